@@ -71,6 +71,9 @@ typedef struct {
   /* used by DMDASetMatPreallocateOnly() */
   PetscBool prealloc_only;
   PetscInt  preallocCenterDim; /* Dimension of the points which connect adjacent points for preallocation */
+
+  /* used by DMDASetStencilMatrix() */
+  PetscBool stencilmatrix;
 } DM_DA;
 
 /*
@@ -29,6 +29,8 @@ PETSC_EXTERN PetscLogEvent DMSWARM_DataExchangerPack;
     PetscCheck(_swarm->dmcell, PetscObjectComm((PetscObject)(dm)), PETSC_ERR_SUP, "Valid only for DMSwarmPIC if the cell DM is set. You must call DMSwarmSetCellDM(dm,celldm)"); \
   } while (0)
 
+typedef struct _n_DMSwarmCellNeighbors *DMSwarmCellNeighbors;
+
 typedef struct {
   DMSwarmDataBucket db;
   PetscInt          refct;
@@ -50,7 +52,8 @@ typedef struct {
 
   DM dmcell;
 
-  PetscBool migrate_error_on_missing_point;
+  PetscBool            migrate_error_on_missing_point;
+  DMSwarmCellNeighbors migrate_neighbors; /* cell adjacency and neighbor ranks of DMSWARM_MIGRATE_DMCELLNEIGHBOR */
 
   PetscBool   collect_view_active;
   PetscInt    collect_view_reset_nlocal;
@@ -73,8 +76,13 @@ struct _p_DMSwarmSort {
   PetscInt    ncells, npoints;
   PetscInt   *pcell_offsets;
   SwarmPoint *list;
+  PetscBool   issorted;                    /* the points are stored by cell, that is list[p].point_index = p */
+  PetscInt    nsortedcells, nsortedpoints; /* sizes when the points were last reordered by DMSwarmSortPoints() */
+  PetscInt   *psorted_offsets;             /* offsets of the cells when the points were last reordered */
 };
 
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_Push_Basic(DM, PetscBool);
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_CellDMScatter(DM, PetscBool);
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_CellDMExact(DM, PetscBool);
+PETSC_INTERN PetscErrorCode DMSwarmMigrate_CellDMNeighbor(DM, PetscBool);
+PETSC_INTERN PetscErrorCode DMSwarmCellNeighborsDestroy(DMSwarmCellNeighbors *);
@@ -591,8 +591,24 @@ struct _p_MatCoarsen {
   PetscReal         threshold; /* HEM can filter interim graphs */
   PetscInt          strength_index_size;
   PetscInt          strength_index[MAT_COARSEN_STRENGTH_INDEX_SIZE];
+  PetscBool         local_first; /* MIS and MISK: aggregate the interior of the process first, then resolve the boundary with hashed priorities */
+  PetscInt          max_rounds;  /* MIS and MISK: bound on the rounds of ghost exchanges, 0 for no bound */
 };
 
+/*
+  MatCoarsenMISPrecedes_Private - with local-first MIS, whether the vertex gid1 takes precedence over its ghost neighbor gid2
+  on the process boundary. The priorities are a hash of the global index, so that a process does not wait on all of its
+  neighbors of higher rank as with the ordering by global index; ties are broken with the global index.
+*/
+static inline PetscBool MatCoarsenMISPrecedes_Private(PetscInt gid1, PetscInt gid2)
+{
+  uint64_t h1 = (uint64_t)gid1 * 0x9E3779B97F4A7C15ULL, h2 = (uint64_t)gid2 * 0x9E3779B97F4A7C15ULL;
+
+  h1 ^= h1 >> 29;
+  h2 ^= h2 >> 29;
+  return (h1 > h2 || (h1 == h2 && gid1 > gid2)) ? PETSC_TRUE : PETSC_FALSE;
+}
+
 PETSC_EXTERN PetscErrorCode MatCoarsenMISKSetDistance(MatCoarsen, PetscInt);
 PETSC_EXTERN PetscErrorCode MatCoarsenMISKGetDistance(MatCoarsen, PetscInt *);
 
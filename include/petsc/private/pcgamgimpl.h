@@ -27,6 +27,7 @@ typedef struct gamg_TAG {
   PCGAMGLayoutType layout_type;
   PetscBool        cpu_pin_coarse_grids;
   PetscInt         min_eq_proc;
+  PetscInt         node_eq_limit; /* below this number of equations per active process keep one active process per compute node */
   PetscInt         asm_hem_aggs;
   MatCoarsen       asm_crs; /* used to generate ASM aggregates */
   PetscInt         coarse_eq_limit;
@@ -53,6 +54,15 @@ typedef struct gamg_TAG {
   PetscBool recompute_esteig;
   PetscInt  injection_index_size;
   PetscInt  injection_index[MAT_COARSEN_STRENGTH_INDEX_SIZE];
+  /* update of the hierarchy when the matrix values change */
+  PetscBool      update_prol;                        /* re-smooth the tentative prolongators with the new matrices */
+  Mat            prol_tentative[PETSC_MG_MAXLEVELS]; /* tentative prolongators, kept for the updates */
+  IS             prol_cols[PETSC_MG_MAXLEVELS];      /* columns of the prolongators kept by the process reduction */
+  PetscReal      rebuild_ratio;                      /* rebuild when a solve needs this many times the iterations of the first solve */
+  PetscInt       ref_its;                            /* iterations of the first solve after the hierarchy was built */
+  PetscBool      rebuild;
+  PetscInt       nbuild, nupdate;
+  PetscLogDouble setup_time[PETSC_MG_MAXLEVELS];
 } PC_GAMG;
 
 PetscErrorCode PCReset_MG(PC);
@@ -45,6 +45,12 @@ typedef struct {
   PetscLogEvent eventsmoothsolve;
   PetscLogEvent eventresidual;
   PetscLogEvent eventinterprestrict;
+  VecScatter    cscatter; /* from the level vectors to ctmp, for the concurrent additive cycle */
+  Vec           ctmp;     /* level vector distributed on the processes solving the level in the concurrent additive cycle */
+  PetscMPIInt   csize;    /* number of processes solving the level in the concurrent additive cycle */
+
+  Mat              cAloc, cPloc;         /* rows of the level operators on the processes solving the level, reused across setups */
+  PetscObjectState cAnzstate, cPnzstate; /* nonzero states of the level operators when cAloc and cPloc were extracted */
 } PC_MG_Levels;
 
 /*
@@ -76,6 +82,15 @@ typedef struct {
   PetscErrorCode (*view)(PC, PetscViewer); /* GAMG and other objects that use PCMG can set their own viewer here */
   PetscReal min_eigen_DinvA[PETSC_MG_MAXLEVELS];
   PetscReal max_eigen_DinvA[PETSC_MG_MAXLEVELS];
+
+  /* additive cycle with the levels solved concurrently on disjoint groups of processes, see PCMGAdditiveSetConcurrent() */
+  PetscBool        concurrent;
+  PetscSubcomm     cpsubcomm;
+  PetscInt         clevel; /* level solved by this process */
+  KSP              cksp;   /* copy of the smoother of that level on the group of processes */
+  KSP              ckspt;  /* copy of the post smoother of that level for the transpose cycle, if distinct */
+  Mat              cA, cP;
+  Vec              cb, cx;
 } PC_MG;
 
 PETSC_INTERN PetscErrorCode PCSetUp_MG(PC);
@@ -94,6 +109,8 @@ PETSC_INTERN PetscErrorCode PCMGComputeCoarseSpace_Internal(PC, PetscInt, PCMGCo
 PETSC_INTERN PetscErrorCode PCMGAdaptInterpolator_Internal(PC, PetscInt, KSP, KSP, Mat, Mat);
 PETSC_INTERN PetscErrorCode PCMGRecomputeLevelOperators_Internal(PC, PetscInt);
 PETSC_INTERN PetscErrorCode PCMGACycle_Private(PC, PC_MG_Levels **, PetscBool, PetscBool);
+PETSC_INTERN PetscErrorCode PCMGACycleSetUp_Private(PC);
+PETSC_INTERN PetscErrorCode PCMGACycleReset_Private(PC);
 PETSC_INTERN PetscErrorCode PCMGFCycle_Private(PC, PC_MG_Levels **, PetscBool, PetscBool);
 PETSC_INTERN PetscErrorCode PCMGKCycle_Private(PC, PC_MG_Levels **, PetscBool, PetscBool);
 PETSC_INTERN PetscErrorCode PCMGMCycle_Private(PC, PC_MG_Levels **, PetscBool, PetscBool, PCRichardsonConvergedReason *);
@@ -579,6 +579,7 @@ PETSC_EXTERN PetscErrorCode TSAdaptHistorySetTSHistory(TSAdapt, TSHistory, Petsc
 
 PETSC_INTERN PetscErrorCode TSTrajectoryReconstruct_Private(TSTrajectory, TS, PetscReal, Vec, Vec);
 PETSC_INTERN PetscErrorCode TSTrajectorySetUp_Basic(TSTrajectory, TS);
+PETSC_INTERN PetscErrorCode TSRosWGetTableau_Private(TSRosWType, PetscInt *, PetscInt *, const PetscReal **, const PetscReal **, const PetscReal **, const PetscReal **, const PetscReal **, const PetscReal **);
 
 PETSC_EXTERN PetscLogEvent TSTrajectory_Set;
 PETSC_EXTERN PetscLogEvent TSTrajectory_Get;
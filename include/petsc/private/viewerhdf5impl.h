@@ -54,9 +54,13 @@ typedef struct {
   PetscBool                 basedimension2; /* save vectors and DMDA vectors with a dimension of at least 2 even if the bs/dof is 1 */
   PetscBool                 spoutput;       /* write data in single precision even if PETSc is compiled with double precision PetscReal */
   PetscBool                 horizontal;     /* store column vectors as blocks (needed for MATDENSE I/O) */
+  PetscInt                  compress;       /* deflate level for new datasets, 0 for no compression */
+  PetscBool                 datasetFlush;   /* flush the file after each dataset is written */
 } PetscViewer_HDF5;
 
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscViewerHDF5CheckTimestepping_Internal(PetscViewer, const char[]); /* currently used in src/dm/impls/da/gr2.c so needs to be extern */
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscViewerHDF5CreateDatasetPList_Internal(PetscViewer, int, const hsize_t[], hid_t *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscViewerHDF5GetChunkLength_Internal(PetscMPIInt, const PetscInt[], PetscInt, hsize_t *);
 
   /* DMPlex-specific support */
   #define DMPLEX_STORAGE_VERSION_READING_KEY "_dm_plex_storage_version_reading"
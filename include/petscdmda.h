@@ -205,11 +205,19 @@ typedef struct {
 } DMDACoor3d;
 
 PETSC_EXTERN PetscErrorCode DMDAGetLocalInfo(DM, DMDALocalInfo *);
+PETSC_EXTERN PetscErrorCode DMDAGetLocalInfoSplit(DM, DMDALocalInfo *, PetscInt *, DMDALocalInfo[]);
 
 PETSC_EXTERN PetscErrorCode MatRegisterDAAD(void);
 PETSC_EXTERN PetscErrorCode MatCreateSeqUSFFT(Vec, DM, Mat *);
 
 PETSC_EXTERN PetscErrorCode DMDASetGetMatrix(DM, PetscErrorCode (*)(DM, Mat *));
+PETSC_EXTERN PetscErrorCode DMDACreateStencilMatrix(DM, PetscInt, const MatStencil[], Mat *);
+PETSC_EXTERN PetscErrorCode DMDAStencilMatrixSetCoefficients(Mat, const PetscScalar[]);
+PETSC_EXTERN PetscErrorCode DMDAStencilMatrixSetVariableCoefficients(Mat, Vec);
+PETSC_EXTERN PetscErrorCode DMDAStencilMatrixSetCoefficientsFD(Mat, Vec, Vec, PetscErrorCode (*)(Vec, Vec, void *), void *);
+PETSC_EXTERN PetscErrorCode DMDAStencilMatrixGetStencil(Mat, PetscInt *, const MatStencil *[]);
+PETSC_EXTERN PetscErrorCode DMDASetStencilMatrix(DM, PetscBool);
+PETSC_EXTERN PetscErrorCode DMDAGetStencilMatrix(DM, PetscBool *);
 PETSC_EXTERN PetscErrorCode DMDASetBlockFills(DM, const PetscInt *, const PetscInt *);
 PETSC_EXTERN PetscErrorCode DMDASetBlockFillsSparse(DM, const PetscInt *, const PetscInt *);
 PETSC_EXTERN PetscErrorCode DMDASetRefinementFactor(DM, PetscInt, PetscInt, PetscInt);
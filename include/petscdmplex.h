@@ -276,8 +276,13 @@ PETSC_EXTERN PetscErrorCode DMPlexGetMigrationSF(DM, PetscSF *);
 PETSC_EXTERN PetscErrorCode DMPlexDistributionSetName(DM, const char[]);
 PETSC_EXTERN PetscErrorCode DMPlexDistributionGetName(DM, const char *[]);
 
+/* Space-filling curve orderings accepted by DMPlexGetOrdering() in addition to MatOrderingType */
+#define DMPLEX_ORDERING_HILBERT "hilbert"
+#define DMPLEX_ORDERING_MORTON  "morton"
+
 PETSC_EXTERN PetscErrorCode DMPlexGetOrdering(DM, MatOrderingType, DMLabel, IS *);
 PETSC_EXTERN PetscErrorCode DMPlexGetOrdering1D(DM, IS *);
+PETSC_EXTERN PetscErrorCode DMPlexComputeOrderingQuality(DM, PetscInt *, PetscReal *);
 PETSC_EXTERN PetscErrorCode DMPlexPermute(DM, IS, DM *);
 PETSC_EXTERN PetscErrorCode DMPlexReorderGetDefault(DM, DMReorderDefaultFlag *);
 PETSC_EXTERN PetscErrorCode DMPlexReorderSetDefault(DM, DMReorderDefaultFlag);
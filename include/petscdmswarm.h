@@ -29,11 +29,28 @@ typedef enum {
   DMSWARM_PIC
 } DMSwarmType;
 
+/*E
+   DMSwarmMigrateType - Defines how the points of a `DMSWARM` are sent to the MPI rank owning them in `DMSwarmMigrate()`
+
+   Values:
++  `DMSWARM_MIGRATE_BASIC`          - the points are sent to the rank stored in their `DMSwarmField_rank` field
+.  `DMSWARM_MIGRATE_DMCELLNSCATTER` - the points not located on the rank of the cell `DM` are sent to all its neighbor ranks
+.  `DMSWARM_MIGRATE_DMCELLEXACT`    - not implemented
+.  `DMSWARM_MIGRATE_USER`           - not implemented
+-  `DMSWARM_MIGRATE_DMCELLNEIGHBOR` - the points are looked for in their last cell and its face neighbors, the points leaving through the partition
+                                      boundary are sent to the single rank across it and only the points moving further are searched for on all ranks.
+                                      Requires an interpolated `DMPLEX` cell `DM`
+
+   Level: intermediate
+
+.seealso: `DMSWARM`, `DMSwarmSetMigrateType()`, `DMSwarmGetMigrateType()`, `DMSwarmMigrate()`
+E*/
 typedef enum {
   DMSWARM_MIGRATE_BASIC = 0,
   DMSWARM_MIGRATE_DMCELLNSCATTER,
   DMSWARM_MIGRATE_DMCELLEXACT,
-  DMSWARM_MIGRATE_USER
+  DMSWARM_MIGRATE_USER,
+  DMSWARM_MIGRATE_DMCELLNEIGHBOR
 } DMSwarmMigrateType;
 
 typedef enum {
@@ -124,6 +141,8 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM, PetscInt, PetscInt *
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetNumberOfPointsPerCell(DM, PetscInt, PetscInt *);
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetIsValid(DM, PetscBool *);
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetSizes(DM, PetscInt *, PetscInt *);
+PETSC_EXTERN PetscErrorCode DMSwarmSortPoints(DM);
+PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointRange(DM, PetscInt, PetscInt *, PetscInt *);
 
 PETSC_EXTERN PetscErrorCode DMSwarmCreateMassMatrixSquare(DM, DM, Mat *);
 
@@ -171,6 +171,7 @@ typedef const char *MatSolverType;
 #define MATSOLVERMATLAB       "matlab"
 #define MATSOLVERPETSC        "petsc"
 #define MATSOLVERBAS          "bas"
+#define MATSOLVERPARILU       "parilu"
 #define MATSOLVERCUSPARSE     "cusparse"
 #define MATSOLVERCUDA         "cuda"
 #define MATSOLVERHIPSPARSE    "hipsparse"
@@ -74,3 +74,5 @@ PETSC_EXTERN PetscErrorCode MatCoarsenMISKGetDistance(MatCoarsen, PetscInt *);
 PETSC_EXTERN PetscErrorCode MatCoarsenSetMaximumIterations(MatCoarsen, PetscInt);
 PETSC_EXTERN PetscErrorCode MatCoarsenSetThreshold(MatCoarsen, PetscReal);
 PETSC_EXTERN PetscErrorCode MatCoarsenSetStrengthIndex(MatCoarsen, PetscInt, PetscInt[]);
+PETSC_EXTERN PetscErrorCode MatCoarsenSetLocalFirst(MatCoarsen, PetscBool);
+PETSC_EXTERN PetscErrorCode MatCoarsenSetMaximumRounds(MatCoarsen, PetscInt);
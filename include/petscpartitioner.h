@@ -28,12 +28,13 @@ PETSC_EXTERN PetscErrorCode PetscPartitionerFinalizePackage(void);
 .seealso: `PetscPartitionerSetType()`, `PetscPartitioner`
 J*/
 typedef const char *PetscPartitionerType;
-#define PETSCPARTITIONERPARMETIS "parmetis"
-#define PETSCPARTITIONERPTSCOTCH "ptscotch"
-#define PETSCPARTITIONERCHACO    "chaco"
-#define PETSCPARTITIONERSIMPLE   "simple"
-#define PETSCPARTITIONERSHELL    "shell"
-#define PETSCPARTITIONERGATHER   "gather"
+#define PETSCPARTITIONERPARMETIS  "parmetis"
+#define PETSCPARTITIONERPTSCOTCH  "ptscotch"
+#define PETSCPARTITIONERCHACO     "chaco"
+#define PETSCPARTITIONERSIMPLE    "simple"
+#define PETSCPARTITIONERSHELL     "shell"
+#define PETSCPARTITIONERGATHER    "gather"
+#define PETSCPARTITIONERDIFFUSIVE "diffusive"
 
 PETSC_EXTERN PetscFunctionList PetscPartitionerList;
 PETSC_EXTERN PetscErrorCode    PetscPartitionerRegister(const char[], PetscErrorCode (*)(PetscPartitioner));
@@ -53,6 +54,8 @@ PETSC_EXTERN PetscErrorCode PetscPartitionerShellSetPartition(PetscPartitioner,
 PETSC_EXTERN PetscErrorCode PetscPartitionerShellSetRandom(PetscPartitioner, PetscBool);
 PETSC_EXTERN PetscErrorCode PetscPartitionerShellGetRandom(PetscPartitioner, PetscBool *);
 
+PETSC_EXTERN PetscErrorCode PetscPartitionerDiffusiveGetImbalance(PetscPartitioner, PetscReal *, PetscReal *, PetscReal *);
+
 /* We should implement MatPartitioning with PetscPartitioner */
 #include <petscmat.h>
 #define PETSCPARTITIONERMATPARTITIONING "matpartitioning"
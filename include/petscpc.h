@@ -321,6 +321,7 @@ PETSC_EXTERN PetscErrorCode PCPARMSSetFill(PC, PetscInt, PetscInt, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetType(PC, PCGAMGType);
 PETSC_EXTERN PetscErrorCode PCGAMGGetType(PC, PCGAMGType *);
 PETSC_EXTERN PetscErrorCode PCGAMGSetProcEqLim(PC, PetscInt);
+PETSC_EXTERN PetscErrorCode PCGAMGSetNodeEqLim(PC, PetscInt);
 
 PETSC_EXTERN PetscErrorCode PCGAMGSetRepartition(PC, PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGSetUseSAEstEig(PC, PetscBool);
@@ -338,6 +339,8 @@ PETSC_EXTERN PetscErrorCode PCGAMGSetNlevels(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetNSmooths(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetAggressiveLevels(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetReuseInterpolation(PC, PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetUpdateInterpolation(PC, PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetRebuildIterationRatio(PC, PetscReal);
 PETSC_EXTERN PetscErrorCode PCGAMGFinalizePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGInitializePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGRegister(PCGAMGType, PetscErrorCode (*)(PC));
@@ -405,6 +408,7 @@ PETSC_DEPRECATED_FUNCTION(3, 5, 0, "PCMGSetCycleTypeOnLevel()", ) static inline
   return PCMGSetCycleTypeOnLevel(pc, l, (PCMGCycleType)t);
 }
 PETSC_EXTERN PetscErrorCode PCMGMultiplicativeSetCycles(PC, PetscInt);
+PETSC_EXTERN PetscErrorCode PCMGAdditiveSetConcurrent(PC, PetscBool);
 PETSC_EXTERN PetscErrorCode PCMGSetGalerkin(PC, PCMGGalerkinType);
 PETSC_EXTERN PetscErrorCode PCMGGetGalerkin(PC, PCMGGalerkinType *);
 PETSC_EXTERN PetscErrorCode PCMGSetAdaptCoarseSpaceType(PC, PCMGCoarseSpaceType);
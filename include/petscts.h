@@ -52,6 +52,8 @@ typedef const char *TSType;
 #define TSDISCGRAD        "discgrad"
 #define TSIRK             "irk"
 #define TSDIRK            "dirk"
+#define TSPARAREAL        "parareal"
+#define TSBATCH           "batch"
 
 /*E
    TSProblemType - Determines the type of problem this `TS` object is to be used to solve
@@ -360,6 +362,29 @@ typedef enum {
 PETSC_EXTERN const char *const TSTrajectoryMemoryTypes[];
 
 PETSC_EXTERN PetscErrorCode TSTrajectoryMemorySetType(TSTrajectory, TSTrajectoryMemoryType);
+
+/*E
+   TSTrajectoryMemoryCompressionType - Compression of the checkpoints kept in RAM by `TSTRAJECTORYMEMORY`
+
+   Values:
++  `TS_TRAJECTORY_MEMORY_COMPRESS_NONE`     - store copies of the vectors
+.  `TS_TRAJECTORY_MEMORY_COMPRESS_LOSSLESS` - byte shuffling followed by an LZ77 coder
+-  `TS_TRAJECTORY_MEMORY_COMPRESS_LOSSY`    - quantization to a given absolute error followed by an LZ77 coder
+
+   Level: advanced
+
+.seealso: [](ch_ts), `TSTrajectoryMemorySetCompression()`, `TSTRAJECTORYMEMORY`
+E*/
+typedef enum {
+  TS_TRAJECTORY_MEMORY_COMPRESS_NONE,
+  TS_TRAJECTORY_MEMORY_COMPRESS_LOSSLESS,
+  TS_TRAJECTORY_MEMORY_COMPRESS_LOSSY
+} TSTrajectoryMemoryCompressionType;
+PETSC_EXTERN const char *const TSTrajectoryMemoryCompressionTypes[];
+
+PETSC_EXTERN PetscErrorCode TSTrajectoryMemorySetCompression(TSTrajectory, TSTrajectoryMemoryCompressionType, PetscReal);
+PETSC_EXTERN PetscErrorCode TSTrajectoryMemorySetLocalStorage(TSTrajectory, const char[], PetscInt);
+
 PETSC_EXTERN PetscErrorCode TSTrajectorySetMaxCpsRAM(TSTrajectory, PetscInt);
 PETSC_EXTERN PetscErrorCode TSTrajectorySetMaxCpsDisk(TSTrajectory, PetscInt);
 PETSC_EXTERN PetscErrorCode TSTrajectorySetMaxUnitsRAM(TSTrajectory, PetscInt);
@@ -920,6 +945,7 @@ PETSC_EXTERN_TYPEDEF typedef PetscErrorCode(DMDATSIJacobianLocalFn)(DMDALocalInf
 PETSC_EXTERN_TYPEDEF typedef DMDATSIJacobianLocalFn *DMDATSIJacobianLocal;
 
 PETSC_EXTERN PetscErrorCode DMDATSSetRHSFunctionLocal(DM, InsertMode, DMDATSRHSFunctionLocalFn *, void *);
+PETSC_EXTERN PetscErrorCode DMDATSSetRHSFunctionLocalSplit(DM, DMDATSRHSFunctionLocalFn *, DMDATSRHSFunctionLocalFn *, void *);
 PETSC_EXTERN PetscErrorCode DMDATSSetRHSJacobianLocal(DM, DMDATSRHSJacobianLocalFn *, void *);
 PETSC_EXTERN PetscErrorCode DMDATSSetIFunctionLocal(DM, InsertMode, DMDATSIFunctionLocalFn *, void *);
 PETSC_EXTERN PetscErrorCode DMDATSSetIJacobianLocal(DM, DMDATSIJacobianLocalFn *, void *);
@@ -1439,6 +1465,79 @@ PETSC_EXTERN PetscErrorCode TSDiscGradGetFormulation(TS, PetscErrorCode (**)(TS,
 PETSC_EXTERN PetscErrorCode TSDiscGradIsGonzalez(TS, PetscBool *);
 PETSC_EXTERN PetscErrorCode TSDiscGradUseGonzalez(TS, PetscBool);
 
+/*E
+   TSPararealRelaxationType - The relaxation of the fine values between the coarse sweeps of `TSPARAREAL`
+
+   Values:
++  `TS_PARAREAL_RELAXATION_F`   - the fine propagator is applied once per iteration (classical Parareal)
+-  `TS_PARAREAL_RELAXATION_FCF` - the fine values are moved to the next time slices and propagated once more
+
+   Level: intermediate
+
+.seealso: [](ch_ts), `TS`, `TSPARAREAL`, `TSPararealSetRelaxationType()`
+E*/
+typedef enum {
+  TS_PARAREAL_RELAXATION_F,
+  TS_PARAREAL_RELAXATION_FCF
+} TSPararealRelaxationType;
+PETSC_EXTERN const char *const TSPararealRelaxationTypes[];
+
+PETSC_EXTERN PetscErrorCode TSPararealSetSubProblem(TS, PetscErrorCode (*)(TS, void *), void *);
+PETSC_EXTERN PetscErrorCode TSPararealSetNumGroups(TS, PetscInt);
+PETSC_EXTERN PetscErrorCode TSPararealSetNumSlices(TS, PetscInt);
+PETSC_EXTERN PetscErrorCode TSPararealSetRelaxationType(TS, TSPararealRelaxationType);
+PETSC_EXTERN PetscErrorCode TSPararealSetTolerances(TS, PetscReal, PetscInt);
+PETSC_EXTERN PetscErrorCode TSPararealGetSubTS(TS, TS *, TS *);
+PETSC_EXTERN PetscErrorCode TSPararealGetIterationNumber(TS, PetscInt *);
+PETSC_EXTERN PetscErrorCode TSPararealGetGroupSpeedup(TS, PetscReal *);
+
+/*S
+  TSBatchRHSFunctionFn - A prototype of the function that evaluates the right-hand side of a chunk of systems of `TSBATCH`, passed to `TSBatchSetRHSFunction()`
+
+  Calling Sequence:
++ ts  - the `TS` context
+. n   - the number of systems in the chunk
+. ld  - the leading dimension of the arrays, at least `n`
+. sys - the local index of each system of the chunk
+. t   - the time of each system
+. x   - the solution, component c of system b of the chunk is x[c * `ld` + b]
+. f   - the right-hand side, with the same layout as `x`
+- ctx - [optional] user-defined function context
+
+  Level: intermediate
+
+  Note:
+  The loops over the systems of the chunk, with b innermost, vectorize.
+
+.seealso: [](ch_ts), `TS`, `TSBATCH`, `TSBatchSetRHSFunction()`, `TSBatchRHSJacobianFn`
+S*/
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode(TSBatchRHSFunctionFn)(TS ts, PetscInt n, PetscInt ld, const PetscInt sys[], const PetscReal t[], const PetscScalar x[], PetscScalar f[], void *ctx);
+
+/*S
+  TSBatchRHSJacobianFn - A prototype of the function that evaluates the Jacobian of the right-hand side of a chunk of systems of `TSBATCH`, passed to `TSBatchSetRHSJacobian()`
+
+  Calling Sequence:
++ ts  - the `TS` context
+. n   - the number of systems in the chunk
+. ld  - the leading dimension of the arrays, at least `n`
+. sys - the local index of each system of the chunk
+. t   - the time of each system
+. x   - the solution, component c of system b of the chunk is x[c * `ld` + b]
+. J   - the Jacobian, the derivative of component r with respect to component c of system b is J[(r * m + c) * `ld` + b] for systems of size m
+- ctx - [optional] user-defined function context
+
+  Level: intermediate
+
+.seealso: [](ch_ts), `TS`, `TSBATCH`, `TSBatchSetRHSJacobian()`, `TSBatchRHSFunctionFn`
+S*/
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode(TSBatchRHSJacobianFn)(TS ts, PetscInt n, PetscInt ld, const PetscInt sys[], const PetscReal t[], const PetscScalar x[], PetscScalar J[], void *ctx);
+
+PETSC_EXTERN PetscErrorCode TSBatchSetRHSFunction(TS, PetscInt, TSBatchRHSFunctionFn *, void *);
+PETSC_EXTERN PetscErrorCode TSBatchSetRHSJacobian(TS, TSBatchRHSJacobianFn *, void *);
+PETSC_EXTERN PetscErrorCode TSBatchSetRosWType(TS, TSRosWType);
+PETSC_EXTERN PetscErrorCode TSBatchSetChunkSize(TS, PetscInt);
+PETSC_EXTERN PetscErrorCode TSBatchGetStatistics(TS, PetscInt *, PetscInt *, PetscInt *);
+
 /*
        PETSc interface to Sundials
 */
@@ -83,4 +83,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetSPOutput(PetscViewer, PetscBool *)
 
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetCollective(PetscViewer, PetscBool);
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetCollective(PetscViewer, PetscBool *);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetCompression(PetscViewer, PetscInt);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetCompression(PetscViewer, PetscInt *);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetDatasetFlush(PetscViewer, PetscBool);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetDatasetFlush(PetscViewer, PetscBool *);
 #endif /* defined(PETSC_HAVE_HDF5) */
@@ -79,6 +79,21 @@ run_spmv_benchmarks() {
     fi
 }
 
+# Runs the sparse triangular solve benchmarks by using file $1 as the input, comparing the
+# sequential and the level-scheduled MatSolve() of ILU(0) factors, and updating it with the results.
+run_sptrsv_benchmarks() {
+    [ "${DRY_RUN}" == "true" ] && return
+    ${LAUNCHER} ../mat/tests/bench_sptrsv -repetitions 5 -AJSON "$1"
+}
+
+run_benchmarks() {
+    if [ "${BENCHMARK}" == "sptrsv" ]; then
+        run_sptrsv_benchmarks "$1"
+    else
+        run_spmv_benchmarks "$1"
+    fi
+}
+
 NUM_PROBLEMS="$(${SSGET} -n)"
 
 # Creates an input file for $1-th problem in the SuiteSparse collection
@@ -156,8 +171,8 @@ for (( p=${LOOP_START}; p < ${LOOP_END}; ++p )); do
         [ "${DRY_RUN}" != "true" ] && ${SSGET} -i "$i" -c >/dev/null
         continue
     fi
-    # filter matrices for spmv tests
-    if [ "${BENCHMARK}" == "spmv" ]; then
+    # filter matrices for spmv and sptrsv tests
+    if [ "${BENCHMARK}" == "spmv" ] || [ "${BENCHMARK}" == "sptrsv" ]; then
 	# deselect non-square matrices and matrices with more than 2B non zeros
         if [ "$(${SSGET} -i "$i" -pcols)" != "$(${SSGET} -i "$i" -prows)" ] || [ "$(${SSGET} -i "$i" -pnonzeros)" -gt 2000000000 ]; then
             [ "${DRY_RUN}" != "true" ] && ${SSGET} -i "$i" -c >/dev/null
@@ -172,8 +187,8 @@ for (( p=${LOOP_START}; p < ${LOOP_END}; ++p )); do
         mkdir -p "$(dirname "${RESULT_FILE}")"
         echo -e "${PREFIX}Extracting the matrix for ${GROUP}/${NAME}" 1>&2
         generate_suite_sparse_input "$i" >"${RESULT_FILE}"
-        echo -e "${PREFIX}Running SpMV for ${GROUP}/${NAME}" 1>&2
-        run_spmv_benchmarks "${RESULT_FILE}"
+        echo -e "${PREFIX}Running ${BENCHMARK} for ${GROUP}/${NAME}" 1>&2
+        run_benchmarks "${RESULT_FILE}"
         # echo -e "${PREFIX}Cleaning up problem ${GROUP}/${NAME}" 1>&2
         # [ "${DRY_RUN}" != "true" ] && ${SSGET} -i "$i" -c >/dev/null
     else
@@ -184,8 +199,8 @@ if [ "${SINGLE_JSON}" == "true" ]; then
     cat << EOT >"${RESULT_FILE}"
 ]
 EOT
-    echo -e "${PREFIX}Running SpMV for SEG${SEGMENT_ID}" 1>&2
-    run_spmv_benchmarks "${RESULT_FILE}"
+    echo -e "${PREFIX}Running ${BENCHMARK} for SEG${SEGMENT_ID}" 1>&2
+    run_benchmarks "${RESULT_FILE}"
     for (( p=${LOOP_START}; p < ${LOOP_END}; ++p )); do
         if [ $use_matrix_list_file -eq 1 ]; then
             i=${MATRIX_LIST[$((p-1))]}
@@ -235,6 +235,7 @@ class MatSolverType(object):
     MATLAB          = S_(MATSOLVERMATLAB)
     PETSC           = S_(MATSOLVERPETSC)
     BAS             = S_(MATSOLVERBAS)
+    PARILU          = S_(MATSOLVERPARILU)
     CUSPARSE        = S_(MATSOLVERCUSPARSE)
     CUDA            = S_(MATSOLVERCUDA)
     SPQR            = S_(MATSOLVERSPQR)
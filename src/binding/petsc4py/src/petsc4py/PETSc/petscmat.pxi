@@ -119,6 +119,7 @@ cdef extern from * nogil:
     PetscMatSolverType MATSOLVERMATLAB
     PetscMatSolverType MATSOLVERPETSC
     PetscMatSolverType MATSOLVERBAS
+    PetscMatSolverType MATSOLVERPARILU
     PetscMatSolverType MATSOLVERCUSPARSE
     PetscMatSolverType MATSOLVERCUDA
     PetscMatSolverType MATSOLVERSPQR
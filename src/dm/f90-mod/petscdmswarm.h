@@ -15,6 +15,7 @@
       PetscEnum, parameter :: DMSWARM_MIGRATE_DMCELLNSCATTER = 1
       PetscEnum, parameter :: DMSWARM_MIGRATE_DMCELLEXACT = 2
       PetscEnum, parameter :: DMSWARM_MIGRATE_USER = 3
+      PetscEnum, parameter :: DMSWARM_MIGRATE_DMCELLNEIGHBOR = 4
 !
 ! DMSwarmCollectType
 !
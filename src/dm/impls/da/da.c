@@ -1078,6 +1078,7 @@ PetscErrorCode DMRefine_DA(DM da, MPI_Comm comm, DM *daref)
   /* da2->ops->createinterpolation = da->ops->createinterpolation; this causes problem with SNESVI */
   da2->ops->getcoloring = da->ops->getcoloring;
   dd2->interptype       = dd->interptype;
+  dd2->stencilmatrix    = dd->stencilmatrix;
 
   /* copy fill information if given */
   if (dd->dfill) {
@@ -1225,6 +1226,7 @@ PetscErrorCode DMCoarsen_DA(DM dmf, MPI_Comm comm, DM *dmc)
   dmc2->ops->creatematrix = dmf->ops->creatematrix;
   dmc2->ops->getcoloring  = dmf->ops->getcoloring;
   dd2->interptype         = dd->interptype;
+  dd2->stencilmatrix      = dd->stencilmatrix;
 
   /* copy fill information if given */
   if (dd->dfill) {
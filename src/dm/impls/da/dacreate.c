@@ -82,6 +82,7 @@ static PetscErrorCode DMSetFromOptions_DA(DM da, PetscOptionItems *PetscOptionsO
   }
 
   PetscCall(PetscOptionsBoundedInt("-da_refine", "Uniformly refine DA one or more times", "None", refine, &refine, NULL, 0));
+  PetscCall(PetscOptionsBool("-da_stencil_matrix", "DMCreateMatrix() returns a DMDACreateStencilMatrix() matrix", "DMDASetStencilMatrix", dd->stencilmatrix, &dd->stencilmatrix, NULL));
   PetscOptionsHeadEnd();
 
   while (refine--) {
@@ -0,0 +1,762 @@
+#include <petsc/private/dmdaimpl.h> /*I   "petscdmda.h"   I*/
+#include <petsc/private/matimpl.h> /* for MatShellGetScalingShifts() */
+
+typedef struct {
+  DM            da;
+  DMDALocalInfo info;
+  PetscInt      n;        /* number of entries of the stencil */
+  MatStencil   *st;       /* offsets of the entries */
+  PetscInt     *loff;     /* offsets of the entries in the ghosted local array */
+  PetscBool    *valid;    /* entries whose neighbor row is in the domain, for the current row */
+  PetscScalar  *c;        /* constant coefficients of the entries */
+  PetscScalar  *cv;       /* variable coefficients of the owned points, stored entry by entry, or NULL */
+  PetscScalar  *diag;     /* diagonal of the owned points */
+  PetscInt      lo[3];    /* ghosted local points where the operand is defined */
+  PetscInt      hi[3];
+  PetscInt      w;        /* largest offset in the outermost dimension */
+  PetscInt      tile;     /* number of rows in the tiles of the 3d product, 0 for automatic */
+  PetscBool     pipeline; /* pipeline the repeated local SOR sweeps over the planes */
+  Vec           xl;       /* ghosted work vector */
+  PetscInt      ncolors;  /* number of colors of the colored differencing, 0 until it is needed */
+  PetscInt      cmul[3];  /* the color of the point (i, j, k) is (cmul[0] i + cmul[1] j + cmul[2] k) mod ncolors */
+  PetscReal     fderr;    /* relative perturbation of the colored differencing */
+  PetscReal     fdumin;   /* smallest magnitude of the perturbed values */
+  PetscInt      nmult;    /* number of products */
+  PetscInt      nfunc;    /* number of function evaluations of the colored differencing */
+} Mat_DAStencil;
+
+static inline void MatDAStencilSetRow_Private(Mat_DAStencil *s, PetscInt j, PetscInt k)
+{
+  for (PetscInt e = 0; e < s->n; e++) s->valid[e] = (PetscBool)(j + s->st[e].j >= s->lo[1] && j + s->st[e].j < s->hi[1] && k + s->st[e].k >= s->lo[2] && k + s->st[e].k < s->hi[2]);
+}
+
+/* y = A x for the owned points of the row (j, k), one entry at a time so that the inner loops are contiguous */
+static void MatMult_DAStencil_Row(Mat_DAStencil *s, PetscInt j, PetscInt k, const PetscScalar xl[], PetscScalar y[])
+{
+  const DMDALocalInfo *info = &s->info;
+  const PetscInt       nown = info->xm * info->ym * info->zm, g = info->xm * ((j - info->ys) + info->ym * (k - info->zs));
+  const PetscScalar   *xr   = xl + (info->xs - info->gxs) + info->gxm * ((j - info->gys) + info->gym * (k - info->gzs));
+  PetscScalar         *yr   = y + g;
+
+  MatDAStencilSetRow_Private(s, j, k);
+  for (PetscInt i = 0; i < info->xm; i++) yr[i] = 0.0;
+  for (PetscInt e = 0; e < s->n; e++) {
+    const PetscInt     ilo = PetscMax(0, s->lo[0] - s->st[e].i - info->xs), ihi = PetscMin(info->xm, s->hi[0] - s->st[e].i - info->xs);
+    const PetscScalar *xe  = xr + s->loff[e];
+
+    if (!s->valid[e]) continue;
+    if (s->cv) {
+      const PetscScalar *ce = s->cv + e * nown + g;
+
+      PetscPragmaSIMD
+      for (PetscInt i = ilo; i < ihi; i++) yr[i] += ce[i] * xe[i];
+    } else {
+      const PetscScalar c = s->c[e];
+
+      PetscPragmaSIMD
+      for (PetscInt i = ilo; i < ihi; i++) yr[i] += c * xe[i];
+    }
+  }
+}
+
+static PetscErrorCode MatMult_DAStencil(Mat A, Vec x, Vec y)
+{
+  Mat_DAStencil       *s;
+  const DMDALocalInfo *info;
+  const PetscScalar   *xl;
+  PetscScalar         *ya;
+  PetscInt             tile;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &s));
+  PetscCheck(s->diag, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_WRONGSTATE, "Must set the coefficients with DMDAStencilMatrixSetCoefficients() or DMDAStencilMatrixSetVariableCoefficients()");
+  info = &s->info;
+  PetscCall(DMGlobalToLocalBegin(s->da, x, INSERT_VALUES, s->xl));
+  PetscCall(DMGlobalToLocalEnd(s->da, x, INSERT_VALUES, s->xl));
+  PetscCall(VecGetArrayRead(s->xl, &xl));
+  PetscCall(VecGetArrayWrite(y, &ya));
+  /* in 3d the rows are swept in tiles of the second dimension, so that the planes of a tile needed by the stencil stay in cache */
+  tile = s->tile;
+  if (!tile) tile = PetscMax(1, 32768 / ((2 * s->w + 1) * info->gxm));
+  for (PetscInt jt = info->ys; jt < info->ys + info->ym; jt += tile) {
+    for (PetscInt k = info->zs; k < info->zs + info->zm; k++) {
+      for (PetscInt j = jt; j < PetscMin(jt + tile, info->ys + info->ym); j++) MatMult_DAStencil_Row(s, j, k, xl, ya);
+    }
+  }
+  PetscCall(VecRestoreArrayWrite(y, &ya));
+  PetscCall(VecRestoreArrayRead(s->xl, &xl));
+  PetscCall(PetscLogFlops(2.0 * s->n * info->xm * info->ym * info->zm));
+  s->nmult++;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatGetDiagonal_DAStencil(Mat A, Vec d)
+{
+  Mat_DAStencil *s;
+  PetscScalar   *da;
+  PetscInt       n;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &s));
+  PetscCheck(s->diag, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_WRONGSTATE, "Must set the coefficients with DMDAStencilMatrixSetCoefficients() or DMDAStencilMatrixSetVariableCoefficients()");
+  PetscCall(VecGetLocalSize(d, &n));
+  PetscCall(VecGetArrayWrite(d, &da));
+  PetscCall(PetscArraycpy(da, s->diag, n));
+  PetscCall(VecRestoreArrayWrite(d, &da));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* one SOR sweep over the owned points of the row (j, k) of the ghosted local array, the diagonal entries are skipped in the sum */
+static void MatSOR_DAStencil_Row(Mat_DAStencil *s, PetscInt j, PetscInt k, PetscBool forward, PetscScalar scale, PetscScalar shift, PetscReal omega, const PetscScalar b[], PetscScalar xl[])
+{
+  const DMDALocalInfo *info = &s->info;
+  const PetscInt       nown = info->xm * info->ym * info->zm, g = info->xm * ((j - info->ys) + info->ym * (k - info->zs));
+  PetscScalar         *xr   = xl + (info->xs - info->gxs) + info->gxm * ((j - info->gys) + info->gym * (k - info->gzs));
+
+  MatDAStencilSetRow_Private(s, j, k);
+  for (PetscInt ii = 0; ii < info->xm; ii++) {
+    const PetscInt i = forward ? ii : info->xm - 1 - ii;
+    PetscScalar    sum = b[g + i];
+
+    for (PetscInt e = 0; e < s->n; e++) {
+      const PetscInt in = info->xs + i + s->st[e].i;
+
+      if (!s->loff[e] || !s->valid[e] || in < s->lo[0] || in >= s->hi[0]) continue;
+      sum -= scale * (s->cv ? s->cv[e * nown + g + i] : s->c[e]) * xr[i + s->loff[e]];
+    }
+    xr[i] = (1.0 - omega) * xr[i] + omega * sum / (scale * s->diag[g + i] + shift);
+  }
+}
+
+/* one SOR sweep over the plane p of the outermost dimension */
+static void MatSOR_DAStencil_Plane(Mat_DAStencil *s, PetscInt p, PetscBool forward, PetscScalar scale, PetscScalar shift, PetscReal omega, const PetscScalar b[], PetscScalar xl[])
+{
+  const DMDALocalInfo *info = &s->info;
+
+  if (info->dim == 3) {
+    for (PetscInt jj = 0; jj < info->ym; jj++) MatSOR_DAStencil_Row(s, forward ? info->ys + jj : info->ys + info->ym - 1 - jj, info->zs + p, forward, scale, shift, omega, b, xl);
+  } else if (info->dim == 2) MatSOR_DAStencil_Row(s, info->ys + p, 0, forward, scale, shift, omega, b, xl);
+  else MatSOR_DAStencil_Row(s, 0, 0, forward, scale, shift, omega, b, xl);
+}
+
+/*
+  lits sweeps in the same direction with the ghost points fixed. When pipelined, sweep l + 1 follows sweep l with a lag of
+  w + 1 planes, where w is the largest offset of the stencil across the planes, so that each plane is visited lits times
+  while in cache. Every point sees the same values as in consecutive sweeps, so the result is the same.
+*/
+static void MatSOR_DAStencil_Sweeps(Mat_DAStencil *s, PetscInt lits, PetscBool forward, PetscScalar scale, PetscScalar shift, PetscReal omega, const PetscScalar b[], PetscScalar xl[])
+{
+  const DMDALocalInfo *info = &s->info;
+  const PetscInt       np   = info->dim == 3 ? info->zm : (info->dim == 2 ? info->ym : 1);
+
+  if (s->pipeline && lits > 1 && np > 1) {
+    for (PetscInt t = 0; t < np + (lits - 1) * (s->w + 1); t++) {
+      for (PetscInt l = 0; l < lits; l++) {
+        const PetscInt p = t - l * (s->w + 1);
+
+        if (p >= 0 && p < np) MatSOR_DAStencil_Plane(s, forward ? p : np - 1 - p, forward, scale, shift, omega, b, xl);
+      }
+    }
+  } else {
+    for (PetscInt l = 0; l < lits; l++) {
+      for (PetscInt p = 0; p < np; p++) MatSOR_DAStencil_Plane(s, forward ? p : np - 1 - p, forward, scale, shift, omega, b, xl);
+    }
+  }
+}
+
+/* the sweeps are local to each process, with the ghost points updated at each of the its iterations, as for MATMPIAIJ */
+static PetscErrorCode MatSOR_DAStencil(Mat A, Vec b, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec x)
+{
+  Mat_DAStencil       *s;
+  const DMDALocalInfo *info;
+  const PetscScalar   *ba;
+  PetscScalar         *xa, *xl, shift, scale;
+  PetscMPIInt          size;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &s));
+  PetscCheck(s->diag, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_WRONGSTATE, "Must set the coefficients with DMDAStencilMatrixSetCoefficients() or DMDAStencilMatrixSetVariableCoefficients()");
+  PetscCheck(!(flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER)), PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "Eisenstat and triangular applications are not supported");
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)A), &size));
+  PetscCheck(size == 1 || !(flag & SOR_SYMMETRIC_SWEEP), PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "Parallel SOR not supported, use the local sweeps");
+  PetscCall(MatShellGetScalingShifts(A, &shift, &scale, (Vec *)MAT_SHELL_NOT_ALLOWED, (Vec *)MAT_SHELL_NOT_ALLOWED, (Vec *)MAT_SHELL_NOT_ALLOWED, (Mat *)MAT_SHELL_NOT_ALLOWED, (IS *)MAT_SHELL_NOT_ALLOWED, (IS *)MAT_SHELL_NOT_ALLOWED));
+  shift += fshift;
+  info = &s->info;
+  PetscCall(VecGetArrayRead(b, &ba));
+  for (PetscInt it = 0; it < its; it++) {
+    if (!it && (flag & SOR_ZERO_INITIAL_GUESS)) PetscCall(VecSet(s->xl, 0.0));
+    else {
+      PetscCall(DMGlobalToLocalBegin(s->da, x, INSERT_VALUES, s->xl));
+      PetscCall(DMGlobalToLocalEnd(s->da, x, INSERT_VALUES, s->xl));
+    }
+    PetscCall(VecGetArray(s->xl, &xl));
+    if ((flag & SOR_SYMMETRIC_SWEEP) == SOR_SYMMETRIC_SWEEP || (flag & SOR_LOCAL_SYMMETRIC_SWEEP) == SOR_LOCAL_SYMMETRIC_SWEEP) {
+      for (PetscInt l = 0; l < lits; l++) {
+        MatSOR_DAStencil_Sweeps(s, 1, PETSC_TRUE, scale, shift, omega, ba, xl);
+        MatSOR_DAStencil_Sweeps(s, 1, PETSC_FALSE, scale, shift, omega, ba, xl);
+      }
+    } else if (flag & (SOR_FORWARD_SWEEP | SOR_LOCAL_FORWARD_SWEEP)) {
+      MatSOR_DAStencil_Sweeps(s, lits, PETSC_TRUE, scale, shift, omega, ba, xl);
+    } else if (flag & (SOR_BACKWARD_SWEEP | SOR_LOCAL_BACKWARD_SWEEP)) {
+      MatSOR_DAStencil_Sweeps(s, lits, PETSC_FALSE, scale, shift, omega, ba, xl);
+    }
+    /* copy the owned points back */
+    PetscCall(VecGetArrayWrite(x, &xa));
+    for (PetscInt k = info->zs; k < info->zs + info->zm; k++) {
+      for (PetscInt j = info->ys; j < info->ys + info->ym; j++) {
+        PetscCall(PetscArraycpy(xa + info->xm * ((j - info->ys) + info->ym * (k - info->zs)), xl + (info->xs - info->gxs) + info->gxm * ((j - info->gys) + info->gym * (k - info->gzs)), info->xm));
+      }
+    }
+    PetscCall(VecRestoreArrayWrite(x, &xa));
+    PetscCall(VecRestoreArray(s->xl, &xl));
+  }
+  PetscCall(VecRestoreArrayRead(b, &ba));
+  PetscCall(PetscLogFlops(2.0 * its * lits * s->n * info->xm * info->ym * info->zm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSetFromOptions_DAStencil(Mat A, PetscOptionItems *PetscOptionsObject)
+{
+  Mat_DAStencil *s;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &s));
+  PetscOptionsHeadBegin(PetscOptionsObject, "DMDA stencil matrix options");
+  PetscCall(PetscOptionsInt("-mat_da_stencil_tile", "Number of rows in the tiles of the 3d product, 0 for automatic", "DMDACreateStencilMatrix", s->tile, &s->tile, NULL));
+  PetscCall(PetscOptionsBool("-mat_da_stencil_pipeline", "Pipeline the repeated local SOR sweeps over the planes", "DMDACreateStencilMatrix", s->pipeline, &s->pipeline, NULL));
+  PetscCall(PetscOptionsReal("-mat_da_stencil_fd_err", "Relative perturbation of the colored differencing", "DMDAStencilMatrixSetCoefficientsFD", s->fderr, &s->fderr, NULL));
+  PetscCall(PetscOptionsReal("-mat_da_stencil_fd_umin", "Smallest magnitude of the perturbed values", "DMDAStencilMatrixSetCoefficientsFD", s->fdumin, &s->fdumin, NULL));
+  PetscOptionsHeadEnd();
+  PetscCheck(s->tile >= 0, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_OUTOFRANGE, "Number of rows in a tile %" PetscInt_FMT " cannot be negative", s->tile);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_DAStencil(Mat A, PetscViewer viewer)
+{
+  Mat_DAStencil *s;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &s));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "DMDA stencil matrix with %" PetscInt_FMT " %s coefficients\n", s->n, s->cv ? "variable" : "constant"));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  tiles of %" PetscInt_FMT " rows%s, %s SOR sweeps\n", s->tile, s->tile ? "" : " (automatic)", s->pipeline ? "pipelined" : "consecutive"));
+    if (s->ncolors) PetscCall(PetscViewerASCIIPrintf(viewer, "  colored differencing with %" PetscInt_FMT " colors, %" PetscInt_FMT " function evaluations for %" PetscInt_FMT " products (%g per product)\n", s->ncolors, s->nfunc, s->nmult, s->nmult ? (double)s->nfunc / s->nmult : 0.0));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_DAStencil(Mat A)
+{
+  Mat_DAStencil *s;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &s));
+  PetscCall(PetscFree4(s->st, s->loff, s->valid, s->c));
+  PetscCall(PetscFree(s->cv));
+  PetscCall(PetscFree(s->diag));
+  PetscCall(VecDestroy(&s->xl));
+  PetscCall(DMDestroy(&s->da));
+  PetscCall(PetscFree(s));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "DMDAStencilMatrixGetContext_C", NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode DMDAStencilMatrixGetContext_DAStencil(Mat A, Mat_DAStencil **s)
+{
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, s));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode DMDAStencilMatrixGetContext_Private(Mat A, Mat_DAStencil **s)
+{
+  PetscFunctionBegin;
+  *s = NULL;
+  PetscTryMethod(A, "DMDAStencilMatrixGetContext_C", (Mat, Mat_DAStencil **), (A, s));
+  PetscCheck(*s, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_WRONG, "Not a matrix from DMDACreateStencilMatrix()");
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  DMDACreateStencilMatrix - Creates a matrix applying a stencil on a `DMDA` without storing its nonzeros
+
+  Collective
+
+  Input Parameters:
++ da      - the `DMDA`, with a single degree of freedom per point
+. n       - the number of entries of the stencil, ignored if `offsets` is `NULL`
+- offsets - the offsets of the entries in the i, j, and k directions, or `NULL` for the star or box stencil of the `DMDA`
+
+  Output Parameter:
+. A - the matrix
+
+  Options Database Keys:
++ -mat_da_stencil_tile <rows>       - number of rows in the tiles of the 3d product, 0 for automatic
+- -mat_da_stencil_pipeline <bool>   - pipeline the repeated local SOR sweeps over the planes (default true)
+
+  Level: intermediate
+
+  Notes:
+  The matrix is a `MATSHELL` and must be given its coefficients with `DMDAStencilMatrixSetCoefficients()` or
+  `DMDAStencilMatrixSetVariableCoefficients()` before it is used. It supports `MatMult()`, `MatGetDiagonal()`, and `MatSOR()`, so it
+  can be used with `PCJACOBI`, `PCSOR`, and as the smoother of the levels of `PCMG`, and `MatScale()` and `MatShift()`.
+
+  The product is applied row by row, one entry at a time, so that the inner loops are contiguous and vectorized. In 3d the rows are
+  swept in tiles so that the planes needed by the stencil stay in cache. Each of the `its` iterations of `MatSOR()` updates the ghost points
+  once, then performs `lits` local sweeps. Sweeps in the same direction are pipelined over the planes of the outermost dimension,
+  so that each plane is swept `lits` times while it is in cache, with the same result as consecutive sweeps.
+
+  The offsets cannot exceed the stencil width of the `DMDA`, and only one offset of an entry can be nonzero with `DMDA_STENCIL_STAR`. The
+  neighbors outside of the domain are dropped with `DM_BOUNDARY_NONE` and `DM_BOUNDARY_GHOSTED`, as for homogeneous Dirichlet
+  conditions, while the periodic and mirrored points are included. The `c` member of the offsets is not used. With periodic boundaries on a
+  single process, the ghost points are only updated between the `its` iterations of `MatSOR()`.
+
+  `DMCreateMatrix()` returns this matrix with the stencil of the `DMDA` after `DMDASetStencilMatrix()`, for example with `-da_stencil_matrix`.
+
+.seealso: [](ch_dmbase), `DM`, `DMDA`, `MATSHELL`, `DMDAStencilMatrixSetCoefficients()`, `DMDAStencilMatrixSetVariableCoefficients()`, `DMDAStencilMatrixGetStencil()`, `DMCreateMatrix()`,
+          `DMDASetStencilMatrix()`
+@*/
+PetscErrorCode DMDACreateStencilMatrix(DM da, PetscInt n, const MatStencil offsets[], Mat *A)
+{
+  Mat_DAStencil *s;
+  PetscInt       dof, nown, bd[3];
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da, DM_CLASSID, 1, DMDA);
+  PetscAssertPointer(A, 4);
+  PetscCall(DMDAGetDof(da, &dof));
+  PetscCheck(dof == 1, PetscObjectComm((PetscObject)da), PETSC_ERR_SUP, "Only a single degree of freedom per point is supported, not %" PetscInt_FMT, dof);
+  PetscCall(PetscNew(&s));
+  PetscCall(PetscObjectReference((PetscObject)da));
+  s->da       = da;
+  s->pipeline = PETSC_TRUE;
+  s->fderr    = PETSC_SQRT_MACHINE_EPSILON;
+  s->fdumin   = 100.0 * PETSC_SQRT_MACHINE_EPSILON;
+  PetscCall(DMDAGetLocalInfo(da, &s->info));
+  if (!offsets) {
+    const PetscInt sw = s->info.sw, ny = s->info.dim > 1 ? sw : 0, nz = s->info.dim > 2 ? sw : 0;
+
+    n = 0;
+    for (PetscInt k = -nz; k <= nz; k++)
+      for (PetscInt j = -ny; j <= ny; j++)
+        for (PetscInt i = -sw; i <= sw; i++) n += (s->info.st == DMDA_STENCIL_BOX || (!j && !k) || (!i && !k) || (!i && !j));
+  }
+  PetscCheck(n > 0, PetscObjectComm((PetscObject)da), PETSC_ERR_ARG_OUTOFRANGE, "Number of stencil entries %" PetscInt_FMT " must be positive", n);
+  s->n = n;
+  PetscCall(PetscMalloc4(n, &s->st, n, &s->loff, n, &s->valid, n, &s->c));
+  if (offsets) PetscCall(PetscArraycpy(s->st, offsets, n));
+  else {
+    const PetscInt sw = s->info.sw, ny = s->info.dim > 1 ? sw : 0, nz = s->info.dim > 2 ? sw : 0;
+
+    n = 0;
+    for (PetscInt k = -nz; k <= nz; k++)
+      for (PetscInt j = -ny; j <= ny; j++)
+        for (PetscInt i = -sw; i <= sw; i++) {
+          if (s->info.st == DMDA_STENCIL_BOX || (!j && !k) || (!i && !k) || (!i && !j)) {
+            s->st[n].i = i;
+            s->st[n].j = j;
+            s->st[n].k = k;
+            s->st[n].c = 0;
+            n++;
+          }
+        }
+  }
+  for (PetscInt e = 0; e < s->n; e++) {
+    const MatStencil *o = &s->st[e];
+
+    PetscCheck(PetscAbs(o->i) <= s->info.sw && PetscAbs(o->j) <= s->info.sw && PetscAbs(o->k) <= s->info.sw, PetscObjectComm((PetscObject)da), PETSC_ERR_ARG_OUTOFRANGE, "Offsets (%" PetscInt_FMT ", %" PetscInt_FMT ", %" PetscInt_FMT ") of entry %" PetscInt_FMT " exceed the stencil width %" PetscInt_FMT, o->i, o->j, o->k, e, s->info.sw);
+    PetscCheck((s->info.dim > 1 || !o->j) && (s->info.dim > 2 || !o->k), PetscObjectComm((PetscObject)da), PETSC_ERR_ARG_OUTOFRANGE, "Offsets (%" PetscInt_FMT ", %" PetscInt_FMT ", %" PetscInt_FMT ") of entry %" PetscInt_FMT " are not zero beyond dimension %" PetscInt_FMT, o->i, o->j, o->k, e, s->info.dim);
+    PetscCheck(s->info.st == DMDA_STENCIL_BOX || (!o->j && !o->k) || (!o->i && !o->k) || (!o->i && !o->j), PetscObjectComm((PetscObject)da), PETSC_ERR_ARG_OUTOFRANGE, "Offsets (%" PetscInt_FMT ", %" PetscInt_FMT ", %" PetscInt_FMT ") of entry %" PetscInt_FMT " need a DMDA_STENCIL_BOX", o->i, o->j, o->k, e);
+    s->loff[e] = o->i + s->info.gxm * (o->j + s->info.gym * o->k);
+    s->w       = PetscMax(s->w, PetscAbs(s->info.dim == 3 ? o->k : (s->info.dim == 2 ? o->j : 0)));
+  }
+  /* the ghost points beyond a boundary are only defined for periodic and mirrored boundaries */
+  bd[0] = s->info.bx;
+  bd[1] = s->info.by;
+  bd[2] = s->info.bz;
+  for (PetscInt d = 0; d < 3; d++) {
+    const PetscInt gs = d == 0 ? s->info.gxs : (d == 1 ? s->info.gys : s->info.gzs), gm = d == 0 ? s->info.gxm : (d == 1 ? s->info.gym : s->info.gzm);
+    const PetscInt M  = d == 0 ? s->info.mx : (d == 1 ? s->info.my : s->info.mz);
+
+    s->lo[d] = gs;
+    s->hi[d] = gs + gm;
+    if (d >= s->info.dim) {
+      s->lo[d] = 0;
+      s->hi[d] = 1;
+    } else if (bd[d] == DM_BOUNDARY_GHOSTED) {
+      s->lo[d] = PetscMax(gs, 0);
+      s->hi[d] = PetscMin(gs + gm, M);
+    }
+  }
+  PetscCall(DMCreateLocalVector(da, &s->xl));
+
+  nown = s->info.xm * s->info.ym * s->info.zm;
+  PetscCall(MatCreateShell(PetscObjectComm((PetscObject)da), nown, nown, PETSC_DETERMINE, PETSC_DETERMINE, s, A));
+  PetscCall(MatShellSetOperation(*A, MATOP_MULT, (void (*)(void))MatMult_DAStencil));
+  PetscCall(MatShellSetOperation(*A, MATOP_GET_DIAGONAL, (void (*)(void))MatGetDiagonal_DAStencil));
+  PetscCall(MatShellSetOperation(*A, MATOP_SOR, (void (*)(void))MatSOR_DAStencil));
+  PetscCall(MatShellSetOperation(*A, MATOP_SET_FROM_OPTIONS, (void (*)(void))MatSetFromOptions_DAStencil));
+  PetscCall(MatShellSetOperation(*A, MATOP_VIEW, (void (*)(void))MatView_DAStencil));
+  PetscCall(MatShellSetOperation(*A, MATOP_DESTROY, (void (*)(void))MatDestroy_DAStencil));
+  PetscCall(PetscObjectComposeFunction((PetscObject)*A, "DMDAStencilMatrixGetContext_C", DMDAStencilMatrixGetContext_DAStencil));
+  PetscCall(MatSetDM(*A, da));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  DMDAStencilMatrixSetCoefficients - Sets constant coefficients of the entries of a matrix from `DMDACreateStencilMatrix()`
+
+  Logically Collective
+
+  Input Parameters:
++ A - the matrix
+- c - the coefficients of the entries, in the order of the offsets
+
+  Level: intermediate
+
+  Note:
+  The coefficients are copied, so this must be called again after they change.
+
+.seealso: [](ch_dmbase), `DM`, `DMDA`, `DMDACreateStencilMatrix()`, `DMDAStencilMatrixSetVariableCoefficients()`, `DMDAStencilMatrixGetStencil()`
+@*/
+PetscErrorCode DMDAStencilMatrixSetCoefficients(Mat A, const PetscScalar c[])
+{
+  Mat_DAStencil *s;
+  PetscScalar    d = 0.0;
+  PetscInt       nown;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  PetscAssertPointer(c, 2);
+  PetscCall(DMDAStencilMatrixGetContext_Private(A, &s));
+  nown = s->info.xm * s->info.ym * s->info.zm;
+  PetscCall(PetscFree(s->cv));
+  if (!s->diag) PetscCall(PetscMalloc1(nown, &s->diag));
+  for (PetscInt e = 0; e < s->n; e++) {
+    s->c[e] = c[e];
+    if (!s->loff[e]) d += c[e];
+  }
+  for (PetscInt p = 0; p < nown; p++) s->diag[p] = d;
+  PetscCall(PetscObjectStateIncrease((PetscObject)A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  DMDAStencilMatrixSetVariableCoefficients - Sets coefficients of the entries of a matrix from `DMDACreateStencilMatrix()` that vary from point to point
+
+  Collective
+
+  Input Parameters:
++ A - the matrix
+- c - the coefficients, with the coefficients of the entries of each owned point contiguous, in the order of the offsets
+
+  Level: intermediate
+
+  Notes:
+  The vector `c` has the layout of a global vector of the `DMDA` with the number of entries as degrees of freedom, see
+  `DMDACreateCompatibleDMDA()`, so the coefficients of the point (i, j) are `ca[j][i][e]` with `DMDAVecGetArrayDOF()`.
+
+  The coefficients are copied, so this must be called again after they change.
+
+.seealso: [](ch_dmbase), `DM`, `DMDA`, `DMDACreateStencilMatrix()`, `DMDAStencilMatrixSetCoefficients()`, `DMDACreateCompatibleDMDA()`
+@*/
+PetscErrorCode DMDAStencilMatrixSetVariableCoefficients(Mat A, Vec c)
+{
+  Mat_DAStencil     *s;
+  const PetscScalar *ca;
+  PetscInt           nown, nc;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  PetscValidHeaderSpecific(c, VEC_CLASSID, 2);
+  PetscCall(DMDAStencilMatrixGetContext_Private(A, &s));
+  nown = s->info.xm * s->info.ym * s->info.zm;
+  PetscCall(VecGetLocalSize(c, &nc));
+  PetscCheck(nc == s->n * nown, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Local size %" PetscInt_FMT " of the coefficients should be %" PetscInt_FMT " entries times %" PetscInt_FMT " points", nc, s->n, nown);
+  if (!s->cv) PetscCall(PetscMalloc1(s->n * nown, &s->cv));
+  if (!s->diag) PetscCall(PetscMalloc1(nown, &s->diag));
+  PetscCall(VecGetArrayRead(c, &ca));
+  for (PetscInt p = 0; p < nown; p++) {
+    s->diag[p] = 0.0;
+    for (PetscInt e = 0; e < s->n; e++) {
+      s->cv[e * nown + p] = ca[p * s->n + e];
+      if (!s->loff[e]) s->diag[p] += ca[p * s->n + e];
+    }
+  }
+  PetscCall(VecRestoreArrayRead(c, &ca));
+  PetscCall(PetscObjectStateIncrease((PetscObject)A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* greatest common divisor of the positive a and b */
+static inline PetscInt MatDAStencilGCD_Private(PetscInt a, PetscInt b)
+{
+  while (b) {
+    const PetscInt r = a % b;
+
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+/*
+  Finds a linear coloring of the points, the color of (i, j, k) being (cmul[0] i + cmul[1] j + cmul[2] k) mod ncolors, such that the
+  neighbors of a point in the stencil all have different colors. The fewest colors are searched from the number of entries, which is
+  reached by the 5-point and 7-point stars, up to twice the number of colors of the box coloring. With periodic boundaries the multiplier
+  times the number of points must vanish modulo the number of colors, so that the colors wrap around the domain.
+*/
+static PetscErrorCode MatDAStencilCreateColoring_Private(Mat A, Mat_DAStencil *s)
+{
+  const DMDALocalInfo *info = &s->info;
+  const PetscInt       M[3] = {info->mx, info->my, info->mz}, dim = info->dim;
+  const PetscBool      per[3] = {(PetscBool)(info->bx == DM_BOUNDARY_PERIODIC), (PetscBool)(info->by == DM_BOUNDARY_PERIODIC), (PetscBool)(info->bz == DM_BOUNDARY_PERIODIC)};
+  PetscInt             w[3] = {0, 0, 0}, qmax = 2;
+
+  PetscFunctionBegin;
+  PetscCheck(info->bx != DM_BOUNDARY_MIRROR && info->by != DM_BOUNDARY_MIRROR && info->bz != DM_BOUNDARY_MIRROR, PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "Colored differencing is not supported with DM_BOUNDARY_MIRROR");
+  for (PetscInt e = 0; e < s->n; e++) {
+    w[0] = PetscMax(w[0], PetscAbs(s->st[e].i));
+    w[1] = PetscMax(w[1], PetscAbs(s->st[e].j));
+    w[2] = PetscMax(w[2], PetscAbs(s->st[e].k));
+  }
+  for (PetscInt d = 0; d < dim; d++) qmax *= 2 * w[d] + 1;
+  for (PetscInt q = s->n; q <= qmax; q++) {
+    PetscInt step[3];
+
+    for (PetscInt d = 0; d < 3; d++) step[d] = d < dim && per[d] ? q / MatDAStencilGCD_Private(M[d], q) : 1;
+    /* without periodicity in the first dimension, its multiplier can be scaled to 1 */
+    for (PetscInt a0 = step[0]; a0 < (per[0] ? q : 2); a0 += step[0]) {
+      for (PetscInt a1 = 0; a1 < (dim > 1 ? q : 1); a1 += step[1]) {
+        for (PetscInt a2 = 0; a2 < (dim > 2 ? q : 1); a2 += step[2]) {
+          PetscBool valid = PETSC_TRUE;
+
+          for (PetscInt e = 0; e < s->n && valid; e++)
+            for (PetscInt f = e + 1; f < s->n && valid; f++) valid = (PetscBool)((a0 * (s->st[e].i - s->st[f].i) + a1 * (s->st[e].j - s->st[f].j) + a2 * (s->st[e].k - s->st[f].k)) % q != 0);
+          if (valid) {
+            s->ncolors = q;
+            s->cmul[0] = a0;
+            s->cmul[1] = a1;
+            s->cmul[2] = a2;
+            PetscFunctionReturn(PETSC_SUCCESS);
+          }
+        }
+      }
+    }
+  }
+  SETERRQ(PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "No coloring of the stencil with at most %" PetscInt_FMT " colors is compatible with the periodic boundaries, change the number of points", qmax);
+}
+
+static inline PetscScalar MatDAStencilFDStep_Private(Mat_DAStencil *s, PetscScalar u)
+{
+  if (PetscAbsScalar(u) < s->fdumin) u = PetscRealPart(u) >= 0.0 ? s->fdumin : -s->fdumin;
+  return s->fderr * u;
+}
+
+/*@C
+  DMDAStencilMatrixSetCoefficientsFD - Sets the variable coefficients of a matrix from `DMDACreateStencilMatrix()` to the Jacobian of a
+  function by colored differencing
+
+  Collective
+
+  Input Parameters:
++ A    - the matrix
+. x    - the global vector at which the Jacobian is computed
+. f    - the value of the function at `x`, or `NULL` to evaluate it
+. func - the function
+- ctx  - optional context for `func`
+
+  Calling sequence of `func`:
++ x   - the global vector at which to evaluate the function
+. f   - the global vector to hold the value of the function
+- ctx - the optional context
+
+  Options Database Keys:
++ -mat_da_stencil_fd_err <err>   - relative perturbation of the values, see `MatFDColoringSetParameters()`
+- -mat_da_stencil_fd_umin <umin> - smallest magnitude of the perturbed values
+
+  Level: intermediate
+
+  Notes:
+  The function must only couple the points within the stencil of the matrix. The points are colored so that the neighbors of any
+  point in the stencil have different colors, so the function is evaluated once per color, with all the points of the color perturbed, and
+  the change of the function at a point is attributed to the entry of the stencil whose neighbor has the color. The colors are linear in
+  the indices of the points, which gives 5 colors for the 5-point star in 2d, as `DMCreateColoring()` does, and 7 for the 7-point star in 3d,
+  instead of 27. With periodic boundaries the number of points must be compatible with a coloring, in the worst case a multiple of the
+  number of colors of the box coloring in each direction.
+
+  Each color evaluates the whole function, so computing the coefficients costs as many function evaluations as `MatFDColoringApply()`
+  with the same number of colors, plus one if `f` is `NULL`, which is the cost of `-snes_fd_color`. The perturbations are not restricted
+  to the stencil of the perturbed points and no element contributions are cached between the colors. What is saved is the storage and
+  the products: `MatMult()` costs about as many operations per point as there are entries of the stencil, as for `DMDACreateStencilMatrix()`.
+  `MatView()` reports the function evaluations per product.
+
+  This is used by `SNES` to compute the Jacobian of a function set with `DMDASNESSetFunctionLocal()` when the `DMDA` creates its matrices with
+  `DMDASetStencilMatrix()`, see `DMCreateMatrix()`.
+
+.seealso: [](ch_dmbase), `DM`, `DMDA`, `DMDACreateStencilMatrix()`, `DMDAStencilMatrixSetVariableCoefficients()`, `MatFDColoringCreate()`, `MatCreateSNESMF()`
+@*/
+PetscErrorCode DMDAStencilMatrixSetCoefficientsFD(Mat A, Vec x, Vec f, PetscErrorCode (*func)(Vec x, Vec f, void *ctx), void *ctx)
+{
+  Mat_DAStencil       *s;
+  const DMDALocalInfo *info;
+  Vec                  f0 = f, xp, fp;
+  const PetscScalar   *xa, *xl, *f0a, *fpa;
+  PetscScalar         *xpa;
+  PetscInt            *color, *entry, nown, q;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 2);
+  if (f) PetscValidHeaderSpecific(f, VEC_CLASSID, 3);
+  PetscCall(DMDAStencilMatrixGetContext_Private(A, &s));
+  info = &s->info;
+  nown = info->xm * info->ym * info->zm;
+  if (!s->ncolors) PetscCall(MatDAStencilCreateColoring_Private(A, s));
+  q = s->ncolors;
+  PetscCall(VecDuplicate(x, &xp));
+  PetscCall(VecDuplicate(x, &fp));
+  if (!f0) {
+    PetscCall(VecDuplicate(x, &f0));
+    PetscCall((*func)(x, f0, ctx));
+    s->nfunc++;
+  }
+  PetscCall(DMGlobalToLocalBegin(s->da, x, INSERT_VALUES, s->xl));
+  PetscCall(DMGlobalToLocalEnd(s->da, x, INSERT_VALUES, s->xl));
+  if (!s->cv) PetscCall(PetscMalloc1(s->n * nown, &s->cv));
+  if (!s->diag) PetscCall(PetscMalloc1(nown, &s->diag));
+  PetscCall(PetscArrayzero(s->cv, s->n * nown));
+
+  /* the neighbor of entry e of a point of color c has the color c + (cmul . offset_e) mod q, which differs between the entries */
+  PetscCall(PetscMalloc2(nown, &color, q, &entry));
+  for (PetscInt r = 0; r < q; r++) entry[r] = -1;
+  for (PetscInt e = 0; e < s->n; e++) entry[(((s->cmul[0] * s->st[e].i + s->cmul[1] * s->st[e].j + s->cmul[2] * s->st[e].k) % q) + q) % q] = e;
+  for (PetscInt k = info->zs, p = 0; k < info->zs + info->zm; k++)
+    for (PetscInt j = info->ys; j < info->ys + info->ym; j++)
+      for (PetscInt i = info->xs; i < info->xs + info->xm; i++, p++) color[p] = (s->cmul[0] * i + s->cmul[1] * j + s->cmul[2] * k) % q;
+
+  PetscCall(VecGetArrayRead(x, &xa));
+  PetscCall(VecGetArrayRead(f0, &f0a));
+  PetscCall(VecGetArrayRead(s->xl, &xl));
+  for (PetscInt c = 0; c < q; c++) {
+    PetscCall(VecGetArrayWrite(xp, &xpa));
+    for (PetscInt p = 0; p < nown; p++) xpa[p] = color[p] == c ? xa[p] + MatDAStencilFDStep_Private(s, xa[p]) : xa[p];
+    PetscCall(VecRestoreArrayWrite(xp, &xpa));
+    PetscCall((*func)(xp, fp, ctx));
+    s->nfunc++;
+    PetscCall(VecGetArrayRead(fp, &fpa));
+    for (PetscInt k = info->zs, p = 0; k < info->zs + info->zm; k++)
+      for (PetscInt j = info->ys; j < info->ys + info->ym; j++) {
+        const PetscScalar *xr = xl + (info->xs - info->gxs) + info->gxm * ((j - info->gys) + info->gym * (k - info->gzs));
+
+        MatDAStencilSetRow_Private(s, j, k);
+        for (PetscInt i = info->xs; i < info->xs + info->xm; i++, p++) {
+          const PetscInt e = entry[(c - color[p] + q) % q];
+
+          if (e < 0 || !s->valid[e] || i + s->st[e].i < s->lo[0] || i + s->st[e].i >= s->hi[0]) continue;
+          s->cv[e * nown + p] = (fpa[p] - f0a[p]) / MatDAStencilFDStep_Private(s, xr[i - info->xs + s->loff[e]]);
+        }
+      }
+    PetscCall(VecRestoreArrayRead(fp, &fpa));
+  }
+  PetscCall(VecRestoreArrayRead(s->xl, &xl));
+  PetscCall(VecRestoreArrayRead(f0, &f0a));
+  PetscCall(VecRestoreArrayRead(x, &xa));
+  for (PetscInt p = 0; p < nown; p++) {
+    s->diag[p] = 0.0;
+    for (PetscInt e = 0; e < s->n; e++)
+      if (!s->loff[e]) s->diag[p] += s->cv[e * nown + p];
+  }
+  PetscCall(PetscFree2(color, entry));
+  PetscCall(VecDestroy(&xp));
+  PetscCall(VecDestroy(&fp));
+  if (!f) PetscCall(VecDestroy(&f0));
+  PetscCall(PetscObjectStateIncrease((PetscObject)A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  DMDAStencilMatrixGetStencil - Gets the offsets of the entries of a matrix from `DMDACreateStencilMatrix()`
+
+  Not Collective
+
+  Input Parameter:
+. A - the matrix
+
+  Output Parameters:
++ n       - the number of entries, or `NULL`
+- offsets - the offsets of the entries, or `NULL`
+
+  Level: intermediate
+
+.seealso: [](ch_dmbase), `DM`, `DMDA`, `DMDACreateStencilMatrix()`, `DMDAStencilMatrixSetCoefficients()`
+@*/
+PetscErrorCode DMDAStencilMatrixGetStencil(Mat A, PetscInt *n, const MatStencil *offsets[])
+{
+  Mat_DAStencil *s;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 1);
+  PetscCall(DMDAStencilMatrixGetContext_Private(A, &s));
+  if (n) *n = s->n;
+  if (offsets) *offsets = s->st;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  DMDASetStencilMatrix - Sets whether `DMCreateMatrix()` returns a matrix from `DMDACreateStencilMatrix()` with the stencil of the `DMDA`
+
+  Logically Collective
+
+  Input Parameters:
++ da  - the `DMDA`, with a single degree of freedom per point
+- flg - `PETSC_TRUE` to create the stencil matrix, `PETSC_FALSE` to create the matrix of type `DMSetMatType()`
+
+  Options Database Key:
+. -da_stencil_matrix <bool> - create the stencil matrix
+
+  Level: intermediate
+
+  Note:
+  The stencil matrix is a `MATSHELL`, but `DMCreateMatrix()` with the type `MATSHELL` still returns an empty shell for the application.
+
+.seealso: [](ch_dmbase), `DM`, `DMDA`, `DMDAGetStencilMatrix()`, `DMDACreateStencilMatrix()`, `DMCreateMatrix()`, `DMDAStencilMatrixSetCoefficientsFD()`
+@*/
+PetscErrorCode DMDASetStencilMatrix(DM da, PetscBool flg)
+{
+  DM_DA *dd = (DM_DA *)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da, DM_CLASSID, 1, DMDA);
+  PetscValidLogicalCollectiveBool(da, flg, 2);
+  dd->stencilmatrix = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  DMDAGetStencilMatrix - Gets whether `DMCreateMatrix()` returns a matrix from `DMDACreateStencilMatrix()`
+
+  Not Collective
+
+  Input Parameter:
+. da - the `DMDA`
+
+  Output Parameter:
+. flg - `PETSC_TRUE` if the stencil matrix is created
+
+  Level: intermediate
+
+.seealso: [](ch_dmbase), `DM`, `DMDA`, `DMDASetStencilMatrix()`, `DMDACreateStencilMatrix()`, `DMCreateMatrix()`
+@*/
+PetscErrorCode DMDAGetStencilMatrix(DM da, PetscBool *flg)
+{
+  DM_DA *dd = (DM_DA *)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da, DM_CLASSID, 1, DMDA);
+  PetscAssertPointer(flg, 2);
+  *flg = dd->stencilmatrix;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -233,3 +233,93 @@ PetscErrorCode DMDAGetLocalInfo(DM da, DMDALocalInfo *info)
   info->gzm = (dd->Ze - dd->Zs);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*@
+  DMDAGetLocalInfoSplit - Splits the points owned by this MPI process into the interior points, whose stencil only contains owned points, and
+  boxes of points next to the ghost points
+
+  Not Collective
+
+  Input Parameter:
+. da - the `DMDA`
+
+  Output Parameters:
++ interior  - structure describing the box of interior points in its `xs`, `xm`, `ys`, `ym`, `zs`, and `zm`, the other fields are those of `DMDAGetLocalInfo()`
+. nboundary - the number of boxes of boundary points
+- boundary  - structures describing the boxes of boundary points, an array of length at least `2*dim`
+
+  Level: advanced
+
+  Notes:
+  The boxes of `interior` and `boundary` do not overlap and cover the points owned by this MPI process. A box is a candidate for
+  interior only away from the sides with ghost points, the sides at a nonperiodic domain boundary without ghost points do not shrink it.
+
+  The residual at the interior points only needs the values of the global vector, so it can be evaluated while the ghost points are
+  communicated, see `DMDASNESSetFunctionLocalSplit()`. If there is no interior point, `interior` has `xm`, `ym`, and `zm` of 0 and the only
+  boundary box is the whole of the owned points.
+
+.seealso: [](sec_struct), `DM`, `DMDA`, `DMDAGetLocalInfo()`, `DMDALocalInfo`, `DMDASNESSetFunctionLocalSplit()`, `DMDATSSetRHSFunctionLocalSplit()`
+@*/
+PetscErrorCode DMDAGetLocalInfoSplit(DM da, DMDALocalInfo *interior, PetscInt *nboundary, DMDALocalInfo boundary[])
+{
+  DMDALocalInfo info;
+  PetscInt      lo[3], hi[3], s[3], e[3];
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da, DM_CLASSID, 1, DMDA);
+  PetscAssertPointer(interior, 2);
+  PetscAssertPointer(nboundary, 3);
+  PetscAssertPointer(boundary, 4);
+  PetscCall(DMDAGetLocalInfo(da, &info));
+  s[0] = info.xs;
+  s[1] = info.ys;
+  s[2] = info.zs;
+  e[0] = info.xs + info.xm;
+  e[1] = info.ys + info.ym;
+  e[2] = info.zs + info.zm;
+  /* the ghost points are on the sides where the ghosted box is larger than the owned box */
+  lo[0] = 2 * info.xs - info.gxs;
+  lo[1] = 2 * info.ys - info.gys;
+  lo[2] = 2 * info.zs - info.gzs;
+  hi[0] = 2 * e[0] - (info.gxs + info.gxm);
+  hi[1] = 2 * e[1] - (info.gys + info.gym);
+  hi[2] = 2 * e[2] - (info.gzs + info.gzm);
+  *interior    = info;
+  *nboundary   = 0;
+  interior->xm = interior->ym = interior->zm = 0;
+  if (lo[0] >= hi[0] || lo[1] >= hi[1] || lo[2] >= hi[2]) {
+    if (info.xm && info.ym && info.zm) boundary[(*nboundary)++] = info;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  interior->xs = lo[0];
+  interior->xm = hi[0] - lo[0];
+  interior->ys = lo[1];
+  interior->ym = hi[1] - lo[1];
+  interior->zs = lo[2];
+  interior->zm = hi[2] - lo[2];
+  /* slabs normal to z over the whole owned box, then normal to y and x over the remaining box */
+  for (PetscInt d = 2; d >= 0; --d) {
+    for (PetscInt side = 0; side < 2; ++side) {
+      DMDALocalInfo *b  = &boundary[*nboundary];
+      PetscInt       bs = side ? hi[d] : s[d], be = side ? e[d] : lo[d];
+      PetscInt       bxs[3], bxm[3];
+
+      if (be <= bs) continue;
+      for (PetscInt c = 0; c < 3; ++c) {
+        bxs[c] = c < d ? s[c] : lo[c];
+        bxm[c] = c < d ? e[c] - s[c] : hi[c] - lo[c];
+      }
+      bxs[d] = bs;
+      bxm[d] = be - bs;
+      *b     = info;
+      b->xs  = bxs[0];
+      b->xm  = bxm[0];
+      b->ys  = bxs[1];
+      b->ym  = bxm[1];
+      b->zs  = bxs[2];
+      b->zm  = bxm[2];
+      ++(*nboundary);
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
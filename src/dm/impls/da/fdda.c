@@ -620,6 +620,13 @@ PetscErrorCode DMCreateMatrix_DA(DM da, Mat *J)
   PetscCall(MatInitializePackage());
   mtype = da->mattype;
 
+  /* the stencil matrix applies the stencil of the DMDA without storing its nonzeros */
+  if (dd->stencilmatrix) {
+    PetscCall(DMDACreateStencilMatrix(da, 0, NULL, J));
+    PetscCall(MatSetFromOptions(*J));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   /*
                                   m
           ------------------------------------------------------
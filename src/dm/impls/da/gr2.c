@@ -506,8 +506,7 @@ static PetscErrorCode VecView_MPI_HDF5_DA(Vec xin, PetscViewer viewer)
   PetscCall(PetscObjectGetName((PetscObject)xin, &vecname));
   if (!H5Lexists(group, vecname, H5P_DEFAULT)) {
     /* Create chunk */
-    PetscCallHDF5Return(chunkspace, H5Pcreate, (H5P_DATASET_CREATE));
-    PetscCallHDF5(H5Pset_chunk, (chunkspace, dim, chunkDims));
+    PetscCall(PetscViewerHDF5CreateDatasetPList_Internal(viewer, dim, chunkDims, &chunkspace));
 
     PetscCallHDF5Return(dset_id, H5Dcreate2, (group, vecname, filescalartype, filespace, H5P_DEFAULT, chunkspace, H5P_DEFAULT));
   } else {
@@ -547,7 +546,7 @@ static PetscErrorCode VecView_MPI_HDF5_DA(Vec xin, PetscViewer viewer)
 
   PetscCall(VecGetArrayRead(xin, &x));
   PetscCallHDF5(H5Dwrite, (dset_id, memscalartype, memspace, filespace, hdf5->dxpl_id, x));
-  PetscCallHDF5(H5Fflush, (file_id, H5F_SCOPE_GLOBAL));
+  if (hdf5->datasetFlush) PetscCallHDF5(H5Fflush, (file_id, H5F_SCOPE_GLOBAL));
   PetscCall(VecRestoreArrayRead(xin, &x));
 
   #if defined(PETSC_USE_COMPLEX)
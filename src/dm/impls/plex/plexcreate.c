@@ -4547,7 +4547,7 @@ static PetscErrorCode DMSetFromOptions_Plex(DM dm, PetscOptionItems *PetscOption
   DMReorderDefaultFlag reorder;
   PetscReal            volume    = -1.0;
   PetscInt             prerefine = 0, refine = 0, r, coarsen = 0, overlap = 0, extLayers = 0, dim;
-  PetscBool            uniformOrig = PETSC_FALSE, created = PETSC_FALSE, uniform = PETSC_TRUE, distribute, saveSF = PETSC_FALSE, interpolate = PETSC_TRUE, coordSpace = PETSC_TRUE, remap = PETSC_TRUE, ghostCells = PETSC_FALSE, isHierarchy, flg;
+  PetscBool            uniformOrig = PETSC_FALSE, created = PETSC_FALSE, uniform = PETSC_TRUE, distribute, saveSF = PETSC_FALSE, interpolate = PETSC_TRUE, coordSpace = PETSC_TRUE, remap = PETSC_TRUE, ghostCells = PETSC_FALSE, reorderView = PETSC_FALSE, isHierarchy, flg;
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject, "DMPlex Options");
@@ -4656,16 +4656,24 @@ static PetscErrorCode DMSetFromOptions_Plex(DM dm, PetscOptionItems *PetscOption
   PetscCall(DMPlexReorderGetDefault(dm, &reorder));
   PetscCall(MatGetOrderingList(&ordlist));
   PetscCall(PetscStrncpy(oname, MATORDERINGNATURAL, sizeof(oname)));
-  PetscCall(PetscOptionsFList("-dm_plex_reorder", "Set mesh reordering type", "DMPlexGetOrdering", ordlist, MATORDERINGNATURAL, oname, sizeof(oname), &flg));
+  PetscCall(PetscOptionsFList("-dm_plex_reorder", "Set mesh reordering type (or hilbert, morton)", "DMPlexGetOrdering", ordlist, MATORDERINGNATURAL, oname, sizeof(oname), &flg));
+  PetscCall(PetscOptionsBool("-dm_plex_reorder_view", "Report ordering quality before and after reordering", "DMPlexComputeOrderingQuality", reorderView, &reorderView, NULL));
   if (reorder == DM_REORDER_DEFAULT_TRUE || flg) {
-    DM pdm;
-    IS perm;
+    DM        pdm;
+    IS        perm;
+    PetscInt  bw[2];
+    PetscReal span[2];
 
+    if (reorderView) PetscCall(DMPlexComputeOrderingQuality(dm, &bw[0], &span[0]));
     PetscCall(DMPlexGetOrdering(dm, oname, NULL, &perm));
     PetscCall(DMPlexPermute(dm, perm, &pdm));
     PetscCall(ISDestroy(&perm));
     PetscCall(DMPlexReplace_Internal(dm, &pdm));
     PetscCall(DMSetFromOptions_NonRefinement_Plex(dm, PetscOptionsObject));
+    if (reorderView) {
+      PetscCall(DMPlexComputeOrderingQuality(dm, &bw[1], &span[1]));
+      PetscCall(PetscPrintf(PetscObjectComm((PetscObject)dm), "Mesh ordering %s: bandwidth %" PetscInt_FMT " -> %" PetscInt_FMT ", average closure span %g -> %g\n", oname, bw[0], bw[1], (double)span[0], (double)span[1]));
+    }
   }
   /* Handle DMPlex distribution */
   PetscCall(DMPlexDistributeGetDefault(dm, &distribute));
@@ -5106,6 +5114,8 @@ PETSC_INTERN PetscErrorCode DMClone_Plex(DM dm, DM *newdm)
 . -dm_plex_remesh_bd                 - Allow changes to the boundary on remeshing
 . -dm_plex_max_projection_height     - Maximum mesh point height used to project locally
 . -dm_plex_regular_refinement        - Use special nested projection algorithm for regular refinement
+. -dm_plex_reorder <type>            - Reorder the mesh before distribution, using a `MatOrderingType` or `hilbert`/`morton` space-filling curves
+. -dm_plex_reorder_view              - Report the bandwidth and closure span before and after reordering
 . -dm_plex_reorder_section           - Use specialized blocking if available
 . -dm_plex_check_all                 - Perform all checks below
 . -dm_plex_check_symmetry            - Check that the adjacency information in the mesh is symmetric
@@ -1409,6 +1409,284 @@ static PetscErrorCode GmshCreateFE(MPI_Comm comm, const char prefix[], PetscBool
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_MPIIO)
+/* A contiguous piece of an ASCII file, holding the lines which start in the share of a byte range owned by this process */
+typedef struct {
+  char      *buf;   /* NUL-terminated file contents starting at byte offset base */
+  MPI_Offset base;  /* File offset of buf[0] */
+  size_t     len;   /* Number of bytes read */
+  size_t     first; /* Offset in buf of the first line owned by this process */
+  size_t     last;  /* Lines starting before this offset in buf are owned by this process */
+  PetscBool  eof;   /* The buffer extends to the end of the file */
+} GmshChunk;
+
+static PetscErrorCode GmshChunkRead_Private(MPI_File fh, MPI_Offset fsize, MPI_Offset start, MPI_Offset end, PetscMPIInt rank, PetscMPIInt size, GmshChunk *chunk)
+{
+  const MPI_Offset cs = start + ((end - start) * rank) / size;
+  const MPI_Offset ce = start + ((end - start) * (rank + 1)) / size;
+  /* Read the byte before our share to detect a line boundary, and enough after it to finish the last line */
+  const MPI_Offset rs = cs > start ? cs - 1 : cs;
+  const MPI_Offset re = PetscMin(fsize, ce + PETSC_MAX_PATH_LEN);
+  size_t           nread = 0;
+
+  PetscFunctionBegin;
+  chunk->base = rs;
+  chunk->len  = (size_t)(re - rs);
+  chunk->eof  = re == fsize ? PETSC_TRUE : PETSC_FALSE;
+  PetscCall(PetscMalloc1(chunk->len + 1, &chunk->buf));
+  while (nread < chunk->len) {
+    const int  count = (int)PetscMin(chunk->len - nread, (size_t)PETSC_MPI_INT_MAX);
+    MPI_Status status;
+    int        cnt;
+
+    PetscCallMPI(MPI_File_read_at(fh, rs + (MPI_Offset)nread, chunk->buf + nread, count, MPI_CHAR, &status));
+    PetscCallMPI(MPI_Get_count(&status, MPI_CHAR, &cnt));
+    PetscCheck(cnt > 0, PETSC_COMM_SELF, PETSC_ERR_FILE_READ, "Unexpected end of Gmsh file at offset %" PetscInt64_FMT, (PetscInt64)(rs + (MPI_Offset)nread));
+    nread += (size_t)cnt;
+  }
+  chunk->buf[chunk->len] = '\0';
+  chunk->first           = 0;
+  if (cs > start) {
+    /* The line containing byte cs belongs to the previous process unless it starts there */
+    const char *nl = strchr(chunk->buf, '\n');
+
+    chunk->first = nl ? (size_t)(nl - chunk->buf) + 1 : chunk->len;
+  }
+  chunk->last = (size_t)(ce - rs);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Return the next owned line in the chunk, starting at *pos, and advance *pos past it */
+static PetscErrorCode GmshChunkNextLine_Private(GmshChunk *chunk, size_t *pos, char **line, MPI_Offset *offset)
+{
+  char *nl;
+
+  PetscFunctionBegin;
+  *line = NULL;
+  if (*pos >= chunk->last || *pos >= chunk->len) PetscFunctionReturn(PETSC_SUCCESS);
+  *line   = chunk->buf + *pos;
+  *offset = chunk->base + (MPI_Offset)*pos;
+  nl      = strchr(*line, '\n');
+  PetscCheck(nl || chunk->eof, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Gmsh line at offset %" PetscInt64_FMT " is longer than %d characters", (PetscInt64)*offset, PETSC_MAX_PATH_LEN);
+  *pos = nl ? (size_t)(nl - chunk->buf) + 1 : chunk->len;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+typedef enum {
+  GMSH_MARKER_NODES,
+  GMSH_MARKER_END_NODES,
+  GMSH_MARKER_ELEMENTS,
+  GMSH_MARKER_END_ELEMENTS,
+  GMSH_MARKER_PERIODIC,
+  GMSH_NUM_MARKERS
+} GmshMarker;
+
+static const char *const GmshMarkers[] = {"$Nodes", "$EndNodes", "$Elements", "$EndElements", "$Periodic"};
+
+/* Parse the integers of an element line of a Gmsh 2.2 file, returning the number of tags and a pointer to the node numbers */
+static PetscErrorCode GmshParseElement_Private(char *line, MPI_Offset offset, long *cellType, long *numTags, long *tag, char **nodes)
+{
+  char *p = line, *q;
+  long  t;
+
+  PetscFunctionBegin;
+  (void)strtol(p, &q, 10);
+  *cellType = strtol(q, &p, 10);
+  *numTags  = strtol(p, &q, 10);
+  PetscCheck(q != p && *numTags >= 0, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Invalid Gmsh element at offset %" PetscInt64_FMT, (PetscInt64)offset);
+  PetscCall(GmshCellTypeCheck(*cellType));
+  *tag = -1;
+  for (t = 0; t < *numTags; ++t) {
+    const long val = strtol(q, &q, 10);
+
+    if (!t) *tag = val;
+  }
+  *nodes = q;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  DMPlexCreateGmshParallel_Private - Read an ASCII Gmsh 2.2 file on all processes at once
+
+  Every process scans a contiguous byte range of the file for section markers, and after these are exchanged, parses the
+  lines starting in its share of the $Nodes and $Elements sections. The cells of highest dimension and the vertices are
+  then handed to DMPlexCreateFromCellListParallelPetsc(), so that no process ever holds the whole mesh. The result is
+  distributed naively, and is meant to be repartitioned by DMPlexDistribute().
+*/
+static PetscErrorCode DMPlexCreateGmshParallel_Private(MPI_Comm comm, const char filename[], PetscBool interpolate, DM *dm)
+{
+  MPI_File        fh;
+  MPI_Offset      fsize, sections[2 * GMSH_NUM_MARKERS];
+  GmshChunk       chunk;
+  PetscInt64     *markers = NULL, *allMarkers;
+  PetscMPIInt     rank, size, numMarkers = 0, *counts, *displs, i;
+  PetscInt       *cells, *tags, numNodes = 0, numCells = 0, nodeStart = 0, Nn, NVertices, dim = 0, coordDim = -1, numCorners = 0, c, d;
+  PetscBool       periodic = PETSC_TRUE;
+  PetscReal      *coords;
+  DMPolytopeType  ct = DM_POLYTOPE_UNKNOWN;
+  PetscLogDouble  mem[2], gmem[2];
+  size_t          pos, bytes;
+  char           *line;
+  MPI_Offset      offset;
+  PetscInt        buf[2], gbuf[2];
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-dm_plex_gmsh_spacedim", &coordDim, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-dm_plex_gmsh_periodic", &periodic, NULL));
+  PetscCall(GmshCellInfoSetUp());
+  PetscCall(PetscLogEventBegin(DMPLEX_CreateGmsh, NULL, NULL, NULL, NULL));
+  PetscCallMPI(MPI_File_open(comm, filename, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh));
+  PetscCallMPI(MPI_File_get_size(fh, &fsize));
+
+  /* Locate the section markers, each process scanning its share of the file */
+  PetscCall(GmshChunkRead_Private(fh, fsize, 0, fsize, rank, size, &chunk));
+  for (pos = chunk.first;;) {
+    PetscCall(GmshChunkNextLine_Private(&chunk, &pos, &line, &offset));
+    if (!line) break;
+    if (line[0] != '$') continue;
+    for (i = 0; i < GMSH_NUM_MARKERS; ++i) {
+      size_t len;
+
+      PetscCall(PetscStrlen(GmshMarkers[i], &len));
+      if (!strncmp(line, GmshMarkers[i], len) && (line[len] == '\n' || line[len] == '\r' || line[len] == ' ' || line[len] == '\0')) break;
+    }
+    if (i == GMSH_NUM_MARKERS) continue;
+    PetscCall(PetscRealloc(sizeof(PetscInt64) * 3 * (numMarkers + 1), &markers));
+    /* Store the marker, its offset, and the offset of the following line */
+    markers[3 * numMarkers + 0] = i;
+    markers[3 * numMarkers + 1] = (PetscInt64)offset;
+    markers[3 * numMarkers + 2] = (PetscInt64)(chunk.base + (MPI_Offset)pos);
+    ++numMarkers;
+  }
+  bytes = chunk.len;
+  PetscCall(PetscFree(chunk.buf));
+  PetscCall(PetscMalloc2(size, &counts, size + 1, &displs));
+  numMarkers *= 3;
+  PetscCallMPI(MPI_Allgather(&numMarkers, 1, MPI_INT, counts, 1, MPI_INT, comm));
+  displs[0] = 0;
+  for (i = 0; i < size; ++i) displs[i + 1] = displs[i] + counts[i];
+  PetscCall(PetscMalloc1(displs[size], &allMarkers));
+  PetscCallMPI(MPI_Allgatherv(markers, numMarkers, MPIU_INT64, allMarkers, counts, displs, MPIU_INT64, comm));
+  PetscCall(PetscFree(markers));
+  for (i = 0; i < 2 * GMSH_NUM_MARKERS; ++i) sections[i] = -1;
+  for (i = 0; i < displs[size]; i += 3) {
+    const PetscInt64 m = allMarkers[i];
+
+    PetscCheck(sections[2 * m] < 0, comm, PETSC_ERR_SUP, "Parallel Gmsh reader does not support multiple %s sections", GmshMarkers[m]);
+    sections[2 * m + 0] = (MPI_Offset)allMarkers[i + 1];
+    sections[2 * m + 1] = (MPI_Offset)allMarkers[i + 2];
+  }
+  PetscCall(PetscFree(allMarkers));
+  PetscCall(PetscFree2(counts, displs));
+  for (i = 0; i < GMSH_MARKER_PERIODIC; ++i) PetscCheck(sections[2 * i] >= 0, comm, PETSC_ERR_FILE_UNEXPECTED, "Gmsh file %s has no %s section", filename, GmshMarkers[i]);
+  PetscCheck(sections[2 * GMSH_MARKER_PERIODIC] < 0 || !periodic, comm, PETSC_ERR_SUP, "Parallel Gmsh reader does not support periodic meshes, use -dm_plex_gmsh_periodic 0 to ignore the periodic section");
+
+  /* Read the vertices, which must be numbered consecutively from 1 */
+  PetscCall(GmshChunkRead_Private(fh, fsize, sections[2 * GMSH_MARKER_NODES + 1], sections[2 * GMSH_MARKER_END_NODES], rank, size, &chunk));
+  bytes = PetscMax(bytes, chunk.len);
+  for (pos = chunk.first;;) {
+    PetscCall(GmshChunkNextLine_Private(&chunk, &pos, &line, &offset));
+    if (!line) break;
+    if (offset != sections[2 * GMSH_MARKER_NODES + 1]) ++numNodes;
+  }
+  PetscCallMPI(MPI_Exscan(&numNodes, &nodeStart, 1, MPIU_INT, MPI_SUM, comm));
+  if (rank == 0) nodeStart = 0;
+  PetscCall(MPIU_Allreduce(&numNodes, &NVertices, 1, MPIU_INT, MPI_SUM, comm));
+  PetscCheck(NVertices > 0, comm, PETSC_ERR_FILE_UNEXPECTED, "Gmsh file %s has no nodes", filename);
+  PetscCall(PetscMalloc1(numNodes * 3, &coords));
+  buf[0] = 0;
+  for (pos = chunk.first, Nn = 0;;) {
+    char *p;
+
+    PetscCall(GmshChunkNextLine_Private(&chunk, &pos, &line, &offset));
+    if (!line) break;
+    if (offset == sections[2 * GMSH_MARKER_NODES + 1]) continue;
+    if (strtol(line, &p, 10) != nodeStart + Nn + 1) buf[0] = 1;
+    for (d = 0; d < 3; ++d) coords[Nn * 3 + d] = (PetscReal)strtod(p, &p);
+    ++Nn;
+  }
+  PetscCall(PetscFree(chunk.buf));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, buf, 1, MPIU_INT, MPI_MAX, comm));
+  PetscCheck(!buf[0], comm, PETSC_ERR_SUP, "Parallel Gmsh reader requires nodes numbered consecutively from 1");
+
+  /* Read the cells, which are the elements of highest dimension */
+  PetscCall(GmshChunkRead_Private(fh, fsize, sections[2 * GMSH_MARKER_ELEMENTS + 1], sections[2 * GMSH_MARKER_END_ELEMENTS], rank, size, &chunk));
+  bytes = PetscMax(bytes, chunk.len);
+  PetscCallMPI(MPI_File_close(&fh));
+  for (pos = chunk.first;;) {
+    char *nodes;
+    long  cellType, numTags, tag;
+
+    PetscCall(GmshChunkNextLine_Private(&chunk, &pos, &line, &offset));
+    if (!line) break;
+    if (offset == sections[2 * GMSH_MARKER_ELEMENTS + 1]) continue;
+    PetscCall(GmshParseElement_Private(line, offset, &cellType, &numTags, &tag, &nodes));
+    dim = PetscMax(dim, GmshCellMap[cellType].dim);
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &dim, 1, MPIU_INT, MPI_MAX, comm));
+  /* Every cell must have the same type, so record the largest and the negated smallest type */
+  buf[0] = -1;
+  buf[1] = -PETSC_MAX_INT;
+  for (pos = chunk.first;;) {
+    char *nodes;
+    long  cellType, numTags, tag;
+
+    PetscCall(GmshChunkNextLine_Private(&chunk, &pos, &line, &offset));
+    if (!line) break;
+    if (offset == sections[2 * GMSH_MARKER_ELEMENTS + 1]) continue;
+    PetscCall(GmshParseElement_Private(line, offset, &cellType, &numTags, &tag, &nodes));
+    if (GmshCellMap[cellType].dim != dim) continue;
+    buf[0] = PetscMax(buf[0], (PetscInt)cellType);
+    buf[1] = PetscMax(buf[1], -(PetscInt)cellType);
+    ++numCells;
+  }
+  PetscCall(MPIU_Allreduce(buf, gbuf, 2, MPIU_INT, MPI_MAX, comm));
+  PetscCheck(gbuf[0] >= 0, comm, PETSC_ERR_FILE_UNEXPECTED, "Gmsh file %s has no cells", filename);
+  PetscCheck(gbuf[0] == -gbuf[1], comm, PETSC_ERR_SUP, "Parallel Gmsh reader requires a single cell type");
+  PetscCheck(GmshCellMap[gbuf[0]].order == 1, comm, PETSC_ERR_SUP, "Parallel Gmsh reader does not support high-order cells");
+  ct         = DMPolytopeTypeFromGmsh(gbuf[0]);
+  numCorners = GmshCellMap[gbuf[0]].numVerts;
+  PetscCall(PetscMalloc2(numCells * numCorners, &cells, numCells, &tags));
+  for (pos = chunk.first, c = 0;;) {
+    char *nodes;
+    long  cellType, numTags, tag;
+
+    PetscCall(GmshChunkNextLine_Private(&chunk, &pos, &line, &offset));
+    if (!line) break;
+    if (offset == sections[2 * GMSH_MARKER_ELEMENTS + 1]) continue;
+    PetscCall(GmshParseElement_Private(line, offset, &cellType, &numTags, &tag, &nodes));
+    if (GmshCellMap[cellType].dim != dim) continue;
+    for (d = 0; d < numCorners; ++d) cells[c * numCorners + d] = (PetscInt)strtol(nodes, &nodes, 10) - 1;
+    PetscCall(DMPlexInvertCell(ct, &cells[c * numCorners]));
+    tags[c++] = numTags ? (PetscInt)tag : -1;
+  }
+  PetscCall(PetscFree(chunk.buf));
+  mem[0] = (PetscLogDouble)bytes + (PetscLogDouble)(numNodes * 3 * sizeof(PetscReal) + numCells * (numCorners + 1) * sizeof(PetscInt));
+
+  /* Build the naively distributed mesh */
+  if (coordDim < 0) coordDim = dim;
+  PetscCheck(coordDim <= 3, comm, PETSC_ERR_ARG_OUTOFRANGE, "Embedding dimension %" PetscInt_FMT " > 3", coordDim);
+  for (Nn = 0; Nn < numNodes; ++Nn)
+    for (d = 0; d < coordDim; ++d) coords[Nn * coordDim + d] = coords[Nn * 3 + d];
+  PetscCall(DMPlexCreateFromCellListParallelPetsc(comm, dim, numCells, numNodes, NVertices, numCorners, interpolate, cells, coordDim, coords, NULL, NULL, dm));
+  /* Labels must exist on every process, including those without cells */
+  for (c = 0, d = 0; c < numCells; ++c) d = PetscMax(d, tags[c] >= 0 ? 1 : 0);
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &d, 1, MPIU_INT, MPI_MAX, comm));
+  if (d) PetscCall(DMCreateLabel(*dm, "Cell Sets"));
+  for (c = 0; c < numCells; ++c)
+    if (tags[c] >= 0) PetscCall(DMSetLabelValue(*dm, "Cell Sets", c, tags[c]));
+  PetscCall(PetscFree2(cells, tags));
+  PetscCall(PetscFree(coords));
+  PetscCall(PetscMemoryGetCurrentUsage(&mem[1]));
+  PetscCall(MPIU_Allreduce(mem, gmem, 2, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm));
+  PetscCall(PetscInfo(*dm, "Parallel Gmsh read of %s: %" PetscInt_FMT " cells and %" PetscInt_FMT " nodes on this process; max reader memory %g MB and resident size %g MB per process\n", filename, numCells, numNodes, gmem[0] / 1048576., gmem[1] / 1048576.));
+  PetscCall(PetscLogEventEnd(DMPLEX_CreateGmsh, NULL, NULL, NULL, NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 /*@
   DMPlexCreateGmshFromFile - Create a `DMPLEX` mesh from a Gmsh file
 
@@ -1420,19 +1698,31 @@ static PetscErrorCode GmshCreateFE(MPI_Comm comm, const char prefix[], PetscBool
   Output Parameter:
 . dm - The `DM` object representing the mesh
 
+  Options Database Key:
+. -dm_plex_gmsh_parallel - Read an ASCII Gmsh 2.2 file in parallel, without gathering the mesh on the first process
+
   Level: beginner
 
+  Note:
+  With `-dm_plex_gmsh_parallel`, each process parses a contiguous piece of the node and element sections using MPI-IO,
+  and the mesh is created with `DMPlexCreateFromCellListParallelPetsc()`. The result is distributed in file order, and
+  is usually repartitioned by `DMPlexDistribute()` from `DMSetFromOptions()`. Only meshes with a single linear cell type
+  and nodes numbered consecutively from 1 are supported, and only the "Cell Sets" label is created. The memory used by
+  the reader on each process is reported by `-info`, and `-log_view_memory` reports it for the `DMPlexCreateGmsh` event.
+
 .seealso: [](ch_unstructured), `DM`, `DMPLEX`, `DMPlexCreateFromFile()`, `DMPlexCreateGmsh()`, `DMPlexCreate()`
 @*/
 PetscErrorCode DMPlexCreateGmshFromFile(MPI_Comm comm, const char filename[], PetscBool interpolate, DM *dm)
 {
   PetscViewer     viewer;
   PetscMPIInt     rank;
-  int             fileType;
+  int             fileType = 0, fileFormat = 0;
   PetscViewerType vtype;
+  PetscBool       parallel = PETSC_FALSE;
 
   PetscFunctionBegin;
   PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-dm_plex_gmsh_parallel", &parallel, NULL));
 
   /* Determine Gmsh file type (ASCII or binary) from file header */
   if (rank == 0) {
@@ -1440,7 +1730,6 @@ PetscErrorCode DMPlexCreateGmshFromFile(MPI_Comm comm, const char filename[], Pe
     char     line[PETSC_MAX_PATH_LEN];
     int      snum;
     float    version;
-    int      fileFormat;
 
     PetscCall(PetscArrayzero(gmsh, 1));
     PetscCall(PetscViewerCreate(PETSC_COMM_SELF, &gmsh->viewer));
@@ -1459,7 +1748,22 @@ PetscErrorCode DMPlexCreateGmshFromFile(MPI_Comm comm, const char filename[], Pe
     PetscCheck(fileFormat <= 41, PETSC_COMM_SELF, PETSC_ERR_SUP, "Gmsh file version %3.1f must be at most 4.1", (double)version);
     PetscCall(PetscViewerDestroy(&gmsh->viewer));
   }
-  PetscCallMPI(MPI_Bcast(&fileType, 1, MPI_INT, 0, comm));
+  {
+    int buf[2] = {fileType, fileFormat};
+
+    PetscCallMPI(MPI_Bcast(buf, 2, MPI_INT, 0, comm));
+    fileType   = buf[0];
+    fileFormat = buf[1];
+  }
+  if (parallel) {
+    PetscCheck(fileType == 0 && fileFormat == 22, comm, PETSC_ERR_SUP, "Parallel Gmsh reader only supports ASCII files in format 2.2");
+#if defined(PETSC_HAVE_MPIIO)
+    PetscCall(DMPlexCreateGmshParallel_Private(comm, filename, interpolate, dm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+#else
+    SETERRQ(comm, PETSC_ERR_SUP_SYS, "Parallel Gmsh reader requires MPI-IO");
+#endif
+  }
   vtype = (fileType == 0) ? PETSCVIEWERASCII : PETSCVIEWERBINARY;
 
   /* Create appropriate viewer and build plex */
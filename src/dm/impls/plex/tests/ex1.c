@@ -437,6 +437,16 @@ int main(int argc, char **argv)
       nsize: 3
       requires: !single
       args: -dm_plex_filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/square_bin.msh -dist_dm_distribute -petscpartitioner_type simple
+    test:
+      suffix: gmsh_3_parallel
+      nsize: 3
+      requires: !single
+      args: -dm_plex_filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/square.msh -dm_plex_gmsh_parallel -dist_dm_distribute -petscpartitioner_type simple
+    test:
+      suffix: gmsh_5_parallel
+      nsize: 4
+      requires: !single
+      args: -dm_plex_filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/square_quad.msh -dm_plex_gmsh_parallel -dist_dm_distribute -petscpartitioner_type simple -dm_plex_check_all
     test:
       suffix: gmsh_5
       requires: !single
@@ -33,6 +33,7 @@ typedef struct {
   PetscBool     testRedundant;    /* Use a redundant partitioning for testing */
   PetscBool     loadBalance;      /* Load balance via a second distribute step */
   PetscBool     partitionBalance; /* Balance shared point partition */
+  PetscInt      cellWeight;       /* Weight of the cells in the lower half of the domain during load balancing */
   PetscLogStage stages[4];
 } AppCtx;
 
@@ -44,6 +45,7 @@ PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   options->testRedundant    = PETSC_FALSE;
   options->loadBalance      = PETSC_FALSE;
   options->partitionBalance = PETSC_FALSE;
+  options->cellWeight       = 1;
 
   PetscOptionsBegin(comm, "", "Meshing Problem Options", "DMPLEX");
   PetscCall(PetscOptionsBoundedInt("-overlap", "The cell overlap for partitioning", "ex12.c", options->overlap, &options->overlap, NULL, 0));
@@ -51,6 +53,7 @@ PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   PetscCall(PetscOptionsBool("-test_redundant", "Use a redundant partition for testing", "ex12.c", options->testRedundant, &options->testRedundant, NULL));
   PetscCall(PetscOptionsBool("-load_balance", "Perform parallel load balancing in a second distribution step", "ex12.c", options->loadBalance, &options->loadBalance, NULL));
   PetscCall(PetscOptionsBool("-partition_balance", "Balance the ownership of shared points", "ex12.c", options->partitionBalance, &options->partitionBalance, NULL));
+  PetscCall(PetscOptionsBoundedInt("-cell_weight", "Weight of the cells in the lower half of the domain during load balancing", "ex12.c", options->cellWeight, &options->cellWeight, NULL, 1));
   PetscOptionsEnd();
 
   PetscCall(PetscLogStageRegister("MeshLoad", &options->stages[STAGE_LOAD]));
@@ -164,6 +167,25 @@ PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
       PetscCall(PetscPartitionerSetType(part, PETSCPARTITIONERSHELL));
       PetscCall(PetscPartitionerShellSetPartition(part, size, reSizes_n2, rePoints_n2));
     }
+    if (user->cellWeight > 1) {
+      PetscSection s;
+      PetscInt     pStart, pEnd, cStart, cEnd;
+
+      /* Emulate a load change by weighting cells through the local section */
+      PetscCall(DMPlexGetChart(*dm, &pStart, &pEnd));
+      PetscCall(DMPlexGetHeightStratum(*dm, 0, &cStart, &cEnd));
+      PetscCall(PetscSectionCreate(PETSC_COMM_SELF, &s));
+      PetscCall(PetscSectionSetChart(s, pStart, pEnd));
+      for (PetscInt c = cStart; c < cEnd; ++c) {
+        PetscReal centroid[3];
+
+        PetscCall(DMPlexComputeCellGeometryFVM(*dm, c, NULL, centroid, NULL));
+        PetscCall(PetscSectionSetDof(s, c, centroid[1] < 0.5 ? user->cellWeight : 1));
+      }
+      PetscCall(PetscSectionSetUp(s));
+      PetscCall(DMSetLocalSection(*dm, s));
+      PetscCall(PetscSectionDestroy(&s));
+    }
     PetscCall(DMPlexSetPartitionBalance(*dm, user->partitionBalance));
     PetscCall(DMPlexDistribute(*dm, overlap, NULL, &pdm));
     if (pdm) {
@@ -247,6 +269,10 @@ int main(int argc, char **argv)
     requires: parmetis
     nsize: 4
     args: -dm_coord_space 0 -dm_plex_simplex 0 -dm_plex_box_faces 4,4 -petscpartitioner_type shell -petscpartitioner_shell_random -lb_petscpartitioner_type parmetis -load_balance -lb_petscpartitioner_view -prelb_dm_view ::load_balance -dm_view ::load_balance
+  test:
+    suffix: lb_diffusive
+    nsize: 4
+    args: -dm_coord_space 0 -dm_plex_simplex 0 -dm_plex_box_faces 8,8 -petscpartitioner_type simple -load_balance -cell_weight 4 -lb_petscpartitioner_type diffusive -lb_petscpartitioner_view -prelb_dm_view ::load_balance -dm_view ::load_balance
 
   # Same tests as above, but with balancing of the shared point partition
   test:
@@ -4,13 +4,50 @@ static char help[] = "Tests mesh reordering\n\n";
 
 int main(int argc, char **argv)
 {
-  DM dm;
+  DM        dm;
+  char      oname[256] = "";
+  PetscBool flg;
 
   PetscFunctionBeginUser;
   PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscOptionsBegin(PETSC_COMM_WORLD, "", "Mesh Reordering Options", "DMPLEX");
+  PetscCall(PetscOptionsString("-reorder_distributed", "Reorder the distributed mesh with this ordering", "ex45.c", oname, oname, sizeof(oname), &flg));
+  PetscOptionsEnd();
   PetscCall(DMCreate(PETSC_COMM_WORLD, &dm));
   PetscCall(DMSetType(dm, DMPLEX));
   PetscCall(DMSetFromOptions(dm));
+  if (flg) {
+    DM        pdm, cdm;
+    IS        perm;
+    Vec       coords, lcoords, gcoords;
+    PetscInt  bw[2], N[2];
+    PetscReal span[2], nrm[2], err;
+
+    PetscCall(DMPlexComputeOrderingQuality(dm, &bw[0], &span[0]));
+    PetscCall(DMGetCoordinates(dm, &coords));
+    PetscCall(VecGetSize(coords, &N[0]));
+    PetscCall(VecNorm(coords, NORM_2, &nrm[0]));
+    PetscCall(DMPlexGetOrdering(dm, oname, NULL, &perm));
+    PetscCall(DMPlexPermute(dm, perm, &pdm));
+    PetscCall(ISDestroy(&perm));
+    PetscCall(DMDestroy(&dm));
+    dm = pdm;
+    PetscCall(DMPlexCheck(dm));
+    /* the global coordinates must be unchanged up to ordering, and the ghost update must reproduce the permuted local coordinates */
+    PetscCall(DMGetCoordinates(dm, &coords));
+    PetscCall(VecGetSize(coords, &N[1]));
+    PetscCall(VecNorm(coords, NORM_2, &nrm[1]));
+    PetscCall(DMGetCoordinatesLocal(dm, &lcoords));
+    PetscCall(DMGetCoordinateDM(dm, &cdm));
+    PetscCall(DMGetLocalVector(cdm, &gcoords));
+    PetscCall(DMGlobalToLocal(cdm, coords, INSERT_VALUES, gcoords));
+    PetscCall(VecAXPY(gcoords, -1.0, lcoords));
+    PetscCall(VecNorm(gcoords, NORM_INFINITY, &err));
+    PetscCall(DMRestoreLocalVector(cdm, &gcoords));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Coordinates %s after reordering\n", N[0] == N[1] && PetscAbsReal(nrm[0] - nrm[1]) <= 1e-12 * nrm[0] && err == 0.0 ? "preserved" : "changed"));
+    PetscCall(DMPlexComputeOrderingQuality(dm, &bw[1], &span[1]));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Distributed ordering %s: bandwidth %" PetscInt_FMT " -> %" PetscInt_FMT ", average closure span %g -> %g\n", oname, bw[0], bw[1], (double)span[0], (double)span[1]));
+  }
   PetscCall(DMViewFromOptions(dm, NULL, "-dm_view"));
   PetscCall(DMDestroy(&dm));
   PetscCall(PetscFinalize());
@@ -42,4 +79,29 @@ int main(int argc, char **argv)
       nsize: 2
       args: -petscpartitioner_type simple
 
+  testset:
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 8,8 -dm_plex_reorder_view
+
+    test:
+      suffix: hilbert_2d
+      args: -dm_plex_reorder hilbert
+
+    test:
+      suffix: morton_2d
+      args: -dm_plex_reorder morton
+
+    test:
+      suffix: hilbert_3d
+      args: -dm_plex_dim 3 -dm_plex_box_faces 4,4,4 -dm_plex_reorder hilbert
+
+    test:
+      suffix: hilbert_dist
+      nsize: 2
+      args: -petscpartitioner_type simple -reorder_distributed hilbert
+
+    test:
+      suffix: morton_dist_3d
+      nsize: 3
+      args: -dm_plex_dim 3 -dm_plex_box_faces 4,4,4 -petscpartitioner_type simple -reorder_distributed morton
+
 TEST*/
@@ -16,6 +16,7 @@ typedef struct {
   PetscBool   use_low_level_functions;     /* Use low level functions for viewing and loading */
   //TODO This is meant as temporary option; can be removed once we have full parallel loading in place
   PetscBool distribute_after_topo_load; /* Distribute topology right after DMPlexTopologyLoad(), if use_low_level_functions=true */
+  PetscBool check_compression;          /* Report the chunked and deflate compressed datasets of the saved file */
   PetscInt  verbose;
 } AppCtx;
 
@@ -31,6 +32,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   options->outfile[0]                 = '\0';
   options->use_low_level_functions    = PETSC_FALSE;
   options->distribute_after_topo_load = PETSC_FALSE;
+  options->check_compression          = PETSC_FALSE;
   options->verbose                    = 0;
 
   PetscOptionsBegin(comm, "", "Meshing Problem Options", "DMPLEX");
@@ -42,6 +44,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   PetscCall(PetscOptionsString("-outfile", "Output mesh file", EX, options->outfile, options->outfile, sizeof(options->outfile), NULL));
   PetscCall(PetscOptionsBool("-use_low_level_functions", "Use low level functions for viewing and loading", EX, options->use_low_level_functions, &options->use_low_level_functions, NULL));
   PetscCall(PetscOptionsBool("-distribute_after_topo_load", "Distribute topology right after DMPlexTopologyLoad(), if use_low_level_functions=true", EX, options->distribute_after_topo_load, &options->distribute_after_topo_load, NULL));
+  PetscCall(PetscOptionsBool("-check_compression", "Report the chunked and deflate compressed datasets of the saved file", EX, options->check_compression, &options->check_compression, NULL));
   PetscCall(PetscOptionsInt("-verbose", "Verbosity level", EX, options->verbose, &options->verbose, NULL));
   PetscOptionsEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -78,6 +81,54 @@ static PetscErrorCode SaveMesh(AppCtx *options, DM dm)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+typedef struct {
+  PetscInt ndatasets, nchunked, ndeflated;
+} CompressionCount;
+
+static herr_t CountCompressedDatasets_Private(hid_t group, const char *name, const H5L_info_t *info, void *ctx)
+{
+  CompressionCount *count = (CompressionCount *)ctx;
+  hid_t             obj, dcpl;
+  int               nfilters;
+
+  if (info->type != H5L_TYPE_HARD) return 0;
+  if ((obj = H5Oopen(group, name, H5P_DEFAULT)) < 0) return -1;
+  if (H5Iget_type(obj) == H5I_DATASET) {
+    if ((dcpl = H5Dget_create_plist(obj)) < 0) return -1;
+    count->ndatasets++;
+    if (H5Pget_layout(dcpl) == H5D_CHUNKED) count->nchunked++;
+    nfilters = H5Pget_nfilters(dcpl);
+    for (int f = 0; f < nfilters; f++) {
+      unsigned flags, cd_values[1];
+      size_t   cd_nelmts = 1;
+
+      if (H5Pget_filter2(dcpl, (unsigned)f, &flags, &cd_nelmts, cd_values, 0, NULL, NULL) == H5Z_FILTER_DEFLATE) {
+        count->ndeflated++;
+        break;
+      }
+    }
+    if (H5Pclose(dcpl) < 0) return -1;
+  }
+  if (H5Oclose(obj) < 0) return -1;
+  return 0;
+}
+
+/* the topology, coordinates, and labels are distributed IS and Vec datasets, which must all be chunked and compressed */
+static PetscErrorCode CheckCompression(AppCtx *options)
+{
+  PetscViewer      v;
+  hid_t            file;
+  CompressionCount count = {0, 0, 0};
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscViewerHDF5Open(options->comm, options->outfile, FILE_MODE_READ, &v));
+  PetscCall(PetscViewerHDF5GetFileId(v, &file));
+  PetscCheck(H5Lvisit(file, H5_INDEX_NAME, H5_ITER_NATIVE, CountCompressedDatasets_Private, &count) >= 0, options->comm, PETSC_ERR_LIB, "Could not visit the datasets of %s", options->outfile);
+  PetscCall(PetscViewerDestroy(&v));
+  PetscCall(PetscPrintf(options->comm, "Chunked datasets: %s, deflate filter: %s\n", count.nchunked > 0 ? "yes" : "no", count.ndeflated > 0 && count.ndeflated == count.nchunked ? "yes" : "no"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 typedef enum {
   NONE      = 0,
   PRE_DIST  = 1,
@@ -373,6 +424,7 @@ int main(int argc, char **argv)
     PetscCall(DMLabelDestroy(&label));
   }
   PetscCall(SaveMesh(&user, dm));
+  if (user.check_compression) PetscCall(CheckCompression(&user));
 
   PetscCall(LoadMesh(&user, &dmnew));
   PetscCall(IncrementNumLabels(&user)); /* account for depth label */
@@ -491,4 +543,18 @@ int main(int argc, char **argv)
     test:
       suffix: f
       args: -dm_plex_filename ${DATAFILESPATH}/meshes/hdf5-petsc/petsc-v3.16.0/v1.0.0/square.h5
+
+  # same as 3, writing chunked and compressed datasets without per-dataset flushes
+  test:
+    suffix: 3_compressed
+    requires: !complex datafilespath
+    nsize: 3
+    args: -dm_plex_name plex
+    args: -dm_plex_view_hdf5_storage_version 2.0.0
+    args: -dm_plex_interpolate -load_dm_distribute 0 -petscpartitioner_type simple
+    args: -use_low_level_functions -compare_pre_post
+    args: -num_labels 1
+    args: -outfile ex56_3_compressed.h5
+    args: -viewer_hdf5_compression 4 -viewer_hdf5_dataset_flush 0 -check_compression
+    args: -dm_plex_filename ${DATAFILESPATH}/meshes/hdf5-petsc/petsc-v3.16.0/v1.0.0/annulus-20.h5
 TEST*/
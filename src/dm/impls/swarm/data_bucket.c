@@ -482,6 +482,41 @@ PetscErrorCode DMSwarmDataBucketRemovePointAtIndex(const DMSwarmDataBucket db, c
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* move point p to newpos[p] for all points in use, permuting every field together */
+PetscErrorCode DMSwarmDataBucketPermute(const DMSwarmDataBucket db, const PetscInt newpos[])
+{
+  PetscInt  f, p, q, lo, hi;
+  size_t    maxsize = 0;
+  char     *buf;
+  PetscBool any_active_fields;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmDataBucketQueryForActiveFields(db, &any_active_fields));
+  PetscCheck(!any_active_fields, PETSC_COMM_SELF, PETSC_ERR_USER, "Cannot safely permute points as at least one DMSwarmDataField is currently being accessed");
+#if defined(DMSWARM_DATAFIELD_POINT_ACCESS_GUARD)
+  for (p = 0; p < db->L; ++p) PetscCheck(newpos[p] >= 0 && newpos[p] < db->L, PETSC_COMM_SELF, PETSC_ERR_USER, "New position %" PetscInt_FMT " of point %" PetscInt_FMT " must be in [0, %" PetscInt_FMT ")", newpos[p], p, db->L);
+#endif
+  /* only the points between the first and the last one that move are touched */
+  for (lo = 0; lo < db->L && newpos[lo] == lo; ++lo);
+  for (hi = db->L; hi > lo && newpos[hi - 1] == hi - 1; --hi);
+  if (lo == hi) PetscFunctionReturn(PETSC_SUCCESS);
+  for (f = 0; f < db->nfields; ++f) maxsize = PetscMax(maxsize, db->field[f]->atomic_size);
+  PetscCall(PetscMalloc(maxsize * (hi - lo), &buf));
+  for (f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField field = db->field[f];
+    const size_t     size  = field->atomic_size;
+
+    PetscCall(PetscMemcpy(buf, DMSWARM_DATAFIELD_point_access(field->data, lo, size), size * (hi - lo)));
+    /* copy back the runs of consecutive points that stay consecutive at once */
+    for (p = lo; p < hi; p = q) {
+      for (q = p + 1; q < hi && newpos[q] == newpos[q - 1] + 1; ++q);
+      PetscCall(PetscMemcpy(DMSWARM_DATAFIELD_point_access(field->data, newpos[p], size), buf + (p - lo) * size, size * (q - p)));
+    }
+  }
+  PetscCall(PetscFree(buf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* copy x into y */
 PetscErrorCode DMSwarmDataFieldCopyPoint(const PetscInt pid_x, const DMSwarmDataField field_x, const PetscInt pid_y, const DMSwarmDataField field_y)
 {
@@ -15,7 +15,7 @@ PetscLogEvent DMSWARM_DataExchangerTopologySetup, DMSWARM_DataExchangerBegin, DM
 PetscLogEvent DMSWARM_DataExchangerSendCount, DMSWARM_DataExchangerPack;
 
 const char *DMSwarmTypeNames[]          = {"basic", "pic", NULL};
-const char *DMSwarmMigrateTypeNames[]   = {"basic", "dmcellnscatter", "dmcellexact", "user", NULL};
+const char *DMSwarmMigrateTypeNames[]   = {"basic", "dmcellnscatter", "dmcellexact", "user", "dmcellneighbor", "DMSwarmMigrateType", "DMSWARM_MIGRATE_", NULL};
 const char *DMSwarmCollectTypeNames[]   = {"basic", "boundingbox", "general", "user", NULL};
 const char *DMSwarmPICLayoutTypeNames[] = {"regular", "gauss", "subdivision", NULL};
 
@@ -1352,6 +1352,9 @@ PetscErrorCode DMSwarmMigrate(DM dm, PetscBool remove_sent_points)
     SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_SUP, "DMSWARM_MIGRATE_DMCELLEXACT not implemented");
   case DMSWARM_MIGRATE_USER:
     SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_SUP, "DMSWARM_MIGRATE_USER not implemented");
+  case DMSWARM_MIGRATE_DMCELLNEIGHBOR:
+    PetscCall(DMSwarmMigrate_CellDMNeighbor(dm, remove_sent_points));
+    break;
   default:
     SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_SUP, "DMSWARM_MIGRATE type unknown");
   }
@@ -1582,6 +1585,7 @@ static PetscErrorCode DMSetup_Swarm(DM dm)
 
       swarm->migrate_type = DMSWARM_MIGRATE_DMCELLNSCATTER;
     }
+    PetscCall(PetscOptionsGetEnum(((PetscObject)dm)->options, ((PetscObject)dm)->prefix, "-dm_swarm_migrate_type", DMSwarmMigrateTypeNames, (PetscEnum *)&swarm->migrate_type, NULL));
   }
 
   PetscCall(DMSwarmFinalizeFieldRegister(dm));
@@ -1612,6 +1616,7 @@ static PetscErrorCode DMDestroy_Swarm(DM dm)
   if (--swarm->refct > 0) PetscFunctionReturn(PETSC_SUCCESS);
   PetscCall(DMSwarmDataBucketDestroy(&swarm->db));
   if (swarm->sort_context) PetscCall(DMSwarmSortDestroy(&swarm->sort_context));
+  PetscCall(DMSwarmCellNeighborsDestroy(&swarm->migrate_neighbors));
   PetscCall(PetscFree(swarm));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
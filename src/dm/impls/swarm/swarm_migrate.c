@@ -1,7 +1,9 @@
 #include <petscsf.h>
 #include <petscdmswarm.h>
 #include <petscdmda.h>
+#include <petscdmplex.h>
 #include <petsc/private/dmswarmimpl.h> /*I   "petscdmswarm.h"   I*/
+#include <petsc/private/dmpleximpl.h>
 #include "../src/dm/impls/swarm/data_bucket.h"
 #include "../src/dm/impls/swarm/data_ex.h"
 
@@ -348,6 +350,499 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm, PetscBool remove_sent_points)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+ Face adjacency of the cells of a DMPLEX cell DM and the persistent communication pattern with the ranks sharing the
+ partition boundary, used by DMSwarmMigrate_CellDMNeighbor()
+*/
+struct _n_DMSwarmCellNeighbors {
+  DM           dmcell; /* the cell DM the adjacency was computed for */
+  PetscInt     dim, cStart, cEnd;
+  PetscSFNode *cellNode;   /* (rank, cell) owning each local cell, on another rank for overlap cells */
+  PetscInt    *adjOffsets; /* the face neighbors of cell c are adjCell[] and adjNode[] in [adjOffsets[c - cStart], adjOffsets[c - cStart + 1]) */
+  PetscInt    *adjCell;    /* local neighbor cell, or -1 across the partition boundary */
+  PetscSFNode *adjNode;    /* (rank, cell) owning the neighbor cell */
+  PetscReal   *adjGeom;    /* centroid and outward normal of the faces on the partition boundary */
+  PetscMPIInt  nranks;     /* ranks sharing the partition boundary, sorted */
+  PetscMPIInt *ranks;
+  PetscSF      ranksf; /* leaf i is connected to the root of this rank on ranks[i] */
+  PetscMPIInt  tag;
+};
+
+PetscErrorCode DMSwarmCellNeighborsDestroy(DMSwarmCellNeighbors *nb)
+{
+  PetscFunctionBegin;
+  if (!*nb) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(DMDestroy(&(*nb)->dmcell));
+  PetscCall(PetscFree5((*nb)->cellNode, (*nb)->adjOffsets, (*nb)->adjCell, (*nb)->adjNode, (*nb)->adjGeom));
+  PetscCall(PetscFree((*nb)->ranks));
+  PetscCall(PetscSFDestroy(&(*nb)->ranksf));
+  PetscCall(PetscFree(*nb));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode DMSwarmCellNeighborsCreate_Private(DM dm, DM dmcell, DMSwarmCellNeighbors *nbr)
+{
+  DMSwarmCellNeighbors nb;
+  MPI_Comm             comm;
+  PetscMPIInt          rank, nfrom, *toranks, *todata, *fromranks = NULL, *fromdata = NULL, *slots, *rslots;
+  MPI_Request         *reqs;
+  PetscSF              sf;
+  PetscSFNode         *own, *other, *remote;
+  const PetscSFNode   *iremote;
+  const PetscInt      *ilocal;
+  PetscInt             nroots, nleaves, pStart, pEnd, fStart, fEnd, c, f, i, j, n, nto = 0, nadj = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)dm, &comm));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCall(PetscNew(&nb));
+  PetscCall(PetscObjectReference((PetscObject)dmcell));
+  nb->dmcell = dmcell;
+  PetscCall(DMGetCoordinateDim(dmcell, &nb->dim));
+  PetscCall(DMPlexGetHeightStratum(dmcell, 0, &nb->cStart, &nb->cEnd));
+  PetscCall(DMPlexGetHeightStratum(dmcell, 1, &fStart, &fEnd));
+  PetscCall(DMPlexGetChart(dmcell, &pStart, &pEnd));
+  PetscCall(DMGetPointSF(dmcell, &sf));
+  PetscCall(PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote));
+
+  /* the cell on the other side of each face on the partition boundary */
+  PetscCall(PetscMalloc2(pEnd - pStart, &own, pEnd - pStart, &other));
+  for (i = 0; i < pEnd - pStart; ++i) own[i].rank = own[i].index = other[i].rank = other[i].index = -1;
+  for (f = fStart; f < fEnd; ++f) {
+    const PetscInt *support;
+    PetscInt        ns;
+
+    PetscCall(DMPlexGetSupportSize(dmcell, f, &ns));
+    PetscCall(DMPlexGetSupport(dmcell, f, &support));
+    if (ns == 1) {
+      own[f - pStart].rank  = rank;
+      own[f - pStart].index = support[0];
+    }
+  }
+  if (nroots >= 0) {
+    PetscCall(PetscSFReduceBegin(sf, MPIU_2INT, own, other, MPI_REPLACE));
+    PetscCall(PetscSFReduceEnd(sf, MPIU_2INT, own, other, MPI_REPLACE));
+    PetscCall(PetscSFBcastBegin(sf, MPIU_2INT, own, other, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_2INT, own, other, MPI_REPLACE));
+  }
+
+  /* the owner of each local cell */
+  n = nb->cEnd - nb->cStart;
+  for (c = nb->cStart; c < nb->cEnd; ++c) {
+    const PetscInt *cone;
+    PetscInt        nc;
+
+    PetscCall(DMPlexGetConeSize(dmcell, c, &nc));
+    PetscCall(DMPlexGetCone(dmcell, c, &cone));
+    for (i = 0; i < nc; ++i) {
+      PetscInt ns;
+
+      PetscCall(DMPlexGetSupportSize(dmcell, cone[i], &ns));
+      if (ns == 2 || (ns == 1 && other[cone[i] - pStart].rank >= 0)) ++nadj;
+    }
+  }
+  PetscCall(PetscMalloc5(n, &nb->cellNode, n + 1, &nb->adjOffsets, nadj, &nb->adjCell, nadj, &nb->adjNode, 2 * nb->dim * nadj, &nb->adjGeom));
+  for (c = nb->cStart; c < nb->cEnd; ++c) {
+    nb->cellNode[c - nb->cStart].rank  = rank;
+    nb->cellNode[c - nb->cStart].index = c;
+  }
+  for (i = 0; i < PetscMax(nleaves, 0); ++i) {
+    const PetscInt p = ilocal ? ilocal[i] : i;
+
+    if (p >= nb->cStart && p < nb->cEnd) nb->cellNode[p - nb->cStart] = iremote[i];
+  }
+
+  /* the face neighbors, with the geometry of the faces on the partition boundary */
+  nb->adjOffsets[0] = 0;
+  for (c = nb->cStart, nadj = 0; c < nb->cEnd; ++c) {
+    const PetscInt *cone;
+    PetscReal       cc[3], vol;
+    PetscInt        nc, d;
+
+    PetscCall(DMPlexGetConeSize(dmcell, c, &nc));
+    PetscCall(DMPlexGetCone(dmcell, c, &cone));
+    PetscCall(DMPlexComputeCellGeometryFVM(dmcell, c, &vol, cc, NULL));
+    for (i = 0; i < nc; ++i) {
+      const PetscInt *support;
+      PetscInt        ns;
+
+      PetscCall(DMPlexGetSupportSize(dmcell, cone[i], &ns));
+      PetscCall(DMPlexGetSupport(dmcell, cone[i], &support));
+      if (ns == 2) {
+        const PetscInt cn = support[0] == c ? support[1] : support[0];
+
+        nb->adjCell[nadj]   = cn;
+        nb->adjNode[nadj++] = nb->cellNode[cn - nb->cStart];
+      } else if (ns == 1 && other[cone[i] - pStart].rank >= 0) {
+        PetscReal *fc = &nb->adjGeom[2 * nb->dim * nadj], *nrm = fc + nb->dim, area, dot = 0;
+
+        nb->adjCell[nadj]   = -1;
+        nb->adjNode[nadj++] = other[cone[i] - pStart];
+        PetscCall(DMPlexComputeCellGeometryFVM(dmcell, cone[i], &area, fc, nrm));
+        for (d = 0; d < nb->dim; ++d) dot += nrm[d] * (fc[d] - cc[d]);
+        if (dot < 0)
+          for (d = 0; d < nb->dim; ++d) nrm[d] = -nrm[d];
+      }
+    }
+    nb->adjOffsets[c - nb->cStart + 1] = nadj;
+  }
+  PetscCall(PetscFree2(own, other));
+
+  /* the ranks sharing the partition boundary, made symmetric */
+  PetscCall(PetscMalloc2(nadj + n, &toranks, nadj + n, &todata));
+  for (i = 0; i < nadj; ++i)
+    if (nb->adjNode[i].rank != rank) PetscCall(PetscMPIIntCast(nb->adjNode[i].rank, &toranks[nto++]));
+  for (i = 0; i < n; ++i)
+    if (nb->cellNode[i].rank != rank) PetscCall(PetscMPIIntCast(nb->cellNode[i].rank, &toranks[nto++]));
+  PetscCall(PetscSortRemoveDupsMPIInt(&nto, toranks));
+  for (i = 0; i < nto; ++i) todata[i] = rank;
+  PetscCall(PetscCommBuildTwoSided(comm, 1, MPI_INT, (PetscMPIInt)nto, toranks, todata, &nfrom, &fromranks, &fromdata));
+  PetscCall(PetscMalloc1(nto + nfrom, &nb->ranks));
+  PetscCall(PetscArraycpy(nb->ranks, toranks, nto));
+  PetscCall(PetscArraycpy(nb->ranks + nto, fromranks, nfrom));
+  j = nto + nfrom;
+  PetscCall(PetscSortRemoveDupsMPIInt(&j, nb->ranks));
+  nb->nranks = (PetscMPIInt)j;
+  PetscCall(PetscFree2(toranks, todata));
+  PetscCall(PetscFree(fromranks));
+  PetscCall(PetscFree(fromdata));
+
+  /* the persistent star forest between the neighbor ranks, leaf i gives the slot of this rank on ranks[i] */
+  PetscCall(PetscObjectGetNewTag((PetscObject)dm, &nb->tag));
+  PetscCall(PetscMalloc3(nb->nranks, &slots, nb->nranks, &rslots, 2 * nb->nranks, &reqs));
+  for (i = 0; i < nb->nranks; ++i) {
+    slots[i] = (PetscMPIInt)i;
+    PetscCallMPI(MPI_Irecv(&rslots[i], 1, MPI_INT, nb->ranks[i], nb->tag, comm, &reqs[i]));
+  }
+  for (i = 0; i < nb->nranks; ++i) PetscCallMPI(MPI_Isend(&slots[i], 1, MPI_INT, nb->ranks[i], nb->tag, comm, &reqs[nb->nranks + i]));
+  PetscCallMPI(MPI_Waitall(2 * nb->nranks, reqs, MPI_STATUSES_IGNORE));
+  PetscCall(PetscMalloc1(nb->nranks, &remote));
+  for (i = 0; i < nb->nranks; ++i) {
+    remote[i].rank  = nb->ranks[i];
+    remote[i].index = rslots[i];
+  }
+  PetscCall(PetscSFCreate(comm, &nb->ranksf));
+  PetscCall(PetscSFSetGraph(nb->ranksf, nb->nranks, nb->nranks, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(nb->ranksf));
+  PetscCall(PetscFree3(slots, rslots, reqs));
+  PetscCall(PetscInfo(dm, "Face adjacency of %" PetscInt_FMT " cells with %d neighbor ranks\n", n, nb->nranks));
+  *nbr = nb;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+ Looks for the point x, last in cell c, in c and its face neighbors. If it is found, dest is the owner of the cell
+ containing it. Otherwise dest is the neighbor across the partition boundary face the point is furthest beyond, or has a
+ negative rank if the point has to be searched for
+*/
+static PetscErrorCode DMSwarmCellNeighborsLocate_Private(DMSwarmCellNeighbors nb, const PetscReal x[], PetscInt c, PetscSFNode *dest, PetscBool *found)
+{
+  PetscScalar xs[3];
+  PetscReal   best = 0;
+  PetscInt    cell, d, j;
+
+  PetscFunctionBegin;
+  *found     = PETSC_FALSE;
+  dest->rank = dest->index = -1;
+  if (c < nb->cStart || c >= nb->cEnd) PetscFunctionReturn(PETSC_SUCCESS);
+  for (d = 0; d < nb->dim; ++d) xs[d] = x[d];
+  PetscCall(DMPlexLocatePoint_Internal(nb->dmcell, nb->dim, xs, c, &cell));
+  if (cell >= 0) {
+    *dest  = nb->cellNode[c - nb->cStart];
+    *found = PETSC_TRUE;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (j = nb->adjOffsets[c - nb->cStart]; j < nb->adjOffsets[c - nb->cStart + 1]; ++j) {
+    if (nb->adjCell[j] >= 0) {
+      PetscCall(DMPlexLocatePoint_Internal(nb->dmcell, nb->dim, xs, nb->adjCell[j], &cell));
+      if (cell >= 0) {
+        *dest  = nb->adjNode[j];
+        *found = PETSC_TRUE;
+        PetscFunctionReturn(PETSC_SUCCESS);
+      }
+    } else {
+      const PetscReal *fc = &nb->adjGeom[2 * nb->dim * j], *nrm = fc + nb->dim;
+      PetscReal        dist = 0;
+
+      for (d = 0; d < nb->dim; ++d) dist += nrm[d] * (x[d] - fc[d]);
+      if (dist > best) {
+        best  = dist;
+        *dest = nb->adjNode[j];
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* collective search of the cell DM for the n points at coor[search[i] * dim], the points not found are flagged in far */
+static PetscErrorCode DMSwarmCellNeighborsSearch_Private(DM dmcell, PetscInt dim, PetscInt n, const PetscInt search[], const PetscReal coor[], PetscInt cellid[], PetscBool far[], PetscInt *nfar)
+{
+  Vec                pos;
+  PetscSF            sfcell = NULL;
+  const PetscSFNode *cells;
+  PetscScalar       *x;
+  PetscInt           i, d;
+
+  PetscFunctionBegin;
+  PetscCall(VecCreateSeq(PETSC_COMM_SELF, n * dim, &pos));
+  PetscCall(VecSetBlockSize(pos, dim));
+  PetscCall(VecGetArrayWrite(pos, &x));
+  for (i = 0; i < n; ++i)
+    for (d = 0; d < dim; ++d) x[i * dim + d] = coor[search[i] * dim + d];
+  PetscCall(VecRestoreArrayWrite(pos, &x));
+  PetscCall(DMLocatePoints(dmcell, pos, DM_POINTLOCATION_NONE, &sfcell));
+  PetscCall(PetscSFGetGraph(sfcell, NULL, NULL, NULL, &cells));
+  for (i = 0; i < n; ++i) {
+    cellid[search[i]] = cells[i].index;
+    if (cells[i].index == DMLOCATEPOINT_POINT_NOT_FOUND) {
+      far[search[i]] = PETSC_TRUE;
+      ++(*nfar);
+    }
+  }
+  PetscCall(PetscSFDestroy(&sfcell));
+  PetscCall(VecDestroy(&pos));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* removes the points flagged in mask, which is permuted along with the points */
+static PetscErrorCode DMSwarmRemovePointsMasked_Private(DM dm, PetscBool mask[])
+{
+  DM_Swarm *swarm = (DM_Swarm *)dm->data;
+  PetscInt  p, npoints;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
+  for (p = 0; p < npoints; ++p) {
+    if (mask[p]) {
+      PetscCall(DMSwarmDataBucketRemovePointAtIndex(swarm->db, p));
+      mask[p] = mask[npoints - 1];
+      --npoints;
+      --p;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* size of a packed point and offset of the cell index within it */
+static PetscErrorCode DMSwarmGetPackedCellOffset_Private(DM dm, size_t *psize, size_t *offset)
+{
+  DM_Swarm         *swarm = (DM_Swarm *)dm->data;
+  DMSwarmDataField *fields;
+  PetscInt          nfields, fcell, f;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmDataBucketGetDMSwarmDataFields(swarm->db, &nfields, &fields));
+  PetscCall(DMSwarmDataBucketGetDMSwarmDataFieldIdByName(swarm->db, DMSwarmPICField_cellid, &fcell));
+  *psize  = 0;
+  *offset = 0;
+  for (f = 0; f < nfields; ++f) {
+    if (f == fcell) *offset = *psize;
+    *psize += fields[f]->atomic_size;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+ Migrates the points of a DMPLEX cell DM by looking for them in their last cell and its face neighbors, sending the
+ points leaving through the partition boundary to the rank across it, and searching all ranks only for the points
+ not found this way
+*/
+PetscErrorCode DMSwarmMigrate_CellDMNeighbor(DM dm, PetscBool remove_sent_points)
+{
+  DM_Swarm              *swarm = (DM_Swarm *)dm->data;
+  DM                     dmcell;
+  DMSwarmCellNeighbors   nb;
+  MPI_Comm               comm;
+  PetscMPIInt            rank, size, ndest = 0;
+  PetscBool              isplex, found, *far, *sent;
+  DMPlexInterpolatedFlag interpolated = DMPLEX_INTERPOLATED_INVALID;
+  PetscSFNode            node;
+  PetscReal             *coor;
+  PetscInt              *cellid, *rankval, *dest, *guess, *search, *sendcounts, *recvcounts, *sendoffsets, *recvoffsets;
+  PetscInt               dim, npoints, npointsg = 0, npointsg_new, nrecv, nsearch, nfar = 0, nfarg, nsent = 0, nsame = 0, nkept = 0, i, p, q;
+  size_t                 psize, ocell;
+  char                  *sendbuf, *recvbuf;
+  MPI_Request           *reqs;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmGetCellDM(dm, &dmcell));
+  PetscCheck(dmcell, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Only valid if cell DM provided");
+  PetscCall(PetscObjectTypeCompare((PetscObject)dmcell, DMPLEX, &isplex));
+  if (isplex) {
+    PetscInt cdim;
+
+    PetscCall(DMGetDimension(dmcell, &dim));
+    PetscCall(DMGetCoordinateDim(dmcell, &cdim));
+    PetscCall(DMPlexIsInterpolatedCollective(dmcell, &interpolated));
+    if (dim < 2 || cdim != dim) interpolated = DMPLEX_INTERPOLATED_INVALID;
+  }
+  if (interpolated != DMPLEX_INTERPOLATED_FULL) {
+    PetscCall(PetscInfo(dm, "Neighbor migration needs an interpolated DMPLEX cell DM of dimension 2 or 3, using the scatter to all neighbors\n"));
+    PetscCall(DMSwarmMigrate_CellDMScatter(dm, remove_sent_points));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (swarm->migrate_neighbors && swarm->migrate_neighbors->dmcell != dmcell) PetscCall(DMSwarmCellNeighborsDestroy(&swarm->migrate_neighbors));
+  if (!swarm->migrate_neighbors) PetscCall(DMSwarmCellNeighborsCreate_Private(dm, dmcell, &swarm->migrate_neighbors));
+  nb = swarm->migrate_neighbors;
+  PetscCall(PetscObjectGetComm((PetscObject)dm, &comm));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  if (swarm->migrate_error_on_missing_point) PetscCall(DMSwarmGetSize(dm, &npointsg));
+  PetscCall(DMSwarmGetPackedCellOffset_Private(dm, &psize, &ocell));
+
+  /* look for the points in their cell and its face neighbors, then search this rank for the points which moved further */
+  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
+  PetscCall(PetscMalloc2(npoints, &dest, npoints, &guess));
+  PetscCall(PetscMalloc1(npoints, &sent));
+  PetscCall(PetscMalloc1(npoints, &far));
+  PetscCall(PetscMalloc1(npoints, &search));
+  PetscCall(PetscCalloc4(nb->nranks, &sendcounts, nb->nranks, &recvcounts, nb->nranks + 1, &sendoffsets, nb->nranks + 1, &recvoffsets));
+  PetscCall(DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  for (p = 0, nsearch = 0; p < npoints; ++p) {
+    dest[p] = -1;
+    far[p] = sent[p] = PETSC_FALSE;
+    PetscCall(DMSwarmCellNeighborsLocate_Private(nb, &coor[p * dim], cellid[p], &node, &found));
+    if (found && node.rank == rank) {
+      if (node.index == cellid[p]) ++nsame;
+      cellid[p] = node.index;
+    } else if (node.rank >= 0) {
+      PetscCall(PetscFindMPIInt((PetscMPIInt)node.rank, nb->nranks, nb->ranks, &dest[p]));
+      PetscCheck(dest[p] >= 0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Rank %" PetscInt_FMT " is not a neighbor", node.rank);
+      guess[p] = node.index;
+      sent[p]  = PETSC_TRUE;
+      ++sendcounts[dest[p]];
+      ++nsent;
+    } else search[nsearch++] = p;
+  }
+  PetscCall(DMSwarmCellNeighborsSearch_Private(dmcell, dim, nsearch, search, coor, cellid, far, &nfar));
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+
+  /* send the points leaving through the partition boundary to the ranks across it, with the cell to start looking in */
+  PetscCall(PetscSFReduceBegin(nb->ranksf, MPIU_INT, sendcounts, recvcounts, MPI_REPLACE));
+  PetscCall(PetscSFReduceEnd(nb->ranksf, MPIU_INT, sendcounts, recvcounts, MPI_REPLACE));
+  for (i = 0; i < nb->nranks; ++i) {
+    sendoffsets[i + 1] = sendoffsets[i] + sendcounts[i];
+    recvoffsets[i + 1] = recvoffsets[i] + recvcounts[i];
+    if (sendcounts[i]) ++ndest;
+  }
+  nrecv = recvoffsets[nb->nranks];
+  PetscCall(PetscMalloc3(psize * nsent, &sendbuf, psize * nrecv, &recvbuf, 2 * nb->nranks, &reqs));
+  for (p = 0; p < npoints; ++p) {
+    if (dest[p] >= 0) {
+      char *data_p = sendbuf + psize * sendoffsets[dest[p]]++;
+
+      PetscCall(DMSwarmDataBucketFillPackedArray(swarm->db, p, data_p));
+      PetscCall(PetscMemcpy(data_p + ocell, &guess[p], sizeof(PetscInt)));
+    }
+  }
+  for (i = 0; i < nb->nranks; ++i) {
+    PetscMPIInt count;
+
+    PetscCall(PetscMPIIntCast(psize * recvcounts[i], &count));
+    PetscCallMPI(MPI_Irecv(recvbuf + psize * recvoffsets[i], count, MPI_BYTE, nb->ranks[i], nb->tag, comm, &reqs[i]));
+  }
+  for (i = 0; i < nb->nranks; ++i) {
+    PetscMPIInt count;
+
+    PetscCall(PetscMPIIntCast(psize * sendcounts[i], &count));
+    PetscCallMPI(MPI_Isend(sendbuf + psize * (sendoffsets[i] - sendcounts[i]), count, MPI_BYTE, nb->ranks[i], nb->tag, comm, &reqs[nb->nranks + i]));
+  }
+  PetscCallMPI(MPI_Waitall(2 * nb->nranks, reqs, MPI_STATUSES_IGNORE));
+
+  /* the received points are appended, sent points stay in place until all points are located */
+  PetscCall(DMSwarmDataBucketSetSizes(swarm->db, npoints + nrecv, DMSWARM_DATA_BUCKET_BUFFER_DEFAULT));
+  for (p = 0; p < nrecv; ++p) PetscCall(DMSwarmDataBucketInsertPackedArray(swarm->db, npoints + p, recvbuf + psize * p));
+  PetscCall(PetscFree3(sendbuf, recvbuf, reqs));
+  PetscCall(PetscFree(search));
+  PetscCall(PetscMalloc1(nrecv, &search));
+  PetscCall(PetscRealloc(sizeof(PetscBool) * (npoints + nrecv), &far));
+  PetscCall(PetscRealloc(sizeof(PetscBool) * (npoints + nrecv), &sent));
+  PetscCall(DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  for (p = npoints, nsearch = 0; p < npoints + nrecv; ++p) {
+    far[p] = sent[p] = PETSC_FALSE;
+    PetscCall(DMSwarmCellNeighborsLocate_Private(nb, &coor[p * dim], cellid[p], &node, &found));
+    if (found && node.rank == rank) cellid[p] = node.index;
+    else search[nsearch++] = p;
+  }
+  PetscCall(DMSwarmCellNeighborsSearch_Private(dmcell, dim, nsearch, search, coor, cellid, far, &nfar));
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(PetscFree(search));
+
+  /* the points not found near their cell are searched for by all ranks, the highest rank finding one keeps it */
+  PetscCallMPI(MPIU_Allreduce(&nfar, &nfarg, 1, MPIU_INT, MPI_SUM, comm));
+  if (nfarg) {
+    PetscMPIInt *counts, *displs, *owner, nbytes;
+    PetscInt     nfound = 0;
+    PetscReal   *fcoor;
+    PetscInt    *fcell;
+    PetscBool   *ffar;
+    char        *farbuf, *farbufg;
+
+    PetscCall(PetscMalloc4(size, &counts, size + 1, &displs, nfarg, &owner, nfarg, &search));
+    PetscCall(PetscMPIIntCast(psize * nfar, &nbytes));
+    PetscCallMPI(MPI_Allgather(&nbytes, 1, MPI_INT, counts, 1, MPI_INT, comm));
+    for (i = 0, displs[0] = 0; i < size; ++i) displs[i + 1] = displs[i] + counts[i];
+    PetscCall(PetscMalloc5(psize * nfar, &farbuf, psize * nfarg, &farbufg, nfarg * dim, &fcoor, nfarg, &fcell, nfarg, &ffar));
+    for (p = 0, q = 0; p < npoints + nrecv; ++p)
+      if (far[p]) PetscCall(DMSwarmDataBucketFillPackedArray(swarm->db, p, farbuf + psize * q++));
+    PetscCallMPI(MPI_Allgatherv(farbuf, nbytes, MPI_BYTE, farbufg, counts, displs, MPI_BYTE, comm));
+    {
+      DMSwarmDataField *fields;
+      PetscInt          nfields, fc, f;
+      size_t            ocoor = 0;
+
+      PetscCall(DMSwarmDataBucketGetDMSwarmDataFields(swarm->db, &nfields, &fields));
+      PetscCall(DMSwarmDataBucketGetDMSwarmDataFieldIdByName(swarm->db, DMSwarmPICField_coor, &fc));
+      for (f = 0; f < fc; ++f) ocoor += fields[f]->atomic_size;
+      for (q = 0; q < nfarg; ++q) {
+        PetscCall(PetscMemcpy(&fcoor[q * dim], farbufg + psize * q + ocoor, sizeof(PetscReal) * dim));
+        search[q] = q;
+        ffar[q]   = PETSC_FALSE;
+      }
+    }
+    PetscCall(DMSwarmCellNeighborsSearch_Private(dmcell, dim, nfarg, search, fcoor, fcell, ffar, &nfound));
+    for (q = 0; q < nfarg; ++q) {
+      owner[q] = ffar[q] ? -1 : rank;
+      if (!ffar[q]) PetscCall(PetscMemcpy(farbufg + psize * q + ocell, &fcell[q], sizeof(PetscInt)));
+    }
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE, owner, (PetscMPIInt)nfarg, MPI_INT, MPI_MAX, comm));
+
+    /* the far points are only kept by their owner, the far points received from a neighbor are always removed */
+    for (p = 0; p < npoints + nrecv; ++p) sent[p] = (PetscBool)(p < npoints ? (remove_sent_points && (sent[p] || far[p])) : far[p]);
+    PetscCall(DMSwarmRemovePointsMasked_Private(dm, sent));
+    PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &p, NULL, NULL));
+    for (q = 0; q < nfarg; ++q)
+      if (owner[q] == rank) ++nkept;
+    PetscCall(DMSwarmDataBucketSetSizes(swarm->db, p + nkept, DMSWARM_DATA_BUCKET_BUFFER_DEFAULT));
+    for (q = 0, i = 0; q < nfarg; ++q)
+      if (owner[q] == rank) PetscCall(DMSwarmDataBucketInsertPackedArray(swarm->db, p + i++, farbufg + psize * q));
+    PetscCall(PetscFree5(farbuf, farbufg, fcoor, fcell, ffar));
+    PetscCall(PetscFree4(counts, displs, owner, search));
+  } else {
+    if (remove_sent_points) PetscCall(DMSwarmRemovePointsMasked_Private(dm, sent));
+  }
+  PetscCall(PetscInfo(dm, "%" PetscInt_FMT " points stayed in their cell, %" PetscInt_FMT " sent to %d of %d neighbor ranks, %" PetscInt_FMT " received, %" PetscInt_FMT " of %" PetscInt_FMT " searched on all ranks kept\n", nsame, nsent, ndest, nb->nranks, nrecv, nkept, nfarg));
+
+  /* the points on this rank are owned by it */
+  PetscCall(DMSwarmDataBucketGetSizes(swarm->db, &npoints, NULL, NULL));
+  PetscCall(DMSwarmGetField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  for (p = 0; p < npoints; ++p) rankval[p] = rank;
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankval));
+  PetscCall(PetscFree2(dest, guess));
+  PetscCall(PetscFree(sent));
+  PetscCall(PetscFree(far));
+  PetscCall(PetscFree4(sendcounts, recvcounts, sendoffsets, recvoffsets));
+  if (swarm->migrate_error_on_missing_point) {
+    PetscCall(DMSwarmGetSize(dm, &npointsg_new));
+    PetscCheck(npointsg == npointsg_new, comm, PETSC_ERR_USER, "Points from the DMSwarm must remain constant during migration (initial %" PetscInt_FMT " - final %" PetscInt_FMT ")", npointsg, npointsg_new);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode DMSwarmMigrate_CellDMExact(DM dm, PetscBool remove_sent_points)
 {
   PetscFunctionBegin;
@@ -1,26 +1,12 @@
 #include <petscdmda.h>                 /*I  "petscdmda.h"      I*/
 #include <petscdmplex.h>               /*I  "petscdmplex.h"    I*/
 #include <petsc/private/dmswarmimpl.h> /*I  "petscdmswarm.h"   I*/
+#include "../src/dm/impls/swarm/data_bucket.h"
 
-static int sort_CompareSwarmPoint(const void *dataA, const void *dataB)
+/* the points outside of the cells are gathered in an extra bin after the last cell */
+static inline PetscInt DMSwarmSortBin_Private(PetscInt cellid, PetscInt ncells)
 {
-  SwarmPoint *pointA = (SwarmPoint *)dataA;
-  SwarmPoint *pointB = (SwarmPoint *)dataB;
-
-  if (pointA->cell_index < pointB->cell_index) {
-    return -1;
-  } else if (pointA->cell_index > pointB->cell_index) {
-    return 1;
-  } else {
-    return 0;
-  }
-}
-
-static PetscErrorCode DMSwarmSortApplyCellIndexSort(DMSwarmSort ctx)
-{
-  PetscFunctionBegin;
-  if (ctx->list) qsort(ctx->list, ctx->npoints, sizeof(SwarmPoint), sort_CompareSwarmPoint);
-  PetscFunctionReturn(PETSC_SUCCESS);
+  return (cellid >= 0 && cellid < ncells) ? cellid : ncells;
 }
 
 static PetscErrorCode DMSwarmSortCreate(DMSwarmSort *_ctx)
@@ -32,7 +18,7 @@ static PetscErrorCode DMSwarmSortCreate(DMSwarmSort *_ctx)
   ctx->isvalid = PETSC_FALSE;
   ctx->ncells  = 0;
   ctx->npoints = 0;
-  PetscCall(PetscMalloc1(1, &ctx->pcell_offsets));
+  PetscCall(PetscMalloc1(2, &ctx->pcell_offsets));
   PetscCall(PetscMalloc1(1, &ctx->list));
   *_ctx = ctx;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -42,19 +28,19 @@ static PetscErrorCode DMSwarmSortSetup(DMSwarmSort ctx, DM dm, PetscInt ncells)
 {
   PetscInt *swarm_cellid;
   PetscInt  p, npoints;
-  PetscInt  tmp, c, count;
+  PetscInt  b, bprev = 0;
 
   PetscFunctionBegin;
   if (!ctx) PetscFunctionReturn(PETSC_SUCCESS);
   if (ctx->isvalid) PetscFunctionReturn(PETSC_SUCCESS);
 
   PetscCall(PetscLogEventBegin(DMSWARM_Sort, 0, 0, 0, 0));
-  /* check the number of cells */
+  /* check the number of cells, with room for the bin of the points outside of the cells */
   if (ncells != ctx->ncells) {
-    PetscCall(PetscRealloc(sizeof(PetscInt) * (ncells + 1), &ctx->pcell_offsets));
+    PetscCall(PetscRealloc(sizeof(PetscInt) * (ncells + 2), &ctx->pcell_offsets));
     ctx->ncells = ncells;
   }
-  PetscCall(PetscArrayzero(ctx->pcell_offsets, ctx->ncells + 1));
+  PetscCall(PetscArrayzero(ctx->pcell_offsets, ctx->ncells + 2));
 
   /* get the number of points */
   PetscCall(DMSwarmGetLocalSize(dm, &npoints));
@@ -62,27 +48,28 @@ static PetscErrorCode DMSwarmSortSetup(DMSwarmSort ctx, DM dm, PetscInt ncells)
     PetscCall(PetscRealloc(sizeof(SwarmPoint) * npoints, &ctx->list));
     ctx->npoints = npoints;
   }
-  PetscCall(PetscArrayzero(ctx->list, npoints));
 
+  /* counting sort by cell index, which keeps the order of the points within a cell */
   PetscCall(DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&swarm_cellid));
+  ctx->issorted = PETSC_TRUE;
   for (p = 0; p < ctx->npoints; p++) {
-    ctx->list[p].point_index = p;
-    ctx->list[p].cell_index  = swarm_cellid[p];
+    b = DMSwarmSortBin_Private(swarm_cellid[p], ncells);
+    ctx->pcell_offsets[b + 1]++;
+    if (b < bprev) ctx->issorted = PETSC_FALSE;
+    bprev = b;
   }
-  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&swarm_cellid));
-  PetscCall(DMSwarmSortApplyCellIndexSort(ctx));
-
-  /* sum points per cell */
-  for (p = 0; p < ctx->npoints; p++) ctx->pcell_offsets[ctx->list[p].cell_index]++;
+  for (b = 0; b < ncells; b++) ctx->pcell_offsets[b + 1] += ctx->pcell_offsets[b];
+  for (p = 0; p < ctx->npoints; p++) {
+    const PetscInt pid = ctx->pcell_offsets[DMSwarmSortBin_Private(swarm_cellid[p], ncells)]++;
 
-  /* create offset list */
-  count = 0;
-  for (c = 0; c < ctx->ncells; c++) {
-    tmp                   = ctx->pcell_offsets[c];
-    ctx->pcell_offsets[c] = count;
-    count                 = count + tmp;
+    ctx->list[pid].point_index = p;
+    ctx->list[pid].cell_index  = swarm_cellid[p];
   }
-  ctx->pcell_offsets[c] = count;
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&swarm_cellid));
+
+  /* shift the insertion positions back to the offsets */
+  for (b = ncells; b > 0; b--) ctx->pcell_offsets[b] = ctx->pcell_offsets[b - 1];
+  ctx->pcell_offsets[0] = 0;
 
   ctx->isvalid = PETSC_TRUE;
   PetscCall(PetscLogEventEnd(DMSWARM_Sort, 0, 0, 0, 0));
@@ -99,6 +86,7 @@ PetscErrorCode DMSwarmSortDestroy(DMSwarmSort *_ctx)
   ctx = *_ctx;
   if (ctx->list) PetscCall(PetscFree(ctx->list));
   if (ctx->pcell_offsets) PetscCall(PetscFree(ctx->pcell_offsets));
+  PetscCall(PetscFree(ctx->psorted_offsets));
   PetscCall(PetscFree(ctx));
   *_ctx = NULL;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -183,6 +171,41 @@ PetscErrorCode DMSwarmSortGetPointsPerCell(DM dm, PetscInt e, PetscInt *npoints,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode DMSwarmSortGetNumberOfCells_Private(DM dm, PetscInt *ncells)
+{
+  DM        celldm;
+  PetscBool isda, isplex, isshell;
+
+  PetscFunctionBegin;
+  PetscCall(DMSwarmGetCellDM(dm, &celldm));
+  PetscCall(PetscObjectTypeCompare((PetscObject)celldm, DMDA, &isda));
+  PetscCall(PetscObjectTypeCompare((PetscObject)celldm, DMPLEX, &isplex));
+  PetscCall(PetscObjectTypeCompare((PetscObject)celldm, DMSHELL, &isshell));
+  *ncells = 0;
+  if (isda) {
+    PetscInt        nel, npe;
+    const PetscInt *element;
+
+    PetscCall(DMDAGetElements(celldm, &nel, &npe, &element));
+    *ncells = nel;
+    PetscCall(DMDARestoreElements(celldm, &nel, &npe, &element));
+  } else if (isplex) {
+    PetscInt ps, pe;
+
+    PetscCall(DMPlexGetHeightStratum(celldm, 0, &ps, &pe));
+    *ncells = pe - ps;
+  } else if (isshell) {
+    PetscErrorCode (*method_DMShellGetNumberOfCells)(DM, PetscInt *);
+
+    PetscCall(PetscObjectQueryFunction((PetscObject)celldm, "DMGetNumberOfCells_C", &method_DMShellGetNumberOfCells));
+    if (method_DMShellGetNumberOfCells) {
+      PetscCall(method_DMShellGetNumberOfCells(celldm, ncells));
+    } else
+      SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Cannot determine the number of cells for the DMSHELL object. User must provide a method via PetscObjectComposeFunction( (PetscObject)shelldm, \"DMGetNumberOfCells_C\", your_function_to_compute_number_of_cells);");
+  } else SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Cannot determine the number of cells for a DM not of type DA, PLEX or SHELL");
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   DMSwarmSortGetAccess - Setups up a `DMSWARM` point sort context for efficient traversal of points within a cell
 
@@ -196,7 +219,7 @@ PetscErrorCode DMSwarmSortGetPointsPerCell(DM dm, PetscInt e, PetscInt *npoints,
   Notes:
   Calling `DMSwarmSortGetAccess()` creates a list which enables easy identification of all points contained in a
   given cell. This method does not explicitly sort the data within the `DMSWARM` based on the cell index associated
-  with a `DMSWARM` point.
+  with a `DMSWARM` point, use `DMSwarmSortPoints()` for that.
 
   The sort context is valid only for the `DMSWARM` points defined at the time when `DMSwarmSortGetAccess()` was called.
   For example, suppose the swarm contained NP points when `DMSwarmSortGetAccess()` was called. If the user subsequently
@@ -226,41 +249,10 @@ PetscErrorCode DMSwarmSortGetAccess(DM dm)
 {
   DM_Swarm *swarm = (DM_Swarm *)dm->data;
   PetscInt  ncells;
-  DM        celldm;
-  PetscBool isda, isplex, isshell;
 
   PetscFunctionBegin;
   if (!swarm->sort_context) PetscCall(DMSwarmSortCreate(&swarm->sort_context));
-
-  /* get the number of cells */
-  PetscCall(DMSwarmGetCellDM(dm, &celldm));
-  PetscCall(PetscObjectTypeCompare((PetscObject)celldm, DMDA, &isda));
-  PetscCall(PetscObjectTypeCompare((PetscObject)celldm, DMPLEX, &isplex));
-  PetscCall(PetscObjectTypeCompare((PetscObject)celldm, DMSHELL, &isshell));
-  ncells = 0;
-  if (isda) {
-    PetscInt        nel, npe;
-    const PetscInt *element;
-
-    PetscCall(DMDAGetElements(celldm, &nel, &npe, &element));
-    ncells = nel;
-    PetscCall(DMDARestoreElements(celldm, &nel, &npe, &element));
-  } else if (isplex) {
-    PetscInt ps, pe;
-
-    PetscCall(DMPlexGetHeightStratum(celldm, 0, &ps, &pe));
-    ncells = pe - ps;
-  } else if (isshell) {
-    PetscErrorCode (*method_DMShellGetNumberOfCells)(DM, PetscInt *);
-
-    PetscCall(PetscObjectQueryFunction((PetscObject)celldm, "DMGetNumberOfCells_C", &method_DMShellGetNumberOfCells));
-    if (method_DMShellGetNumberOfCells) {
-      PetscCall(method_DMShellGetNumberOfCells(celldm, &ncells));
-    } else
-      SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Cannot determine the number of cells for the DMSHELL object. User must provide a method via PetscObjectComposeFunction( (PetscObject)shelldm, \"DMGetNumberOfCells_C\", your_function_to_compute_number_of_cells);");
-  } else SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Cannot determine the number of cells for a DM not of type DA, PLEX or SHELL");
-
-  /* setup */
+  PetscCall(DMSwarmSortGetNumberOfCells_Private(dm, &ncells));
   PetscCall(DMSwarmSortSetup(swarm->sort_context, dm, ncells));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -349,3 +341,139 @@ PetscErrorCode DMSwarmSortGetSizes(DM dm, PetscInt *ncells, PetscInt *npoints)
   if (npoints) *npoints = swarm->sort_context->npoints;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*@
+  DMSwarmSortPoints - Reorders the points of a `DMSWARM` so that the points of each cell are stored contiguously
+
+  Not Collective
+
+  Input Parameter:
+. dm - a `DMSWARM` object
+
+  Level: advanced
+
+  Notes:
+  All the fields of the `DMSWARM` are permuted together, with the points ordered by the cell index in the field
+  `DMSwarmPICField_cellid`. Points outside of the cells of the local cell `DM` are moved after the points of the last cell.
+  The order of the points within a cell is preserved.
+
+  The ordering is updated incrementally. A point still in the block of its cell from the previous call of `DMSwarmSortPoints()`
+  stays in place relative to the other points of its cell, and only the points that left their cell, or were added since,
+  are sorted with a counting sort over the cells. Call it after each particle push and `DMSwarmMigrate()`, when most
+  points remain in their cell, to keep the storage ordered by cell at a cost proportional to the number of points and cells.
+
+  After `DMSwarmSortPoints()`, `DMSwarmSortGetAccess()` does not need to sort and `DMSwarmSortGetPointRange()` gives the
+  contiguous range of points of each cell, so that the loops over the points of the cells, for example for the deposition
+  to the mesh or the interpolation to the particles, stream through the fields.
+
+  This cannot be called while fields are accessed with `DMSwarmGetField()` or between `DMSwarmSortGetAccess()` and
+  `DMSwarmSortRestoreAccess()`.
+
+.seealso: `DMSWARM`, `DMSwarmSortGetAccess()`, `DMSwarmSortGetPointRange()`, `DMSwarmMigrate()`
+@*/
+PetscErrorCode DMSwarmSortPoints(DM dm)
+{
+  DM_Swarm   *swarm = (DM_Swarm *)dm->data;
+  DMSwarmSort ctx;
+  PetscInt   *swarm_cellid, *stay, *move, *offsets, *moved, *newpos;
+  PetscInt    ncells, npoints, nmoved = 0, b, c, k, p;
+  PetscBool   incremental;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(dm, DM_CLASSID, 1, DMSWARM);
+  DMSWARMPICVALID(dm);
+  if (!swarm->sort_context) PetscCall(DMSwarmSortCreate(&swarm->sort_context));
+  ctx = swarm->sort_context;
+  PetscCheck(!ctx->isvalid, PetscObjectComm((PetscObject)dm), PETSC_ERR_ORDER, "Cannot reorder the points between DMSwarmSortGetAccess() and DMSwarmSortRestoreAccess()");
+  PetscCall(DMSwarmSortGetNumberOfCells_Private(dm, &ncells));
+  PetscCall(DMSwarmGetLocalSize(dm, &npoints));
+  incremental = (ctx->psorted_offsets && ncells == ctx->nsortedcells) ? PETSC_TRUE : PETSC_FALSE;
+
+  PetscCall(PetscLogEventBegin(DMSWARM_Sort, 0, 0, 0, 0));
+  PetscCall(PetscCalloc3(ncells + 1, &stay, ncells + 1, &move, ncells + 2, &offsets));
+  PetscCall(PetscMalloc2(npoints, &moved, npoints, &newpos));
+  PetscCall(DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&swarm_cellid));
+  /* a point stays if it is in the block of its cell from the last ordering, all the others have moved */
+  for (p = 0, c = 0; p < npoints; p++) {
+    b = DMSwarmSortBin_Private(swarm_cellid[p], ncells);
+    if (incremental && p < ctx->nsortedpoints) {
+      while (p >= ctx->psorted_offsets[c + 1]) c++;
+      if (b == c) {
+        stay[b]++;
+        continue;
+      }
+    }
+    moved[nmoved++] = p;
+    move[b]++;
+  }
+  /* the moved points go after the points that stayed in their cell */
+  for (b = 0; b <= ncells; b++) {
+    offsets[b + 1] = offsets[b] + stay[b] + move[b];
+    move[b]        = offsets[b] + stay[b];
+    stay[b]        = offsets[b];
+  }
+  if (nmoved) {
+    for (p = 0, k = 0; p < npoints; p++) {
+      if (k < nmoved && moved[k] == p) {
+        k++;
+        continue;
+      }
+      newpos[p] = stay[DMSwarmSortBin_Private(swarm_cellid[p], ncells)]++;
+    }
+    /* counting sort of the moved points only */
+    for (k = 0; k < nmoved; k++) newpos[moved[k]] = move[DMSwarmSortBin_Private(swarm_cellid[moved[k]], ncells)]++;
+  }
+  PetscCall(DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&swarm_cellid));
+  if (nmoved) PetscCall(DMSwarmDataBucketPermute(swarm->db, newpos));
+  PetscCall(PetscInfo(dm, "Reordered %" PetscInt_FMT " points in %" PetscInt_FMT " cells, %" PetscInt_FMT " points had moved\n", npoints, ncells, nmoved));
+
+  if (!ctx->psorted_offsets || ncells != ctx->nsortedcells) {
+    PetscCall(PetscFree(ctx->psorted_offsets));
+    PetscCall(PetscMalloc1(ncells + 2, &ctx->psorted_offsets));
+  }
+  PetscCall(PetscArraycpy(ctx->psorted_offsets, offsets, ncells + 2));
+  ctx->nsortedcells  = ncells;
+  ctx->nsortedpoints = npoints;
+  PetscCall(PetscFree2(moved, newpos));
+  PetscCall(PetscFree3(stay, move, offsets));
+  PetscCall(PetscLogEventEnd(DMSWARM_Sort, 0, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  DMSwarmSortGetPointRange - Gets the contiguous range of the points in a cell of a `DMSWARM` stored by cell
+
+  Not Collective
+
+  Input Parameters:
++ dm - a `DMSWARM` object
+- e  - the index of the cell
+
+  Output Parameters:
++ pStart - the index of the first point in the cell
+- pEnd   - one past the index of the last point in the cell
+
+  Level: advanced
+
+  Notes:
+  You must call `DMSwarmSortGetAccess()` before you can call `DMSwarmSortGetPointRange()`, and the points must be stored by
+  cell, as after `DMSwarmSortPoints()`. Then the points of cell `e` are `pStart` to `pEnd - 1` in every field, so that no
+  index list is needed to loop over them.
+
+.seealso: `DMSWARM`, `DMSwarmSortPoints()`, `DMSwarmSortGetAccess()`, `DMSwarmSortGetPointsPerCell()`
+@*/
+PetscErrorCode DMSwarmSortGetPointRange(DM dm, PetscInt e, PetscInt *pStart, PetscInt *pEnd)
+{
+  DM_Swarm   *swarm = (DM_Swarm *)dm->data;
+  DMSwarmSort ctx;
+
+  PetscFunctionBegin;
+  ctx = swarm->sort_context;
+  PetscCheck(ctx, PetscObjectComm((PetscObject)dm), PETSC_ERR_USER, "The DMSwarmSort context has not been created. Must call DMSwarmSortGetAccess() first");
+  PetscCheck(ctx->isvalid, PETSC_COMM_SELF, PETSC_ERR_USER, "SwarmPointSort container is not valid. Must call DMSwarmSortGetAccess() first");
+  PetscCheck(ctx->issorted, PETSC_COMM_SELF, PETSC_ERR_USER, "The points are not stored by cell. Must call DMSwarmSortPoints() before DMSwarmSortGetAccess()");
+  PetscCheck(e >= 0 && e < ctx->ncells, PETSC_COMM_SELF, PETSC_ERR_USER, "Cell index (%" PetscInt_FMT ") must be in [0, %" PetscInt_FMT ")", e, ctx->ncells);
+  if (pStart) *pStart = ctx->pcell_offsets[e];
+  if (pEnd) *pEnd = ctx->pcell_offsets[e + 1];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
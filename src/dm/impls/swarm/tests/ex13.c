@@ -0,0 +1,243 @@
+static char help[] = "Tests the storage of DMSwarm points by cell with DMSwarmSortPoints() while the points are pushed through a mesh.\n";
+
+#include <petscdmda.h>
+#include <petscdmswarm.h>
+#include <petsctime.h>
+
+typedef struct {
+  PetscInt  nc;     /* number of cells in each direction */
+  PetscInt  np;     /* number of points */
+  PetscInt  nsteps; /* number of pushes */
+  PetscReal dt;     /* time step of the pushes */
+  PetscBool report; /* report the throughput of the push, sort, and deposit */
+} AppCtx;
+
+/* the velocity and weight of a point only depend on its id, so that they can be checked after any reordering */
+static inline void PointVelocity(PetscInt id, PetscReal v[])
+{
+  v[0] = PetscCosReal(0.1 * id);
+  v[1] = PetscSinReal(0.1 * id);
+}
+
+static inline PetscReal PointWeight(PetscInt id)
+{
+  return 1.0 + id % 3;
+}
+
+/* points with id a multiple of 101 are lost outside of the mesh */
+static inline PetscInt PointCell(const AppCtx *user, PetscInt id, const PetscReal x[])
+{
+  PetscInt i = PetscMin((PetscInt)(x[0] * user->nc), user->nc - 1), j = PetscMin((PetscInt)(x[1] * user->nc), user->nc - 1);
+
+  return id % 101 ? j * user->nc + i : DMLOCATEPOINT_POINT_NOT_FOUND;
+}
+
+static PetscErrorCode InitializePoints(DM sw, PetscInt pStart, PetscInt pEnd, PetscInt idStart, AppCtx *user)
+{
+  PetscReal *coor, *vel, *w;
+  PetscInt  *id, *cellid;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmGetField(sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmGetField(sw, "weight", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  for (PetscInt p = pStart; p < pEnd; p++) {
+    id[p]           = idStart + p - pStart;
+    coor[2 * p]     = PetscFmodReal(0.6180339887 * id[p], 1.0);
+    coor[2 * p + 1] = PetscFmodReal(0.4142135624 * id[p], 1.0);
+    cellid[p]       = PointCell(user, id[p], &coor[2 * p]);
+    w[p]            = PointWeight(id[p]);
+    PointVelocity(id[p], &vel[2 * p]);
+  }
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmRestoreField(sw, "weight", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmRestoreField(sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* move the points with their velocity in the periodic unit square and update their cell */
+static PetscErrorCode Push(DM sw, AppCtx *user)
+{
+  PetscReal *coor, *vel;
+  PetscInt  *id, *cellid, n;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMSwarmGetLocalSize(sw, &n));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmGetField(sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  for (PetscInt p = 0; p < n; p++) {
+    for (PetscInt d = 0; d < 2; d++) {
+      coor[2 * p + d] += user->dt * vel[2 * p + d];
+      coor[2 * p + d] -= PetscFloorReal(coor[2 * p + d]);
+    }
+    cellid[p] = PointCell(user, id[p], &coor[2 * p]);
+  }
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmRestoreField(sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* deposit the weights of the points to their cell and interpolate the cell density back to the points, streaming through the cells */
+static PetscErrorCode DepositAndInterpolate(DM sw, PetscReal rho[], AppCtx *user)
+{
+  PetscReal *w, *rhop;
+  PetscInt   ncells = user->nc * user->nc;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMSwarmSortGetAccess(sw));
+  PetscCall(DMSwarmGetField(sw, "weight", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmGetField(sw, "density", NULL, NULL, (void **)&rhop));
+  for (PetscInt c = 0; c < ncells; c++) {
+    PetscInt pStart, pEnd;
+
+    PetscCall(DMSwarmSortGetPointRange(sw, c, &pStart, &pEnd));
+    rho[c] = 0.0;
+    for (PetscInt p = pStart; p < pEnd; p++) rho[c] += w[p];
+    for (PetscInt p = pStart; p < pEnd; p++) rhop[p] = rho[c];
+  }
+  PetscCall(DMSwarmRestoreField(sw, "density", NULL, NULL, (void **)&rhop));
+  PetscCall(DMSwarmRestoreField(sw, "weight", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmSortRestoreAccess(sw));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* check that the points are stored by cell and that all the fields were permuted together */
+static PetscErrorCode CheckPoints(DM sw, const PetscReal rho[], AppCtx *user)
+{
+  PetscReal *coor, *vel, *w, *rhop, v[2], wsum = 0.0, rhosum = 0.0;
+  PetscInt  *id, *cellid, n, ncells = user->nc * user->nc, cStart = 0;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMSwarmGetLocalSize(sw, &n));
+  PetscCall(DMSwarmSortGetAccess(sw));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmGetField(sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmGetField(sw, "weight", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmGetField(sw, "density", NULL, NULL, (void **)&rhop));
+  PetscCall(DMSwarmGetField(sw, "id", NULL, NULL, (void **)&id));
+  for (PetscInt c = 0; c < ncells; c++) {
+    PetscInt pStart, pEnd, npc;
+
+    PetscCall(DMSwarmSortGetPointRange(sw, c, &pStart, &pEnd));
+    PetscCall(DMSwarmSortGetNumberOfPointsPerCell(sw, c, &npc));
+    PetscCheck(pStart == cStart && pEnd - pStart == npc, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cell %" PetscInt_FMT " has points [%" PetscInt_FMT ", %" PetscInt_FMT ") instead of %" PetscInt_FMT " points from %" PetscInt_FMT, c, pStart, pEnd, npc, cStart);
+    for (PetscInt p = pStart; p < pEnd; p++) {
+      PetscCheck(cellid[p] == c && PointCell(user, id[p], &coor[2 * p]) == c, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point %" PetscInt_FMT " with cell %" PetscInt_FMT " is stored in cell %" PetscInt_FMT, p, cellid[p], c);
+      PetscCheck(rhop[p] == rho[c], PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point %" PetscInt_FMT " has the wrong interpolated density", p);
+    }
+    cStart = pEnd;
+    rhosum += rho[c];
+  }
+  for (PetscInt p = 0; p < n; p++) {
+    PointVelocity(id[p], v);
+    PetscCheck(w[p] == PointWeight(id[p]) && vel[2 * p] == v[0] && vel[2 * p + 1] == v[1], PETSC_COMM_SELF, PETSC_ERR_PLIB, "Fields of point %" PetscInt_FMT " were not permuted together", p);
+    if (p >= cStart) PetscCheck(cellid[p] == DMLOCATEPOINT_POINT_NOT_FOUND, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point %" PetscInt_FMT " in cell %" PetscInt_FMT " is stored after the cells", p, cellid[p]);
+    else wsum += w[p];
+  }
+  PetscCheck(wsum == rhosum, PETSC_COMM_SELF, PETSC_ERR_PLIB, "The deposit %g is not the sum of the weights %g", (double)rhosum, (double)wsum);
+  PetscCall(DMSwarmRestoreField(sw, "id", NULL, NULL, (void **)&id));
+  PetscCall(DMSwarmRestoreField(sw, "density", NULL, NULL, (void **)&rhop));
+  PetscCall(DMSwarmRestoreField(sw, "weight", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmRestoreField(sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmSortRestoreAccess(sw));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM             da, sw;
+  AppCtx         user;
+  PetscReal     *rho;
+  PetscLogDouble t0, t1, tpush = 0, tsort = 0, tdeposit = 0;
+  PetscInt       n, npushed = 0;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.nc     = 8;
+  user.np     = 2000;
+  user.nsteps = 10;
+  user.dt     = 0.05;
+  user.report = PETSC_FALSE;
+  PetscOptionsBegin(PETSC_COMM_SELF, NULL, "Sort test options", NULL);
+  PetscCall(PetscOptionsInt("-nc", "Number of cells in each direction", NULL, user.nc, &user.nc, NULL));
+  PetscCall(PetscOptionsInt("-np", "Number of points", NULL, user.np, &user.np, NULL));
+  PetscCall(PetscOptionsInt("-nsteps", "Number of pushes", NULL, user.nsteps, &user.nsteps, NULL));
+  PetscCall(PetscOptionsReal("-dt", "Time step of the pushes", NULL, user.dt, &user.dt, NULL));
+  PetscCall(PetscOptionsBool("-report_throughput", "Report the number of points pushed, sorted, and deposited per second", NULL, user.report, &user.report, NULL));
+  PetscOptionsEnd();
+
+  /* the sort is local to each process, the mesh and the points live on a single one */
+  PetscCall(DMDACreate2d(PETSC_COMM_SELF, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DMDA_STENCIL_BOX, user.nc + 1, user.nc + 1, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, &da));
+  PetscCall(DMSetUp(da));
+  PetscCall(DMDASetUniformCoordinates(da, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0));
+
+  PetscCall(DMCreate(PETSC_COMM_SELF, &sw));
+  PetscCall(DMSetType(sw, DMSWARM));
+  PetscCall(DMSetDimension(sw, 2));
+  PetscCall(DMSwarmSetType(sw, DMSWARM_PIC));
+  PetscCall(DMSwarmSetCellDM(sw, da));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "velocity", 2, PETSC_REAL));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "weight", 1, PETSC_REAL));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "density", 1, PETSC_REAL));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(sw, "id", 1, PETSC_INT));
+  PetscCall(DMSwarmFinalizeFieldRegister(sw));
+  PetscCall(DMSwarmSetLocalSizes(sw, user.np, 16));
+  PetscCall(InitializePoints(sw, 0, user.np, 0, &user));
+  PetscCall(PetscMalloc1(user.nc * user.nc, &rho));
+
+  PetscCall(DMSwarmSortPoints(sw));
+  for (PetscInt step = 0; step < user.nsteps; step++) {
+    PetscCall(PetscTime(&t0));
+    PetscCall(Push(sw, &user));
+    PetscCall(PetscTime(&t1));
+    tpush += t1 - t0;
+    if (step == user.nsteps / 2) {
+      /* remove and add points between two sorts */
+      PetscCall(DMSwarmGetLocalSize(sw, &n));
+      for (PetscInt p = n - 1; p >= 0; p -= 37) PetscCall(DMSwarmRemovePointAtIndex(sw, p));
+      PetscCall(DMSwarmGetLocalSize(sw, &n));
+      for (PetscInt p = 0; p < 50; p++) PetscCall(DMSwarmAddPoint(sw));
+      PetscCall(InitializePoints(sw, n, n + 50, user.np, &user));
+    }
+    PetscCall(PetscTime(&t0));
+    PetscCall(DMSwarmSortPoints(sw));
+    PetscCall(PetscTime(&t1));
+    tsort += t1 - t0;
+    PetscCall(DepositAndInterpolate(sw, rho, &user));
+    PetscCall(PetscTime(&t0));
+    tdeposit += t0 - t1;
+    PetscCall(CheckPoints(sw, rho, &user));
+    PetscCall(DMSwarmGetLocalSize(sw, &n));
+    npushed += n;
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_SELF, "Points stored by cell after %" PetscInt_FMT " pushes\n", user.nsteps));
+  if (user.report) PetscCall(PetscPrintf(PETSC_COMM_SELF, "Throughput in points per second: push %g, sort %g, deposit and interpolation %g\n", npushed / tpush, npushed / tsort, npushed / tdeposit));
+
+  PetscCall(PetscFree(rho));
+  PetscCall(DMDestroy(&sw));
+  PetscCall(DMDestroy(&da));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+     suffix: 0
+
+   test:
+     suffix: 1
+     args: -nc 5 -np 500 -nsteps 20 -dt 0.3
+
+TEST*/
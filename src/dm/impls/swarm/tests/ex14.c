@@ -0,0 +1,192 @@
+static char help[] = "Tests the migration of DMSwarm points to the neighbors of their cell on a distributed DMPLEX.\n";
+
+#include <petscdmplex.h>
+#include <petscdmswarm.h>
+#include <petscsf.h>
+
+typedef struct {
+  PetscInt  nsteps; /* number of pushes */
+  PetscReal dt;     /* time step of the pushes */
+  PetscInt  jump;   /* every jump steps a few points are moved to the other side of the domain */
+} AppCtx;
+
+/* the velocity of a point only depends on its initial position, so it does not depend on the partition */
+static PetscErrorCode CreateSwarm(DM dm, DM *sw)
+{
+  PetscReal *coor, *vel;
+  PetscInt   dim, npoints, p, d;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMGetDimension(dm, &dim));
+  PetscCall(DMCreate(PetscObjectComm((PetscObject)dm), sw));
+  PetscCall(DMSetType(*sw, DMSWARM));
+  PetscCall(DMSetDimension(*sw, dim));
+  PetscCall(DMSwarmSetType(*sw, DMSWARM_PIC));
+  PetscCall(DMSwarmSetCellDM(*sw, dm));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(*sw, "velocity", dim, PETSC_REAL));
+  PetscCall(DMSwarmFinalizeFieldRegister(*sw));
+  PetscCall(DMSwarmInsertPointsUsingCellDM(*sw, DMSWARMPIC_LAYOUT_GAUSS, 2));
+  PetscCall(DMSetUp(*sw));
+  PetscCall(DMSwarmGetLocalSize(*sw, &npoints));
+  PetscCall(DMSwarmGetField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(*sw, "velocity", NULL, NULL, (void **)&vel));
+  for (p = 0; p < npoints; ++p)
+    for (d = 0; d < dim; ++d) vel[p * dim + d] = PetscSinReal(7.0 * (d + 1) * coor[p * dim + (d + 1) % dim] + 3.0 * coor[p * dim + d]);
+  PetscCall(DMSwarmRestoreField(*sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmRestoreField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* moves the points in the unit box with reflecting walls, the points with a large first velocity component jump to the mirrored position */
+static PetscErrorCode Push(DM sw, PetscReal dt, PetscBool jump)
+{
+  PetscReal *coor, *vel;
+  PetscInt   dim, npoints, p, d;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMGetDimension(sw, &dim));
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(sw, "velocity", NULL, NULL, (void **)&vel));
+  for (p = 0; p < npoints; ++p) {
+    const PetscBool far = (PetscBool)(jump && vel[p * dim] > 0.99);
+
+    for (d = 0; d < dim; ++d) {
+      PetscReal *x = &coor[p * dim + d], *v = &vel[p * dim + d];
+
+      *x += dt * *v;
+      if (*x < 0.0) {
+        *x = -*x;
+        *v = -*v;
+      }
+      if (*x > 1.0) {
+        *x = 2.0 - *x;
+        *v = -*v;
+      }
+      if (far) *x = 1.0 - *x;
+    }
+  }
+  PetscCall(DMSwarmRestoreField(sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* sums the coordinates of the points to compare with the points which are not migrated */
+static PetscErrorCode SumCoordinates(DM sw, PetscReal *sum)
+{
+  PetscReal *coor;
+  PetscInt   dim, npoints, p, d;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMGetDimension(sw, &dim));
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  *sum = 0.0;
+  for (p = 0; p < npoints; ++p)
+    for (d = 0; d < dim; ++d) *sum += (d + 1) * coor[p * dim + d];
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE, sum, 1, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)sw)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* counts the points which are not in the cell they are stored with */
+static PetscErrorCode CheckCells(DM sw, PetscInt *nwrong)
+{
+  DM                 dm;
+  Vec                pos;
+  PetscSF            sfcell = NULL;
+  const PetscSFNode *cells;
+  PetscInt          *cellid, npoints, p;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMSwarmGetCellDM(sw, &dm));
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(DMSwarmCreateLocalVectorFromField(sw, DMSwarmPICField_coor, &pos));
+  PetscCall(DMLocatePoints(dm, pos, DM_POINTLOCATION_NONE, &sfcell));
+  PetscCall(DMSwarmDestroyLocalVectorFromField(sw, DMSwarmPICField_coor, &pos));
+  PetscCall(PetscSFGetGraph(sfcell, NULL, NULL, NULL, &cells));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  *nwrong = 0;
+  for (p = 0; p < npoints; ++p)
+    if (cells[p].index != cellid[p]) ++(*nwrong);
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid));
+  PetscCall(PetscSFDestroy(&sfcell));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE, nwrong, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject)sw)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM        dm, sw, swref;
+  AppCtx    user;
+  PetscInt  n, nref, nwrong, step;
+  PetscReal sum, sumref;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.nsteps = 10;
+  user.dt     = 0.05;
+  user.jump   = 4;
+  PetscOptionsBegin(PETSC_COMM_WORLD, "", "Neighbor migration test options", "DMSWARM");
+  PetscCall(PetscOptionsInt("-nsteps", "Number of pushes", NULL, user.nsteps, &user.nsteps, NULL));
+  PetscCall(PetscOptionsReal("-dt", "Time step of the pushes", NULL, user.dt, &user.dt, NULL));
+  PetscCall(PetscOptionsInt("-jump", "Number of pushes between jumps of a few points across the domain, 0 for none", NULL, user.jump, &user.jump, NULL));
+  PetscOptionsEnd();
+
+  PetscCall(DMCreate(PETSC_COMM_WORLD, &dm));
+  PetscCall(DMSetType(dm, DMPLEX));
+  PetscCall(DMSetFromOptions(dm));
+  PetscCall(DMViewFromOptions(dm, NULL, "-dm_view"));
+  PetscCall(CreateSwarm(dm, &sw));
+  PetscCall(DMSwarmSetMigrateType(sw, DMSWARM_MIGRATE_DMCELLNEIGHBOR));
+  PetscCall(CreateSwarm(dm, &swref));
+  PetscCall(DMSwarmGetSize(swref, &nref));
+
+  for (step = 1; step <= user.nsteps; ++step) {
+    const PetscBool jump = (PetscBool)(user.jump > 0 && step % user.jump == 0);
+
+    PetscCall(Push(sw, user.dt, jump));
+    PetscCall(Push(swref, user.dt, jump));
+    PetscCall(DMSwarmMigrate(sw, PETSC_TRUE));
+    PetscCall(DMSwarmGetSize(sw, &n));
+    PetscCall(CheckCells(sw, &nwrong));
+    PetscCall(SumCoordinates(sw, &sum));
+    PetscCall(SumCoordinates(swref, &sumref));
+    PetscCheck(n == nref, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Step %" PetscInt_FMT ": %" PetscInt_FMT " points after migration instead of %" PetscInt_FMT, step, n, nref);
+    PetscCheck(!nwrong, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Step %" PetscInt_FMT ": %" PetscInt_FMT " points are not in their cell", step, nwrong);
+    PetscCheck(PetscAbsReal(sum - sumref) <= 1e-10 * PetscAbsReal(sumref), PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Step %" PetscInt_FMT ": the migrated points differ from the points pushed in place", step);
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%" PetscInt_FMT " points in their cell after %" PetscInt_FMT " pushes\n", n, user.nsteps));
+
+  PetscCall(DMDestroy(&sw));
+  PetscCall(DMDestroy(&swref));
+  PetscCall(DMDestroy(&dm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  build:
+    requires: !complex double
+
+  test:
+    suffix: 0
+    args: -dm_plex_box_faces 6,6 -dm_plex_simplex 0
+
+  test:
+    suffix: 1
+    nsize: 4
+    args: -dm_plex_box_faces 6,6 -dm_plex_simplex 0 -petscpartitioner_type simple
+
+  test:
+    suffix: 1_simplex
+    nsize: 4
+    args: -dm_plex_filename ${wPETSC_DIR}/share/petsc/datafiles/meshes/square.msh -dm_refine 1 -petscpartitioner_type simple
+
+  test:
+    suffix: 3d
+    nsize: 3
+    args: -dm_plex_dim 3 -dm_plex_box_faces 4,4,4 -dm_plex_simplex 0 -petscpartitioner_type simple -nsteps 8 -dt 0.1
+
+TEST*/
@@ -0,0 +1,243 @@
+static char help[] = "Tests and benchmarks the threaded push and deposition of DMSwarm points on a DMDA and a DMPLEX.\n";
+
+#include <petscdmda.h>
+#include <petscdmplex.h>
+#include <petscdmswarm.h>
+#include <petscksp.h>
+#include <petsctime.h>
+#include <petsc/private/petscimpl.h>
+
+typedef struct {
+  PetscBool da;     /* use a DMDA instead of a DMPLEX */
+  PetscInt  order;  /* order of the Gauss points inserted in each cell */
+  PetscInt  nsteps; /* number of pushes */
+  PetscReal dt;     /* time step of the pushes */
+  PetscBool report; /* report the throughput of the push and deposition */
+} AppCtx;
+
+static PetscErrorCode CreateMesh(MPI_Comm comm, DM *dm, AppCtx *user)
+{
+  PetscFunctionBeginUser;
+  if (user->da) {
+    PetscCall(DMDACreate2d(comm, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE, DMDA_STENCIL_BOX, 9, 9, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, dm));
+    PetscCall(DMSetFromOptions(*dm));
+    PetscCall(DMSetUp(*dm));
+    PetscCall(DMDASetElementType(*dm, DMDA_ELEMENT_Q1));
+    PetscCall(DMDASetUniformCoordinates(*dm, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0));
+  } else {
+    PetscFE        fe;
+    DMPolytopeType ct;
+    PetscInt       dim, cStart;
+
+    PetscCall(DMCreate(comm, dm));
+    PetscCall(DMSetType(*dm, DMPLEX));
+    PetscCall(DMSetFromOptions(*dm));
+    PetscCall(DMGetDimension(*dm, &dim));
+    PetscCall(DMPlexGetHeightStratum(*dm, 0, &cStart, NULL));
+    PetscCall(DMPlexGetCellType(*dm, cStart, &ct));
+    PetscCall(PetscFECreateByCell(PETSC_COMM_SELF, dim, 1, ct, NULL, PETSC_DECIDE, &fe));
+    PetscCall(PetscObjectSetName((PetscObject)fe, "density"));
+    PetscCall(DMSetField(*dm, 0, NULL, (PetscObject)fe));
+    PetscCall(DMCreateDS(*dm));
+    PetscCall(PetscFEDestroy(&fe));
+  }
+  PetscCall(DMViewFromOptions(*dm, NULL, "-dm_view"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the velocity and weight of a point only depend on its initial position, so they do not depend on the partition */
+static PetscErrorCode CreateSwarm(DM dm, const char prefix[], DM *sw, AppCtx *user)
+{
+  PetscReal *coor, *vel, *w;
+  PetscInt   dim, npoints;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMGetDimension(dm, &dim));
+  PetscCall(DMCreate(PetscObjectComm((PetscObject)dm), sw));
+  PetscCall(DMSetType(*sw, DMSWARM));
+  PetscCall(DMSetOptionsPrefix(*sw, prefix));
+  PetscCall(DMSetDimension(*sw, dim));
+  PetscCall(DMSwarmSetType(*sw, DMSWARM_PIC));
+  PetscCall(DMSwarmSetCellDM(*sw, dm));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(*sw, "velocity", dim, PETSC_REAL));
+  PetscCall(DMSwarmRegisterPetscDatatypeField(*sw, "w", 1, PETSC_REAL));
+  PetscCall(DMSwarmFinalizeFieldRegister(*sw));
+  PetscCall(DMSwarmInsertPointsUsingCellDM(*sw, DMSWARMPIC_LAYOUT_GAUSS, user->order));
+  PetscCall(DMSetUp(*sw));
+  PetscCall(DMSwarmGetLocalSize(*sw, &npoints));
+  PetscCall(DMSwarmGetField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(*sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmGetField(*sw, "w", NULL, NULL, (void **)&w));
+  for (PetscInt p = 0; p < npoints; ++p) {
+    for (PetscInt d = 0; d < dim; ++d) vel[p * dim + d] = PetscSinReal(7.0 * (d + 1) * coor[p * dim + (d + 1) % dim] + 3.0 * coor[p * dim + d]);
+    w[p] = 1.0 + 0.5 * PetscCosReal(5.0 * coor[p * dim]);
+  }
+  PetscCall(DMSwarmRestoreField(*sw, "w", NULL, NULL, (void **)&w));
+  PetscCall(DMSwarmRestoreField(*sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmRestoreField(*sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* moves the points in the periodic unit box, the points are independent so the loop is threaded */
+static PetscErrorCode Push(DM sw, PetscReal dt)
+{
+  PetscReal *coor, *vel;
+  PetscInt   dim, npoints;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMGetDimension(sw, &dim));
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmGetField(sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscPragmaUseOMPKernels(parallel for schedule(static))
+  for (PetscInt i = 0; i < npoints * dim; ++i) {
+    coor[i] += dt * vel[i];
+    coor[i] -= PetscFloorReal(coor[i]);
+  }
+  PetscCall(DMSwarmRestoreField(sw, "velocity", NULL, NULL, (void **)&vel));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmMigrate(sw, PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* checks that the conservative projection u solves M u = M_p^T w with the assembled particle mass matrix M_p */
+static PetscErrorCode CheckConservative(DM sw, DM dm, Vec u, PetscReal *err)
+{
+  Mat       M, M_p;
+  Vec       w, r, rhs;
+  PetscReal nrhs;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMCreateMassMatrix(dm, dm, &M));
+  PetscCall(DMCreateMassMatrix(sw, dm, &M_p));
+  PetscCall(DMGetGlobalVector(dm, &r));
+  PetscCall(DMGetGlobalVector(dm, &rhs));
+  PetscCall(DMSwarmCreateGlobalVectorFromField(sw, "w", &w));
+  PetscCall(MatMultTranspose(M_p, w, rhs));
+  PetscCall(DMSwarmDestroyGlobalVectorFromField(sw, "w", &w));
+  PetscCall(MatMult(M, u, r));
+  PetscCall(VecAXPY(r, -1.0, rhs));
+  PetscCall(VecNorm(r, NORM_2, err));
+  PetscCall(VecNorm(rhs, NORM_2, &nrhs));
+  *err /= nrhs;
+  PetscCall(DMRestoreGlobalVector(dm, &rhs));
+  PetscCall(DMRestoreGlobalVector(dm, &r));
+  PetscCall(MatDestroy(&M_p));
+  PetscCall(MatDestroy(&M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm, sw, swref;
+  Vec            u, uref;
+  AppCtx         user;
+  const char    *fieldnames[1] = {"w"};
+  PetscInt       n, ncores = 1;
+  PetscReal      err, nref, errmax = 0.0, errcons = 0.0;
+  PetscLogDouble t0, t1, tpush = 0.0, tdeposit = 0.0;
+  PetscMPIInt    size;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.da     = PETSC_FALSE;
+  user.order  = 3;
+  user.nsteps = 5;
+  user.dt     = 0.05;
+  user.report = PETSC_FALSE;
+  PetscOptionsBegin(PETSC_COMM_WORLD, "", "Threaded push and deposition options", "DMSWARM");
+  PetscCall(PetscOptionsBool("-da", "Use a DMDA instead of a DMPLEX", NULL, user.da, &user.da, NULL));
+  PetscCall(PetscOptionsInt("-order", "Order of the Gauss points inserted in each cell", NULL, user.order, &user.order, NULL));
+  PetscCall(PetscOptionsInt("-nsteps", "Number of pushes", NULL, user.nsteps, &user.nsteps, NULL));
+  PetscCall(PetscOptionsReal("-dt", "Time step of the pushes", NULL, user.dt, &user.dt, NULL));
+  PetscCall(PetscOptionsBool("-report_throughput", "Report the throughput of the push and deposition", NULL, user.report, &user.report, NULL));
+  PetscOptionsEnd();
+
+  PetscCall(CreateMesh(PETSC_COMM_WORLD, &dm, &user));
+  /* the reference swarm is deposited with the options of the ref_ prefix, typically in a single chunk */
+  PetscCall(CreateSwarm(dm, NULL, &sw, &user));
+  PetscCall(CreateSwarm(dm, "ref_", &swref, &user));
+  PetscCall(DMCreateGlobalVector(dm, &u));
+  PetscCall(DMCreateGlobalVector(dm, &uref));
+
+  for (PetscInt step = 0; step < user.nsteps; ++step) {
+    PetscCall(PetscTime(&t0));
+    PetscCall(Push(sw, user.dt));
+    PetscCall(PetscTime(&t1));
+    tpush += t1 - t0;
+    PetscCall(DMSwarmProjectFields(sw, NULL, 1, fieldnames, &u, SCATTER_FORWARD));
+    PetscCall(PetscTime(&t0));
+    tdeposit += t0 - t1;
+
+    PetscCall(Push(swref, user.dt));
+    PetscCall(DMSwarmProjectFields(swref, NULL, 1, fieldnames, &uref, SCATTER_FORWARD));
+    PetscCall(VecNorm(uref, NORM_2, &nref));
+    PetscCall(VecAXPY(uref, -1.0, u));
+    PetscCall(VecNorm(uref, NORM_2, &err));
+    errmax = PetscMax(errmax, err / nref);
+  }
+  if (!user.da) PetscCall(CheckConservative(sw, dm, u, &errcons));
+  PetscCall(DMSwarmGetSize(sw, &n));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Deposition of %" PetscInt_FMT " points after %" PetscInt_FMT " pushes %s the reference\n", n, user.nsteps, errmax < 1e-12 && errcons < 1e-10 ? "matches" : "differs from"));
+  if (user.report) {
+    PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+#if defined(PETSC_USE_OPENMP_KERNELS)
+    ncores = PetscMax(PetscNumOMPThreads, 1);
+#endif
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE, &tpush, 1, MPIU_PETSCLOGDOUBLE, MPI_MAX, PETSC_COMM_WORLD));
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE, &tdeposit, 1, MPIU_PETSCLOGDOUBLE, MPI_MAX, PETSC_COMM_WORLD));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Throughput in points per second per core on %d processes with %" PetscInt_FMT " threads: push %g, deposition %g\n", size, ncores, n * user.nsteps / (tpush * size * ncores), n * user.nsteps / (tdeposit * size * ncores)));
+  }
+
+  PetscCall(VecDestroy(&u));
+  PetscCall(VecDestroy(&uref));
+  PetscCall(DMDestroy(&sw));
+  PetscCall(DMDestroy(&swref));
+  PetscCall(DMDestroy(&dm));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  build:
+    requires: !complex double
+
+  testset:
+    args: -dm_swarm_project_chunks 3 -ref_dm_swarm_project_chunks 1
+    output_file: output/ex15_da.out
+
+    test:
+      suffix: da
+      args: -da
+
+    test:
+      suffix: da_2
+      nsize: 2
+      args: -da
+
+  testset:
+    args: -dm_plex_box_faces 6,6 -dm_plex_simplex 0 -dm_swarm_project_chunks 3 -ref_dm_swarm_project_chunks 1 \
+          -ptof_ksp_type cg -ptof_pc_type jacobi -ptof_ksp_rtol 1e-14 -ref_ptof_ksp_type cg -ref_ptof_pc_type jacobi -ref_ptof_ksp_rtol 1e-14
+
+    test:
+      suffix: plex
+      output_file: output/ex15_plex.out
+
+    test:
+      suffix: plex_2
+      nsize: 2
+      args: -petscpartitioner_type simple -dm_swarm_migrate_type dmcellneighbor
+      output_file: output/ex15_plex.out
+
+    test:
+      suffix: plex_q2
+      args: -petscspace_degree 2
+      output_file: output/ex15_plex.out
+
+    test:
+      suffix: plex_3d
+      args: -dm_plex_dim 3 -dm_plex_box_faces 3,3,3 -order 2
+      output_file: output/ex15_plex_3d.out
+
+TEST*/
@@ -0,0 +1,347 @@
+#include <petsc/private/partitionerimpl.h> /*I "petscpartitioner.h" I*/
+#include <petsc/private/hashseti.h>
+
+typedef struct {
+  PetscInt  maxIt;       /* Maximum number of diffusion iterations on the process graph */
+  PetscReal tol;         /* Relative load imbalance below which no vertex is moved */
+  PetscInt  its;         /* Number of diffusion iterations in the last partition */
+  PetscReal imbBefore;   /* Load imbalance of the input distribution */
+  PetscReal imbAfter;    /* Load imbalance of the computed partition */
+  PetscReal migrated;    /* Fraction of the total weight moved by the last partition */
+  PetscBool fromScratch; /* The last partition was not computed by diffusion */
+} PetscPartitioner_Diffusive;
+
+static PetscErrorCode PetscPartitionerDestroy_Diffusive(PetscPartitioner part)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree(part->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscPartitionerView_Diffusive_ASCII(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *)part->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerASCIIPushTab(viewer));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "imbalance tolerance %g, maximum diffusion iterations %" PetscInt_FMT "\n", (double)p->tol, p->maxIt));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "load imbalance %.4g -> %.4g, migrated weight %.4g%%%s\n", (double)p->imbBefore, (double)p->imbAfter, (double)(100.0 * p->migrated), p->fromScratch ? " (partitioned from scratch)" : ""));
+  PetscCall(PetscViewerASCIIPopTab(viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscPartitionerView_Diffusive(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscBool iascii;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) PetscCall(PetscPartitionerView_Diffusive_ASCII(part, viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscPartitionerSetFromOptions_Diffusive(PetscPartitioner part, PetscOptionItems *PetscOptionsObject)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *)part->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscPartitioner Diffusive Options");
+  PetscCall(PetscOptionsBoundedInt("-petscpartitioner_diffusive_max_it", "Maximum number of diffusion iterations on the process graph", "", p->maxIt, &p->maxIt, NULL, 0));
+  PetscCall(PetscOptionsBoundedReal("-petscpartitioner_diffusive_tol", "Relative load imbalance that is accepted without moving vertices", "", p->tol, &p->tol, NULL, 0.0));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The process owning global vertex v, vtxdist[r] <= v < vtxdist[r+1] */
+static inline PetscMPIInt PetscPartitionerDiffusiveOwner_Private(PetscMPIInt size, const PetscInt vtxdist[], PetscInt v)
+{
+  PetscMPIInt lo = 0, hi = size;
+
+  while (hi - lo > 1) {
+    const PetscMPIInt mid = lo + (hi - lo) / 2;
+
+    if (vtxdist[mid] <= v) lo = mid;
+    else hi = mid;
+  }
+  return lo;
+}
+
+static PetscErrorCode PetscPartitionerPartition_Diffusive(PetscPartitioner part, PetscInt nparts, PetscInt numVertices, PetscInt start[], PetscInt adjacency[], PetscSection vertSection, PetscSection edgeSection, PetscSection targetSection, PetscSection partSection, IS *partition)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *)part->data;
+  MPI_Comm                    comm;
+  PetscMPIInt                 size, rank, r;
+  PetscInt                   *vtxdist, *vwgt, *dest, *load, *points, *offsets;
+  PetscReal                  *goal, *newLoad, total = 0.0, moved = 0.0, imb;
+  PetscInt                    myLoad = 0, v, np, e;
+  PetscBool                   fromScratch = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)part, &comm));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCheck(nparts == size, comm, PETSC_ERR_SUP, "Diffusive repartitioning needs one part per process, %" PetscInt_FMT " parts != %d processes", nparts, size);
+  if (edgeSection) PetscCall(PetscInfo(part, "PETSCPARTITIONERDIFFUSIVE ignores edge weights\n"));
+  /* Current distribution and loads */
+  PetscCall(PetscMalloc6(size + 1, &vtxdist, numVertices, &vwgt, numVertices, &dest, size, &load, size, &goal, size, &newLoad));
+  vtxdist[0] = 0;
+  PetscCallMPI(MPI_Allgather(&numVertices, 1, MPIU_INT, &vtxdist[1], 1, MPIU_INT, comm));
+  for (r = 0; r < size; ++r) vtxdist[r + 1] += vtxdist[r];
+  for (v = 0; v < numVertices; ++v) {
+    vwgt[v] = 1;
+    if (vertSection) PetscCall(PetscSectionGetDof(vertSection, v, &vwgt[v]));
+    myLoad += vwgt[v];
+    dest[v] = rank;
+  }
+  PetscCallMPI(MPI_Allgather(&myLoad, 1, MPIU_INT, load, 1, MPIU_INT, comm));
+  for (r = 0; r < size; ++r) total += load[r];
+  /* Target load of each process */
+  {
+    PetscInt tw, sumw = 0;
+
+    for (r = 0; r < size && targetSection; ++r) {
+      PetscCall(PetscSectionGetDof(targetSection, r, &tw));
+      sumw += tw;
+    }
+    for (r = 0; r < size; ++r) {
+      goal[r] = total / size;
+      if (sumw) {
+        PetscCall(PetscSectionGetDof(targetSection, r, &tw));
+        goal[r] = (total * tw) / sumw;
+      }
+    }
+  }
+  for (r = 0, imb = 1.0; r < size; ++r)
+    if (goal[r] > 0.0) imb = PetscMax(imb, load[r] / goal[r]);
+  p->imbBefore = imb;
+  p->its       = 0;
+  /* A process without vertices cannot receive any by diffusion, so the graph is cut into contiguous weighted slices instead */
+  for (r = 0; r < size; ++r)
+    if (!load[r] && goal[r] > 0.0) fromScratch = PETSC_TRUE;
+  if (fromScratch) {
+    PetscInt  offset = 0;
+    PetscReal cum    = 0.0, mid;
+
+    PetscCallMPI(MPI_Exscan(&myLoad, &offset, 1, MPIU_INT, MPI_SUM, comm));
+    if (!rank) offset = 0;
+    for (v = 0, np = 0; v < numVertices; ++v) {
+      mid = offset + 0.5 * vwgt[v];
+      while (np < nparts - 1 && mid >= cum + goal[np]) cum += goal[np++];
+      dest[v] = np;
+      offset += vwgt[v];
+    }
+  } else if (imb > 1.0 + p->tol) {
+    PetscHSetI  ht;
+    PetscInt   *nbrs, *gnbrs, *gdeg, *goff, *queue, *mark, *gain, nn, k, it;
+    PetscReal  *excess, *update, *flow;
+    PetscMPIInt nn32, *cnts, *displs;
+
+    /* Neighboring processes in the graph */
+    PetscCall(PetscHSetICreate(&ht));
+    for (e = 0; e < (numVertices ? start[numVertices] : 0); ++e) {
+      r = PetscPartitionerDiffusiveOwner_Private(size, vtxdist, adjacency[e]);
+      if (r != rank) PetscCall(PetscHSetIAdd(ht, r));
+    }
+    PetscCall(PetscHSetIGetSize(ht, &nn));
+    PetscCall(PetscMalloc1(nn, &nbrs));
+    k = 0;
+    PetscCall(PetscHSetIGetElems(ht, &k, nbrs));
+    PetscCall(PetscHSetIDestroy(&ht));
+    PetscCall(PetscSortInt(nn, nbrs));
+    /* Every process solves the diffusion problem on the (small) process graph redundantly */
+    PetscCall(PetscMPIIntCast(nn, &nn32));
+    PetscCall(PetscMalloc3(size, &cnts, size + 1, &displs, size + 1, &goff));
+    PetscCallMPI(MPI_Allgather(&nn32, 1, MPI_INT, cnts, 1, MPI_INT, comm));
+    displs[0] = 0;
+    goff[0]   = 0;
+    for (r = 0; r < size; ++r) {
+      displs[r + 1] = displs[r] + cnts[r];
+      goff[r + 1]   = displs[r + 1];
+    }
+    PetscCall(PetscMalloc2(goff[size], &gnbrs, size, &gdeg));
+    PetscCallMPI(MPI_Allgatherv(nbrs, nn32, MPIU_INT, gnbrs, cnts, displs, MPIU_INT, comm));
+    for (r = 0; r < size; ++r) gdeg[r] = goff[r + 1] - goff[r];
+    PetscCall(PetscMalloc3(size, &excess, size, &update, nn, &flow));
+    for (r = 0; r < size; ++r) excess[r] = load[r] - goal[r];
+    for (k = 0; k < nn; ++k) flow[k] = 0.0;
+    /* First order diffusion: every edge moves alpha times the difference of the excess loads of its ends */
+    for (it = 0; it < p->maxIt; ++it) {
+      PetscReal err = 0.0;
+
+      for (r = 0; r < size; ++r)
+        if (goal[r] > 0.0) err = PetscMax(err, excess[r] / goal[r]);
+      if (err <= p->tol) break;
+      for (r = 0; r < size; ++r) update[r] = 0.0;
+      for (r = 0; r < size; ++r) {
+        for (e = goff[r]; e < goff[r + 1]; ++e) {
+          const PetscInt  j     = gnbrs[e];
+          const PetscReal alpha = 1.0 / (1.0 + PetscMax(gdeg[r], gdeg[j]));
+          PetscReal       f;
+
+          if (j < r) continue;
+          f = alpha * (excess[r] - excess[j]);
+          update[r] -= f;
+          update[j] += f;
+          if (r == rank) flow[e - goff[r]] += f;
+          else if (j == rank) {
+            PetscCall(PetscFindInt(r, nn, nbrs, &k));
+            if (k >= 0) flow[k] -= f;
+          }
+        }
+      }
+      for (r = 0; r < size; ++r) excess[r] += update[r];
+    }
+    p->its = it;
+    /* Move boundary layers towards each neighbor until the outgoing flow is matched, starting with the cells that have the most edges into the neighbor */
+    PetscCall(PetscMalloc3(numVertices, &queue, numVertices, &mark, numVertices, &gain));
+    for (v = 0; v < numVertices; ++v) mark[v] = -1;
+    for (k = 0; k < nn; ++k) {
+      PetscReal sent = 0.0;
+      PetscInt  head = 0, tail = 0;
+
+      if (flow[k] <= 0.0) continue;
+      for (v = 0; v < numVertices; ++v) {
+        PetscInt cnt = 0;
+
+        if (dest[v] != rank) continue;
+        for (e = start[v]; e < start[v + 1]; ++e)
+          if (PetscPartitionerDiffusiveOwner_Private(size, vtxdist, adjacency[e]) == nbrs[k]) ++cnt;
+        if (cnt) {
+          gain[tail]    = -cnt;
+          queue[tail++] = v;
+          mark[v]       = k;
+        }
+      }
+      PetscCall(PetscSortIntWithArray(tail, gain, queue));
+      while (head < tail) {
+        const PetscInt u = queue[head++];
+
+        if (sent + 0.5 * vwgt[u] > flow[k]) break;
+        dest[u] = nbrs[k];
+        sent += vwgt[u];
+        for (e = start[u]; e < start[u + 1]; ++e) {
+          const PetscInt w = adjacency[e] - vtxdist[rank];
+
+          if (w < 0 || w >= numVertices || dest[w] != rank || mark[w] == k) continue;
+          mark[w]       = k;
+          queue[tail++] = w;
+        }
+      }
+    }
+    PetscCall(PetscFree3(queue, mark, gain));
+    PetscCall(PetscFree3(excess, update, flow));
+    PetscCall(PetscFree2(gnbrs, gdeg));
+    PetscCall(PetscFree3(cnts, displs, goff));
+    PetscCall(PetscFree(nbrs));
+  }
+  /* Assemble the partition */
+  PetscCall(PetscMalloc2(numVertices, &points, nparts + 1, &offsets));
+  for (np = 0; np <= nparts; ++np) offsets[np] = 0;
+  for (r = 0; r < size; ++r) newLoad[r] = 0.0;
+  for (v = 0; v < numVertices; ++v) {
+    ++offsets[dest[v] + 1];
+    newLoad[dest[v]] += vwgt[v];
+    if (dest[v] != rank) moved += vwgt[v];
+  }
+  for (np = 0; np < nparts; ++np) {
+    PetscCall(PetscSectionSetDof(partSection, np, offsets[np + 1]));
+    offsets[np + 1] += offsets[np];
+  }
+  for (v = 0; v < numVertices; ++v) points[offsets[dest[v]]++] = v;
+  PetscCall(ISCreateGeneral(PETSC_COMM_SELF, numVertices, points, PETSC_COPY_VALUES, partition));
+  PetscCall(PetscFree2(points, offsets));
+  /* Report the imbalance and the migration volume */
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, newLoad, size, MPIU_REAL, MPIU_SUM, comm));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &moved, 1, MPIU_REAL, MPIU_SUM, comm));
+  for (r = 0, imb = 1.0; r < size; ++r)
+    if (goal[r] > 0.0) imb = PetscMax(imb, newLoad[r] / goal[r]);
+  p->imbAfter    = imb;
+  p->migrated    = total > 0.0 ? moved / total : 0.0;
+  p->fromScratch = fromScratch;
+  PetscCall(PetscInfo(part, "Load imbalance %g -> %g after %" PetscInt_FMT " diffusion iterations, migrating %g%% of the weight\n", (double)p->imbBefore, (double)p->imbAfter, p->its, (double)(100.0 * p->migrated)));
+  PetscCall(PetscFree6(vtxdist, vwgt, dest, load, goal, newLoad));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscPartitionerInitialize_Diffusive(PetscPartitioner part)
+{
+  PetscFunctionBegin;
+  part->noGraph             = PETSC_FALSE;
+  part->ops->view           = PetscPartitionerView_Diffusive;
+  part->ops->setfromoptions = PetscPartitionerSetFromOptions_Diffusive;
+  part->ops->destroy        = PetscPartitionerDestroy_Diffusive;
+  part->ops->partition      = PetscPartitionerPartition_Diffusive;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PetscPartitionerDiffusiveGetImbalance - Get the load imbalance before and after the last partition computed by a `PETSCPARTITIONERDIFFUSIVE`
+
+  Not Collective
+
+  Input Parameter:
+. part - The `PetscPartitioner`
+
+  Output Parameters:
++ before   - The maximum ratio of process load to target load for the input distribution
+. after    - The maximum ratio of process load to target load for the computed partition
+- migrated - The fraction of the total vertex weight that changes process
+
+  Level: intermediate
+
+.seealso: `PETSCPARTITIONERDIFFUSIVE`, `PetscPartitionerPartition()`, `DMPlexDistribute()`
+@*/
+PetscErrorCode PetscPartitionerDiffusiveGetImbalance(PetscPartitioner part, PetscReal *before, PetscReal *after, PetscReal *migrated)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *)part->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(part, PETSCPARTITIONER_CLASSID, 1, PETSCPARTITIONERDIFFUSIVE);
+  if (before) *before = p->imbBefore;
+  if (after) *after = p->imbAfter;
+  if (migrated) *migrated = p->migrated;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+  PETSCPARTITIONERDIFFUSIVE = "diffusive" - A PetscPartitioner object that rebalances an existing distribution
+
+  Options Database Keys:
++ -petscpartitioner_diffusive_tol <tol>   - Relative imbalance accepted without moving vertices, default 0.05
+- -petscpartitioner_diffusive_max_it <it> - Maximum number of diffusion iterations on the process graph, default 100
+
+  Level: intermediate
+
+  Notes:
+  The current owner of each graph vertex is taken as the starting point. A first order diffusion on the graph of neighboring processes
+  computes how much weight must flow across each process boundary, and each process then hands over layers of cells adjacent to the
+  receiving neighbor, so that only a thin band of the mesh migrates. Vertex weights, for example from `-petscpartitioner_use_vertex_weights`,
+  and target partition weights are respected.
+
+  Calling `DMPlexDistribute()` on a distributed mesh with this partitioner returns the migration `PetscSF`, which can be used to move
+  fields with `DMPlexDistributeField()`. The imbalance before and after is shown by `-petscpartitioner_view` and `PetscPartitionerDiffusiveGetImbalance()`.
+
+  If a process owns no vertex, for instance when the mesh has not been distributed yet, the graph is cut into contiguous slices of
+  equal weight instead.
+
+.seealso: `PetscPartitionerType`, `PetscPartitionerCreate()`, `PetscPartitionerSetType()`, `PetscPartitionerDiffusiveGetImbalance()`
+M*/
+
+PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_Diffusive(PetscPartitioner part)
+{
+  PetscPartitioner_Diffusive *p;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  PetscCall(PetscNew(&p));
+  p->maxIt     = 100;
+  p->tol       = 0.05;
+  p->imbBefore = 1.0;
+  p->imbAfter  = 1.0;
+  part->data   = p;
+
+  PetscCall(PetscPartitionerInitialize_Diffusive(part));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -160,6 +160,11 @@ finally:
     nsize: {{1 2 3}separate output}
     args: -nparts {{1 2 3}separate output} -petscpartitioner_type gather -petscpartitioner_view -petscpartitioner_view_graph
 
+  test:
+    suffix: diffusive
+    nsize: {{1 2 3}separate output}
+    args: -pwgts {{false true}separate output} -petscpartitioner_type diffusive -petscpartitioner_view
+
   test:
     requires: parmetis
     suffix: parmetis
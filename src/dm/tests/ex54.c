@@ -0,0 +1,278 @@
+static char help[] = "Tests the DMDA stencil matrix against the assembled MATAIJ matrix of the same stencil.\n\n";
+
+#include <petscdmda.h>
+#include <petscksp.h>
+#include <petsctime.h>
+
+typedef struct {
+  PetscBool variable; /* coefficients varying from point to point */
+  PetscBool periodic; /* periodic boundaries */
+  PetscInt  bench;    /* number of products timed */
+} AppCtx;
+
+/* diagonally dominant coefficients, the coefficient of entry e at the point (i, j, k) */
+static PetscScalar Coefficient(PetscInt n, const MatStencil *o, PetscInt e, PetscInt i, PetscInt j, PetscInt k, AppCtx *user)
+{
+  if (!o->i && !o->j && !o->k) return n + 1.0 + (user->variable ? PetscSinReal(i + 2.0 * j + 3.0 * k) : 0.0);
+  return -(1.0 + (user->variable ? 0.5 * PetscSinReal(0.3 * i + 0.7 * j + 1.1 * k + e) : 0.0));
+}
+
+static PetscErrorCode CreateMatrices(DM da, Mat *A, Mat *B, AppCtx *user)
+{
+  DMDALocalInfo     info;
+  const MatStencil *st;
+  MatStencil        row, *cols;
+  PetscScalar      *vals;
+  PetscInt          n;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMDAGetLocalInfo(da, &info));
+  PetscCall(DMDACreateStencilMatrix(da, 0, NULL, A));
+  PetscCall(MatSetFromOptions(*A));
+  PetscCall(DMDAStencilMatrixGetStencil(*A, &n, &st));
+  PetscCall(PetscMalloc2(n, &cols, n, &vals));
+  if (user->variable) {
+    DM           cda;
+    Vec          c;
+    PetscScalar *ca;
+    PetscInt     p = 0;
+
+    PetscCall(DMDACreateCompatibleDMDA(da, n, &cda));
+    PetscCall(DMCreateGlobalVector(cda, &c));
+    PetscCall(VecGetArray(c, &ca));
+    for (PetscInt k = info.zs; k < info.zs + info.zm; k++)
+      for (PetscInt j = info.ys; j < info.ys + info.ym; j++)
+        for (PetscInt i = info.xs; i < info.xs + info.xm; i++, p++)
+          for (PetscInt e = 0; e < n; e++) ca[p * n + e] = Coefficient(n, &st[e], e, i, j, k, user);
+    PetscCall(VecRestoreArray(c, &ca));
+    PetscCall(DMDAStencilMatrixSetVariableCoefficients(*A, c));
+    PetscCall(VecDestroy(&c));
+    PetscCall(DMDestroy(&cda));
+  } else {
+    for (PetscInt e = 0; e < n; e++) vals[e] = Coefficient(n, &st[e], e, 0, 0, 0, user);
+    PetscCall(DMDAStencilMatrixSetCoefficients(*A, vals));
+  }
+
+  /* the neighbors outside of a nonperiodic domain are dropped */
+  PetscCall(DMCreateMatrix(da, B));
+  for (PetscInt k = info.zs; k < info.zs + info.zm; k++)
+    for (PetscInt j = info.ys; j < info.ys + info.ym; j++)
+      for (PetscInt i = info.xs; i < info.xs + info.xm; i++) {
+        PetscInt nc = 0;
+
+        row.i = i;
+        row.j = j;
+        row.k = k;
+        for (PetscInt e = 0; e < n; e++) {
+          const PetscInt ii = i + st[e].i, jj = j + st[e].j, kk = k + st[e].k;
+
+          if (!user->periodic && (ii < 0 || ii >= info.mx || jj < 0 || jj >= info.my || kk < 0 || kk >= info.mz)) continue;
+          cols[nc].i = ii;
+          cols[nc].j = jj;
+          cols[nc].k = kk;
+          vals[nc++] = Coefficient(n, &st[e], e, i, j, k, user);
+        }
+        PetscCall(MatSetValuesStencil(*B, 1, &row, nc, cols, vals, INSERT_VALUES));
+      }
+  PetscCall(MatAssemblyBegin(*B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*B, MAT_FINAL_ASSEMBLY));
+  PetscCall(PetscFree2(cols, vals));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode Compare(const char name[], Vec x, Vec y)
+{
+  PetscReal nrm, err;
+  Vec       d;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecDuplicate(x, &d));
+  PetscCall(VecWAXPY(d, -1.0, x, y));
+  PetscCall(VecNorm(d, NORM_INFINITY, &err));
+  PetscCall(VecNorm(y, NORM_INFINITY, &nrm));
+  PetscCall(PetscPrintf(PetscObjectComm((PetscObject)x), "%s %s MATAIJ\n", name, err <= 1e-12 * nrm ? "matches" : "differs from"));
+  PetscCall(VecDestroy(&d));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode Test(Mat A, Mat B, Vec x, Vec b, AppCtx *user)
+{
+  Vec y, z;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecDuplicate(x, &z));
+  PetscCall(MatMult(A, x, y));
+  PetscCall(MatMult(B, x, z));
+  PetscCall(Compare("MatMult", y, z));
+  PetscCall(MatGetDiagonal(A, y));
+  PetscCall(MatGetDiagonal(B, z));
+  PetscCall(Compare("MatGetDiagonal", y, z));
+  /* the local sweeps of a periodic process which is its own neighbor only see the ghost points of the previous iteration */
+  if (!user->periodic) {
+    PetscCall(VecCopy(x, y));
+    PetscCall(VecCopy(x, z));
+    PetscCall(MatSOR(A, b, 1.1, SOR_LOCAL_SYMMETRIC_SWEEP, 0.0, 2, 1, y));
+    PetscCall(MatSOR(B, b, 1.1, SOR_LOCAL_SYMMETRIC_SWEEP, 0.0, 2, 1, z));
+    PetscCall(Compare("MatSOR symmetric", y, z));
+    PetscCall(MatSOR(A, b, 0.9, (MatSORType)(SOR_LOCAL_FORWARD_SWEEP | SOR_ZERO_INITIAL_GUESS), 0.5, 2, 3, y));
+    PetscCall(MatSOR(B, b, 0.9, (MatSORType)(SOR_LOCAL_FORWARD_SWEEP | SOR_ZERO_INITIAL_GUESS), 0.5, 2, 3, z));
+    PetscCall(Compare("MatSOR forward", y, z));
+    PetscCall(MatSOR(A, b, 1.0, SOR_LOCAL_BACKWARD_SWEEP, 0.0, 1, 4, y));
+    PetscCall(MatSOR(B, b, 1.0, SOR_LOCAL_BACKWARD_SWEEP, 0.0, 1, 4, z));
+    PetscCall(Compare("MatSOR backward", y, z));
+  }
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode Solve(Mat A, Mat B, Vec b)
+{
+  KSP      ksp;
+  Vec      y, z;
+  PetscInt ita, itb;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecDuplicate(b, &y));
+  PetscCall(VecDuplicate(b, &z));
+  PetscCall(KSPCreate(PetscObjectComm((PetscObject)A), &ksp));
+  PetscCall(KSPSetTolerances(ksp, 1e-10, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT));
+  PetscCall(KSPSetFromOptions(ksp));
+  PetscCall(KSPSetOperators(ksp, A, A));
+  PetscCall(KSPSolve(ksp, b, y));
+  PetscCall(KSPGetIterationNumber(ksp, &ita));
+  PetscCall(KSPSetOperators(ksp, B, B));
+  PetscCall(KSPSolve(ksp, b, z));
+  PetscCall(KSPGetIterationNumber(ksp, &itb));
+  PetscCall(Compare("KSPSolve", y, z));
+  PetscCall(PetscPrintf(PetscObjectComm((PetscObject)A), "Number of iterations %s\n", ita == itb ? "matches" : "differs"));
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode Bench(Mat A, Mat B, Vec x, AppCtx *user)
+{
+  Vec            y;
+  PetscLogDouble t0, t1, ta, tb;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(PetscTime(&t0));
+  for (PetscInt it = 0; it < user->bench; it++) PetscCall(MatMult(A, x, y));
+  PetscCall(PetscTime(&t1));
+  ta = t1 - t0;
+  for (PetscInt it = 0; it < user->bench; it++) PetscCall(MatMult(B, x, y));
+  PetscCall(PetscTime(&t0));
+  tb = t0 - t1;
+  PetscCall(PetscPrintf(PetscObjectComm((PetscObject)A), "Time of %" PetscInt_FMT " products: stencil %g s, MATAIJ %g s, speedup %g\n", user->bench, ta, tb, tb / ta));
+  PetscCall(VecDestroy(&y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM             da;
+  Mat            A, B;
+  Vec            x, b;
+  AppCtx         user;
+  PetscInt       dim = 2, M = 11, sw = 1;
+  PetscBool      box = PETSC_FALSE;
+  DMBoundaryType bt;
+  PetscRandom    rand;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.variable = PETSC_FALSE;
+  user.periodic = PETSC_FALSE;
+  user.bench    = 0;
+  PetscOptionsBegin(PETSC_COMM_WORLD, "", "DMDA stencil matrix test options", "DMDA");
+  PetscCall(PetscOptionsInt("-dim", "Dimension", NULL, dim, &dim, NULL));
+  PetscCall(PetscOptionsInt("-M", "Number of points in each direction", NULL, M, &M, NULL));
+  PetscCall(PetscOptionsInt("-sw", "Stencil width", NULL, sw, &sw, NULL));
+  PetscCall(PetscOptionsBool("-box", "Use a box stencil instead of a star stencil", NULL, box, &box, NULL));
+  PetscCall(PetscOptionsBool("-variable", "Use coefficients varying from point to point", NULL, user.variable, &user.variable, NULL));
+  PetscCall(PetscOptionsBool("-periodic", "Use periodic boundaries", NULL, user.periodic, &user.periodic, NULL));
+  PetscCall(PetscOptionsInt("-bench", "Number of products timed", NULL, user.bench, &user.bench, NULL));
+  PetscOptionsEnd();
+
+  bt = user.periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+  if (dim == 1) PetscCall(DMDACreate1d(PETSC_COMM_WORLD, bt, M, 1, sw, NULL, &da));
+  else if (dim == 2) PetscCall(DMDACreate2d(PETSC_COMM_WORLD, bt, bt, box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR, M, M, PETSC_DECIDE, PETSC_DECIDE, 1, sw, NULL, NULL, &da));
+  else PetscCall(DMDACreate3d(PETSC_COMM_WORLD, bt, bt, bt, box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR, M, M, M, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, 1, sw, NULL, NULL, NULL, &da));
+  PetscCall(DMSetFromOptions(da));
+  PetscCall(DMSetUp(da));
+  PetscCall(CreateMatrices(da, &A, &B, &user));
+  PetscCall(MatViewFromOptions(A, NULL, "-A_view"));
+
+  PetscCall(DMCreateGlobalVector(da, &x));
+  PetscCall(VecDuplicate(x, &b));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rand));
+  PetscCall(VecSetRandom(x, rand));
+  PetscCall(VecSetRandom(b, rand));
+  PetscCall(Test(A, B, x, b, &user));
+  /* the shifts and scalings of the MATSHELL are included in the diagonal and the sweeps */
+  PetscCall(MatScale(A, 2.0));
+  PetscCall(MatScale(B, 2.0));
+  PetscCall(MatShift(A, 1.5));
+  PetscCall(MatShift(B, 1.5));
+  PetscCall(Test(A, B, x, b, &user));
+  PetscCall(Solve(A, B, b));
+  if (user.bench) PetscCall(Bench(A, B, x, &user));
+
+  PetscCall(PetscRandomDestroy(&rand));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&b));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(DMDestroy(&da));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    args: -ksp_type gmres -pc_type sor
+    output_file: output/ex54_1.out
+
+    test:
+      suffix: 1
+      args: -dim 1 -M 20 -variable
+
+    test:
+      suffix: 1_par
+      nsize: 2
+      args: -dim 1 -M 20 -variable -sw 2
+
+    test:
+      suffix: 2
+      args: -dim 2
+
+    test:
+      suffix: 2_box
+      nsize: 4
+      args: -dim 2 -box -variable
+
+    test:
+      suffix: 2_star
+      nsize: 3
+      args: -dim 2 -sw 2 -variable -mat_da_stencil_pipeline {{0 1}}
+
+    test:
+      suffix: 3
+      nsize: 2
+      args: -dim 3 -M 7 -sw 2 -variable
+
+    test:
+      suffix: 3_box
+      args: -dim 3 -M 7 -box -variable -mat_da_stencil_tile 2
+
+  test:
+    suffix: periodic
+    nsize: 2
+    args: -dim 2 -box -variable -periodic -ksp_type gmres -pc_type jacobi -A_view
+
+TEST*/
@@ -9,6 +9,9 @@ static PetscErrorCode KSPReset_Chebyshev(KSP ksp)
 
   PetscFunctionBegin;
   if (cheb->kspest) PetscCall(KSPReset(cheb->kspest));
+  PetscCall(VecDestroy(&cheb->dinv));
+  cheb->dinvid    = 0;
+  cheb->dinvstate = -1;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -135,6 +138,15 @@ static PetscErrorCode KSPChebyshevGetKind_Chebyshev(KSP ksp, KSPChebyshevKind *k
   *kind = cheb->chebykind;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+static PetscErrorCode KSPChebyshevSetFused_Chebyshev(KSP ksp, PetscBool fused)
+{
+  KSP_Chebyshev *cheb = (KSP_Chebyshev *)ksp->data;
+
+  PetscFunctionBegin;
+  cheb->fused = fused;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 /*@
   KSPChebyshevSetEigenvalues - Sets estimates for the extreme eigenvalues of the preconditioned problem.
 
@@ -327,6 +339,43 @@ PetscErrorCode KSPChebyshevGetKind(KSP ksp, KSPChebyshevKind *kind)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  KSPChebyshevSetFused - use, for the first-kind Chebyshev iteration preconditioned by `PCJACOBI`, a single pass over the
+  matrix for the computation of the residual, the application of the inverse diagonal and the update of the iterate
+
+  Logically Collective
+
+  Input Parameters:
++ ksp   - Linear solver context
+- fused - `PETSC_TRUE` to fuse the steps of the iteration
+
+  Options Database Key:
+. -ksp_chebyshev_fused <bool> - fuse the steps of the iteration
+
+  Level: advanced
+
+  Notes:
+  The fused iteration reads the matrix, the right-hand side and the two previous iterates once per iteration, instead of
+  going through a `MatMult()` followed by three vector operations. It is mostly useful for `KSPCHEBYSHEV` as a multigrid
+  smoother, for example with `-mg_levels_ksp_chebyshev_fused`, where the smoother is memory bandwidth bound.
+
+  It is used only if the matrix is `MATSEQAIJ`, `MATMPIAIJ`, `MATSEQBAIJ` or `MATMPIBAIJ`, the preconditioner is
+  `PCJACOBI` (of any `PCJacobiType`, including the l1 variant `PC_JACOBI_ROWL1`), the `KSPNormType` is `KSP_NORM_NONE`
+  and the kind is `KSP_CHEBYSHEV_FIRST`, and no monitor (`KSPMonitorSet()`) or convergence test other than `KSPConvergedSkip()` and
+  `KSPConvergedDefault()` (`KSPSetConvergenceTest()`) is set; otherwise the unfused iteration is used. The iterates are the same in exact
+  arithmetic.
+
+.seealso: [](ch_ksp), `KSPCHEBYSHEV`, `KSPChebyshevSetKind()`, `PCJACOBI`, `PCJacobiSetType()`, `PCMG`
+@*/
+PetscErrorCode KSPChebyshevSetFused(KSP ksp, PetscBool fused)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ksp, fused, 2);
+  PetscTryMethod(ksp, "KSPChebyshevSetFused_C", (KSP, PetscBool), (ksp, fused));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode KSPChebyshevEstEigGetKSP_Chebyshev(KSP ksp, KSP *kspest)
 {
   KSP_Chebyshev *cheb = (KSP_Chebyshev *)ksp->data;
@@ -371,6 +420,7 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(KSP ksp, PetscOptionItems *Pet
 
   cheb->chebykind = KSP_CHEBYSHEV_FIRST; /* Default to 1st-kind Chebyshev polynomial */
   PetscCall(PetscOptionsEnum("-ksp_chebyshev_kind", "Type of Chebyshev polynomial", "KSPChebyshevKind", KSPChebyshevKinds, (PetscEnum)cheb->chebykind, (PetscEnum *)&cheb->chebykind, NULL));
+  PetscCall(PetscOptionsBool("-ksp_chebyshev_fused", "Fuse the residual, Jacobi and update steps of the first-kind iteration", "KSPChebyshevSetFused", cheb->fused, &cheb->fused, NULL));
 
   /* We need to estimate eigenvalues; need to set this here so that KSPSetFromOptions() is called on the estimator */
   if ((cheb->emin == 0. || cheb->emax == 0.) && !cheb->kspest) PetscCall(KSPChebyshevEstEigSet(ksp, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE));
@@ -383,14 +433,110 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(KSP ksp, PetscOptionItems *Pet
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+typedef PetscErrorCode (*MatResidualJacobiUpdateFn)(Mat, Vec, PetscScalar, PetscScalar, PetscScalar, Vec, Vec, Vec, Vec);
+
+/*
+   Returns the kernel computing y = alpha w + beta x + gamma D (b - A x) in one pass over A if the first-kind iteration can be
+   fused, and the inverse diagonal D applied by the Jacobi preconditioner, computed again only when the Pmat changes
+*/
+static PetscErrorCode KSPChebyshevGetFused_Private(KSP ksp, Mat Amat, Mat Pmat, MatResidualJacobiUpdateFn *f)
+{
+  KSP_Chebyshev   *cheb = (KSP_Chebyshev *)ksp->data;
+  PetscBool        flg;
+  PetscObjectId    id;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  *f = NULL;
+  if (!cheb->fused || ksp->transpose_solve || ksp->normtype != KSP_NORM_NONE) PetscFunctionReturn(PETSC_SUCCESS);
+  /* the fused iteration computes no residual, so it calls neither the monitors nor a convergence test of the user */
+  if (ksp->numbermonitors || (ksp->converged != KSPConvergedSkip && ksp->converged != KSPConvergedDefault)) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectTypeCompare((PetscObject)ksp->pc, PCJACOBI, &flg));
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+  /* derived types such as the GPU ones inherit the composed kernel, which would work on the host copy of their values */
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)Amat, &flg, MATSEQAIJ, MATMPIAIJ, MATSEQBAIJ, MATMPIBAIJ, ""));
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectQueryFunction((PetscObject)Amat, "MatResidualJacobiUpdate_C", f));
+  if (!*f) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscObjectGetId((PetscObject)Pmat, &id));
+  PetscCall(PetscObjectStateGet((PetscObject)Pmat, &state));
+  if (!cheb->dinv || id != cheb->dinvid || state != cheb->dinvstate) {
+    if (!cheb->dinv) PetscCall(VecDuplicate(ksp->vec_rhs, &cheb->dinv));
+    /* the Jacobi preconditioner is diagonal, applying it to ones gives its diagonal */
+    PetscCall(VecSet(ksp->work[2], 1.0));
+    PetscCall(KSP_PCApply(ksp, ksp->work[2], cheb->dinv));
+    cheb->dinvid    = id;
+    cheb->dinvstate = state;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSolve_Chebyshev_FirstKind_Fused(KSP ksp, Mat Amat, MatResidualJacobiUpdateFn f)
+{
+  KSP_Chebyshev *cheb = (KSP_Chebyshev *)ksp->data;
+  PetscInt       k = 1, kp1 = 2, km1 = 0, ktmp;
+  PetscScalar    alpha, omegaprod, mu, omega, Gamma, c[3], scale;
+  PetscReal      emax, emin;
+  Vec            sol_orig = ksp->vec_sol, b = ksp->vec_rhs, p[3];
+
+  PetscFunctionBegin;
+  p[km1] = sol_orig;
+  p[k]   = ksp->work[0];
+  p[kp1] = ksp->work[1];
+
+  PetscCall(KSPChebyshevGetEigenvalues_Chebyshev(ksp, &emax, &emin));
+  scale     = 2.0 / (emax + emin);
+  alpha     = 1.0 - scale * emin;
+  Gamma     = 1.0;
+  mu        = 1.0 / alpha;
+  omegaprod = 2.0 / alpha;
+  c[km1]    = 1.0;
+  c[k]      = mu;
+
+  if (ksp->max_it == 0) {
+    ksp->reason = KSP_DIVERGED_ITS; /* This for a V(0,x) cycle */
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  /* p[k] = scale D (b - A p[km1]) + p[km1] */
+  if (ksp->guess_zero) {
+    PetscCall(VecPointwiseMult(p[k], cheb->dinv, b));
+    PetscCall(VecScale(p[k], scale));
+  } else PetscCall((*f)(Amat, cheb->dinv, 0.0, 1.0, scale, b, NULL, p[km1], p[k]));
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->its = 1;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+
+  for (PetscInt i = 1; i < ksp->max_it; i++) {
+    PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+    ksp->its++;
+    PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+    c[kp1] = 2.0 * mu * c[k] - c[km1];
+    omega  = omegaprod * c[k] / c[kp1];
+
+    /* y^{k+1} = omega(y^{k} - y^{k-1} + Gamma*D*(b - A y^{k})) + y^{k-1} */
+    PetscCall((*f)(Amat, cheb->dinv, 1.0 - omega, omega, omega * Gamma * scale, b, p[km1], p[k], p[kp1]));
+
+    ktmp = km1;
+    km1  = k;
+    k    = kp1;
+    kp1  = ktmp;
+  }
+  ksp->reason = KSP_CONVERGED_ITS;
+  if (k) PetscCall(VecCopy(p[k], sol_orig));
+  PetscCall(KSPLogErrorHistory(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode KSPSolve_Chebyshev_FirstKind(KSP ksp)
 {
-  PetscInt    k, kp1, km1, ktmp, i;
-  PetscScalar alpha, omegaprod, mu, omega, Gamma, c[3], scale;
-  PetscReal   rnorm = 0.0, emax, emin;
-  Vec         sol_orig, b, p[3], r;
-  Mat         Amat, Pmat;
-  PetscBool   diagonalscale;
+  PetscInt                  k, kp1, km1, ktmp, i;
+  PetscScalar               alpha, omegaprod, mu, omega, Gamma, c[3], scale;
+  PetscReal                 rnorm = 0.0, emax, emin;
+  Vec                       sol_orig, b, p[3], r;
+  Mat                       Amat, Pmat;
+  PetscBool                 diagonalscale;
+  MatResidualJacobiUpdateFn fused;
 
   PetscFunctionBegin;
   PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
@@ -400,6 +546,11 @@ static PetscErrorCode KSPSolve_Chebyshev_FirstKind(KSP ksp)
   PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
   ksp->its = 0;
   PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+  PetscCall(KSPChebyshevGetFused_Private(ksp, Amat, Pmat, &fused));
+  if (fused) {
+    PetscCall(KSPSolve_Chebyshev_FirstKind_Fused(ksp, Amat, fused));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   /* These three point to the three active solutions, we
      rotate these three at each solution update */
   km1      = 0;
@@ -716,6 +867,7 @@ static PetscErrorCode KSPView_Chebyshev(KSP ksp, PetscViewer viewer)
     switch (cheb->chebykind) {
     case KSP_CHEBYSHEV_FIRST:
       PetscCall(PetscViewerASCIIPrintf(viewer, "  Chebyshev polynomial of first kind\n"));
+      if (cheb->fused) PetscCall(PetscViewerASCIIPrintf(viewer, "  fusing the residual, Jacobi and update steps when possible\n"));
       break;
     case KSP_CHEBYSHEV_FOURTH:
       PetscCall(PetscViewerASCIIPrintf(viewer, "  Chebyshev polynomial of fourth kind\n"));
@@ -862,12 +1014,14 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
   PetscFunctionBegin;
   PetscCall(PetscFree(cheb->betas));
   PetscCall(KSPDestroy(&cheb->kspest));
+  PetscCall(VecDestroy(&cheb->dinv));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetEigenvalues_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevEstEigSet_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevEstEigSetUseNoisy_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetKind_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevGetKind_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevEstEigGetKSP_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetFused_C", NULL));
   PetscCall(KSPDestroyDefault(ksp));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -881,7 +1035,8 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 .   -ksp_chebyshev_esteig <a,b,c,d> - estimate eigenvalues using a Krylov method, then use this
                          transform for Chebyshev eigenvalue bounds (`KSPChebyshevEstEigSet()`)
 .   -ksp_chebyshev_esteig_steps - number of estimation steps
--   -ksp_chebyshev_esteig_noisy - use a noisy random number generator to create right-hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_noisy - use a noisy random number generator to create right-hand side for eigenvalue estimator
+-   -ksp_chebyshev_fused - fuse the residual, `PCJACOBI` and update steps of the first-kind iteration (`KSPChebyshevSetFused()`)
 
    Level: beginner
 
@@ -896,7 +1051,7 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
    The user should call `KSPChebyshevSetEigenvalues()` to get eigenvalue estimates.
 
 .seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`,
-          `KSPChebyshevSetEigenvalues()`, `KSPChebyshevEstEigSet()`, `KSPChebyshevEstEigSetUseNoisy()`
+          `KSPChebyshevSetEigenvalues()`, `KSPChebyshevEstEigSet()`, `KSPChebyshevEstEigSetUseNoisy()`, `KSPChebyshevSetFused()`
           `KSPRICHARDSON`, `KSPCG`, `PCMG`
 M*/
 
@@ -916,13 +1071,14 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   chebyshevP->emin = 0.;
   chebyshevP->emax = 0.;
 
-  chebyshevP->tform[0] = 0.0;
-  chebyshevP->tform[1] = 0.1;
-  chebyshevP->tform[2] = 0;
-  chebyshevP->tform[3] = 1.1;
-  chebyshevP->eststeps = 10;
-  chebyshevP->usenoisy = PETSC_TRUE;
-  ksp->setupnewmatrix  = PETSC_TRUE;
+  chebyshevP->tform[0]  = 0.0;
+  chebyshevP->tform[1]  = 0.1;
+  chebyshevP->tform[2]  = 0;
+  chebyshevP->tform[3]  = 1.1;
+  chebyshevP->eststeps  = 10;
+  chebyshevP->usenoisy  = PETSC_TRUE;
+  chebyshevP->dinvstate = -1;
+  ksp->setupnewmatrix   = PETSC_TRUE;
 
   ksp->ops->setup          = KSPSetUp_Chebyshev;
   ksp->ops->destroy        = KSPDestroy_Chebyshev;
@@ -938,5 +1094,6 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetKind_C", KSPChebyshevSetKind_Chebyshev));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevGetKind_C", KSPChebyshevGetKind_Chebyshev));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevEstEigGetKSP_C", KSPChebyshevEstEigGetKSP_Chebyshev));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetFused_C", KSPChebyshevSetFused_Chebyshev));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
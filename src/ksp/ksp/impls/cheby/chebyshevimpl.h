@@ -21,6 +21,11 @@ typedef struct {
   /* For tracking when to update the eigenvalue estimates */
   PetscObjectId    amatid, pmatid;
   PetscObjectState amatstate, pmatstate;
+  /* For the first-kind iteration with Jacobi fused with the residual computation, see KSPChebyshevSetFused() */
+  PetscBool        fused;
+  Vec              dinv; /* inverse diagonal applied by the Jacobi preconditioner */
+  PetscObjectId    dinvid;
+  PetscObjectState dinvstate;
 } KSP_Chebyshev;
 
 /* given the polynomial order, return tabulated beta coefficients for use in opt. 4th-kind Chebyshev smoother */
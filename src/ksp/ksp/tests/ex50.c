@@ -1,4 +1,5 @@
-static char help[] = "Tests point block Jacobi and ILU for different block sizes\n\n";
+static char help[] = "Tests point block Jacobi and ILU for different block sizes\n\n\
+  -vpb_change : with PCVPBJACOBI, solve again after splitting every block into blocks of sizes 1 and bs-1\n\n";
 
 #include <petscksp.h>
 
@@ -11,11 +12,13 @@ int main(int argc, char **args)
   PetscReal   norm; /* norm of solution error */
   PetscInt    i, j, k, l, n = 27, its, bs = 2, Ii, J;
   PetscScalar v;
+  PetscBool   vpb_change = PETSC_FALSE;
 
   PetscFunctionBeginUser;
   PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
   PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
   PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-vpb_change", &vpb_change, NULL));
 
   PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
   PetscCall(MatSetSizes(A, n * bs, n * bs, PETSC_DETERMINE, PETSC_DETERMINE));
@@ -46,6 +49,14 @@ int main(int argc, char **args)
 
   PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
   PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  if (vpb_change) {
+    PetscInt *bsizes;
+
+    PetscCall(PetscMalloc1(n, &bsizes));
+    for (i = 0; i < n; i++) bsizes[i] = bs;
+    PetscCall(MatSetVariableBlockSizes(A, n, bsizes));
+    PetscCall(PetscFree(bsizes));
+  }
   PetscCall(MatCreateVecs(A, &u, &b));
   PetscCall(VecDuplicate(u, &x));
   PetscCall(VecSet(u, 1.0));
@@ -73,6 +84,21 @@ int main(int argc, char **args)
      - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
   PetscCall(KSPSolve(ksp, b, x));
+  if (vpb_change) {
+    PetscInt *bsizes;
+
+    /* new variable block sizes, the preconditioner must use the new blocks */
+    PetscCall(PetscMalloc1(2 * n, &bsizes));
+    for (i = 0; i < n; i++) {
+      bsizes[2 * i]     = 1;
+      bsizes[2 * i + 1] = bs - 1;
+    }
+    PetscCall(MatSetVariableBlockSizes(A, 2 * n, bsizes));
+    PetscCall(PetscFree(bsizes));
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(KSPSolve(ksp, b, x));
+  }
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
                       Check solution and clean up
@@ -132,4 +158,21 @@ int main(int argc, char **args)
       requires: kokkos_kernels
       args: -mat_type aijkokkos
 
+  testset:
+    args: -bs {{1 2 3 5 8 11}} -mat_type {{aij baij}} -ksp_type bcgs
+    output_file: output/ex50_1.out
+
+    test:
+      suffix: pbjacobi_batched
+      args: -pc_type pbjacobi -pc_pbjacobi_batched
+
+    test:
+      suffix: bjacobi_batched
+      args: -pc_type bjacobi -pc_bjacobi_local_blocks 9 -pc_bjacobi_batched -sub_pc_type lu -options_left 0
+
+  test:
+    suffix: vpbjacobi_batched_change
+    args: -bs 3 -vpb_change -pc_type vpbjacobi -pc_vpbjacobi_batched -ksp_view
+    filter: grep "batched dense LU"
+
 TEST*/
@@ -1,6 +1,7 @@
 static char help[] = "Solves a linear system in parallel with KSP.\n\
 Input parameters include:\n\
   -view_exact_sol   : write exact solution vector to stdout\n\
+  -error_tol <tol>  : only report whether the norm of the error is below tol\n\
   -m <mesh_x>       : number of mesh points in x-direction\n\
   -n <mesh_y>       : number of mesh points in y-direction\n\n";
 
@@ -15,6 +16,7 @@ int main(int argc, char **args)
   Mat         A;       /* linear system matrix */
   KSP         ksp;     /* linear solver context */
   PetscReal   norm;    /* norm of solution error */
+  PetscReal   errtol = 0.0;
   PetscInt    i, j, Ii, J, Istart, Iend, m = 8, n = 7, its;
   PetscBool   flg;
   PetscScalar v;
@@ -23,6 +25,7 @@ int main(int argc, char **args)
   PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
   PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
   PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-error_tol", &errtol, NULL));
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
          Compute the matrix and right-hand-side vector that define
          the linear system, Ax = b.
@@ -190,7 +193,8 @@ int main(int argc, char **args)
      print statement from all processes that share a communicator.
      An alternative is PetscFPrintf(), which prints to a file.
   */
-  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Norm of error %g iterations %" PetscInt_FMT "\n", (double)norm, its));
+  if (errtol > 0.0) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Norm of error %s %g iterations %" PetscInt_FMT "\n", norm < errtol ? "<" : ">=", (double)errtol, its));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Norm of error %g iterations %" PetscInt_FMT "\n", (double)norm, its));
 
   /*
      Free work space.  All PETSc objects should be destroyed when they
@@ -233,6 +237,40 @@ int main(int argc, char **args)
       nsize: 2
       args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: levels
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -pc_type ilu -mat_petsc_solve_levels -mat_petsc_solve_levels_reorder {{0 1}}
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: levels_2
+      nsize: 2
+      args: -ksp_monitor_short -m 6 -n 7 -ksp_gmres_cgs_refinement_type refine_always -sub_pc_factor_levels 1 -sub_pc_factor_mat_ordering_type rcm -sub_mat_petsc_solve_levels -sub_mat_petsc_solve_levels_reorder {{0 1}}
+      output_file: output/ex2_levels_2.out
+
+   test:
+      suffix: supernodal
+      args: -ksp_monitor_short -m 20 -n 20 -pc_type {{lu cholesky}} -pc_factor_mat_ordering_type {{natural nd}} -mat_petsc_supernodal -error_tol 1e-10
+
+   test:
+      suffix: supernodal_2
+      nsize: 2
+      args: -ksp_monitor_short -m 20 -n 20 -sub_pc_type {{lu cholesky}} -sub_mat_petsc_supernodal
+
+   test:
+      suffix: parilu
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -pc_type ilu -pc_factor_mat_solver_type parilu
+
+   test:
+      suffix: parilu_exact
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -pc_type ilu -pc_factor_mat_solver_type parilu -mat_parilu_sweeps 30 -mat_parilu_solve_sweeps {{0 30}}
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: parilu_2
+      nsize: 2
+      args: -ksp_monitor_short -m 10 -n 10 -ksp_gmres_cgs_refinement_type refine_always -pc_type {{bjacobi asm}separate output} -sub_pc_type ilu -sub_pc_factor_levels 1 -sub_pc_factor_mat_ordering_type rcm -sub_pc_factor_mat_solver_type parilu -sub_mat_parilu_sweeps 2
+
    test:
       suffix: 3
       args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
@@ -389,6 +427,11 @@ int main(int argc, char **args)
       nsize: 1
       args: -ksp_monitor -ksp_type gmres -pc_type bjacobi -sub_pc_type icc -ksp_pc_side symmetric -pc_bjacobi_blocks 2
 
+   test:
+      suffix: bjacobi_batched
+      nsize: 2
+      args: -ksp_monitor_short -pc_type bjacobi -pc_bjacobi_blocks 8 -sub_pc_type lu -pc_bjacobi_batched {{0 1}shared output} -options_left 0
+
    test:
       suffix: help
       requires: !openblas !blis !mkl !hpddm !complex !kokkos_kernels !amgx !ml !spai !hypre !viennacl !parms !h2opus !metis !parmetis !superlu_dist !mkl_sparse_optimize !mkl_sparse !mkl_pardiso !mkl_cpardiso !cuda !hip defined(PETSC_USE_LOG) defined(PETSC_USE_INFO) cxx
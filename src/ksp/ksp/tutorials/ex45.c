@@ -204,4 +204,14 @@ PetscErrorCode ComputeMatrix(KSP ksp, Mat jac, Mat B, void *ctx)
       nsize: 4
       args: -ksp_type fgmres -ksp_monitor_short -pc_type mg -mg_levels_ksp_type richardson -mg_levels_pc_type jacobi -pc_mg_levels 2 -da_grid_x 65 -da_grid_y 65 -da_grid_z 65 -mg_coarse_pc_type telescope -mg_coarse_pc_telescope_reduction_factor 2 -mg_coarse_telescope_pc_type mg -mg_coarse_telescope_pc_mg_galerkin pmat -mg_coarse_telescope_pc_mg_levels 3 -mg_coarse_telescope_mg_levels_ksp_type richardson -mg_coarse_telescope_mg_levels_pc_type jacobi -mg_levels_ksp_type richardson -mg_coarse_telescope_mg_levels_ksp_type richardson -ksp_rtol 1.0e-4
 
+   test:
+      suffix: additive_concurrent
+      nsize: 4
+      args: -da_grid_x 9 -da_grid_y 9 -da_grid_z 9 -da_refine 2 -pc_type mg -pc_mg_levels 3 -pc_mg_type additive -ksp_type fgmres -mg_levels_ksp_type richardson -mg_levels_pc_type jacobi -mg_levels_ksp_max_it 3 -ksp_monitor_short -pc_mg_additive_concurrent {{0 1}shared output}
+
+   test:
+      suffix: additive_concurrent_transpose
+      nsize: 4
+      args: -da_grid_x 9 -da_grid_y 9 -da_grid_z 9 -da_refine 2 -pc_type mg -pc_mg_levels 3 -pc_mg_type additive -ksp_type bicg -ksp_max_it 6 -pc_mg_distinct_smoothup -mg_levels_ksp_type richardson -mg_levels_pc_type jacobi -mg_levels_ksp_max_it 3 -mg_levels_up_ksp_type richardson -mg_levels_up_pc_type jacobi -mg_levels_up_ksp_max_it 2 -ksp_monitor_short -pc_mg_additive_concurrent {{0 1}shared output}
+
 TEST*/
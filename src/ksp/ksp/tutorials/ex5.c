@@ -388,6 +388,15 @@ int main(int argc, char **args)
       args: -pc_type asm -mat_type baij
       output_file: output/ex5_asm.out
 
+   test:
+      suffix: refactor_cache
+      args: -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -pc_type ilu -pc_factor_mat_ordering_type rcm -mat_petsc_refactor_cache
+
+   test:
+      suffix: refactor_cache_2
+      nsize: 2
+      args: -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -sub_mat_petsc_refactor_cache
+
    test:
       suffix: redundant_0
       args: -m 1000 -pc_type redundant -pc_redundant_number 1 -redundant_ksp_type gmres -redundant_pc_type jacobi
@@ -1,20 +1,67 @@
 static char help[] = "Creates a matrix from quadrilateral finite elements in 2D, Laplacian \n\
   -ne <size>       : problem size in number of elements (eg, -ne 31 gives 32^2 grid)\n\
-  -alpha <v>      : scaling of material coefficient in embedded circle\n\n";
+  -alpha <v>      : scaling of material coefficient in embedded circle\n\
+  -steps <n>       : number of solves, the coefficient in the circle is multiplied by -alpha_factor <f> between them\n\n";
 
 #include <petscksp.h>
 
+/* assembles the stiffness matrices with the coefficient soft_alpha in the embedded circle */
+static PetscErrorCode AssembleStiffness(Mat Amat, Mat Pmat, PetscInt ne, PetscReal soft_alpha, PetscScalar DD1[4][4], PetscScalar DD2[4][4])
+{
+  PetscInt    Istart, Iend, Ii, i, j;
+  PetscReal   x, y, h = 1. / ne;
+  PetscScalar DD[4][4];
+
+  PetscFunctionBeginUser;
+  PetscCall(MatGetOwnershipRange(Amat, &Istart, &Iend));
+  for (Ii = Istart; Ii < Iend; Ii++) {
+    j = Ii / (ne + 1);
+    i = Ii % (ne + 1);
+    x = h * (Ii % (ne + 1));
+    y = h * (Ii / (ne + 1));
+    if (i < ne && j < ne) {
+      PetscInt jj, ii, idx[4];
+      /* radius */
+      PetscReal radius = PetscSqrtReal((x - .5 + h / 2) * (x - .5 + h / 2) + (y - .5 + h / 2) * (y - .5 + h / 2));
+      PetscReal alpha  = 1.0;
+      idx[0]           = Ii;
+      idx[1]           = Ii + 1;
+      idx[2]           = Ii + (ne + 1) + 1;
+      idx[3]           = Ii + (ne + 1);
+      if (radius < 0.25) alpha = soft_alpha;
+      for (ii = 0; ii < 4; ii++) {
+        for (jj = 0; jj < 4; jj++) DD[ii][jj] = alpha * DD1[ii][jj];
+      }
+      PetscCall(MatSetValues(Pmat, 4, idx, 4, idx, (const PetscScalar *)DD, ADD_VALUES));
+      if (j > 0) {
+        PetscCall(MatSetValues(Amat, 4, idx, 4, idx, (const PetscScalar *)DD, ADD_VALUES));
+      } else {
+        /* a BC */
+        for (ii = 0; ii < 4; ii++) {
+          for (jj = 0; jj < 4; jj++) DD[ii][jj] = alpha * DD2[ii][jj];
+        }
+        PetscCall(MatSetValues(Amat, 4, idx, 4, idx, (const PetscScalar *)DD, ADD_VALUES));
+      }
+    }
+  }
+  PetscCall(MatAssemblyBegin(Amat, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(Amat, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyBegin(Pmat, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(Pmat, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 int main(int argc, char **args)
 {
   Mat           Amat, Pmat;
-  PetscInt      i, m, M, its, Istart, Iend, j, Ii, ix, ne = 4;
-  PetscReal     x, y, h;
+  PetscInt      i, m, M, its, Istart, Iend, j, Ii, ix, ne = 4, steps = 1;
+  PetscReal     x, y, h, alpha_factor = 10.;
   Vec           xx, bb;
   KSP           ksp;
   PetscReal     soft_alpha = 1.e-3;
   MPI_Comm      comm;
   PetscMPIInt   npe, mype;
-  PetscScalar   DD[4][4], DD2[4][4];
+  PetscScalar   DD2[4][4];
   PetscLogStage stage;
 #define DIAG_S 0.0
   PetscScalar DD1[4][4] = {
@@ -33,6 +80,8 @@ int main(int argc, char **args)
   h = 1. / ne;
   /* ne*ne; number of global elements */
   PetscCall(PetscOptionsGetReal(NULL, NULL, "-alpha", &soft_alpha, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-steps", &steps, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-alpha_factor", &alpha_factor, NULL));
   M = (ne + 1) * (ne + 1); /* global number of nodes */
 
   /* create stiffness matrix (2) */
@@ -99,40 +148,13 @@ int main(int argc, char **args)
       y                  = h * (Ii / (ne + 1));
       coords[2 * ix]     = x;
       coords[2 * ix + 1] = y;
-      if (i < ne && j < ne) {
-        PetscInt jj, ii, idx[4];
-        /* radius */
-        PetscReal radius = PetscSqrtReal((x - .5 + h / 2) * (x - .5 + h / 2) + (y - .5 + h / 2) * (y - .5 + h / 2));
-        PetscReal alpha  = 1.0;
-        idx[0]           = Ii;
-        idx[1]           = Ii + 1;
-        idx[2]           = Ii + (ne + 1) + 1;
-        idx[3]           = Ii + (ne + 1);
-        if (radius < 0.25) alpha = soft_alpha;
-        for (ii = 0; ii < 4; ii++) {
-          for (jj = 0; jj < 4; jj++) DD[ii][jj] = alpha * DD1[ii][jj];
-        }
-        PetscCall(MatSetValues(Pmat, 4, idx, 4, idx, (const PetscScalar *)DD, ADD_VALUES));
-        if (j > 0) {
-          PetscCall(MatSetValues(Amat, 4, idx, 4, idx, (const PetscScalar *)DD, ADD_VALUES));
-        } else {
-          /* a BC */
-          for (ii = 0; ii < 4; ii++) {
-            for (jj = 0; jj < 4; jj++) DD[ii][jj] = alpha * DD2[ii][jj];
-          }
-          PetscCall(MatSetValues(Amat, 4, idx, 4, idx, (const PetscScalar *)DD, ADD_VALUES));
-        }
-      }
       if (j > 0) {
         PetscScalar v  = h * h;
         PetscInt    jj = Ii;
         PetscCall(VecSetValues(bb, 1, &jj, &v, INSERT_VALUES));
       }
     }
-    PetscCall(MatAssemblyBegin(Amat, MAT_FINAL_ASSEMBLY));
-    PetscCall(MatAssemblyEnd(Amat, MAT_FINAL_ASSEMBLY));
-    PetscCall(MatAssemblyBegin(Pmat, MAT_FINAL_ASSEMBLY));
-    PetscCall(MatAssemblyEnd(Pmat, MAT_FINAL_ASSEMBLY));
+    PetscCall(AssembleStiffness(Amat, Pmat, ne, soft_alpha, DD1, DD2));
     PetscCall(VecAssemblyBegin(bb));
     PetscCall(VecAssemblyEnd(bb));
 
@@ -166,6 +188,16 @@ int main(int argc, char **args)
 
   PetscCall(KSPSolve(ksp, bb, xx));
 
+  /* solve again with a coefficient that changes, as in a sequence of nonlinear or time steps */
+  for (PetscInt step = 1; step < steps; step++) {
+    soft_alpha *= alpha_factor;
+    PetscCall(MatZeroEntries(Amat));
+    PetscCall(MatZeroEntries(Pmat));
+    PetscCall(AssembleStiffness(Amat, Pmat, ne, soft_alpha, DD1, DD2));
+    PetscCall(VecSet(xx, .0));
+    PetscCall(KSPSolve(ksp, bb, xx));
+  }
+
   PetscCall(PetscLogStagePop());
 
   PetscCall(KSPGetIterationNumber(ksp, &its));
@@ -245,4 +277,24 @@ int main(int argc, char **args)
       filter: sed -e "s/Linear solve converged due to CONVERGED_RTOL iterations 8/Linear solve converged due to CONVERGED_RTOL iterations 7/g"
       suffix: hem
       args: -ne 39 -ksp_type cg -pc_type gamg -pc_gamg_type agg -ksp_rtol 1e-4 -ksp_norm_type unpreconditioned -pc_gamg_mat_coarsen_type hem -ksp_converged_reason -ksp_norm_type unpreconditioned
+
+   test:
+      requires: !single !__float128
+      nsize: 4
+      suffix: local_first
+      args: -ne 39 -ksp_type cg -pc_type gamg -pc_gamg_type agg -ksp_rtol 1e-4 -ksp_norm_type unpreconditioned -pc_gamg_mat_coarsen_type {{mis misk}} -pc_gamg_mat_coarsen_local_first -pc_gamg_mat_coarsen_max_rounds {{0 1 2}} -pc_gamg_node_eq_limit 1000 -ksp_converged_reason
+      output_file: output/ex54_local_first.out
+
+   test:
+      requires: !single !__float128
+      nsize: 4
+      suffix: update
+      args: -ne 39 -steps 5 -alpha 1.e-6 -alpha_factor 1.e3 -ksp_type cg -pc_type gamg -pc_gamg_type agg -ksp_rtol 1e-4 -ksp_norm_type unpreconditioned -pc_gamg_update_interpolation {{0 1}separate output} -ksp_converged_reason
+
+   test:
+      requires: !single !__float128 defined(PETSC_USE_INFO)
+      nsize: 4
+      suffix: rebuild
+      filter: grep -e "Linear solve" -e "Rebuild the hierarchy"
+      args: -ne 39 -steps 5 -alpha 1.e-6 -alpha_factor 1.e3 -ksp_type cg -pc_type gamg -pc_gamg_type agg -ksp_rtol 1e-4 -ksp_norm_type unpreconditioned -pc_gamg_rebuild_iteration_ratio 1.1 -ksp_converged_reason -info :pc
 TEST*/
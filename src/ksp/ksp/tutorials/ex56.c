@@ -488,6 +488,12 @@ PetscErrorCode elem_3d_elast_v_25(PetscScalar *dd)
        suffix: baij
        filter: grep -v variant
        args: -pc_type jacobi -pc_jacobi_type rowl1 -ksp_type cg -mat_type baij -ksp_view -ksp_rtol 1e-1 -two_solves false
+     test:
+       suffix: cheby_fused
+       args: -pc_type gamg -mg_levels_ksp_type chebyshev -mg_levels_ksp_max_it 2 -mg_levels_pc_type jacobi -mg_levels_pc_jacobi_type rowl1 -mg_levels_ksp_chebyshev_fused {{0 1}shared output} -ksp_monitor_short
+     test:
+       suffix: cheby_fused_baij
+       args: -mat_type baij -ksp_type chebyshev -ksp_norm_type none -ksp_max_it 30 -pc_type jacobi -ksp_chebyshev_fused {{0 1}shared output} -ksp_view_final_residual -two_solves false
 
    test:
       suffix: latebs
@@ -7,6 +7,7 @@
 #include <petscblaslapack.h>
 
 #include <petsc/private/dmswarmimpl.h>         // For the citation and check
+#include <petsc/private/petscfeimpl.h>         // For CoordinatesRealToRef()
 #include "../src/dm/impls/swarm/data_bucket.h" // For DataBucket internals
 
 typedef struct _projectConstraintsCtx {
@@ -438,21 +439,161 @@ PetscErrorCode DMCheckInterpolator(DM dmf, Mat In, Mat MC, Mat MF, PetscReal tol
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  The points are deposited in nchunks contiguous chunks, concurrently with OpenMP kernels. Each chunk but the first
+  accumulates into its own copy of the local grid, and the copies are then summed.
+*/
+static PetscErrorCode DMSwarmProjectGetNumChunks_Private(DM sw, PetscInt npoints, PetscInt *nchunks)
+{
+  PetscFunctionBegin;
+  *nchunks = 1;
+#if defined(PETSC_USE_OPENMP_KERNELS)
+  *nchunks = PetscMax(PetscNumOMPThreads, 1);
+#endif
+  PetscCall(PetscOptionsGetInt(((PetscObject)sw)->options, ((PetscObject)sw)->prefix, "-dm_swarm_project_chunks", nchunks, NULL));
+  PetscCheck(*nchunks > 0, PetscObjectComm((PetscObject)sw), PETSC_ERR_ARG_OUTOFRANGE, "Number of chunks %" PetscInt_FMT " must be positive", *nchunks);
+  *nchunks = PetscMin(*nchunks, PetscMax(npoints, 1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* adds the private grids of chunks 1 to nchunks - 1, stored one after the other in work, to the grid of the first chunk */
+static void DMSwarmProjectReduceChunks_Private(PetscInt nchunks, PetscInt n, const PetscScalar work[], PetscScalar grid[])
+{
+  PetscPragmaUseOMPKernels(parallel for schedule(static))
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt t = 1; t < nchunks; t++) grid[i] += work[(t - 1) * n + i];
+  }
+}
+
+/* adds the weights of the cell-sorted points in [kstart, kend) of the batch starting at k0 to the local grid */
+static void DMSwarmDeposit_PLEX_Kernel(PetscInt kstart, PetscInt kend, PetscInt k0, PetscInt Nc, PetscInt nF, const SwarmPoint list[], const PetscInt cellIdx[], const PetscReal T[], const PetscScalar u[], PetscScalar grid[])
+{
+  for (PetscInt k = kstart; k < kend; k++) {
+    const PetscInt   p   = list[k].point_index;
+    const PetscInt  *idx = &cellIdx[list[k].cell_index * nF];
+    const PetscReal *Tk  = &T[(k - k0) * nF * Nc];
+
+    for (PetscInt i = 0; i < nF / Nc; i++)
+      for (PetscInt c = 0; c < Nc; c++) grid[idx[i * Nc + c]] += Tk[(i * Nc + c) * Nc + c] * u[p * Nc + c];
+  }
+}
+
+/*
+  Computes rhs = M_p^T u_p for the particle mass matrix M_p of DMCreateMassMatrix() without assembling it. The points
+  are processed by cell in batches tabulated at once, and each batch is split into chunks deposited concurrently.
+*/
+static PetscErrorCode DMSwarmDeposit_PLEX_Private(DM sw, DM dm, PetscFE fe, Vec u_p, Vec rhs)
+{
+  DM_Swarm          *swarm = (DM_Swarm *)sw->data;
+  const PetscInt     bsize = 4096; /* number of points tabulated at once */
+  PetscSection       section;
+  PetscTabulation    T;
+  SwarmPoint        *list;
+  Vec                rhs_l;
+  const PetscScalar *u;
+  PetscScalar       *grid, *work = NULL;
+  PetscReal         *coor, *geom, *xi, v0ref[3] = {-1.0, -1.0, -1.0}, detJ;
+  PetscInt          *cellIdx = NULL, dim, Nc, nF = 0, cStart, cEnd, npoints, nsorted, nl, nchunks;
+
+  PetscFunctionBegin;
+  PetscCall(DMGetCoordinateDim(dm, &dim));
+  PetscCall(PetscFEGetNumComponents(fe, &Nc));
+  PetscCall(DMGetLocalSection(dm, &section));
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  PetscCall(DMSwarmGetLocalSize(sw, &npoints));
+  PetscCall(DMSwarmSortGetAccess(sw));
+  list    = swarm->sort_context->list;
+  nsorted = swarm->sort_context->pcell_offsets[cEnd]; /* the points located in a cell */
+
+  /* the local closure indices and affine geometry of the cells, constrained dofs are added to their local entry and dropped by the global assembly */
+  PetscCall(PetscMalloc1(cEnd * (dim + dim * dim), &geom));
+  for (PetscInt c = cStart; c < cEnd; c++) {
+    PetscReal *v0 = &geom[c * (dim + dim * dim)], J[9];
+    PetscInt  *idx, n;
+
+    PetscCall(DMPlexComputeCellGeometryFEM(dm, c, NULL, v0, J, v0 + dim, &detJ));
+    PetscCall(DMPlexGetClosureIndices(dm, section, section, c, PETSC_FALSE, &n, &idx, NULL, NULL));
+    if (c == cStart) {
+      nF = n;
+      PetscCall(PetscMalloc1(cEnd * nF, &cellIdx));
+    }
+    PetscCheck(n == nF, PETSC_COMM_SELF, PETSC_ERR_SUP, "Cell %" PetscInt_FMT " has %" PetscInt_FMT " closure dofs instead of %" PetscInt_FMT ", only a single cell type is supported", c, n, nF);
+    for (PetscInt i = 0; i < n; i++) cellIdx[c * nF + i] = idx[i] < 0 ? -(idx[i] + 1) : idx[i];
+    PetscCall(DMPlexRestoreClosureIndices(dm, section, section, c, PETSC_FALSE, &n, &idx, NULL, NULL));
+  }
+
+  PetscCall(DMGetLocalVector(dm, &rhs_l));
+  PetscCall(VecZeroEntries(rhs_l));
+  PetscCall(VecGetLocalSize(rhs_l, &nl));
+  PetscCall(VecGetArray(rhs_l, &grid));
+  PetscCall(VecGetArrayRead(u_p, &u));
+  PetscCall(DMSwarmGetField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(DMSwarmProjectGetNumChunks_Private(sw, PetscMin(nsorted, bsize), &nchunks));
+  if (nchunks > 1) PetscCall(PetscCalloc1((nchunks - 1) * nl, &work));
+  PetscCall(PetscCalloc1(bsize * dim, &xi));
+  PetscCall(PetscFECreateTabulation(fe, 1, PetscMin(PetscMax(nsorted, 1), bsize), xi, 0, &T));
+  for (PetscInt k0 = 0; k0 < nsorted; k0 += bsize) {
+    const PetscInt nb = PetscMin(bsize, nsorted - k0);
+
+    PetscPragmaUseOMPKernels(parallel for schedule(static))
+    for (PetscInt k = k0; k < k0 + nb; k++) {
+      const PetscReal *v0 = &geom[list[k].cell_index * (dim + dim * dim)];
+
+      CoordinatesRealToRef(dim, dim, v0ref, v0, v0 + dim, &coor[list[k].point_index * dim], &xi[(k - k0) * dim]);
+    }
+    PetscCall(PetscFEComputeTabulation(fe, nb, xi, 0, T));
+    PetscPragmaUseOMPKernels(parallel for schedule(static, 1))
+    for (PetscInt t = 0; t < nchunks; t++) DMSwarmDeposit_PLEX_Kernel(k0 + (PetscInt)((PetscInt64)t * nb / nchunks), k0 + (PetscInt)((PetscInt64)(t + 1) * nb / nchunks), k0, Nc, nF, list, cellIdx, T->T[0], u, t ? work + (t - 1) * nl : grid);
+  }
+  if (nchunks > 1) DMSwarmProjectReduceChunks_Private(nchunks, nl, work, grid);
+  PetscCall(PetscInfo(sw, "Deposited %" PetscInt_FMT " of %" PetscInt_FMT " points in %" PetscInt_FMT " chunks\n", nsorted, npoints, nchunks));
+  PetscCall(PetscTabulationDestroy(&T));
+  PetscCall(PetscFree(xi));
+  PetscCall(PetscFree(work));
+  PetscCall(DMSwarmRestoreField(sw, DMSwarmPICField_coor, NULL, NULL, (void **)&coor));
+  PetscCall(VecRestoreArrayRead(u_p, &u));
+  PetscCall(VecRestoreArray(rhs_l, &grid));
+  PetscCall(VecZeroEntries(rhs));
+  PetscCall(DMLocalToGlobalBegin(dm, rhs_l, ADD_VALUES, rhs));
+  PetscCall(DMLocalToGlobalEnd(dm, rhs_l, ADD_VALUES, rhs));
+  PetscCall(DMRestoreLocalVector(dm, &rhs_l));
+  PetscCall(PetscFree(cellIdx));
+  PetscCall(PetscFree(geom));
+  PetscCall(DMSwarmSortRestoreAccess(sw));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 // Project particles to field
 //   M_f u_f = M_p u_p
 //   u_f = M^{-1}_f M_p u_p
 static PetscErrorCode DMSwarmProjectField_Conservative_PLEX(DM sw, DM dm, Vec u_p, Vec u_f)
 {
-  KSP         ksp;
-  Mat         M_f, M_p; // TODO Should cache these
-  Vec         rhs;
-  const char *prefix;
+  DM           celldm;
+  KSP          ksp;
+  Mat          M_f; // TODO Should cache this
+  Vec          rhs;
+  PetscDS      ds;
+  PetscObject  obj;
+  PetscClassId id;
+  const char  *prefix;
 
   PetscFunctionBegin;
   PetscCall(DMCreateMassMatrix(dm, dm, &M_f));
-  PetscCall(DMCreateMassMatrix(sw, dm, &M_p));
   PetscCall(DMGetGlobalVector(dm, &rhs));
-  PetscCall(MatMultTranspose(M_p, u_p, rhs));
+  PetscCall(DMGetDS(dm, &ds));
+  PetscCall(PetscDSGetDiscretization(ds, 0, &obj));
+  PetscCall(PetscObjectGetClassId(obj, &id));
+  PetscCall(DMSwarmGetCellDM(sw, &celldm));
+  /* the cells of the points are those of the cell DM, so dm must share its mesh, as its clones and subDMs do */
+  if (id == PETSCFE_CLASSID && dm->data == celldm->data) {
+    PetscCall(DMSwarmDeposit_PLEX_Private(sw, dm, (PetscFE)obj, u_p, rhs));
+  } else {
+    Mat M_p;
+
+    PetscCall(DMCreateMassMatrix(sw, dm, &M_p));
+    PetscCall(MatMultTranspose(M_p, u_p, rhs));
+    PetscCall(MatDestroy(&M_p));
+  }
 
   PetscCall(KSPCreate(PetscObjectComm((PetscObject)sw), &ksp));
   PetscCall(PetscObjectGetOptionsPrefix((PetscObject)sw, &prefix));
@@ -466,7 +607,6 @@ static PetscErrorCode DMSwarmProjectField_Conservative_PLEX(DM sw, DM dm, Vec u_
   PetscCall(DMRestoreGlobalVector(dm, &rhs));
   PetscCall(KSPDestroy(&ksp));
   PetscCall(MatDestroy(&M_f));
-  PetscCall(MatDestroy(&M_p));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -537,16 +677,40 @@ static PetscErrorCode DMSwarmProjectFields_Plex_Internal(DM sw, DM dm, PetscInt
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* adds N_k(x_p) phi_p and N_k(x_p) of the points in [pstart, pend) to the vertices k of their Q1 element */
+static void DMSwarmProjectField_ApproxQ1_DA_2D_Kernel(PetscInt pstart, PetscInt pend, PetscInt npe, const PetscInt element_list[], const PetscScalar coor[], const PetscInt cellid[], const PetscReal coor_p[], const PetscReal swarm_field[], PetscScalar field[], PetscScalar denom[])
+{
+  for (PetscInt p = pstart; p < pend; p++) {
+    const PetscInt    *element = &element_list[npe * cellid[p]];
+    const PetscScalar *x0      = &coor[2 * element[0]];
+    const PetscScalar *x2      = &coor[2 * element[2]];
+    PetscScalar        xi_p[2], Ni[4];
+
+    /* compute local coordinates: (xp-x0)/dx = (xip+1)/2 */
+    xi_p[0] = 2.0 * (coor_p[2 * p] - x0[0]) / (x2[0] - x0[0]) - 1.0;
+    xi_p[1] = 2.0 * (coor_p[2 * p + 1] - x0[1]) / (x2[1] - x0[1]) - 1.0;
+
+    /* evaluate basis functions */
+    Ni[0] = 0.25 * (1.0 - xi_p[0]) * (1.0 - xi_p[1]);
+    Ni[1] = 0.25 * (1.0 + xi_p[0]) * (1.0 - xi_p[1]);
+    Ni[2] = 0.25 * (1.0 + xi_p[0]) * (1.0 + xi_p[1]);
+    Ni[3] = 0.25 * (1.0 - xi_p[0]) * (1.0 + xi_p[1]);
+
+    for (PetscInt k = 0; k < npe; k++) {
+      field[element[k]] += Ni[k] * swarm_field[p];
+      denom[element[k]] += Ni[k];
+    }
+  }
+}
+
 static PetscErrorCode DMSwarmProjectField_ApproxQ1_DA_2D(DM swarm, PetscReal *swarm_field, DM dm, Vec v_field)
 {
   Vec                v_field_l, denom_l, coor_l, denom;
-  PetscScalar       *_field_l, *_denom_l;
-  PetscInt           k, p, e, npoints, nel, npe;
+  PetscScalar       *_field_l, *_denom_l, *wfield = NULL, *wdenom = NULL;
+  PetscInt           npoints, nel, npe, nl, nchunks;
   PetscInt          *mpfield_cell;
   PetscReal         *mpfield_coor;
   const PetscInt    *element_list;
-  const PetscInt    *element;
-  PetscScalar        xi_p[2], Ni[4];
   const PetscScalar *_coor;
 
   PetscFunctionBegin;
@@ -559,6 +723,7 @@ static PetscErrorCode DMSwarmProjectField_ApproxQ1_DA_2D(DM swarm, PetscReal *sw
   PetscCall(VecZeroEntries(denom));
   PetscCall(VecZeroEntries(denom_l));
 
+  PetscCall(VecGetLocalSize(v_field_l, &nl));
   PetscCall(VecGetArray(v_field_l, &_field_l));
   PetscCall(VecGetArray(denom_l, &_denom_l));
 
@@ -570,37 +735,20 @@ static PetscErrorCode DMSwarmProjectField_ApproxQ1_DA_2D(DM swarm, PetscReal *sw
   PetscCall(DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void **)&mpfield_coor));
   PetscCall(DMSwarmGetField(swarm, DMSwarmPICField_cellid, NULL, NULL, (void **)&mpfield_cell));
 
-  for (p = 0; p < npoints; p++) {
-    PetscReal         *coor_p;
-    const PetscScalar *x0;
-    const PetscScalar *x2;
-    PetscScalar        dx[2];
-
-    e       = mpfield_cell[p];
-    coor_p  = &mpfield_coor[2 * p];
-    element = &element_list[npe * e];
-
-    /* compute local coordinates: (xp-x0)/dx = (xip+1)/2 */
-    x0 = &_coor[2 * element[0]];
-    x2 = &_coor[2 * element[2]];
-
-    dx[0] = x2[0] - x0[0];
-    dx[1] = x2[1] - x0[1];
-
-    xi_p[0] = 2.0 * (coor_p[0] - x0[0]) / dx[0] - 1.0;
-    xi_p[1] = 2.0 * (coor_p[1] - x0[1]) / dx[1] - 1.0;
-
-    /* evaluate basis functions */
-    Ni[0] = 0.25 * (1.0 - xi_p[0]) * (1.0 - xi_p[1]);
-    Ni[1] = 0.25 * (1.0 + xi_p[0]) * (1.0 - xi_p[1]);
-    Ni[2] = 0.25 * (1.0 + xi_p[0]) * (1.0 + xi_p[1]);
-    Ni[3] = 0.25 * (1.0 - xi_p[0]) * (1.0 + xi_p[1]);
+  PetscCall(DMSwarmProjectGetNumChunks_Private(swarm, npoints, &nchunks));
+  if (nchunks > 1) PetscCall(PetscCalloc2((nchunks - 1) * nl, &wfield, (nchunks - 1) * nl, &wdenom));
+  PetscPragmaUseOMPKernels(parallel for schedule(static, 1))
+  for (PetscInt t = 0; t < nchunks; t++) {
+    PetscScalar *field = t ? wfield + (t - 1) * nl : _field_l, *den = t ? wdenom + (t - 1) * nl : _denom_l;
 
-    for (k = 0; k < npe; k++) {
-      _field_l[element[k]] += Ni[k] * swarm_field[p];
-      _denom_l[element[k]] += Ni[k];
-    }
+    DMSwarmProjectField_ApproxQ1_DA_2D_Kernel((PetscInt)((PetscInt64)t * npoints / nchunks), (PetscInt)((PetscInt64)(t + 1) * npoints / nchunks), npe, element_list, _coor, mpfield_cell, mpfield_coor, swarm_field, field, den);
+  }
+  if (nchunks > 1) {
+    DMSwarmProjectReduceChunks_Private(nchunks, nl, wfield, _field_l);
+    DMSwarmProjectReduceChunks_Private(nchunks, nl, wdenom, _denom_l);
+    PetscCall(PetscFree2(wfield, wdenom));
   }
+  PetscCall(PetscInfo(swarm, "Deposited %" PetscInt_FMT " points in %" PetscInt_FMT " chunks\n", npoints, nchunks));
 
   PetscCall(DMSwarmRestoreField(swarm, DMSwarmPICField_cellid, NULL, NULL, (void **)&mpfield_cell));
   PetscCall(DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void **)&mpfield_coor));
@@ -663,6 +811,9 @@ static PetscErrorCode DMSwarmProjectFields_DA_Internal(DM swarm, DM celldm, Pets
 . fields     - an array of `Vec`'s of length nfields
 - mode       - if `SCATTER_FORWARD` then map particles to the continuum, and if `SCATTER_REVERSE` map the continuum to particles
 
+  Options Database Key:
+. -dm_swarm_project_chunks <n> - number of chunks of particles deposited concurrently, defaults to the number of OpenMP threads
+
   Level: beginner
 
   Notes:
@@ -680,6 +831,11 @@ static PetscErrorCode DMSwarmProjectFields_DA_Internal(DM swarm, DM celldm, Pets
 
   For the `DMPLEX` case, there is only a single vector, so the field layout in the `DMPLEX` must match the requested fields from the `DMSwarm`.
 
+  When mapping particles to the continuum, the particles are split into chunks deposited concurrently with OpenMP kernels, each
+  chunk into its own copy of the local grid, and the copies are summed afterwards. This is race free without coloring the cells,
+  and the result only depends on the number of chunks through the order of the floating point sums. For the `DMPLEX` case with a
+  `PetscFE` discretization on the cell `DM`, the right-hand side $M_p^T \phi_p$ is deposited without assembling the particle mass matrix.
+
   For averaging projection, nly swarm fields registered with data type of `PETSC_REAL` can be projected onto the cell `DM`, and only swarm fields of block size = 1 can currently be projected.
 
 .seealso: [](ch_dmbase), `DMSWARM`, `DMSwarmSetType()`, `DMSwarmSetCellDM()`, `DMSwarmType`
@@ -7,6 +7,7 @@
 static PetscErrorCode PCSetUp_BJacobi_Singleblock(PC, Mat, Mat);
 static PetscErrorCode PCSetUp_BJacobi_Multiblock(PC, Mat, Mat);
 static PetscErrorCode PCSetUp_BJacobi_Multiproc(PC);
+static PetscErrorCode PCSetUp_BJacobi_Batched(PC, Mat);
 
 static PetscErrorCode PCSetUp_BJacobi(PC pc)
 {
@@ -121,6 +122,17 @@ static PetscErrorCode PCSetUp_BJacobi(PC pc)
     } else pmat = mat;
   }
 
+  if (jac->batched) {
+    PetscInt max_len = 0;
+
+    for (i = 0; i < jac->n_local; i++) max_len = PetscMax(max_len, jac->l_lens[i]);
+    if (max_len <= PC_BATCH_MAX_BS) {
+      PetscCall(PCSetUp_BJacobi_Batched(pc, pmat));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    PetscCall(PetscInfo(pc, "Local blocks of size %" PetscInt_FMT " too large for the batched dense LU, using a KSP per block instead\n", max_len));
+  }
+
   /*
      Setup code depends on the number of blocks
   */
@@ -161,6 +173,7 @@ static PetscErrorCode PCSetFromOptions_BJacobi(PC pc, PetscOptionItems *PetscOpt
   if (flg) PetscCall(PCBJacobiSetTotalBlocks(pc, blocks, NULL));
   PetscCall(PetscOptionsInt("-pc_bjacobi_local_blocks", "Local number of blocks", "PCBJacobiSetLocalBlocks", jac->n_local, &blocks, &flg));
   if (flg) PetscCall(PCBJacobiSetLocalBlocks(pc, blocks, NULL));
+  PetscCall(PetscOptionsBool("-pc_bjacobi_batched", "Factor and solve small local blocks together with a batched dense LU", "PCBJACOBI", jac->batched, &jac->batched, NULL));
   if (jac->ksp) {
     /* The sub-KSP has already been set up (e.g., PCSetUp_BJacobi_Singleblock), but KSPSetFromOptions was not called
      * unless we had already been called. */
@@ -189,6 +202,10 @@ static PetscErrorCode PCView_BJacobi(PC pc, PetscViewer viewer)
   if (iascii) {
     if (pc->useAmat) PetscCall(PetscViewerASCIIPrintf(viewer, "  using Amat local matrix, number of blocks = %" PetscInt_FMT "\n", jac->n));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  number of blocks = %" PetscInt_FMT "\n", jac->n));
+    if (jac->batched && jac->data && !jac->ksp) {
+      PetscCall(PCBatchLUView(((PC_BJacobi_Batched *)jac->data)->blu, viewer));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
     PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)pc), &rank));
     PetscCall(PetscViewerGetFormat(viewer, &format));
     if (format != PETSC_VIEWER_ASCII_INFO_DETAIL) {
@@ -262,6 +279,7 @@ static PetscErrorCode PCBJacobiGetSubKSP_BJacobi(PC pc, PetscInt *n_local, Petsc
 
   PetscFunctionBegin;
   PetscCheck(pc->setupcalled, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_WRONGSTATE, "Must call KSPSetUp() or PCSetUp() first");
+  PetscCheck(jac->ksp || !jac->batched, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "There are no sub-KSP with -pc_bjacobi_batched");
 
   if (n_local) *n_local = jac->n_local;
   if (first_local) *first_local = jac->first_local;
@@ -480,7 +498,8 @@ PetscErrorCode PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt *
 
    Options Database Keys:
 +  -pc_use_amat - use Amat to apply block of operator in inner Krylov method
--  -pc_bjacobi_blocks <n> - use n total blocks
+.  -pc_bjacobi_blocks <n> - use n total blocks
+-  -pc_bjacobi_batched <false> - factor the local blocks together with a batched dense LU instead of using a `KSP` per block
 
    Notes:
     See `PCJACOBI` for diagonal Jacobi, `PCVPBJACOBI` for variable point block, and `PCPBJACOBI` for fixed size point block
@@ -500,6 +519,10 @@ PetscErrorCode PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt *
 
      When multiple processes share a single block, each block encompasses exactly all the unknowns owned its set of processes.
 
+     With `-pc_bjacobi_batched`, when all the local blocks have at most 32 rows, they are extracted densely and solved exactly with
+     the batched dense LU of `PCVPBJACOBI`, which interleaves the blocks of the same size so that the factorizations and solves
+     vectorize across them, instead of going through a `KSP` and `PC` per block. There are then no sub-`KSP` and the -sub_ options are ignored.
+
    Level: beginner
 
 .seealso: [](ch_ksp), `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `PCType`,
@@ -1117,6 +1140,77 @@ static PetscErrorCode PCSetUp_BJacobi_Multiblock(PC pc, Mat mat, Mat pmat)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+      These are for many small blocks per process factored together with the batched dense LU
+*/
+static PetscErrorCode PCReset_BJacobi_Batched(PC pc)
+{
+  PC_BJacobi         *jac  = (PC_BJacobi *)pc->data;
+  PC_BJacobi_Batched *bjac = (PC_BJacobi_Batched *)jac->data;
+
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUDestroy(&bjac->blu));
+  PetscCall(PetscFree(jac->l_lens));
+  PetscCall(PetscFree(jac->g_lens));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCDestroy_BJacobi_Batched(PC pc)
+{
+  PC_BJacobi *jac = (PC_BJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(PCReset_BJacobi_Batched(pc));
+  PetscCall(PetscFree(jac->data));
+  PetscCall(PCDestroy_BJacobi(pc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApply_BJacobi_Batched(PC pc, Vec x, Vec y)
+{
+  PC_BJacobi         *jac  = (PC_BJacobi *)pc->data;
+  PC_BJacobi_Batched *bjac = (PC_BJacobi_Batched *)jac->data;
+
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUSolve(bjac->blu, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplyTranspose_BJacobi_Batched(PC pc, Vec x, Vec y)
+{
+  PC_BJacobi         *jac  = (PC_BJacobi *)pc->data;
+  PC_BJacobi_Batched *bjac = (PC_BJacobi_Batched *)jac->data;
+
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUSolveTranspose(bjac->blu, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetUp_BJacobi_Batched(PC pc, Mat pmat)
+{
+  PC_BJacobi         *jac = (PC_BJacobi *)pc->data;
+  PC_BJacobi_Batched *bjac;
+  PetscBool           zeropivot;
+
+  PetscFunctionBegin;
+  if (!jac->data) {
+    pc->ops->reset          = PCReset_BJacobi_Batched;
+    pc->ops->destroy        = PCDestroy_BJacobi_Batched;
+    pc->ops->apply          = PCApply_BJacobi_Batched;
+    pc->ops->matapply       = NULL;
+    pc->ops->applytranspose = PCApplyTranspose_BJacobi_Batched;
+
+    PetscCall(PetscNew(&bjac));
+    jac->data = (void *)bjac;
+  }
+  bjac = (PC_BJacobi_Batched *)jac->data;
+  if (!bjac->blu) PetscCall(PCBatchLUCreate(jac->n_local, jac->l_lens, &bjac->blu));
+  /* pmat only holds the local rows and columns here */
+  PetscCall(PCBatchLUFactor(bjac->blu, pmat, pc->erroriffailure, &zeropivot));
+  if (zeropivot) pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
       These are for a single block with multiple processes
 */
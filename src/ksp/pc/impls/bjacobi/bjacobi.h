@@ -3,6 +3,7 @@
     Private data for block Jacobi and block Gauss-Seidel preconditioner.
 */
 #include <petsc/private/pcimpl.h>
+#include <../src/ksp/pc/impls/pbjacobi/pbbatch.h>
 
 /*
        This data is general for all implementations
@@ -17,6 +18,7 @@ typedef struct {
   PetscInt    *l_lens;         /* lens of each block */
   PetscInt    *g_lens;
   PetscSubcomm psubcomm; /* for multiple processors per block */
+  PetscBool    batched;  /* factor and solve small local blocks with the batched dense LU instead of a KSP per block */
 } PC_BJacobi;
 
 /*
@@ -36,6 +38,11 @@ typedef struct {
   Vec x, y;
 } PC_BJacobi_Singleblock;
 
+/*  This is for many small blocks per processor factored together */
+typedef struct {
+  PCBatchLU blu;
+} PC_BJacobi_Batched;
+
 /*  This is for multiple processors per block */
 typedef struct {
   PC           pc;         /* preconditioner used on each subcommunicator */
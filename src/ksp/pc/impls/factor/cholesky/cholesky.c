@@ -275,6 +275,10 @@ PetscErrorCode PCFactorSetReuseOrdering(PC pc, PetscBool flag)
    not need a Krylov method (i.e. you can use -ksp_type preonly, or
    `KSPSetType`(ksp,`KSPPREONLY`) for the Krylov method
 
+   For `MATSEQAIJ` matrices factored with `MATSOLVERPETSC`, the option `-mat_petsc_supernodal` (with the factor prefix) selects a
+   supernodal factorization that factors and updates dense panels of columns with the same nonzero structure with BLAS3 kernels. It is
+   only available for real scalars, requires a positive definite matrix and does not apply shifts.
+
 .seealso: [](ch_ksp), `PCCreate()`, `PCSetType()`, `PCType`, `PC`,
           `PCILU`, `PCLU`, `PCICC`, `PCFactorSetReuseOrdering()`, `PCFactorSetReuseFill()`, `PCFactorGetMatrix()`,
           `PCFactorSetFill()`, `PCFactorSetShiftType()`, `PCFactorSetShiftAmount()`
@@ -120,6 +120,10 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
     /* must update the pc record of the matrix state or the PC will attempt to run PCSetUp() yet again */
     PetscCall(PetscObjectStateGet((PetscObject)pc->pmat, &pc->matstate));
   } else {
+    PetscBool      symbolic = PETSC_FALSE;
+    PetscLogDouble t0, t1, t2;
+
+    PetscCall(PetscTime(&t0));
     if (!pc->setupcalled) {
       /* first time in so compute reordering and symbolic factorization */
       PetscBool canuseordering;
@@ -132,6 +136,7 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
         /*  Remove zeros along diagonal?     */
         if (ilu->nonzerosalongdiagonal) PetscCall(MatReorderForNonzeroDiagonal(pc->pmat, ilu->nonzerosalongdiagonaltol, ilu->row, ilu->col));
       }
+      symbolic = PETSC_TRUE;
       PetscCall(MatILUFactorSymbolic(((PC_Factor *)ilu)->fact, pc->pmat, ilu->row, ilu->col, &((PC_Factor *)ilu)->info));
       PetscCall(MatGetInfo(((PC_Factor *)ilu)->fact, MAT_LOCAL, &info));
       ilu->hdr.actualfill = info.fill_ratio_needed;
@@ -152,6 +157,7 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
           if (ilu->nonzerosalongdiagonal) PetscCall(MatReorderForNonzeroDiagonal(pc->pmat, ilu->nonzerosalongdiagonaltol, ilu->row, ilu->col));
         }
       }
+      symbolic = PETSC_TRUE;
       PetscCall(MatILUFactorSymbolic(((PC_Factor *)ilu)->fact, pc->pmat, ilu->row, ilu->col, &((PC_Factor *)ilu)->info));
       PetscCall(MatGetInfo(((PC_Factor *)ilu)->fact, MAT_LOCAL, &info));
       ilu->hdr.actualfill = info.fill_ratio_needed;
@@ -162,7 +168,11 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
       PetscFunctionReturn(PETSC_SUCCESS);
     }
 
+    PetscCall(PetscTime(&t1));
     PetscCall(MatLUFactorNumeric(((PC_Factor *)ilu)->fact, pc->pmat, &((PC_Factor *)ilu)->info));
+    PetscCall(PetscTime(&t2));
+    if (symbolic) PetscCall(PetscInfo(pc, "Ordering and symbolic factorization %g s, numeric factorization %g s\n", t1 - t0, t2 - t1));
+    else PetscCall(PetscInfo(pc, "Reused the symbolic factorization, numeric factorization %g s\n", t2 - t1));
     PetscCall(MatFactorGetError(((PC_Factor *)ilu)->fact, &err));
     if (err) { /* FactorNumeric() fails */
       pc->failedreason = (PCFailedReason)err;
@@ -260,6 +270,16 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc, Vec x, Vec y)
 
    For `MATSEQBAIJ` matrices this implements a point block ILU
 
+   For `MATSEQAIJ` matrices the option `-mat_petsc_solve_levels` applies the triangular solves by level sets, the rows of a level
+   are independent and are eliminated concurrently when PETSc is configured with `--with-openmp-kernels`. The option
+   `-mat_petsc_solve_levels_reorder` additionally stores a copy of the factors in level order so the rows of a level are contiguous in memory.
+   These options are prefixed with the options prefix of the factored matrix, see `MatGetFactor()`
+
+   When the matrix is refactored with the same nonzero pattern, as in Newton's method or implicit time stepping, the option
+   `-mat_petsc_refactor_cache` (`MATSEQAIJ` only, also prefixed) keeps maps from the nonzeros of the matrix and from the elimination
+   updates to their positions in the factor, so later numeric factorizations need no index lookups. Run with `-info :pc` to see the time of
+   the symbolic and numeric factorizations in each `PCSetUp()`
+
    The "symmetric" application of this preconditioner is not actually symmetric since L is not transpose(U)
    even when the matrix is not symmetric since the U stores the diagonals of the factorization.
 
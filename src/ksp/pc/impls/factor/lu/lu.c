@@ -72,8 +72,11 @@ static PetscErrorCode PCSetUp_LU(PC pc)
     }
     ((PC_Factor *)dir)->fact = pc->pmat;
   } else {
-    MatInfo info;
+    MatInfo        info;
+    PetscBool      symbolic = PETSC_FALSE;
+    PetscLogDouble t0, t1, t2;
 
+    PetscCall(PetscTime(&t0));
     if (!pc->setupcalled) {
       PetscBool canuseordering;
 
@@ -84,6 +87,7 @@ static PetscErrorCode PCSetUp_LU(PC pc)
         PetscCall(MatGetOrdering(pc->pmat, ((PC_Factor *)dir)->ordering, &dir->row, &dir->col));
         if (dir->nonzerosalongdiagonal) PetscCall(MatReorderForNonzeroDiagonal(pc->pmat, dir->nonzerosalongdiagonaltol, dir->row, dir->col));
       }
+      symbolic = PETSC_TRUE;
       PetscCall(MatLUFactorSymbolic(((PC_Factor *)dir)->fact, pc->pmat, dir->row, dir->col, &((PC_Factor *)dir)->info));
       PetscCall(MatGetInfo(((PC_Factor *)dir)->fact, MAT_LOCAL, &info));
       dir->hdr.actualfill = info.fill_ratio_needed;
@@ -102,6 +106,7 @@ static PetscErrorCode PCSetUp_LU(PC pc)
           if (dir->nonzerosalongdiagonal) PetscCall(MatReorderForNonzeroDiagonal(pc->pmat, dir->nonzerosalongdiagonaltol, dir->row, dir->col));
         }
       }
+      symbolic = PETSC_TRUE;
       PetscCall(MatLUFactorSymbolic(((PC_Factor *)dir)->fact, pc->pmat, dir->row, dir->col, &((PC_Factor *)dir)->info));
       PetscCall(MatGetInfo(((PC_Factor *)dir)->fact, MAT_LOCAL, &info));
       dir->hdr.actualfill = info.fill_ratio_needed;
@@ -118,7 +123,11 @@ static PetscErrorCode PCSetUp_LU(PC pc)
       PetscFunctionReturn(PETSC_SUCCESS);
     }
 
+    PetscCall(PetscTime(&t1));
     PetscCall(MatLUFactorNumeric(((PC_Factor *)dir)->fact, pc->pmat, &((PC_Factor *)dir)->info));
+    PetscCall(PetscTime(&t2));
+    if (symbolic) PetscCall(PetscInfo(pc, "Ordering and symbolic factorization %g s, numeric factorization %g s\n", t1 - t0, t2 - t1));
+    else PetscCall(PetscInfo(pc, "Reused the symbolic factorization, numeric factorization %g s\n", t2 - t1));
     PetscCall(MatFactorGetError(((PC_Factor *)dir)->fact, &err));
     if (err) { /* FactorNumeric() fails */
       pc->failedreason = (PCFailedReason)err;
@@ -226,6 +235,15 @@ static PetscErrorCode PCApplyTranspose_LU(PC pc, Vec x, Vec y)
    not need a Krylov method (i.e. you can use -ksp_type preonly, or
    `KSPSetType`(ksp,`KSPPREONLY`) for the Krylov method
 
+   For `MATSEQAIJ` matrices factored with `MATSOLVERPETSC`, the option `-mat_petsc_supernodal` (with the factor prefix, for example
+   `-sub_mat_petsc_supernodal` for the blocks of `PCBJACOBI`) selects a supernodal factorization: the columns of the factors with the
+   same nonzero structure are grouped into dense panels that are factored and updated with BLAS3 kernels. It uses the symmetrized
+   nonzero structure, requires the same row and column orderings, pivots only within the diagonal blocks of the supernodes and does not
+   apply shifts.
+
+   The option `-mat_petsc_refactor_cache` keeps maps of the numeric factorization of `MATSEQAIJ` matrices to speed up the refactorizations
+   with the same nonzero pattern, see `PCILU`
+
 .seealso: [](ch_ksp), `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `MatSolverType`, `MatGetFactor()`, `PCQR`, `PCSVD`,
           `PCILU`, `PCCHOLESKY`, `PCICC`, `PCFactorSetReuseOrdering()`, `PCFactorSetReuseFill()`, `PCFactorGetMatrix()`,
           `PCFactorSetFill()`, `PCFactorSetUseInPlace()`, `PCFactorSetMatOrderingType()`, `PCFactorSetColumnPivot()`,
@@ -815,17 +815,21 @@ static const NState REMOVED  = -3;
 */
 static PetscErrorCode fixAggregatesWithSquare(PC pc, Mat Gmat_2, Mat Gmat_1, PetscCoarsenData *aggs_2)
 {
-  PetscBool      isMPI;
-  Mat_SeqAIJ    *matA_1, *matB_1 = NULL;
-  MPI_Comm       comm;
-  PetscInt       lid, *ii, *idx, ix, Iend, my0, kk, n, j;
-  Mat_MPIAIJ    *mpimat_2 = NULL, *mpimat_1 = NULL;
-  const PetscInt nloc = Gmat_2->rmap->n;
-  PetscScalar   *cpcol_1_state, *cpcol_2_state, *cpcol_2_par_orig, *lid_parent_gid;
-  PetscInt      *lid_cprowID_1 = NULL;
-  NState        *lid_state;
-  Vec            ghost_par_orig2;
-  PetscMPIInt    rank;
+  PC_MG          *mg          = (PC_MG *)pc->data;
+  PC_GAMG        *pc_gamg     = (PC_GAMG *)mg->innerctx;
+  PC_GAMG_AGG    *pc_gamg_agg = (PC_GAMG_AGG *)pc_gamg->subctx;
+  const PetscBool bounded     = (PetscBool)(pc_gamg_agg->crs->max_rounds > 0); /* selected vertices on different processes may be neighbors */
+  PetscBool       isMPI;
+  Mat_SeqAIJ     *matA_1, *matB_1 = NULL;
+  MPI_Comm        comm;
+  PetscInt        lid, *ii, *idx, ix, Iend, my0, kk, n, j;
+  Mat_MPIAIJ     *mpimat_2 = NULL, *mpimat_1 = NULL;
+  const PetscInt  nloc = Gmat_2->rmap->n;
+  PetscScalar    *cpcol_1_state, *cpcol_2_state, *cpcol_2_par_orig, *lid_parent_gid;
+  PetscInt       *lid_cprowID_1 = NULL;
+  NState         *lid_state;
+  Vec             ghost_par_orig2;
+  PetscMPIInt     rank;
 
   PetscFunctionBegin;
   PetscCall(PetscObjectGetComm((PetscObject)Gmat_2, &comm));
@@ -943,6 +947,7 @@ static PetscErrorCode fixAggregatesWithSquare(PC pc, Mat Gmat_2, Mat Gmat_1, Pet
         NState   statej = lid_state[lidj];
 
         if (statej == DELETED && (sgid = (PetscInt)PetscRealPart(lid_parent_gid[lidj])) != lid + my0) { /* steal local */
+          if (bounded && sgid != -1 && (sgid < my0 || sgid >= Iend)) continue;                         /* already stolen by a neighbor ghost */
           lid_parent_gid[lidj] = (PetscScalar)(lid + my0);                                              /* send this if sgid is not local */
           if (sgid >= my0 && sgid < Iend) {                                                             /* I'm stealing this local from a local sgid */
             PetscInt      hav = 0, slid = sgid - my0, gidj = lidj + my0;
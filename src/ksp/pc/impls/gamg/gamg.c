@@ -3,6 +3,7 @@
  */
 #include <../src/ksp/pc/impls/gamg/gamg.h>            /*I "petscpc.h" I*/
 #include <../src/ksp/ksp/impls/cheby/chebyshevimpl.h> /*I "petscksp.h" I*/
+#include <petsctime.h>
 
 #if defined(PETSC_HAVE_CUDA)
   #include <cuda_runtime.h>
@@ -23,12 +24,23 @@ static PetscLogStage gamg_stages[PETSC_MG_MAXLEVELS];
 static PetscFunctionList GAMGList = NULL;
 static PetscBool         PCGAMGPackageInitialized;
 
+static PetscErrorCode PCGAMGDestroyTentative_Private(PC_GAMG *pc_gamg)
+{
+  PetscFunctionBegin;
+  for (PetscInt level = 0; level < PETSC_MG_MAXLEVELS; level++) {
+    PetscCall(MatDestroy(&pc_gamg->prol_tentative[level]));
+    PetscCall(ISDestroy(&pc_gamg->prol_cols[level]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PCReset_GAMG(PC pc)
 {
   PC_MG   *mg      = (PC_MG *)pc->data;
   PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
 
   PetscFunctionBegin;
+  PetscCall(PCGAMGDestroyTentative_Private(pc_gamg));
   PetscCall(PetscFree(pc_gamg->data));
   pc_gamg->data_sz = 0;
   PetscCall(PetscFree(pc_gamg->orig_data));
@@ -134,6 +146,26 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc, Mat Amat_fine, PetscInt cr_b
     new_size = (PetscMPIInt)((float)ncrs_eq_glob / (float)pc_gamg->min_eq_proc + 0.5); /* hardwire min. number of eq/proc */
     if (!new_size) new_size = 1;                                                       /* not likely, possible? */
     else if (new_size >= nactive) new_size = nactive;                                  /* no change, rare */
+    if (pc_gamg->node_eq_limit > 0 && new_size > 1 && ncrs_eq_glob < (PetscInt)nactive * pc_gamg->node_eq_limit) {
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+      /* agglomerate early: keep at most one active process per compute node */
+      PetscShmComm pshmcomm;
+      MPI_Comm     loccomm;
+      PetscMPIInt  locrank, leader, nnodes;
+
+      PetscCall(PetscShmCommGet(comm, &pshmcomm));
+      PetscCall(PetscShmCommGetMpiShmComm(pshmcomm, &loccomm));
+      PetscCallMPI(MPI_Comm_rank(loccomm, &locrank));
+      leader = !locrank;
+      PetscCall(MPIU_Allreduce(&leader, &nnodes, 1, MPI_INT, MPI_SUM, comm));
+      if (nnodes < new_size) {
+        PetscCall(PetscInfo(pc, "%s: %" PetscInt_FMT " equations on %d active processes, below the node limit: reduce to %d processes, one per node\n", ((PetscObject)pc)->prefix, ncrs_eq_glob, nactive, nnodes));
+        new_size = nnodes;
+      }
+#else
+      PetscCall(PetscInfo(pc, "%s: node equation limit ignored, shared memory communicators need MPI-3\n", ((PetscObject)pc)->prefix));
+#endif
+    }
     PetscCall(PetscInfo(pc, "%s: Coarse grid reduction from %d to %d active processes\n", ((PetscObject)pc)->prefix, nactive, new_size));
   }
   if (new_size == nactive) {
@@ -527,6 +559,86 @@ PetscErrorCode PCGAMGSquareGraph_GAMG(PC a_pc, Mat Gmat1, Mat *Gmat2)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Whether the local rows of A and B have the same column indices, so that the values of one can be copied into the other */
+static PetscErrorCode PCGAMGSameNonzeroPattern_Private(Mat A, Mat B, PetscBool *same)
+{
+  PetscInt  Istart, Iend, nwork = 0, *work = NULL;
+  PetscBool flg = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (PetscInt r = Istart; r < Iend && flg; r++) {
+    const PetscInt *cols;
+    PetscInt        ncols, n;
+
+    /* only one row of a parallel matrix may be gotten at a time */
+    PetscCall(MatGetRow(A, r, &ncols, &cols, NULL));
+    n = ncols;
+    if (n > nwork) {
+      PetscCall(PetscFree(work));
+      nwork = 2 * n;
+      PetscCall(PetscMalloc1(nwork, &work));
+    }
+    PetscCall(PetscArraycpy(work, cols, n));
+    PetscCall(MatRestoreRow(A, r, &ncols, &cols, NULL));
+    PetscCall(MatGetRow(B, r, &ncols, &cols, NULL));
+    if (ncols != n) flg = PETSC_FALSE;
+    else PetscCall(PetscArraycmp(work, cols, n, &flg));
+    PetscCall(MatRestoreRow(B, r, &ncols, &cols, NULL));
+  }
+  PetscCall(PetscFree(work));
+  PetscCall(MPIU_Allreduce(&flg, same, 1, MPIU_BOOL, MPI_LAND, PetscObjectComm((PetscObject)A)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   PCGAMGUpdateProlongator_Private - Smooths again the stored tentative prolongator of a level with the new matrix of the level
+
+   Input Parameters:
++  pc      - the preconditioner context
+.  level   - the level, 0 being the finest
+.  mglevel - the same level in the numbering of PCMG, 0 being the coarsest
+-  A       - the new matrix of the level
+
+   The values of the prolongator are replaced if its nonzero pattern is unchanged. Otherwise the new prolongator replaces it, so that
+   the Galerkin product of the coarser level is created again.
+*/
+static PetscErrorCode PCGAMGUpdateProlongator_Private(PC pc, PetscInt level, PetscInt mglevel, Mat A)
+{
+  PC_MG    *mg      = (PC_MG *)pc->data;
+  PC_GAMG  *pc_gamg = (PC_GAMG *)mg->innerctx;
+  Mat       P       = mg->levels[mglevel]->interpolate, Pnew;
+  PetscBool same;
+
+  PetscFunctionBegin;
+  pc_gamg->current_level = level;
+  PetscCall(MatDuplicate(pc_gamg->prol_tentative[level], MAT_COPY_VALUES, &Pnew));
+  PetscCall(pc_gamg->ops->optprolongator(pc, A, &Pnew));
+  if (pc_gamg->prol_cols[level]) { /* same process reduction as in the setup */
+    IS       findices;
+    PetscInt Istart, Iend, f_bs;
+    Mat      Psub;
+
+    PetscCall(MatGetOwnershipRange(Pnew, &Istart, &Iend));
+    PetscCall(MatGetBlockSize(A, &f_bs));
+    PetscCall(ISCreateStride(PetscObjectComm((PetscObject)Pnew), Iend - Istart, Istart, 1, &findices));
+    PetscCall(ISSetBlockSize(findices, f_bs));
+    PetscCall(MatCreateSubMatrix(Pnew, findices, pc_gamg->prol_cols[level], MAT_INITIAL_MATRIX, &Psub));
+    PetscCall(ISDestroy(&findices));
+    PetscCall(MatDestroy(&Pnew));
+    Pnew = Psub;
+  }
+  PetscCall(PCGAMGSameNonzeroPattern_Private(Pnew, P, &same));
+  if (same) PetscCall(MatCopy(Pnew, P, SAME_NONZERO_PATTERN));
+  else {
+    PetscCall(PetscInfo(pc, "%s: Nonzero pattern of the prolongator changed on level %" PetscInt_FMT ", replace it\n", ((PetscObject)pc)->prefix, level));
+    PetscCall(PCMGSetInterpolation(pc, mglevel, Pnew));
+    PetscCall(PCMGSetRestriction(pc, mglevel, Pnew));
+  }
+  PetscCall(MatDestroy(&Pnew));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    PCSetUp_GAMG - Prepares for the use of the GAMG preconditioner
                     by setting data structures and options.
@@ -557,8 +669,10 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
   PetscCallMPI(MPI_Comm_size(comm, &size));
   PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_SETUP], 0, 0, 0, 0));
   if (pc->setupcalled) {
-    if (!pc_gamg->reuse_prol || pc->flag == DIFFERENT_NONZERO_PATTERN) {
+    if (!pc_gamg->reuse_prol || pc->flag == DIFFERENT_NONZERO_PATTERN || pc_gamg->rebuild) {
       /* reset everything */
+      if (pc_gamg->rebuild) PetscCall(PetscInfo(pc, "%s: Rebuild the hierarchy after the convergence degraded\n", ((PetscObject)pc)->prefix));
+      PetscCall(PCGAMGDestroyTentative_Private(pc_gamg));
       PetscCall(PCReset_MG(pc));
       pc->setupcalled = 0;
     } else {
@@ -573,10 +687,16 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
         PetscCall(KSPSetOperators(mglevels[pc_gamg->Nlevels - 1]->smoothd, dA, dB));
 
         for (level = pc_gamg->Nlevels - 2, gl = 0; level >= 0; level--, gl++) {
-          MatReuse reuse = MAT_INITIAL_MATRIX;
+          MatReuse       reuse = MAT_INITIAL_MATRIX;
+          PetscLogDouble t0;
 #if defined(GAMG_STAGES)
           PetscCall(PetscLogStagePush(gamg_stages[gl]));
 #endif
+          PetscCall(PetscTime(&t0));
+          if (pc_gamg->update_prol && pc_gamg->prol_tentative[gl]) {
+            PetscCall(PetscInfo(pc, "%s: Smooth the tentative prolongator again on level %" PetscInt_FMT "\n", ((PetscObject)pc)->prefix, gl));
+            PetscCall(PCGAMGUpdateProlongator_Private(pc, gl, level + 1, dB));
+          }
           /* matrix structure can change from repartitioning or process reduction but don't know if we have process reduction here. Should fix */
           PetscCall(KSPGetOperators(mglevels[level]->smoothd, NULL, &B));
           if (B->product) {
@@ -603,9 +723,17 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
               KSP_Chebyshev *cheb = (KSP_Chebyshev *)smoother->data;
               cheb->emin_provided = 0;
               cheb->emax_provided = 0;
+              /* the update of the prolongator estimated them again */
+              if (pc_gamg->update_prol && pc_gamg->prol_tentative[gl] && pc_gamg->use_sa_esteig && mg->max_eigen_DinvA[gl] > 0) {
+                cheb->emin_provided = mg->min_eigen_DinvA[gl];
+                cheb->emax_provided = mg->max_eigen_DinvA[gl];
+              }
             }
             /* we could call PetscCall(KSPChebyshevSetEigenvalues(smoother, 0, 0)); but the logic does not work properly */
           }
+          PetscCall(PetscTimeSubtract(&t0));
+          pc_gamg->setup_time[gl] = -t0;
+          PetscCall(PetscInfo(pc, "%s: Level %" PetscInt_FMT " updated in %g seconds\n", ((PetscObject)pc)->prefix, gl, (double)pc_gamg->setup_time[gl]));
           // inc
           dB = B;
 #if defined(GAMG_STAGES)
@@ -615,10 +743,15 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
       }
 
       PetscCall(PCSetUp_MG(pc));
+      pc_gamg->nupdate++;
       PetscCall(PetscLogEventEnd(petsc_gamg_setup_events[GAMG_SETUP], 0, 0, 0, 0));
       PetscFunctionReturn(PETSC_SUCCESS);
     }
   }
+  pc_gamg->nbuild++;
+  pc_gamg->nupdate = 0;
+  pc_gamg->ref_its = -1;
+  pc_gamg->rebuild = PETSC_FALSE;
 
   if (!pc_gamg->data) {
     if (pc_gamg->orig_data) {
@@ -638,7 +771,7 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
   }
 
   /* cache original data for reuse */
-  if (!pc_gamg->orig_data && (PetscBool)(!pc_gamg->reuse_prol)) {
+  if (!pc_gamg->orig_data && (!pc_gamg->reuse_prol || pc_gamg->rebuild_ratio > 0)) {
     PetscCall(PetscMalloc1(pc_gamg->data_sz, &pc_gamg->orig_data));
     for (qq = 0; qq < pc_gamg->data_sz; qq++) pc_gamg->orig_data[qq] = pc_gamg->data[qq];
     pc_gamg->orig_data_cell_rows = pc_gamg->data_cell_rows;
@@ -658,8 +791,11 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
 
   /* Get A_i and R_i */
   for (level = 0, Aarr[0] = Pmat, nactivepe = size; level < (pc_gamg->Nlevels - 1) && (level == 0 || M > pc_gamg->coarse_eq_limit); level++) {
+    PetscLogDouble t0;
+
     pc_gamg->current_level = level;
     level1                 = level + 1;
+    PetscCall(PetscTime(&t0));
 #if defined(GAMG_STAGES)
     if (!gamg_stages[level]) {
       char str[32];
@@ -740,7 +876,8 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
         PetscCall(MatGetBlockSizes(Prol11, NULL, &cr_bs)); // column size
 
         if (pc_gamg->ops->optprolongator) {
-          /* smooth */
+          /* smooth, keeping the tentative prolongator to smooth it again when the matrix changes */
+          if (pc_gamg->update_prol && pc_gamg->reuse_prol) PetscCall(MatDuplicate(Prol11, MAT_COPY_VALUES, &pc_gamg->prol_tentative[level]));
           PetscCall(pc_gamg->ops->optprolongator(pc, Aarr[level], &Prol11));
         }
 
@@ -805,15 +942,17 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
     if (level1 == pc_gamg->Nlevels - 1) is_last = PETSC_TRUE;
     if (level == PETSC_MG_MAXLEVELS - 2) is_last = PETSC_TRUE;
     PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_LEVEL], 0, 0, 0, 0));
-    PetscCall(pc_gamg->ops->createlevel(pc, Aarr[level], cr_bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last));
+    PetscCall(pc_gamg->ops->createlevel(pc, Aarr[level], cr_bs, &Parr[level1], &Aarr[level1], &nactivepe, pc_gamg->prol_tentative[level] ? &pc_gamg->prol_cols[level] : NULL, is_last));
     PetscCall(PetscLogEventEnd(petsc_gamg_setup_events[GAMG_LEVEL], 0, 0, 0, 0));
+    PetscCall(PetscTimeSubtract(&t0));
+    pc_gamg->setup_time[level] = -t0;
 
     PetscCall(MatGetSize(Aarr[level1], &M, &N)); /* M is loop test variables */
 #if defined(PETSC_USE_INFO)
     PetscCall(MatGetInfo(Aarr[level1], MAT_GLOBAL_SUM, &info));
     nnztot += info.nz_used;
 #endif
-    PetscCall(PetscInfo(pc, "%s: %d) N=%" PetscInt_FMT ", n data cols=%" PetscInt_FMT ", nnz/row (ave)=%" PetscInt_FMT ", %d active pes\n", ((PetscObject)pc)->prefix, (int)level1, M, pc_gamg->data_cell_cols, (PetscInt)(info.nz_used / (PetscReal)M), nactivepe));
+    PetscCall(PetscInfo(pc, "%s: %d) N=%" PetscInt_FMT ", n data cols=%" PetscInt_FMT ", nnz/row (ave)=%" PetscInt_FMT ", %d active pes, built in %g seconds\n", ((PetscObject)pc)->prefix, (int)level1, M, pc_gamg->data_cell_cols, (PetscInt)(info.nz_used / (PetscReal)M), nactivepe, (double)pc_gamg->setup_time[level]));
 
 #if defined(GAMG_STAGES)
     PetscCall(PetscLogStagePop());
@@ -980,12 +1119,15 @@ PetscErrorCode PCDestroy_GAMG(PC pc)
   PetscCall(PetscFree(pc_gamg->gamg_type_name));
   PetscCall(PetscFree(pc_gamg));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetProcEqLim_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetNodeEqLim_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetCoarseEqLim_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRepartition_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetEigenvalues_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseSAEstEig_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRecomputeEstEig_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseInterpolation_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUpdateInterpolation_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRebuildIterationRatio_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGASMSetUseAggs_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetParallelCoarseGridSolve_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetCpuPinCoarseGrids_C", NULL));
@@ -1044,6 +1186,54 @@ static PetscErrorCode PCGAMGSetProcEqLim_GAMG(PC pc, PetscInt n)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  PCGAMGSetNodeEqLim - Set the number of equations per active process below which `PCGAMG` keeps at most one active process
+  per compute node on the coarse grids
+
+  Logically Collective
+
+  Input Parameters:
++ pc - the preconditioner context
+- n  - the number of equations, 0 to turn this off
+
+  Options Database Key:
+. -pc_gamg_node_eq_limit <limit> - set the limit
+
+  Level: intermediate
+
+  Notes:
+  `PCGAMGSetProcEqLim()` reduces the number of active processes in proportion to the size of the coarse grid. On many processes
+  the coarse grids then still span many compute nodes, where each coarse level costs several rounds of communication
+  between nodes for very little work. Once the average number of equations per active process drops below this limit,
+  `PCGAMG` agglomerates the coarse grid early onto at most one process per compute node, the compute nodes being the
+  shared memory domains of the communicator.
+
+  The active processes are spread over the communicator with the `PCGAMG_LAYOUT_SPREAD` layout, so when the processes of a compute
+  node have consecutive ranks there is one active process on each compute node.
+
+  This has no effect on the levels for which `PCGAMGSetRankReductionFactors()` gives the reduction.
+
+.seealso: [the Users Manual section on PCGAMG](sec_amg), [the Users Manual section on PCMG](sec_mg), [](ch_ksp), `PCGAMG`, `PCGAMGSetProcEqLim()`, `PCGAMGSetRankReductionFactors()`, `PCGAMGSetCoarseGridLayoutType()`
+@*/
+PetscErrorCode PCGAMGSetNodeEqLim(PC pc, PetscInt n)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(pc, n, 2);
+  PetscTryMethod(pc, "PCGAMGSetNodeEqLim_C", (PC, PetscInt), (pc, n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCGAMGSetNodeEqLim_GAMG(PC pc, PetscInt n)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->node_eq_limit = n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   PCGAMGSetCoarseEqLim - Set maximum number of equations on the coarsest grid of `PCGAMG`
 
@@ -1277,6 +1467,94 @@ static PetscErrorCode PCGAMGSetReuseInterpolation_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  PCGAMGSetUpdateInterpolation - Smooth the prolongators again with the new matrices when rebuilding a `PCGAMG` algebraic multigrid
+  preconditioner whose interpolation is reused
+
+  Collective
+
+  Input Parameters:
++ pc  - the preconditioner context
+- flg - `PETSC_TRUE` or `PETSC_FALSE`, default is `PETSC_FALSE`
+
+  Options Database Key:
+. -pc_gamg_update_interpolation <true,false> - smooth the tentative prolongators again
+
+  Level: intermediate
+
+  Notes:
+  The aggregates and the tentative prolongators of the first setup are kept; when the matrix values change, but not its nonzero
+  pattern, only the smoothing of the prolongators (with new eigenvalue estimates if they are computed) and the numerical part of the
+  Galerkin products are done again. This is cheaper than a new setup and keeps the convergence rate closer to it than
+  `PCGAMGSetReuseInterpolation()` alone, for example across nonlinear iterations or time steps. If the nonzero pattern of a smoothed
+  prolongator changes, it replaces the previous one and the Galerkin product of the coarser level is created again.
+
+  It has no effect if the interpolation is not reused or if the `PCGAMGType` does not smooth its prolongators.
+
+.seealso: [the Users Manual section on PCGAMG](sec_amg), [the Users Manual section on PCMG](sec_mg), [](ch_ksp), `PCGAMG`, `PCGAMGSetReuseInterpolation()`,
+          `PCGAMGSetRebuildIterationRatio()`
+@*/
+PetscErrorCode PCGAMGSetUpdateInterpolation(PC pc, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(pc, flg, 2);
+  PetscTryMethod(pc, "PCGAMGSetUpdateInterpolation_C", (PC, PetscBool), (pc, flg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCGAMGSetUpdateInterpolation_GAMG(PC pc, PetscBool flg)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->update_prol = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCGAMGSetRebuildIterationRatio - Rebuild a `PCGAMG` algebraic multigrid preconditioner whose interpolation is reused once the
+  convergence degrades
+
+  Collective
+
+  Input Parameters:
++ pc    - the preconditioner context
+- ratio - rebuild when a solve needs more than `ratio` times the iterations of the first solve after the last build, 0 to never rebuild (the default)
+
+  Options Database Key:
+. -pc_gamg_rebuild_iteration_ratio <ratio> - the ratio of iterations
+
+  Level: intermediate
+
+  Notes:
+  The number of iterations is monitored only for the `KSP` that uses `pc`. A solve that fails to converge also triggers a rebuild.
+  The rebuild happens in the next setup of the preconditioner, with the aggregates computed for the new matrix.
+
+.seealso: [the Users Manual section on PCGAMG](sec_amg), [the Users Manual section on PCMG](sec_mg), [](ch_ksp), `PCGAMG`, `PCGAMGSetReuseInterpolation()`,
+          `PCGAMGSetUpdateInterpolation()`
+@*/
+PetscErrorCode PCGAMGSetRebuildIterationRatio(PC pc, PetscReal ratio)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(pc, ratio, 2);
+  PetscTryMethod(pc, "PCGAMGSetRebuildIterationRatio_C", (PC, PetscReal), (pc, ratio));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCGAMGSetRebuildIterationRatio_GAMG(PC pc, PetscReal ratio)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+
+  PetscFunctionBegin;
+  PetscCheck(ratio == 0 || ratio >= 1, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Ratio of iterations %g must be 0 or at least 1", (double)ratio);
+  pc_gamg->rebuild_ratio = ratio;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   PCGAMGASMSetUseAggs - Have the `PCGAMG` smoother on each level use `PCASM` where the aggregates defined by the coarsening process are
   the subdomains for the additive Schwarz preconditioner used as the smoother
@@ -1698,12 +1976,36 @@ static PetscErrorCode PCGAMGSetType_GAMG(PC pc, PCGAMGType type)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   PCPostSolve_GAMG - Monitors the iterations of the solves with a reused hierarchy and flags it for a rebuild when they degrade
+*/
+static PetscErrorCode PCPostSolve_GAMG(PC pc, KSP ksp, Vec b, Vec x)
+{
+  PC_MG             *mg      = (PC_MG *)pc->data;
+  PC_GAMG           *pc_gamg = (PC_GAMG *)mg->innerctx;
+  PetscInt           its;
+  KSPConvergedReason reason;
+
+  PetscFunctionBegin;
+  if (pc_gamg->rebuild_ratio <= 0 || !pc_gamg->reuse_prol) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(KSPGetIterationNumber(ksp, &its));
+  PetscCall(KSPGetConvergedReason(ksp, &reason));
+  if (pc_gamg->ref_its < 0) {
+    if (reason > 0) pc_gamg->ref_its = its;
+  } else if (reason < 0 || its > pc_gamg->rebuild_ratio * PetscMax(pc_gamg->ref_its, 1)) {
+    PetscCall(PetscInfo(pc, "%s: %" PetscInt_FMT " iterations (%s) after %" PetscInt_FMT " in the first solve: rebuild the hierarchy in the next setup\n", ((PetscObject)pc)->prefix, its, KSPConvergedReasons[reason], pc_gamg->ref_its));
+    pc_gamg->rebuild = PETSC_TRUE;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PCView_GAMG(PC pc, PetscViewer viewer)
 {
-  PC_MG         *mg       = (PC_MG *)pc->data;
-  PC_MG_Levels **mglevels = mg->levels;
-  PC_GAMG       *pc_gamg  = (PC_GAMG *)mg->innerctx;
-  PetscReal      gc, oc;
+  PC_MG            *mg       = (PC_MG *)pc->data;
+  PC_MG_Levels    **mglevels = mg->levels;
+  PC_GAMG          *pc_gamg  = (PC_GAMG *)mg->innerctx;
+  PetscReal         gc, oc;
+  PetscViewerFormat format;
 
   PetscFunctionBegin;
   PetscCall(PetscViewerASCIIPrintf(viewer, "    GAMG specific options\n"));
@@ -1724,6 +2026,9 @@ static PetscErrorCode PCView_GAMG(PC pc, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPopTab(viewer));
   }
   if (pc_gamg->use_parallel_coarse_grid_solver) PetscCall(PetscViewerASCIIPrintf(viewer, "      Using parallel coarse grid solver (all coarse grid equations not put on one process)\n"));
+  if (pc_gamg->node_eq_limit > 0) PetscCall(PetscViewerASCIIPrintf(viewer, "      One active process per compute node below %" PetscInt_FMT " equations per process\n", pc_gamg->node_eq_limit));
+  if (pc_gamg->update_prol) PetscCall(PetscViewerASCIIPrintf(viewer, "      Smoothing the tentative prolongators again when the matrix values change\n"));
+  if (pc_gamg->rebuild_ratio > 0) PetscCall(PetscViewerASCIIPrintf(viewer, "      Rebuilding the hierarchy when a solve needs more than %g times the iterations of the first solve\n", (double)pc_gamg->rebuild_ratio));
   if (pc_gamg->injection_index_size) {
     PetscCall(PetscViewerASCIIPrintf(viewer, "      Using injection restriction/prolongation on first level, dofs:"));
     for (int i = 0; i < pc_gamg->injection_index_size; i++) PetscCall(PetscViewerASCIIPrintf(viewer, " %d", (int)pc_gamg->injection_index[i]));
@@ -1757,6 +2062,13 @@ static PetscErrorCode PCView_GAMG(PC pc, PetscViewer viewer)
     PetscCall(MPIU_Allreduce(MPI_IN_PLACE, rd, 3, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)pc)));
     PetscCall(PetscViewerASCIIPrintf(viewer, "     %12" PetscInt_FMT " %12" PetscInt_FMT "   %12" PetscInt_FMT "     %12" PetscInt_FMT "\n", N, (PetscInt)rd[0], (PetscInt)PetscCeilReal(rd[1] / N), (PetscInt)PetscCeilReal(rd[2] / N)));
   }
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "      Hierarchy built %" PetscInt_FMT " times, updated %" PetscInt_FMT " times since the last build\n", pc_gamg->nbuild, pc_gamg->nupdate));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "      Setup time of the last build or update per level (seconds, finest first):"));
+    for (PetscInt i = 0; i < mg->nlevels - 1; i++) PetscCall(PetscViewerASCIIPrintf(viewer, " %g", (double)pc_gamg->setup_time[i]));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "\n"));
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1820,12 +2132,16 @@ static PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOption
   PetscCall(PetscOptionsBool("-pc_gamg_use_sa_esteig", "Use eigen estimate from smoothed aggregation for smoother", "PCGAMGSetUseSAEstEig", pc_gamg->use_sa_esteig, &pc_gamg->use_sa_esteig, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_recompute_esteig", "Set flag to recompute eigen estimates for Chebyshev when matrix changes", "PCGAMGSetRecomputeEstEig", pc_gamg->recompute_esteig, &pc_gamg->recompute_esteig, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_reuse_interpolation", "Reuse prolongation operator", "PCGAMGReuseInterpolation", pc_gamg->reuse_prol, &pc_gamg->reuse_prol, NULL));
+  PetscCall(PetscOptionsBool("-pc_gamg_update_interpolation", "Smooth the reused prolongators again with the new matrices", "PCGAMGSetUpdateInterpolation", pc_gamg->update_prol, &pc_gamg->update_prol, NULL));
+  PetscCall(PetscOptionsReal("-pc_gamg_rebuild_iteration_ratio", "Rebuild the hierarchy when a solve needs more than this many times the iterations of the first solve", "PCGAMGSetRebuildIterationRatio", pc_gamg->rebuild_ratio, &pc_gamg->rebuild_ratio, &flag));
+  if (flag) PetscCall(PCGAMGSetRebuildIterationRatio(pc, pc_gamg->rebuild_ratio));
   PetscCall(PetscOptionsBool("-pc_gamg_asm_use_agg", "Use aggregation aggregates for ASM smoother", "PCGAMGASMSetUseAggs", pc_gamg->use_aggs_in_asm, &pc_gamg->use_aggs_in_asm, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_parallel_coarse_grid_solver", "Use parallel coarse grid solver (otherwise put last grid on one process)", "PCGAMGSetParallelCoarseGridSolve", pc_gamg->use_parallel_coarse_grid_solver, &pc_gamg->use_parallel_coarse_grid_solver, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_cpu_pin_coarse_grids", "Pin coarse grids to the CPU", "PCGAMGSetCpuPinCoarseGrids", pc_gamg->cpu_pin_coarse_grids, &pc_gamg->cpu_pin_coarse_grids, NULL));
   PetscCall(PetscOptionsEnum("-pc_gamg_coarse_grid_layout_type", "compact: place reduced grids on processes in natural order; spread: distribute to whole machine for more memory bandwidth", "PCGAMGSetCoarseGridLayoutType", LayoutTypes,
                              (PetscEnum)pc_gamg->layout_type, (PetscEnum *)&pc_gamg->layout_type, NULL));
   PetscCall(PetscOptionsInt("-pc_gamg_process_eq_limit", "Limit (goal) on number of equations per process on coarse grids", "PCGAMGSetProcEqLim", pc_gamg->min_eq_proc, &pc_gamg->min_eq_proc, NULL));
+  PetscCall(PetscOptionsInt("-pc_gamg_node_eq_limit", "Number of equations per process on coarse grids below which to keep one active process per compute node", "PCGAMGSetNodeEqLim", pc_gamg->node_eq_limit, &pc_gamg->node_eq_limit, NULL));
   PetscCall(PetscOptionsInt("-pc_gamg_coarse_eq_limit", "Limit on number of equations for the coarse grid", "PCGAMGSetCoarseEqLim", pc_gamg->coarse_eq_limit, &pc_gamg->coarse_eq_limit, NULL));
   PetscCall(PetscOptionsInt("-pc_gamg_asm_hem_aggs", "Number of HEM matching passed in aggregates for ASM smoother", "PCGAMGASMSetHEM", pc_gamg->asm_hem_aggs, &pc_gamg->asm_hem_aggs, NULL));
   PetscCall(PetscOptionsReal("-pc_gamg_threshold_scale", "Scaling of threshold for each level not specified", "PCGAMGSetThresholdScale", pc_gamg->threshold_scale, &pc_gamg->threshold_scale, NULL));
@@ -1876,8 +2192,11 @@ static PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOption
 . -pc_gamg_asm_use_agg <bool,default=false> - use the aggregates from the coasening process to defined the subdomains on each level for the PCASM smoother
 . -pc_gamg_process_eq_limit <limit, default=50> - `PCGAMG` will reduce the number of MPI ranks used directly on the coarse grids so that there are around <limit>
                                         equations on each process that has degrees of freedom
+. -pc_gamg_node_eq_limit <limit, default=0> - below <limit> equations per active process agglomerate the coarse grids onto at most one process per compute node
 . -pc_gamg_coarse_eq_limit <limit, default=50> - Set maximum number of equations on coarsest grid to aim for.
 . -pc_gamg_reuse_interpolation <bool,default=true> - when rebuilding the algebraic multigrid preconditioner reuse the previously computed interpolations (should always be true)
+. -pc_gamg_update_interpolation <bool,default=false> - when reusing the interpolations smooth them again with the new matrices
+. -pc_gamg_rebuild_iteration_ratio <ratio,default=0> - rebuild the reused hierarchy when a solve needs more than ratio times the iterations of the first solve
 . -pc_gamg_threshold[] <thresh,default=[-1,...]> - Before aggregating the graph `PCGAMG` will remove small values from the graph on each level (< 0 does no filtering)
 - -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
 
@@ -1906,9 +2225,9 @@ static PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOption
 
 .seealso: [the Users Manual section on PCGAMG](sec_amg), [the Users Manual section on PCMG](sec_mg), [](ch_ksp), `PCCreate()`, `PCSetType()`,
           `MatSetBlockSize()`,
-          `PCMGType`, `PCSetCoordinates()`, `MatSetNearNullSpace()`, `PCGAMGSetType()`, `PCGAMGAGG`, `PCGAMGGEO`, `PCGAMGCLASSICAL`, `PCGAMGSetProcEqLim()`,
-          `PCGAMGSetCoarseEqLim()`, `PCGAMGSetRepartition()`, `PCGAMGRegister()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGASMSetUseAggs()`,
-          `PCGAMGSetParallelCoarseGridSolve()`, `PCGAMGSetNlevels()`, `PCGAMGSetThreshold()`, `PCGAMGGetType()`, `PCGAMGSetUseSAEstEig()`
+          `PCMGType`, `PCSetCoordinates()`, `MatSetNearNullSpace()`, `PCGAMGSetType()`, `PCGAMGAGG`, `PCGAMGGEO`, `PCGAMGCLASSICAL`, `PCGAMGSetProcEqLim()`, `PCGAMGSetNodeEqLim()`,
+          `PCGAMGSetCoarseEqLim()`, `PCGAMGSetRepartition()`, `PCGAMGRegister()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGSetUpdateInterpolation()`,
+          `PCGAMGSetRebuildIterationRatio()`, `PCGAMGASMSetUseAggs()`, `PCGAMGSetParallelCoarseGridSolve()`, `PCGAMGSetNlevels()`, `PCGAMGSetThreshold()`, `PCGAMGGetType()`, `PCGAMGSetUseSAEstEig()`
 M*/
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
 {
@@ -1940,15 +2259,19 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   pc->ops->setup          = PCSetUp_GAMG;
   pc->ops->reset          = PCReset_GAMG;
   pc->ops->destroy        = PCDestroy_GAMG;
+  pc->ops->postsolve      = PCPostSolve_GAMG;
   mg->view                = PCView_GAMG;
 
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetProcEqLim_C", PCGAMGSetProcEqLim_GAMG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetNodeEqLim_C", PCGAMGSetNodeEqLim_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetCoarseEqLim_C", PCGAMGSetCoarseEqLim_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRepartition_C", PCGAMGSetRepartition_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetEigenvalues_C", PCGAMGSetEigenvalues_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseSAEstEig_C", PCGAMGSetUseSAEstEig_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRecomputeEstEig_C", PCGAMGSetRecomputeEstEig_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseInterpolation_C", PCGAMGSetReuseInterpolation_GAMG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUpdateInterpolation_C", PCGAMGSetUpdateInterpolation_GAMG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRebuildIterationRatio_C", PCGAMGSetRebuildIterationRatio_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGASMSetUseAggs_C", PCGAMGASMSetUseAggs_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetParallelCoarseGridSolve_C", PCGAMGSetParallelCoarseGridSolve_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetCpuPinCoarseGrids_C", PCGAMGSetCpuPinCoarseGrids_GAMG));
@@ -1968,6 +2291,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   pc_gamg->cpu_pin_coarse_grids            = PETSC_FALSE;
   pc_gamg->layout_type                     = PCGAMG_LAYOUT_SPREAD;
   pc_gamg->min_eq_proc                     = 50;
+  pc_gamg->node_eq_limit                   = 0;
   pc_gamg->asm_hem_aggs                    = 0;
   pc_gamg->coarse_eq_limit                 = 50;
   for (int i = 0; i < PETSC_MG_MAXLEVELS; i++) pc_gamg->threshold[i] = -1;
@@ -1978,6 +2302,9 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   pc_gamg->recompute_esteig = PETSC_TRUE;
   pc_gamg->emin             = 0;
   pc_gamg->emax             = 0;
+  pc_gamg->update_prol      = PETSC_FALSE;
+  pc_gamg->rebuild_ratio    = 0;
+  pc_gamg->ref_its          = -1;
 
   pc_gamg->ops->createlevel = PCGAMGCreateLevel_GAMG;
 
@@ -199,6 +199,7 @@ PetscErrorCode PCReset_MG(PC pc)
 
   PetscFunctionBegin;
   if (mglevels) {
+    PetscCall(PCMGACycleReset_Private(pc));
     n = mglevels[0]->levels;
     for (i = 0; i < n - 1; i++) {
       PetscCall(VecDestroy(&mglevels[i + 1]->r));
@@ -527,6 +528,7 @@ PetscErrorCode PCDestroy_MG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCMGGetAdaptCR_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCMGSetAdaptCoarseSpaceType_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCMGGetAdaptCoarseSpaceType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCMGAdditiveSetConcurrent_C", NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -710,6 +712,7 @@ PetscErrorCode PCSetFromOptions_MG(PC pc, PetscOptionItems *PetscOptionsObject)
     PetscCall(PetscOptionsInt("-pc_mg_multiplicative_cycles", "Number of cycles for each preconditioner step", "PCMGMultiplicativeSetCycles", mg->cyclesperpcapply, &cycles, &flg));
     if (flg) PetscCall(PCMGMultiplicativeSetCycles(pc, cycles));
   }
+  PetscCall(PetscOptionsBool("-pc_mg_additive_concurrent", "Solve the levels concurrently on disjoint groups of processes", "PCMGAdditiveSetConcurrent", mg->concurrent, &mg->concurrent, NULL));
   flg = PETSC_FALSE;
   PetscCall(PetscOptionsBool("-pc_mg_log", "Log times for each multigrid level", "None", flg, &flg, NULL));
   if (flg) {
@@ -766,6 +769,13 @@ PetscErrorCode PCView_MG(PC pc, PetscViewer viewer)
     const char *cyclename = levels ? (mglevels[0]->cycles == PC_MG_CYCLE_V ? "v" : "w") : "unknown";
     PetscCall(PetscViewerASCIIPrintf(viewer, "  type is %s, levels=%" PetscInt_FMT " cycles=%s\n", PCMGTypes[mg->am], levels, cyclename));
     if (mg->am == PC_MG_MULTIPLICATIVE) PetscCall(PetscViewerASCIIPrintf(viewer, "    Cycles per PCApply=%" PetscInt_FMT "\n", mg->cyclesperpcapply));
+    if (mg->am == PC_MG_ADDITIVE && mg->cpsubcomm) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "    Levels solved concurrently, number of processes per level:"));
+      PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_FALSE));
+      for (i = 0; i < levels; i++) PetscCall(PetscViewerASCIIPrintf(viewer, " %d", mglevels[i]->csize));
+      PetscCall(PetscViewerASCIIPrintf(viewer, "\n"));
+      PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_TRUE));
+    } else if (mg->am == PC_MG_ADDITIVE && mg->concurrent) PetscCall(PetscViewerASCIIPrintf(viewer, "    Levels solved one after another, concurrent solves not possible\n"));
     if (mg->galerkin == PC_MG_GALERKIN_BOTH) {
       PetscCall(PetscViewerASCIIPrintf(viewer, "    Using Galerkin computed coarse grid matrices\n"));
     } else if (mg->galerkin == PC_MG_GALERKIN_PMAT) {
@@ -1201,6 +1211,7 @@ PetscErrorCode PCSetUp_MG(PC pc)
   PetscCall(KSPSetUp(mglevels[0]->smoothd));
   if (mglevels[0]->smoothd->reason) pc->failedreason = PC_SUBPC_ERROR;
   if (mglevels[0]->eventsmoothsetup) PetscCall(PetscLogEventEnd(mglevels[0]->eventsmoothsetup, 0, 0, 0, 0));
+  PetscCall(PCMGACycleSetUp_Private(pc));
 
     /*
      Dump the interpolation/restriction matrices plus the
@@ -1344,6 +1355,53 @@ PetscErrorCode PCMGSetType(PC pc, PCMGType form)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PCMGAdditiveSetConcurrent_MG(PC pc, PetscBool flg)
+{
+  PC_MG *mg = (PC_MG *)pc->data;
+
+  PetscFunctionBegin;
+  mg->concurrent = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCMGAdditiveSetConcurrent - Solves the levels of the additive multigrid cycle concurrently, each on its own group of processes
+
+  Logically Collective
+
+  Input Parameters:
++ pc  - the preconditioner context
+- flg - `PETSC_TRUE` to solve the levels concurrently
+
+  Options Database Key:
+. -pc_mg_additive_concurrent <bool> - solve the levels concurrently
+
+  Level: advanced
+
+  Notes:
+  With `PC_MG_ADDITIVE` the corrections of the levels are independent once the right-hand sides of all the levels have been
+  restricted. This option splits the processes into one group per level, with sizes proportional to the number of nonzeros
+  of the level operators, redistributes each level operator onto its group, and has each group solve its level with a copy
+  of the smoother of the level (same `KSPType`, `PCType`, tolerances and options prefix) while the other groups solve the
+  other levels. The coarse levels then no longer leave most of the processes idle, and their reductions only involve
+  the processes of their group.
+
+  It requires at least as many processes as levels and operators that can be redistributed with `MatCreateSubMatrices()`;
+  otherwise the levels are solved one after another. Preconditioners that depend on the parallel layout, such as `PCBJACOBI`,
+  give a different correction on the redistributed level. The flag may be set before or after the type; it has no effect unless
+  the `PCMGType` is `PC_MG_ADDITIVE`.
+
+.seealso: [](ch_ksp), `PCMG`, `PCMGSetType()`, `PC_MG_ADDITIVE`, `PCTELESCOPE`
+@*/
+PetscErrorCode PCMGAdditiveSetConcurrent(PC pc, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(pc, flg, 2);
+  PetscTryMethod(pc, "PCMGAdditiveSetConcurrent_C", (PC, PetscBool), (pc, flg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   PCMGGetType - Finds the form of multigrid the `PCMG` is using  multiplicative, additive, full, or the Kaskade algorithm.
 
@@ -1897,6 +1955,7 @@ PetscErrorCode PCMGGetCoarseSpaceConstructor(const char name[], PetscErrorCode (
 .  -pc_mg_distinct_smoothup                           - configure up (after interpolation) and down (before restriction) smoothers separately (with different options prefixes)
 .  -pc_mg_galerkin <both,pmat,mat,none>               - use Galerkin process to compute coarser operators, i.e. Acoarse = R A R'
 .  -pc_mg_multiplicative_cycles                        - number of cycles to use as the preconditioner (defaults to 1)
+.  -pc_mg_additive_concurrent                          - with the additive type, solve the levels concurrently on disjoint groups of processes
 .  -pc_mg_dump_matlab                                  - dumps the matrices for each level and the restriction/interpolation matrices
                                                          to a `PETSCVIEWERSOCKET` for reading from MATLAB.
 -  -pc_mg_dump_binary                                  -dumps the matrices for each level and the restriction/interpolation matrices
@@ -1928,7 +1987,8 @@ PetscErrorCode PCMGGetCoarseSpaceConstructor(const char name[], PetscErrorCode (
           `PCMGSetDistinctSmoothUp()`, `PCMGGetCoarseSolve()`, `PCMGSetResidual()`, `PCMGSetInterpolation()`,
           `PCMGSetRestriction()`, `PCMGGetSmoother()`, `PCMGGetSmootherUp()`, `PCMGGetSmootherDown()`,
           `PCMGSetCycleTypeOnLevel()`, `PCMGSetRhs()`, `PCMGSetX()`, `PCMGSetR()`,
-          `PCMGSetAdaptCR()`, `PCMGGetAdaptInterpolation()`, `PCMGSetGalerkin()`, `PCMGGetAdaptCoarseSpaceType()`, `PCMGSetAdaptCoarseSpaceType()`
+          `PCMGSetAdaptCR()`, `PCMGGetAdaptInterpolation()`, `PCMGSetGalerkin()`, `PCMGGetAdaptCoarseSpaceType()`, `PCMGSetAdaptCoarseSpaceType()`,
+          `PCMGAdditiveSetConcurrent()`
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_MG(PC pc)
@@ -1968,5 +2028,6 @@ PETSC_EXTERN PetscErrorCode PCCreate_MG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCMGGetAdaptCR_C", PCMGGetAdaptCR_MG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCMGSetAdaptCoarseSpaceType_C", PCMGSetAdaptCoarseSpaceType_MG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCMGGetAdaptCoarseSpaceType_C", PCMGGetAdaptCoarseSpaceType_MG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCMGAdditiveSetConcurrent_C", PCMGAdditiveSetConcurrent_MG));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -2,9 +2,307 @@
      Additive Multigrid V Cycle routine
 */
 #include <petsc/private/pcmgimpl.h>
+#include <petsc/private/kspimpl.h>
+
+/*
+   PCMGACycleReset_Private - Destroys the data of the concurrent additive cycle
+*/
+PetscErrorCode PCMGACycleReset_Private(PC pc)
+{
+  PC_MG         *mg       = (PC_MG *)pc->data;
+  PC_MG_Levels **mglevels = mg->levels;
+
+  PetscFunctionBegin;
+  if (!mg->cpsubcomm) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt i = 0; i < mglevels[0]->levels; i++) {
+    PetscCall(VecScatterDestroy(&mglevels[i]->cscatter));
+    PetscCall(VecDestroy(&mglevels[i]->ctmp));
+    PetscCall(MatDestroy(&mglevels[i]->cAloc));
+    PetscCall(MatDestroy(&mglevels[i]->cPloc));
+    mglevels[i]->csize = 0;
+  }
+  PetscCall(KSPDestroy(&mg->cksp));
+  PetscCall(KSPDestroy(&mg->ckspt));
+  PetscCall(MatDestroy(&mg->cA));
+  PetscCall(MatDestroy(&mg->cP));
+  PetscCall(VecDestroy(&mg->cb));
+  PetscCall(VecDestroy(&mg->cx));
+  PetscCall(PetscSubcommDestroy(&mg->cpsubcomm));
+  mg->clevel = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* rows of the level matrix on the processes solving the level, and all the columns, reusing Alocal and Ared if they exist */
+static PetscErrorCode PCMGACycleMatCreate_Private(PC pc, Mat A, IS isrow, PetscBool active, Mat *Alocal, Mat *Ared)
+{
+  PC_MG   *mg = (PC_MG *)pc->data;
+  Mat     *_Alocal;
+  IS       iscol;
+  PetscInt N, bs, m;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(A, NULL, &N));
+  PetscCall(ISCreateStride(PETSC_COMM_SELF, N, 0, 1, &iscol));
+  PetscCall(ISSetIdentity(iscol));
+  PetscCall(MatGetBlockSizes(A, NULL, &bs));
+  PetscCall(ISSetBlockSize(iscol, bs));
+  PetscCall(MatSetOption(A, MAT_SUBMAT_SINGLEIS, PETSC_TRUE));
+  if (*Alocal) PetscCall(MatCreateSubMatrices(A, 1, &isrow, &iscol, MAT_REUSE_MATRIX, &Alocal));
+  else {
+    PetscCall(MatCreateSubMatrices(A, 1, &isrow, &iscol, MAT_INITIAL_MATRIX, &_Alocal));
+    *Alocal = *_Alocal;
+    PetscCall(PetscFree(_Alocal));
+  }
+  if (active) {
+    PetscCall(MatGetSize(*Alocal, &m, NULL));
+    PetscCall(MatCreateMPIMatConcatenateSeqMat(PetscSubcommChild(mg->cpsubcomm), *Alocal, m, *Ared ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX, Ared));
+  }
+  PetscCall(ISDestroy(&iscol));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* a copy of the smoother of the level of this process on its group of processes */
+static PetscErrorCode PCMGACycleKSPCreate_Private(PC pc, KSP smooth, KSP *cksp)
+{
+  PC_MG         *mg       = (PC_MG *)pc->data;
+  PC_MG_Levels **mglevels = mg->levels;
+  PC             spc, cpc;
+  KSPType        ksptype;
+  PCType         pctype;
+  KSPNormType    normtype;
+  PetscReal      rtol, abstol, dtol;
+  PetscInt       maxits;
+  PetscBool      flg;
+  const char    *prefix;
+
+  PetscFunctionBegin;
+  PetscCall(KSPCreate(PetscSubcommChild(mg->cpsubcomm), cksp));
+  PetscCall(KSPSetNestLevel(*cksp, pc->kspnestlevel));
+  PetscCall(KSPSetErrorIfNotConverged(*cksp, pc->erroriffailure));
+  PetscCall(PetscObjectIncrementTabLevel((PetscObject)*cksp, (PetscObject)pc, mglevels[0]->levels - mg->clevel));
+  PetscCall(KSPGetType(smooth, &ksptype));
+  PetscCall(KSPSetType(*cksp, ksptype));
+  PetscCall(KSPGetTolerances(smooth, &rtol, &abstol, &dtol, &maxits));
+  PetscCall(KSPSetTolerances(*cksp, rtol, abstol, dtol, maxits));
+  PetscCall(KSPGetNormType(smooth, &normtype));
+  PetscCall(KSPSetNormType(*cksp, normtype));
+  if (normtype == KSP_NORM_NONE) PetscCall(KSPSetConvergenceTest(*cksp, KSPConvergedSkip, NULL, NULL));
+  PetscCall(KSPGetPC(smooth, &spc));
+  PetscCall(KSPGetPC(*cksp, &cpc));
+  PetscCall(PCGetType(spc, &pctype));
+  PetscCall(PetscObjectTypeCompare((PetscObject)spc, PCREDUNDANT, &flg));
+  if (flg && mglevels[mg->clevel]->csize == 1) pctype = PCLU;
+  if (pctype) PetscCall(PCSetType(cpc, pctype));
+  if (!mg->clevel) PetscCall(PCFactorSetShiftType(cpc, MAT_SHIFT_INBLOCKS));
+  PetscCall(KSPGetOptionsPrefix(smooth, &prefix));
+  PetscCall(KSPSetOptionsPrefix(*cksp, prefix));
+  PetscCall(KSPSetOperators(*cksp, mg->cA, mg->cP));
+  if (pc->setfromoptionscalled) PetscCall(KSPSetFromOptions(*cksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   PCMGACycleSetUp_Private - Sets up the concurrent additive cycle, see PCMGAdditiveSetConcurrent()
+
+   The processes are split into one group per level, with sizes proportional to the number of nonzeros of the level operators.
+   Each level operator is redistributed onto its group, whose processes solve the level with a copy of the level smoother
+   while the other groups solve the other levels.
+*/
+PetscErrorCode PCMGACycleSetUp_Private(PC pc)
+{
+  PC_MG         *mg       = (PC_MG *)pc->data;
+  PC_MG_Levels **mglevels = mg->levels;
+  PetscInt       n        = mglevels[0]->levels, nfree;
+  MPI_Comm       comm     = PetscObjectComm((PetscObject)pc);
+  PetscMPIInt    size, rank, cstart = 0, result;
+  PetscLogDouble nnz[PETSC_MG_MAXLEVELS], nnztot = 0;
+  PetscBool      rebuild = PETSC_FALSE, flg;
+
+  PetscFunctionBegin;
+  if (!mg->concurrent || mg->am != PC_MG_ADDITIVE || n == 1) {
+    PetscCall(PCMGACycleReset_Private(pc));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  if (size < n || n > PETSC_MG_MAXLEVELS) {
+    PetscCall(PetscInfo(pc, "Solving the %" PetscInt_FMT " levels one after another, there are %d processes\n", n, size));
+    PetscCall(PCMGACycleReset_Private(pc));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (PetscInt i = 0; i < n; i++) {
+    Mat      A, P;
+    MatInfo  info;
+    PetscInt M;
+
+    PetscCallMPI(MPI_Comm_compare(comm, PetscObjectComm((PetscObject)mglevels[i]->smoothd), &result));
+    PetscCall(KSPGetOperators(mglevels[i]->smoothd, &A, &P));
+    PetscCall(MatHasOperation(A, MATOP_CREATE_SUBMATRICES, &flg));
+    if (flg) PetscCall(MatHasOperation(P, MATOP_CREATE_SUBMATRICES, &flg));
+    if ((result != MPI_IDENT && result != MPI_CONGRUENT) || !flg) {
+      PetscCall(PetscInfo(pc, "Solving the levels one after another, level %" PetscInt_FMT " is not on the communicator of the PC or its operators cannot be redistributed\n", i));
+      PetscCall(PCMGACycleReset_Private(pc));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    PetscCall(MatGetInfo(P, MAT_GLOBAL_SUM, &info));
+    nnz[i] = info.nz_used;
+    nnztot += nnz[i];
+    PetscCall(MatGetSize(P, &M, NULL));
+    if (mglevels[i]->ctmp) {
+      PetscInt Mtmp;
+
+      PetscCall(VecGetSize(mglevels[i]->ctmp, &Mtmp));
+      if (Mtmp != M) rebuild = PETSC_TRUE;
+    } else rebuild = PETSC_TRUE;
+  }
+  if (rebuild) PetscCall(PCMGACycleReset_Private(pc));
+
+  if (!mg->cpsubcomm) {
+    /* one process per level, then the remaining processes in proportion to the nonzeros, the finest level gets the rest */
+    nfree = size - n;
+    for (PetscInt i = 0; i < n; i++) {
+      mglevels[i]->csize = 1 + (PetscMPIInt)(nnztot > 0 ? PetscFloorReal((PetscReal)(size - n) * nnz[i] / nnztot) : 0);
+      nfree -= mglevels[i]->csize - 1;
+    }
+    mglevels[n - 1]->csize += (PetscMPIInt)nfree;
+    /* the finest level on the first processes */
+    for (PetscInt i = n - 1; i >= 0; i--) {
+      if (rank >= cstart && rank < cstart + mglevels[i]->csize) mg->clevel = i;
+      cstart += mglevels[i]->csize;
+    }
+    PetscCall(PetscSubcommCreate(comm, &mg->cpsubcomm));
+    PetscCall(PetscSubcommSetNumber(mg->cpsubcomm, n));
+    PetscCall(PetscSubcommSetTypeGeneral(mg->cpsubcomm, (PetscMPIInt)mg->clevel, rank));
+    PetscCall(PetscInfo(pc, "Solving the %" PetscInt_FMT " levels concurrently, this process solves level %" PetscInt_FMT " with %d processes\n", n, mg->clevel, mglevels[mg->clevel]->csize));
+  }
+
+  /* redistribute the vectors and the operators of each level onto their group of processes */
+  cstart = 0;
+  for (PetscInt i = n - 1; i >= 0; i--) {
+    PetscBool active = (PetscBool)(mg->clevel == i);
+    Mat       A, P;
+    PetscInt  M, bs, st = 0, m = 0;
+    IS        isin;
+
+    PetscCall(KSPGetOperators(mglevels[i]->smoothd, &A, &P));
+    PetscCall(MatGetSize(P, &M, NULL));
+    PetscCall(MatGetBlockSize(P, &bs));
+    if (active) {
+      PetscMPIInt r = rank - cstart, s = mglevels[i]->csize;
+      PetscInt    Mb = M / bs;
+
+      m  = bs * (Mb / s + (r < Mb % s ? 1 : 0));
+      st = bs * (r * (Mb / s) + PetscMin(r, Mb % s));
+    }
+    cstart += mglevels[i]->csize;
+    PetscCall(ISCreateStride(comm, m, st, 1, &isin));
+    PetscCall(ISSetBlockSize(isin, bs));
+    if (!mglevels[i]->ctmp) {
+      Vec     x;
+      VecType vectype;
+
+      PetscCall(MatCreateVecs(P, &x, NULL));
+      PetscCall(MatGetVecType(P, &vectype));
+      PetscCall(VecCreate(comm, &mglevels[i]->ctmp));
+      PetscCall(VecSetSizes(mglevels[i]->ctmp, m, M));
+      PetscCall(VecSetBlockSize(mglevels[i]->ctmp, bs));
+      PetscCall(VecSetType(mglevels[i]->ctmp, vectype));
+      PetscCall(VecScatterCreate(x, isin, mglevels[i]->ctmp, NULL, &mglevels[i]->cscatter));
+      PetscCall(VecDestroy(&x));
+    }
+    {
+      PetscObjectState Astate, Pstate;
+
+      /* new nonzero patterns need new submatrices */
+      PetscCall(MatGetNonzeroState(A, &Astate));
+      PetscCall(MatGetNonzeroState(P, &Pstate));
+      if (mglevels[i]->cPloc && (Astate != mglevels[i]->cAnzstate || Pstate != mglevels[i]->cPnzstate || (A == P) != !mglevels[i]->cAloc)) {
+        PetscCall(MatDestroy(&mglevels[i]->cAloc));
+        PetscCall(MatDestroy(&mglevels[i]->cPloc));
+        if (active) {
+          PetscCall(MatDestroy(&mg->cA));
+          PetscCall(MatDestroy(&mg->cP));
+        }
+      }
+      mglevels[i]->cAnzstate = Astate;
+      mglevels[i]->cPnzstate = Pstate;
+    }
+    PetscCall(PCMGACycleMatCreate_Private(pc, P, isin, active, &mglevels[i]->cPloc, &mg->cP));
+    if (A != P) PetscCall(PCMGACycleMatCreate_Private(pc, A, isin, active, &mglevels[i]->cAloc, &mg->cA));
+    else if (active && !mg->cA) {
+      PetscCall(PetscObjectReference((PetscObject)mg->cP));
+      mg->cA = mg->cP;
+    }
+    PetscCall(ISDestroy(&isin));
+  }
+
+  /* the solver of the level of this process, a copy of the level smoother */
+  if (!mg->cksp) {
+    PetscInt m, M, bs;
+
+    PetscCall(PCMGACycleKSPCreate_Private(pc, mglevels[mg->clevel]->smoothd, &mg->cksp));
+    PetscCall(MatGetLocalSize(mg->cP, &m, NULL));
+    PetscCall(MatGetSize(mg->cP, &M, NULL));
+    PetscCall(MatGetBlockSize(mg->cP, &bs));
+    PetscCall(VecCreateMPIWithArray(PetscSubcommChild(mg->cpsubcomm), bs, m, M, NULL, &mg->cb));
+    PetscCall(MatCreateVecs(mg->cP, &mg->cx, NULL));
+  } else PetscCall(KSPSetOperators(mg->cksp, mg->cA, mg->cP));
+  if (mg->ckspt) PetscCall(KSPSetOperators(mg->ckspt, mg->cA, mg->cP));
+  PetscCall(KSPSetUp(mg->cksp));
+  if (mg->cksp->reason) pc->failedreason = PC_SUBPC_ERROR;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* solve all the levels at once, each group of processes solving its own level */
+static PetscErrorCode PCMGACycleSolveConcurrent_Private(PC pc, PC_MG_Levels **mglevels, PetscBool transpose)
+{
+  PC_MG        *mg = (PC_MG *)pc->data;
+  PC_MG_Levels *mgl = mglevels[mg->clevel];
+  PetscInt      l   = mglevels[0]->levels, m;
+  PetscScalar  *a;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < l; i++) PetscCall(VecScatterBegin(mglevels[i]->cscatter, mglevels[i]->b, mglevels[i]->ctmp, INSERT_VALUES, SCATTER_FORWARD));
+  for (PetscInt i = 0; i < l; i++) PetscCall(VecScatterEnd(mglevels[i]->cscatter, mglevels[i]->b, mglevels[i]->ctmp, INSERT_VALUES, SCATTER_FORWARD));
+
+  if (mgl->eventsmoothsolve) PetscCall(PetscLogEventBegin(mgl->eventsmoothsolve, 0, 0, 0, 0));
+  PetscCall(VecGetLocalSize(mgl->ctmp, &m));
+  PetscCall(VecGetArray(mgl->ctmp, &a));
+  PetscCall(VecPlaceArray(mg->cb, a));
+  PetscCall(VecZeroEntries(mg->cx));
+  if (!transpose) {
+    PetscCall(KSPSolve(mg->cksp, mg->cb, mg->cx));
+    PetscCall(KSPCheckSolve(mg->cksp, pc, mg->cx));
+  } else {
+    KSP ksp = mg->cksp;
+
+    /* the transpose cycle uses the post smoother, as the sequential one */
+    if (mgl->smoothu != mgl->smoothd) {
+      if (!mg->ckspt) PetscCall(PCMGACycleKSPCreate_Private(pc, mgl->smoothu, &mg->ckspt));
+      ksp = mg->ckspt;
+    }
+    PetscCall(KSPSolveTranspose(ksp, mg->cb, mg->cx));
+    PetscCall(KSPCheckSolve(ksp, pc, mg->cx));
+  }
+  PetscCall(VecResetArray(mg->cb));
+  {
+    const PetscScalar *x;
+
+    PetscCall(VecGetArrayRead(mg->cx, &x));
+    PetscCall(PetscArraycpy(a, x, m));
+    PetscCall(VecRestoreArrayRead(mg->cx, &x));
+  }
+  PetscCall(VecRestoreArray(mgl->ctmp, &a));
+  if (mgl->eventsmoothsolve) PetscCall(PetscLogEventEnd(mgl->eventsmoothsolve, 0, 0, 0, 0));
+
+  for (PetscInt i = 0; i < l; i++) PetscCall(VecScatterBegin(mglevels[i]->cscatter, mglevels[i]->ctmp, mglevels[i]->x, INSERT_VALUES, SCATTER_REVERSE));
+  for (PetscInt i = 0; i < l; i++) PetscCall(VecScatterEnd(mglevels[i]->cscatter, mglevels[i]->ctmp, mglevels[i]->x, INSERT_VALUES, SCATTER_REVERSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
 PetscErrorCode PCMGACycle_Private(PC pc, PC_MG_Levels **mglevels, PetscBool transpose, PetscBool matapp)
 {
+  PC_MG   *mg = (PC_MG *)pc->data;
   PetscInt i, l = mglevels[0]->levels;
 
   PetscFunctionBegin;
@@ -20,32 +318,35 @@ PetscErrorCode PCMGACycle_Private(PC pc, PC_MG_Levels **mglevels, PetscBool tran
     }
     if (mglevels[i]->eventinterprestrict) PetscCall(PetscLogEventEnd(mglevels[i]->eventinterprestrict, 0, 0, 0, 0));
   }
-  /* solve separately on each level */
-  for (i = 0; i < l; i++) {
-    if (matapp) {
-      if (!mglevels[i]->X) {
-        PetscCall(MatDuplicate(mglevels[i]->B, MAT_DO_NOT_COPY_VALUES, &mglevels[i]->X));
+  if (mg->cpsubcomm && !matapp) PetscCall(PCMGACycleSolveConcurrent_Private(pc, mglevels, transpose));
+  else {
+    /* solve separately on each level */
+    for (i = 0; i < l; i++) {
+      if (matapp) {
+        if (!mglevels[i]->X) {
+          PetscCall(MatDuplicate(mglevels[i]->B, MAT_DO_NOT_COPY_VALUES, &mglevels[i]->X));
+        } else {
+          PetscCall(MatZeroEntries(mglevels[i]->X));
+        }
       } else {
-        PetscCall(MatZeroEntries(mglevels[i]->X));
+        PetscCall(VecZeroEntries(mglevels[i]->x));
       }
-    } else {
-      PetscCall(VecZeroEntries(mglevels[i]->x));
-    }
-    if (mglevels[i]->eventsmoothsolve) PetscCall(PetscLogEventBegin(mglevels[i]->eventsmoothsolve, 0, 0, 0, 0));
-    if (!transpose) {
-      if (matapp) {
-        PetscCall(KSPMatSolve(mglevels[i]->smoothd, mglevels[i]->B, mglevels[i]->X));
-        PetscCall(KSPCheckSolve(mglevels[i]->smoothd, pc, NULL));
+      if (mglevels[i]->eventsmoothsolve) PetscCall(PetscLogEventBegin(mglevels[i]->eventsmoothsolve, 0, 0, 0, 0));
+      if (!transpose) {
+        if (matapp) {
+          PetscCall(KSPMatSolve(mglevels[i]->smoothd, mglevels[i]->B, mglevels[i]->X));
+          PetscCall(KSPCheckSolve(mglevels[i]->smoothd, pc, NULL));
+        } else {
+          PetscCall(KSPSolve(mglevels[i]->smoothd, mglevels[i]->b, mglevels[i]->x));
+          PetscCall(KSPCheckSolve(mglevels[i]->smoothd, pc, mglevels[i]->x));
+        }
       } else {
-        PetscCall(KSPSolve(mglevels[i]->smoothd, mglevels[i]->b, mglevels[i]->x));
-        PetscCall(KSPCheckSolve(mglevels[i]->smoothd, pc, mglevels[i]->x));
+        PetscCheck(!matapp, PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP, "Not supported");
+        PetscCall(KSPSolveTranspose(mglevels[i]->smoothu, mglevels[i]->b, mglevels[i]->x));
+        PetscCall(KSPCheckSolve(mglevels[i]->smoothu, pc, mglevels[i]->x));
       }
-    } else {
-      PetscCheck(!matapp, PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP, "Not supported");
-      PetscCall(KSPSolveTranspose(mglevels[i]->smoothu, mglevels[i]->b, mglevels[i]->x));
-      PetscCall(KSPCheckSolve(mglevels[i]->smoothu, pc, mglevels[i]->x));
+      if (mglevels[i]->eventsmoothsolve) PetscCall(PetscLogEventEnd(mglevels[i]->eventsmoothsolve, 0, 0, 0, 0));
     }
-    if (mglevels[i]->eventsmoothsolve) PetscCall(PetscLogEventEnd(mglevels[i]->eventsmoothsolve, 0, 0, 0, 0));
   }
   for (i = 1; i < l; i++) {
     if (mglevels[i]->eventinterprestrict) PetscCall(PetscLogEventBegin(mglevels[i]->eventinterprestrict, 0, 0, 0, 0));
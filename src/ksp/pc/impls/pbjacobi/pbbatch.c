@@ -0,0 +1,339 @@
+/*
+   Batched dense LU factorization with partial pivoting, and the corresponding solves, of many small diagonal blocks.
+
+   Entry (i,j) of lane l of batch b of a group with block size bs is stored at a[((b * bs + j) * bs + i) * PC_BATCH_LANES + l],
+   so the innermost loop of every kernel runs over the lanes, that is over PC_BATCH_LANES different blocks, with unit stride.
+*/
+#include <../src/ksp/pc/impls/pbjacobi/pbbatch.h>
+
+#define BLU(a, bs, i, j, l) ((a)[((j) * (bs) + (i)) * PC_BATCH_LANES + (l)])
+
+PetscErrorCode PCBatchLUCreate(PetscInt nblocks, const PetscInt bsizes[], PCBatchLU *blu)
+{
+  PCBatchLU b;
+  PetscInt  i, k, g, count[PC_BATCH_MAX_BS + 1], group[PC_BATCH_MAX_BS + 1], *fill, start = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&b));
+  b->nblocks = nblocks;
+  b->min_bs  = nblocks ? PETSC_MAX_INT : 0;
+  b->max_bs  = 0;
+  PetscCall(PetscArrayzero(count, PC_BATCH_MAX_BS + 1));
+  for (i = 0; i < nblocks; i++) {
+    PetscCheck(bsizes[i] >= 1 && bsizes[i] <= PC_BATCH_MAX_BS, PETSC_COMM_SELF, PETSC_ERR_SUP, "Batched block size %" PetscInt_FMT " must be between 1 and %d", bsizes[i], PC_BATCH_MAX_BS);
+    count[bsizes[i]]++;
+    b->min_bs = PetscMin(b->min_bs, bsizes[i]);
+    b->max_bs = PetscMax(b->max_bs, bsizes[i]);
+  }
+  for (k = 1; k <= PC_BATCH_MAX_BS; k++) {
+    group[k] = b->ngroups;
+    if (count[k]) b->ngroups++;
+  }
+  PetscCall(PetscCalloc1(b->ngroups, &b->groups));
+  PetscCall(PetscCalloc1(b->ngroups, &fill));
+  for (k = 1; k <= PC_BATCH_MAX_BS; k++) {
+    PCBatchLUGroup *grp = &b->groups[group[k]];
+
+    if (!count[k]) continue;
+    grp->bs     = k;
+    grp->nbatch = (count[k] + PC_BATCH_LANES - 1) / PC_BATCH_LANES;
+    PetscCall(PetscMalloc3(grp->nbatch * PC_BATCH_LANES, &grp->start, grp->nbatch * k * k * PC_BATCH_LANES, &grp->a, grp->nbatch * k * PC_BATCH_LANES, &grp->perm));
+    for (i = 0; i < grp->nbatch * PC_BATCH_LANES; i++) grp->start[i] = -1;
+  }
+  for (i = 0; i < nblocks; i++) {
+    g                             = group[bsizes[i]];
+    b->groups[g].start[fill[g]++] = start;
+    start += bsizes[i];
+  }
+  PetscCall(PetscFree(fill));
+  *blu = b;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Whether b was created with these block sizes, in this order, so that its interleaved layout can be reused */
+PetscErrorCode PCBatchLUHasSizes(PCBatchLU b, PetscInt nblocks, const PetscInt bsizes[], PetscBool *has)
+{
+  PetscInt i, g, group[PC_BATCH_MAX_BS + 1], fill[PC_BATCH_MAX_BS + 1], start = 0;
+
+  PetscFunctionBegin;
+  *has = PETSC_FALSE;
+  if (b->nblocks != nblocks) PetscFunctionReturn(PETSC_SUCCESS);
+  for (i = 0; i <= PC_BATCH_MAX_BS; i++) group[i] = -1;
+  for (g = 0; g < b->ngroups; g++) {
+    group[b->groups[g].bs] = g;
+    fill[g]                = 0;
+  }
+  for (i = 0; i < nblocks; i++) {
+    if (bsizes[i] < 1 || bsizes[i] > PC_BATCH_MAX_BS || group[bsizes[i]] < 0) PetscFunctionReturn(PETSC_SUCCESS);
+    g = group[bsizes[i]];
+    if (fill[g] >= b->groups[g].nbatch * PC_BATCH_LANES || b->groups[g].start[fill[g]++] != start) PetscFunctionReturn(PETSC_SUCCESS);
+    start += bsizes[i];
+  }
+  /* every group must be filled up to its padding */
+  for (g = 0; g < b->ngroups; g++)
+    if (fill[g] < b->groups[g].nbatch * PC_BATCH_LANES && b->groups[g].start[fill[g]] >= 0) PetscFunctionReturn(PETSC_SUCCESS);
+  *has = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Gathers the diagonal blocks of the local rows of A into the interleaved storage; padding lanes get identity blocks */
+static PetscErrorCode PCBatchLUFill_Private(PCBatchLU b, Mat A)
+{
+  PetscInt           g, s, i, j, k, rstart, ncols;
+  const PetscInt    *cols;
+  const PetscScalar *vals;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetOwnershipRange(A, &rstart, NULL));
+  for (g = 0; g < b->ngroups; g++) {
+    PCBatchLUGroup *grp = &b->groups[g];
+    const PetscInt  bs  = grp->bs;
+
+    PetscCall(PetscArrayzero(grp->a, grp->nbatch * bs * bs * PC_BATCH_LANES));
+    for (s = 0; s < grp->nbatch * PC_BATCH_LANES; s++) {
+      MatScalar     *a = grp->a + (s / PC_BATCH_LANES) * bs * bs * PC_BATCH_LANES;
+      const PetscInt l = s % PC_BATCH_LANES;
+
+      if (grp->start[s] < 0) {
+        for (i = 0; i < bs; i++) BLU(a, bs, i, i, l) = 1.0;
+        continue;
+      }
+      for (i = 0; i < bs; i++) {
+        const PetscInt row = rstart + grp->start[s] + i;
+
+        PetscCall(MatGetRow(A, row, &ncols, &cols, &vals));
+        for (k = 0; k < ncols; k++) {
+          j = cols[k] - rstart - grp->start[s];
+          if (j >= 0 && j < bs) BLU(a, bs, i, j, l) = vals[k];
+        }
+        PetscCall(MatRestoreRow(A, row, &ncols, &cols, &vals));
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* LU factorization with partial pivoting of the PC_BATCH_LANES blocks of one batch, every lane choosing its own pivots */
+static inline PetscInt PCBatchLUFactor_Kernel(PetscInt bs, MatScalar *a, PetscInt *perm)
+{
+  PetscInt  i, j, k, l, piv[PC_BATCH_LANES], zero[PC_BATCH_LANES] = {0}, nzero = 0;
+  MatReal   amax[PC_BATCH_LANES];
+  MatScalar d[PC_BATCH_LANES];
+
+  for (k = 0; k < bs; k++) {
+    PetscPragmaSIMD
+    for (l = 0; l < PC_BATCH_LANES; l++) {
+      piv[l]  = k;
+      amax[l] = PetscAbsScalar(BLU(a, bs, k, k, l));
+    }
+    for (i = k + 1; i < bs; i++) {
+      PetscPragmaSIMD
+      for (l = 0; l < PC_BATCH_LANES; l++) {
+        const MatReal v = PetscAbsScalar(BLU(a, bs, i, k, l));
+
+        piv[l]  = v > amax[l] ? i : piv[l];
+        amax[l] = v > amax[l] ? v : amax[l];
+      }
+    }
+    for (l = 0; l < PC_BATCH_LANES; l++) perm[k * PC_BATCH_LANES + l] = piv[l];
+    for (j = 0; j < bs; j++) {
+      for (l = 0; l < PC_BATCH_LANES; l++) {
+        const MatScalar t = BLU(a, bs, k, j, l);
+
+        BLU(a, bs, k, j, l)      = BLU(a, bs, piv[l], j, l);
+        BLU(a, bs, piv[l], j, l) = t;
+      }
+    }
+    for (l = 0; l < PC_BATCH_LANES; l++) {
+      /* a singular block gets a zero inverse pivot, the caller reports the failure */
+      if (amax[l] == 0.0) {
+        d[l]    = 0.0;
+        zero[l] = 1;
+      } else d[l] = 1.0 / BLU(a, bs, k, k, l);
+      BLU(a, bs, k, k, l) = d[l];
+    }
+    for (i = k + 1; i < bs; i++) {
+      PetscPragmaSIMD
+      for (l = 0; l < PC_BATCH_LANES; l++) BLU(a, bs, i, k, l) *= d[l];
+    }
+    for (j = k + 1; j < bs; j++) {
+      for (i = k + 1; i < bs; i++) {
+        PetscPragmaSIMD
+        for (l = 0; l < PC_BATCH_LANES; l++) BLU(a, bs, i, j, l) -= BLU(a, bs, i, k, l) * BLU(a, bs, k, j, l);
+      }
+    }
+  }
+  for (l = 0; l < PC_BATCH_LANES; l++) nzero += zero[l];
+  return nzero;
+}
+
+/*
+   Extracts and factors the diagonal blocks of the local rows of A, which must support MatGetRow(). A zero pivot generates an
+   error if erroriffailure is set, otherwise it is returned in zeropivot and the singular blocks get a zero inverse pivot.
+*/
+PetscErrorCode PCBatchLUFactor(PCBatchLU b, Mat A, PetscBool erroriffailure, PetscBool *zeropivot)
+{
+  PetscInt       g;
+  PetscLogDouble flops = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUFill_Private(b, A));
+  *zeropivot = PETSC_FALSE;
+  for (g = 0; g < b->ngroups; g++) {
+    PCBatchLUGroup *grp    = &b->groups[g];
+    const PetscInt  bs     = grp->bs;
+    const PetscInt  nbatch = grp->nbatch;
+    PetscInt        batch, nzero = 0;
+
+    PetscPragmaUseOMPKernels(parallel for schedule(static) reduction(+:nzero))
+    for (batch = 0; batch < nbatch; batch++) nzero += PCBatchLUFactor_Kernel(bs, grp->a + batch * bs * bs * PC_BATCH_LANES, grp->perm + batch * bs * PC_BATCH_LANES);
+    if (nzero) {
+      PetscCheck(!erroriffailure, PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "Zero pivot in a diagonal block of size %" PetscInt_FMT, bs);
+      PetscCall(PetscInfo(A, "Zero pivot in %" PetscInt_FMT " diagonal block(s) of size %" PetscInt_FMT "\n", nzero, bs));
+      *zeropivot = PETSC_TRUE;
+    }
+    flops += (2.0 * bs * bs * bs / 3.0) * nbatch * PC_BATCH_LANES;
+  }
+  PetscCall(PetscLogFlops(flops));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Solves with the factors of one batch, t holds the interleaved right-hand sides on entry and the solutions on exit */
+static inline void PCBatchLUSolve_Kernel(PetscInt bs, const MatScalar *a, const PetscInt *perm, PetscScalar *t)
+{
+  PetscInt i, k, l;
+
+  for (k = 0; k < bs; k++) {
+    for (l = 0; l < PC_BATCH_LANES; l++) {
+      const PetscInt    p = perm[k * PC_BATCH_LANES + l];
+      const PetscScalar s = t[k * PC_BATCH_LANES + l];
+
+      t[k * PC_BATCH_LANES + l] = t[p * PC_BATCH_LANES + l];
+      t[p * PC_BATCH_LANES + l] = s;
+    }
+  }
+  for (k = 0; k < bs; k++) {
+    for (i = k + 1; i < bs; i++) {
+      PetscPragmaSIMD
+      for (l = 0; l < PC_BATCH_LANES; l++) t[i * PC_BATCH_LANES + l] -= BLU(a, bs, i, k, l) * t[k * PC_BATCH_LANES + l];
+    }
+  }
+  for (k = bs - 1; k >= 0; k--) {
+    PetscPragmaSIMD
+    for (l = 0; l < PC_BATCH_LANES; l++) t[k * PC_BATCH_LANES + l] *= BLU(a, bs, k, k, l);
+    for (i = 0; i < k; i++) {
+      PetscPragmaSIMD
+      for (l = 0; l < PC_BATCH_LANES; l++) t[i * PC_BATCH_LANES + l] -= BLU(a, bs, i, k, l) * t[k * PC_BATCH_LANES + l];
+    }
+  }
+}
+
+/* Solves with the transpose of A = P^T L U, that is U^T L^T P */
+static inline void PCBatchLUSolveTranspose_Kernel(PetscInt bs, const MatScalar *a, const PetscInt *perm, PetscScalar *t)
+{
+  PetscInt i, k, l;
+
+  for (k = 0; k < bs; k++) {
+    PetscPragmaSIMD
+    for (l = 0; l < PC_BATCH_LANES; l++) t[k * PC_BATCH_LANES + l] *= BLU(a, bs, k, k, l);
+    for (i = k + 1; i < bs; i++) {
+      PetscPragmaSIMD
+      for (l = 0; l < PC_BATCH_LANES; l++) t[i * PC_BATCH_LANES + l] -= BLU(a, bs, k, i, l) * t[k * PC_BATCH_LANES + l];
+    }
+  }
+  for (k = bs - 1; k >= 0; k--) {
+    for (i = k + 1; i < bs; i++) {
+      PetscPragmaSIMD
+      for (l = 0; l < PC_BATCH_LANES; l++) t[k * PC_BATCH_LANES + l] -= BLU(a, bs, i, k, l) * t[i * PC_BATCH_LANES + l];
+    }
+  }
+  for (k = bs - 1; k >= 0; k--) {
+    for (l = 0; l < PC_BATCH_LANES; l++) {
+      const PetscInt    p = perm[k * PC_BATCH_LANES + l];
+      const PetscScalar s = t[k * PC_BATCH_LANES + l];
+
+      t[k * PC_BATCH_LANES + l] = t[p * PC_BATCH_LANES + l];
+      t[p * PC_BATCH_LANES + l] = s;
+    }
+  }
+}
+
+static PetscErrorCode PCBatchLUSolve_Private(PCBatchLU b, Vec x, Vec y, PetscBool transpose)
+{
+  const PetscScalar *xx;
+  PetscScalar       *yy;
+  PetscInt           g;
+  PetscLogDouble     flops = 0;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(x, &xx));
+  PetscCall(VecGetArrayWrite(y, &yy));
+  for (g = 0; g < b->ngroups; g++) {
+    const PCBatchLUGroup *grp    = &b->groups[g];
+    const PetscInt        bs     = grp->bs;
+    const PetscInt        nbatch = grp->nbatch;
+    PetscInt              batch;
+
+    PetscPragmaUseOMPKernels(parallel for schedule(static))
+    for (batch = 0; batch < nbatch; batch++) {
+      const PetscInt *start = grp->start + batch * PC_BATCH_LANES;
+      PetscScalar     t[PC_BATCH_MAX_BS * PC_BATCH_LANES];
+      PetscInt        i, l;
+
+      for (i = 0; i < bs; i++) {
+        for (l = 0; l < PC_BATCH_LANES; l++) t[i * PC_BATCH_LANES + l] = start[l] < 0 ? 0.0 : xx[start[l] + i];
+      }
+      if (transpose) PCBatchLUSolveTranspose_Kernel(bs, grp->a + batch * bs * bs * PC_BATCH_LANES, grp->perm + batch * bs * PC_BATCH_LANES, t);
+      else PCBatchLUSolve_Kernel(bs, grp->a + batch * bs * bs * PC_BATCH_LANES, grp->perm + batch * bs * PC_BATCH_LANES, t);
+      for (i = 0; i < bs; i++) {
+        for (l = 0; l < PC_BATCH_LANES; l++) {
+          if (start[l] >= 0) yy[start[l] + i] = t[i * PC_BATCH_LANES + l];
+        }
+      }
+    }
+    flops += (2.0 * bs * bs - bs) * nbatch * PC_BATCH_LANES;
+  }
+  PetscCall(VecRestoreArrayRead(x, &xx));
+  PetscCall(VecRestoreArrayWrite(y, &yy));
+  PetscCall(PetscLogFlops(flops));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PCBatchLUSolve(PCBatchLU b, Vec x, Vec y)
+{
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUSolve_Private(b, x, y, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PCBatchLUSolveTranspose(PCBatchLU b, Vec x, Vec y)
+{
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUSolve_Private(b, x, y, PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PCBatchLUView(PCBatchLU b, PetscViewer viewer)
+{
+  PetscInt g;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerASCIIPrintf(viewer, "  batched dense LU of %d blocks per batch, number of batches:", PC_BATCH_LANES));
+  PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_FALSE));
+  for (g = 0; g < b->ngroups; g++) PetscCall(PetscViewerASCIIPrintf(viewer, " %" PetscInt_FMT " (block size %" PetscInt_FMT ")", b->groups[g].nbatch, b->groups[g].bs));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "\n"));
+  PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PCBatchLUDestroy(PCBatchLU *blu)
+{
+  PetscInt g;
+
+  PetscFunctionBegin;
+  if (!*blu) PetscFunctionReturn(PETSC_SUCCESS);
+  for (g = 0; g < (*blu)->ngroups; g++) PetscCall(PetscFree3((*blu)->groups[g].start, (*blu)->groups[g].a, (*blu)->groups[g].perm));
+  PetscCall(PetscFree((*blu)->groups));
+  PetscCall(PetscFree(*blu));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
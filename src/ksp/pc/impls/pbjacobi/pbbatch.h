@@ -0,0 +1,35 @@
+#pragma once
+
+#include <petsc/private/pcimpl.h>
+
+/*
+   Batched dense LU factorization and solves of many small diagonal blocks, shared by PCPBJACOBI, PCVPBJACOBI and PCBJACOBI.
+
+   The blocks are grouped by size; the blocks of one group are interleaved in batches of PC_BATCH_LANES blocks so that
+   entry (i,j) of the PC_BATCH_LANES blocks of a batch is contiguous in memory and every SIMD lane works on a different block.
+*/
+#define PC_BATCH_LANES  8
+#define PC_BATCH_MAX_BS 32
+
+typedef struct {
+  PetscInt   bs;     /* size of the blocks of this group */
+  PetscInt   nbatch; /* number of batches, the last one padded with identity blocks */
+  PetscInt  *start;  /* [nbatch*PC_BATCH_LANES] first local row of each block, -1 for padding */
+  MatScalar *a;      /* [nbatch*bs*bs*PC_BATCH_LANES] interleaved LU factors, reciprocal of the pivots on the diagonal */
+  PetscInt  *perm;   /* [nbatch*bs*PC_BATCH_LANES] row interchanges of the partial pivoting */
+} PCBatchLUGroup;
+
+typedef struct _n_PCBatchLU *PCBatchLU;
+struct _n_PCBatchLU {
+  PetscInt        nblocks, min_bs, max_bs;
+  PetscInt        ngroups;
+  PCBatchLUGroup *groups;
+};
+
+PETSC_INTERN PetscErrorCode PCBatchLUCreate(PetscInt, const PetscInt[], PCBatchLU *);
+PETSC_INTERN PetscErrorCode PCBatchLUHasSizes(PCBatchLU, PetscInt, const PetscInt[], PetscBool *);
+PETSC_INTERN PetscErrorCode PCBatchLUFactor(PCBatchLU, Mat, PetscBool, PetscBool *);
+PETSC_INTERN PetscErrorCode PCBatchLUSolve(PCBatchLU, Vec, Vec);
+PETSC_INTERN PetscErrorCode PCBatchLUSolveTranspose(PCBatchLU, Vec, Vec);
+PETSC_INTERN PetscErrorCode PCBatchLUView(PCBatchLU, PetscViewer);
+PETSC_INTERN PetscErrorCode PCBatchLUDestroy(PCBatchLU *);
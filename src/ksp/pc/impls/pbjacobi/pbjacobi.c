@@ -262,8 +262,57 @@ PETSC_INTERN PetscErrorCode PCSetUp_PBJacobi_Host(PC pc)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PCApply_PBJacobi_Batched(PC pc, Vec x, Vec y)
+{
+  PC_PBJacobi *jac = (PC_PBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUSolve(jac->blu, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplyTranspose_PBJacobi_Batched(PC pc, Vec x, Vec y)
+{
+  PC_PBJacobi *jac = (PC_PBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUSolveTranspose(jac->blu, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetUp_PBJacobi_Batched(PC pc)
+{
+  PC_PBJacobi *jac = (PC_PBJacobi *)pc->data;
+  Mat          A   = pc->pmat;
+  PetscInt     i, nlocal, *bsizes;
+  PetscBool    zeropivot, has;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetBlockSize(A, &jac->bs));
+  PetscCall(MatGetLocalSize(A, &nlocal, NULL));
+  jac->mbs = nlocal / jac->bs;
+  PetscCall(PetscMalloc1(jac->mbs, &bsizes));
+  for (i = 0; i < jac->mbs; i++) bsizes[i] = jac->bs;
+  /* a new block size needs a new interleaved layout */
+  if (jac->blu) {
+    PetscCall(PCBatchLUHasSizes(jac->blu, jac->mbs, bsizes, &has));
+    if (!has) PetscCall(PCBatchLUDestroy(&jac->blu));
+  }
+  if (!jac->blu) PetscCall(PCBatchLUCreate(jac->mbs, bsizes, &jac->blu));
+  PetscCall(PetscFree(bsizes));
+  PetscCall(PCBatchLUFactor(jac->blu, A, pc->erroriffailure, &zeropivot));
+  if (zeropivot) pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+  pc->ops->apply          = PCApply_PBJacobi_Batched;
+  pc->ops->applytranspose = PCApplyTranspose_PBJacobi_Batched;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PCSetUp_PBJacobi(PC pc)
 {
+  PC_PBJacobi *jac     = (PC_PBJacobi *)pc->data;
+  PetscBool    batched = jac->batched;
+  PetscInt     bs;
+
   PetscFunctionBegin;
   /* In PCCreate_PBJacobi() pmat might have not been set, so we wait to the last minute to do the dispatch */
 #if defined(PETSC_HAVE_CUDA)
@@ -285,17 +334,31 @@ static PetscErrorCode PCSetUp_PBJacobi(PC pc)
   else
 #endif
   {
-    PetscCall(PCSetUp_PBJacobi_Host(pc));
+    if (batched) {
+      PetscCall(MatGetBlockSize(pc->pmat, &bs));
+      if (bs > PC_BATCH_MAX_BS) {
+        PetscCall(PetscInfo(pc, "Block size %" PetscInt_FMT " not supported by the batched dense LU, inverting the blocks instead\n", bs));
+        batched = PETSC_FALSE;
+      }
+    }
+    if (batched) PetscCall(PCSetUp_PBJacobi_Batched(pc));
+    else {
+      PetscCall(PCBatchLUDestroy(&jac->blu));
+      PetscCall(PCSetUp_PBJacobi_Host(pc));
+    }
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 PetscErrorCode PCDestroy_PBJacobi(PC pc)
 {
+  PC_PBJacobi *jac = (PC_PBJacobi *)pc->data;
+
   PetscFunctionBegin;
   /*
       Free the private data structure that was hanging off the PC
   */
+  PetscCall(PCBatchLUDestroy(&jac->blu));
   PetscCall(PetscFree(pc->data));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -307,13 +370,30 @@ static PetscErrorCode PCView_PBJacobi(PC pc, PetscViewer viewer)
 
   PetscFunctionBegin;
   PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
-  if (iascii) PetscCall(PetscViewerASCIIPrintf(viewer, "  point-block size %" PetscInt_FMT "\n", jac->bs));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  point-block size %" PetscInt_FMT "\n", jac->bs));
+    if (jac->blu) PetscCall(PCBatchLUView(jac->blu, viewer));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetFromOptions_PBJacobi(PC pc, PetscOptionItems *PetscOptionsObject)
+{
+  PC_PBJacobi *jac = (PC_PBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Point-block Jacobi options");
+  PetscCall(PetscOptionsBool("-pc_pbjacobi_batched", "Factor and solve the blocks with a batched dense LU interleaving several blocks", "PCPBJACOBI", jac->batched, &jac->batched, NULL));
+  PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 /*MC
      PCPBJACOBI - Point block Jacobi preconditioner
 
+   Options Database Key:
+.  -pc_pbjacobi_batched <false> - factor the blocks and solve with them with a batched dense LU instead of applying explicit inverses
+
    Notes:
     See `PCJACOBI` for diagonal Jacobi, `PCVPBJACOBI` for variable-size point block, and `PCBJACOBI` for large size blocks
 
@@ -322,6 +402,10 @@ static PetscErrorCode PCView_PBJacobi(PC pc, PetscViewer viewer)
    Uses dense LU factorization with partial pivoting to invert the blocks; if a zero pivot
    is detected a PETSc error is generated.
 
+   With `-pc_pbjacobi_batched` the blocks, of size at most 32, are stored interleaved by groups of 8 so that the LU factorization
+   and the triangular solves of the group vectorize across the blocks, and are threaded over the groups with `--with-openmp-kernels`.
+   This applies to matrices on the host only.
+
    Developer Notes:
      This should support the `PCSetErrorIfFailure()` flag set to `PETSC_TRUE` to allow
      the factorization to continue even after a zero pivot is found resulting in a Nan and hence
@@ -365,7 +449,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_PBJacobi(PC pc)
   pc->ops->applytranspose      = PCApplyTranspose_PBJacobi;
   pc->ops->setup               = PCSetUp_PBJacobi;
   pc->ops->destroy             = PCDestroy_PBJacobi;
-  pc->ops->setfromoptions      = NULL;
+  pc->ops->setfromoptions      = PCSetFromOptions_PBJacobi;
   pc->ops->view                = PCView_PBJacobi;
   pc->ops->applyrichardson     = NULL;
   pc->ops->applysymmetricleft  = NULL;
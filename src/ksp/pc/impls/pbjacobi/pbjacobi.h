@@ -1,6 +1,7 @@
 #pragma once
 
 #include <petsc/private/pcimpl.h>
+#include <../src/ksp/pc/impls/pbjacobi/pbbatch.h>
 
 /*
    Private context (data structure) for the PBJacobi preconditioner.
@@ -9,6 +10,8 @@ typedef struct {
   const MatScalar *diag;
   PetscInt         bs, mbs; /* block size (bs), and number of blocks (mbs) */
   void            *spptr;   /* opaque pointer to a device data structure */
+  PetscBool        batched; /* factor and solve the blocks with the batched dense LU on the host */
+  PCBatchLU        blu;
 } PC_PBJacobi;
 
 #if defined(PETSC_HAVE_CUDA)
@@ -237,8 +237,58 @@ PETSC_INTERN PetscErrorCode PCSetUp_VPBJacobi_Host(PC pc)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PCApply_VPBJacobi_Batched(PC pc, Vec x, Vec y)
+{
+  PC_VPBJacobi *jac = (PC_VPBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUSolve(jac->blu, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApplyTranspose_VPBJacobi_Batched(PC pc, Vec x, Vec y)
+{
+  PC_VPBJacobi *jac = (PC_VPBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(PCBatchLUSolveTranspose(jac->blu, x, y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetUp_VPBJacobi_Batched(PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi *)pc->data;
+  PetscInt        nblocks;
+  const PetscInt *bsizes;
+  PetscBool       zeropivot, has;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetVariableBlockSizes(pc->pmat, &nblocks, &bsizes));
+  /* new variable block sizes need a new interleaved layout */
+  if (jac->blu) {
+    PetscCall(PCBatchLUHasSizes(jac->blu, nblocks, bsizes, &has));
+    if (!has) PetscCall(PCBatchLUDestroy(&jac->blu));
+  }
+  if (!jac->blu) {
+    PetscCall(PCBatchLUCreate(nblocks, bsizes, &jac->blu));
+    jac->nblocks = jac->blu->nblocks;
+    jac->min_bs  = jac->blu->min_bs;
+    jac->max_bs  = jac->blu->max_bs;
+  }
+  PetscCall(PCBatchLUFactor(jac->blu, pc->pmat, pc->erroriffailure, &zeropivot));
+  if (zeropivot) pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+  pc->ops->apply          = PCApply_VPBJacobi_Batched;
+  pc->ops->applytranspose = PCApplyTranspose_VPBJacobi_Batched;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
 {
+  PC_VPBJacobi   *jac     = (PC_VPBJacobi *)pc->data;
+  PetscBool       batched = jac->batched;
+  PetscInt        i, nblocks, max_bs = 0;
+  const PetscInt *bsizes;
+
   PetscFunctionBegin;
   /* In PCCreate_VPBJacobi() pmat might have not been set, so we wait to the last minute to do the dispatch */
 #if defined(PETSC_HAVE_CUDA)
@@ -260,7 +310,19 @@ static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
   else
 #endif
   {
-    PetscCall(PCSetUp_VPBJacobi_Host(pc));
+    if (batched) {
+      PetscCall(MatGetVariableBlockSizes(pc->pmat, &nblocks, &bsizes));
+      for (i = 0; i < nblocks; i++) max_bs = PetscMax(max_bs, bsizes[i]);
+      if (!nblocks || max_bs > PC_BATCH_MAX_BS) {
+        PetscCall(PetscInfo(pc, "Block size %" PetscInt_FMT " not supported by the batched dense LU, inverting the blocks instead\n", max_bs));
+        batched = PETSC_FALSE;
+      }
+    }
+    if (batched) PetscCall(PCSetUp_VPBJacobi_Batched(pc));
+    else {
+      PetscCall(PCBatchLUDestroy(&jac->blu));
+      PetscCall(PCSetUp_VPBJacobi_Host(pc));
+    }
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -275,10 +337,22 @@ static PetscErrorCode PCView_VPBJacobi(PC pc, PetscViewer viewer)
   if (iascii) {
     PetscCall(PetscViewerASCIIPrintf(viewer, "  number of blocks: %" PetscInt_FMT "\n", jac->nblocks));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  block sizes: min=%" PetscInt_FMT " max=%" PetscInt_FMT "\n", jac->min_bs, jac->max_bs));
+    if (jac->blu) PetscCall(PCBatchLUView(jac->blu, viewer));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PCSetFromOptions_VPBJacobi(PC pc, PetscOptionItems *PetscOptionsObject)
+{
+  PC_VPBJacobi *jac = (PC_VPBJacobi *)pc->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Variable point-block Jacobi options");
+  PetscCall(PetscOptionsBool("-pc_vpbjacobi_batched", "Factor and solve the blocks with a batched dense LU interleaving blocks of the same size", "PCVPBJACOBI", jac->batched, &jac->batched, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode PCDestroy_VPBJacobi(PC pc)
 {
   PC_VPBJacobi *jac = (PC_VPBJacobi *)pc->data;
@@ -288,6 +362,7 @@ PETSC_INTERN PetscErrorCode PCDestroy_VPBJacobi(PC pc)
       Free the private data structure that was hanging off the PC
   */
   PetscCall(PetscFree(jac->diag));
+  PetscCall(PCBatchLUDestroy(&jac->blu));
   PetscCall(PetscFree(pc->data));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -297,6 +372,9 @@ PETSC_INTERN PetscErrorCode PCDestroy_VPBJacobi(PC pc)
 
    Level: beginner
 
+   Options Database Key:
+.  -pc_vpbjacobi_batched <false> - factor the blocks and solve with them with a batched dense LU instead of applying explicit inverses
+
    Notes:
      See `PCJACOBI` for point Jacobi preconditioning, `PCPBJACOBI` for fixed point block size, and `PCBJACOBI` for large size blocks
 
@@ -307,6 +385,9 @@ PETSC_INTERN PetscErrorCode PCDestroy_VPBJacobi(PC pc)
 
      One must call `MatSetVariableBlockSizes()` to use this preconditioner
 
+     With `-pc_vpbjacobi_batched` the blocks, of size at most 32, are grouped by size and stored interleaved by groups of 8 blocks of
+     the same size, so that the LU factorization and the triangular solves vectorize across the blocks; see `PCPBJACOBI`.
+
    Developer Notes:
      This should support the `PCSetErrorIfFailure()` flag set to `PETSC_TRUE` to allow
      the factorization to continue even after a zero pivot is found resulting in a Nan and hence
@@ -348,7 +429,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_VPBJacobi(PC pc)
   pc->ops->applytranspose      = NULL;
   pc->ops->setup               = PCSetUp_VPBJacobi;
   pc->ops->destroy             = PCDestroy_VPBJacobi;
-  pc->ops->setfromoptions      = NULL;
+  pc->ops->setfromoptions      = PCSetFromOptions_VPBJacobi;
   pc->ops->view                = PCView_VPBJacobi;
   pc->ops->applyrichardson     = NULL;
   pc->ops->applysymmetricleft  = NULL;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <petsc/private/pcimpl.h>
+#include <../src/ksp/pc/impls/pbjacobi/pbbatch.h>
 
 /*
    Private context (data structure) for the VPBJacobi preconditioner.
@@ -9,6 +10,8 @@ typedef struct {
   PetscInt   nblocks, min_bs, max_bs; // Stats recorded during setup for viewing
   MatScalar *diag;                    /* on host */
   void      *spptr;                   /* offload to devices */
+  PetscBool  batched;                 /* factor and solve the blocks with the batched dense LU on the host */
+  PCBatchLU  blu;
 } PC_VPBJacobi;
 
 #if defined(PETSC_HAVE_CUDA)
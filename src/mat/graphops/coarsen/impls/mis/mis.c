@@ -15,17 +15,19 @@
    . perm - serial permutation of rows of local to process in MIS
    . Gmat - global matrix of graph (data not defined)
    . strict_aggs - flag for whether to keep strict (non overlapping) aggregates in 'llist';
+   . local_first - aggregate the process interior first, then resolve the boundary with hashed priorities
+   . max_rounds - bound on the rounds of ghost exchanges, 0 for no bound
 
    Output Parameter:
    . a_selected - IS of selected vertices, includes 'ghost' nodes at end with natural local indices
    . a_locals_llist - array of list of nodes rooted at selected nodes
 */
-static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool strict_aggs, PetscCoarsenData **a_locals_llist)
+static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool strict_aggs, PetscBool local_first, PetscInt max_rounds, PetscCoarsenData **a_locals_llist)
 {
   Mat_SeqAIJ       *matA, *matB = NULL;
   Mat_MPIAIJ       *mpimat = NULL;
   MPI_Comm          comm;
-  PetscInt          num_fine_ghosts, kk, n, ix, j, *idx, *ii, Iend, my0, nremoved, gid, lid, cpid, lidj, sgid, t1, t2, slid, nDone, nselected = 0, state, statej;
+  PetscInt          num_fine_ghosts, kk, n, ix, j, *idx, *ii, Iend, my0, nremoved, gid, lid, cpid, lidj, sgid, t1, t2, slid, nDone, nselected = 0, state, statej, round;
   PetscInt         *cpcol_gid, *cpcol_state, *lid_cprowID, *lid_gid, *cpcol_sel_gid, *icpcol_gid, *lid_state, *lid_parent_gid = NULL, nrm_tot = 0;
   PetscBool        *lid_removed;
   PetscBool         isMPI, isAIJ, isOK;
@@ -90,27 +92,36 @@ static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool s
   nremoved = nDone = 0;
 
   PetscCall(ISGetIndices(perm, &perm_ix));
-  while (nDone < nloc || PETSC_TRUE) { /* asynchronous not implemented */
+  for (round = 0;; round++) { /* asynchronous not implemented */
+    /* once the interior is done with local-first, only the boundary is left; after max_rounds select what is left */
+    const PetscBool boundary = (PetscBool)(local_first && round > 0 && matB);
+    const PetscBool last     = (PetscBool)(max_rounds > 0 && round == max_rounds);
+    const PetscInt  nsweep   = boundary ? matB->compressedrow.nrows : nloc;
+
     /* check all vertices */
-    for (kk = 0; kk < nloc; kk++) {
-      lid   = perm_ix[kk];
+    for (kk = 0; kk < nsweep; kk++) {
+      lid   = boundary ? matB->compressedrow.rindex[kk] : perm_ix[kk];
       state = lid_state[lid];
       if (lid_removed[lid]) continue;
       if (state == MIS_NOT_DONE) {
         /* parallel test, delete if selected ghost */
         isOK = PETSC_TRUE;
         if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
-          ii  = matB->compressedrow.i;
-          n   = ii[ix + 1] - ii[ix];
-          idx = matB->j + ii[ix];
-          for (j = 0; j < n; j++) {
-            cpid   = idx[j]; /* compressed row ID in B mat */
-            gid    = cpcol_gid[cpid];
-            statej = cpcol_state[cpid];
-            PetscCheck(!MIS_IS_SELECTED(statej), PETSC_COMM_SELF, PETSC_ERR_SUP, "selected ghost: %d", (int)gid);
-            if (statej == MIS_NOT_DONE && gid >= Iend) { /* should be (pe>rank), use gid as pe proxy */
-              isOK = PETSC_FALSE;                        /* can not delete */
-              break;
+          if (local_first && !round) isOK = PETSC_FALSE; /* the interior goes first */
+          else if (!last) {
+            ii  = matB->compressedrow.i;
+            n   = ii[ix + 1] - ii[ix];
+            idx = matB->j + ii[ix];
+            for (j = 0; j < n; j++) {
+              cpid   = idx[j]; /* compressed row ID in B mat */
+              gid    = cpcol_gid[cpid];
+              statej = cpcol_state[cpid];
+              PetscCheck(!MIS_IS_SELECTED(statej), PETSC_COMM_SELF, PETSC_ERR_SUP, "selected ghost: %d", (int)gid);
+              /* by default the ghost with larger gid (pe>rank, gid as pe proxy) goes first, with local-first the one of higher priority */
+              if (statej == MIS_NOT_DONE && (local_first ? MatCoarsenMISPrecedes_Private(gid, lid + my0) : gid >= Iend)) {
+                isOK = PETSC_FALSE; /* can not delete */
+                break;
+              }
             }
           }
         } /* parallel test */
@@ -172,6 +183,7 @@ static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool s
 
     /* update ghost states and count todos */
     if (isMPI) {
+      if (last) break; /* all selected or deleted, without communication */
       /* scatter states, check for done */
       PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
       PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
@@ -208,7 +220,7 @@ static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool s
     } else break; /* all done */
   } /* outer parallel MIS loop */
   PetscCall(ISRestoreIndices(perm, &perm_ix));
-  PetscCall(PetscInfo(info_is, "\t removed %" PetscInt_FMT " of %" PetscInt_FMT " vertices.  %" PetscInt_FMT " selected.\n", nremoved, nloc, nselected));
+  PetscCall(PetscInfo(info_is, "\t removed %" PetscInt_FMT " of %" PetscInt_FMT " vertices.  %" PetscInt_FMT " selected in %" PetscInt_FMT " rounds.\n", nremoved, nloc, nselected, round + 1));
 
   /* tell adj who my lid_parent_gid vertices belong to - fill in agg_lists selected ghost lists */
   if (strict_aggs && matB) {
@@ -266,10 +278,10 @@ static PetscErrorCode MatCoarsenApply_MIS(MatCoarsen coarse)
     PetscCall(PetscObjectGetComm((PetscObject)mat, &comm));
     PetscCall(MatGetLocalSize(mat, &m, &n));
     PetscCall(ISCreateStride(comm, m, 0, 1, &perm));
-    PetscCall(MatCoarsenApply_MIS_private(perm, mat, coarse->strict_aggs, &coarse->agg_lists));
+    PetscCall(MatCoarsenApply_MIS_private(perm, mat, coarse->strict_aggs, coarse->local_first, coarse->max_rounds, &coarse->agg_lists));
     PetscCall(ISDestroy(&perm));
   } else {
-    PetscCall(MatCoarsenApply_MIS_private(coarse->perm, mat, coarse->strict_aggs, &coarse->agg_lists));
+    PetscCall(MatCoarsenApply_MIS_private(coarse->perm, mat, coarse->strict_aggs, coarse->local_first, coarse->max_rounds, &coarse->agg_lists));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -319,9 +331,14 @@ static PetscErrorCode MatCoarsenView_MIS(MatCoarsen coarse, PetscViewer viewer)
    Input Parameter:
 .  coarse - the coarsen context
 
+   Options Database Keys:
++   -mat_coarsen_local_first <bool> - aggregate the process interior first, see `MatCoarsenSetLocalFirst()`
+-   -mat_coarsen_max_rounds <n> - bound on the rounds of ghost exchanges, see `MatCoarsenSetMaximumRounds()`
+
    Level: beginner
 
-.seealso: `MatCoarsen`, `MatCoarsenApply()`, `MatCoarsenGetData()`, `MatCoarsenSetType()`, `MatCoarsenType`
+.seealso: `MatCoarsen`, `MatCoarsenApply()`, `MatCoarsenGetData()`, `MatCoarsenSetType()`, `MatCoarsenType`,
+          `MatCoarsenSetLocalFirst()`, `MatCoarsenSetMaximumRounds()`
 M*/
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS(MatCoarsen coarse)
 {
@@ -39,11 +39,13 @@ static PetscErrorCode PetscCoarsenDataView_private(PetscCoarsenData *agg_lists,
   Input Parameter:
    . perm - permutation
    . Gmat - global matrix of graph (data not defined)
+   . local_first - aggregate the process interior first, then resolve the boundary with hashed priorities
+   . max_rounds - bound on the rounds of ghost exchanges of each MIS, 0 for no bound
 
   Output Parameter:
    . a_locals_llist - array of list of local nodes rooted at local node
 */
-static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk, Mat Gmat, PetscCoarsenData **a_locals_llist)
+static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk, Mat Gmat, PetscBool local_first, PetscInt max_rounds, PetscCoarsenData **a_locals_llist)
 {
   PetscBool   isMPI;
   MPI_Comm    comm;
@@ -54,7 +56,7 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
   PetscFunctionBegin;
   PetscValidHeaderSpecific(perm, IS_CLASSID, 1);
   PetscValidHeaderSpecific(Gmat, MAT_CLASSID, 3);
-  PetscAssertPointer(a_locals_llist, 4);
+  PetscAssertPointer(a_locals_llist, 6);
   PetscCheck(misk < 5 && misk > 0, PETSC_COMM_SELF, PETSC_ERR_SUP, "too many/few levels: %d", (int)misk);
   PetscCall(PetscObjectBaseTypeCompare((PetscObject)Gmat, MATMPIAIJ, &isMPI));
   PetscCall(PetscObjectGetComm((PetscObject)Gmat, &comm));
@@ -71,7 +73,7 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
     const PetscInt    nloc_inner = cMat->rmap->n;
     PetscCoarsenData *agg_lists;
     PetscInt         *cpcol_gid = NULL, *cpcol_state, *lid_cprowID, *lid_state, *lid_parent_gid = NULL;
-    PetscInt          num_fine_ghosts, kk, n, ix, j, *idx, *ai, Iend, my0, nremoved, gid, cpid, lidj, sgid, t1, t2, slid, nDone, nselected = 0, state;
+    PetscInt          num_fine_ghosts, kk, n, ix, j, *idx, *ai, Iend, my0, nremoved, gid, cpid, lidj, sgid, t1, t2, slid, nDone, nselected = 0, state, round;
     PetscBool        *lid_removed, isOK;
     PetscLayout       layout;
     PetscSF           sf;
@@ -126,10 +128,15 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
     nremoved = nDone = 0;
     if (!iterIdx) PetscCall(ISGetIndices(perm, &perm_ix)); // use permutation on first MIS
     else perm_ix = NULL;
-    while (nDone < nloc_inner || PETSC_TRUE) { /* asynchronous not implemented */
+    for (round = 0;; round++) { /* asynchronous not implemented */
+      /* once the interior is done with local-first, only the boundary is left; after max_rounds select what is left */
+      const PetscBool boundary = (PetscBool)(local_first && round > 0 && matB);
+      const PetscBool last     = (PetscBool)(max_rounds > 0 && round == max_rounds);
+      const PetscInt  nsweep   = boundary ? matB->compressedrow.nrows : nloc_inner;
+
       /* check all vertices */
-      for (kk = 0; kk < nloc_inner; kk++) {
-        const PetscInt lid = perm_ix ? perm_ix[kk] : kk;
+      for (kk = 0; kk < nsweep; kk++) {
+        const PetscInt lid = boundary ? matB->compressedrow.rindex[kk] : (perm_ix ? perm_ix[kk] : kk);
         state              = lid_state[lid];
         if (iterIdx == 0 && lid_removed[lid]) continue;
         if (state == MIS_NOT_DONE) {
@@ -137,15 +144,19 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
           isOK = PETSC_TRUE;
           /* parallel test */
           if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
-            ai  = matB->compressedrow.i;
-            n   = ai[ix + 1] - ai[ix];
-            idx = matB->j + ai[ix];
-            for (j = 0; j < n; j++) {
-              cpid = idx[j]; /* compressed row ID in B mat */
-              gid  = cpcol_gid[cpid];
-              if (cpcol_state[cpid] == MIS_NOT_DONE && gid >= Iend) { /* or pe>rank */
-                isOK = PETSC_FALSE;                                   /* can not delete */
-                break;
+            if (local_first && !round) isOK = PETSC_FALSE; /* the interior goes first */
+            else if (!last) {
+              ai  = matB->compressedrow.i;
+              n   = ai[ix + 1] - ai[ix];
+              idx = matB->j + ai[ix];
+              for (j = 0; j < n; j++) {
+                cpid = idx[j]; /* compressed row ID in B mat */
+                gid  = cpcol_gid[cpid];
+                /* by default the ghost with larger gid (or pe>rank) goes first, with local-first the one of higher priority */
+                if (cpcol_state[cpid] == MIS_NOT_DONE && (local_first ? MatCoarsenMISPrecedes_Private(gid, lid + my0) : gid >= Iend)) {
+                  isOK = PETSC_FALSE; /* can not delete */
+                  break;
+                }
               }
             }
           }
@@ -188,6 +199,7 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
 
       /* update ghost states and count todos */
       if (isMPI) {
+        if (last) break; /* all selected or deleted, without communication */
         /* scatter states, check for done */
         PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
         PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
@@ -218,7 +230,7 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
       } else break; /* no mpi - all done */
     } /* outer parallel MIS loop */
     if (!iterIdx) PetscCall(ISRestoreIndices(perm, &perm_ix));
-    PetscCall(PetscInfo(Gmat, "\t removed %" PetscInt_FMT " of %" PetscInt_FMT " vertices.  %" PetscInt_FMT " selected.\n", nremoved, nloc_inner, nselected));
+    PetscCall(PetscInfo(Gmat, "\t removed %" PetscInt_FMT " of %" PetscInt_FMT " vertices.  %" PetscInt_FMT " selected in %" PetscInt_FMT " rounds.\n", nremoved, nloc_inner, nselected, round + 1));
 
     /* tell adj who my lid_parent_gid vertices belong to - fill in agg_lists selected ghost lists */
     if (matB) {
@@ -364,10 +376,10 @@ static PetscErrorCode MatCoarsenApply_MISK(MatCoarsen coarse)
 
     PetscCall(MatGetLocalSize(mat, &m, &n));
     PetscCall(ISCreateStride(PetscObjectComm((PetscObject)mat), m, 0, 1, &perm));
-    PetscCall(MatCoarsenApply_MISK_private(perm, (PetscInt)k, mat, &coarse->agg_lists));
+    PetscCall(MatCoarsenApply_MISK_private(perm, (PetscInt)k, mat, coarse->local_first, coarse->max_rounds, &coarse->agg_lists));
     PetscCall(ISDestroy(&perm));
   } else {
-    PetscCall(MatCoarsenApply_MISK_private(coarse->perm, (PetscInt)k, mat, &coarse->agg_lists));
+    PetscCall(MatCoarsenApply_MISK_private(coarse->perm, (PetscInt)k, mat, coarse->local_first, coarse->max_rounds, &coarse->agg_lists));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -410,13 +422,16 @@ static PetscErrorCode MatCoarsenSetFromOptions_MISK(MatCoarsen coarse, PetscOpti
 
    Level: beginner
 
-   Options Database Key:
-.   -mat_coarsen_misk_distance <k> - distance for MIS
+   Options Database Keys:
++   -mat_coarsen_misk_distance <k> - distance for MIS
+.   -mat_coarsen_local_first <bool> - aggregate the process interior first, see `MatCoarsenSetLocalFirst()`
+-   -mat_coarsen_max_rounds <n> - bound on the rounds of ghost exchanges of each MIS, see `MatCoarsenSetMaximumRounds()`
 
    Note:
-   When the coarsening is used inside `PCGAMG` then the options database key is `-pc_gamg_mat_coarsen_misk_distance`
+   When the coarsening is used inside `PCGAMG` then the options database keys are prefixed with `-pc_gamg_`, for example `-pc_gamg_mat_coarsen_misk_distance`
 
-.seealso: `MatCoarsen`, `MatCoarsenMISKSetDistance()`, `MatCoarsenApply()`, `MatCoarsenSetType()`, `MatCoarsenType`, `MatCoarsenCreate()`, `MATCOARSENHEM`, `MATCOARSENMIS`
+.seealso: `MatCoarsen`, `MatCoarsenMISKSetDistance()`, `MatCoarsenApply()`, `MatCoarsenSetType()`, `MatCoarsenType`, `MatCoarsenCreate()`, `MATCOARSENHEM`, `MATCOARSENMIS`,
+          `MatCoarsenSetLocalFirst()`, `MatCoarsenSetMaximumRounds()`
 M*/
 
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MISK(MatCoarsen coarse)
@@ -242,6 +242,8 @@ PetscErrorCode MatCoarsenView(MatCoarsen agg, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPopTab(viewer));
   }
   if (agg->strength_index_size > 0) PetscCall(PetscViewerASCIIPrintf(viewer, " Using scalar strength-of-connection index index[%d] = {%d, ..}\n", (int)agg->strength_index_size, (int)agg->strength_index[0]));
+  if (agg->local_first) PetscCall(PetscViewerASCIIPrintf(viewer, " Aggregating the process interior first\n"));
+  if (agg->max_rounds > 0) PetscCall(PetscViewerASCIIPrintf(viewer, " At most %" PetscInt_FMT " rounds of ghost exchanges\n", agg->max_rounds));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -380,6 +382,8 @@ PetscErrorCode MatCoarsenSetFromOptions(MatCoarsen coarser)
   PetscCall(PetscOptionsInt("-mat_coarsen_threshold", "Threshold (for HEM)", "MatCoarsenSetThreshold", coarser->max_it, &coarser->max_it, NULL));
   coarser->strength_index_size = MAT_COARSEN_STRENGTH_INDEX_SIZE;
   PetscCall(PetscOptionsIntArray("-mat_coarsen_strength_index", "Array of indices to use strength of connection measure (default is all indices)", "MatCoarsenSetStrengthIndex", coarser->strength_index, &coarser->strength_index_size, NULL));
+  PetscCall(PetscOptionsBool("-mat_coarsen_local_first", "Aggregate the process interior first, then resolve the process boundary (for MIS and MISK)", "MatCoarsenSetLocalFirst", coarser->local_first, &coarser->local_first, NULL));
+  PetscCall(PetscOptionsInt("-mat_coarsen_max_rounds", "Maximum number of rounds of ghost exchanges, 0 for no bound (for MIS and MISK)", "MatCoarsenSetMaximumRounds", coarser->max_rounds, &coarser->max_rounds, NULL));
   /*
    Set the type if it was never set.
    */
@@ -425,6 +429,74 @@ static PetscErrorCode MatCoarsenSetMaximumIterations_MATCOARSEN(MatCoarsen coars
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  MatCoarsenSetLocalFirst - Aggregate the vertices that have no neighbors on other processes first, without communication,
+  and then resolve only the vertices on the process boundary, for `MATCOARSENMIS` and `MATCOARSENMISK`
+
+  Logically Collective
+
+  Input Parameters:
++ coarse - the coarsen context
+- flg    - `PETSC_TRUE` to aggregate the interior first
+
+  Options Database Key:
+. -mat_coarsen_local_first <bool> - aggregate the process interior first
+
+  Level: intermediate
+
+  Notes:
+  By default a vertex on the process boundary waits for its undecided neighbors on processes of higher rank, which can
+  create chains of dependencies across many processes and many rounds of ghost exchanges. With this option a boundary vertex
+  only waits for its undecided neighbors with a higher pseudo-random priority, a hash of their global index, so the number
+  of rounds grows with the logarithm of the boundary size instead of with the number of processes.
+
+  The number of rounds can further be bounded with `MatCoarsenSetMaximumRounds()`.
+
+  When the coarsening is used inside `PCGAMG` then the options database keys are prefixed with `-pc_gamg_`
+
+.seealso: `MatCoarsen`, `MatCoarsenSetMaximumRounds()`, `MATCOARSENMIS`, `MATCOARSENMISK`, `MatCoarsenSetFromOptions()`
+@*/
+PetscErrorCode MatCoarsenSetLocalFirst(MatCoarsen coarse, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse, MAT_COARSEN_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(coarse, flg, 2);
+  coarse->local_first = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  MatCoarsenSetMaximumRounds - Bound the number of rounds of ghost exchanges of `MATCOARSENMIS` and `MATCOARSENMISK`
+
+  Logically Collective
+
+  Input Parameters:
++ coarse - the coarsen context
+- n      - maximum number of rounds, 0 for no bound
+
+  Options Database Key:
+. -mat_coarsen_max_rounds <n> - maximum number of rounds
+
+  Level: intermediate
+
+  Notes:
+  Once `n` rounds are done, the vertices that are still undecided are selected, or aggregated with a local selected neighbor,
+  without further communication. The aggregates remain a valid partition of the vertices, but two selected vertices
+  on different processes may then be neighbors.
+
+  When the coarsening is used inside `PCGAMG` then the options database keys are prefixed with `-pc_gamg_`
+
+.seealso: `MatCoarsen`, `MatCoarsenSetLocalFirst()`, `MATCOARSENMIS`, `MATCOARSENMISK`, `MatCoarsenSetFromOptions()`
+@*/
+PetscErrorCode MatCoarsenSetMaximumRounds(MatCoarsen coarse, PetscInt n)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse, MAT_COARSEN_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(coarse, n, 2);
+  coarse->max_rounds = n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   MatCoarsenSetStrengthIndex -  Index array to use for index to use for strength of connection
 
@@ -76,6 +76,7 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpisell_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatSetPreallocationCOO_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatSetValuesCOO_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatResidualJacobiUpdate_C", NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1043,6 +1044,70 @@ static PetscErrorCode MatMult_MPIAIJ(Mat A, Vec xx, Vec yy)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatResidualJacobiUpdate_MPIAIJ - Computes y = alpha w + beta x + gamma D (b - A x) in one pass over the rows of the diagonal
+   block, during the communication of the ghost values of x, and one pass over the nonzero rows of the off-diagonal block
+*/
+static PetscErrorCode MatResidualJacobiUpdate_MPIAIJ(Mat A, Vec d, PetscScalar alpha, PetscScalar beta, PetscScalar gamma, Vec b, Vec w, Vec x, Vec y)
+{
+  Mat_MPIAIJ        *mat = (Mat_MPIAIJ *)A->data;
+  Mat_SeqAIJ        *ad  = (Mat_SeqAIJ *)mat->A->data, *bd = (Mat_SeqAIJ *)mat->B->data;
+  const PetscInt     m    = A->rmap->n, *ai = ad->i, *bi = bd->i, *ridx = bd->compressedrow.use ? bd->compressedrow.rindex : NULL;
+  const PetscInt     nb   = bd->compressedrow.use ? bd->compressedrow.nrows : m;
+  const PetscScalar *xa, *ba, *da, *wa = NULL, *la;
+  const MatScalar   *a_a, *b_a;
+  PetscScalar       *ya;
+
+  PetscFunctionBegin;
+  PetscCall(VecScatterBegin(mat->Mvctx, x, mat->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCall(MatSeqAIJGetArrayRead(mat->A, &a_a));
+  PetscCall(VecGetArrayRead(d, &da));
+  PetscCall(VecGetArrayRead(b, &ba));
+  PetscCall(VecGetArrayRead(x, &xa));
+  if (alpha != 0.0) PetscCall(VecGetArrayRead(w, &wa));
+  PetscCall(VecGetArrayWrite(y, &ya));
+  /* rows without off-process columns are finished, the others keep their partial residual in y */
+  PetscPragmaUseOMPKernels(parallel for)
+  for (PetscInt i = 0; i < m; i++) {
+    PetscInt           n   = ai[i + 1] - ai[i];
+    const PetscInt    *aj  = ad->j + ai[i];
+    const PetscScalar *aa  = a_a + ai[i];
+    PetscScalar        sum = ba[i];
+
+    PetscSparseDenseMinusDot(sum, xa, aa, aj, n);
+    if (bi[i + 1] > bi[i]) ya[i] = sum;
+    else {
+      ya[i] = beta * xa[i] + gamma * da[i] * sum;
+      if (wa) ya[i] += alpha * wa[i];
+    }
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(mat->A, &a_a));
+  PetscCall(VecScatterEnd(mat->Mvctx, x, mat->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCall(MatSeqAIJGetArrayRead(mat->B, &b_a));
+  PetscCall(VecGetArrayRead(mat->lvec, &la));
+  PetscPragmaUseOMPKernels(parallel for)
+  for (PetscInt k = 0; k < nb; k++) {
+    PetscInt           i   = ridx ? ridx[k] : k, n = bi[i + 1] - bi[i];
+    const PetscInt    *bj  = bd->j + bi[i];
+    const PetscScalar *bb  = b_a + bi[i];
+    PetscScalar        sum = ya[i];
+
+    if (!n) continue;
+    PetscSparseDenseMinusDot(sum, la, bb, bj, n);
+    ya[i] = beta * xa[i] + gamma * da[i] * sum;
+    if (wa) ya[i] += alpha * wa[i];
+  }
+  PetscCall(PetscLogFlops(2.0 * (ad->nz + bd->nz) + 6.0 * m));
+  PetscCall(VecRestoreArrayRead(mat->lvec, &la));
+  PetscCall(MatSeqAIJRestoreArrayRead(mat->B, &b_a));
+  PetscCall(VecRestoreArrayWrite(y, &ya));
+  if (alpha != 0.0) PetscCall(VecRestoreArrayRead(w, &wa));
+  PetscCall(VecRestoreArrayRead(x, &xa));
+  PetscCall(VecRestoreArrayRead(b, &ba));
+  PetscCall(VecRestoreArrayRead(d, &da));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatMultDiagonalBlock_MPIAIJ(Mat A, Vec bb, Vec xx)
 {
   Mat_MPIAIJ *a = (Mat_MPIAIJ *)A->data;
@@ -5800,6 +5865,63 @@ PetscErrorCode MatGetBrowsOfAcols(Mat A, Mat B, MatReuse scall, IS *rowb, IS *co
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* sends the values of the rows of B needed by the other processes, and posts the receives of those needed by this one into b_otha[] */
+static PetscErrorCode MatGetBrowsOfAoColsValuesBegin_Private(Mat A, Mat B, const PetscInt *sstartsj, const PetscInt *rstartsj, MatScalar *bufa, PetscScalar *b_otha, PetscMPIInt *nreqs, MPI_Request **reqs)
+{
+  Mat_MPIAIJ        *a   = (Mat_MPIAIJ *)A->data;
+  VecScatter         ctx = a->Mvctx;
+  MPI_Comm           comm;
+  const PetscMPIInt *rprocs, *sprocs;
+  const PetscInt    *srow, *rstarts, *sstarts;
+  PetscScalar       *vals;
+  PetscInt           nrecvs, nsends, sbs, rbs, k = 0, ncols;
+  PetscMPIInt        tag = ((PetscObject)ctx)->tag, rank;
+  MPI_Request       *rwaits, *swaits;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)A, &comm));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCall(VecScatterGetRemote_Private(ctx, PETSC_TRUE /*send*/, &nsends, &sstarts, &srow, &sprocs, &sbs));
+  PetscCall(VecScatterGetRemoteOrdered_Private(ctx, PETSC_FALSE /*recv*/, &nrecvs, &rstarts, NULL /*indices not needed*/, &rprocs, &rbs));
+  PetscCall(PetscMPIIntCast(nsends + nrecvs, nreqs));
+  PetscCall(PetscMalloc1(*nreqs, reqs));
+  rwaits = *reqs;
+  swaits = PetscSafePointerPlusOffset(*reqs, nrecvs);
+
+  /*  post receives of a-array */
+  for (PetscInt i = 0; i < nrecvs; i++) PetscCallMPI(MPI_Irecv(b_otha + rstartsj[i], rstartsj[i + 1] - rstartsj[i], MPIU_SCALAR, rprocs[i], tag, comm, rwaits + i));
+
+  /* pack the outgoing message a-array */
+  if (nsends) k = sstarts[0];
+  for (PetscInt i = 0; i < nsends; i++) {
+    PetscScalar *bufA = bufa + sstartsj[i];
+
+    for (PetscInt j = 0; j < sstarts[i + 1] - sstarts[i]; j++) {
+      PetscInt row = srow[k++] + B->rmap->range[rank]; /* global row idx */
+
+      for (PetscInt ll = 0; ll < sbs; ll++) {
+        PetscCall(MatGetRow_MPIAIJ(B, row + ll, &ncols, NULL, &vals));
+        for (PetscInt l = 0; l < ncols; l++) *bufA++ = vals[l];
+        PetscCall(MatRestoreRow_MPIAIJ(B, row + ll, &ncols, NULL, &vals));
+      }
+    }
+    PetscCallMPI(MPI_Isend(bufa + sstartsj[i], sstartsj[i + 1] - sstartsj[i], MPIU_SCALAR, sprocs[i], tag, comm, swaits + i));
+  }
+  PetscCall(VecScatterRestoreRemote_Private(ctx, PETSC_TRUE, &nsends, &sstarts, &srow, &sprocs, &sbs));
+  PetscCall(VecScatterRestoreRemoteOrdered_Private(ctx, PETSC_FALSE, &nrecvs, &rstarts, NULL, &rprocs, &rbs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatGetBrowsOfAoColsValuesEnd_Private(PetscMPIInt *nreqs, MPI_Request **reqs)
+{
+  PetscFunctionBegin;
+  /* recvs and sends of a-array are completed */
+  if (*nreqs) PetscCallMPI(MPI_Waitall(*nreqs, *reqs, MPI_STATUSES_IGNORE));
+  PetscCall(PetscFree(*reqs));
+  *nreqs = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
     MatGetBrowsOfAoCols_MPIAIJ - Creates a `MATSEQAIJ` matrix by taking rows of B that equal to nonzero columns
     of the OFF-DIAGONAL portion of local A
@@ -5833,7 +5955,7 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A, Mat B, MatReuse scall, PetscInt
   const PetscInt    *srow, *rstarts, *sstarts;
   PetscInt          *rowlen, *bufj, *bufJ, ncols = 0, aBn = a->B->cmap->n, row, *b_othi, *b_othj, *rvalues = NULL, *svalues = NULL, *cols, sbs, rbs;
   PetscInt           i, j, k = 0, l, ll, nrecvs, nsends, nrows, *rstartsj = NULL, *sstartsj, len;
-  PetscScalar       *b_otha, *bufa, *bufA, *vals = NULL;
+  PetscScalar       *b_otha, *bufa;
   MPI_Request       *reqs = NULL, *rwaits = NULL, *swaits = NULL;
   PetscMPIInt        size, tag, rank, nreqs;
 
@@ -5968,30 +6090,9 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A, Mat B, MatReuse scall, PetscInt
   } else SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Matrix P does not possess an object container");
 
   /* a-array */
-  /*  post receives of a-array */
-  for (i = 0; i < nrecvs; i++) {
-    nrows = rstartsj[i + 1] - rstartsj[i]; /* length of the msg received */
-    PetscCallMPI(MPI_Irecv(b_otha + rstartsj[i], nrows, MPIU_SCALAR, rprocs[i], tag, comm, rwaits + i));
-  }
-
-  /* pack the outgoing message a-array */
-  if (nsends) k = sstarts[0];
-  for (i = 0; i < nsends; i++) {
-    nrows = sstarts[i + 1] - sstarts[i]; /* num of block rows */
-    bufA  = bufa + sstartsj[i];
-    for (j = 0; j < nrows; j++) {
-      row = srow[k++] + B->rmap->range[rank]; /* global row idx */
-      for (ll = 0; ll < sbs; ll++) {
-        PetscCall(MatGetRow_MPIAIJ(B, row + ll, &ncols, NULL, &vals));
-        for (l = 0; l < ncols; l++) *bufA++ = vals[l];
-        PetscCall(MatRestoreRow_MPIAIJ(B, row + ll, &ncols, NULL, &vals));
-      }
-    }
-    PetscCallMPI(MPI_Isend(bufa + sstartsj[i], sstartsj[i + 1] - sstartsj[i], MPIU_SCALAR, sprocs[i], tag, comm, swaits + i));
-  }
-  /* recvs and sends of a-array are completed */
-  if (nreqs) PetscCallMPI(MPI_Waitall(nreqs, reqs, MPI_STATUSES_IGNORE));
   PetscCall(PetscFree(reqs));
+  PetscCall(MatGetBrowsOfAoColsValuesBegin_Private(A, B, sstartsj, rstartsj, bufa, b_otha, &nreqs, &reqs));
+  PetscCall(MatGetBrowsOfAoColsValuesEnd_Private(&nreqs, &reqs));
 
   if (scall == MAT_INITIAL_MATRIX) {
     /* put together the new matrix */
@@ -6023,6 +6124,57 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A, Mat B, MatReuse scall, PetscInt
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+    MatGetBrowsOfAoColsBegin_MPIAIJ - Starts updating the values of a matrix obtained with `MatGetBrowsOfAoCols_MPIAIJ()`, the same as
+    `MatGetBrowsOfAoCols_MPIAIJ()` with `MAT_REUSE_MATRIX`, so that the communication can be overlapped with computations that do not need B_oth
+
+    Collective
+
+   Input Parameters:
++    A,B - the matrices in `MATMPIAIJ` format
+.    startsj_s, startsj_r, bufa - as obtained from `MatGetBrowsOfAoCols_MPIAIJ()`
+-    B_oth - the matrix obtained from `MatGetBrowsOfAoCols_MPIAIJ()`
+
+   Output Parameters:
++    b_otha - the value array of B_oth receiving the messages, to pass to `MatGetBrowsOfAoColsEnd_MPIAIJ()`
+.    nreqs - the number of pending requests
+-    reqs - the pending requests, to pass to `MatGetBrowsOfAoColsEnd_MPIAIJ()`
+
+    Level: developer
+*/
+PetscErrorCode MatGetBrowsOfAoColsBegin_MPIAIJ(Mat A, Mat B, PetscInt *startsj_s, PetscInt *startsj_r, MatScalar *bufa, Mat B_oth, PetscScalar **b_otha, PetscMPIInt *nreqs, MPI_Request **reqs)
+{
+  PetscFunctionBegin;
+  *b_otha = NULL;
+  *nreqs  = 0;
+  *reqs   = NULL;
+  if (!B_oth) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscLogEventBegin(MAT_GetBrowsOfAocols, A, B, 0, 0));
+  PetscCall(MatSeqAIJGetArrayWrite(B_oth, b_otha));
+  PetscCall(MatGetBrowsOfAoColsValuesBegin_Private(A, B, startsj_s, startsj_r, bufa, *b_otha, nreqs, reqs));
+  PetscCall(PetscLogEventEnd(MAT_GetBrowsOfAocols, A, B, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+    MatGetBrowsOfAoColsEnd_MPIAIJ - Completes the update started with `MatGetBrowsOfAoColsBegin_MPIAIJ()`, the values of B_oth can be used afterwards
+
+    Input Parameters:
++    B_oth - the matrix passed to `MatGetBrowsOfAoColsBegin_MPIAIJ()`
+.    b_otha - the value array obtained from `MatGetBrowsOfAoColsBegin_MPIAIJ()`, restored once the messages have arrived
+.    nreqs - the number of pending requests
+-    reqs - the pending requests
+
+    Level: developer
+*/
+PetscErrorCode MatGetBrowsOfAoColsEnd_MPIAIJ(Mat B_oth, PetscScalar **b_otha, PetscMPIInt *nreqs, MPI_Request **reqs)
+{
+  PetscFunctionBegin;
+  PetscCall(MatGetBrowsOfAoColsValuesEnd_Private(nreqs, reqs));
+  if (B_oth) PetscCall(MatSeqAIJRestoreArrayWrite(B_oth, b_otha));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJPERM(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSELL(Mat, MatType, MatReuse, Mat *);
@@ -6926,6 +7078,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatProductSetFromOptions_mpiaij_mpiaij_C", MatProductSetFromOptions_MPIAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetPreallocationCOO_C", MatSetPreallocationCOO_MPIAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetValuesCOO_C", MatSetValuesCOO_MPIAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatResidualJacobiUpdate_C", MatResidualJacobiUpdate_MPIAIJ));
   PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATMPIAIJ));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
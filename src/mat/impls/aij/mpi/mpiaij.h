@@ -156,6 +156,8 @@ PETSC_INTERN PetscErrorCode MatDestroy_MPIAIJ_PtAP(void *);
 PETSC_INTERN PetscErrorCode MatDestroy_MPIAIJ_MatMatMult(void *);
 
 PETSC_INTERN PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat, Mat, MatReuse, PetscInt **, PetscInt **, MatScalar **, Mat *);
+PETSC_INTERN PetscErrorCode MatGetBrowsOfAoColsBegin_MPIAIJ(Mat, Mat, PetscInt *, PetscInt *, MatScalar *, Mat, PetscScalar **, PetscMPIInt *, MPI_Request **);
+PETSC_INTERN PetscErrorCode MatGetBrowsOfAoColsEnd_MPIAIJ(Mat, PetscScalar **, PetscMPIInt *, MPI_Request **);
 PETSC_INTERN PetscErrorCode MatSetValues_MPIAIJ(Mat, PetscInt, const PetscInt[], PetscInt, const PetscInt[], const PetscScalar[], InsertMode);
 PETSC_INTERN PetscErrorCode MatSetValues_MPIAIJ_CopyFromCSRFormat(Mat, const PetscInt[], const PetscInt[], const PetscScalar[]);
 PETSC_INTERN PetscErrorCode MatSetValues_MPIAIJ_CopyFromCSRFormat_Symbolic(Mat, const PetscInt[], const PetscInt[]);
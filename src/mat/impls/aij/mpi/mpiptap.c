@@ -101,9 +101,11 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_scalable(Mat A, Mat P, Mat C)
   Mat_APMPI         *ptap;
   Mat                AP_loc, C_loc, C_oth;
   PetscInt           i, rstart, rend, cm, ncols, row, *api, *apj, am = A->rmap->n, apnz, nout;
-  PetscScalar       *apa;
+  PetscScalar       *apa, *p_otha = NULL;
   const PetscInt    *cols;
   const PetscScalar *vals;
+  PetscMPIInt        nreqs = 0;
+  MPI_Request       *reqs  = NULL;
 
   PetscFunctionBegin;
   MatCheckProduct(C, 3);
@@ -113,6 +115,9 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_scalable(Mat A, Mat P, Mat C)
 
   PetscCall(MatZeroEntries(C));
 
+  /* 0) start updating the values of P_oth, overlapped with the computations that only involve local rows of P */
+  if (ptap->reuse == MAT_REUSE_MATRIX) PetscCall(MatGetBrowsOfAoColsBegin_MPIAIJ(A, P, ptap->startsj_s, ptap->startsj_r, ptap->bufa, ptap->P_oth, &p_otha, &nreqs, &reqs));
+
   /* 1) get R = Pd^T,Ro = Po^T */
   if (ptap->reuse == MAT_REUSE_MATRIX) {
     PetscCall(MatTranspose(p->A, MAT_REUSE_MATRIX, &ptap->Rd));
@@ -124,11 +129,8 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_scalable(Mat A, Mat P, Mat C)
   ap     = (Mat_SeqAIJ *)AP_loc->data;
 
   /* 2-1) get P_oth = ptap->P_oth  and P_loc = ptap->P_loc */
-  if (ptap->reuse == MAT_REUSE_MATRIX) {
-    /* P_oth and P_loc are obtained in MatPtASymbolic() when reuse == MAT_INITIAL_MATRIX */
-    PetscCall(MatGetBrowsOfAoCols_MPIAIJ(A, P, MAT_REUSE_MATRIX, &ptap->startsj_s, &ptap->startsj_r, &ptap->bufa, &ptap->P_oth));
-    PetscCall(MatMPIAIJGetLocalMat(P, MAT_REUSE_MATRIX, &ptap->P_loc));
-  }
+  /* P_oth and P_loc are obtained in MatPtASymbolic() when reuse == MAT_INITIAL_MATRIX */
+  if (ptap->reuse == MAT_REUSE_MATRIX) PetscCall(MatMPIAIJGetLocalMat(P, MAT_REUSE_MATRIX, &ptap->P_loc));
 
   /* 2-2) compute numeric A_loc*P - dominating part */
   /* get data from symbolic products */
@@ -138,12 +140,17 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_scalable(Mat A, Mat P, Mat C)
   api = ap->i;
   apj = ap->j;
   PetscCall(ISLocalToGlobalMappingApply(ptap->ltog, api[AP_loc->rmap->n], apj, apj));
-  for (i = 0; i < am; i++) {
-    /* AP[i,:] = A[i,:]*P = Ad*P_loc Ao*P_oth */
-    apnz = api[i + 1] - api[i];
-    apa  = ap->a + api[i];
-    PetscCall(PetscArrayzero(apa, apnz));
-    AProw_scalable(i, ad, ao, p_loc, p_oth, api, apj, apa);
+  /* the rows without off-process entries first, then the others once the values of P_oth have arrived */
+  for (PetscInt pass = 0; pass < 2; pass++) {
+    if (pass && ptap->reuse == MAT_REUSE_MATRIX) PetscCall(MatGetBrowsOfAoColsEnd_MPIAIJ(ptap->P_oth, &p_otha, &nreqs, &reqs));
+    for (i = 0; i < am; i++) {
+      if ((ao->i[i + 1] > ao->i[i]) != pass) continue;
+      /* AP[i,:] = A[i,:]*P = Ad*P_loc Ao*P_oth */
+      apnz = api[i + 1] - api[i];
+      apa  = ap->a + api[i];
+      PetscCall(PetscArrayzero(apa, apnz));
+      AProw_scalable(i, ad, ao, p_loc, p_oth, api, apj, apa);
+    }
   }
   PetscCall(ISGlobalToLocalMappingApply(ptap->ltog, IS_GTOLM_DROP, api[AP_loc->rmap->n], apj, &nout, apj));
   PetscCheck(api[AP_loc->rmap->n] == nout, PETSC_COMM_SELF, PETSC_ERR_ARG_INCOMP, "Incorrect mapping %" PetscInt_FMT " != %" PetscInt_FMT, api[AP_loc->rmap->n], nout);
@@ -1863,9 +1870,11 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat A, Mat P, Mat C)
   Mat                AP_loc, C_loc, C_oth;
   PetscInt           i, rstart, rend, cm, ncols, row;
   PetscInt          *api, *apj, am = A->rmap->n, j, col, apnz;
-  PetscScalar       *apa;
+  PetscScalar       *apa, *p_otha = NULL;
   const PetscInt    *cols;
   const PetscScalar *vals;
+  PetscMPIInt        nreqs = 0;
+  MPI_Request       *reqs  = NULL;
 
   PetscFunctionBegin;
   MatCheckProduct(C, 3);
@@ -1874,6 +1883,9 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat A, Mat P, Mat C)
   PetscCheck(ptap->AP_loc, PetscObjectComm((PetscObject)C), PETSC_ERR_ARG_WRONGSTATE, "PtAP cannot be reused. Do not call MatProductClear()");
 
   PetscCall(MatZeroEntries(C));
+  /* 0) start updating the values of P_oth, overlapped with the computations that only involve local rows of P */
+  if (ptap->reuse == MAT_REUSE_MATRIX) PetscCall(MatGetBrowsOfAoColsBegin_MPIAIJ(A, P, ptap->startsj_s, ptap->startsj_r, ptap->bufa, ptap->P_oth, &p_otha, &nreqs, &reqs));
+
   /* 1) get R = Pd^T,Ro = Po^T */
   if (ptap->reuse == MAT_REUSE_MATRIX) {
     PetscCall(MatTranspose(p->A, MAT_REUSE_MATRIX, &ptap->Rd));
@@ -1885,11 +1897,8 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat A, Mat P, Mat C)
   ap     = (Mat_SeqAIJ *)AP_loc->data;
 
   /* 2-1) get P_oth = ptap->P_oth  and P_loc = ptap->P_loc */
-  if (ptap->reuse == MAT_REUSE_MATRIX) {
-    /* P_oth and P_loc are obtained in MatPtASymbolic() when reuse == MAT_INITIAL_MATRIX */
-    PetscCall(MatGetBrowsOfAoCols_MPIAIJ(A, P, MAT_REUSE_MATRIX, &ptap->startsj_s, &ptap->startsj_r, &ptap->bufa, &ptap->P_oth));
-    PetscCall(MatMPIAIJGetLocalMat(P, MAT_REUSE_MATRIX, &ptap->P_loc));
-  }
+  /* P_oth and P_loc are obtained in MatPtASymbolic() when reuse == MAT_INITIAL_MATRIX */
+  if (ptap->reuse == MAT_REUSE_MATRIX) PetscCall(MatMPIAIJGetLocalMat(P, MAT_REUSE_MATRIX, &ptap->P_loc));
 
   /* 2-2) compute numeric A_loc*P - dominating part */
   /* get data from symbolic products */
@@ -1898,14 +1907,19 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat A, Mat P, Mat C)
   apa = ptap->apa;
   api = ap->i;
   apj = ap->j;
-  for (i = 0; i < am; i++) {
-    /* AP[i,:] = A[i,:]*P = Ad*P_loc Ao*P_oth */
-    AProw_nonscalable(i, ad, ao, p_loc, p_oth, apa);
-    apnz = api[i + 1] - api[i];
-    for (j = 0; j < apnz; j++) {
-      col                 = apj[j + api[i]];
-      ap->a[j + ap->i[i]] = apa[col];
-      apa[col]            = 0.0;
+  /* the rows without off-process entries first, then the others once the values of P_oth have arrived */
+  for (PetscInt pass = 0; pass < 2; pass++) {
+    if (pass && ptap->reuse == MAT_REUSE_MATRIX) PetscCall(MatGetBrowsOfAoColsEnd_MPIAIJ(ptap->P_oth, &p_otha, &nreqs, &reqs));
+    for (i = 0; i < am; i++) {
+      if ((ao->i[i + 1] > ao->i[i]) != pass) continue;
+      /* AP[i,:] = A[i,:]*P = Ad*P_loc Ao*P_oth */
+      AProw_nonscalable(i, ad, ao, p_loc, p_oth, apa);
+      apnz = api[i + 1] - api[i];
+      for (j = 0; j < apnz; j++) {
+        col                 = apj[j + api[i]];
+        ap->a[j + ap->i[i]] = apa[col];
+        apa[col]            = 0.0;
+      }
     }
   }
   /* We have modified the contents of local matrix AP_loc and must increase its ObjectState, since we are not doing AssemblyBegin/End on it. */
@@ -1226,6 +1226,8 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscFree(a->saved_values));
   PetscCall(PetscFree2(a->compressedrow.i, a->compressedrow.rindex));
   PetscCall(MatDestroy_SeqAIJ_Inode(A));
+  PetscCall(MatSeqAIJLevelsDestroy(A));
+  PetscCall(MatSeqAIJRefactorDestroy(A));
   PetscCall(PetscFree(A->data));
 
   /* MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted may allocate this.
@@ -1287,6 +1289,7 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatSeqAIJKron_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatSetPreallocationCOO_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatSetValuesCOO_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatResidualJacobiUpdate_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatFactorGetSolverType_C", NULL));
   /* these calls do not belong here: the subclasses Duplicate/Destroy are wrong */
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijsell_seqaij_C", NULL));
@@ -1515,6 +1518,49 @@ PetscErrorCode MatMult_SeqAIJ(Mat A, Vec xx, Vec yy)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatResidualJacobiUpdate_SeqAIJ - Computes y = alpha w + beta x + gamma D (b - A x), with D a diagonal matrix stored as a vector,
+   in one pass over the rows of A. This is the step of the Chebyshev smoother with Jacobi preconditioning, see KSPCHEBYSHEV.
+
+   Notes:
+   w is not referenced if alpha is zero. y cannot be x or w.
+*/
+static PetscErrorCode MatResidualJacobiUpdate_SeqAIJ(Mat A, Vec d, PetscScalar alpha, PetscScalar beta, PetscScalar gamma, Vec b, Vec w, Vec x, Vec y)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ *)A->data;
+  const PetscInt     m  = A->rmap->n, *ai = a->i;
+  const PetscScalar *xa, *ba, *da, *wa = NULL;
+  const MatScalar   *a_a;
+  PetscScalar       *ya;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(d, &da));
+  PetscCall(VecGetArrayRead(b, &ba));
+  PetscCall(VecGetArrayRead(x, &xa));
+  if (alpha != 0.0) PetscCall(VecGetArrayRead(w, &wa));
+  PetscCall(VecGetArrayWrite(y, &ya));
+  PetscPragmaUseOMPKernels(parallel for)
+  for (PetscInt i = 0; i < m; i++) {
+    PetscInt           n   = ai[i + 1] - ai[i];
+    const PetscInt    *aj  = a->j + ai[i];
+    const PetscScalar *aa  = a_a + ai[i];
+    PetscScalar        sum = ba[i];
+
+    PetscSparseDenseMinusDot(sum, xa, aa, aj, n);
+    ya[i] = beta * xa[i] + gamma * da[i] * sum;
+    if (wa) ya[i] += alpha * wa[i];
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz + 6.0 * m));
+  PetscCall(VecRestoreArrayWrite(y, &ya));
+  if (alpha != 0.0) PetscCall(VecRestoreArrayRead(w, &wa));
+  PetscCall(VecRestoreArrayRead(x, &xa));
+  PetscCall(VecRestoreArrayRead(b, &ba));
+  PetscCall(VecRestoreArrayRead(d, &da));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 // HACK!!!!! Used by src/mat/tests/ex170.c
 PETSC_EXTERN PetscErrorCode MatMultMax_SeqAIJ(Mat A, Vec xx, Vec yy)
 {
@@ -4944,6 +4990,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSeqAIJKron_C", MatSeqAIJKron_SeqAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetPreallocationCOO_C", MatSetPreallocationCOO_SeqAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetValuesCOO_C", MatSetValuesCOO_SeqAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatResidualJacobiUpdate_C", MatResidualJacobiUpdate_SeqAIJ));
   PetscCall(MatCreate_SeqAIJ_Inode(B));
   PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
   PetscCall(MatSeqAIJSetTypeFromOptions(B)); /* this allows changing the matrix subtype to say MATSEQAIJPERM */
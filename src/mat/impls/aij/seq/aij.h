@@ -133,6 +133,42 @@ typedef struct {
   PetscObjectState mat_nonzerostate; /* non-zero state when inodes were checked for */
 } Mat_SeqAIJ_Inode;
 
+/* Level schedule of the triangular factors of a factored SeqAIJ matrix, helper class for MatSolve() */
+typedef struct {
+  PetscBool  use;                /* use level-scheduled triangular solves */
+  PetscBool  reorder;            /* store a copy of the factors in level order */
+  PetscBool  setup;              /* the level sets are valid for the current symbolic factorization */
+  PetscInt   nlevelsL, nlevelsU; /* number of levels of L and U */
+  PetscInt  *ptrL, *ptrU;        /* the rows of level k of L are rowsL[ptrL[k]] to rowsL[ptrL[k + 1] - 1] */
+  PetscInt  *rowsL, *rowsU;
+  PetscInt  *iL, *jL, *iU, *jU;  /* with reorder, row k of the copies holds row rowsL[k] (rowsU[k]) of L (U) */
+  MatScalar *aL, *aU;
+} Mat_SeqAIJ_Levels;
+
+PETSC_INTERN PetscErrorCode MatSeqAIJLevelsReset_Factor(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJLevelsSetUp_Factor(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJLevelsDestroy(Mat);
+
+/* Precomputed maps of the numeric LU and ILU factorizations of a factored SeqAIJ matrix, helper class for MatLUFactorNumeric() */
+typedef struct {
+  PetscBool        use;          /* reuse the maps across numeric factorizations with the same nonzero pattern */
+  PetscReal        maxratio;     /* largest size of the update map, relative to the number of nonzeros of the factors */
+  PetscBool        setup;        /* the maps are valid for the current symbolic factorization */
+  PetscObjectState nonzerostate; /* of the matrix the maps were computed for */
+  PetscInt        *amap;         /* position in the factor of each nonzero of the matrix */
+  PetscCount      *uptr;         /* the updates by entry k of L are upd[uptr[k]] to upd[uptr[k + 1] - 1] */
+  PetscInt        *upd;          /* positions in the factor updated by the entries of the rows of U, in the order of the elimination */
+  PetscInt        *usrc;         /* with dropped updates, the entry of the row of U for each update, otherwise NULL */
+  PetscCount       nupd, ndrop;  /* numbers of kept and dropped updates */
+} Mat_SeqAIJ_Refactor;
+
+PETSC_INTERN PetscErrorCode MatSeqAIJRefactorReset_Factor(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJRefactorSetUp_Factor(Mat, Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJRefactorDestroy(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJSupernodalUse_Factor(Mat, PetscBool *);
+PETSC_INTERN PetscErrorCode MatLUFactorSymbolic_SeqAIJ_Supernodal(Mat, Mat, IS, IS, const MatFactorInfo *);
+PETSC_INTERN PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ_Supernodal(Mat, Mat, IS, const MatFactorInfo *);
+
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat, PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat, MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
@@ -146,8 +182,10 @@ PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat, PetscScalar **);
 
 typedef struct {
   SEQAIJHEADER(MatScalar);
-  Mat_SeqAIJ_Inode inode;
-  MatScalar       *saved_values; /* location for stashing nonzero values of matrix */
+  Mat_SeqAIJ_Inode    inode;
+  Mat_SeqAIJ_Levels   levels;       /* level schedule for MatSolve() of factored matrices */
+  Mat_SeqAIJ_Refactor refactor;     /* precomputed maps for MatLUFactorNumeric() of factored matrices */
+  MatScalar          *saved_values; /* location for stashing nonzero values of matrix */
 
   PetscScalar *idiag, *mdiag, *ssor_work; /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
   PetscBool    idiagvalid;                /* current idiag[] and mdiag[] are valid */
@@ -379,6 +417,7 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat, Mat, Pets
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat, Mat, PetscReal, Mat);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threaded(Mat, Mat, PetscReal, Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat, Mat, PetscReal, Mat);
 #endif
@@ -390,6 +429,7 @@ PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat, Mat, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat, Mat, Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat, Mat, PetscReal, Mat);
+PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_Threaded(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ(Mat, Mat, Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_SparseAxpy(Mat, Mat, Mat);
 
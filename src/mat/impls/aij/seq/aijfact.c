@@ -297,12 +297,21 @@ PetscErrorCode MatLUFactorSymbolic_SeqAIJ(Mat B, Mat A, IS isrow, IS iscol, cons
   PetscInt           nlnk, *lnk, k, **bi_ptr;
   PetscFreeSpaceList free_space = NULL, current_space = NULL;
   PetscBT            lnkbt;
-  PetscBool          missing;
+  PetscBool          missing, supernodal, symmetric;
 
   PetscFunctionBegin;
   PetscCheck(A->rmap->N == A->cmap->N, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "matrix must be square");
   PetscCall(MatMissingDiagonal(A, &missing, &i));
   PetscCheck(!missing, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Matrix is missing diagonal entry %" PetscInt_FMT, i);
+  PetscCall(MatSeqAIJSupernodalUse_Factor(B, &supernodal));
+  if (supernodal) {
+    PetscCall(ISEqual(isrow, iscol, &symmetric));
+    if (symmetric) {
+      PetscCall(MatLUFactorSymbolic_SeqAIJ_Supernodal(B, A, isrow, iscol, info));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    PetscCall(PetscInfo(A, "Supernodal LU requires the same row and column orderings, using the standard factorization\n"));
+  }
 
   PetscCall(ISInvertPermutation(iscol, PETSC_DECIDE, &isicol));
   PetscCall(ISGetIndices(isrow, &r));
@@ -425,6 +434,8 @@ PetscErrorCode MatLUFactorSymbolic_SeqAIJ(Mat B, Mat A, IS isrow, IS iscol, cons
   B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ;
   if (a->inode.size) B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
   PetscCall(MatSeqAIJCheckInode_FactorLU(B));
+  PetscCall(MatSeqAIJLevelsReset_Factor(B));
+  PetscCall(MatSeqAIJRefactorReset_Factor(B));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -465,8 +476,17 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info
   const PetscInt  *ddiag;
   PetscReal        rs;
   MatScalar        d;
+  const PetscInt  *amap = NULL, *upd = NULL, *usrc = NULL;
+  const PetscCount *uptr = NULL;
 
   PetscFunctionBegin;
+  PetscCall(MatSeqAIJRefactorSetUp_Factor(B, A));
+  if (b->refactor.setup) {
+    amap = b->refactor.amap;
+    uptr = b->refactor.uptr;
+    upd  = b->refactor.upd;
+    usrc = b->refactor.usrc;
+  }
   /* MatPivotSetUp(): initialize shift context sctx */
   PetscCall(PetscMemzero(&sctx, sizeof(FactorShiftCtx)));
 
@@ -496,6 +516,42 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info
   do {
     sctx.newshift = PETSC_FALSE;
     for (i = 0; i < n; i++) {
+      if (amap) {
+        MatScalar *ba = b->a;
+
+        /* with the precomputed maps, load the row directly into the factor and eliminate in place */
+        for (j = bi[i]; j < bi[i + 1]; j++) ba[j] = 0.0;
+        for (j = bdiag[i + 1] + 1; j <= bdiag[i]; j++) ba[j] = 0.0;
+        for (j = ai[r[i]]; j < ai[r[i] + 1]; j++) ba[amap[j]] = aa[j];
+        ba[bdiag[i]] += sctx.shift_amount;
+
+        for (k = bi[i]; k < bi[i + 1]; k++) {
+          const PetscInt *ut = upd + uptr[k], *us = usrc ? usrc + uptr[k] : NULL;
+
+          row        = bj[k];
+          multiplier = ba[k] * ba[bdiag[row]];
+          ba[k]      = multiplier;
+          pv         = ba + bdiag[row + 1] + 1;
+          nz         = (PetscInt)(uptr[k + 1] - uptr[k]);
+          if (us) {
+            for (j = 0; j < nz; j++) ba[ut[j]] -= multiplier * pv[us[j]];
+          } else {
+            for (j = 0; j < nz; j++) ba[ut[j]] -= multiplier * pv[j];
+          }
+        }
+        PetscCall(PetscLogFlops(bi[i + 1] - bi[i] + 2.0 * (uptr[bi[i + 1]] - uptr[bi[i]])));
+
+        rs = 0.0;
+        for (j = bi[i]; j < bi[i + 1]; j++) rs += PetscAbsScalar(ba[j]);
+        for (j = bdiag[i + 1] + 1; j < bdiag[i]; j++) rs += PetscAbsScalar(ba[j]);
+        sctx.rs = rs;
+        sctx.pv = ba[bdiag[i]];
+        PetscCall(MatPivotCheck(B, A, info, &sctx, i));
+        if (sctx.newshift) break;
+        ba[bdiag[i]] = 1.0 / sctx.pv;
+        continue;
+      }
+
       /* zero rtmp */
       /* L part */
       nz    = bi[i + 1] - bi[i];
@@ -595,6 +651,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info
   } else {
     C->ops->solve = MatSolve_SeqAIJ;
   }
+  PetscCall(MatSeqAIJLevelsSetUp_Factor(C));
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
@@ -1705,6 +1762,8 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ilu0(Mat fact, Mat A, IS isrow, IS is
   fact->info.fill_ratio_needed = 1.0;
   fact->ops->lufactornumeric   = MatLUFactorNumeric_SeqAIJ;
   PetscCall(MatSeqAIJCheckInode_FactorLU(fact));
+  PetscCall(MatSeqAIJLevelsReset_Factor(fact));
+  PetscCall(MatSeqAIJRefactorReset_Factor(fact));
 
   b       = (Mat_SeqAIJ *)(fact)->data;
   b->row  = isrow;
@@ -1877,6 +1936,8 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS isrow, IS iscol,
   (fact)->ops->lufactornumeric   = MatLUFactorNumeric_SeqAIJ;
   if (a->inode.size) (fact)->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
   PetscCall(MatSeqAIJCheckInode_FactorLU(fact));
+  PetscCall(MatSeqAIJLevelsReset_Factor(fact));
+  PetscCall(MatSeqAIJRefactorReset_Factor(fact));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -2812,7 +2873,7 @@ PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS perm, const
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
   Mat_SeqSBAIJ      *b;
-  PetscBool          perm_identity, missing;
+  PetscBool          perm_identity, missing, supernodal;
   PetscReal          fill = info->fill;
   const PetscInt    *rip, *riip;
   PetscInt           i, am = A->rmap->n, *ai = a->i, *aj = a->j, reallocs = 0, prow;
@@ -2826,6 +2887,15 @@ PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS perm, const
   PetscCheck(A->rmap->n == A->cmap->n, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Must be square matrix, rows %" PetscInt_FMT " columns %" PetscInt_FMT, A->rmap->n, A->cmap->n);
   PetscCall(MatMissingDiagonal(A, &missing, &i));
   PetscCheck(!missing, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Matrix is missing diagonal entry %" PetscInt_FMT, i);
+  PetscCall(MatSeqAIJSupernodalUse_Factor(fact, &supernodal));
+  if (supernodal) {
+#if !defined(PETSC_USE_COMPLEX)
+    PetscCall(MatCholeskyFactorSymbolic_SeqAIJ_Supernodal(fact, A, perm, info));
+    PetscFunctionReturn(PETSC_SUCCESS);
+#else
+    PetscCall(PetscInfo(A, "Supernodal Cholesky is not available for complex scalars, using the standard factorization\n"));
+#endif
+  }
 
   /* check whether perm is the identity mapping */
   PetscCall(ISIdentity(perm, &perm_identity));
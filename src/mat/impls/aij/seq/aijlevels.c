@@ -0,0 +1,200 @@
+/*
+  Level-scheduled triangular solves for LU and ILU factors of SeqAIJ matrices.
+
+  The rows of L (and of U) are partitioned into level sets: a row belongs to level k if the longest chain of rows it depends upon
+  in the triangular solve has length k. All rows of a level can be eliminated concurrently once the previous levels are done, so
+  the solve is threaded over the rows of each level when PETSc is configured with --with-openmp-kernels.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+PetscErrorCode MatSeqAIJLevelsDestroy(Mat A)
+{
+  Mat_SeqAIJ_Levels *lv = &((Mat_SeqAIJ *)A->data)->levels;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree4(lv->ptrL, lv->ptrU, lv->rowsL, lv->rowsU));
+  PetscCall(PetscFree6(lv->iL, lv->jL, lv->aL, lv->iU, lv->jU, lv->aU));
+  lv->nlevelsL = 0;
+  lv->nlevelsU = 0;
+  lv->setup    = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJLevelsReset_Factor - Discards the level sets after a new symbolic factorization and reads the options
+   that control the triangular solves.
+
+   Input Parameter:
+.  B - the LU or ILU factor, after its symbolic factorization
+*/
+PetscErrorCode MatSeqAIJLevelsReset_Factor(Mat B)
+{
+  Mat_SeqAIJ_Levels *lv = &((Mat_SeqAIJ *)B->data)->levels;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJLevelsDestroy(B));
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "SeqAIJ triangular solve options", "Mat");
+  PetscCall(PetscOptionsBool("-mat_petsc_solve_levels", "Apply the triangular solves level by level", NULL, lv->use, &lv->use, NULL));
+  PetscCall(PetscOptionsBool("-mat_petsc_solve_levels_reorder", "Store a copy of the factors in level order for contiguous access", NULL, lv->reorder, &lv->reorder, NULL));
+  PetscOptionsEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Buckets the rows by level, keeping them in increasing order within each level */
+static PetscErrorCode MatSeqAIJLevelsSort_Private(PetscInt n, const PetscInt level[], PetscInt nlevels, PetscInt ptr[], PetscInt rows[])
+{
+  PetscInt i, *next;
+
+  PetscFunctionBegin;
+  PetscCall(PetscArrayzero(ptr, nlevels + 1));
+  for (i = 0; i < n; i++) ptr[level[i] + 1]++;
+  for (i = 0; i < nlevels; i++) ptr[i + 1] += ptr[i];
+  PetscCall(PetscMalloc1(nlevels, &next));
+  PetscCall(PetscArraycpy(next, ptr, nlevels));
+  for (i = 0; i < n; i++) rows[next[level[i]]++] = i;
+  PetscCall(PetscFree(next));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSeqAIJLevelsCompute_Private(Mat B)
+{
+  Mat_SeqAIJ        *b  = (Mat_SeqAIJ *)B->data;
+  Mat_SeqAIJ_Levels *lv = &b->levels;
+  const PetscInt     n = B->rmap->n, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  PetscInt           i, k, nzL = n ? bi[n] : 0, nzU = n ? bdiag[0] - bdiag[n] : 0, *levelL, *levelU;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc2(n, &levelL, n, &levelU));
+  lv->nlevelsL = 0;
+  for (i = 0; i < n; i++) {
+    PetscInt l = 0;
+
+    for (k = bi[i]; k < bi[i + 1]; k++) l = PetscMax(l, levelL[bj[k]] + 1);
+    levelL[i]    = l;
+    lv->nlevelsL = PetscMax(lv->nlevelsL, l + 1);
+  }
+  lv->nlevelsU = 0;
+  for (i = n - 1; i >= 0; i--) {
+    PetscInt l = 0;
+
+    for (k = bdiag[i + 1] + 1; k < bdiag[i]; k++) l = PetscMax(l, levelU[bj[k]] + 1);
+    levelU[i]    = l;
+    lv->nlevelsU = PetscMax(lv->nlevelsU, l + 1);
+  }
+  PetscCall(PetscMalloc4(lv->nlevelsL + 1, &lv->ptrL, lv->nlevelsU + 1, &lv->ptrU, n, &lv->rowsL, n, &lv->rowsU));
+  PetscCall(MatSeqAIJLevelsSort_Private(n, levelL, lv->nlevelsL, lv->ptrL, lv->rowsL));
+  PetscCall(MatSeqAIJLevelsSort_Private(n, levelU, lv->nlevelsU, lv->ptrU, lv->rowsU));
+  PetscCall(PetscFree2(levelL, levelU));
+
+  if (lv->reorder) {
+    PetscCall(PetscMalloc6(n + 1, &lv->iL, nzL, &lv->jL, nzL, &lv->aL, n + 1, &lv->iU, nzU, &lv->jU, nzU, &lv->aU));
+    lv->iL[0] = 0;
+    lv->iU[0] = 0;
+    for (k = 0; k < n; k++) {
+      const PetscInt rL = lv->rowsL[k], rU = lv->rowsU[k], nzu = bdiag[rU] - bdiag[rU + 1];
+
+      lv->iL[k + 1] = lv->iL[k] + bi[rL + 1] - bi[rL];
+      PetscCall(PetscArraycpy(lv->jL + lv->iL[k], bj + bi[rL], bi[rL + 1] - bi[rL]));
+      /* the off-diagonal entries of the row of U followed by the inverse of its diagonal, as in the factor */
+      lv->iU[k + 1] = lv->iU[k] + nzu;
+      PetscCall(PetscArraycpy(lv->jU + lv->iU[k], bj + bdiag[rU + 1] + 1, nzu));
+    }
+  }
+  lv->setup = PETSC_TRUE;
+  PetscCall(PetscInfo(B, "Level scheduled triangular solves: %" PetscInt_FMT " levels for L and %" PetscInt_FMT " levels for U, %g and %g rows per level on average\n", lv->nlevelsL, lv->nlevelsU, lv->nlevelsL ? (double)n / lv->nlevelsL : 0.0, lv->nlevelsU ? (double)n / lv->nlevelsU : 0.0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSolve_SeqAIJ_Levels(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqAIJ              *a  = (Mat_SeqAIJ *)A->data;
+  const Mat_SeqAIJ_Levels *lv = &a->levels;
+  const PetscInt           n = A->rmap->n, *ai = a->i, *aj = a->j, *adiag = a->diag;
+  const PetscInt          *ptrL = lv->ptrL, *ptrU = lv->ptrU, *rowsL = lv->rowsL, *rowsU = lv->rowsU;
+  const PetscInt          *iL = lv->iL, *jL = lv->jL, *iU = lv->iU, *jU = lv->jU;
+  const MatScalar         *aa = a->a, *aL = lv->aL, *aU = lv->aU;
+  const PetscInt          *r = NULL, *c = NULL;
+  const PetscBool          reorder = lv->reorder;
+  PetscBool                rident, cident;
+  PetscScalar             *x, *t;
+  const PetscScalar       *b;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  PetscCall(ISIdentity(a->row, &rident));
+  PetscCall(ISIdentity(a->col, &cident));
+  if (!rident) PetscCall(ISGetIndices(a->row, &r));
+  if (!cident) PetscCall(ISGetIndices(a->col, &c));
+  t = cident ? x : a->solve_work;
+
+  PetscPragmaUseOMPKernels(parallel)
+  {
+    /* forward solve the lower triangular, the rows of a level only depend on rows of the previous levels */
+    for (PetscInt l = 0; l < lv->nlevelsL; l++) {
+      PetscPragmaUseOMPKernels(for schedule(static))
+      for (PetscInt k = ptrL[l]; k < ptrL[l + 1]; k++) {
+        const PetscInt   i   = rowsL[k];
+        const PetscInt  *vi  = reorder ? jL + iL[k] : aj + ai[i];
+        const MatScalar *v   = reorder ? aL + iL[k] : aa + ai[i];
+        const PetscInt   nz  = reorder ? iL[k + 1] - iL[k] : ai[i + 1] - ai[i];
+        PetscScalar      sum = r ? b[r[i]] : b[i];
+
+        PetscSparseDenseMinusDot(sum, t, v, vi, nz);
+        t[i] = sum;
+      }
+    }
+    /* backward solve the upper triangular */
+    for (PetscInt l = 0; l < lv->nlevelsU; l++) {
+      PetscPragmaUseOMPKernels(for schedule(static))
+      for (PetscInt k = ptrU[l]; k < ptrU[l + 1]; k++) {
+        const PetscInt   i   = rowsU[k];
+        const PetscInt  *vi  = reorder ? jU + iU[k] : aj + adiag[i + 1] + 1;
+        const MatScalar *v   = reorder ? aU + iU[k] : aa + adiag[i + 1] + 1;
+        const PetscInt   nz  = reorder ? iU[k + 1] - iU[k] - 1 : adiag[i] - adiag[i + 1] - 1;
+        const MatScalar  d   = v[nz]; /* inverse of the diagonal entry */
+        PetscScalar      sum = t[i];
+
+        PetscSparseDenseMinusDot(sum, t, v, vi, nz);
+        t[i] = sum * d;
+        if (c) x[c[i]] = t[i];
+      }
+    }
+  }
+
+  if (r) PetscCall(ISRestoreIndices(a->row, &r));
+  if (c) PetscCall(ISRestoreIndices(a->col, &c));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(2.0 * a->nz - A->cmap->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJLevelsSetUp_Factor - After a numeric LU or ILU factorization, computes the level sets of the factors if needed,
+   refreshes the level ordered copy of the factors, and selects the level-scheduled MatSolve()
+
+   Input Parameter:
+.  B - the LU or ILU factor, after its numeric factorization
+*/
+PetscErrorCode MatSeqAIJLevelsSetUp_Factor(Mat B)
+{
+  Mat_SeqAIJ        *b  = (Mat_SeqAIJ *)B->data;
+  Mat_SeqAIJ_Levels *lv = &b->levels;
+  const PetscInt    *bi = b->i, *bdiag = b->diag;
+
+  PetscFunctionBegin;
+  if (!lv->use) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!lv->setup) PetscCall(MatSeqAIJLevelsCompute_Private(B));
+  if (lv->reorder) {
+    for (PetscInt k = 0; k < B->rmap->n; k++) {
+      const PetscInt rL = lv->rowsL[k], rU = lv->rowsU[k];
+
+      PetscCall(PetscArraycpy(lv->aL + lv->iL[k], b->a + bi[rL], bi[rL + 1] - bi[rL]));
+      PetscCall(PetscArraycpy(lv->aU + lv->iU[k], b->a + bdiag[rU + 1] + 1, bdiag[rU] - bdiag[rU + 1]));
+    }
+  }
+  B->ops->solve = MatSolve_SeqAIJ_Levels;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
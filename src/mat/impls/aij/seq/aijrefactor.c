@@ -0,0 +1,131 @@
+/*
+  Precomputed maps for the numeric LU and ILU factorizations of SeqAIJ matrices whose nonzero pattern does not change.
+
+  The map amap[] sends each nonzero of the matrix to its position in the factor, and upd[] lists, row by row and in the order of
+  the elimination, the position in the factor updated by each entry of the rows of U the row is eliminated with. A numeric
+  factorization then works directly on the values of the factor, without the dense work row and the column index lookups.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+PetscErrorCode MatSeqAIJRefactorDestroy(Mat A)
+{
+  Mat_SeqAIJ_Refactor *rf = &((Mat_SeqAIJ *)A->data)->refactor;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree2(rf->amap, rf->uptr));
+  PetscCall(PetscFree2(rf->upd, rf->usrc));
+  rf->nupd         = 0;
+  rf->ndrop        = 0;
+  rf->nonzerostate = 0;
+  rf->setup        = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJRefactorReset_Factor - Discards the maps after a new symbolic factorization and reads the options that control them
+
+   Input Parameter:
+.  B - the LU or ILU factor, after its symbolic factorization
+*/
+PetscErrorCode MatSeqAIJRefactorReset_Factor(Mat B)
+{
+  Mat_SeqAIJ_Refactor *rf = &((Mat_SeqAIJ *)B->data)->refactor;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJRefactorDestroy(B));
+  if (rf->maxratio == 0.0) rf->maxratio = 16.0;
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "SeqAIJ numeric factorization options", "Mat");
+  PetscCall(PetscOptionsBool("-mat_petsc_refactor_cache", "Precompute the maps of the numeric factorization to reuse them in refactorizations", NULL, rf->use, &rf->use, NULL));
+  PetscCall(PetscOptionsReal("-mat_petsc_refactor_cache_max_ratio", "Largest size of the cached update map relative to the nonzeros of the factors", NULL, rf->maxratio, &rf->maxratio, NULL));
+  PetscOptionsEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSeqAIJRefactorCompute_Private(Mat B, Mat A)
+{
+  Mat_SeqAIJ          *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data;
+  Mat_SeqAIJ_Refactor *rf = &b->refactor;
+  const PetscInt       n = A->rmap->n, *ai = a->i, *aj = a->j, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  const PetscInt      *r, *ic;
+  PetscInt            *pos;
+  PetscCount           s = 0;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJRefactorDestroy(B));
+  rf->nonzerostate = A->nonzerostate;
+  PetscCall(PetscMalloc1(n, &pos));
+  for (PetscInt j = 0; j < n; j++) pos[j] = -1;
+  PetscCall(ISGetIndices(b->row, &r));
+  PetscCall(ISGetIndices(b->icol, &ic));
+
+  /* count the kept and dropped updates, with the positions in the factor of the entries of row i in pos[] */
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt k = bi[i]; k < bi[i + 1]; k++) pos[bj[k]] = k;
+    for (PetscInt k = bdiag[i + 1] + 1; k <= bdiag[i]; k++) pos[bj[k]] = k;
+    for (PetscInt k = bi[i]; k < bi[i + 1]; k++) {
+      for (PetscInt q = bdiag[bj[k] + 1] + 1; q < bdiag[bj[k]]; q++) {
+        if (pos[bj[q]] >= 0) rf->nupd++;
+        else rf->ndrop++;
+      }
+    }
+    for (PetscInt k = bi[i]; k < bi[i + 1]; k++) pos[bj[k]] = -1;
+    for (PetscInt k = bdiag[i + 1] + 1; k <= bdiag[i]; k++) pos[bj[k]] = -1;
+  }
+  if (rf->nupd > rf->maxratio * (bdiag[0] + 1)) {
+    PetscCall(PetscInfo(B, "Not caching the numeric factorization, %" PetscCount_FMT " updates exceed %g times the %" PetscInt_FMT " nonzeros of the factors\n", rf->nupd, (double)rf->maxratio, bdiag[0] + 1));
+    rf->nupd  = 0;
+    rf->ndrop = 0;
+  } else {
+    PetscCall(PetscMalloc2(ai[n], &rf->amap, bi[n] + 1, &rf->uptr));
+    PetscCall(PetscMalloc2(rf->nupd, &rf->upd, rf->ndrop ? rf->nupd : 0, &rf->usrc));
+    rf->uptr[0] = 0;
+    for (PetscInt i = 0; i < n; i++) {
+      for (PetscInt k = bi[i]; k < bi[i + 1]; k++) pos[bj[k]] = k;
+      for (PetscInt k = bdiag[i + 1] + 1; k <= bdiag[i]; k++) pos[bj[k]] = k;
+
+      for (PetscInt p = ai[r[i]]; p < ai[r[i] + 1]; p++) rf->amap[p] = pos[ic[aj[p]]];
+      for (PetscInt k = bi[i]; k < bi[i + 1]; k++) {
+        const PetscInt row = bj[k];
+
+        for (PetscInt q = bdiag[row + 1] + 1; q < bdiag[row]; q++) {
+          if (pos[bj[q]] < 0) continue;
+          if (rf->usrc) rf->usrc[s] = q - bdiag[row + 1] - 1;
+          rf->upd[s++] = pos[bj[q]];
+        }
+        rf->uptr[k + 1] = s;
+      }
+
+      for (PetscInt k = bi[i]; k < bi[i + 1]; k++) pos[bj[k]] = -1;
+      for (PetscInt k = bdiag[i + 1] + 1; k <= bdiag[i]; k++) pos[bj[k]] = -1;
+    }
+    rf->setup = PETSC_TRUE;
+    PetscCall(PetscInfo(B, "Cached the numeric factorization: %" PetscCount_FMT " updates, %" PetscCount_FMT " dropped, for %" PetscInt_FMT " nonzeros of the factors\n", rf->nupd, rf->ndrop, bdiag[0] + 1));
+  }
+  PetscCall(ISRestoreIndices(b->row, &r));
+  PetscCall(ISRestoreIndices(b->icol, &ic));
+  PetscCall(PetscFree(pos));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJRefactorSetUp_Factor - Before a numeric LU or ILU factorization, computes the maps of the factorization if they are
+   requested and not yet available for the nonzero pattern of the matrix
+
+   Input Parameters:
++  B - the LU or ILU factor, after its symbolic factorization
+-  A - the matrix being factored
+
+   Note:
+   After this call `B`'s `refactor.setup` tells whether the numeric factorization can use the maps; they may be too large,
+   see `-mat_petsc_refactor_cache_max_ratio`
+*/
+PetscErrorCode MatSeqAIJRefactorSetUp_Factor(Mat B, Mat A)
+{
+  Mat_SeqAIJ_Refactor *rf = &((Mat_SeqAIJ *)B->data)->refactor;
+
+  PetscFunctionBegin;
+  if (!rf->use) PetscFunctionReturn(PETSC_SUCCESS);
+  if (rf->nonzerostate && rf->nonzerostate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS); /* computed, or found too large */
+  PetscCall(MatSeqAIJRefactorCompute_Private(B, A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
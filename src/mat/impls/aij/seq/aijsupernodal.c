@@ -0,0 +1,473 @@
+/*
+  Supernodal LU and Cholesky factorizations of SeqAIJ matrices.
+
+  The symbolic factorization computes the elimination tree of the symmetrized, permuted matrix, the structure of the columns
+  of L and the fundamental supernodes: sets of consecutive columns with the same structure below their diagonal block. Each
+  supernode is stored as a dense panel, L as nrows x ncols (its diagonal block holding L11 and, for LU, U11) and for LU the rows
+  of U to the right of the diagonal block as ncols x (nrows - ncols). The numeric factorization is right-looking: each diagonal
+  block is factored with LAPACK (potrf, or getrf with pivoting restricted to the diagonal block), the off-diagonal panels are
+  computed with trsm and the Schur complement updates with gemm, scattered into the panels of the ancestor supernodes.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <petscblaslapack.h>
+
+typedef struct {
+  PetscBool     cholesky;
+  IS            perm;           /* symmetric permutation, row k of the factors is row perm[k] of the matrix */
+  PetscInt      n, nsuper;
+  PetscInt     *sup;            /* supernode s has the columns sup[s] to sup[s + 1] - 1 */
+  PetscInt     *colsup;         /* supernode of each column */
+  PetscInt     *rowptr, *rows;  /* the rows of supernode s are rows[rowptr[s]] to rows[rowptr[s + 1] - 1], its own columns first */
+  PetscInt     *loff, *uoff;    /* offsets in val of the column major panels of L (nrows x ncols) and U (ncols x (nrows - ncols)) */
+  PetscInt     *dest;           /* position in val of each nonzero of the matrix, -1 if it is not used */
+  PetscInt      nval, maxbelow; /* size of val, maximum number of rows below a diagonal block */
+  PetscInt      maxwork;        /* size of the Schur complement update buffer */
+  PetscScalar  *val, *work, *y;
+  PetscInt     *map;
+  PetscBLASInt *ipiv;           /* pivots within the diagonal blocks for LU, indexed by column */
+  PetscLogDouble flops;         /* flops of one numeric factorization */
+} Mat_SeqAIJ_Supernodal;
+
+static PetscErrorCode MatSeqAIJSupernodalDestroy_Private(void *ctx)
+{
+  Mat_SeqAIJ_Supernodal *sn = (Mat_SeqAIJ_Supernodal *)ctx;
+
+  PetscFunctionBegin;
+  PetscCall(ISDestroy(&sn->perm));
+  PetscCall(PetscFree7(sn->sup, sn->colsup, sn->rowptr, sn->loff, sn->uoff, sn->map, sn->ipiv));
+  PetscCall(PetscFree2(sn->rows, sn->dest));
+  PetscCall(PetscFree3(sn->val, sn->work, sn->y));
+  PetscCall(PetscFree(sn));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJSupernodalUse_Factor - Checks if the LU or Cholesky factorization of a SeqAIJ matrix should be supernodal
+
+   Input Parameter:
+.  B - the factor matrix, before the symbolic factorization
+*/
+PetscErrorCode MatSeqAIJSupernodalUse_Factor(Mat B, PetscBool *use)
+{
+  PetscFunctionBegin;
+  *use = PETSC_FALSE;
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "SeqAIJ factorization options", "Mat");
+  PetscCall(PetscOptionsBool("-mat_petsc_supernodal", "Factor supernodes with dense BLAS3 kernels", NULL, *use, use, NULL));
+  PetscOptionsEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* marks the ancestors of j below k in the elimination tree, with path compression, see Liu's algorithm */
+static inline void MatSeqAIJSupernodalEtreeUpdate_Private(PetscInt j, PetscInt k, PetscInt parent[], PetscInt ancestor[])
+{
+  for (PetscInt i = j, inext; i != -1 && i < k; i = inext) {
+    inext       = ancestor[i];
+    ancestor[i] = k;
+    if (inext == -1) parent[i] = k;
+  }
+}
+
+static PetscErrorCode MatSolve_SeqAIJ_Supernodal(Mat B, Vec bb, Vec xx)
+{
+  Mat_SeqAIJ_Supernodal *sn;
+  const PetscInt        *rip;
+  const PetscScalar     *b;
+  PetscScalar           *x, *y, *tmp, one = 1.0, mone = -1.0, zero = 0.0;
+  PetscBLASInt           ione = 1;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectContainerQuery((PetscObject)B, "MatSeqAIJSupernodal_Context", (void **)&sn));
+  if (!sn->n) PetscFunctionReturn(PETSC_SUCCESS);
+  y   = sn->y;
+  tmp = sn->y + sn->n;
+  PetscCall(ISGetIndices(sn->perm, &rip));
+  PetscCall(VecGetArrayRead(bb, &b));
+  for (PetscInt k = 0; k < sn->n; k++) y[k] = b[rip[k]];
+  PetscCall(VecRestoreArrayRead(bb, &b));
+
+  /* forward solve with L */
+  for (PetscInt s = 0; s < sn->nsuper; s++) {
+    const PetscInt     fc = sn->sup[s], nc = sn->sup[s + 1] - fc, nr = sn->rowptr[s + 1] - sn->rowptr[s], *rows = sn->rows + sn->rowptr[s];
+    const PetscScalar *L  = sn->val + sn->loff[s];
+    PetscBLASInt       bn, bm, b2;
+
+    PetscCall(PetscBLASIntCast(nc, &bn));
+    PetscCall(PetscBLASIntCast(nr, &bm));
+    PetscCall(PetscBLASIntCast(nr - nc, &b2));
+    if (!sn->cholesky) {
+      for (PetscInt k = 0; k < nc; k++) {
+        const PetscInt pk = sn->ipiv[fc + k] - 1;
+
+        if (pk != k) {
+          const PetscScalar t = y[fc + k];
+
+          y[fc + k]  = y[fc + pk];
+          y[fc + pk] = t;
+        }
+      }
+    }
+    PetscCallBLAS("BLAStrsv", BLAStrsv_("L", "N", sn->cholesky ? "N" : "U", &bn, L, &bm, y + fc, &ione));
+    if (b2) {
+      PetscCallBLAS("BLASgemv", BLASgemv_("N", &b2, &bn, &one, L + nc, &bm, y + fc, &ione, &zero, tmp, &ione));
+      for (PetscInt r = 0; r < nr - nc; r++) y[rows[nc + r]] -= tmp[r];
+    }
+  }
+  /* backward solve with U, or L^T */
+  for (PetscInt s = sn->nsuper - 1; s >= 0; s--) {
+    const PetscInt     fc = sn->sup[s], nc = sn->sup[s + 1] - fc, nr = sn->rowptr[s + 1] - sn->rowptr[s], *rows = sn->rows + sn->rowptr[s];
+    const PetscScalar *L  = sn->val + sn->loff[s];
+    PetscBLASInt       bn, bm, b2;
+
+    PetscCall(PetscBLASIntCast(nc, &bn));
+    PetscCall(PetscBLASIntCast(nr, &bm));
+    PetscCall(PetscBLASIntCast(nr - nc, &b2));
+    if (b2) {
+      for (PetscInt r = 0; r < nr - nc; r++) tmp[r] = y[rows[nc + r]];
+      if (sn->cholesky) PetscCallBLAS("BLASgemv", BLASgemv_("T", &b2, &bn, &mone, L + nc, &bm, tmp, &ione, &one, y + fc, &ione));
+      else PetscCallBLAS("BLASgemv", BLASgemv_("N", &bn, &b2, &mone, sn->val + sn->uoff[s], &bn, tmp, &ione, &one, y + fc, &ione));
+    }
+    if (sn->cholesky) PetscCallBLAS("BLAStrsv", BLAStrsv_("L", "T", "N", &bn, L, &bm, y + fc, &ione));
+    else PetscCallBLAS("BLAStrsv", BLAStrsv_("U", "N", "N", &bn, L, &bm, y + fc, &ione));
+  }
+
+  PetscCall(VecGetArrayWrite(xx, &x));
+  for (PetscInt k = 0; k < sn->n; k++) x[rip[k]] = y[k];
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(ISRestoreIndices(sn->perm, &rip));
+  PetscCall(PetscLogFlops(4.0 * (sn->nval - sn->n) + 2.0 * sn->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatFactorNumeric_SeqAIJ_Supernodal(Mat B, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ_Supernodal *sn;
+  const PetscScalar     *aa;
+  PetscScalar            one = 1.0, zero = 0.0, *val, *W;
+  PetscInt               nnz = ((Mat_SeqAIJ *)A->data)->i[A->rmap->n], *map;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectContainerQuery((PetscObject)B, "MatSeqAIJSupernodal_Context", (void **)&sn));
+  val = sn->val;
+  W   = sn->work;
+  map = sn->map;
+  PetscCall(PetscArrayzero(val, sn->nval));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (PetscInt p = 0; p < nnz; p++) {
+    if (sn->dest[p] >= 0) val[sn->dest[p]] = aa[p];
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+
+  for (PetscInt s = 0; s < sn->nsuper; s++) {
+    const PetscInt fc = sn->sup[s], nc = sn->sup[s + 1] - fc, nr = sn->rowptr[s + 1] - sn->rowptr[s], *rows = sn->rows + sn->rowptr[s];
+    PetscScalar   *L = val + sn->loff[s], *U = sn->cholesky ? NULL : val + sn->uoff[s];
+    PetscBLASInt   bn, bm, b2, ierr = 0;
+
+    PetscCall(PetscBLASIntCast(nc, &bn));
+    PetscCall(PetscBLASIntCast(nr, &bm));
+    PetscCall(PetscBLASIntCast(nr - nc, &b2));
+    /* factor the diagonal block */
+    PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+    if (sn->cholesky) PetscCallBLAS("LAPACKpotrf", LAPACKpotrf_("L", &bn, L, &bm, &ierr));
+    else PetscCallBLAS("LAPACKgetrf", LAPACKgetrf_(&bn, &bn, L, &bm, sn->ipiv + fc, &ierr));
+    PetscCall(PetscFPTrapPop());
+    if (ierr) {
+      const PetscInt row = fc + ierr - 1;
+
+      PetscCheck(!A->erroriffailure, PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "Zero pivot in %s factorization row %" PetscInt_FMT, sn->cholesky ? "Cholesky" : "LU", row);
+      PetscCall(PetscInfo(A, "Detected zero pivot in %s factorization in row %" PetscInt_FMT "\n", sn->cholesky ? "Cholesky (matrix not positive definite?)" : "LU", row));
+      B->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+      B->factorerror_zeropivot_value = 0.0;
+      B->factorerror_zeropivot_row   = row;
+      break;
+    }
+    if (!b2) continue;
+
+    /* the off-diagonal panels: U12 = L11^{-1} P U12 and L21 = L21 U11^{-1} (or L21 L11^{-T}) */
+    if (!sn->cholesky) {
+      for (PetscInt k = 0; k < nc; k++) {
+        const PetscInt pk = sn->ipiv[fc + k] - 1;
+
+        if (pk == k) continue;
+        for (PetscInt c = 0; c < nr - nc; c++) {
+          const PetscScalar t = U[c * nc + k];
+
+          U[c * nc + k]  = U[c * nc + pk];
+          U[c * nc + pk] = t;
+        }
+      }
+      PetscCallBLAS("BLAStrsm", BLAStrsm_("L", "L", "N", "U", &bn, &b2, &one, L, &bm, U, &bn));
+      PetscCallBLAS("BLAStrsm", BLAStrsm_("R", "U", "N", "N", &b2, &bn, &one, L, &bm, L + nc, &bm));
+    } else PetscCallBLAS("BLAStrsm", BLAStrsm_("R", "L", "T", "N", &b2, &bn, &one, L, &bm, L + nc, &bm));
+
+    /* Schur complement updates, grouped by the supernode of the columns they update */
+    for (PetscInt q = nc, q2; q < nr; q = q2) {
+      const PetscInt  t = sn->colsup[rows[q]], tf = sn->sup[t], tn = sn->sup[t + 1] - tf, tm = sn->rowptr[t + 1] - sn->rowptr[t];
+      const PetscInt *trows = sn->rows + sn->rowptr[t];
+      PetscScalar    *Lt = val + sn->loff[t];
+      PetscBLASInt    bw, bh, bu;
+
+      for (q2 = q; q2 < nr && rows[q2] < tf + tn; q2++);
+      /* positions of the rows q, q + 1, ... of this supernode among the rows of supernode t */
+      for (PetscInt r = q, rt = 0; r < nr; r++) {
+        while (trows[rt] != rows[r]) rt++;
+        map[r - q] = rt;
+      }
+      PetscCall(PetscBLASIntCast(nr - q, &bh));
+      PetscCall(PetscBLASIntCast(q2 - q, &bw));
+      PetscCall(PetscBLASIntCast(nr - q2, &bu));
+      if (sn->cholesky) PetscCallBLAS("BLASgemm", BLASgemm_("N", "T", &bh, &bw, &bn, &one, L + q, &bm, L + q, &bm, &zero, W, &bh));
+      else PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bh, &bw, &bn, &one, L + q, &bm, U + (q - nc) * nc, &bn, &zero, W, &bh));
+      for (PetscInt c = 0; c < q2 - q; c++) {
+        PetscScalar *Ltc = Lt + (rows[q + c] - tf) * tm;
+
+        for (PetscInt r = sn->cholesky ? c : 0; r < nr - q; r++) Ltc[map[r]] -= W[c * (nr - q) + r];
+      }
+      if (!sn->cholesky && bu) {
+        PetscScalar *Ut = val + sn->uoff[t];
+
+        PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bw, &bu, &bn, &one, L + q, &bm, U + (q2 - nc) * nc, &bn, &zero, W, &bw));
+        for (PetscInt c = 0; c < nr - q2; c++) {
+          PetscScalar *Utc = Ut + (map[q2 - q + c] - tn) * tn;
+
+          for (PetscInt r = 0; r < q2 - q; r++) Utc[rows[q + r] - tf] -= W[c * (q2 - q) + r];
+        }
+      }
+    }
+  }
+  PetscCall(PetscLogFlops(sn->flops));
+
+  B->ops->solve             = MatSolve_SeqAIJ_Supernodal;
+  B->ops->solvetranspose    = sn->cholesky ? MatSolve_SeqAIJ_Supernodal : NULL;
+  B->ops->solveadd          = NULL;
+  B->ops->solvetransposeadd = NULL;
+  B->ops->matsolve          = NULL;
+  B->ops->matsolvetranspose = NULL;
+  B->ops->forwardsolve      = NULL;
+  B->ops->backwardsolve     = NULL;
+  B->ops->getinertia        = NULL;
+  B->assembled              = PETSC_TRUE;
+  B->preallocated           = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatGetInfo_SeqAIJ_Supernodal(Mat B, MatInfoType flag, MatInfo *info)
+{
+  Mat_SeqAIJ_Supernodal *sn;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectContainerQuery((PetscObject)B, "MatSeqAIJSupernodal_Context", (void **)&sn));
+  info->block_size        = 1.0;
+  info->nz_allocated      = sn ? sn->nval : 0;
+  info->nz_used           = sn ? sn->nval : 0;
+  info->nz_unneeded       = 0;
+  info->assemblies        = B->num_ass;
+  info->mallocs           = 0;
+  info->memory            = 0;
+  info->fill_ratio_given  = B->info.fill_ratio_given;
+  info->fill_ratio_needed = B->info.fill_ratio_needed;
+  info->factor_mallocs    = B->info.factor_mallocs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_SeqAIJ_Supernodal(Mat B, PetscViewer viewer)
+{
+  Mat_SeqAIJ_Supernodal *sn;
+  PetscBool              iascii;
+  PetscViewerFormat      format;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  PetscCall(PetscObjectContainerQuery((PetscObject)B, "MatSeqAIJSupernodal_Context", (void **)&sn));
+  if (iascii && sn) {
+    PetscCall(PetscViewerGetFormat(viewer, &format));
+    if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "supernodal %s factorization: %" PetscInt_FMT " supernodes, %g columns per supernode on average\n", sn->cholesky ? "Cholesky" : "LU", sn->nsuper, sn->nsuper ? (double)sn->n / sn->nsuper : 0.0));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatFactorSymbolic_SeqAIJ_Supernodal(Mat B, Mat A, IS perm, const MatFactorInfo *info, PetscBool cholesky)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJ_Supernodal *sn;
+  const PetscInt         n = A->rmap->n, *ai = a->i, *aj = a->j, nnz = ai[n];
+  const PetscInt        *rip, *ip;
+  PetscInt              *ati, *atj, *atp, *parent, *ancestor, *mark, *colcount, *next, nrowstotal;
+  IS                     iperm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&sn));
+  sn->cholesky = cholesky;
+  sn->n        = n;
+  PetscCall(PetscObjectReference((PetscObject)perm));
+  sn->perm = perm;
+  PetscCall(ISInvertPermutation(perm, PETSC_DECIDE, &iperm));
+  PetscCall(ISGetIndices(perm, &rip));
+  PetscCall(ISGetIndices(iperm, &ip));
+
+  /* the transpose of the nonzero pattern, to access the columns of the matrix */
+  PetscCall(PetscCalloc1(n + 1, &ati));
+  PetscCall(PetscMalloc2(nnz, &atj, nnz, &atp));
+  for (PetscInt p = 0; p < nnz; p++) ati[aj[p] + 1]++;
+  for (PetscInt i = 0; i < n; i++) ati[i + 1] += ati[i];
+  PetscCall(PetscMalloc5(n, &next, n, &parent, n, &ancestor, n, &mark, n, &colcount));
+  PetscCall(PetscArraycpy(next, ati, n));
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt p = ai[i]; p < ai[i + 1]; p++) {
+      const PetscInt q = next[aj[p]]++;
+
+      atj[q] = i;
+      atp[q] = p;
+    }
+  }
+
+  /* elimination tree of the permuted A + A^T */
+  for (PetscInt k = 0; k < n; k++) {
+    parent[k]   = -1;
+    ancestor[k] = -1;
+    for (PetscInt p = ai[rip[k]]; p < ai[rip[k] + 1]; p++) MatSeqAIJSupernodalEtreeUpdate_Private(ip[aj[p]], k, parent, ancestor);
+    for (PetscInt q = ati[rip[k]]; q < ati[rip[k] + 1]; q++) MatSeqAIJSupernodalEtreeUpdate_Private(ip[atj[q]], k, parent, ancestor);
+  }
+
+  /* column counts of L from the row subtrees */
+  for (PetscInt k = 0; k < n; k++) {
+    mark[k]     = k;
+    colcount[k] = 1;
+    for (PetscInt p = ai[rip[k]]; p < ai[rip[k] + 1]; p++) {
+      for (PetscInt i = ip[aj[p]]; i < k && mark[i] != k; i = parent[i]) {
+        colcount[i]++;
+        mark[i] = k;
+      }
+    }
+    for (PetscInt q = ati[rip[k]]; q < ati[rip[k] + 1]; q++) {
+      for (PetscInt i = ip[atj[q]]; i < k && mark[i] != k; i = parent[i]) {
+        colcount[i]++;
+        mark[i] = k;
+      }
+    }
+  }
+
+  /* fundamental supernodes: column j continues the supernode of column j - 1 if it is its parent and has the same structure */
+  PetscCall(PetscMalloc7(n + 1, &sn->sup, n, &sn->colsup, n + 1, &sn->rowptr, n, &sn->loff, n, &sn->uoff, n, &sn->map, n, &sn->ipiv));
+  sn->nsuper = 0;
+  for (PetscInt j = 0; j < n; j++) {
+    if (!j || parent[j - 1] != j || colcount[j - 1] != colcount[j] + 1) sn->sup[sn->nsuper++] = j;
+    sn->colsup[j] = sn->nsuper - 1;
+  }
+  sn->sup[sn->nsuper] = n;
+  sn->rowptr[0]       = 0;
+  for (PetscInt s = 0; s < sn->nsuper; s++) sn->rowptr[s + 1] = sn->rowptr[s] + colcount[sn->sup[s]];
+  nrowstotal = sn->rowptr[sn->nsuper];
+
+  /* the structure of the first column of each supernode, in increasing row order */
+  PetscCall(PetscMalloc2(nrowstotal, &sn->rows, nnz, &sn->dest));
+  for (PetscInt s = 0; s < sn->nsuper; s++) {
+    sn->rows[sn->rowptr[s]] = sn->sup[s];
+    next[s]                 = sn->rowptr[s] + 1;
+  }
+  for (PetscInt k = 0; k < n; k++) mark[k] = -1;
+  for (PetscInt k = 0; k < n; k++) {
+    mark[k] = k;
+    for (PetscInt p = ai[rip[k]]; p < ai[rip[k] + 1]; p++) {
+      for (PetscInt i = ip[aj[p]]; i < k && mark[i] != k; i = parent[i]) {
+        mark[i] = k;
+        if (sn->sup[sn->colsup[i]] == i) sn->rows[next[sn->colsup[i]]++] = k;
+      }
+    }
+    for (PetscInt q = ati[rip[k]]; q < ati[rip[k] + 1]; q++) {
+      for (PetscInt i = ip[atj[q]]; i < k && mark[i] != k; i = parent[i]) {
+        mark[i] = k;
+        if (sn->sup[sn->colsup[i]] == i) sn->rows[next[sn->colsup[i]]++] = k;
+      }
+    }
+  }
+
+  /* layout of the panels, sizes of the work arrays and flop count */
+  sn->nval     = 0;
+  sn->maxbelow = 0;
+  sn->maxwork  = 0;
+  sn->flops    = 0.0;
+  for (PetscInt s = 0; s < sn->nsuper; s++) {
+    const PetscInt nc = sn->sup[s + 1] - sn->sup[s], nr = sn->rowptr[s + 1] - sn->rowptr[s], *rows = sn->rows + sn->rowptr[s];
+
+    sn->loff[s] = sn->nval;
+    sn->nval += nr * nc;
+    sn->maxbelow = PetscMax(sn->maxbelow, nr - nc);
+    sn->flops += (cholesky ? 1.0 : 2.0) * nc * nc * nc / 3.0 + (cholesky ? 1.0 : 2.0) * (nr - nc) * nc * nc + (cholesky ? 1.0 : 2.0) * (nr - nc) * (nr - nc) * nc;
+    for (PetscInt q = nc, q2; q < nr; q = q2) {
+      const PetscInt t = sn->colsup[rows[q]];
+
+      for (q2 = q; q2 < nr && rows[q2] < sn->sup[t + 1]; q2++);
+      sn->maxwork = PetscMax(sn->maxwork, (nr - q) * (q2 - q));
+    }
+  }
+  for (PetscInt s = 0; s < sn->nsuper && !cholesky; s++) {
+    const PetscInt nc = sn->sup[s + 1] - sn->sup[s], nr = sn->rowptr[s + 1] - sn->rowptr[s];
+
+    sn->uoff[s] = sn->nval;
+    sn->nval += (nr - nc) * nc;
+  }
+
+  /* where each nonzero of the matrix goes in the panels: for Cholesky the upper triangular part, as in the standard factorization,
+     stored by columns in L; for LU the columns of L with the diagonal blocks, then the rows of U */
+  for (PetscInt p = 0; p < nnz; p++) sn->dest[p] = -1;
+  for (PetscInt t = 0; t < sn->nsuper; t++) {
+    const PetscInt fc = sn->sup[t], lc = sn->sup[t + 1] - 1, nc = lc - fc + 1, nr = sn->rowptr[t + 1] - sn->rowptr[t], *rows = sn->rows + sn->rowptr[t];
+
+    for (PetscInt r = 0; r < nr; r++) sn->map[rows[r]] = r;
+    for (PetscInt c = fc; c <= lc; c++) {
+      if (cholesky) {
+        for (PetscInt p = ai[rip[c]]; p < ai[rip[c] + 1]; p++) {
+          const PetscInt i = ip[aj[p]];
+
+          if (i >= c) sn->dest[p] = sn->loff[t] + (c - fc) * nr + sn->map[i];
+        }
+        continue;
+      }
+      for (PetscInt q = ati[rip[c]]; q < ati[rip[c] + 1]; q++) {
+        const PetscInt i = ip[atj[q]];
+
+        if (i >= fc) sn->dest[atp[q]] = sn->loff[t] + (c - fc) * nr + sn->map[i];
+      }
+      for (PetscInt p = ai[rip[c]]; p < ai[rip[c] + 1]; p++) {
+        const PetscInt i = ip[aj[p]];
+
+        if (i > lc) sn->dest[p] = sn->uoff[t] + (sn->map[i] - nc) * nc + (c - fc);
+      }
+    }
+  }
+  PetscCall(PetscFree5(next, parent, ancestor, mark, colcount));
+  PetscCall(PetscFree(ati));
+  PetscCall(PetscFree2(atj, atp));
+  PetscCall(ISRestoreIndices(perm, &rip));
+  PetscCall(ISRestoreIndices(iperm, &ip));
+  PetscCall(ISDestroy(&iperm));
+
+  PetscCall(PetscMalloc3(sn->nval, &sn->val, sn->maxwork, &sn->work, n + sn->maxbelow, &sn->y));
+  PetscCall(PetscObjectContainerCompose((PetscObject)B, "MatSeqAIJSupernodal_Context", sn, MatSeqAIJSupernodalDestroy_Private));
+  PetscCall(PetscInfo(A, "%" PetscInt_FMT " supernodes, %g columns per supernode on average, %" PetscInt_FMT " entries in the panels of the factors\n", sn->nsuper, sn->nsuper ? (double)n / sn->nsuper : 0.0, sn->nval));
+
+  B->info.factor_mallocs    = 0;
+  B->info.fill_ratio_given  = info->fill;
+  B->info.fill_ratio_needed = nnz ? (PetscReal)sn->nval / nnz : 0.0;
+  B->ops->view              = MatView_SeqAIJ_Supernodal;
+  B->ops->getinfo           = MatGetInfo_SeqAIJ_Supernodal;
+  if (cholesky) B->ops->choleskyfactornumeric = MatFactorNumeric_SeqAIJ_Supernodal;
+  else B->ops->lufactornumeric = MatFactorNumeric_SeqAIJ_Supernodal;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatLUFactorSymbolic_SeqAIJ_Supernodal(Mat B, Mat A, IS isrow, IS iscol, const MatFactorInfo *info)
+{
+  PetscFunctionBegin;
+  PetscCall(MatFactorSymbolic_SeqAIJ_Supernodal(B, A, isrow, info, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ_Supernodal(Mat B, Mat A, IS perm, const MatFactorInfo *info)
+{
+  PetscFunctionBegin;
+  PetscCall(MatFactorSymbolic_SeqAIJ_Supernodal(B, A, perm, info, PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
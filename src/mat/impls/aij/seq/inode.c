@@ -1202,6 +1202,11 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B, Mat A, const MatFactorInfo
   PetscInt        *tmp_vec1, *tmp_vec2, *nsmap;
 
   PetscFunctionBegin;
+  PetscCall(MatSeqAIJRefactorSetUp_Factor(B, A));
+  if (b->refactor.setup) { /* the precomputed maps are used by the row by row factorization */
+    PetscCall(MatLUFactorNumeric_SeqAIJ(B, A, info));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   /* MatPivotSetUp(): initialize shift context sctx */
   PetscCall(PetscMemzero(&sctx, sizeof(FactorShiftCtx)));
 
@@ -1941,6 +1946,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B, Mat A, const MatFactorInfo
   } else {
     C->ops->solve = MatSolve_SeqAIJ;
   }
+  PetscCall(MatSeqAIJLevelsSetUp_Factor(C));
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
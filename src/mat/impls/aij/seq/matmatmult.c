@@ -131,6 +131,13 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A, Mat B, PetscReal fill, Ma
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  /* threaded */
+  PetscCall(PetscStrcmp(alg, "threaded", &flg));
+  if (flg) {
+    PetscCall(MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threaded(A, B, fill, C));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
 #if defined(PETSC_HAVE_HYPRE)
   PetscCall(PetscStrcmp(alg, "hypre", &flg));
   if (flg) {
@@ -1985,11 +1992,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_AB(Mat C)
   PetscInt     alg     = 0; /* default algorithm */
   PetscBool    flg     = PETSC_FALSE;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char *algTypes[7] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge"};
-  PetscInt    nalg        = 7;
-#else
-  const char *algTypes[8] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge", "hypre"};
+  const char *algTypes[8] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge", "threaded"};
   PetscInt    nalg        = 8;
+#else
+  const char *algTypes[9] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge", "threaded", "hypre"};
+  PetscInt    nalg        = 9;
 #endif
 
   PetscFunctionBegin;
@@ -2078,11 +2085,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_PtAP(Mat C)
   PetscBool    flg     = PETSC_FALSE;
   PetscInt     alg     = 0; /* default algorithm -- alg=1 should be default!!! */
 #if !defined(PETSC_HAVE_HYPRE)
-  const char *algTypes[2] = {"scalable", "rap"};
-  PetscInt    nalg        = 2;
-#else
-  const char *algTypes[3] = {"scalable", "rap", "hypre"};
+  const char *algTypes[3] = {"scalable", "rap", "threaded"};
   PetscInt    nalg        = 3;
+#else
+  const char *algTypes[4] = {"scalable", "rap", "threaded", "hypre"};
+  PetscInt    nalg        = 4;
 #endif
 
   PetscFunctionBegin;
@@ -0,0 +1,321 @@
+/*
+  Row-partitioned two-pass products of SeqAIJ matrices, C = A*B and C = P^T*A*P, used with -matmatmult_via threaded and
+  -matptap_via threaded (or -mat_product_algorithm threaded).
+
+  The rows of C are split into chunks of about the same number of flops, each chunk has its own work arrays so the chunks are
+  processed concurrently when PETSc is configured with --with-openmp-kernels. The first (symbolic) pass counts the nonzeros of
+  each row of C, the second one fills in their sorted column indices; the numeric phase only computes values into this pattern,
+  so it can be repeated for matrices with the same nonzero patterns. The columns of B are accumulated in blocks of bs columns,
+  so the markers and the accumulator of a chunk are sized to stay in the L2 cache also when B has many columns.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscInt       nchunks;    /* number of chunks of rows of C, each with its own work arrays */
+  PetscInt      *cstart;     /* chunk t has the rows cstart[t] to cstart[t + 1] - 1 */
+  PetscInt       bs;         /* number of columns of B accumulated at a time */
+  PetscInt       rmax;       /* largest number of nonzeros in a row of A */
+  PetscInt      *mark, *idx; /* per chunk: bs markers and column indices for the symbolic phase */
+  PetscInt      *next;       /* per chunk: rmax positions in the rows of B */
+  PetscScalar   *acc;        /* per chunk: bs accumulators */
+  PetscLogDouble flops;
+} MatMatMult_SeqAIJ_Threaded;
+
+typedef struct {
+  Mat                         Pt, AP; /* P^T and A*P */
+  MatMatMult_SeqAIJ_Threaded *ap, *ptap;
+} MatPtAP_SeqAIJ_Threaded;
+
+static PetscErrorCode MatMatMultThreadedDestroy_Private(void *data)
+{
+  MatMatMult_SeqAIJ_Threaded *mm = (MatMatMult_SeqAIJ_Threaded *)data;
+
+  PetscFunctionBegin;
+  if (!mm) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFree(mm->cstart));
+  PetscCall(PetscFree4(mm->mark, mm->idx, mm->next, mm->acc));
+  PetscCall(PetscFree(mm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the index sets of the symbolic phase are short and mostly nearly sorted, a shell sort needs no recursion and no error handling
+   inside the threaded loop */
+static inline void MatMatMultThreadedSort_Private(PetscInt n, PetscInt *x)
+{
+  static const PetscInt gaps[] = {701, 301, 132, 57, 23, 10, 4, 1};
+
+  for (PetscInt g = 0; g < (PetscInt)PETSC_STATIC_ARRAY_LENGTH(gaps); g++) {
+    const PetscInt gap = gaps[g];
+
+    for (PetscInt i = gap; i < n; i++) {
+      const PetscInt t = x[i];
+      PetscInt       j = i;
+
+      for (; j >= gap && x[j - gap] > t; j -= gap) x[j] = x[j - gap];
+      x[j] = t;
+    }
+  }
+}
+
+/*
+  Number of nonzeros of row i of A*B, with their sorted column indices in cj[] if cj is not NULL. The rows of B are merged block by
+  block of bs columns, next[] keeps for each of them the position of the first entry not yet merged
+*/
+static inline PetscInt MatMatMultThreadedRowSymbolic_Private(PetscInt i, const PetscInt *ai, const PetscInt *aj, const PetscInt *bi, const PetscInt *bj, PetscInt bs, PetscBool diagonal, PetscInt *mark, PetscInt *idx, PetscInt *next, PetscInt *stamp, PetscInt *cj)
+{
+  const PetscInt  anz  = ai[i + 1] - ai[i];
+  const PetscInt *acol = aj + ai[i];
+  PetscInt        cnz = 0, diag = diagonal ? i : -1;
+
+  for (PetscInt k = 0; k < anz; k++) next[k] = bi[acol[k]];
+  while (PETSC_TRUE) {
+    PetscInt lo = diag >= 0 ? diag : PETSC_MAX_INT, blk, hi, n = 0;
+
+    for (PetscInt k = 0; k < anz; k++) {
+      if (next[k] < bi[acol[k] + 1]) lo = PetscMin(lo, bj[next[k]]);
+    }
+    if (lo == PETSC_MAX_INT) break;
+    blk = (lo / bs) * bs;
+    hi  = blk + bs;
+    (*stamp)++;
+    for (PetscInt k = 0; k < anz; k++) {
+      const PetscInt qend = bi[acol[k] + 1];
+      PetscInt       q    = next[k];
+
+      for (; q < qend && bj[q] < hi; q++) {
+        if (mark[bj[q] - blk] != *stamp) {
+          mark[bj[q] - blk] = *stamp;
+          idx[n++]          = bj[q];
+        }
+      }
+      next[k] = q;
+    }
+    if (diag >= blk && diag < hi) {
+      if (mark[diag - blk] != *stamp) idx[n++] = diag;
+      diag = -1;
+    }
+    if (cj) {
+      MatMatMultThreadedSort_Private(n, idx);
+      for (PetscInt k = 0; k < n; k++) cj[cnz + k] = idx[k];
+    }
+    cnz += n;
+  }
+  return cnz;
+}
+
+/* values of row i of C = A*B, whose column indices are the union of those of the rows of B selected by row i of A */
+static inline void MatMatMultThreadedRowNumeric_Private(PetscInt i, const PetscInt *ai, const PetscInt *aj, const PetscScalar *aa, const PetscInt *bi, const PetscInt *bj, const PetscScalar *ba, const PetscInt *ci, const PetscInt *cj, PetscScalar *ca, PetscInt bs, PetscScalar *acc, PetscInt *next)
+{
+  const PetscInt     anz  = ai[i + 1] - ai[i];
+  const PetscInt    *acol = aj + ai[i];
+  const PetscScalar *aval = aa + ai[i];
+  PetscInt           q    = ci[i];
+
+  for (PetscInt k = 0; k < anz; k++) next[k] = bi[acol[k]];
+  while (q < ci[i + 1]) {
+    const PetscInt blk = (cj[q] / bs) * bs, hi = blk + bs;
+
+    for (PetscInt k = 0; k < anz; k++) {
+      const PetscInt    pend = bi[acol[k] + 1];
+      const PetscScalar av   = aval[k];
+      PetscInt          p    = next[k];
+
+      for (; p < pend && bj[p] < hi; p++) acc[bj[p] - blk] += av * ba[p];
+      next[k] = p;
+    }
+    for (; q < ci[i + 1] && cj[q] < hi; q++) {
+      ca[q]            = acc[cj[q] - blk];
+      acc[cj[q] - blk] = 0.0;
+    }
+  }
+}
+
+/* computes the nonzero pattern of C = A*B into C, and the context for its numeric phase */
+static PetscErrorCode MatMatMultThreadedSymbolic_Private(Mat A, Mat B, PetscReal fill, Mat C, MatMatMult_SeqAIJ_Threaded **mmctx)
+{
+  Mat_SeqAIJ                 *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data, *c;
+  const PetscInt             *ai = a->i, *aj = a->j, *bi = b->i, *bj = b->j;
+  PetscInt                    am = A->rmap->n, bm = B->rmap->n, bn = B->cmap->n, *ci, *cj, *stamp;
+  PetscBool                   diagonal = C->force_diagonals;
+  PetscLogDouble              flops    = 0.0, target;
+  PetscReal                   afill;
+  MatMatMult_SeqAIJ_Threaded *mm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&mm));
+  mm->nchunks = 1;
+#if defined(PETSC_USE_OPENMP_KERNELS)
+  mm->nchunks = PetscMax(PetscNumOMPThreads, 1);
+#endif
+  mm->bs = (PetscInt)(262144 / (sizeof(PetscScalar) + 2 * sizeof(PetscInt))); /* markers, indices and accumulators in 256 KB */
+  PetscOptionsBegin(PetscObjectComm((PetscObject)C), ((PetscObject)C)->prefix, "Threaded sparse matrix-matrix product options", "Mat");
+  PetscCall(PetscOptionsInt("-mat_product_threaded_chunks", "Number of chunks of rows of the product, each with its own work arrays", "MatProductSetAlgorithm", mm->nchunks, &mm->nchunks, NULL));
+  PetscCall(PetscOptionsInt("-mat_product_threaded_block_size", "Number of columns accumulated at a time", "MatProductSetAlgorithm", mm->bs, &mm->bs, NULL));
+  PetscOptionsEnd();
+  PetscCheck(mm->nchunks > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of chunks %" PetscInt_FMT " must be positive", mm->nchunks);
+  PetscCheck(mm->bs > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Block size %" PetscInt_FMT " must be positive", mm->bs);
+  mm->bs      = PetscMin(mm->bs, PetscMax(bn, 1));
+  mm->nchunks = PetscMin(mm->nchunks, PetscMax(am, 1));
+  mm->rmax    = a->rmax;
+  for (PetscInt i = 0; i < am; i++) mm->rmax = PetscMax(mm->rmax, ai[i + 1] - ai[i]);
+
+  /* split the rows into chunks of about the same number of flops, the number of nonzeros of A*B before merging */
+  PetscCall(PetscMalloc1(mm->nchunks + 1, &mm->cstart));
+  for (PetscInt j = 0; j < ai[am]; j++) flops += bi[aj[j] + 1] - bi[aj[j]];
+  for (PetscInt t = 0; t <= mm->nchunks; t++) mm->cstart[t] = t ? am : 0;
+  mm->flops = 2.0 * flops;
+  target    = flops / mm->nchunks;
+  flops     = 0.0;
+  for (PetscInt i = 0, t = 1; i < am && t < mm->nchunks; i++) {
+    for (PetscInt j = ai[i]; j < ai[i + 1]; j++) flops += bi[aj[j] + 1] - bi[aj[j]];
+    while (t < mm->nchunks && flops >= t * target) mm->cstart[t++] = i + 1;
+  }
+
+  PetscCall(PetscCalloc4(mm->nchunks * mm->bs, &mm->mark, mm->nchunks * mm->bs, &mm->idx, mm->nchunks * mm->rmax, &mm->next, mm->nchunks * mm->bs, &mm->acc));
+  PetscCall(PetscCalloc1(mm->nchunks, &stamp));
+
+  /* first pass: number of nonzeros of each row */
+  PetscCall(PetscMalloc1(am + 1, &ci));
+  ci[0] = 0;
+  PetscPragmaUseOMPKernels(parallel for schedule(static, 1))
+  for (PetscInt t = 0; t < mm->nchunks; t++) {
+    PetscInt *mark = mm->mark + t * mm->bs, *idx = mm->idx + t * mm->bs, *next = mm->next + t * mm->rmax;
+
+    for (PetscInt i = mm->cstart[t]; i < mm->cstart[t + 1]; i++) ci[i + 1] = MatMatMultThreadedRowSymbolic_Private(i, ai, aj, bi, bj, mm->bs, (PetscBool)(diagonal && i < bn), mark, idx, next, &stamp[t], NULL);
+  }
+  for (PetscInt i = 0; i < am; i++) ci[i + 1] += ci[i];
+
+  /* second pass: sorted column indices */
+  PetscCall(PetscMalloc1(ci[am] + 1, &cj));
+  PetscPragmaUseOMPKernels(parallel for schedule(static, 1))
+  for (PetscInt t = 0; t < mm->nchunks; t++) {
+    PetscInt *mark = mm->mark + t * mm->bs, *idx = mm->idx + t * mm->bs, *next = mm->next + t * mm->rmax;
+
+    for (PetscInt i = mm->cstart[t]; i < mm->cstart[t + 1]; i++) (void)MatMatMultThreadedRowSymbolic_Private(i, ai, aj, bi, bj, mm->bs, (PetscBool)(diagonal && i < bn), mark, idx, next, &stamp[t], cj + ci[i]);
+  }
+  PetscCall(PetscFree(stamp));
+
+  PetscCall(MatSetSeqAIJWithArrays_private(PetscObjectComm((PetscObject)A), am, bn, ci, cj, NULL, ((PetscObject)A)->type_name, C));
+  PetscCall(MatSetBlockSizesFromMats(C, A, B));
+  c          = (Mat_SeqAIJ *)C->data;
+  c->free_a  = PETSC_TRUE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  afill = (PetscReal)ci[am] / PetscMax(ai[am] + bi[bm], 1) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  C->info.mallocs           = 0;
+  C->info.fill_ratio_given  = fill;
+  C->info.fill_ratio_needed = afill;
+  PetscCall(PetscInfo(C, "%" PetscInt_FMT " chunks of rows, blocks of %" PetscInt_FMT " columns; fill ratio: given %g needed %g\n", mm->nchunks, mm->bs, (double)fill, (double)afill));
+  *mmctx = mm;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMatMultThreadedNumeric_Private(Mat A, Mat B, Mat C, MatMatMult_SeqAIJ_Threaded *mm)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data, *c = (Mat_SeqAIJ *)C->data;
+  const PetscInt    *ai = a->i, *aj = a->j, *bi = b->i, *bj = b->j, *ci = c->i, *cj = c->j;
+  const PetscScalar *aa, *ba;
+  PetscScalar       *ca;
+
+  PetscFunctionBegin;
+  if (!c->a) {
+    PetscCall(PetscMalloc1(ci[C->rmap->n] + 1, &c->a));
+    c->free_a = PETSC_TRUE;
+  }
+  ca = c->a;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(MatSeqAIJGetArrayRead(B, &ba));
+  PetscPragmaUseOMPKernels(parallel for schedule(static, 1))
+  for (PetscInt t = 0; t < mm->nchunks; t++) {
+    PetscScalar *acc  = mm->acc + t * mm->bs;
+    PetscInt    *next = mm->next + t * mm->rmax;
+
+    for (PetscInt i = mm->cstart[t]; i < mm->cstart[t + 1]; i++) MatMatMultThreadedRowNumeric_Private(i, ai, aj, aa, bi, bj, ba, ci, cj, ca, mm->bs, acc, next);
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(MatSeqAIJRestoreArrayRead(B, &ba));
+  PetscCall(PetscLogFlops(mm->flops));
+#if defined(PETSC_HAVE_DEVICE)
+  if (C->offloadmask != PETSC_OFFLOAD_UNALLOCATED) C->offloadmask = PETSC_OFFLOAD_CPU;
+#endif
+  PetscCall(MatAssemblyBegin(C, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(C, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded(Mat A, Mat B, Mat C)
+{
+  PetscFunctionBegin;
+  MatCheckProduct(C, 3);
+  PetscCheck(C->product->data, PetscObjectComm((PetscObject)C), PETSC_ERR_ARG_WRONGSTATE, "Product cannot be reused. Do not call MatProductClear()");
+  PetscCall(MatMatMultThreadedNumeric_Private(A, B, C, (MatMatMult_SeqAIJ_Threaded *)C->product->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threaded(Mat A, Mat B, PetscReal fill, Mat C)
+{
+  MatMatMult_SeqAIJ_Threaded *mm;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 4);
+  PetscCheck(!C->product->data, PetscObjectComm((PetscObject)C), PETSC_ERR_PLIB, "Product data not empty");
+  PetscCall(MatMatMultThreadedSymbolic_Private(A, B, fill, C, &mm));
+  C->product->data       = mm;
+  C->product->destroy    = MatMatMultThreadedDestroy_Private;
+  C->ops->matmultnumeric = MatMatMultNumeric_SeqAIJ_SeqAIJ_Threaded;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatPtAPThreadedDestroy_Private(void *data)
+{
+  MatPtAP_SeqAIJ_Threaded *ptap = (MatPtAP_SeqAIJ_Threaded *)data;
+
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(&ptap->Pt));
+  PetscCall(MatDestroy(&ptap->AP));
+  PetscCall(MatMatMultThreadedDestroy_Private(ptap->ap));
+  PetscCall(MatMatMultThreadedDestroy_Private(ptap->ptap));
+  PetscCall(PetscFree(ptap));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_Threaded(Mat A, Mat P, Mat C)
+{
+  MatPtAP_SeqAIJ_Threaded *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 3);
+  ptap = (MatPtAP_SeqAIJ_Threaded *)C->product->data;
+  PetscCheck(ptap, PetscObjectComm((PetscObject)C), PETSC_ERR_ARG_WRONGSTATE, "PtAP cannot be reused. Do not call MatProductClear()");
+  PetscCall(MatTranspose(P, MAT_REUSE_MATRIX, &ptap->Pt));
+  PetscCall(MatMatMultThreadedNumeric_Private(A, P, ptap->AP, ptap->ap));
+  PetscCall(MatMatMultThreadedNumeric_Private(ptap->Pt, ptap->AP, C, ptap->ptap));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  C = P^T*(A*P) as two threaded products; P^T is stored explicitly so that both products are row-oriented and each row of C is
+  computed by a single thread
+*/
+PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_Threaded(Mat A, Mat P, PetscReal fill, Mat C)
+{
+  MatPtAP_SeqAIJ_Threaded *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 4);
+  PetscCheck(!C->product->data, PetscObjectComm((PetscObject)C), PETSC_ERR_PLIB, "Product data not empty");
+  PetscCall(PetscNew(&ptap));
+  PetscCall(MatTranspose(P, MAT_INITIAL_MATRIX, &ptap->Pt));
+  PetscCall(MatCreate(PETSC_COMM_SELF, &ptap->AP));
+  PetscCall(MatSetOptionsPrefix(ptap->AP, ((PetscObject)C)->prefix));
+  PetscCall(MatMatMultThreadedSymbolic_Private(A, P, fill, ptap->AP, &ptap->ap));
+  PetscCall(MatMatMultThreadedSymbolic_Private(ptap->Pt, ptap->AP, fill, C, &ptap->ptap));
+  PetscCall(MatSetBlockSizes(C, PetscAbs(P->cmap->bs), PetscAbs(P->cmap->bs)));
+  C->product->data       = ptap;
+  C->product->destroy    = MatPtAPThreadedDestroy_Private;
+  C->ops->ptapnumeric    = MatPtAPNumeric_SeqAIJ_SeqAIJ_Threaded;
+  C->ops->productnumeric = MatProductNumeric_PtAP;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -49,6 +49,13 @@ PetscErrorCode MatProductSymbolic_PtAP_SeqAIJ_SeqAIJ(Mat C)
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  /* "threaded" */
+  PetscCall(PetscStrcmp(alg, "threaded", &flg));
+  if (flg) {
+    PetscCall(MatPtAPSymbolic_SeqAIJ_SeqAIJ_Threaded(A, P, fill, C));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   /* hypre */
 #if defined(PETSC_HAVE_HYPRE)
   PetscCall(PetscStrcmp(alg, "hypre", &flg));
@@ -0,0 +1,339 @@
+/*
+  Fine-grained iterative ILU factorization of Chow and Patel for SeqAIJ matrices.
+
+  The nonzeros of the ILU(k) factors are computed by fixed-point sweeps of the equations (L U)_ij = a_ij restricted to the
+  sparsity pattern of the factors. Every entry of a sweep is computed independently from the previous iterate, so the sweeps
+  (and the Jacobi sweeps used for the approximate triangular solves) are threaded over the rows when PETSc is configured with
+  --with-openmp-kernels. The factors are stored in the same layout as the MATSOLVERPETSC factors.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/*MC
+  MATSOLVERPARILU - Fine-grained iterative ILU(k) factorization with approximate triangular solves {cite}`chow2015fine`
+
+  Works with `MATSEQAIJ` matrices, use `-pc_factor_mat_solver_type parilu` with `PCILU`, or `-sub_pc_factor_mat_solver_type parilu`
+  for the subdomain solvers of `PCBJACOBI` and `PCASM`
+
+  Options Database Keys:
++ -pc_factor_levels <l>           - number of levels of fill of the ILU(k) sparsity pattern
+. -mat_parilu_sweeps <s>          - number of fixed-point sweeps used to compute the factors, default 3
+- -mat_parilu_solve_sweeps <m>    - number of Jacobi sweeps for each approximate triangular solve, default 3; 0 gives exact triangular solves
+
+  Level: intermediate
+
+  Notes:
+  The factors are not the exact ILU(k) factors but converge to them as the number of sweeps increases; each sweep has the cost of
+  a sparse matrix-matrix product restricted to the pattern of the factors. Likewise, the triangular solves are replaced by
+  a fixed number of Jacobi iterations. Both trade a somewhat weaker preconditioner for much better thread scaling than the
+  sequential factorization and triangular solves, they are threaded when PETSc is configured with `--with-openmp-kernels`.
+
+  With approximate triangular solves `MatSolveTranspose()` is not available
+
+.seealso: [](ch_matrices), `Mat`, `PCILU`, `PCFactorSetMatSolverType()`, `MatSolverType`, `PCFactorSetLevels()`, `MATSOLVERPETSC`, `PCCHOWILUVIENNACL`
+M*/
+
+typedef struct {
+  PetscInt     sweeps;      /* number of fixed-point sweeps of the factorization */
+  PetscInt     solvesweeps; /* number of Jacobi sweeps of each triangular solve, 0 for exact solves */
+  PetscInt    *ucp, *ucr;   /* U stored by columns: the rows of column j are ucr[ucp[j]] to ucr[ucp[j + 1] - 1], its diagonal last */
+  PetscInt    *upos;        /* upos[q] is the position in the column storage of the entry at position diag[n] + 1 + q of the factor */
+  PetscScalar *av;          /* values of the permuted matrix on the sparsity pattern of the factors */
+  PetscScalar *l[2], *u[2]; /* current and next iterates of L (as the factor) and U (by columns) */
+  PetscScalar *work;
+} Mat_ParILU;
+
+static PetscErrorCode MatParILUDestroy_Private(void *ctx)
+{
+  Mat_ParILU *parilu = (Mat_ParILU *)ctx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree3(parilu->ucp, parilu->ucr, parilu->upos));
+  PetscCall(PetscFree6(parilu->av, parilu->l[0], parilu->l[1], parilu->u[0], parilu->u[1], parilu->work));
+  PetscCall(PetscFree(parilu));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* sum over k < min(i, j) of L(i, k) U(k, j), merging row i of L with column j of U without its diagonal */
+static inline PetscScalar MatParILUDot_Private(const PetscInt *lj, const PetscScalar *lv, PetscInt nl, const PetscInt *ur, const PetscScalar *uv, PetscInt nu)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    s = 0, t = 0;
+
+  while (s < nl && t < nu) {
+    if (lj[s] < ur[t]) s++;
+    else if (lj[s] > ur[t]) t++;
+    else sum += lv[s++] * uv[t++];
+  }
+  return sum;
+}
+
+static PetscErrorCode MatSolve_SeqAIJ_ParILU(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  Mat_ParILU        *parilu;
+  const PetscInt     n = A->rmap->n, *ai = a->i, *aj = a->j, *adiag = a->diag;
+  const MatScalar   *aa = a->a;
+  const PetscInt    *r = NULL, *c = NULL;
+  PetscBool          rident, cident;
+  PetscScalar       *x, *y, *t[2];
+  const PetscScalar *b;
+  PetscInt           cur = 0;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectContainerQuery((PetscObject)A, "MatParILU_Context", (void **)&parilu));
+  y    = parilu->work;
+  t[0] = parilu->work + n;
+  t[1] = parilu->work + 2 * n;
+  PetscCall(ISIdentity(a->row, &rident));
+  PetscCall(ISIdentity(a->col, &cident));
+  if (!rident) PetscCall(ISGetIndices(a->row, &r));
+  if (!cident) PetscCall(ISGetIndices(a->col, &c));
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+
+  /* L y = P b with Jacobi sweeps y <- P b - (L - I) y, starting from y = P b */
+  for (PetscInt i = 0; i < n; i++) y[i] = r ? b[r[i]] : b[i];
+  PetscCall(PetscArraycpy(t[cur], y, n));
+  for (PetscInt m = 0; m < parilu->solvesweeps; m++) {
+    const PetscScalar *told = t[cur];
+    PetscScalar       *tnew = t[1 - cur];
+
+    PetscPragmaUseOMPKernels(parallel for schedule(static))
+    for (PetscInt i = 0; i < n; i++) {
+      PetscScalar sum = y[i];
+
+      for (PetscInt k = ai[i]; k < ai[i + 1]; k++) sum -= aa[k] * told[aj[k]];
+      tnew[i] = sum;
+    }
+    cur = 1 - cur;
+  }
+  PetscCall(PetscArraycpy(y, t[cur], n));
+
+  /* U z = y with Jacobi sweeps z <- D^{-1} (y - (U - D) z), starting from z = D^{-1} y */
+  for (PetscInt i = 0; i < n; i++) t[cur][i] = aa[adiag[i]] * y[i];
+  for (PetscInt m = 0; m < parilu->solvesweeps; m++) {
+    const PetscScalar *told = t[cur];
+    PetscScalar       *tnew = t[1 - cur];
+
+    PetscPragmaUseOMPKernels(parallel for schedule(static))
+    for (PetscInt i = 0; i < n; i++) {
+      PetscScalar sum = y[i];
+
+      for (PetscInt k = adiag[i + 1] + 1; k < adiag[i]; k++) sum -= aa[k] * told[aj[k]];
+      tnew[i] = aa[adiag[i]] * sum;
+    }
+    cur = 1 - cur;
+  }
+  if (c) {
+    for (PetscInt i = 0; i < n; i++) x[c[i]] = t[cur][i];
+  } else PetscCall(PetscArraycpy(x, t[cur], n));
+
+  if (r) PetscCall(ISRestoreIndices(a->row, &r));
+  if (c) PetscCall(ISRestoreIndices(a->col, &c));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(parilu->solvesweeps * 2.0 * a->nz + n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatLUFactorNumeric_SeqAIJ_ParILU(Mat B, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data;
+  Mat_ParILU        *parilu;
+  const PetscInt     n = A->rmap->n, *ai = a->i, *aj = a->j, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  const PetscInt     uoff = n ? bdiag[n] + 1 : 0;
+  const PetscInt    *ucp, *ucr, *upos, *r, *ic;
+  const PetscScalar *aa;
+  PetscScalar       *av, *rtmp;
+  PetscInt           cur = 0;
+  PetscBool          row_identity, col_identity;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectContainerQuery((PetscObject)B, "MatParILU_Context", (void **)&parilu));
+  ucp  = parilu->ucp;
+  ucr  = parilu->ucr;
+  upos = parilu->upos;
+  av   = parilu->av;
+
+  /* gather the entries of the permuted matrix on the pattern of the factors */
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(ISGetIndices(b->row, &r));
+  PetscCall(ISGetIndices(b->icol, &ic));
+  PetscCall(PetscCalloc1(n, &rtmp));
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt k = ai[r[i]]; k < ai[r[i] + 1]; k++) rtmp[ic[aj[k]]] = aa[k];
+    for (PetscInt p = bi[i]; p < bi[i + 1]; p++) av[p] = rtmp[bj[p]];
+    for (PetscInt p = bdiag[i + 1] + 1; p <= bdiag[i]; p++) av[p] = rtmp[bj[p]];
+    for (PetscInt k = ai[r[i]]; k < ai[r[i] + 1]; k++) rtmp[ic[aj[k]]] = 0.0;
+  }
+  PetscCall(PetscFree(rtmp));
+  PetscCall(ISRestoreIndices(b->row, &r));
+  PetscCall(ISRestoreIndices(b->icol, &ic));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+
+  /* initial guess: U is the upper triangular part of the matrix and L its lower triangular part scaled by the diagonal */
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt p = bdiag[i + 1] + 1; p <= bdiag[i]; p++) parilu->u[cur][upos[p - uoff]] = av[p];
+  }
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt p = bi[i]; p < bi[i + 1]; p++) parilu->l[cur][p] = av[p] / av[bdiag[bj[p]]];
+  }
+
+  for (PetscInt s = 0; s < parilu->sweeps; s++) {
+    const PetscScalar *lold = parilu->l[cur], *uold = parilu->u[cur];
+    PetscScalar       *lnew = parilu->l[1 - cur], *unew = parilu->u[1 - cur];
+
+    PetscPragmaUseOMPKernels(parallel for schedule(dynamic, 64))
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscInt    *lj = bj + bi[i], nl = bi[i + 1] - bi[i];
+      const PetscScalar *lv = lold + bi[i];
+
+      for (PetscInt p = bi[i]; p < bi[i + 1]; p++) {
+        const PetscInt j = bj[p];
+
+        lnew[p] = (av[p] - MatParILUDot_Private(lj, lv, nl, ucr + ucp[j], uold + ucp[j], ucp[j + 1] - ucp[j] - 1)) / uold[ucp[j + 1] - 1];
+      }
+      for (PetscInt p = bdiag[i + 1] + 1; p <= bdiag[i]; p++) {
+        const PetscInt j = bj[p];
+
+        unew[upos[p - uoff]] = av[p] - MatParILUDot_Private(lj, lv, nl, ucr + ucp[j], uold + ucp[j], ucp[j + 1] - ucp[j] - 1);
+      }
+    }
+    cur = 1 - cur;
+  }
+
+  /* store the factors in the layout of the MATSOLVERPETSC factors, with the inverse of the diagonal of U */
+  PetscCall(PetscArraycpy(b->a, parilu->l[cur], n ? bi[n] : 0));
+  for (PetscInt i = 0; i < n; i++) {
+    PetscScalar d;
+
+    for (PetscInt p = bdiag[i + 1] + 1; p < bdiag[i]; p++) b->a[p] = parilu->u[cur][upos[p - uoff]];
+    d = parilu->u[cur][upos[bdiag[i] - uoff]];
+    if (PetscAbsScalar(d) <= info->zeropivot && !PetscIsNanScalar(d)) {
+      PetscCheck(!A->erroriffailure, PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "Zero pivot row %" PetscInt_FMT " value %g tolerance %g", i, (double)PetscAbsScalar(d), (double)info->zeropivot);
+      PetscCall(PetscInfo(A, "Detected zero pivot in factorization in row %" PetscInt_FMT " value %g tolerance %g\n", i, (double)PetscAbsScalar(d), (double)info->zeropivot));
+      B->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+      B->factorerror_zeropivot_value = PetscAbsScalar(d);
+      B->factorerror_zeropivot_row   = i;
+      break;
+    }
+    b->a[bdiag[i]] = 1.0 / d;
+  }
+  PetscCall(PetscLogFlops(parilu->sweeps * 2.0 * b->nz));
+
+  PetscCall(ISIdentity(b->row, &row_identity));
+  PetscCall(ISIdentity(b->icol, &col_identity));
+  if (parilu->solvesweeps) {
+    B->ops->solve          = MatSolve_SeqAIJ_ParILU;
+    B->ops->solvetranspose = NULL;
+  } else {
+    B->ops->solve          = row_identity && col_identity ? MatSolve_SeqAIJ_NaturalOrdering : MatSolve_SeqAIJ;
+    B->ops->solvetranspose = MatSolveTranspose_SeqAIJ;
+    PetscCall(MatSeqAIJLevelsSetUp_Factor(B));
+  }
+  B->ops->solveadd          = NULL;
+  B->ops->solvetransposeadd = NULL;
+  B->ops->matsolve          = NULL;
+  B->ops->matsolvetranspose = NULL;
+  B->assembled              = PETSC_TRUE;
+  B->preallocated           = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_SeqAIJ_ParILU(Mat A, PetscViewer viewer)
+{
+  Mat_ParILU       *parilu;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  PetscCall(MatView_SeqAIJ(A, viewer));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  PetscCall(PetscObjectContainerQuery((PetscObject)A, "MatParILU_Context", (void **)&parilu));
+  if (iascii && parilu) {
+    PetscCall(PetscViewerGetFormat(viewer, &format));
+    if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+      if (parilu->solvesweeps) PetscCall(PetscViewerASCIIPrintf(viewer, "ParILU: %" PetscInt_FMT " fixed-point sweeps of the factorization, %" PetscInt_FMT " Jacobi sweeps per triangular solve\n", parilu->sweeps, parilu->solvesweeps));
+      else PetscCall(PetscViewerASCIIPrintf(viewer, "ParILU: %" PetscInt_FMT " fixed-point sweeps of the factorization, exact triangular solves\n", parilu->sweeps));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ParILU(Mat B, Mat A, IS isrow, IS iscol, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ     *b;
+  Mat_ParILU     *parilu;
+  const PetscInt *bi, *bj, *bdiag;
+  PetscInt        n = A->rmap->n, nzL, nzU, uoff, *next;
+
+  PetscFunctionBegin;
+  PetscCall(MatILUFactorSymbolic_SeqAIJ(B, A, isrow, iscol, info));
+  b     = (Mat_SeqAIJ *)B->data;
+  bi    = b->i;
+  bj    = b->j;
+  bdiag = b->diag;
+  nzL   = n ? bi[n] : 0;
+  nzU   = n ? bdiag[0] - bdiag[n] : 0;
+  uoff  = n ? bdiag[n] + 1 : 0;
+
+  PetscCall(PetscNew(&parilu));
+  parilu->sweeps      = 3;
+  parilu->solvesweeps = 3;
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "ParILU options", "Mat");
+  PetscCall(PetscOptionsInt("-mat_parilu_sweeps", "Number of fixed-point sweeps of the factorization", "MATSOLVERPARILU", parilu->sweeps, &parilu->sweeps, NULL));
+  PetscCall(PetscOptionsInt("-mat_parilu_solve_sweeps", "Number of Jacobi sweeps of the triangular solves, 0 for exact solves", "MATSOLVERPARILU", parilu->solvesweeps, &parilu->solvesweeps, NULL));
+  PetscOptionsEnd();
+  PetscCheck(parilu->sweeps >= 0 && parilu->solvesweeps >= 0, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_OUTOFRANGE, "Number of sweeps cannot be negative");
+
+  /* U by columns, the rows of each column in increasing order so the diagonal is last */
+  PetscCall(PetscMalloc3(n + 1, &parilu->ucp, nzU, &parilu->ucr, nzU, &parilu->upos));
+  PetscCall(PetscCalloc1(n + 1, &next));
+  for (PetscInt p = uoff; p < uoff + nzU; p++) next[bj[p] + 1]++;
+  parilu->ucp[0] = 0;
+  for (PetscInt j = 0; j < n; j++) parilu->ucp[j + 1] = parilu->ucp[j] + next[j + 1];
+  PetscCall(PetscArraycpy(next, parilu->ucp, n));
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt p = bdiag[i + 1] + 1; p <= bdiag[i]; p++) {
+      const PetscInt q = next[bj[p]]++;
+
+      parilu->ucr[q]         = i;
+      parilu->upos[p - uoff] = q;
+    }
+  }
+  PetscCall(PetscFree(next));
+  PetscCall(PetscMalloc6(n ? bdiag[0] + 1 : 0, &parilu->av, nzL, &parilu->l[0], nzL, &parilu->l[1], nzU, &parilu->u[0], nzU, &parilu->u[1], 3 * n, &parilu->work));
+  PetscCall(PetscObjectContainerCompose((PetscObject)B, "MatParILU_Context", parilu, MatParILUDestroy_Private));
+
+  B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_ParILU;
+  B->ops->view            = MatView_SeqAIJ_ParILU;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatFactorGetSolverType_seqaij_parilu(Mat A, MatSolverType *type)
+{
+  PetscFunctionBegin;
+  *type = MATSOLVERPARILU;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_parilu(Mat A, MatFactorType ftype, Mat *B)
+{
+  PetscInt n = A->rmap->n;
+
+  PetscFunctionBegin;
+  PetscCheck(ftype == MAT_FACTOR_ILU, PETSC_COMM_SELF, PETSC_ERR_SUP, "Factor type not supported");
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)A), B));
+  PetscCall(MatSetSizes(*B, n, n, n, n));
+  PetscCall(MatSetType(*B, MATSEQAIJ));
+  PetscCall(MatSetBlockSizesFromMats(*B, A, A));
+  (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqAIJ_ParILU;
+  (*B)->factortype             = ftype;
+  (*B)->canuseordering         = PETSC_TRUE;
+  PetscCall(PetscStrallocpy(MATORDERINGNATURAL, (char **)&(*B)->preferredordering[MAT_FACTOR_ILU]));
+  PetscCall(PetscFree((*B)->solvertype));
+  PetscCall(PetscStrallocpy(MATSOLVERPARILU, &(*B)->solvertype));
+  PetscCall(PetscObjectComposeFunction((PetscObject)*B, "MatFactorGetSolverType_C", MatFactorGetSolverType_seqaij_parilu));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -32,6 +32,7 @@ static PetscErrorCode MatDestroy_MPIBAIJ(Mat mat)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatStoreValues_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatRetrieveValues_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatMPIBAIJSetPreallocation_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatResidualJacobiUpdate_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatMPIBAIJSetPreallocationCSR_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatDiagonalScaleLocal_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatSetHashTableFactor_C", NULL));
@@ -1237,6 +1238,79 @@ static PetscErrorCode MatMult_MPIBAIJ(Mat A, Vec xx, Vec yy)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatResidualJacobiUpdate_MPIBAIJ - Computes y = alpha w + beta x + gamma D (b - A x) in one pass over the block rows of the
+   diagonal block, during the communication of the ghost values of x, and one pass over the nonzero block rows of the off-diagonal block
+*/
+static PetscErrorCode MatResidualJacobiUpdate_MPIBAIJ(Mat A, Vec d, PetscScalar alpha, PetscScalar beta, PetscScalar gamma, Vec b, Vec w, Vec x, Vec y)
+{
+  Mat_MPIBAIJ       *mat = (Mat_MPIBAIJ *)A->data;
+  Mat_SeqBAIJ       *ad  = (Mat_SeqBAIJ *)mat->A->data, *bd = (Mat_SeqBAIJ *)mat->B->data;
+  const PetscInt     bs  = A->rmap->bs, bs2 = ad->bs2, mbs = ad->mbs, *ai = ad->i, *aj = ad->j, *bi = bd->i, *bj = bd->j;
+  const PetscScalar *xa, *ba, *da, *wa = NULL, *la;
+  PetscScalar       *ya, *sum;
+
+  PetscFunctionBegin;
+  PetscCall(VecScatterBegin(mat->Mvctx, x, mat->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  /* the work array of the matrix-vector product of the diagonal block, it holds at least bs entries */
+  if (!ad->mult_work) {
+    const PetscInt k = PetscMax(mat->A->rmap->n, mat->A->cmap->n);
+
+    PetscCall(PetscMalloc1(k + 1, &ad->mult_work));
+  }
+  sum = ad->mult_work;
+  PetscCall(VecGetArrayRead(d, &da));
+  PetscCall(VecGetArrayRead(b, &ba));
+  PetscCall(VecGetArrayRead(x, &xa));
+  if (alpha != 0.0) PetscCall(VecGetArrayRead(w, &wa));
+  PetscCall(VecGetArrayWrite(y, &ya));
+  /* block rows without off-process columns are finished, the others keep their partial residual in y */
+  for (PetscInt ib = 0; ib < mbs; ib++) {
+    for (PetscInt r = 0; r < bs; r++) sum[r] = ba[ib * bs + r];
+    for (PetscInt k = ai[ib]; k < ai[ib + 1]; k++) {
+      const MatScalar   *v  = ad->a + k * bs2;
+      const PetscScalar *xb = xa + aj[k] * bs;
+
+      for (PetscInt c = 0; c < bs; c++) {
+        for (PetscInt r = 0; r < bs; r++) sum[r] -= v[c * bs + r] * xb[c];
+      }
+    }
+    for (PetscInt r = 0, i = ib * bs; r < bs; r++, i++) {
+      if (bi[ib + 1] > bi[ib]) ya[i] = sum[r];
+      else {
+        ya[i] = beta * xa[i] + gamma * da[i] * sum[r];
+        if (wa) ya[i] += alpha * wa[i];
+      }
+    }
+  }
+  PetscCall(VecScatterEnd(mat->Mvctx, x, mat->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCall(VecGetArrayRead(mat->lvec, &la));
+  for (PetscInt ib = 0; ib < mbs; ib++) {
+    if (bi[ib + 1] == bi[ib]) continue;
+    for (PetscInt r = 0; r < bs; r++) sum[r] = ya[ib * bs + r];
+    for (PetscInt k = bi[ib]; k < bi[ib + 1]; k++) {
+      const MatScalar   *v  = bd->a + k * bs2;
+      const PetscScalar *lb = la + bj[k] * bs;
+
+      for (PetscInt c = 0; c < bs; c++) {
+        for (PetscInt r = 0; r < bs; r++) sum[r] -= v[c * bs + r] * lb[c];
+      }
+    }
+    for (PetscInt r = 0, i = ib * bs; r < bs; r++, i++) {
+      ya[i] = beta * xa[i] + gamma * da[i] * sum[r];
+      if (wa) ya[i] += alpha * wa[i];
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * (ad->nz + bd->nz) * bs2 + 6.0 * A->rmap->n));
+  PetscCall(VecRestoreArrayRead(mat->lvec, &la));
+  PetscCall(VecRestoreArrayWrite(y, &ya));
+  if (alpha != 0.0) PetscCall(VecRestoreArrayRead(w, &wa));
+  PetscCall(VecRestoreArrayRead(x, &xa));
+  PetscCall(VecRestoreArrayRead(b, &ba));
+  PetscCall(VecRestoreArrayRead(d, &da));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatMultAdd_MPIBAIJ(Mat A, Vec xx, Vec yy, Vec zz)
 {
   Mat_MPIBAIJ *a = (Mat_MPIBAIJ *)A->data;
@@ -2934,6 +3008,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIBAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatStoreValues_C", MatStoreValues_MPIBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatRetrieveValues_C", MatRetrieveValues_MPIBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatMPIBAIJSetPreallocation_C", MatMPIBAIJSetPreallocation_MPIBAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatResidualJacobiUpdate_C", MatResidualJacobiUpdate_MPIBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatMPIBAIJSetPreallocationCSR_C", MatMPIBAIJSetPreallocationCSR_MPIBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatDiagonalScaleLocal_C", MatDiagonalScaleLocal_MPIBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetHashTableFactor_C", MatSetHashTableFactor_MPIBAIJ));
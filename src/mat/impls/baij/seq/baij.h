@@ -236,6 +236,7 @@ PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_15_ver3(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_15_ver4(Mat, Vec, Vec);
 
 PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_N(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatResidualJacobiUpdate_SeqBAIJ(Mat, Vec, PetscScalar, PetscScalar, PetscScalar, Vec, Vec, Vec, Vec);
 
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_1(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_2(Mat, Vec, Vec, Vec);
@@ -2031,6 +2031,56 @@ PetscErrorCode MatMult_SeqBAIJ_N(Mat A, Vec xx, Vec zz)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatResidualJacobiUpdate_SeqBAIJ - Computes y = alpha w + beta x + gamma D (b - A x), with D a diagonal matrix stored as a vector,
+   in one pass over the block rows of A. This is the step of the Chebyshev smoother with Jacobi preconditioning, see KSPCHEBYSHEV.
+
+   Notes:
+   w is not referenced if alpha is zero. y cannot be x or w.
+*/
+PetscErrorCode MatResidualJacobiUpdate_SeqBAIJ(Mat A, Vec d, PetscScalar alpha, PetscScalar beta, PetscScalar gamma, Vec b, Vec w, Vec x, Vec y)
+{
+  Mat_SeqBAIJ       *a  = (Mat_SeqBAIJ *)A->data;
+  const PetscInt     bs = A->rmap->bs, bs2 = a->bs2, *ai = a->i, *aj = a->j;
+  const PetscScalar *xa, *ba, *da, *wa = NULL;
+  PetscScalar       *ya, *sum;
+
+  PetscFunctionBegin;
+  if (!a->mult_work) {
+    const PetscInt k = PetscMax(A->rmap->n, A->cmap->n);
+
+    PetscCall(PetscMalloc1(k + 1, &a->mult_work));
+  }
+  sum = a->mult_work;
+  PetscCall(VecGetArrayRead(d, &da));
+  PetscCall(VecGetArrayRead(b, &ba));
+  PetscCall(VecGetArrayRead(x, &xa));
+  if (alpha != 0.0) PetscCall(VecGetArrayRead(w, &wa));
+  PetscCall(VecGetArrayWrite(y, &ya));
+  for (PetscInt ib = 0; ib < a->mbs; ib++) {
+    for (PetscInt r = 0; r < bs; r++) sum[r] = ba[ib * bs + r];
+    for (PetscInt k = ai[ib]; k < ai[ib + 1]; k++) {
+      const MatScalar   *v  = a->a + k * bs2; /* the blocks are stored by columns */
+      const PetscScalar *xb = xa + aj[k] * bs;
+
+      for (PetscInt c = 0; c < bs; c++) {
+        for (PetscInt r = 0; r < bs; r++) sum[r] -= v[c * bs + r] * xb[c];
+      }
+    }
+    for (PetscInt r = 0, i = ib * bs; r < bs; r++, i++) {
+      ya[i] = beta * xa[i] + gamma * da[i] * sum[r];
+      if (wa) ya[i] += alpha * wa[i];
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz * bs2 + 6.0 * A->rmap->n));
+  PetscCall(VecRestoreArrayWrite(y, &ya));
+  if (alpha != 0.0) PetscCall(VecRestoreArrayRead(w, &wa));
+  PetscCall(VecRestoreArrayRead(x, &xa));
+  PetscCall(VecRestoreArrayRead(b, &ba));
+  PetscCall(VecRestoreArrayRead(d, &da));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatMultAdd_SeqBAIJ_1(Mat A, Vec xx, Vec yy, Vec zz)
 {
   Mat_SeqBAIJ       *a = (Mat_SeqBAIJ *)A->data;
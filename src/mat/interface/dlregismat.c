@@ -129,6 +129,7 @@ PETSC_INTERN PetscErrorCode MatGetFactor_seqdense_hip(Mat, MatFactorType, Mat *)
 #endif
 PETSC_INTERN PetscErrorCode MatGetFactor_constantdiagonal_petsc(Mat, MatFactorType, Mat *);
 PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_bas(Mat, MatFactorType, Mat *);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_parilu(Mat, MatFactorType, Mat *);
 
 #include <petscbm.h>
 PETSC_INTERN PetscErrorCode PetscBenchCreate_HPL(PetscBench);
@@ -372,6 +373,7 @@ PetscErrorCode MatInitializePackage(void)
 #endif
 
   PetscCall(MatSolverTypeRegister(MATSOLVERBAS, MATSEQAIJ, MAT_FACTOR_ICC, MatGetFactor_seqaij_bas));
+  PetscCall(MatSolverTypeRegister(MATSOLVERPARILU, MATSEQAIJ, MAT_FACTOR_ILU, MatGetFactor_seqaij_parilu));
 
   /*
      Register the external package factorization based solvers
@@ -10161,6 +10161,11 @@ PetscErrorCode MatFactorFactorizeSchurComplement(Mat F)
 
   The deprecated `PETSC_DEFAULT` in `fill` also means use the current value
 
+  For `MATSEQAIJ` matrices `-matptap_via threaded` computes $P^T (A P)$ with row-partitioned products that accumulate a cache-sized
+  block of columns at a time, threaded when PETSc is configured with `--with-openmp-kernels`. The symbolic products are kept for
+  `MAT_REUSE_MATRIX`, at the cost of storing $P^T$ and $A P$. For `MATMPIAIJ` matrices with the default algorithm it may be used for the local products
+  with `-inner_C_loc_mat_product_algorithm threaded` and `-inner_C_oth_mat_product_algorithm threaded`.
+
   Developer Note:
   For matrix types without special implementation the function fallbacks to `MatMatMult()` followed by `MatTransposeMatMult()`.
 
@@ -10312,6 +10317,9 @@ static PetscErrorCode MatProduct_Private(Mat A, Mat B, MatReuse scall, PetscReal
 
   To determine the correct fill value, run with `-info` and search for the string "Fill ratio" to see the value actually needed.
 
+  For `MATSEQAIJ` matrices `-matmatmult_via threaded` splits the rows of C into chunks of equal work, computed concurrently when PETSc is
+  configured with `--with-openmp-kernels`, and accumulates a cache-sized block of columns of B at a time.
+
   In the special case where matrix `B` (and hence `C`) are dense you can create the correctly sized matrix `C` yourself and then call this routine with `MAT_REUSE_MATRIX`,
   rather than first having `MatMatMult()` create it for you. You can NEVER do this if the matrix `C` is sparse.
 
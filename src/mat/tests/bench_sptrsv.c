@@ -0,0 +1,206 @@
+static char help[] = "Driver for benchmarking the level-scheduled sparse triangular solves of ILU(0) factors.";
+
+#include <petscmat.h>
+#include "cJSON.h"
+#include "mmloader.h"
+
+static char *read_file(const char *filename)
+{
+  FILE  *file       = NULL;
+  long   length     = 0;
+  char  *content    = NULL;
+  size_t read_chars = 0;
+
+  /* open in read binary mode */
+  file = fopen(filename, "rb");
+  if (file) {
+    /* get the length */
+    fseek(file, 0, SEEK_END);
+    length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    /* allocate content buffer */
+    content = (char *)malloc((size_t)length + sizeof(""));
+    /* read the file into memory */
+    read_chars          = fread(content, sizeof(char), (size_t)length, file);
+    content[read_chars] = '\0';
+    fclose(file);
+  }
+  return content;
+}
+
+static void write_file(const char *filename, const char *content)
+{
+  FILE *file = NULL;
+  file       = fopen(filename, "w");
+  if (file) {
+    fputs(content, file);
+    fclose(file);
+  }
+}
+
+static int ParseJSON(const char *const inputjsonfile, char ***outputfilenames, int *nmat)
+{
+  char        *content     = read_file(inputjsonfile);
+  cJSON       *matrix_json = NULL;
+  const cJSON *elem = NULL, *item = NULL;
+  char       **filenames;
+  int          i, n;
+  if (!content) return 0;
+  matrix_json = cJSON_Parse(content);
+  if (!matrix_json) return 0;
+  n         = cJSON_GetArraySize(matrix_json);
+  *nmat     = n;
+  filenames = (char **)malloc(sizeof(char *) * n);
+  for (i = 0; i < n; i++) {
+    elem         = cJSON_GetArrayItem(matrix_json, i);
+    item         = cJSON_GetObjectItemCaseSensitive(elem, "filename");
+    filenames[i] = (char *)malloc(sizeof(char) * (strlen(item->valuestring) + 1));
+    strcpy(filenames[i], item->valuestring);
+  }
+  cJSON_Delete(matrix_json);
+  free(content);
+  *outputfilenames = filenames;
+  return 0;
+}
+
+/* Records the average time of a sequential and of a level-scheduled MatSolve() in the "sptrsv" object of each matrix */
+static int UpdateJSON(const char *const inputjsonfile, PetscReal *seq_times, PetscReal *levels_times, PetscInt repetitions)
+{
+  char  *content     = read_file(inputjsonfile);
+  cJSON *matrix_json = NULL;
+  int    i, n;
+  if (!content) return 0;
+  matrix_json = cJSON_Parse(content);
+  if (!matrix_json) return 0;
+  n = cJSON_GetArraySize(matrix_json);
+  for (i = 0; i < n; i++) {
+    cJSON *elem   = cJSON_GetArrayItem(matrix_json, i);
+    cJSON *sptrsv = cJSON_CreateObject();
+
+    cJSON_DeleteItemFromObject(elem, "sptrsv");
+    cJSON_AddItemToObject(elem, "sptrsv", sptrsv);
+    cJSON_AddNumberToObject(sptrsv, "time_sequential", seq_times[i] / repetitions);
+    cJSON_AddNumberToObject(sptrsv, "time_levels", levels_times[i] / repetitions);
+    cJSON_AddNumberToObject(sptrsv, "repetitions", repetitions);
+  }
+  free(content);
+  content = cJSON_Print(matrix_json);
+  write_file(inputjsonfile, content);
+  cJSON_Delete(matrix_json);
+  free(content);
+  return 0;
+}
+
+/* ILU(0) factorization of A, the factor gets the options prefix prefix so level scheduling can be selected for it alone */
+static PetscErrorCode FactorILU(Mat A, const char prefix[], Mat *F)
+{
+  MatFactorInfo info;
+  IS            rowperm, colperm;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatGetFactor(A, MATSOLVERPETSC, MAT_FACTOR_ILU, F));
+  PetscCall(MatSetOptionsPrefix(*F, prefix));
+  PetscCall(MatGetOrdering(A, MATORDERINGNATURAL, &rowperm, &colperm));
+  PetscCall(MatFactorInfoInitialize(&info));
+  info.fill        = 1.0;
+  info.shifttype   = (PetscReal)MAT_SHIFT_NONZERO;
+  info.shiftamount = PETSC_MACHINE_EPSILON * 100;
+  PetscCall(MatILUFactorSymbolic(*F, A, rowperm, colperm, &info));
+  PetscCall(MatLUFactorNumeric(*F, A, &info));
+  PetscCall(ISDestroy(&rowperm));
+  PetscCall(ISDestroy(&colperm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TimedSolve(Mat F, Vec b, Vec x, PetscInt repetitions, PetscReal *time)
+{
+  PetscLogDouble vstart, vend;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatSolve(F, b, x)); /* warm up */
+  PetscCall(PetscTime(&vstart));
+  for (PetscInt i = 0; i < repetitions; i++) PetscCall(MatSolve(F, b, x));
+  PetscCall(PetscTime(&vend));
+  *time = (PetscReal)(vend - vstart);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Times the solves with both factors and checks that they agree */
+static PetscErrorCode BenchSpTRSV(Mat A, const char name[], PetscInt repetitions, PetscReal *seq_time, PetscReal *levels_time)
+{
+  Mat       F, Flevels;
+  Vec       b, x, xlevels;
+  PetscReal norm, err;
+
+  PetscFunctionBeginUser;
+  PetscCall(FactorILU(A, NULL, &F));
+  PetscCall(FactorILU(A, "levels_", &Flevels));
+  PetscCall(MatCreateVecs(A, &x, &b));
+  PetscCall(VecDuplicate(x, &xlevels));
+  PetscCall(VecSet(b, 1.0));
+  PetscCall(TimedSolve(F, b, x, repetitions, seq_time));
+  PetscCall(TimedSolve(Flevels, b, xlevels, repetitions, levels_time));
+  PetscCall(VecNorm(x, NORM_INFINITY, &norm));
+  PetscCall(VecAXPY(xlevels, -1.0, x));
+  PetscCall(VecNorm(xlevels, NORM_INFINITY, &err));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%s: level-scheduled solve %s the sequential solve\n", name, err <= 100 * PETSC_MACHINE_EPSILON * PetscMax(norm, 1.0) ? "agrees with" : "DIFFERS from"));
+  PetscCall(PetscInfo(A, "%s: sequential %g s, level scheduled %g s per solve\n", name, (double)(*seq_time / repetitions), (double)(*levels_time / repetitions)));
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&xlevels));
+  PetscCall(MatDestroy(&F));
+  PetscCall(MatDestroy(&Flevels));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  PetscInt   repetitions = 10;
+  Mat        A;
+  char       filename[PETSC_MAX_PATH_LEN], jfilename[PETSC_MAX_PATH_LEN];
+  char     **filenames = NULL;
+  int        nmat      = 0;
+  PetscBool  flg1, flg2, reorder = PETSC_FALSE;
+  PetscReal *seq_times, *levels_times;
+
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-repetitions", &repetitions, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-reorder", &reorder, NULL));
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-AMTX", filename, PETSC_MAX_PATH_LEN, &flg1));
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-AJSON", jfilename, PETSC_MAX_PATH_LEN, &flg2));
+  PetscCheck(flg1 || flg2, PETSC_COMM_WORLD, PETSC_ERR_USER_INPUT, "Must indicate an input file with the -AMTX or -AJSON depending on the file format");
+  PetscCheck(repetitions > 0, PETSC_COMM_WORLD, PETSC_ERR_USER_INPUT, "Number of repetitions %" PetscInt_FMT " must be positive", repetitions);
+  PetscCall(PetscOptionsSetValue(NULL, "-levels_mat_petsc_solve_levels", "1"));
+  PetscCall(PetscOptionsSetValue(NULL, "-levels_mat_petsc_solve_levels_reorder", reorder ? "1" : "0"));
+  if (flg2) ParseJSON(jfilename, &filenames, &nmat);
+  else nmat = 1;
+  PetscCall(PetscCalloc2(nmat, &seq_times, nmat, &levels_times));
+  for (int i = 0; i < nmat; i++) {
+    const char *name = flg2 ? filenames[i] : filename;
+
+    PetscCall(MatCreateFromMTX(&A, name, PETSC_TRUE));
+    PetscCall(BenchSpTRSV(A, flg2 ? name : "matrix", repetitions, &seq_times[i], &levels_times[i]));
+    PetscCall(MatDestroy(&A));
+  }
+  if (flg2) {
+    UpdateJSON(jfilename, seq_times, levels_times, repetitions);
+    for (int i = 0; i < nmat; i++) free(filenames[i]);
+    free(filenames);
+  }
+  PetscCall(PetscFree2(seq_times, levels_times));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   build:
+      requires: !complex double !windows_compilers !defined(PETSC_USE_64BIT_INDICES)
+      depends: mmloader.c mmio.c cJSON.c
+
+   test:
+      suffix: 1
+      args: -AMTX ${wPETSC_DIR}/share/petsc/datafiles/matrices/amesos2_test_mat0.mtx -reorder {{0 1}}
+      output_file: output/bench_sptrsv_1.out
+
+TEST*/
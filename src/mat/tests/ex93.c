@@ -231,4 +231,9 @@ PetscErrorCode testPTAPRectangular(void)
       args: -matmatmult_via scalable_fast
       output_file: output/ex93_1.out
 
+   test:
+      suffix: threaded
+      args: -matmatmult_via threaded -matptap_via threaded -mat_product_threaded_chunks {{1 2}} -mat_product_threaded_block_size {{1 2 100}}
+      output_file: output/ex93_1.out
+
 TEST*/
@@ -325,6 +325,17 @@ int main(int argc, char **argv)
      args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_mat_product_algorithm rowmerge -inner_offdiag_mat_product_algorithm rowmerge
      output_file: output/ex96_1.out
 
+   test:
+     suffix: threaded
+     args: -Mx 10 -My 5 -Mz 10 -matmatmult_via threaded -matptap_via threaded -mat_product_threaded_chunks {{1 3}} -mat_product_threaded_block_size {{7 1000}}
+     output_file: output/ex96_1.out
+
+   test:
+     suffix: seq_threaded
+     nsize: 3
+     args: -Mx 10 -My 5 -Mz 10 -inner_C_loc_mat_product_algorithm threaded -inner_C_oth_mat_product_algorithm threaded -inner_C_loc_mat_product_threaded_chunks 2 -inner_C_loc_mat_product_threaded_block_size 7
+     output_file: output/ex96_1.out
+
    test:
      suffix: allatonce
      nsize: 3
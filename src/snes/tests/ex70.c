@@ -0,0 +1,148 @@
+static char help[] = "Tests the split local residual of DMDASNESSetFunctionLocalSplit() on the Bratu problem.\n\n";
+
+#include <petscdmda.h>
+#include <petscsnes.h>
+
+typedef struct {
+  PetscReal lambda;   /* Bratu parameter */
+  PetscBool periodic; /* periodic boundaries instead of Dirichlet boundaries */
+  PetscInt  count;    /* number of points evaluated */
+} AppCtx;
+
+static PetscErrorCode FormFunctionLocal2d(DMDALocalInfo *info, PetscScalar **x, PetscScalar **f, AppCtx *user)
+{
+  const PetscReal hx = 1.0 / info->mx, hy = 1.0 / info->my;
+
+  PetscFunctionBeginUser;
+  for (PetscInt j = info->ys; j < info->ys + info->ym; j++)
+    for (PetscInt i = info->xs; i < info->xs + info->xm; i++) {
+      if (!user->periodic && (i == 0 || j == 0 || i == info->mx - 1 || j == info->my - 1)) f[j][i] = x[j][i];
+      else f[j][i] = (2.0 * x[j][i] - x[j][i - 1] - x[j][i + 1]) * hy / hx + (2.0 * x[j][i] - x[j - 1][i] - x[j + 1][i]) * hx / hy - hx * hy * user->lambda * PetscExpScalar(x[j][i]);
+    }
+  user->count += info->xm * info->ym;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FormFunctionLocal3d(DMDALocalInfo *info, PetscScalar ***x, PetscScalar ***f, AppCtx *user)
+{
+  const PetscReal hx = 1.0 / info->mx, hy = 1.0 / info->my, hz = 1.0 / info->mz;
+
+  PetscFunctionBeginUser;
+  for (PetscInt k = info->zs; k < info->zs + info->zm; k++)
+    for (PetscInt j = info->ys; j < info->ys + info->ym; j++)
+      for (PetscInt i = info->xs; i < info->xs + info->xm; i++) {
+        if (!user->periodic && (i == 0 || j == 0 || k == 0 || i == info->mx - 1 || j == info->my - 1 || k == info->mz - 1)) f[k][j][i] = x[k][j][i];
+        else
+          f[k][j][i] = (2.0 * x[k][j][i] - x[k][j][i - 1] - x[k][j][i + 1]) * hy * hz / hx + (2.0 * x[k][j][i] - x[k][j - 1][i] - x[k][j + 1][i]) * hx * hz / hy + (2.0 * x[k][j][i] - x[k - 1][j][i] - x[k + 1][j][i]) * hx * hy / hz - hx * hy * hz * user->lambda * PetscExpScalar(x[k][j][i]);
+      }
+  user->count += info->xm * info->ym * info->zm;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM                  da;
+  SNES                snes;
+  Vec                 x, f, g;
+  AppCtx              user;
+  PetscInt            dim = 2, M = 16, nlocal;
+  PetscReal           nrm, err;
+  PetscRandom         rand;
+  DMDASNESFunctionFn *func;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.lambda   = 6.0;
+  user.periodic = PETSC_FALSE;
+  PetscOptionsBegin(PETSC_COMM_WORLD, "", "Split local residual test options", "SNES");
+  PetscCall(PetscOptionsInt("-dim", "Dimension", NULL, dim, &dim, NULL));
+  PetscCall(PetscOptionsInt("-M", "Number of points in each direction", NULL, M, &M, NULL));
+  PetscCall(PetscOptionsReal("-lambda", "Bratu parameter", NULL, user.lambda, &user.lambda, NULL));
+  PetscCall(PetscOptionsBool("-periodic", "Use periodic boundaries", NULL, user.periodic, &user.periodic, NULL));
+  PetscOptionsEnd();
+
+  if (dim == 2) {
+    const DMBoundaryType bt = user.periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+
+    PetscCall(DMDACreate2d(PETSC_COMM_WORLD, bt, bt, DMDA_STENCIL_STAR, M, M, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, &da));
+    func = (DMDASNESFunctionFn *)FormFunctionLocal2d;
+  } else {
+    const DMBoundaryType bt = user.periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+
+    PetscCall(DMDACreate3d(PETSC_COMM_WORLD, bt, bt, bt, DMDA_STENCIL_STAR, M, M, M, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, NULL, &da));
+    func = (DMDASNESFunctionFn *)FormFunctionLocal3d;
+  }
+  PetscCall(DMSetFromOptions(da));
+  PetscCall(DMSetUp(da));
+  PetscCall(DMCreateGlobalVector(da, &x));
+  PetscCall(VecDuplicate(x, &f));
+  PetscCall(VecDuplicate(x, &g));
+  PetscCall(VecGetLocalSize(x, &nlocal));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rand));
+  PetscCall(VecSetRandom(x, rand));
+  PetscCall(PetscRandomDestroy(&rand));
+
+  PetscCall(SNESCreate(PETSC_COMM_WORLD, &snes));
+  PetscCall(SNESSetDM(snes, da));
+  PetscCall(DMDASNESSetFunctionLocal(da, INSERT_VALUES, func, &user));
+  PetscCall(SNESComputeFunction(snes, x, f));
+  PetscCall(DMDASNESSetFunctionLocalSplit(da, func, NULL, &user));
+  user.count = 0;
+  PetscCall(SNESComputeFunction(snes, x, g));
+  PetscCheck(user.count == nlocal, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Evaluated %" PetscInt_FMT " points instead of %" PetscInt_FMT, user.count, nlocal);
+  PetscCall(VecAXPY(g, -1.0, f));
+  PetscCall(VecNorm(g, NORM_INFINITY, &err));
+  PetscCall(VecNorm(f, NORM_INFINITY, &nrm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Split residual %s\n", err <= 1e-14 * nrm ? "matches" : "differs"));
+
+  /* the periodic Bratu problem has no solution */
+  if (!user.periodic) {
+    PetscCall(SNESSetFromOptions(snes));
+    PetscCall(VecSet(x, 0.0));
+    PetscCall(SNESSolve(snes, NULL, x));
+  }
+
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&f));
+  PetscCall(VecDestroy(&g));
+  PetscCall(SNESDestroy(&snes));
+  PetscCall(DMDestroy(&da));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    args: -snes_converged_reason
+    output_file: output/ex70_1.out
+
+    test:
+      suffix: 1
+
+    test:
+      suffix: 1_par
+      nsize: 4
+
+  testset:
+    args: -dim 3 -M 8 -snes_converged_reason
+    output_file: output/ex70_3d.out
+
+    test:
+      suffix: 3d
+
+    test:
+      suffix: 3d_par
+      nsize: 4
+
+  test:
+    suffix: thin
+    nsize: 3
+    args: -da_processors_x 3 -M 7 -snes_converged_reason
+
+  test:
+    suffix: periodic
+    nsize: 2
+    args: -periodic -dm_view
+
+TEST*/
@@ -0,0 +1,228 @@
+static char help[] = "Tests the Jacobian of DMDA stencil matrices computed by colored differencing on the Bratu problem.\n\n";
+
+#include <petscdmda.h>
+#include <petscsnes.h>
+
+typedef struct {
+  PetscReal lambda;   /* Bratu parameter */
+  PetscBool periodic; /* periodic boundaries instead of Dirichlet boundaries */
+} AppCtx;
+
+/* the box stencil couples the diagonal neighbors through the nonlinear term */
+static PetscErrorCode FormFunctionLocal2d(DMDALocalInfo *info, PetscScalar **x, PetscScalar **f, AppCtx *user)
+{
+  const PetscReal hx = 1.0 / info->mx, hy = 1.0 / info->my;
+
+  PetscFunctionBeginUser;
+  for (PetscInt j = info->ys; j < info->ys + info->ym; j++)
+    for (PetscInt i = info->xs; i < info->xs + info->xm; i++) {
+      if (!user->periodic && (i == 0 || j == 0 || i == info->mx - 1 || j == info->my - 1)) f[j][i] = x[j][i];
+      else {
+        PetscScalar u = x[j][i];
+
+        if (info->st == DMDA_STENCIL_BOX) u += 0.05 * (x[j - 1][i - 1] + x[j + 1][i + 1] - x[j - 1][i + 1] - x[j + 1][i - 1]);
+        f[j][i] = (2.0 * x[j][i] - x[j][i - 1] - x[j][i + 1]) * hy / hx + (2.0 * x[j][i] - x[j - 1][i] - x[j + 1][i]) * hx / hy - hx * hy * user->lambda * PetscExpScalar(u);
+      }
+    }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FormFunctionLocal3d(DMDALocalInfo *info, PetscScalar ***x, PetscScalar ***f, AppCtx *user)
+{
+  const PetscReal hx = 1.0 / info->mx, hy = 1.0 / info->my, hz = 1.0 / info->mz;
+
+  PetscFunctionBeginUser;
+  for (PetscInt k = info->zs; k < info->zs + info->zm; k++)
+    for (PetscInt j = info->ys; j < info->ys + info->ym; j++)
+      for (PetscInt i = info->xs; i < info->xs + info->xm; i++) {
+        if (!user->periodic && (i == 0 || j == 0 || k == 0 || i == info->mx - 1 || j == info->my - 1 || k == info->mz - 1)) f[k][j][i] = x[k][j][i];
+        else
+          f[k][j][i] = (2.0 * x[k][j][i] - x[k][j][i - 1] - x[k][j][i + 1]) * hy * hz / hx + (2.0 * x[k][j][i] - x[k][j - 1][i] - x[k][j + 1][i]) * hx * hz / hy + (2.0 * x[k][j][i] - x[k - 1][j][i] - x[k + 1][j][i]) * hx * hy / hz - hx * hy * hz * user->lambda * PetscExpScalar(x[k][j][i]);
+      }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FormJacobianLocal2d(DMDALocalInfo *info, PetscScalar **x, Mat B, AppCtx *user)
+{
+  const PetscReal hx = 1.0 / info->mx, hy = 1.0 / info->my;
+
+  PetscFunctionBeginUser;
+  for (PetscInt j = info->ys; j < info->ys + info->ym; j++)
+    for (PetscInt i = info->xs; i < info->xs + info->xm; i++) {
+      MatStencil  row = {0, j, i, 0}, col[9];
+      PetscScalar v[9], u = x[j][i], e;
+      PetscInt    n = 0;
+
+      if (!user->periodic && (i == 0 || j == 0 || i == info->mx - 1 || j == info->my - 1)) {
+        v[0] = 1.0;
+        PetscCall(MatSetValuesStencil(B, 1, &row, 1, &row, v, INSERT_VALUES));
+        continue;
+      }
+      if (info->st == DMDA_STENCIL_BOX) u += 0.05 * (x[j - 1][i - 1] + x[j + 1][i + 1] - x[j - 1][i + 1] - x[j + 1][i - 1]);
+      e = hx * hy * user->lambda * PetscExpScalar(u);
+      col[n] = (MatStencil){0, j, i, 0};
+      v[n++] = 2.0 * (hy / hx + hx / hy) - e;
+      col[n] = (MatStencil){0, j, i - 1, 0};
+      v[n++] = -hy / hx;
+      col[n] = (MatStencil){0, j, i + 1, 0};
+      v[n++] = -hy / hx;
+      col[n] = (MatStencil){0, j - 1, i, 0};
+      v[n++] = -hx / hy;
+      col[n] = (MatStencil){0, j + 1, i, 0};
+      v[n++] = -hx / hy;
+      if (info->st == DMDA_STENCIL_BOX) {
+        col[n] = (MatStencil){0, j - 1, i - 1, 0};
+        v[n++] = -0.05 * e;
+        col[n] = (MatStencil){0, j + 1, i + 1, 0};
+        v[n++] = -0.05 * e;
+        col[n] = (MatStencil){0, j - 1, i + 1, 0};
+        v[n++] = 0.05 * e;
+        col[n] = (MatStencil){0, j + 1, i - 1, 0};
+        v[n++] = 0.05 * e;
+      }
+      PetscCall(MatSetValuesStencil(B, 1, &row, n, col, v, INSERT_VALUES));
+    }
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* compares the products of the stencil Jacobian with those of the MATAIJ Jacobian computed by MatFDColoring, up to the different differencing
+   parameters, or with those of the analytic Jacobian in 2d, which does not need a DMDA coloring */
+static PetscErrorCode CompareJacobians(SNES snes, DM da, Vec x, PetscBool analytic, AppCtx *user)
+{
+  Mat       A, B;
+  Vec       v, y, z;
+  PetscReal nrm, err;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMDASetStencilMatrix(da, PETSC_TRUE));
+  PetscCall(DMCreateMatrix(da, &A));
+  PetscCall(DMDASetStencilMatrix(da, PETSC_FALSE));
+  PetscCall(DMCreateMatrix(da, &B));
+  PetscCall(SNESComputeJacobian(snes, x, A, A));
+  if (analytic) {
+    DMDALocalInfo info;
+    Vec           xl;
+    PetscScalar **xa;
+
+    PetscCall(DMDAGetLocalInfo(da, &info));
+    PetscCheck(info.dim == 2, PETSC_COMM_WORLD, PETSC_ERR_SUP, "The analytic Jacobian is only implemented in 2d");
+    PetscCall(DMGetLocalVector(da, &xl));
+    PetscCall(DMGlobalToLocal(da, x, INSERT_VALUES, xl));
+    PetscCall(DMDAVecGetArrayRead(da, xl, &xa));
+    PetscCall(FormJacobianLocal2d(&info, xa, B, user));
+    PetscCall(DMDAVecRestoreArrayRead(da, xl, &xa));
+    PetscCall(DMRestoreLocalVector(da, &xl));
+  } else PetscCall(SNESComputeJacobian(snes, x, B, B));
+  PetscCall(VecDuplicate(x, &v));
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecDuplicate(x, &z));
+  PetscCall(VecSetRandom(v, NULL));
+  PetscCall(MatMult(A, v, y));
+  PetscCall(MatMult(B, v, z));
+  PetscCall(VecAXPY(y, -1.0, z));
+  PetscCall(VecNorm(y, NORM_INFINITY, &err));
+  PetscCall(VecNorm(z, NORM_INFINITY, &nrm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Colored differencing %s %s\n", err <= 1e-6 * nrm ? "matches" : "differs from", analytic ? "the analytic Jacobian" : "MatFDColoring"));
+  PetscCall(VecDestroy(&v));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM              da;
+  SNES            snes;
+  Mat             J;
+  Vec             x;
+  AppCtx          user;
+  PetscInt        dim = 2, M = 15;
+  PetscBool       box = PETSC_FALSE, analytic = PETSC_FALSE;
+  DMBoundaryType  bt;
+  DMDAStencilType st;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.lambda   = 6.0;
+  user.periodic = PETSC_FALSE;
+  PetscOptionsBegin(PETSC_COMM_WORLD, "", "Colored differencing test options", "SNES");
+  PetscCall(PetscOptionsInt("-dim", "Dimension", NULL, dim, &dim, NULL));
+  PetscCall(PetscOptionsInt("-M", "Number of points in each direction", NULL, M, &M, NULL));
+  PetscCall(PetscOptionsBool("-box", "Use the box stencil", NULL, box, &box, NULL));
+  PetscCall(PetscOptionsReal("-lambda", "Bratu parameter", NULL, user.lambda, &user.lambda, NULL));
+  PetscCall(PetscOptionsBool("-periodic", "Use periodic boundaries", NULL, user.periodic, &user.periodic, NULL));
+  PetscCall(PetscOptionsBool("-analytic", "Compare with the analytic Jacobian instead of MatFDColoring", NULL, analytic, &analytic, NULL));
+  PetscOptionsEnd();
+
+  bt = user.periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+  st = box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR;
+  if (dim == 2) PetscCall(DMDACreate2d(PETSC_COMM_WORLD, bt, bt, st, M, M, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, &da));
+  else PetscCall(DMDACreate3d(PETSC_COMM_WORLD, bt, bt, bt, st, M, M, M, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, NULL, &da));
+  PetscCall(DMSetFromOptions(da));
+  PetscCall(DMSetUp(da));
+  PetscCall(DMCreateGlobalVector(da, &x));
+
+  PetscCall(SNESCreate(PETSC_COMM_WORLD, &snes));
+  PetscCall(SNESSetDM(snes, da));
+  PetscCall(DMDASNESSetFunctionLocal(da, INSERT_VALUES, (DMDASNESFunctionFn *)(dim == 2 ? (PetscErrorCode (*)(void))FormFunctionLocal2d : (PetscErrorCode (*)(void))FormFunctionLocal3d), &user));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(CompareJacobians(snes, da, x, analytic, &user));
+
+  /* the periodic Bratu problem has no solution */
+  if (!user.periodic) {
+    PetscCall(DMDASetStencilMatrix(da, PETSC_TRUE));
+    PetscCall(SNESSetFromOptions(snes));
+    PetscCall(VecSet(x, 0.0));
+    PetscCall(SNESSolve(snes, NULL, x));
+    PetscCall(SNESGetJacobian(snes, &J, NULL, NULL, NULL));
+    PetscCall(MatView(J, PETSC_VIEWER_STDOUT_WORLD));
+  }
+
+  PetscCall(VecDestroy(&x));
+  PetscCall(SNESDestroy(&snes));
+  PetscCall(DMDestroy(&da));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  test:
+    suffix: 1
+    args: -snes_converged_reason -ksp_type cg -pc_type jacobi -ksp_rtol 1e-6
+
+  test:
+    suffix: box
+    nsize: 2
+    args: -box -snes_converged_reason -ksp_type gmres -pc_type sor -ksp_rtol 1e-6
+
+  test:
+    suffix: 3d
+    nsize: 2
+    args: -dim 3 -M 8 -snes_converged_reason -ksp_type cg -pc_type jacobi -ksp_rtol 1e-6
+
+  # the 5 colors of the star stencil need a multiple of 5 points
+  testset:
+    nsize: 2
+    args: -periodic
+    output_file: output/ex71_periodic.out
+
+    test:
+      suffix: periodic
+      args: -M 10
+
+    test:
+      suffix: periodic_box
+      args: -M 12 -box
+
+  # the DMDA coloring of MatFDColoring cannot handle the box stencil on 10 periodic points, while the linear coloring can
+  test:
+    suffix: periodic_box_10
+    nsize: 2
+    args: -periodic -box -M 10 -analytic
+
+TEST*/
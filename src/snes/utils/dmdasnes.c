@@ -14,6 +14,10 @@ typedef struct {
   DMDASNESJacobianVecFn  *jacobianlocalvec;
   DMDASNESObjectiveVecFn *objectivelocalvec;
 
+  /* split version evaluating the interior points during the ghost update */
+  DMDASNESFunctionFn *residuallocalinterior;
+  DMDASNESFunctionFn *residuallocalboundary;
+
   /* user contexts */
   void      *residuallocalctx;
   void      *jacobianlocalctx;
@@ -54,6 +58,37 @@ static PetscErrorCode DMDASNESGetContext(DM dm, DMSNES sdm, DMSNES_DA **dmdasnes
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* the interior points only read owned values, so they are evaluated on the global vector while the ghost points are communicated */
+static PetscErrorCode SNESComputeFunctionSplit_DMDA(SNES snes, DM dm, DMSNES_DA *dmdasnes, Vec X, Vec F)
+{
+  DMDASNESFunctionFn *boundaryfn = dmdasnes->residuallocalboundary ? dmdasnes->residuallocalboundary : dmdasnes->residuallocalinterior;
+  DMDALocalInfo       interior, boundary[6];
+  PetscInt            nb;
+  Vec                 Xloc;
+  void               *x, *f, *rctx;
+
+  PetscFunctionBegin;
+  PetscCall(DMDAGetLocalInfoSplit(dm, &interior, &nb, boundary));
+  rctx = dmdasnes->residuallocalctx ? dmdasnes->residuallocalctx : snes->user;
+  PetscCall(DMGetLocalVector(dm, &Xloc));
+  PetscCall(PetscLogEventBegin(SNES_FunctionEval, snes, X, F, 0));
+  PetscCall(DMGlobalToLocalBegin(dm, X, INSERT_VALUES, Xloc));
+  PetscCall(DMDAVecGetArray(dm, F, &f));
+  if (interior.xm && interior.ym && interior.zm) {
+    PetscCall(DMDAVecGetArrayRead(dm, X, &x));
+    PetscCallBack("SNES DMDA local callback interior function", (*dmdasnes->residuallocalinterior)(&interior, x, f, rctx));
+    PetscCall(DMDAVecRestoreArrayRead(dm, X, &x));
+  }
+  PetscCall(DMGlobalToLocalEnd(dm, X, INSERT_VALUES, Xloc));
+  PetscCall(DMDAVecGetArrayRead(dm, Xloc, &x));
+  for (PetscInt b = 0; b < nb; ++b) PetscCallBack("SNES DMDA local callback boundary function", (*boundaryfn)(&boundary[b], x, f, rctx));
+  PetscCall(DMDAVecRestoreArrayRead(dm, Xloc, &x));
+  PetscCall(DMDAVecRestoreArray(dm, F, &f));
+  PetscCall(PetscLogEventEnd(SNES_FunctionEval, snes, X, F, 0));
+  PetscCall(DMRestoreLocalVector(dm, &Xloc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode SNESComputeFunction_DMDA(SNES snes, Vec X, Vec F, void *ctx)
 {
   DM            dm;
@@ -66,8 +101,13 @@ static PetscErrorCode SNESComputeFunction_DMDA(SNES snes, Vec X, Vec F, void *ct
   PetscValidHeaderSpecific(snes, SNES_CLASSID, 1);
   PetscValidHeaderSpecific(X, VEC_CLASSID, 2);
   PetscValidHeaderSpecific(F, VEC_CLASSID, 3);
-  PetscCheck(dmdasnes->residuallocal || dmdasnes->residuallocalvec, PetscObjectComm((PetscObject)snes), PETSC_ERR_PLIB, "Corrupt context");
+  PetscCheck(dmdasnes->residuallocal || dmdasnes->residuallocalvec || dmdasnes->residuallocalinterior, PetscObjectComm((PetscObject)snes), PETSC_ERR_PLIB, "Corrupt context");
   PetscCall(SNESGetDM(snes, &dm));
+  if (dmdasnes->residuallocalinterior) {
+    PetscCall(SNESComputeFunctionSplit_DMDA(snes, dm, dmdasnes, X, F));
+    PetscCall(VecFlag(F, snes->domainerror));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(DMGetLocalVector(dm, &Xloc));
   PetscCall(DMGlobalToLocalBegin(dm, X, INSERT_VALUES, Xloc));
   PetscCall(DMGlobalToLocalEnd(dm, X, INSERT_VALUES, Xloc));
@@ -143,6 +183,13 @@ static PetscErrorCode SNESComputeObjective_DMDA(SNES snes, Vec X, PetscReal *ob,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode SNESComputeFunction_DMDAStencil(Vec X, Vec F, void *ctx)
+{
+  PetscFunctionBegin;
+  PetscCall(SNESComputeFunction((SNES)ctx, X, F));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* Routine is called by example, hence must be labeled PETSC_EXTERN */
 PETSC_EXTERN PetscErrorCode SNESComputeJacobian_DMDA(SNES snes, Vec X, Mat A, Mat B, void *ctx)
 {
@@ -151,11 +198,14 @@ PETSC_EXTERN PetscErrorCode SNESComputeJacobian_DMDA(SNES snes, Vec X, Mat A, Ma
   DMDALocalInfo info;
   Vec           Xloc;
   void         *x, *jctx;
+  void (*isstencil)(void) = NULL;
 
   PetscFunctionBegin;
-  PetscCheck(dmdasnes->residuallocal || dmdasnes->residuallocalvec, PetscObjectComm((PetscObject)snes), PETSC_ERR_PLIB, "Corrupt context");
+  PetscCheck(dmdasnes->residuallocal || dmdasnes->residuallocalvec || dmdasnes->residuallocalinterior, PetscObjectComm((PetscObject)snes), PETSC_ERR_PLIB, "Corrupt context");
   PetscCall(SNESGetDM(snes, &dm));
   jctx = dmdasnes->jacobianlocalctx ? dmdasnes->jacobianlocalctx : snes->user;
+  /* the stencil matrices of DMDASetStencilMatrix() are computed by colored differencing into their coefficients */
+  PetscCall(PetscObjectQueryFunction((PetscObject)B, "DMDAStencilMatrixGetContext_C", &isstencil));
   if (dmdasnes->jacobianlocal || dmdasnes->jacobianlocalvec) {
     PetscCall(DMGetLocalVector(dm, &Xloc));
     PetscCall(DMGlobalToLocalBegin(dm, X, INSERT_VALUES, Xloc));
@@ -168,6 +218,9 @@ PETSC_EXTERN PetscErrorCode SNESComputeJacobian_DMDA(SNES snes, Vec X, Mat A, Ma
       PetscCall(DMDAVecRestoreArray(dm, Xloc, &x));
     }
     PetscCall(DMRestoreLocalVector(dm, &Xloc));
+  } else if (isstencil) {
+    /* the function of the SNES is not guaranteed to hold its value at X for every type and line search, so it is evaluated again */
+    PetscCall(DMDAStencilMatrixSetCoefficientsFD(B, X, NULL, SNESComputeFunction_DMDAStencil, snes));
   } else {
     MatFDColoring fdcoloring;
     PetscCall(PetscObjectQuery((PetscObject)dm, "DMDASNES_FDCOLORING", (PetscObject *)&fdcoloring));
@@ -243,6 +296,10 @@ PetscErrorCode DMDASNESSetFunctionLocal(DM dm, InsertMode imode, PetscErrorCode
   dmdasnes->residuallocal      = func;
   dmdasnes->residuallocalctx   = ctx;
 
+  /* replaces a split function */
+  dmdasnes->residuallocalinterior = NULL;
+  dmdasnes->residuallocalboundary = NULL;
+
   PetscCall(DMSNESSetFunction(dm, SNESComputeFunction_DMDA, dmdasnes));
   if (!sdm->ops->computejacobian) { /* Call us for the Jacobian too, can be overridden by the user. */
     PetscCall(DMSNESSetJacobian(dm, SNESComputeJacobian_DMDA, dmdasnes));
@@ -285,6 +342,60 @@ PetscErrorCode DMDASNESSetFunctionLocalVec(DM dm, InsertMode imode, PetscErrorCo
   dmdasnes->residuallocalvec   = func;
   dmdasnes->residuallocalctx   = ctx;
 
+  /* replaces a split function */
+  dmdasnes->residuallocalinterior = NULL;
+  dmdasnes->residuallocalboundary = NULL;
+
+  PetscCall(DMSNESSetFunction(dm, SNESComputeFunction_DMDA, dmdasnes));
+  if (!sdm->ops->computejacobian) { /* Call us for the Jacobian too, can be overridden by the user. */
+    PetscCall(DMSNESSetJacobian(dm, SNESComputeJacobian_DMDA, dmdasnes));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  DMDASNESSetFunctionLocalSplit - set a local residual evaluation function for use with `DMDA` that is split into interior and boundary
+  kernels, so the communication of the ghost points is overlapped with the evaluation at the interior points
+
+  Logically Collective
+
+  Input Parameters:
++ dm       - `DM` to associate callback with
+. interior - local residual evaluation on the interior points, see `DMDASNESSetFunctionLocal()` for the calling sequence
+. boundary - local residual evaluation on the boundary points, or `NULL` to use `interior`
+- ctx      - optional context for local residual evaluation
+
+  Level: intermediate
+
+  Notes:
+  The residual is computed on the points owned by this MPI process, as with `INSERT_VALUES` in `DMDASNESSetFunctionLocal()`. The functions
+  are called with a `DMDALocalInfo` whose `xs`, `xm`, `ys`, `ym`, `zs`, and `zm` describe the box of points to evaluate, see
+  `DMDAGetLocalInfoSplit()`, so a function written for `DMDASNESSetFunctionLocal()` that loops over these ranges can be passed for both.
+
+  `DMGlobalToLocalBegin()` is called first, then `interior` is called once on the interior points, whose stencil only contains owned points,
+  with the state given by the array of the global vector. After `DMGlobalToLocalEnd()`, `boundary` is called on each box of the remaining
+  points with the array of the ghosted local vector. The residual of the interior points must therefore only read the state within the
+  stencil width of the `DMDA`.
+
+.seealso: [](ch_snes), `DMDA`, `DMDASNESSetFunctionLocal()`, `DMDAGetLocalInfoSplit()`, `DMDASNESSetJacobianLocal()`, `DMSNESSetFunction()`
+@*/
+PetscErrorCode DMDASNESSetFunctionLocalSplit(DM dm, DMDASNESFunctionFn *interior, DMDASNESFunctionFn *boundary, void *ctx)
+{
+  DMSNES     sdm;
+  DMSNES_DA *dmdasnes;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscCall(DMGetDMSNESWrite(dm, &sdm));
+  PetscCall(DMDASNESGetContext(dm, sdm, &dmdasnes));
+
+  dmdasnes->residuallocalimode    = INSERT_VALUES;
+  dmdasnes->residuallocal         = NULL;
+  dmdasnes->residuallocalvec      = NULL;
+  dmdasnes->residuallocalinterior = interior;
+  dmdasnes->residuallocalboundary = boundary;
+  dmdasnes->residuallocalctx      = ctx;
+
   PetscCall(DMSNESSetFunction(dm, SNESComputeFunction_DMDA, dmdasnes));
   if (!sdm->ops->computejacobian) { /* Call us for the Jacobian too, can be overridden by the user. */
     PetscCall(DMSNESSetJacobian(dm, SNESComputeJacobian_DMDA, dmdasnes));
@@ -8,10 +8,18 @@ typedef struct {
   PetscInt  flowcontrol; /* allow only <flowcontrol> messages outstanding at a time while doing IO */
   PetscBool skipheader;  /* don't write header, only raw data */
 #if defined(PETSC_HAVE_MPIIO)
-  PetscBool  usempiio;
-  MPI_File   mfdes; /* ignored unless using MPI IO */
-  MPI_File   mfsub; /* subviewer support */
-  MPI_Offset moff;
+  PetscBool    usempiio;
+  MPI_File     mfdes; /* ignored unless using MPI IO */
+  MPI_File     mfsub; /* subviewer support */
+  MPI_Offset   moff;
+  PetscBool    async;       /* write with MPI_File_iwrite_at() from staging buffers */
+  PetscInt     asyncmax;    /* maximum number of pending writes before a write blocks */
+  PetscInt     asyncn;      /* number of pending writes */
+  MPI_Request *asyncreqs;   /* requests of the pending writes */
+  void       **asyncbufs;   /* staging buffers of the pending writes */
+  PetscInt     asyncwrites; /* number of writes issued asynchronously */
+  PetscInt     asyncstalls; /* number of writes that had to wait for a free slot */
+  PetscInt64   asyncbytes;  /* number of bytes written asynchronously */
 #endif
   char         *filename;            /* file name */
   PetscFileMode filemode;            /* read/write/append mode */
@@ -43,17 +51,90 @@ static PetscErrorCode PetscViewerBinaryClearFunctionList(PetscViewer v)
 #if defined(PETSC_HAVE_MPIIO)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMPIIO_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMPIIO_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetAsync_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetAsync_C", NULL));
 #endif
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 #if defined(PETSC_HAVE_MPIIO)
+/* Frees the staging buffers of completed writes and compacts the queue; if wait is true, blocks until at least one write completes */
+static PetscErrorCode PetscViewerBinaryAsyncProgress_Private(PetscViewer_Binary *vbinary, PetscBool wait)
+{
+  PetscMPIInt i, n, ndone, *done;
+  PetscInt    k;
+
+  PetscFunctionBegin;
+  if (!vbinary->asyncn) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMPIIntCast(vbinary->asyncn, &n));
+  PetscCall(PetscMalloc1(n, &done));
+  if (wait) PetscCallMPI(MPI_Waitsome(n, vbinary->asyncreqs, &ndone, done, MPI_STATUSES_IGNORE));
+  else PetscCallMPI(MPI_Testsome(n, vbinary->asyncreqs, &ndone, done, MPI_STATUSES_IGNORE));
+  if (ndone != MPI_UNDEFINED) {
+    for (i = 0; i < ndone; ++i) PetscCall(PetscFree(vbinary->asyncbufs[done[i]]));
+  }
+  PetscCall(PetscFree(done));
+  for (i = 0, k = 0; i < n; ++i) {
+    if (vbinary->asyncreqs[i] == MPI_REQUEST_NULL) continue;
+    vbinary->asyncreqs[k] = vbinary->asyncreqs[i];
+    vbinary->asyncbufs[k] = vbinary->asyncbufs[i];
+    ++k;
+  }
+  vbinary->asyncn = k;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Completes all pending asynchronous writes of this process */
+static PetscErrorCode PetscViewerBinaryAsyncWaitAll_Private(PetscViewer_Binary *vbinary)
+{
+  PetscMPIInt n;
+  PetscInt    i;
+
+  PetscFunctionBegin;
+  if (!vbinary->asyncn) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMPIIntCast(vbinary->asyncn, &n));
+  PetscCallMPI(MPI_Waitall(n, vbinary->asyncreqs, MPI_STATUSES_IGNORE));
+  for (i = 0; i < vbinary->asyncn; ++i) PetscCall(PetscFree(vbinary->asyncbufs[i]));
+  vbinary->asyncn = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Copies data into a staging buffer (converted to the big-endian file format) and starts a nonblocking write of it at the given offset,
+   so that the caller may reuse data immediately. If the queue is full, waits until one of the pending writes completes.
+*/
+static PetscErrorCode PetscViewerBinaryAsyncWrite_Private(PetscViewer_Binary *vbinary, MPI_Offset off, const void *data, PetscMPIInt cnt, MPI_Datatype mdtype, PetscDataType dtype)
+{
+  PETSC_UNUSED MPI_Aint lb;
+  MPI_Aint              dsize;
+  void                 *buf;
+
+  PetscFunctionBegin;
+  if (!cnt) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!vbinary->asyncreqs) PetscCall(PetscMalloc2(vbinary->asyncmax, &vbinary->asyncreqs, vbinary->asyncmax, &vbinary->asyncbufs));
+  PetscCall(PetscViewerBinaryAsyncProgress_Private(vbinary, PETSC_FALSE));
+  if (vbinary->asyncn == vbinary->asyncmax) {
+    PetscCall(PetscViewerBinaryAsyncProgress_Private(vbinary, PETSC_TRUE));
+    vbinary->asyncstalls++;
+  }
+  PetscCallMPI(MPI_Type_get_extent(mdtype, &lb, &dsize));
+  PetscCall(PetscMalloc((size_t)dsize * cnt, &buf));
+  PetscCall(PetscMemcpy(buf, data, (size_t)dsize * cnt));
+  if (!PetscBinaryBigEndian()) PetscCall(PetscByteSwap(buf, dtype, cnt));
+  PetscCallMPI(MPI_File_iwrite_at(vbinary->mfdes, off, buf, cnt, mdtype, &vbinary->asyncreqs[vbinary->asyncn]));
+  vbinary->asyncbufs[vbinary->asyncn++] = buf;
+  vbinary->asyncwrites++;
+  vbinary->asyncbytes += (PetscInt64)dsize * cnt;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PetscViewerBinarySyncMPIIO(PetscViewer viewer)
 {
   PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
 
   PetscFunctionBegin;
   if (vbinary->filemode == FILE_MODE_READ) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerBinaryAsyncWaitAll_Private(vbinary));
   if (vbinary->mfsub != MPI_FILE_NULL) PetscCallMPI(MPI_File_sync(vbinary->mfsub));
   if (vbinary->mfdes != MPI_FILE_NULL) {
     PetscCallMPI(MPI_Barrier(PetscObjectComm((PetscObject)viewer)));
@@ -70,6 +151,10 @@ static PetscErrorCode PetscViewerGetSubViewer_Binary(PetscViewer viewer, MPI_Com
 
   PetscFunctionBegin;
   PetscCall(PetscViewerSetUp(viewer));
+#if defined(PETSC_HAVE_MPIIO)
+  /* complete the pending asynchronous writes of all processes, so that the subviewer of process zero writes after them */
+  if (vbinary->async) PetscCall(PetscViewerBinarySyncMPIIO(viewer));
+#endif
 
   /* Return subviewer in process zero */
   PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)viewer), &rank));
@@ -111,6 +196,11 @@ static PetscErrorCode PetscViewerGetSubViewer_Binary(PetscViewer viewer, MPI_Com
     obinary->mfdes = vbinary->mfsub;
     obinary->mfsub = MPI_FILE_NULL;
     obinary->moff  = vbinary->moff;
+    /* Subviewer writes are synchronous, it must not share the staging queue of the parent */
+    obinary->async     = PETSC_FALSE;
+    obinary->asyncn    = 0;
+    obinary->asyncreqs = NULL;
+    obinary->asyncbufs = NULL;
   }
 #endif
 
@@ -235,6 +325,10 @@ PetscErrorCode PetscViewerBinaryAddMPIIOOffset(PetscViewer viewer, MPI_Offset of
 
   Level: advanced
 
+  Note:
+  If the viewer writes asynchronously, see `PetscViewerBinarySetAsync()`, the pending writes of this process are completed before
+  the descriptor is returned, so that it may be used, for example, with `MPI_File_set_view()`
+
 .seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinaryOpen()`, `PetscViewerBinaryGetInfoPointer()`, `PetscViewerBinaryGetUseMPIIO()`, `PetscViewerBinarySetUseMPIIO()`, `PetscViewerBinaryGetMPIIOOffset()`
 @*/
 PetscErrorCode PetscViewerBinaryGetMPIIODescriptor(PetscViewer viewer, MPI_File *fdes)
@@ -246,7 +340,8 @@ PetscErrorCode PetscViewerBinaryGetMPIIODescriptor(PetscViewer viewer, MPI_File
   PetscAssertPointer(fdes, 2);
   PetscCall(PetscViewerSetUp(viewer));
   vbinary = (PetscViewer_Binary *)viewer->data;
-  *fdes   = vbinary->mfdes;
+  PetscCall(PetscViewerBinaryAsyncWaitAll_Private(vbinary));
+  *fdes = vbinary->mfdes;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 #endif
@@ -329,6 +424,108 @@ static PetscErrorCode PetscViewerBinaryGetUseMPIIO_Binary(PetscViewer viewer, Pe
 }
 #endif
 
+/*@
+  PetscViewerBinarySetAsync - Sets a binary viewer to write asynchronously, so that the caller does not wait for the file system
+  while writing, for example, checkpoints of a time integration
+
+  Logically Collective
+
+  Input Parameters:
++ viewer     - the `PetscViewer`; must be a `PETSCVIEWERBINARY`
+. async      - `PETSC_TRUE` to write asynchronously
+- maxpending - the maximum number of writes of a process that may be pending at the same time, or `PETSC_DETERMINE` to keep the current value (defaults to 8)
+
+  Options Database Keys:
++ -viewer_binary_async                    - <true or false> flag for writing asynchronously
+- -viewer_binary_async_max_pending <num> - maximum number of pending writes of a process
+
+  Level: advanced
+
+  Notes:
+  Asynchronous writing requires MPI-IO, and turns it on. Each write copies the data into a staging buffer in the binary file
+  format and starts a nonblocking `MPI_File_iwrite_at()` of that buffer, so the data (for example the array of a `Vec` passed to `VecView()`)
+  may be modified as soon as the write call returns. When `maxpending` writes are pending, the next write waits for one of them to complete,
+  which bounds the memory used for staging.
+
+  The pending writes are completed by `PetscViewerFlush()`, which is the completion barrier, and when the viewer is closed or destroyed.
+  `PetscViewerGetSubViewer()` also completes the pending writes of all processes before the subviewer writes.
+  Since writes are independent rather than collective, this may be slower than collective MPI-IO on file systems that rely on collective buffering;
+  whether the writes actually overlap computation depends on the asynchronous progress of the MPI implementation.
+
+  If MPI-IO is not available this function has no effect.
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinaryGetAsync()`, `PetscViewerBinarySetUseMPIIO()`, `PetscViewerFlush()`, `PetscViewerBinaryOpen()`
+@*/
+PetscErrorCode PetscViewerBinarySetAsync(PetscViewer viewer, PetscBool async, PetscInt maxpending)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(viewer, async, 2);
+  PetscValidLogicalCollectiveInt(viewer, maxpending, 3);
+  PetscTryMethod(viewer, "PetscViewerBinarySetAsync_C", (PetscViewer, PetscBool, PetscInt), (viewer, async, maxpending));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_MPIIO)
+static PetscErrorCode PetscViewerBinarySetAsync_Binary(PetscViewer viewer, PetscBool async, PetscInt maxpending)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+
+  PetscFunctionBegin;
+  if (maxpending != PETSC_DETERMINE) {
+    PetscCheck(maxpending > 0, PetscObjectComm((PetscObject)viewer), PETSC_ERR_ARG_OUTOFRANGE, "Maximum number of pending writes must be positive, %" PetscInt_FMT " was set", maxpending);
+    if (maxpending != vbinary->asyncmax) {
+      PetscCall(PetscViewerBinaryAsyncWaitAll_Private(vbinary));
+      PetscCall(PetscFree2(vbinary->asyncreqs, vbinary->asyncbufs));
+      vbinary->asyncmax = maxpending;
+    }
+  }
+  if (async) PetscCall(PetscViewerBinarySetUseMPIIO_Binary(viewer, PETSC_TRUE));
+  else PetscCall(PetscViewerBinaryAsyncWaitAll_Private(vbinary));
+  vbinary->async = async;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+/*@
+  PetscViewerBinaryGetAsync - Returns whether the binary viewer writes asynchronously
+
+  Not Collective
+
+  Input Parameter:
+. viewer - `PetscViewer` context, obtained from `PetscViewerBinaryOpen()`; must be a `PETSCVIEWERBINARY`
+
+  Output Parameters:
++ async      - `PETSC_TRUE` if writes are asynchronous
+- maxpending - the maximum number of writes of a process that may be pending at the same time, or `NULL`
+
+  Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinarySetAsync()`, `PetscViewerBinaryGetUseMPIIO()`
+@*/
+PetscErrorCode PetscViewerBinaryGetAsync(PetscViewer viewer, PetscBool *async, PetscInt *maxpending)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscAssertPointer(async, 2);
+  *async = PETSC_FALSE;
+  if (maxpending) *maxpending = 0;
+  PetscTryMethod(viewer, "PetscViewerBinaryGetAsync_C", (PetscViewer, PetscBool *, PetscInt *), (viewer, async, maxpending));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_MPIIO)
+static PetscErrorCode PetscViewerBinaryGetAsync_Binary(PetscViewer viewer, PetscBool *async, PetscInt *maxpending)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+
+  PetscFunctionBegin;
+  *async = vbinary->async;
+  if (maxpending) *maxpending = vbinary->asyncmax;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 /*@
   PetscViewerBinarySetFlowControl - Sets how many messages are allowed to be outstanding at the same time during parallel IO reads/writes
 
@@ -752,6 +949,13 @@ static PetscErrorCode PetscViewerFileClose_BinaryMPIIO(PetscViewer v)
   PetscViewer_Binary *vbinary = (PetscViewer_Binary *)v->data;
 
   PetscFunctionBegin;
+  PetscCall(PetscViewerBinaryAsyncWaitAll_Private(vbinary));
+  if (vbinary->asyncwrites) {
+    PetscCall(PetscInfo(v, "Completed %" PetscInt_FMT " asynchronous writes of %" PetscInt64_FMT " bytes, %" PetscInt_FMT " of them waited for a free slot\n", vbinary->asyncwrites, vbinary->asyncbytes, vbinary->asyncstalls));
+    vbinary->asyncwrites = 0;
+    vbinary->asyncstalls = 0;
+    vbinary->asyncbytes  = 0;
+  }
   if (vbinary->mfdes != MPI_FILE_NULL) PetscCallMPI(MPI_File_close(&vbinary->mfdes));
   if (vbinary->mfsub != MPI_FILE_NULL) PetscCallMPI(MPI_File_close(&vbinary->mfsub));
   vbinary->moff = 0;
@@ -819,12 +1023,29 @@ static PetscErrorCode PetscViewerFileClose_Binary(PetscViewer v)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PetscViewerFlush_Binary(PetscViewer v)
+{
+#if defined(PETSC_HAVE_MPIIO)
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)v->data;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_MPIIO)
+  /* complete the pending asynchronous writes of all processes */
+  if (vbinary->async && v->setupcalled) PetscCall(PetscViewerBinarySyncMPIIO(v));
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PetscViewerDestroy_Binary(PetscViewer v)
 {
   PetscViewer_Binary *vbinary = (PetscViewer_Binary *)v->data;
 
   PetscFunctionBegin;
   PetscCall(PetscViewerFileClose_Binary(v));
+#if defined(PETSC_HAVE_MPIIO)
+  PetscCall(PetscFree2(vbinary->asyncreqs, vbinary->asyncbufs));
+#endif
   PetscCall(PetscFree(vbinary->filename));
   PetscCall(PetscFree(vbinary));
   PetscCall(PetscViewerBinaryClearFunctionList(v));
@@ -854,7 +1075,8 @@ static PetscErrorCode PetscViewerDestroy_Binary(PetscViewer v)
 . -viewer_binary_skip_info       - true to skip opening an info file
 . -viewer_binary_skip_options    - true to not use options database while creating viewer
 . -viewer_binary_skip_header     - true to skip output object headers to the file
-- -viewer_binary_mpiio           - true to use MPI-IO for input and output to the file (more scalable for large problems)
+. -viewer_binary_mpiio           - true to use MPI-IO for input and output to the file (more scalable for large problems)
+- -viewer_binary_async           - true to write the file asynchronously with MPI-IO, see `PetscViewerBinarySetAsync()`
 
   Level: beginner
 
@@ -899,7 +1121,10 @@ static PetscErrorCode PetscViewerBinaryWriteReadMPIIO(PetscViewer viewer, void *
   PetscCall(PetscMPIIntCast(num, &cnt));
   PetscCall(PetscDataTypeToMPIDataType(dtype, &mdtype));
   if (write) {
-    if (rank == 0) PetscCall(MPIU_File_write_at(mfdes, vbinary->moff, data, cnt, mdtype, &status));
+    if (rank == 0) {
+      if (vbinary->async) PetscCall(PetscViewerBinaryAsyncWrite_Private(vbinary, vbinary->moff, data, cnt, mdtype, dtype));
+      else PetscCall(MPIU_File_write_at(mfdes, vbinary->moff, data, cnt, mdtype, &status));
+    }
   } else {
     if (rank == 0) {
       PetscCall(MPIU_File_read_at(mfdes, vbinary->moff, data, cnt, mdtype, &status));
@@ -1018,9 +1243,10 @@ static PetscErrorCode PetscViewerBinaryWriteReadAll(PetscViewer viewer, PetscBoo
   PetscCall(PetscViewerBinaryGetUseMPIIO(viewer, &useMPIIO));
 #if defined(PETSC_HAVE_MPIIO)
   if (useMPIIO) {
-    MPI_File    mfdes;
-    MPI_Offset  off;
-    PetscMPIInt cnt;
+    PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+    MPI_File            mfdes;
+    MPI_Offset          off;
+    PetscMPIInt         cnt;
 
     if (start == PETSC_DETERMINE) {
       PetscInt64 pcnt = count;
@@ -1032,12 +1258,15 @@ static PetscErrorCode PetscViewerBinaryWriteReadAll(PetscViewer viewer, PetscBoo
       PetscCallMPI(MPI_Bcast(&total, 1, MPIU_INT64, size - 1, comm));
     }
     PetscCall(PetscMPIIntCast(count, &cnt));
-    PetscCall(PetscViewerBinaryGetMPIIODescriptor(viewer, &mfdes));
     PetscCall(PetscViewerBinaryGetMPIIOOffset(viewer, &off));
     off += (MPI_Offset)(start * dsize);
-    if (write) {
+    if (write && vbinary->async) {
+      PetscCall(PetscViewerBinaryAsyncWrite_Private(vbinary, off, data, cnt, mdtype, dtype));
+    } else if (write) {
+      PetscCall(PetscViewerBinaryGetMPIIODescriptor(viewer, &mfdes));
       PetscCall(MPIU_File_write_at_all(mfdes, off, data, cnt, mdtype, MPI_STATUS_IGNORE));
     } else {
+      PetscCall(PetscViewerBinaryGetMPIIODescriptor(viewer, &mfdes));
       PetscCall(MPIU_File_read_at_all(mfdes, off, data, cnt, mdtype, MPI_STATUS_IGNORE));
     }
     off = (MPI_Offset)(total * dsize);
@@ -1481,6 +1710,9 @@ static PetscErrorCode PetscViewerView_Binary(PetscViewer v, PetscViewer viewer)
   PetscCall(PetscViewerBinaryGetUseMPIIO(v, &usempiio));
   PetscCall(PetscViewerASCIIPrintf(viewer, "Filename: %s\n", fname));
   PetscCall(PetscViewerASCIIPrintf(viewer, "Mode: %s (%s)\n", fmode, usempiio ? "mpiio" : "stdio"));
+#if defined(PETSC_HAVE_MPIIO)
+  if (vbinary->async) PetscCall(PetscViewerASCIIPrintf(viewer, "Asynchronous writes: at most %" PetscInt_FMT " pending per process\n", vbinary->asyncmax));
+#endif
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1501,8 +1733,17 @@ static PetscErrorCode PetscViewerSetFromOptions_Binary(PetscViewer viewer, Petsc
   PetscCall(PetscOptionsBool("-viewer_binary_skip_header", "Skip writing/reading header information", "PetscViewerBinarySetSkipHeader", binary->skipheader, &binary->skipheader, NULL));
 #if defined(PETSC_HAVE_MPIIO)
   PetscCall(PetscOptionsBool("-viewer_binary_mpiio", "Use MPI-IO functionality to write/read binary file", "PetscViewerBinarySetUseMPIIO", binary->usempiio, &binary->usempiio, NULL));
+  {
+    PetscBool async      = binary->async;
+    PetscInt  maxpending = binary->asyncmax;
+
+    PetscCall(PetscOptionsBool("-viewer_binary_async", "Write binary file asynchronously with MPI-IO", "PetscViewerBinarySetAsync", async, &async, NULL));
+    PetscCall(PetscOptionsInt("-viewer_binary_async_max_pending", "Maximum number of pending asynchronous writes of a process", "PetscViewerBinarySetAsync", maxpending, &maxpending, NULL));
+    PetscCall(PetscViewerBinarySetAsync_Binary(viewer, async, maxpending));
+  }
 #else
   PetscCall(PetscOptionsBool("-viewer_binary_mpiio", "Use MPI-IO functionality to write/read binary file (NOT AVAILABLE)", "PetscViewerBinarySetUseMPIIO", PETSC_FALSE, &flg, NULL));
+  PetscCall(PetscOptionsBool("-viewer_binary_async", "Write binary file asynchronously with MPI-IO (NOT AVAILABLE)", "PetscViewerBinarySetAsync", PETSC_FALSE, &flg, NULL));
 #endif
   PetscOptionsHeadEnd();
   binary->setfromoptionscalled = PETSC_TRUE;
@@ -1532,7 +1773,7 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   v->ops->destroy          = PetscViewerDestroy_Binary;
   v->ops->view             = PetscViewerView_Binary;
   v->ops->setup            = PetscViewerSetUp_Binary;
-  v->ops->flush            = NULL; /* Should we support Flush() ? */
+  v->ops->flush            = PetscViewerFlush_Binary;
   v->ops->getsubviewer     = PetscViewerGetSubViewer_Binary;
   v->ops->restoresubviewer = PetscViewerRestoreSubViewer_Binary;
   v->ops->read             = PetscViewerBinaryRead;
@@ -1542,6 +1783,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   vbinary->usempiio = PETSC_FALSE;
   vbinary->mfdes    = MPI_FILE_NULL;
   vbinary->mfsub    = MPI_FILE_NULL;
+  vbinary->async    = PETSC_FALSE;
+  vbinary->asyncmax = 8;
 #endif
   vbinary->filename        = NULL;
   vbinary->filemode        = FILE_MODE_UNDEFINED;
@@ -1571,6 +1814,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
 #if defined(PETSC_HAVE_MPIIO)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMPIIO_C", PetscViewerBinaryGetUseMPIIO_Binary));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMPIIO_C", PetscViewerBinarySetUseMPIIO_Binary));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetAsync_C", PetscViewerBinaryGetAsync_Binary));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetAsync_C", PetscViewerBinarySetAsync_Binary));
 #endif
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -68,6 +68,7 @@ static PetscErrorCode PetscViewerHDF5CheckNamedObject_Internal(PetscViewer viewe
 static PetscErrorCode PetscViewerSetFromOptions_HDF5(PetscViewer v, PetscOptionItems *PetscOptionsObject)
 {
   PetscBool         flg  = PETSC_FALSE, set;
+  PetscInt          level;
   PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)v->data;
 
   PetscFunctionBegin;
@@ -76,6 +77,9 @@ static PetscErrorCode PetscViewerSetFromOptions_HDF5(PetscViewer v, PetscOptionI
   PetscCall(PetscOptionsBool("-viewer_hdf5_sp_output", "Force data to be written in single precision", "PetscViewerHDF5SetSPOutput", hdf5->spoutput, &hdf5->spoutput, NULL));
   PetscCall(PetscOptionsBool("-viewer_hdf5_collective", "Enable collective transfer mode", "PetscViewerHDF5SetCollective", flg, &flg, &set));
   if (set) PetscCall(PetscViewerHDF5SetCollective(v, flg));
+  PetscCall(PetscOptionsRangeInt("-viewer_hdf5_compression", "Deflate level for new datasets, 0 for no compression", "PetscViewerHDF5SetCompression", hdf5->compress, &level, &set, 0, 9));
+  if (set) PetscCall(PetscViewerHDF5SetCompression(v, level));
+  PetscCall(PetscOptionsBool("-viewer_hdf5_dataset_flush", "Flush the file after each dataset is written", "PetscViewerHDF5SetDatasetFlush", hdf5->datasetFlush, &hdf5->datasetFlush, NULL));
   flg = PETSC_FALSE;
   PetscCall(PetscOptionsBool("-viewer_hdf5_default_timestepping", "Set default timestepping state", "PetscViewerHDF5SetDefaultTimestepping", flg, &flg, &set));
   if (set) PetscCall(PetscViewerHDF5SetDefaultTimestepping(v, flg));
@@ -95,6 +99,8 @@ static PetscErrorCode PetscViewerView_HDF5(PetscViewer v, PetscViewer viewer)
   PetscCall(PetscViewerHDF5GetCollective(v, &flg));
   PetscCall(PetscViewerASCIIPrintf(viewer, "MPI-IO transfer mode: %s\n", flg ? "collective" : "independent"));
   PetscCall(PetscViewerASCIIPrintf(viewer, "Default timestepping: %s\n", PetscBools[hdf5->defTimestepping]));
+  if (hdf5->compress) PetscCall(PetscViewerASCIIPrintf(viewer, "Deflate compression level: %" PetscInt_FMT "\n", hdf5->compress));
+  if (!hdf5->datasetFlush) PetscCall(PetscViewerASCIIPrintf(viewer, "File flushed only by PetscViewerFlush()\n"));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -140,6 +146,10 @@ static PetscErrorCode PetscViewerDestroy_HDF5(PetscViewer viewer)
   PetscCall(PetscObjectComposeFunction((PetscObject)viewer, "PetscViewerHDF5SetSPOutput_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)viewer, "PetscViewerHDF5SetCollective_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)viewer, "PetscViewerHDF5GetCollective_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)viewer, "PetscViewerHDF5SetCompression_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)viewer, "PetscViewerHDF5GetCompression_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)viewer, "PetscViewerHDF5SetDatasetFlush_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)viewer, "PetscViewerHDF5GetDatasetFlush_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)viewer, "PetscViewerHDF5GetDefaultTimestepping_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)viewer, "PetscViewerHDF5SetDefaultTimestepping_C", NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -393,6 +403,205 @@ PetscErrorCode PetscViewerHDF5GetCollective(PetscViewer viewer, PetscBool *flg)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PetscViewerHDF5SetCompression_HDF5(PetscViewer viewer, PetscInt level)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+  PetscMPIInt       size;
+
+  PetscFunctionBegin;
+  PetscCheck(level >= 0 && level <= 9, PetscObjectComm((PetscObject)viewer), PETSC_ERR_ARG_OUTOFRANGE, "Deflate level %" PetscInt_FMT " must be in [0, 9]", level);
+  hdf5->compress = level;
+  /* HDF5 writes filtered datasets in parallel only with collective transfers */
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)viewer), &size));
+  if (level && size > 1) PetscCall(PetscViewerHDF5SetCollective_HDF5(viewer, PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PetscViewerHDF5SetCompression - Compress datasets created by the viewer with the deflate (gzip) filter.
+
+  Logically Collective; level must contain common value
+
+  Input Parameters:
++ viewer - the `PetscViewer`; if it is not `PETSCVIEWERHDF5` then this command is ignored
+- level  - the deflate level in [0, 9]; 0 (default) disables compression
+
+  Options Database Key:
+. -viewer_hdf5_compression <level> - set the deflate level
+
+  Level: intermediate
+
+  Notes:
+  Distributed `Vec` and `IS` datasets are chunked so that the chunk boundaries lie on the process boundaries whenever the local
+  sizes share a large common divisor, in particular each process writes a single chunk when the local sizes are equal; then no
+  chunk is shared by two processes and compression does not serialize them. Otherwise the chunks have the largest local size. In
+  parallel, HDF5 only supports filtered writes with collective transfers, so this turns on `PetscViewerHDF5SetCollective()`.
+  Reading a compressed file needs no special setting.
+
+  If HDF5 was built without the deflate filter, the datasets are written uncompressed.
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5GetCompression()`, `PetscViewerHDF5SetCollective()`, `PetscViewerHDF5SetDatasetFlush()`
+@*/
+PetscErrorCode PetscViewerHDF5SetCompression(PetscViewer viewer, PetscInt level)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(viewer, level, 2);
+  PetscTryMethod(viewer, "PetscViewerHDF5SetCompression_C", (PetscViewer, PetscInt), (viewer, level));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscViewerHDF5GetCompression_HDF5(PetscViewer viewer, PetscInt *level)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  *level = hdf5->compress;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PetscViewerHDF5GetCompression - Get the deflate level used for datasets created by the viewer.
+
+  Not Collective
+
+  Input Parameter:
+. viewer - the `PETSCVIEWERHDF5` `PetscViewer`
+
+  Output Parameter:
+. level - the deflate level, 0 means no compression
+
+  Level: intermediate
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5SetCompression()`
+@*/
+PetscErrorCode PetscViewerHDF5GetCompression(PetscViewer viewer, PetscInt *level)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscAssertPointer(level, 2);
+  PetscUseMethod(viewer, "PetscViewerHDF5GetCompression_C", (PetscViewer, PetscInt *), (viewer, level));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscViewerHDF5SetDatasetFlush_HDF5(PetscViewer viewer, PetscBool flg)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  hdf5->datasetFlush = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PetscViewerHDF5SetDatasetFlush - Flush the HDF5 file after each `Vec` or `IS` dataset is written.
+
+  Logically Collective; flg must contain common value
+
+  Input Parameters:
++ viewer - the `PetscViewer`; if it is not `PETSCVIEWERHDF5` then this command is ignored
+- flg    - `PETSC_TRUE` (default) to flush after every dataset, `PETSC_FALSE` to leave flushing to `PetscViewerFlush()` and `PetscViewerDestroy()`
+
+  Options Database Key:
+. -viewer_hdf5_dataset_flush - turns on (true) or off (false) flushing after each dataset
+
+  Level: intermediate
+
+  Note:
+  A flush synchronizes the metadata of the whole file across all processes. Checkpoints that write many datasets, such as a
+  `DMPLEX` with its labels, sections and fields, are considerably faster with `PETSC_FALSE`, at the price that the file is
+  only guaranteed to be complete after the next `PetscViewerFlush()`.
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5GetDatasetFlush()`, `PetscViewerFlush()`, `PetscViewerHDF5SetCompression()`
+@*/
+PetscErrorCode PetscViewerHDF5SetDatasetFlush(PetscViewer viewer, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(viewer, flg, 2);
+  PetscTryMethod(viewer, "PetscViewerHDF5SetDatasetFlush_C", (PetscViewer, PetscBool), (viewer, flg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscViewerHDF5GetDatasetFlush_HDF5(PetscViewer viewer, PetscBool *flg)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  *flg = hdf5->datasetFlush;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PetscViewerHDF5GetDatasetFlush - Return whether the HDF5 file is flushed after each dataset is written.
+
+  Not Collective
+
+  Input Parameter:
+. viewer - the `PETSCVIEWERHDF5` `PetscViewer`
+
+  Output Parameter:
+. flg - the flag
+
+  Level: intermediate
+
+.seealso: [](sec_viewers), `PETSCVIEWERHDF5`, `PetscViewerHDF5SetDatasetFlush()`
+@*/
+PetscErrorCode PetscViewerHDF5GetDatasetFlush(PetscViewer viewer, PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscAssertPointer(flg, 2);
+  PetscUseMethod(viewer, "PetscViewerHDF5GetDatasetFlush_C", (PetscViewer, PetscBool *), (viewer, flg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Chunk length of the distributed dimension of a dataset whose process p owns the blocks [range[p], range[p+1])/bs. The largest
+  length dividing all process offsets puts every chunk boundary on a process boundary, so no chunk is written by two processes;
+  it is used unless it splits the largest local part into more than 4 chunks, in which case chunks of the largest local size are used.
+*/
+PetscErrorCode PetscViewerHDF5GetChunkLength_Internal(PetscMPIInt size, const PetscInt range[], PetscInt bs, hsize_t *chunk)
+{
+  PetscInt g = 0, maxLocal = 0;
+
+  PetscFunctionBegin;
+  for (PetscMPIInt r = 0; r < size; ++r) {
+    PetscInt a = g, b = range[r + 1] / bs;
+
+    maxLocal = PetscMax(maxLocal, (range[r + 1] - range[r]) / bs);
+    if (r == size - 1) break;
+    while (b) {
+      const PetscInt t = a % b;
+
+      a = b;
+      b = t;
+    }
+    g = a;
+  }
+  if (!g || 4 * g < maxLocal) g = maxLocal;
+  PetscCall(PetscHDF5IntCast(PetscMax(1, g), chunk));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Dataset creation properties shared by all PETSc objects: the given chunking and, if requested, compression */
+PetscErrorCode PetscViewerHDF5CreateDatasetPList_Internal(PetscViewer viewer, int ndims, const hsize_t chunkDims[], hid_t *dcpl)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
+
+  PetscFunctionBegin;
+  PetscCallHDF5Return(*dcpl, H5Pcreate, (H5P_DATASET_CREATE));
+  PetscCallHDF5(H5Pset_chunk, (*dcpl, ndims, chunkDims));
+  if (hdf5->compress) {
+    htri_t avail;
+
+    PetscCallHDF5ReturnNoCheck(avail, H5Zfilter_avail, (H5Z_FILTER_DEFLATE));
+    if (avail > 0) PetscCallHDF5(H5Pset_deflate, (*dcpl, (unsigned)hdf5->compress));
+    else PetscCall(PetscInfo(viewer, "HDF5 deflate filter not available, writing uncompressed datasets\n"));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PetscViewerFileSetName_HDF5(PetscViewer viewer, const char name[])
 {
   PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5 *)viewer->data;
@@ -568,6 +777,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_HDF5(PetscViewer v)
   hdf5->filename         = NULL;
   hdf5->timestep         = -1;
   hdf5->groups           = NULL;
+  hdf5->compress         = 0;
+  hdf5->datasetFlush     = PETSC_TRUE;
 
   PetscCallHDF5Return(hdf5->dxpl_id, H5Pcreate, (H5P_DATASET_XFER));
 
@@ -579,6 +790,10 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_HDF5(PetscViewer v)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetSPOutput_C", PetscViewerHDF5SetSPOutput_HDF5));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetCollective_C", PetscViewerHDF5SetCollective_HDF5));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5GetCollective_C", PetscViewerHDF5GetCollective_HDF5));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetCompression_C", PetscViewerHDF5SetCompression_HDF5));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5GetCompression_C", PetscViewerHDF5GetCompression_HDF5));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetDatasetFlush_C", PetscViewerHDF5SetDatasetFlush_HDF5));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5GetDatasetFlush_C", PetscViewerHDF5GetDatasetFlush_HDF5));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5GetDefaultTimestepping_C", PetscViewerHDF5GetDefaultTimestepping_HDF5));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerHDF5SetDefaultTimestepping_C", PetscViewerHDF5SetDefaultTimestepping_HDF5));
   PetscFunctionReturn(PETSC_SUCCESS);
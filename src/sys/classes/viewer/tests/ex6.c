@@ -204,5 +204,9 @@ int main(int argc, char **args)
        requires: mpiio
        suffix: mpiio
        args: -viewer_binary_mpiio 1
+     test:
+       requires: mpiio
+       suffix: mpiio_async
+       args: -viewer_binary_async -viewer_binary_async_max_pending 2
 
 TEST*/
@@ -0,0 +1,648 @@
+/*
+  Code for integrating a batch of many small independent ODE systems with linearly implicit Rosenbrock-W methods.
+
+  Each system has its own time step and error control. The systems being integrated are packed into lanes of
+  interleaved arrays, component c of lane b at c * ld + b, so that the loops over the lanes vectorize; a lane
+  whose system reached the end of the step is refilled with the next system, or with the last lane once all the
+  systems are assigned, so that the active lanes stay contiguous.
+*/
+#include <petsc/private/tsimpl.h> /*I   "petscts.h"   I*/
+
+typedef struct {
+  TSBatchRHSFunctionFn *rhsfunction;
+  TSBatchRHSJacobianFn *rhsjacobian;
+  void                 *funP, *jacP;
+  PetscInt              m;      /* number of unknowns of each system */
+  PetscInt              nsys;   /* number of local systems */
+  PetscInt              ld;     /* number of lanes */
+  char                 *rosw_type;
+
+  /* method, see TSStep_RosW() for the use of the coefficients in transformed variables */
+  PetscInt         order, s;
+  PetscReal        gamma;
+  const PetscReal *ASum, *At, *GammaInv, *bt, *bembedt;
+
+  PetscReal   *h;                    /* [nsys] step size of each system, kept from one step to the next */
+  PetscInt    *lsys, *lstat, *lpiv;  /* system, status and pivots of each lane */
+  PetscReal   *lt, *lh, *lhc, *lerr; /* time, next step size, step size of the attempt and error of each lane */
+  PetscReal   *tstage;
+  PetscScalar *X, *Z, *F, *F0, *Y, *J, *work;
+
+  PetscInt nacc, nrej, nfail, nrhs, njac; /* statistics */
+} TS_Batch;
+
+enum {
+  LANE_ACTIVE,
+  LANE_DONE,
+  LANE_FAILED
+};
+
+static PetscErrorCode TSBatchComputeRHS(TS ts, PetscInt n, const PetscReal t[], const PetscScalar x[], PetscScalar f[])
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCallBack("TSBATCH callback right-hand side", (*batch->rhsfunction)(ts, n, batch->ld, batch->lsys, t, x, f, batch->funP));
+  batch->nrhs++;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* J = shift I - df/dx for the n active lanes, by finite differences of all the lanes at once if there is no Jacobian function */
+static PetscErrorCode TSBatchComputeMatrix(TS ts, PetscInt n)
+{
+  TS_Batch    *batch = (TS_Batch *)ts->data;
+  PetscInt     m = batch->m, ld = batch->ld;
+  PetscScalar *J = batch->J, *X = batch->X, *Z = batch->Z, *F = batch->F, *F0 = batch->F0;
+  PetscScalar *d = batch->work;
+
+  PetscFunctionBegin;
+  if (batch->rhsjacobian) {
+    PetscCallBack("TSBATCH callback Jacobian", (*batch->rhsjacobian)(ts, n, ld, batch->lsys, batch->lt, X, J, batch->jacP));
+  } else {
+    PetscCall(TSBatchComputeRHS(ts, n, batch->lt, X, F0));
+    PetscCall(PetscArraycpy(Z, X, m * ld));
+    for (PetscInt c = 0; c < m; c++) {
+      for (PetscInt b = 0; b < n; b++) {
+        d[b] = PETSC_SQRT_MACHINE_EPSILON * PetscMax(PetscAbsScalar(X[c * ld + b]), 1.0);
+        Z[c * ld + b] += d[b];
+      }
+      PetscCall(TSBatchComputeRHS(ts, n, batch->lt, Z, F));
+      for (PetscInt r = 0; r < m; r++)
+        for (PetscInt b = 0; b < n; b++) J[(r * m + c) * ld + b] = (F[r * ld + b] - F0[r * ld + b]) / d[b];
+      for (PetscInt b = 0; b < n; b++) Z[c * ld + b] = X[c * ld + b];
+    }
+  }
+  batch->njac++;
+  for (PetscInt i = 0; i < m * m; i++)
+    for (PetscInt b = 0; b < n; b++) J[i * ld + b] = -J[i * ld + b];
+  for (PetscInt r = 0; r < m; r++)
+    for (PetscInt b = 0; b < n; b++) J[(r * m + r) * ld + b] += 1.0 / (batch->lhc[b] * batch->gamma);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* LU factorization with partial pivoting of the matrix of each lane, a lane with a singular matrix fails its attempt */
+static PetscErrorCode TSBatchFactor(TS ts, PetscInt n)
+{
+  TS_Batch    *batch = (TS_Batch *)ts->data;
+  PetscInt     m = batch->m, ld = batch->ld, *piv = batch->lpiv;
+  PetscScalar *A = batch->J, *inv = batch->work;
+
+  PetscFunctionBegin;
+  for (PetscInt k = 0; k < m; k++) {
+    for (PetscInt b = 0; b < n; b++) {
+      PetscInt  p    = k;
+      PetscReal vmax = PetscAbsScalar(A[(k * m + k) * ld + b]);
+
+      for (PetscInt i = k + 1; i < m; i++) {
+        if (PetscAbsScalar(A[(i * m + k) * ld + b]) > vmax) {
+          p    = i;
+          vmax = PetscAbsScalar(A[(i * m + k) * ld + b]);
+        }
+      }
+      piv[k * ld + b] = p;
+      if (p != k) {
+        for (PetscInt c = 0; c < m; c++) {
+          PetscScalar tmp         = A[(k * m + c) * ld + b];
+          A[(k * m + c) * ld + b] = A[(p * m + c) * ld + b];
+          A[(p * m + c) * ld + b] = tmp;
+        }
+      }
+      if (vmax == 0.0) {
+        batch->lerr[b]          = PETSC_INFINITY;
+        A[(k * m + k) * ld + b] = 1.0;
+      }
+      inv[b] = 1.0 / A[(k * m + k) * ld + b];
+    }
+    for (PetscInt i = k + 1; i < m; i++) {
+      for (PetscInt b = 0; b < n; b++) A[(i * m + k) * ld + b] *= inv[b];
+      for (PetscInt c = k + 1; c < m; c++)
+        for (PetscInt b = 0; b < n; b++) A[(i * m + c) * ld + b] -= A[(i * m + k) * ld + b] * A[(k * m + c) * ld + b];
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSolve(TS ts, PetscInt n, PetscScalar x[])
+{
+  TS_Batch          *batch = (TS_Batch *)ts->data;
+  PetscInt           m = batch->m, ld = batch->ld;
+  const PetscInt    *piv = batch->lpiv;
+  const PetscScalar *A   = batch->J;
+
+  PetscFunctionBegin;
+  for (PetscInt k = 0; k < m; k++) {
+    for (PetscInt b = 0; b < n; b++) {
+      PetscInt p = piv[k * ld + b];
+
+      if (p != k) {
+        PetscScalar tmp = x[k * ld + b];
+        x[k * ld + b]   = x[p * ld + b];
+        x[p * ld + b]   = tmp;
+      }
+    }
+  }
+  for (PetscInt i = 1; i < m; i++)
+    for (PetscInt k = 0; k < i; k++)
+      for (PetscInt b = 0; b < n; b++) x[i * ld + b] -= A[(i * m + k) * ld + b] * x[k * ld + b];
+  for (PetscInt i = m - 1; i >= 0; i--) {
+    for (PetscInt k = i + 1; k < m; k++)
+      for (PetscInt b = 0; b < n; b++) x[i * ld + b] -= A[(i * m + k) * ld + b] * x[k * ld + b];
+    for (PetscInt b = 0; b < n; b++) x[i * ld + b] /= A[(i * m + i) * ld + b];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* one step attempt of all the active lanes up to at most tend, each lane accepts or rejects its own step */
+static PetscErrorCode TSBatchAttempt(TS ts, PetscInt n, PetscReal tend)
+{
+  TS_Batch          *batch = (TS_Batch *)ts->data;
+  PetscInt           m = batch->m, ld = batch->ld, s = batch->s;
+  const PetscReal   *At = batch->At, *GammaInv = batch->GammaInv, *ASum = batch->ASum;
+  PetscScalar       *X = batch->X, *Z = batch->Z, *F = batch->F, *Y = batch->Y;
+  PetscReal         *hc = batch->lhc, *err = batch->lerr, atol, rtol, safety, reject_safety, low, high, hmin, hmax;
+  const PetscScalar *va = NULL, *vr = NULL;
+  Vec                vatol, vrtol;
+  TSAdapt            adapt;
+
+  PetscFunctionBegin;
+  PetscCall(TSGetAdapt(ts, &adapt));
+  PetscCall(TSAdaptGetSafety(adapt, &safety, &reject_safety));
+  PetscCall(TSAdaptGetClip(adapt, &low, &high));
+  PetscCall(TSAdaptGetStepLimits(adapt, &hmin, &hmax));
+  for (PetscInt b = 0; b < n; b++) {
+    hc[b]  = PetscMin(batch->lh[b], tend - batch->lt[b]);
+    err[b] = 0;
+  }
+  PetscCall(TSBatchComputeMatrix(ts, n));
+  PetscCall(TSBatchFactor(ts, n));
+  for (PetscInt i = 0; i < s; i++) {
+    PetscScalar *Yi = Y + i * m * ld;
+
+    PetscCall(PetscArraycpy(Z, X, m * ld));
+    for (PetscInt j = 0; j < i; j++) {
+      const PetscScalar *Yj = Y + j * m * ld;
+
+      if (At[i * s + j] == 0.0) continue;
+      for (PetscInt c = 0; c < m; c++)
+        for (PetscInt b = 0; b < n; b++) Z[c * ld + b] += At[i * s + j] * Yj[c * ld + b];
+    }
+    for (PetscInt b = 0; b < n; b++) batch->tstage[b] = batch->lt[b] + ASum[i] * hc[b];
+    PetscCall(TSBatchComputeRHS(ts, n, batch->tstage, Z, Yi));
+    for (PetscInt j = 0; j < i; j++) {
+      const PetscScalar *Yj = Y + j * m * ld;
+
+      if (GammaInv[i * s + j] == 0.0) continue;
+      for (PetscInt c = 0; c < m; c++)
+        for (PetscInt b = 0; b < n; b++) Yi[c * ld + b] -= GammaInv[i * s + j] / hc[b] * Yj[c * ld + b];
+    }
+    PetscCall(TSBatchSolve(ts, n, Yi));
+  }
+
+  /* solution in Z, error estimate in F */
+  PetscCall(PetscArraycpy(Z, X, m * ld));
+  PetscCall(PetscArrayzero(F, m * ld));
+  for (PetscInt i = 0; i < s; i++) {
+    const PetscScalar *Yi = Y + i * m * ld;
+    const PetscReal    e  = batch->bt[i] - batch->bembedt[i];
+
+    for (PetscInt c = 0; c < m; c++) {
+      for (PetscInt b = 0; b < n; b++) {
+        Z[c * ld + b] += batch->bt[i] * Yi[c * ld + b];
+        F[c * ld + b] += e * Yi[c * ld + b];
+      }
+    }
+  }
+  PetscCall(TSGetTolerances(ts, &atol, &vatol, &rtol, &vrtol));
+  if (vatol) PetscCall(VecGetArrayRead(vatol, &va));
+  if (vrtol) PetscCall(VecGetArrayRead(vrtol, &vr));
+  for (PetscInt c = 0; c < m; c++) {
+    for (PetscInt b = 0; b < n; b++) {
+      PetscInt  k   = batch->lsys[b] * m + c;
+      PetscReal tol = (va ? PetscRealPart(va[k]) : atol) + (vr ? PetscRealPart(vr[k]) : rtol) * PetscMax(PetscAbsScalar(X[c * ld + b]), PetscAbsScalar(Z[c * ld + b]));
+
+      err[b] += PetscSqr(PetscAbsScalar(F[c * ld + b]) / tol);
+    }
+  }
+  if (vatol) PetscCall(VecRestoreArrayRead(vatol, &va));
+  if (vrtol) PetscCall(VecRestoreArrayRead(vrtol, &vr));
+
+  for (PetscInt b = 0; b < n; b++) {
+    PetscReal e   = PetscSqrtReal(err[b] / m);
+    PetscReal fac = e > 0 ? safety * PetscPowReal(e, -1.0 / batch->order) : high;
+
+    if (e <= 1.0) { /* PETSC_INFINITY and NaN are rejected */
+      PetscReal hnew = hc[b] * PetscClipInterval(fac, low, high);
+
+      for (PetscInt c = 0; c < m; c++) X[c * ld + b] = Z[c * ld + b];
+      batch->lt[b] += hc[b];
+      batch->lh[b] = PetscMin(hmax, hc[b] < batch->lh[b] ? PetscMax(batch->lh[b], hnew) : hnew);
+      if (tend - batch->lt[b] <= 10 * PETSC_MACHINE_EPSILON * PetscMax(PetscAbsReal(tend), 1.0)) {
+        batch->lt[b]    = tend;
+        batch->lstat[b] = LANE_DONE;
+      }
+      batch->nacc++;
+    } else {
+      batch->lh[b] = hc[b] * (PetscIsNormalReal(e) ? PetscClipInterval(reject_safety * fac, low, 1.0) : low);
+      if (batch->lh[b] < hmin || batch->lh[b] <= 10 * PETSC_MACHINE_EPSILON * PetscMax(PetscAbsReal(batch->lt[b]), 1.0)) batch->lstat[b] = LANE_FAILED;
+      batch->nrej++;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static inline void TSBatchLanePack(TS_Batch *batch, const PetscScalar u[], PetscInt k, PetscInt b, PetscReal t)
+{
+  for (PetscInt c = 0; c < batch->m; c++) batch->X[c * batch->ld + b] = u[k * batch->m + c];
+  batch->lsys[b]  = k;
+  batch->lstat[b] = LANE_ACTIVE;
+  batch->lt[b]    = t;
+  batch->lh[b]    = batch->h[k];
+}
+
+static inline void TSBatchLaneCopy(TS_Batch *batch, PetscInt from, PetscInt to)
+{
+  for (PetscInt c = 0; c < batch->m; c++) batch->X[c * batch->ld + to] = batch->X[c * batch->ld + from];
+  batch->lsys[to]  = batch->lsys[from];
+  batch->lstat[to] = batch->lstat[from];
+  batch->lt[to]    = batch->lt[from];
+  batch->lh[to]    = batch->lh[from];
+}
+
+static PetscErrorCode TSStep_Batch(TS ts)
+{
+  TS_Batch    *batch = (TS_Batch *)ts->data;
+  PetscInt     m = batch->m, ld = batch->ld, n = 0, next = 0, nfail = 0;
+  PetscReal    t0 = ts->ptime, tend = PetscMin(ts->ptime + ts->time_step, ts->max_time);
+  PetscScalar *u;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArray(ts->vec_sol, &u));
+  while (PETSC_TRUE) {
+    for (; n < ld && next < batch->nsys; n++) TSBatchLanePack(batch, u, next++, n, t0);
+    if (!n) break;
+    PetscCall(TSBatchAttempt(ts, n, tend));
+    for (PetscInt b = 0; b < n;) {
+      PetscInt k = batch->lsys[b];
+
+      if (batch->lstat[b] == LANE_ACTIVE) {
+        b++;
+        continue;
+      }
+      for (PetscInt c = 0; c < m; c++) u[k * m + c] = batch->X[c * ld + b];
+      batch->h[k] = batch->lh[b];
+      if (batch->lstat[b] == LANE_FAILED) {
+        PetscCall(PetscInfo(ts, "System %" PetscInt_FMT " failed at time %g with step size %g\n", k, (double)batch->lt[b], (double)batch->lh[b]));
+        nfail++;
+      }
+      if (next < batch->nsys) TSBatchLanePack(batch, u, next++, b++, t0);
+      else TSBatchLaneCopy(batch, --n, b);
+    }
+  }
+  PetscCall(VecRestoreArray(ts->vec_sol, &u));
+  batch->nfail += nfail;
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE, &nfail, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject)ts)));
+  if (nfail) {
+    ts->reason = TS_DIVERGED_STEP_REJECTED;
+    PetscCall(PetscInfo(ts, "Step=%" PetscInt_FMT ", %" PetscInt_FMT " systems failed to reach time %g, stopping solve\n", ts->steps, nfail, (double)tend));
+  } else ts->ptime = tend;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSetUp_Batch(TS ts)
+{
+  TS_Batch        *batch = (TS_Batch *)ts->data;
+  PetscInt         nloc, m, ld, s;
+  const PetscReal *Gamma;
+
+  PetscFunctionBegin;
+  PetscCheck(batch->rhsfunction, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_WRONGSTATE, "Must call TSBatchSetRHSFunction() first");
+  PetscCall(TSRosWGetTableau_Private(batch->rosw_type, &batch->order, &batch->s, &batch->ASum, &Gamma, &batch->At, &batch->GammaInv, &batch->bt, &batch->bembedt));
+  s = batch->s;
+  PetscCheck(batch->bembedt, PetscObjectComm((PetscObject)ts), PETSC_ERR_SUP, "Rosenbrock-W method %s has no embedded method for the error control", batch->rosw_type);
+  batch->gamma = Gamma[0];
+  for (PetscInt i = 0; i < s; i++) PetscCheck(Gamma[i * s + i] == batch->gamma, PetscObjectComm((PetscObject)ts), PETSC_ERR_SUP, "Rosenbrock-W method %s does not have the same nonzero diagonal coefficient in all stages", batch->rosw_type);
+  PetscCheck(batch->gamma != 0.0, PetscObjectComm((PetscObject)ts), PETSC_ERR_SUP, "Rosenbrock-W method %s has explicit stages", batch->rosw_type);
+
+  m = batch->m;
+  PetscCall(VecGetLocalSize(ts->vec_sol, &nloc));
+  PetscCheck(nloc % m == 0, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Local size of the solution %" PetscInt_FMT " is not a multiple of the size %" PetscInt_FMT " of the systems", nloc, m);
+  batch->nsys = nloc / m;
+  if (batch->ld == PETSC_DECIDE) batch->ld = 64;
+  batch->ld = ld = PetscMax(1, PetscMin(batch->ld, batch->nsys));
+
+  PetscCall(PetscMalloc1(batch->nsys, &batch->h));
+  for (PetscInt k = 0; k < batch->nsys; k++) batch->h[k] = ts->time_step;
+  PetscCall(PetscMalloc7(ld, &batch->lsys, ld, &batch->lstat, m * ld, &batch->lpiv, ld, &batch->lt, ld, &batch->lh, ld, &batch->lhc, ld, &batch->lerr));
+  PetscCall(PetscMalloc1(ld, &batch->tstage));
+  PetscCall(PetscMalloc7(m * ld, &batch->X, m * ld, &batch->Z, m * ld, &batch->F, m * ld, &batch->F0, s * m * ld, &batch->Y, m * m * ld, &batch->J, ld, &batch->work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSReset_Batch(TS ts)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(batch->h));
+  PetscCall(PetscFree7(batch->lsys, batch->lstat, batch->lpiv, batch->lt, batch->lh, batch->lhc, batch->lerr));
+  PetscCall(PetscFree(batch->tstage));
+  PetscCall(PetscFree7(batch->X, batch->Z, batch->F, batch->F0, batch->Y, batch->J, batch->work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSDestroy_Batch(TS ts)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCall(TSReset_Batch(ts));
+  PetscCall(PetscFree(batch->rosw_type));
+  PetscCall(PetscFree(ts->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSFunction_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSJacobian_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRosWType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetChunkSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchGetStatistics_C", NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSetFromOptions_Batch(TS ts, PetscOptionItems *PetscOptionsObject)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+  char      rosw_type[256];
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Batch ODE solver options");
+  {
+    PetscCall(PetscOptionsString("-ts_batch_rosw_type", "Rosenbrock-W method used for all the systems", "TSBatchSetRosWType", batch->rosw_type, rosw_type, sizeof(rosw_type), &flg));
+    if (flg) PetscCall(TSBatchSetRosWType(ts, rosw_type));
+    PetscCall(PetscOptionsInt("-ts_batch_chunk_size", "Number of systems integrated together", "TSBatchSetChunkSize", batch->ld, &batch->ld, NULL));
+  }
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSView_Batch(TS ts, PetscViewer viewer)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+  PetscBool iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerASCIIPrintf(viewer, "  Rosenbrock-W method %s, %s Jacobian\n", batch->rosw_type, batch->rhsjacobian ? "user" : "finite difference"));
+  if (batch->nsys) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  systems of size %" PetscInt_FMT ", integrated in chunks of %" PetscInt_FMT "\n", batch->m, batch->ld));
+    PetscCall(PetscViewerASCIIPushSynchronized(viewer));
+    PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "  [%d] %" PetscInt_FMT " systems, %" PetscInt_FMT " accepted and %" PetscInt_FMT " rejected steps, %" PetscInt_FMT " failures, %" PetscInt_FMT " right-hand side and %" PetscInt_FMT " Jacobian batch evaluations\n", PetscGlobalRank, batch->nsys, batch->nacc, batch->nrej, batch->nfail, batch->nrhs, batch->njac));
+    PetscCall(PetscViewerFlush(viewer));
+    PetscCall(PetscViewerASCIIPopSynchronized(viewer));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetRHSFunction_Batch(TS ts, PetscInt m, TSBatchRHSFunctionFn *f, void *ctx)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!ts->setupcalled || m == batch->m, PetscObjectComm((PetscObject)ts), PETSC_ERR_ORDER, "Cannot change the size of the systems after TSSetUp()");
+  batch->m           = m;
+  batch->rhsfunction = f;
+  batch->funP        = ctx;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetRHSJacobian_Batch(TS ts, TSBatchRHSJacobianFn *f, void *ctx)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  batch->rhsjacobian = f;
+  batch->jacP        = ctx;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetRosWType_Batch(TS ts, TSRosWType type)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!ts->setupcalled, PetscObjectComm((PetscObject)ts), PETSC_ERR_ORDER, "Cannot change the method after TSSetUp()");
+  PetscCall(PetscFree(batch->rosw_type));
+  PetscCall(PetscStrallocpy(type, &batch->rosw_type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchSetChunkSize_Batch(TS ts, PetscInt chunk)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!ts->setupcalled, PetscObjectComm((PetscObject)ts), PETSC_ERR_ORDER, "Cannot change the chunk size after TSSetUp()");
+  batch->ld = chunk;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSBatchGetStatistics_Batch(TS ts, PetscInt *nacc, PetscInt *nrej, PetscInt *nfail)
+{
+  TS_Batch *batch = (TS_Batch *)ts->data;
+
+  PetscFunctionBegin;
+  if (nacc) *nacc = batch->nacc;
+  if (nrej) *nrej = batch->nrej;
+  if (nfail) *nfail = batch->nfail;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  TSBatchSetRHSFunction - Sets the right-hand side of the independent ODE systems integrated by a `TSBATCH` solver
+
+  Logically Collective
+
+  Input Parameters:
++ ts  - the `TS` context
+. m   - the number of unknowns of each system
+. f   - the function evaluating the right-hand side of a chunk of systems, see `TSBatchRHSFunctionFn`
+- ctx - optional context for `f`
+
+  Level: intermediate
+
+  Note:
+  The solution vector of `ts` holds the systems one after the other, system k owning the local entries k * `m` to (k + 1) * `m` - 1.
+
+.seealso: [](ch_ts), `TS`, `TSBATCH`, `TSBatchRHSFunctionFn`, `TSBatchSetRHSJacobian()`
+@*/
+PetscErrorCode TSBatchSetRHSFunction(TS ts, PetscInt m, TSBatchRHSFunctionFn *f, void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, m, 2);
+  PetscCheck(m > 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_ARG_OUTOFRANGE, "Size of the systems %" PetscInt_FMT " must be positive", m);
+  PetscTryMethod(ts, "TSBatchSetRHSFunction_C", (TS, PetscInt, TSBatchRHSFunctionFn *, void *), (ts, m, f, ctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  TSBatchSetRHSJacobian - Sets the Jacobian of the right-hand side of the independent ODE systems integrated by a `TSBATCH` solver
+
+  Logically Collective
+
+  Input Parameters:
++ ts  - the `TS` context
+. f   - the function evaluating the Jacobian of a chunk of systems, see `TSBatchRHSJacobianFn`
+- ctx - optional context for `f`
+
+  Level: intermediate
+
+  Note:
+  Without this function the Jacobians are computed by finite differences, with one evaluation of the right-hand side of all the systems of
+  the chunk per unknown.
+
+.seealso: [](ch_ts), `TS`, `TSBATCH`, `TSBatchRHSJacobianFn`, `TSBatchSetRHSFunction()`
+@*/
+PetscErrorCode TSBatchSetRHSJacobian(TS ts, TSBatchRHSJacobianFn *f, void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscTryMethod(ts, "TSBatchSetRHSJacobian_C", (TS, TSBatchRHSJacobianFn *, void *), (ts, f, ctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSBatchSetRosWType - Sets the Rosenbrock-W method used by a `TSBATCH` solver
+
+  Logically Collective
+
+  Input Parameters:
++ ts   - the `TS` context
+- type - a `TSRosWType` with an embedded method and the same diagonal coefficient in all the stages, such as `TSROSWRA34PW2` (the default) or `TSROSWRODAS3`
+
+  Options Database Key:
+. -ts_batch_rosw_type <type> - the method
+
+  Level: intermediate
+
+.seealso: [](ch_ts), `TS`, `TSBATCH`, `TSROSW`, `TSRosWType`
+@*/
+PetscErrorCode TSBatchSetRosWType(TS ts, TSRosWType type)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscAssertPointer(type, 2);
+  PetscTryMethod(ts, "TSBatchSetRosWType_C", (TS, TSRosWType), (ts, type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSBatchSetChunkSize - Sets the number of systems a `TSBATCH` solver integrates together
+
+  Logically Collective
+
+  Input Parameters:
++ ts    - the `TS` context
+- chunk - the number of systems, or `PETSC_DECIDE`
+
+  Options Database Key:
+. -ts_batch_chunk_size <chunk> - the number of systems
+
+  Level: advanced
+
+  Note:
+  The work space is about (`m` + s + 5) `m` `chunk` scalars for systems of size `m` and a method of s stages. The default of 64 systems
+  keeps it in cache for small systems while giving long vectorizable loops.
+
+.seealso: [](ch_ts), `TS`, `TSBATCH`, `TSBatchSetRHSFunction()`
+@*/
+PetscErrorCode TSBatchSetChunkSize(TS ts, PetscInt chunk)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, chunk, 2);
+  PetscTryMethod(ts, "TSBatchSetChunkSize_C", (TS, PetscInt), (ts, chunk));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSBatchGetStatistics - Gets the number of steps of all the local systems of a `TSBATCH` solver
+
+  Not Collective
+
+  Input Parameter:
+. ts - the `TS` context
+
+  Output Parameters:
++ nacc  - the number of accepted steps, or `NULL`
+. nrej  - the number of rejected steps, or `NULL`
+- nfail - the number of systems that failed to reach the end of a step of `ts`, or `NULL`
+
+  Level: intermediate
+
+.seealso: [](ch_ts), `TS`, `TSBATCH`
+@*/
+PetscErrorCode TSBatchGetStatistics(TS ts, PetscInt *nacc, PetscInt *nrej, PetscInt *nfail)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscUseMethod(ts, "TSBatchGetStatistics_C", (TS, PetscInt *, PetscInt *, PetscInt *), (ts, nacc, nrej, nfail));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+  TSBATCH - Integrates a batch of many small independent ODE systems, such as the chemical kinetics of each cell of a mesh
+
+  Each step of the `TS` advances every system over the time step with a linearly implicit Rosenbrock-W method of `TSROSW`, each
+  system taking its own number of steps chosen by its own error estimate. The systems are integrated in chunks whose right-hand
+  sides, Jacobians and batched dense LU factorizations are evaluated together on interleaved arrays, so that the cost per system is
+  that of its arithmetic instead of that of one `TS` and one `SNES` per system.
+
+  Options Database Keys:
++ -ts_batch_rosw_type <ra34pw2> - the Rosenbrock-W method, see `TSBatchSetRosWType()`
+- -ts_batch_chunk_size <64>     - the number of systems integrated together, see `TSBatchSetChunkSize()`
+
+  Level: intermediate
+
+  Notes:
+  The problem is given with `TSBatchSetRHSFunction()` and optionally `TSBatchSetRHSJacobian()`, not with `TSSetRHSFunction()`. The
+  local systems never interact, so the `TS` needs no communication except to agree on the outcome of each step.
+
+  The step size of each system is controlled with the tolerances of `TSSetTolerances()` and the safety factor, clipping and step
+  limits of the `TSAdapt` of the `TS`, which itself does not adapt the step of the `TS`. The first step of each system is the time step of the `TS`.
+  The time derivative of the right-hand side is neglected as in `TSROSW`.
+
+  When a system fails to reach the end of a step, the time of the `TS` stays at the beginning of the step and the solve stops with
+  `TS_DIVERGED_STEP_REJECTED`; the solution then holds each system at the last time it reached.
+
+  For larger systems or systems coupled through a sparse Jacobian use `TSROSW`, `TSARKIMEX`, or `TSBDF` with a block diagonal
+  Jacobian and `PCPBJACOBI` or `PCVPBJACOBI`, which also factor the diagonal blocks in batches.
+
+.seealso: [](ch_ts), `TSCreate()`, `TS`, `TSSetType()`, `TSBatchSetRHSFunction()`, `TSBatchSetRHSJacobian()`, `TSBatchSetRosWType()`,
+          `TSBatchSetChunkSize()`, `TSBatchGetStatistics()`, `TSROSW`
+M*/
+PETSC_EXTERN PetscErrorCode TSCreate_Batch(TS ts)
+{
+  TS_Batch *batch;
+
+  PetscFunctionBegin;
+  ts->ops->setup          = TSSetUp_Batch;
+  ts->ops->step           = TSStep_Batch;
+  ts->ops->reset          = TSReset_Batch;
+  ts->ops->destroy        = TSDestroy_Batch;
+  ts->ops->setfromoptions = TSSetFromOptions_Batch;
+  ts->ops->view           = TSView_Batch;
+  ts->default_adapt_type  = TSADAPTNONE;
+
+  PetscCall(PetscNew(&batch));
+  ts->data = (void *)batch;
+
+  batch->ld = PETSC_DECIDE;
+  PetscCall(PetscStrallocpy(TSROSWRA34PW2, &batch->rosw_type));
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSFunction_C", TSBatchSetRHSFunction_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRHSJacobian_C", TSBatchSetRHSJacobian_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetRosWType_C", TSBatchSetRosWType_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchSetChunkSize_C", TSBatchSetChunkSize_Batch));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSBatchGetStatistics_C", TSBatchGetStatistics_Batch));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
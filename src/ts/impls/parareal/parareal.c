@@ -0,0 +1,841 @@
+/*
+  Code for parallel-in-time integration with the Parareal algorithm, that is two-level multigrid-reduction-in-time
+  with F- or FCF-relaxation.
+*/
+#include <petsc/private/tsimpl.h> /*I   "petscts.h"   I*/
+#include <petscdm.h>
+#include <petsctime.h>
+
+const char *const TSPararealRelaxationTypes[] = {"F", "FCF", "TSPararealRelaxationType", "TS_PARAREAL_RELAXATION_", NULL};
+
+typedef struct {
+  PetscErrorCode (*subproblem)(TS, void *); /* sets the problem on the communicator of a group, NULL if there is a single group sharing the DM of the TS */
+  void                    *subctx;
+  PetscInt                 ngroups;      /* number of groups of processes, PETSC_DECIDE until the setup */
+  PetscInt                 nslices;      /* number of time slices, a multiple of ngroups; slice n belongs to group n % ngroups */
+  PetscInt                 nloc;         /* number of slices of this group */
+  PetscInt                 max_it, its;  /* maximum and last number of iterations */
+  PetscInt                 coarse_steps; /* steps of the coarse propagator per slice */
+  PetscReal                rtol;
+  TSPararealRelaxationType relax;
+  PetscBool                monitor;
+  PetscSubcomm             psubcomm;
+  PetscMPIInt              color; /* the group of this process */
+  MPI_Comm                 tcomm; /* connects the processes with the same rank in all the groups, its rank is the group */
+  TS                       fine, coarse; /* fixed-step propagators, the fine one with the time step of the TS */
+  Vec                     *U, *F, *G;    /* [nloc] values at the beginning of the slices of this group, their fine and coarse propagation */
+  Vec                      Uend;         /* value at the final time, on the group of the last slice */
+  Vec                      work, next;   /* on the communicator of the group */
+  Vec                      xdup;         /* concatenates one vector of each group, on PetscSubcommContiguousParent() */
+  VecScatter               scatterin;    /* from the solution of the TS to the part of xdup of the first group */
+  VecScatter               scatterout;   /* from the part of xdup of the last group to the solution of the TS */
+  PetscLogDouble           tgroup;       /* time of the fine propagation of all the slices in the first iteration, summed over the groups */
+  PetscReal                speedup;      /* tgroup over the time of the solve, see TSPararealGetGroupSpeedup() */
+} TS_Parareal;
+
+static PetscErrorCode TSPararealCreateSubTS(TS ts, MPI_Comm comm, const char prefix[], TS *sub)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  TSAdapt      adapt;
+
+  PetscFunctionBegin;
+  PetscCall(TSCreate(comm, sub));
+  PetscCall(PetscObjectIncrementTabLevel((PetscObject)*sub, (PetscObject)ts, 1));
+  PetscCall(TSSetOptionsPrefix(*sub, ((PetscObject)ts)->prefix));
+  PetscCall(TSAppendOptionsPrefix(*sub, prefix));
+  PetscCall(TSSetType(*sub, TSRK));
+  PetscCall(TSSetMaxSteps(*sub, PETSC_MAX_INT));
+  PetscCall(TSSetExactFinalTime(*sub, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSGetAdapt(*sub, &adapt));
+  PetscCall(TSAdaptSetType(adapt, TSADAPTNONE));
+  if (pr->subproblem) {
+    PetscCall((*pr->subproblem)(*sub, pr->subctx));
+  } else { /* share the functions set on the DM of the TS, but not its DMSNES whose context is the TS */
+    DM       dm, subdm;
+    Mat      A, B, As, Bs;
+    void    *ctx;
+    TSRHSJacobianFn *rhsjac;
+    TSIJacobianFn   *ijac;
+
+    PetscCall(TSGetDM(ts, &dm));
+    PetscCall(DMClone(dm, &subdm));
+    PetscCall(DMCopyDMTS(dm, subdm));
+    PetscCall(TSSetDM(*sub, subdm));
+    PetscCall(DMDestroy(&subdm));
+    PetscCall(TSGetRHSJacobian(ts, &A, &B, &rhsjac, &ctx));
+    if (A && rhsjac) { /* the values of a constant Jacobian are not recomputed */
+      PetscBool assembled;
+
+      PetscCall(MatAssembled(A, &assembled));
+      PetscCall(MatDuplicate(A, assembled ? MAT_COPY_VALUES : MAT_DO_NOT_COPY_VALUES, &As));
+      if (B && B != A) {
+        PetscCall(MatAssembled(B, &assembled));
+        PetscCall(MatDuplicate(B, assembled ? MAT_COPY_VALUES : MAT_DO_NOT_COPY_VALUES, &Bs));
+      } else Bs = As;
+      PetscCall(TSSetRHSJacobian(*sub, As, Bs, rhsjac, ctx));
+      if (Bs != As) PetscCall(MatDestroy(&Bs));
+      PetscCall(MatDestroy(&As));
+    }
+    PetscCall(TSGetIJacobian(ts, &A, &B, &ijac, &ctx));
+    if (A && ijac) {
+      PetscCall(MatDuplicate(A, MAT_DO_NOT_COPY_VALUES, &As));
+      if (B && B != A) PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &Bs));
+      else Bs = As;
+      PetscCall(TSSetIJacobian(*sub, As, Bs, ijac, ctx));
+      if (Bs != As) PetscCall(MatDestroy(&Bs));
+      PetscCall(MatDestroy(&As));
+    }
+  }
+  PetscCall(TSSetFromOptions(*sub));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* propagates U over time slice n */
+static PetscErrorCode TSPararealPropagate(TS ts, TS sub, PetscInt n, PetscReal dt, Vec U)
+{
+  TS_Parareal       *pr = (TS_Parareal *)ts->data;
+  PetscReal          t0 = ts->ptime, h = (ts->max_time - ts->ptime) / pr->nslices;
+  TSConvergedReason  reason;
+
+  PetscFunctionBegin;
+  PetscCall(TSSetTime(sub, t0 + n * h));
+  PetscCall(TSSetMaxTime(sub, n == pr->nslices - 1 ? ts->max_time : t0 + (n + 1) * h));
+  PetscCall(TSSetStepNumber(sub, 0));
+  PetscCall(TSSetTimeStep(sub, PetscMin(dt, h)));
+  PetscCall(TSSolve(sub, U));
+  PetscCall(TSGetConvergedReason(sub, &reason));
+  PetscCheck(reason >= 0, PetscObjectComm((PetscObject)ts), PETSC_ERR_NOT_CONVERGED, "Propagation over time slice %" PetscInt_FMT " failed: %s", n, TSConvergedReasons[reason]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSend(TS ts, Vec X, PetscInt n)
+{
+  TS_Parareal       *pr = (TS_Parareal *)ts->data;
+  const PetscScalar *x;
+  PetscInt           m;
+  PetscMPIInt        count, dest;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(X, &m));
+  PetscCall(PetscMPIIntCast(m, &count));
+  PetscCall(PetscMPIIntCast(n % pr->ngroups, &dest));
+  PetscCall(VecGetArrayRead(X, &x));
+  PetscCallMPI(MPI_Send(x, count, MPIU_SCALAR, dest, 0, pr->tcomm));
+  PetscCall(VecRestoreArrayRead(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealRecv(TS ts, Vec X, PetscInt n)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscScalar *x;
+  PetscInt     m;
+  PetscMPIInt  count, source;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(X, &m));
+  PetscCall(PetscMPIIntCast(m, &count));
+  PetscCall(PetscMPIIntCast(n % pr->ngroups, &source));
+  PetscCall(VecGetArrayWrite(X, &x));
+  PetscCallMPI(MPI_Recv(x, count, MPIU_SCALAR, source, 0, pr->tcomm, MPI_STATUS_IGNORE));
+  PetscCall(VecRestoreArrayWrite(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* replaces U by Unew and accumulates the relative change */
+static PetscErrorCode TSPararealUpdate(Vec U, Vec Unew, PetscReal *change)
+{
+  PetscReal nrm, dnrm;
+
+  PetscFunctionBegin;
+  PetscCall(VecAXPY(U, -1.0, Unew));
+  PetscCall(VecNorm(U, NORM_2, &dnrm));
+  PetscCall(VecNorm(Unew, NORM_2, &nrm));
+  PetscCall(VecCopy(Unew, U));
+  *change = PetscMax(*change, nrm > 0 ? dnrm / nrm : dnrm);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  The sequential coarse sweep U_{n+1} = G(U_n) + F(U_n^old) - G(U_n^old) from slice first on, pipelined over the groups.
+  The first sweep has no fine values and only propagates the initial condition with the coarse propagator.
+*/
+static PetscErrorCode TSPararealSweep(TS ts, PetscInt first, PetscBool initial, PetscReal *change)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscReal    hc = (ts->max_time - ts->ptime) / (pr->nslices * pr->coarse_steps);
+
+  PetscFunctionBegin;
+  *change = 0;
+  for (PetscInt n = first; n < pr->nslices; n++) {
+    PetscInt j = n / pr->ngroups;
+
+    if (n % pr->ngroups != pr->color) continue;
+    if (n > first && (n - 1) % pr->ngroups != pr->color) {
+      PetscCall(TSPararealRecv(ts, pr->work, n - 1));
+      PetscCall(TSPararealUpdate(pr->U[j], pr->work, change));
+    }
+    PetscCall(VecCopy(pr->U[j], pr->work));
+    PetscCall(TSPararealPropagate(ts, pr->coarse, n, hc, pr->work));
+    if (initial) {
+      PetscCall(VecCopy(pr->work, pr->next));
+    } else {
+      PetscCall(VecWAXPY(pr->next, -1.0, pr->G[j], pr->F[j]));
+      PetscCall(VecAXPY(pr->next, 1.0, pr->work));
+    }
+    PetscCall(VecCopy(pr->work, pr->G[j]));
+    if (n == pr->nslices - 1) PetscCall(TSPararealUpdate(pr->Uend, pr->next, change));
+    else if ((n + 1) % pr->ngroups == pr->color) PetscCall(TSPararealUpdate(pr->U[(n + 1) / pr->ngroups], pr->next, change));
+    else PetscCall(TSPararealSend(ts, pr->next, n + 1));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* C-relaxation: the fine values become the values at the beginning of the next slices */
+static PetscErrorCode TSPararealCRelax(TS ts, PetscInt first)
+{
+  TS_Parareal        *pr = (TS_Parareal *)ts->data;
+  const PetscScalar **f;
+  MPI_Request        *req;
+  PetscMPIInt         nreq = 0, count;
+  PetscInt            m;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(pr->work, &m));
+  PetscCall(PetscMPIIntCast(m, &count));
+  PetscCall(PetscMalloc2(pr->nloc, &f, pr->nloc, &req));
+  for (PetscInt n = first; n < pr->nslices - 1; n++) {
+    PetscInt    j = n / pr->ngroups;
+    PetscMPIInt dest;
+
+    if (n % pr->ngroups != pr->color) continue;
+    if ((n + 1) % pr->ngroups == pr->color) {
+      PetscCall(VecCopy(pr->F[j], pr->U[(n + 1) / pr->ngroups]));
+      continue;
+    }
+    PetscCall(PetscMPIIntCast((n + 1) % pr->ngroups, &dest));
+    PetscCall(VecGetArrayRead(pr->F[j], &f[nreq]));
+    PetscCallMPI(MPI_Isend(f[nreq], count, MPIU_SCALAR, dest, 0, pr->tcomm, &req[nreq]));
+    nreq++;
+  }
+  for (PetscInt n = first + 1; n < pr->nslices; n++) {
+    if (n % pr->ngroups != pr->color || (n - 1) % pr->ngroups == pr->color) continue;
+    PetscCall(TSPararealRecv(ts, pr->U[n / pr->ngroups], n - 1));
+  }
+  PetscCallMPI(MPI_Waitall(nreq, req, MPI_STATUSES_IGNORE));
+  nreq = 0;
+  for (PetscInt n = first; n < pr->nslices - 1; n++) {
+    if (n % pr->ngroups != pr->color || (n + 1) % pr->ngroups == pr->color) continue;
+    PetscCall(VecRestoreArrayRead(pr->F[n / pr->ngroups], &f[nreq++]));
+  }
+  PetscCall(PetscFree2(f, req));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* F-relaxation: fine propagation of all the slices of this group from slice first on, and coarse propagation if requested */
+static PetscErrorCode TSPararealFRelax(TS ts, PetscInt first, PetscBool coarse, PetscLogDouble *time)
+{
+  TS_Parareal   *pr = (TS_Parareal *)ts->data;
+  PetscReal      hc = (ts->max_time - ts->ptime) / (pr->nslices * pr->coarse_steps);
+  PetscLogDouble t0, t1;
+
+  PetscFunctionBegin;
+  PetscCall(PetscTime(&t0));
+  for (PetscInt n = first; n < pr->nslices; n++) {
+    PetscInt j = n / pr->ngroups;
+
+    if (n % pr->ngroups != pr->color) continue;
+    PetscCall(VecCopy(pr->U[j], pr->F[j]));
+    PetscCall(TSPararealPropagate(ts, pr->fine, n, ts->time_step, pr->F[j]));
+    if (coarse) {
+      PetscCall(VecCopy(pr->U[j], pr->G[j]));
+      PetscCall(TSPararealPropagate(ts, pr->coarse, n, hc, pr->G[j]));
+    }
+  }
+  PetscCall(PetscTime(&t1));
+  if (time) *time = t1 - t0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealCopyLocal(Vec x, Vec y)
+{
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+  PetscInt           m;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetLocalSize(x, &m));
+  PetscCall(VecGetArrayRead(x, &xa));
+  PetscCall(VecGetArrayWrite(y, &ya));
+  PetscCall(PetscArraycpy(ya, xa, m));
+  PetscCall(VecRestoreArrayWrite(y, &ya));
+  PetscCall(VecRestoreArrayRead(x, &xa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSolve_Parareal(TS ts)
+{
+  TS_Parareal   *pr = (TS_Parareal *)ts->data;
+  MPI_Comm       comm;
+  PetscReal      change;
+  PetscLogDouble t0, t1, tgroup;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)ts, &comm));
+  PetscCheck(ts->max_time < PETSC_MAX_REAL, comm, PETSC_ERR_ARG_WRONGSTATE, "TSPARAREAL needs the final time, use TSSetMaxTime() or -ts_max_time");
+  PetscCall(PetscTime(&t0));
+  PetscCall(TSMonitor(ts, ts->steps, ts->ptime, ts->vec_sol));
+  if (pr->xdup) {
+    PetscCall(VecScatterBegin(pr->scatterin, ts->vec_sol, pr->xdup, INSERT_VALUES, SCATTER_FORWARD));
+    PetscCall(VecScatterEnd(pr->scatterin, ts->vec_sol, pr->xdup, INSERT_VALUES, SCATTER_FORWARD));
+    if (!pr->color) PetscCall(TSPararealCopyLocal(pr->xdup, pr->U[0]));
+  } else PetscCall(VecCopy(ts->vec_sol, pr->U[0]));
+
+  PetscCall(TSPararealSweep(ts, 0, PETSC_TRUE, &change));
+  for (pr->its = 0; pr->its < pr->max_it;) {
+    PetscInt first = pr->its; /* the slices before it are exact */
+
+    PetscCall(TSPararealFRelax(ts, first, PETSC_FALSE, &tgroup));
+    if (!pr->its) { /* time one group would take to step through all the slices */
+      PetscCallMPI(MPI_Allreduce(MPI_IN_PLACE, &tgroup, 1, MPI_DOUBLE, MPI_SUM, pr->tcomm == MPI_COMM_NULL ? PETSC_COMM_SELF : pr->tcomm));
+      pr->tgroup = tgroup;
+    }
+    if (pr->relax == TS_PARAREAL_RELAXATION_FCF && first < pr->nslices - 1) {
+      PetscCall(TSPararealCRelax(ts, first));
+      PetscCall(TSPararealFRelax(ts, first + 1, PETSC_TRUE, NULL));
+    }
+    PetscCall(TSPararealSweep(ts, first, PETSC_FALSE, &change));
+    PetscCallMPI(MPI_Allreduce(MPI_IN_PLACE, &change, 1, MPIU_REAL, MPIU_MAX, comm));
+    pr->its++;
+    if (pr->monitor) PetscCall(PetscPrintf(comm, "  Parareal iteration %" PetscInt_FMT " relative change %g\n", pr->its, (double)change));
+    if (change <= pr->rtol) break;
+  }
+
+  if (pr->xdup) {
+    if (pr->color == pr->ngroups - 1) PetscCall(TSPararealCopyLocal(pr->Uend, pr->xdup));
+    PetscCall(VecScatterBegin(pr->scatterout, pr->xdup, ts->vec_sol, INSERT_VALUES, SCATTER_FORWARD));
+    PetscCall(VecScatterEnd(pr->scatterout, pr->xdup, ts->vec_sol, INSERT_VALUES, SCATTER_FORWARD));
+  } else PetscCall(VecCopy(pr->Uend, ts->vec_sol));
+  ts->ptime = ts->max_time;
+  ts->steps += pr->nslices;
+  ts->reason = TS_CONVERGED_TIME;
+  PetscCall(PetscTime(&t1));
+  t1 -= t0;
+  PetscCallMPI(MPI_Allreduce(MPI_IN_PLACE, &t1, 1, MPI_DOUBLE, MPI_MAX, comm));
+  PetscCallMPI(MPI_Allreduce(MPI_IN_PLACE, &pr->tgroup, 1, MPI_DOUBLE, MPI_MAX, comm));
+  pr->speedup = t1 > 0 ? (PetscReal)(pr->tgroup / t1) : 0;
+  PetscCall(PetscInfo(ts, "%" PetscInt_FMT " Parareal iterations in %g seconds, fine time stepping on one group %g seconds, speedup over one group %g\n", pr->its, t1, pr->tgroup, (double)pr->speedup));
+  PetscCall(TSMonitor(ts, ts->steps, ts->ptime, ts->vec_sol));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSetUp_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  MPI_Comm     comm, subcomm;
+  PetscMPIInt  size, subrank;
+  PetscInt     M, m, range[2];
+  Vec          X;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)ts, &comm));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  if (pr->ngroups == PETSC_DECIDE) pr->ngroups = pr->subproblem ? size : 1;
+  if (pr->nslices == PETSC_DECIDE) pr->nslices = pr->ngroups;
+  if (pr->max_it == PETSC_DECIDE) pr->max_it = pr->nslices;
+  PetscCheck(pr->ngroups >= 1 && size % pr->ngroups == 0, comm, PETSC_ERR_ARG_INCOMP, "Number of groups %" PetscInt_FMT " must divide the number of processes %d", pr->ngroups, size);
+  PetscCheck(pr->nslices % pr->ngroups == 0, comm, PETSC_ERR_ARG_INCOMP, "Number of time slices %" PetscInt_FMT " must be a multiple of the number of groups %" PetscInt_FMT, pr->nslices, pr->ngroups);
+  PetscCheck(pr->subproblem || pr->ngroups == 1, comm, PETSC_ERR_ARG_WRONGSTATE, "Use TSPararealSetSubProblem() to solve with more than one group of processes");
+  pr->nloc = pr->nslices / pr->ngroups;
+
+  if (pr->subproblem) {
+    PetscCall(PetscSubcommCreate(comm, &pr->psubcomm));
+    PetscCall(PetscSubcommSetNumber(pr->psubcomm, pr->ngroups));
+    PetscCall(PetscSubcommSetType(pr->psubcomm, PETSC_SUBCOMM_CONTIGUOUS));
+    subcomm   = PetscSubcommChild(pr->psubcomm);
+    pr->color = pr->psubcomm->color;
+    PetscCallMPI(MPI_Comm_rank(subcomm, &subrank));
+    PetscCallMPI(MPI_Comm_split(comm, subrank, pr->color, &pr->tcomm));
+  } else {
+    subcomm   = comm;
+    pr->color = 0;
+  }
+  PetscCall(TSPararealCreateSubTS(ts, subcomm, "parareal_fine_", &pr->fine));
+  PetscCall(TSPararealCreateSubTS(ts, subcomm, "parareal_coarse_", &pr->coarse));
+
+  if (pr->subproblem) {
+    PetscInt sizes[2];
+    IS       is1, is2;
+
+    PetscCall(TSGetSolution(pr->fine, &X));
+    PetscCheck(X, comm, PETSC_ERR_ARG_WRONGSTATE, "The function of TSPararealSetSubProblem() must set the solution vector with TSSetSolution()");
+    PetscCall(VecGetSize(ts->vec_sol, &M));
+    PetscCall(VecGetSize(X, &sizes[0]));
+    PetscCheck(sizes[0] == M, comm, PETSC_ERR_ARG_SIZ, "Size of the solution of a group %" PetscInt_FMT " differs from the size of the solution %" PetscInt_FMT, sizes[0], M);
+    PetscCall(VecGetLocalSize(X, &m));
+    sizes[0] = -m;
+    sizes[1] = m;
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE, sizes, 2, MPIU_INT, MPI_MAX, pr->tcomm));
+    PetscCheck(-sizes[0] == sizes[1], PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "The solution vectors of all the groups must have the same parallel layout");
+    PetscCall(VecDuplicate(X, &pr->work));
+    PetscCall(VecCreateMPI(PetscSubcommContiguousParent(pr->psubcomm), m, PETSC_DECIDE, &pr->xdup));
+
+    PetscCall(VecGetOwnershipRange(ts->vec_sol, &range[0], &range[1]));
+    PetscCall(ISCreateStride(comm, range[1] - range[0], range[0], 1, &is1));
+    PetscCall(VecScatterCreate(ts->vec_sol, is1, pr->xdup, is1, &pr->scatterin));
+    PetscCall(ISCreateStride(comm, range[1] - range[0], range[0] + (pr->ngroups - 1) * M, 1, &is2));
+    PetscCall(VecScatterCreate(pr->xdup, is2, ts->vec_sol, is1, &pr->scatterout));
+    PetscCall(ISDestroy(&is1));
+    PetscCall(ISDestroy(&is2));
+  } else PetscCall(VecDuplicate(ts->vec_sol, &pr->work));
+  PetscCall(VecDuplicate(pr->work, &pr->next));
+  PetscCall(VecDuplicate(pr->work, &pr->Uend));
+  PetscCall(VecDuplicateVecs(pr->work, pr->nloc, &pr->U));
+  PetscCall(VecDuplicateVecs(pr->work, pr->nloc, &pr->F));
+  PetscCall(VecDuplicateVecs(pr->work, pr->nloc, &pr->G));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSReset_Parareal(TS ts)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  if (pr->U) {
+    PetscCall(VecDestroyVecs(pr->nloc, &pr->U));
+    PetscCall(VecDestroyVecs(pr->nloc, &pr->F));
+    PetscCall(VecDestroyVecs(pr->nloc, &pr->G));
+  }
+  PetscCall(VecDestroy(&pr->Uend));
+  PetscCall(VecDestroy(&pr->work));
+  PetscCall(VecDestroy(&pr->next));
+  PetscCall(VecDestroy(&pr->xdup));
+  PetscCall(VecScatterDestroy(&pr->scatterin));
+  PetscCall(VecScatterDestroy(&pr->scatterout));
+  PetscCall(TSDestroy(&pr->fine));
+  PetscCall(TSDestroy(&pr->coarse));
+  if (pr->tcomm != MPI_COMM_NULL) PetscCallMPI(MPI_Comm_free(&pr->tcomm));
+  PetscCall(PetscSubcommDestroy(&pr->psubcomm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSDestroy_Parareal(TS ts)
+{
+  PetscFunctionBegin;
+  PetscCall(TSReset_Parareal(ts));
+  PetscCall(PetscFree(ts->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetSubProblem_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetNumGroups_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetNumSlices_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetRelaxationType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTolerances_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetSubTS_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetIterationNumber_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetGroupSpeedup_C", NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSSetFromOptions_Parareal(TS ts, PetscOptionItems *PetscOptionsObject)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscEnum    relax;
+  PetscBool    flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Parareal ODE solver options");
+  {
+    PetscCall(PetscOptionsInt("-ts_parareal_ngroups", "Number of groups of processes, each one integrating some time slices", "TSPararealSetNumGroups", pr->ngroups, &pr->ngroups, NULL));
+    PetscCall(PetscOptionsInt("-ts_parareal_nslices", "Number of time slices, a multiple of the number of groups", "TSPararealSetNumSlices", pr->nslices, &pr->nslices, NULL));
+    PetscCall(PetscOptionsEnum("-ts_parareal_relaxation", "Relaxation of the fine values between the coarse sweeps", "TSPararealSetRelaxationType", TSPararealRelaxationTypes, (PetscEnum)pr->relax, &relax, &flg));
+    if (flg) pr->relax = (TSPararealRelaxationType)relax;
+    PetscCall(PetscOptionsReal("-ts_parareal_rtol", "Relative change of the values at the beginning of the slices below which the iterations stop", "TSPararealSetTolerances", pr->rtol, &pr->rtol, NULL));
+    PetscCall(PetscOptionsInt("-ts_parareal_max_it", "Maximum number of iterations", "TSPararealSetTolerances", pr->max_it, &pr->max_it, NULL));
+    PetscCall(PetscOptionsBoundedInt("-ts_parareal_coarse_steps", "Number of steps of the coarse propagator per time slice", "TSPARAREAL", pr->coarse_steps, &pr->coarse_steps, NULL, 1));
+    PetscCall(PetscOptionsBool("-ts_parareal_monitor", "Monitor the change of the iterations", "TSPARAREAL", pr->monitor, &pr->monitor, NULL));
+  }
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSView_Parareal(TS ts, PetscViewer viewer)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+  PetscBool    iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerASCIIPrintf(viewer, "  %" PetscInt_FMT " time slices on %" PetscInt_FMT " groups of processes, %s-relaxation\n", pr->nslices, pr->ngroups, TSPararealRelaxationTypes[pr->relax]));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "  maximum iterations %" PetscInt_FMT ", relative tolerance %g, coarse steps per slice %" PetscInt_FMT "\n", pr->max_it, (double)pr->rtol, pr->coarse_steps));
+  if (pr->fine) PetscCall(PetscViewerASCIIPrintf(viewer, "  fine propagator %s, coarse propagator %s\n", ((PetscObject)pr->fine)->type_name, ((PetscObject)pr->coarse)->type_name));
+  if (pr->its) PetscCall(PetscViewerASCIIPrintf(viewer, "  last solve: %" PetscInt_FMT " iterations, speedup over fine time stepping on one group of processes %g\n", pr->its, (double)pr->speedup));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetSubProblem_Parareal(TS ts, PetscErrorCode (*subproblem)(TS, void *), void *ctx)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  pr->subproblem = subproblem;
+  pr->subctx     = ctx;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetNumGroups_Parareal(TS ts, PetscInt ngroups)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!ts->setupcalled || ngroups == pr->ngroups, PetscObjectComm((PetscObject)ts), PETSC_ERR_ORDER, "Cannot change the number of groups after TSSetUp()");
+  pr->ngroups = ngroups;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetNumSlices_Parareal(TS ts, PetscInt nslices)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!ts->setupcalled || nslices == pr->nslices, PetscObjectComm((PetscObject)ts), PETSC_ERR_ORDER, "Cannot change the number of time slices after TSSetUp()");
+  pr->nslices = nslices;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetRelaxationType_Parareal(TS ts, TSPararealRelaxationType relax)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  pr->relax = relax;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealSetTolerances_Parareal(TS ts, PetscReal rtol, PetscInt max_it)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  if (rtol != (PetscReal)PETSC_CURRENT) pr->rtol = rtol;
+  if (max_it != PETSC_CURRENT) pr->max_it = max_it;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealGetSubTS_Parareal(TS ts, TS *fine, TS *coarse)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  PetscCheck(ts->setupcalled, PetscObjectComm((PetscObject)ts), PETSC_ERR_ORDER, "Must call TSSetUp() first");
+  if (fine) *fine = pr->fine;
+  if (coarse) *coarse = pr->coarse;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealGetIterationNumber_Parareal(TS ts, PetscInt *its)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  *its = pr->its;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TSPararealGetGroupSpeedup_Parareal(TS ts, PetscReal *speedup)
+{
+  TS_Parareal *pr = (TS_Parareal *)ts->data;
+
+  PetscFunctionBegin;
+  *speedup = pr->speedup;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  TSPararealSetSubProblem - Sets the function that defines the problem on the processes of one group of a `TSPARAREAL` solver
+
+  Logically Collective
+
+  Input Parameters:
++ ts         - the `TS` context
+. subproblem - the function, called for the fine and the coarse propagator of each group
+- ctx        - optional context for `subproblem`
+
+  Calling sequence of `subproblem`:
++ subts - the `TS` propagating the solution over the time slices of the group, on a subcommunicator of the `TS`
+- ctx   - the context
+
+  Level: intermediate
+
+  Notes:
+  `subproblem` must set the functions of `subts`, for example with `TSSetRHSFunction()`, and a solution vector with `TSSetSolution()`. This
+  vector must have the same global size and ordering as the solution of `ts`, and the same local sizes in all the groups.
+
+  Without this function all the slices are integrated by the processes of `ts` with the functions set on its `DM`.
+
+.seealso: [](ch_ts), `TS`, `TSPARAREAL`, `TSPararealSetNumGroups()`, `TSPararealGetSubTS()`
+@*/
+PetscErrorCode TSPararealSetSubProblem(TS ts, PetscErrorCode (*subproblem)(TS subts, void *ctx), void *ctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscTryMethod(ts, "TSPararealSetSubProblem_C", (TS, PetscErrorCode (*)(TS, void *), void *), (ts, subproblem, ctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealSetNumGroups - Sets the number of groups of processes that integrate the time slices of a `TSPARAREAL` solver concurrently
+
+  Logically Collective
+
+  Input Parameters:
++ ts      - the `TS` context
+- ngroups - the number of groups, it must divide the number of processes of `ts`, or `PETSC_DECIDE`
+
+  Options Database Key:
+. -ts_parareal_ngroups <ngroups> - the number of groups
+
+  Level: intermediate
+
+  Note:
+  The default is one group per process when `TSPararealSetSubProblem()` is used, otherwise a single group.
+
+.seealso: [](ch_ts), `TS`, `TSPARAREAL`, `TSPararealSetNumSlices()`, `TSPararealSetSubProblem()`
+@*/
+PetscErrorCode TSPararealSetNumGroups(TS ts, PetscInt ngroups)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, ngroups, 2);
+  PetscTryMethod(ts, "TSPararealSetNumGroups_C", (TS, PetscInt), (ts, ngroups));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealSetNumSlices - Sets the number of time slices of a `TSPARAREAL` solver
+
+  Logically Collective
+
+  Input Parameters:
++ ts      - the `TS` context
+- nslices - the number of slices, a multiple of the number of groups, or `PETSC_DECIDE` for one slice per group
+
+  Options Database Key:
+. -ts_parareal_nslices <nslices> - the number of slices
+
+  Level: intermediate
+
+.seealso: [](ch_ts), `TS`, `TSPARAREAL`, `TSPararealSetNumGroups()`
+@*/
+PetscErrorCode TSPararealSetNumSlices(TS ts, PetscInt nslices)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ts, nslices, 2);
+  PetscTryMethod(ts, "TSPararealSetNumSlices_C", (TS, PetscInt), (ts, nslices));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealSetRelaxationType - Sets the relaxation of a `TSPARAREAL` solver
+
+  Logically Collective
+
+  Input Parameters:
++ ts    - the `TS` context
+- relax - `TS_PARAREAL_RELAXATION_F` or `TS_PARAREAL_RELAXATION_FCF`
+
+  Options Database Key:
+. -ts_parareal_relaxation <f,fcf> - the relaxation
+
+  Level: intermediate
+
+.seealso: [](ch_ts), `TS`, `TSPARAREAL`, `TSPararealRelaxationType`
+@*/
+PetscErrorCode TSPararealSetRelaxationType(TS ts, TSPararealRelaxationType relax)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveEnum(ts, relax, 2);
+  PetscTryMethod(ts, "TSPararealSetRelaxationType_C", (TS, TSPararealRelaxationType), (ts, relax));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealSetTolerances - Sets the convergence criteria of a `TSPARAREAL` solver
+
+  Logically Collective
+
+  Input Parameters:
++ ts     - the `TS` context
+. rtol   - the iterations stop when the largest relative change of the values at the beginning of the time slices is below `rtol`
+- max_it - the maximum number of iterations
+
+  Options Database Keys:
++ -ts_parareal_rtol <rtol>     - the relative tolerance
+- -ts_parareal_max_it <max_it> - the maximum number of iterations
+
+  Level: intermediate
+
+  Note:
+  Use `PETSC_CURRENT` to keep a value. The default maximum number of iterations is the number of time slices, after which the solution is the
+  one of sequential time stepping with the fine propagator.
+
+.seealso: [](ch_ts), `TS`, `TSPARAREAL`, `TSPararealGetIterationNumber()`
+@*/
+PetscErrorCode TSPararealSetTolerances(TS ts, PetscReal rtol, PetscInt max_it)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(ts, rtol, 2);
+  PetscValidLogicalCollectiveInt(ts, max_it, 3);
+  PetscTryMethod(ts, "TSPararealSetTolerances_C", (TS, PetscReal, PetscInt), (ts, rtol, max_it));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealGetSubTS - Gets the fine and coarse propagators of a `TSPARAREAL` solver on the group of this process
+
+  Not Collective
+
+  Input Parameter:
+. ts - the `TS` context
+
+  Output Parameters:
++ fine   - the fine propagator, or `NULL`
+- coarse - the coarse propagator, or `NULL`
+
+  Level: advanced
+
+  Note:
+  The propagators exist after `TSSetUp()`. Their options prefixes are `-parareal_fine_` and `-parareal_coarse_`, both default to `TSRK`.
+
+.seealso: [](ch_ts), `TS`, `TSPARAREAL`, `TSPararealSetSubProblem()`
+@*/
+PetscErrorCode TSPararealGetSubTS(TS ts, TS *fine, TS *coarse)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscUseMethod(ts, "TSPararealGetSubTS_C", (TS, TS *, TS *), (ts, fine, coarse));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealGetIterationNumber - Gets the number of iterations of the last solve of a `TSPARAREAL` solver
+
+  Not Collective
+
+  Input Parameter:
+. ts - the `TS` context
+
+  Output Parameter:
+. its - the number of iterations
+
+  Level: intermediate
+
+.seealso: [](ch_ts), `TS`, `TSPARAREAL`, `TSPararealSetTolerances()`, `TSPararealGetGroupSpeedup()`
+@*/
+PetscErrorCode TSPararealGetIterationNumber(TS ts, PetscInt *its)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscAssertPointer(its, 2);
+  PetscUseMethod(ts, "TSPararealGetIterationNumber_C", (TS, PetscInt *), (ts, its));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  TSPararealGetGroupSpeedup - Gets the speedup of the last solve of a `TSPARAREAL` solver over fine time stepping on one group of processes
+
+  Not Collective
+
+  Input Parameter:
+. ts - the `TS` context
+
+  Output Parameter:
+. speedup - the time that one group of processes would take to step through all the time slices with the fine propagator,
+            measured in the first iteration, divided by the time of the solve
+
+  Level: intermediate
+
+  Notes:
+  The reference is sequential time stepping on the processes of one group, not on all the processes of the `TS`. With more than
+  one group it overestimates the speedup over sequential time stepping on the same resources whenever the fine propagator scales
+  to more processes. With a single group it is the speedup over sequential time stepping on all the processes.
+
+  The speedup is also reported by `-info` and `-ts_view`.
+
+.seealso: [](ch_ts), `TS`, `TSPARAREAL`, `TSPararealGetIterationNumber()`
+@*/
+PetscErrorCode TSPararealGetGroupSpeedup(TS ts, PetscReal *speedup)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
+  PetscAssertPointer(speedup, 2);
+  PetscUseMethod(ts, "TSPararealGetGroupSpeedup_C", (TS, PetscReal *), (ts, speedup));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+  TSPARAREAL - Parallel-in-time integration with the Parareal algorithm
+
+  The time interval is split into time slices that are distributed over groups of processes. Each iteration propagates the
+  values at the beginning of all the slices concurrently with the fine propagator, then corrects them with a sequential sweep of
+  the cheap coarse propagator, U_{n+1} = G(U_n) + F(U_n^old) - G(U_n^old). This is two-level multigrid-reduction-in-time with
+  F-relaxation; FCF-relaxation adds a propagation of the fine values to the next slice and a second fine propagation per iteration.
+
+  Options Database Keys:
++ -ts_parareal_ngroups <ngroups>     - number of groups of processes, see `TSPararealSetNumGroups()`
+. -ts_parareal_nslices <nslices>     - number of time slices, see `TSPararealSetNumSlices()`
+. -ts_parareal_relaxation <f,fcf>    - relaxation, see `TSPararealSetRelaxationType()`
+. -ts_parareal_rtol <rtol>           - relative tolerance, see `TSPararealSetTolerances()`
+. -ts_parareal_max_it <max_it>       - maximum number of iterations, see `TSPararealSetTolerances()`
+. -ts_parareal_coarse_steps <steps>  - number of steps of the coarse propagator per time slice (default 1)
+. -ts_parareal_monitor               - print the relative change of each iteration
+. -parareal_fine_ts_type <type>      - the fine propagator, its time step is the one of the `TS`
+- -parareal_coarse_ts_type <type>    - the coarse propagator
+
+  Level: advanced
+
+  Notes:
+  The final time must be set with `TSSetMaxTime()`. After k iterations the first k time slices are exact, so at most the number of
+  slices iterations are needed. The speedup over fine time stepping on one group of processes is reported by `TSPararealGetGroupSpeedup()`.
+
+  To integrate slices concurrently the problem must be defined on the processes of each group with `TSPararealSetSubProblem()`.
+
+.seealso: [](ch_ts), `TSCreate()`, `TS`, `TSSetType()`, `TSPararealSetSubProblem()`, `TSPararealSetNumGroups()`, `TSPararealSetNumSlices()`,
+          `TSPararealSetRelaxationType()`, `TSPararealSetTolerances()`, `TSPararealGetSubTS()`, `TSPararealGetIterationNumber()`, `TSPararealGetGroupSpeedup()`
+M*/
+PETSC_EXTERN PetscErrorCode TSCreate_Parareal(TS ts)
+{
+  TS_Parareal *pr;
+
+  PetscFunctionBegin;
+  ts->ops->setup          = TSSetUp_Parareal;
+  ts->ops->solve          = TSSolve_Parareal;
+  ts->ops->reset          = TSReset_Parareal;
+  ts->ops->destroy        = TSDestroy_Parareal;
+  ts->ops->setfromoptions = TSSetFromOptions_Parareal;
+  ts->ops->view           = TSView_Parareal;
+  ts->default_adapt_type  = TSADAPTNONE;
+
+  PetscCall(PetscNew(&pr));
+  ts->data = (void *)pr;
+
+  pr->ngroups      = PETSC_DECIDE;
+  pr->nslices      = PETSC_DECIDE;
+  pr->max_it       = PETSC_DECIDE;
+  pr->rtol         = 1e-8;
+  pr->coarse_steps = 1;
+  pr->relax        = TS_PARAREAL_RELAXATION_F;
+  pr->tcomm        = MPI_COMM_NULL;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetSubProblem_C", TSPararealSetSubProblem_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetNumGroups_C", TSPararealSetNumGroups_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetNumSlices_C", TSPararealSetNumSlices_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetRelaxationType_C", TSPararealSetRelaxationType_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealSetTolerances_C", TSPararealSetTolerances_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetSubTS_C", TSPararealGetSubTS_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetIterationNumber_C", TSPararealGetIterationNumber_Parareal));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ts, "TSPararealGetGroupSpeedup_C", TSPararealGetGroupSpeedup_Parareal));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
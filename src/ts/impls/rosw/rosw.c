@@ -1071,6 +1071,35 @@ PetscErrorCode TSRosWRegisterRos4(TSRosWType name, PetscReal gamma, PetscReal a2
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Gives TSBATCH the coefficients of a registered method in transformed variables, see TSStep_RosW()
+*/
+PetscErrorCode TSRosWGetTableau_Private(TSRosWType name, PetscInt *order, PetscInt *s, const PetscReal **ASum, const PetscReal **Gamma, const PetscReal **At, const PetscReal **GammaInv, const PetscReal **bt, const PetscReal **bembedt)
+{
+  RosWTableauLink link;
+  PetscBool       match;
+
+  PetscFunctionBegin;
+  PetscCall(TSRosWInitializePackage());
+  for (link = RosWTableauList; link; link = link->next) {
+    PetscCall(PetscStrcmp(link->tab.name, name, &match));
+    if (match) {
+      RosWTableau t = &link->tab;
+
+      *order    = t->order;
+      *s        = t->s;
+      *ASum     = t->ASum;
+      *Gamma    = t->Gamma;
+      *At       = t->At;
+      *GammaInv = t->GammaInv;
+      *bt       = t->bt;
+      *bembedt  = t->bembed ? t->bembedt : NULL;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+  SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_UNKNOWN_TYPE, "Could not find Rosenbrock-W method '%s'", name);
+}
+
 /*
  The step completion formula is
 
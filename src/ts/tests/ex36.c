@@ -0,0 +1,181 @@
+static char help[] = "Tests TSPARAREAL on a set of Van der Pol oscillators against sequential time stepping.\n";
+
+#include <petscts.h>
+
+typedef struct {
+  PetscInt  n;  /* number of oscillators */
+  PetscReal mu; /* stiffness */
+} AppCtx;
+
+static PetscErrorCode RHSFunction(TS ts, PetscReal t, Vec X, Vec F, void *ctx)
+{
+  AppCtx            *user = (AppCtx *)ctx;
+  const PetscScalar *x;
+  PetscScalar       *f;
+  PetscInt           m;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetLocalSize(X, &m));
+  PetscCall(VecGetArrayRead(X, &x));
+  PetscCall(VecGetArrayWrite(F, &f));
+  for (PetscInt i = 0; i < m; i += 2) {
+    f[i]     = x[i + 1];
+    f[i + 1] = user->mu * (1.0 - x[i] * x[i]) * x[i + 1] - x[i];
+  }
+  PetscCall(VecRestoreArrayWrite(F, &f));
+  PetscCall(VecRestoreArrayRead(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode RHSJacobian(TS ts, PetscReal t, Vec X, Mat A, Mat B, void *ctx)
+{
+  AppCtx            *user = (AppCtx *)ctx;
+  const PetscScalar *x;
+  PetscInt           rstart, rend;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetOwnershipRange(X, &rstart, &rend));
+  PetscCall(VecGetArrayRead(X, &x));
+  for (PetscInt i = rstart; i < rend; i += 2) {
+    const PetscScalar *xi      = x + i - rstart;
+    PetscInt           idx[2]  = {i, i + 1};
+    PetscScalar        J[2][2] = {
+      {0,                                  1                                },
+      {-2.0 * user->mu * xi[0] * xi[1] - 1.0, user->mu * (1.0 - xi[0] * xi[0])}
+    };
+
+    PetscCall(MatSetValues(B, 2, idx, 2, idx, &J[0][0], INSERT_VALUES));
+  }
+  PetscCall(VecRestoreArrayRead(X, &x));
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  if (A != B) {
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* defines the problem on the communicator of ts, used for the whole problem and for each group of processes of TSPARAREAL */
+static PetscErrorCode SetProblem(TS ts, void *ctx)
+{
+  AppCtx  *user = (AppCtx *)ctx;
+  MPI_Comm comm;
+  Vec      X;
+  Mat      J;
+  PetscInt m;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscObjectGetComm((PetscObject)ts, &comm));
+  PetscCall(VecCreate(comm, &X));
+  PetscCall(VecSetSizes(X, PETSC_DECIDE, 2 * user->n));
+  PetscCall(VecSetBlockSize(X, 2));
+  PetscCall(VecSetFromOptions(X));
+  PetscCall(VecGetLocalSize(X, &m));
+  PetscCall(MatCreateAIJ(comm, m, m, PETSC_DETERMINE, PETSC_DETERMINE, 2, NULL, 0, NULL, &J));
+  PetscCall(TSSetSolution(ts, X));
+  PetscCall(TSSetRHSFunction(ts, NULL, RHSFunction, user));
+  PetscCall(TSSetRHSJacobian(ts, J, J, RHSJacobian, user));
+  PetscCall(MatDestroy(&J));
+  PetscCall(VecDestroy(&X));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FormInitialSolution(Vec X)
+{
+  PetscScalar *x;
+  PetscInt     rstart, rend;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetOwnershipRange(X, &rstart, &rend));
+  PetscCall(VecGetArrayWrite(X, &x));
+  for (PetscInt i = rstart; i < rend; i += 2) {
+    x[i - rstart]     = 1.0 + 0.1 * (i / 2);
+    x[i - rstart + 1] = 0.0;
+  }
+  PetscCall(VecRestoreArrayWrite(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  TS        ts, tsref;
+  TSAdapt   adapt;
+  Vec       X, Xref;
+  AppCtx    user;
+  PetscReal tf = 2.0, dt = 0.01, nrm, err;
+  PetscInt  its;
+  PetscBool subproblem = PETSC_TRUE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.n  = 8;
+  user.mu = 1.0;
+  PetscOptionsBegin(PETSC_COMM_WORLD, NULL, "Parareal test options", NULL);
+  PetscCall(PetscOptionsInt("-n", "Number of oscillators", NULL, user.n, &user.n, NULL));
+  PetscCall(PetscOptionsReal("-mu", "Stiffness of the oscillators", NULL, user.mu, &user.mu, NULL));
+  PetscCall(PetscOptionsBool("-subproblem", "Define the problem on each group of processes with TSPararealSetSubProblem()", NULL, subproblem, &subproblem, NULL));
+  PetscOptionsEnd();
+
+  /* sequential time stepping with the fine propagator */
+  PetscCall(TSCreate(PETSC_COMM_WORLD, &tsref));
+  PetscCall(SetProblem(tsref, &user));
+  PetscCall(TSSetType(tsref, TSRK));
+  PetscCall(TSSetTimeStep(tsref, dt));
+  PetscCall(TSSetMaxTime(tsref, tf));
+  PetscCall(TSSetExactFinalTime(tsref, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSGetAdapt(tsref, &adapt));
+  PetscCall(TSAdaptSetType(adapt, TSADAPTNONE));
+  PetscCall(TSSetOptionsPrefix(tsref, "ref_"));
+  PetscCall(TSSetFromOptions(tsref));
+  PetscCall(TSGetSolution(tsref, &Xref));
+  PetscCall(FormInitialSolution(Xref));
+  PetscCall(TSSolve(tsref, Xref));
+
+  PetscCall(TSCreate(PETSC_COMM_WORLD, &ts));
+  PetscCall(SetProblem(ts, &user));
+  PetscCall(TSSetType(ts, TSPARAREAL));
+  if (subproblem) PetscCall(TSPararealSetSubProblem(ts, SetProblem, &user));
+  PetscCall(TSSetTimeStep(ts, dt));
+  PetscCall(TSSetMaxTime(ts, tf));
+  PetscCall(TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSSetFromOptions(ts));
+  PetscCall(TSGetSolution(ts, &X));
+  PetscCall(FormInitialSolution(X));
+  PetscCall(TSSolve(ts, X));
+  PetscCall(TSPararealGetIterationNumber(ts, &its));
+
+  PetscCall(VecNorm(Xref, NORM_2, &nrm));
+  PetscCall(VecAXPY(Xref, -1.0, X));
+  PetscCall(VecNorm(Xref, NORM_2, &err));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Parareal iterations %" PetscInt_FMT ", %s sequential time stepping\n", its, err <= 1e-6 * nrm ? "matches" : "differs from"));
+
+  PetscCall(TSDestroy(&ts));
+  PetscCall(TSDestroy(&tsref));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+     suffix: 1
+     args: -subproblem 0 -ts_parareal_nslices 4
+
+   test:
+     suffix: 2
+     nsize: 4
+     args: -ts_parareal_monitor -ts_parareal_relaxation {{f fcf}separate output}
+
+   test:
+     suffix: 3
+     nsize: 4
+     args: -ts_parareal_ngroups 2 -ts_parareal_nslices 8 -parareal_coarse_ts_type beuler -ts_parareal_coarse_steps 2
+
+   # converges in fewer iterations than time slices
+   test:
+     suffix: 4
+     nsize: 4
+     args: -ts_parareal_nslices 16 -parareal_coarse_ts_type beuler -ts_parareal_monitor -ts_parareal_relaxation {{f fcf}separate output}
+
+TEST*/
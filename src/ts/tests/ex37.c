@@ -0,0 +1,211 @@
+static char help[] = "Tests TSBATCH on an ensemble of Robertson chemical kinetics systems against TSROSW on the whole block diagonal system.\n";
+
+#include <petscts.h>
+
+typedef struct {
+  PetscInt sysstart; /* global index of the first local system */
+} AppCtx;
+
+/* the rate of the first reaction differs from system to system */
+static inline PetscReal RateConstant(PetscInt k)
+{
+  return 0.04 * (1.0 + 0.1 * (k % 7));
+}
+
+static PetscErrorCode BatchRHSFunction(TS ts, PetscInt n, PetscInt ld, const PetscInt sys[], const PetscReal t[], const PetscScalar x[], PetscScalar f[], void *ctx)
+{
+  AppCtx *user = (AppCtx *)ctx;
+
+  PetscFunctionBeginUser;
+  for (PetscInt b = 0; b < n; b++) {
+    PetscReal   k1 = RateConstant(user->sysstart + sys[b]);
+    PetscScalar u0 = x[b], u1 = x[ld + b], u2 = x[2 * ld + b];
+
+    f[b]          = -k1 * u0 + 1e4 * u1 * u2;
+    f[ld + b]     = k1 * u0 - 1e4 * u1 * u2 - 3e7 * u1 * u1;
+    f[2 * ld + b] = 3e7 * u1 * u1;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BatchRHSJacobian(TS ts, PetscInt n, PetscInt ld, const PetscInt sys[], const PetscReal t[], const PetscScalar x[], PetscScalar J[], void *ctx)
+{
+  AppCtx *user = (AppCtx *)ctx;
+
+  PetscFunctionBeginUser;
+  for (PetscInt b = 0; b < n; b++) {
+    PetscReal   k1 = RateConstant(user->sysstart + sys[b]);
+    PetscScalar u1 = x[ld + b], u2 = x[2 * ld + b];
+
+    J[0 * ld + b] = -k1;
+    J[1 * ld + b] = 1e4 * u2;
+    J[2 * ld + b] = 1e4 * u1;
+    J[3 * ld + b] = k1;
+    J[4 * ld + b] = -1e4 * u2 - 6e7 * u1;
+    J[5 * ld + b] = -1e4 * u1;
+    J[6 * ld + b] = 0;
+    J[7 * ld + b] = 6e7 * u1;
+    J[8 * ld + b] = 0;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the same systems as one block diagonal system for TSROSW */
+static PetscErrorCode RHSFunction(TS ts, PetscReal t, Vec X, Vec F, void *ctx)
+{
+  const PetscScalar *x;
+  PetscScalar       *f;
+  PetscInt           n;
+  PetscReal          tt[1] = {t};
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetArrayRead(X, &x));
+  PetscCall(VecGetArrayWrite(F, &f));
+  for (PetscInt k = 0; k < n / 3; k++) PetscCall(BatchRHSFunction(ts, 1, 1, &k, tt, x + 3 * k, f + 3 * k, ctx));
+  PetscCall(VecRestoreArrayWrite(F, &f));
+  PetscCall(VecRestoreArrayRead(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode RHSJacobian(TS ts, PetscReal t, Vec X, Mat A, Mat B, void *ctx)
+{
+  const PetscScalar *x;
+  PetscScalar        J[9];
+  PetscInt           n, rstart;
+  PetscReal          tt[1] = {t};
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetOwnershipRange(X, &rstart, NULL));
+  PetscCall(VecGetArrayRead(X, &x));
+  for (PetscInt k = 0; k < n / 3; k++) {
+    PetscInt idx[3] = {rstart + 3 * k, rstart + 3 * k + 1, rstart + 3 * k + 2};
+
+    PetscCall(BatchRHSJacobian(ts, 1, 1, &k, tt, x + 3 * k, J, ctx));
+    PetscCall(MatSetValues(B, 3, idx, 3, idx, J, INSERT_VALUES));
+  }
+  PetscCall(VecRestoreArrayRead(X, &x));
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FormInitialSolution(Vec X)
+{
+  PetscScalar *x;
+  PetscInt     n;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetArrayWrite(X, &x));
+  for (PetscInt k = 0; k < n / 3; k++) {
+    x[3 * k]     = 1.0;
+    x[3 * k + 1] = 0.0;
+    x[3 * k + 2] = 0.0;
+  }
+  PetscCall(VecRestoreArrayWrite(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  TS                 ts, tsref;
+  Vec                X, Xref;
+  Mat                J;
+  AppCtx             user;
+  PetscInt           nsys = 50, n, nfail;
+  PetscReal          tf = 10.0, err = 0;
+  PetscBool          jacobian = PETSC_TRUE;
+  const PetscScalar *x, *xref;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscOptionsBegin(PETSC_COMM_WORLD, NULL, "Batch test options", NULL);
+  PetscCall(PetscOptionsInt("-nsys", "Number of systems per process", NULL, nsys, &nsys, NULL));
+  PetscCall(PetscOptionsBool("-jacobian", "Provide the Jacobian of the systems", NULL, jacobian, &jacobian, NULL));
+  PetscOptionsEnd();
+
+  PetscCall(VecCreateFromOptions(PETSC_COMM_WORLD, NULL, 3, 3 * nsys, PETSC_DECIDE, &X));
+  PetscCall(VecGetOwnershipRange(X, &user.sysstart, NULL));
+  user.sysstart /= 3;
+  PetscCall(VecDuplicate(X, &Xref));
+  PetscCall(VecGetLocalSize(X, &n));
+
+  PetscCall(TSCreate(PETSC_COMM_WORLD, &tsref));
+  PetscCall(TSSetOptionsPrefix(tsref, "ref_"));
+  PetscCall(TSSetType(tsref, TSROSW));
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, n, n, PETSC_DETERMINE, PETSC_DETERMINE, 3, NULL, 0, NULL, &J));
+  PetscCall(MatSetBlockSize(J, 3));
+  PetscCall(TSSetRHSFunction(tsref, NULL, RHSFunction, &user));
+  PetscCall(TSSetRHSJacobian(tsref, J, J, RHSJacobian, &user));
+  PetscCall(TSSetTimeStep(tsref, 1e-4));
+  PetscCall(TSSetMaxTime(tsref, tf));
+  PetscCall(TSSetExactFinalTime(tsref, TS_EXACTFINALTIME_MATCHSTEP));
+  PetscCall(TSSetTolerances(tsref, 1e-12, NULL, 1e-8, NULL));
+  PetscCall(TSSetFromOptions(tsref));
+  PetscCall(FormInitialSolution(Xref));
+  PetscCall(TSSolve(tsref, Xref));
+
+  PetscCall(TSCreate(PETSC_COMM_WORLD, &ts));
+  PetscCall(TSSetType(ts, TSBATCH));
+  PetscCall(TSBatchSetRHSFunction(ts, 3, BatchRHSFunction, &user));
+  if (jacobian) PetscCall(TSBatchSetRHSJacobian(ts, BatchRHSJacobian, &user));
+  PetscCall(TSSetTimeStep(ts, 1.0));
+  PetscCall(TSSetMaxTime(ts, tf));
+  PetscCall(TSSetTolerances(ts, 1e-12, NULL, 1e-8, NULL));
+  PetscCall(TSSetFromOptions(ts));
+  PetscCall(FormInitialSolution(X));
+  PetscCall(TSSolve(ts, X));
+  PetscCall(TSBatchGetStatistics(ts, NULL, NULL, &nfail));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE, &nfail, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  if (nfail) {
+    TSConvergedReason reason;
+    PetscReal         t;
+
+    /* a failed step leaves the time of the TS at the beginning of the step */
+    PetscCall(TSGetConvergedReason(ts, &reason));
+    PetscCall(TSGetTime(ts, &t));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "TSBATCH stopped with %s at time %g\n", TSConvergedReasons[reason], (double)t));
+  } else {
+    /* compare each component with the tolerances of a solution with the small concentration of the second species */
+    PetscCall(VecGetArrayRead(X, &x));
+    PetscCall(VecGetArrayRead(Xref, &xref));
+    for (PetscInt i = 0; i < n; i++) err = PetscMax(err, PetscAbsScalar(x[i] - xref[i]) / (1e-10 + 1e-4 * PetscAbsScalar(xref[i])));
+    PetscCall(VecRestoreArrayRead(Xref, &xref));
+    PetscCall(VecRestoreArrayRead(X, &x));
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE, &err, 1, MPIU_REAL, MPIU_MAX, PETSC_COMM_WORLD));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "TSBATCH %s TSROSW\n", err <= 1.0 ? "matches" : "differs from"));
+  }
+
+  PetscCall(MatDestroy(&J));
+  PetscCall(VecDestroy(&X));
+  PetscCall(VecDestroy(&Xref));
+  PetscCall(TSDestroy(&ts));
+  PetscCall(TSDestroy(&tsref));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+     suffix: 1
+     args: -ts_monitor -ref_ksp_type preonly -ref_pc_type pbjacobi
+
+   test:
+     suffix: 2
+     nsize: 2
+     args: -ts_batch_chunk_size 7 -jacobian {{0 1}} -ref_ksp_type preonly -ref_pc_type pbjacobi
+     output_file: output/ex37_2.out
+
+   test:
+     suffix: rodas3
+     args: -ts_batch_rosw_type rodas3 -ts_max_steps 4 -ref_ts_max_time 4 -ref_ksp_type preonly -ref_pc_type pbjacobi
+     output_file: output/ex37_2.out
+
+   test:
+     suffix: fail
+     args: -ts_adapt_dt_min 0.1 -ts_error_if_step_fails 0 -ref_ts_max_time 0
+
+TEST*/
@@ -0,0 +1,157 @@
+static char help[] = "Tests the split local right-hand side of DMDATSSetRHSFunctionLocalSplit() on a reaction-diffusion equation.\n\n";
+
+#include <petscdmda.h>
+#include <petscts.h>
+
+typedef struct {
+  PetscReal lambda;   /* reaction parameter */
+  PetscBool periodic; /* periodic boundaries instead of Dirichlet boundaries */
+  PetscInt  count;    /* number of points evaluated */
+} AppCtx;
+
+static PetscErrorCode FormRHSLocal2d(DMDALocalInfo *info, PetscReal t, PetscScalar **x, PetscScalar **f, AppCtx *user)
+{
+  const PetscReal hx = 1.0 / info->mx, hy = 1.0 / info->my;
+
+  PetscFunctionBeginUser;
+  for (PetscInt j = info->ys; j < info->ys + info->ym; j++)
+    for (PetscInt i = info->xs; i < info->xs + info->xm; i++) {
+      if (!user->periodic && (i == 0 || j == 0 || i == info->mx - 1 || j == info->my - 1)) f[j][i] = -x[j][i];
+      else f[j][i] = (x[j][i - 1] - 2.0 * x[j][i] + x[j][i + 1]) / (hx * hx) + (x[j - 1][i] - 2.0 * x[j][i] + x[j + 1][i]) / (hy * hy) + user->lambda * PetscSinReal(t) * PetscExpScalar(-x[j][i] * x[j][i]);
+    }
+  user->count += info->xm * info->ym;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FormRHSLocal3d(DMDALocalInfo *info, PetscReal t, PetscScalar ***x, PetscScalar ***f, AppCtx *user)
+{
+  const PetscReal hx = 1.0 / info->mx, hy = 1.0 / info->my, hz = 1.0 / info->mz;
+
+  PetscFunctionBeginUser;
+  for (PetscInt k = info->zs; k < info->zs + info->zm; k++)
+    for (PetscInt j = info->ys; j < info->ys + info->ym; j++)
+      for (PetscInt i = info->xs; i < info->xs + info->xm; i++) {
+        if (!user->periodic && (i == 0 || j == 0 || k == 0 || i == info->mx - 1 || j == info->my - 1 || k == info->mz - 1)) f[k][j][i] = -x[k][j][i];
+        else
+          f[k][j][i] = (x[k][j][i - 1] - 2.0 * x[k][j][i] + x[k][j][i + 1]) / (hx * hx) + (x[k][j - 1][i] - 2.0 * x[k][j][i] + x[k][j + 1][i]) / (hy * hy) + (x[k - 1][j][i] - 2.0 * x[k][j][i] + x[k + 1][j][i]) / (hz * hz) + user->lambda * PetscSinReal(t) * PetscExpScalar(-x[k][j][i] * x[k][j][i]);
+      }
+  user->count += info->xm * info->ym * info->zm;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM                        da;
+  TS                        ts;
+  Vec                       x, f, g;
+  AppCtx                    user;
+  PetscInt                  dim = 2, M = 16, nlocal, steps;
+  PetscReal                 nrm, err;
+  PetscRandom               rand;
+  DMBoundaryType            bt;
+  DMDATSRHSFunctionLocalFn *func;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  user.lambda   = 6.0;
+  user.periodic = PETSC_FALSE;
+  PetscOptionsBegin(PETSC_COMM_WORLD, "", "Split local right-hand side test options", "TS");
+  PetscCall(PetscOptionsInt("-dim", "Dimension", NULL, dim, &dim, NULL));
+  PetscCall(PetscOptionsInt("-M", "Number of points in each direction", NULL, M, &M, NULL));
+  PetscCall(PetscOptionsReal("-lambda", "Reaction parameter", NULL, user.lambda, &user.lambda, NULL));
+  PetscCall(PetscOptionsBool("-periodic", "Use periodic boundaries", NULL, user.periodic, &user.periodic, NULL));
+  PetscOptionsEnd();
+
+  bt = user.periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+  if (dim == 2) {
+    PetscCall(DMDACreate2d(PETSC_COMM_WORLD, bt, bt, DMDA_STENCIL_STAR, M, M, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, &da));
+    func = (DMDATSRHSFunctionLocalFn *)FormRHSLocal2d;
+  } else {
+    PetscCall(DMDACreate3d(PETSC_COMM_WORLD, bt, bt, bt, DMDA_STENCIL_STAR, M, M, M, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, 1, 1, NULL, NULL, NULL, &da));
+    func = (DMDATSRHSFunctionLocalFn *)FormRHSLocal3d;
+  }
+  PetscCall(DMSetFromOptions(da));
+  PetscCall(DMSetUp(da));
+  PetscCall(DMCreateGlobalVector(da, &x));
+  PetscCall(VecDuplicate(x, &f));
+  PetscCall(VecDuplicate(x, &g));
+  PetscCall(VecGetLocalSize(x, &nlocal));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rand));
+  PetscCall(VecSetRandom(x, rand));
+  PetscCall(PetscRandomDestroy(&rand));
+
+  PetscCall(TSCreate(PETSC_COMM_WORLD, &ts));
+  PetscCall(TSSetDM(ts, da));
+  PetscCall(TSSetProblemType(ts, TS_NONLINEAR));
+  PetscCall(DMDATSSetRHSFunctionLocal(da, INSERT_VALUES, func, &user));
+  PetscCall(TSComputeRHSFunction(ts, 0.5, x, f));
+  PetscCall(DMDATSSetRHSFunctionLocalSplit(da, func, func, &user));
+  user.count = 0;
+  PetscCall(TSComputeRHSFunction(ts, 0.5, x, g));
+  PetscCheck(user.count == nlocal, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Evaluated %" PetscInt_FMT " points instead of %" PetscInt_FMT, user.count, nlocal);
+  PetscCall(VecAXPY(g, -1.0, f));
+  PetscCall(VecNorm(g, NORM_INFINITY, &err));
+  PetscCall(VecNorm(f, NORM_INFINITY, &nrm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Split right-hand side %s\n", err <= 1e-14 * nrm ? "matches" : "differs"));
+
+  /* integrate a few steps with the split right-hand side */
+  PetscCall(TSSetType(ts, TSRK));
+  PetscCall(TSSetTimeStep(ts, 0.1 / (M * M * dim)));
+  PetscCall(TSSetMaxSteps(ts, 10));
+  PetscCall(TSSetExactFinalTime(ts, TS_EXACTFINALTIME_STEPOVER));
+  PetscCall(TSSetFromOptions(ts));
+  PetscCall(VecSet(x, 0.0));
+  PetscCall(TSSolve(ts, x));
+  PetscCall(TSGetStepNumber(ts, &steps));
+  PetscCall(VecNorm(x, NORM_2, &nrm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%" PetscInt_FMT " steps, solution norm %.4g\n", steps, (double)nrm));
+
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&f));
+  PetscCall(VecDestroy(&g));
+  PetscCall(TSDestroy(&ts));
+  PetscCall(DMDestroy(&da));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    output_file: output/ex38_1.out
+
+    test:
+      suffix: 1
+
+    test:
+      suffix: 1_par
+      nsize: 4
+
+  testset:
+    args: -dim 3 -M 8
+    output_file: output/ex38_3d.out
+
+    test:
+      suffix: 3d
+
+    test:
+      suffix: 3d_par
+      nsize: 4
+
+  test:
+    suffix: thin
+    nsize: 3
+    args: -da_processors_x 3 -M 7
+
+  testset:
+    args: -periodic
+    output_file: output/ex38_periodic.out
+
+    test:
+      suffix: periodic
+
+    test:
+      suffix: periodic_par
+      nsize: 4
+
+TEST*/
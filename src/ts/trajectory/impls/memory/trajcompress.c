@@ -0,0 +1,483 @@
+#include "trajcompress.h"
+#if defined(PETSC_HAVE_PTHREAD)
+  #include <pthread.h>
+#endif
+
+/* how the stored bytes of a TJCompressedVec are decoded */
+enum {
+  TJC_RAW,        /* copy of the local array */
+  TJC_SHUFFLE_LZ, /* LZ coded byte-shuffled array */
+  TJC_QUANT,      /* varints of the zigzag coded differences of the quantized values */
+  TJC_QUANT_LZ    /* LZ coded TJC_QUANT stream */
+};
+
+#define TJC_LZ_HASH_LOG   14
+#define TJC_LZ_MIN_MATCH  4
+#define TJC_LZ_MAX_OFFSET 65535
+
+struct _n_TJCompressJob {
+  TJCompressedVec *cv;
+  PetscInt         n;
+  unsigned char   *raw; /* staging copy of the local array */
+  unsigned char   *mid; /* shuffled bytes or varint stream */
+  unsigned char   *out; /* LZ output */
+  size_t           len, midlen;
+  int              method;
+  PetscBool        done;
+  TJCompressJob    next;  /* in the queue of the helper thread */
+  TJCompressJob    inext; /* in the list of jobs not finalized yet */
+};
+
+struct _n_TJCompressor {
+  TSTrajectoryMemoryCompressionType type;
+  PetscReal                         tol;
+  PetscLogDouble                    rawbytes, storedbytes; /* of the vectors currently stored */
+  uint32_t                         *table;                 /* hash table of the LZ coder, only used by the thread that compresses */
+  TJCompressJob                     inflight;
+  PetscBool                         threaded;
+#if defined(PETSC_HAVE_PTHREAD)
+  pthread_t       thread;
+  pthread_mutex_t lock;
+  pthread_cond_t  work, finished;
+  TJCompressJob   head, tail;
+  PetscBool       shutdown;
+#endif
+};
+
+/* The kernels below run on the helper thread, they must not call into PETSc */
+
+static inline uint32_t TJCRead32(const unsigned char *p)
+{
+  uint32_t v;
+
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint32_t TJCHash(uint32_t v)
+{
+  return (v * 2654435761U) >> (32 - TJC_LZ_HASH_LOG);
+}
+
+static inline unsigned char *TJCPutLength(unsigned char *op, size_t l)
+{
+  for (; l >= 255; l -= 255) *op++ = 255;
+  *op++ = (unsigned char)l;
+  return op;
+}
+
+/*
+   LZ77 coder in the spirit of LZ4: a sequence is a token (4 bits of literal length, 4 bits of match length), the literals,
+   a 16-bit offset and the match; the last sequence has only literals. Returns the coded length, 0 if it does not fit in cap.
+*/
+static size_t TJCLZCompress(const unsigned char *in, size_t n, unsigned char *out, size_t cap, uint32_t *table)
+{
+  const unsigned char *ip = in, *anchor = in, *end = in + n;
+  unsigned char       *op = out, *oend = out + cap, *token;
+  size_t               lit, mlen, off;
+
+  memset(table, 0, sizeof(*table) << TJC_LZ_HASH_LOG);
+  while (end - ip >= TJC_LZ_MIN_MATCH) {
+    const uint32_t       seq = TJCRead32(ip), h = TJCHash(seq);
+    const unsigned char *ref = in + table[h], *mp = ip + TJC_LZ_MIN_MATCH, *rp;
+
+    table[h] = (uint32_t)(ip - in);
+    if (ref >= ip || ip - ref > TJC_LZ_MAX_OFFSET || TJCRead32(ref) != seq) {
+      ip++;
+      continue;
+    }
+    for (rp = ref + TJC_LZ_MIN_MATCH; mp < end && *mp == *rp; mp++, rp++) { }
+    lit  = (size_t)(ip - anchor);
+    mlen = (size_t)(mp - ip) - TJC_LZ_MIN_MATCH;
+    off  = (size_t)(ip - ref);
+    if ((size_t)(oend - op) < 1 + lit / 255 + 1 + lit + 2 + mlen / 255 + 1) return 0;
+    token  = op++;
+    *token = (unsigned char)((PetscMin(lit, 15) << 4) | PetscMin(mlen, 15));
+    if (lit >= 15) op = TJCPutLength(op, lit - 15);
+    memcpy(op, anchor, lit);
+    op += lit;
+    *op++ = (unsigned char)(off & 255);
+    *op++ = (unsigned char)(off >> 8);
+    if (mlen >= 15) op = TJCPutLength(op, mlen - 15);
+    ip = anchor = mp;
+  }
+  lit = (size_t)(end - anchor);
+  if ((size_t)(oend - op) < 1 + lit / 255 + 1 + lit) return 0;
+  token  = op++;
+  *token = (unsigned char)(PetscMin(lit, 15) << 4);
+  if (lit >= 15) op = TJCPutLength(op, lit - 15);
+  memcpy(op, anchor, lit);
+  op += lit;
+  return (size_t)(op - out);
+}
+
+static inline PetscBool TJCGetLength(const unsigned char **ip, const unsigned char *iend, size_t *l)
+{
+  unsigned char b;
+
+  do {
+    if (*ip >= iend) return PETSC_FALSE;
+    b = *(*ip)++;
+    *l += b;
+  } while (b == 255);
+  return PETSC_TRUE;
+}
+
+static PetscBool TJCLZDecompress(const unsigned char *in, size_t n, unsigned char *out, size_t outlen)
+{
+  const unsigned char *ip = in, *iend = in + n;
+  unsigned char       *op = out, *oend = out + outlen;
+
+  while (ip < iend) {
+    const unsigned token = *ip++;
+    size_t         lit = token >> 4, mlen = token & 15, off;
+
+    if (lit == 15 && !TJCGetLength(&ip, iend, &lit)) return PETSC_FALSE;
+    if (lit > (size_t)(iend - ip) || lit > (size_t)(oend - op)) return PETSC_FALSE;
+    memcpy(op, ip, lit);
+    op += lit;
+    ip += lit;
+    if (ip == iend) break;
+    if (iend - ip < 2) return PETSC_FALSE;
+    off = (size_t)ip[0] | (size_t)ip[1] << 8;
+    ip += 2;
+    if (mlen == 15 && !TJCGetLength(&ip, iend, &mlen)) return PETSC_FALSE;
+    mlen += TJC_LZ_MIN_MATCH;
+    if (!off || off > (size_t)(op - out) || mlen > (size_t)(oend - op)) return PETSC_FALSE;
+    for (const unsigned char *ref = op - off, *mend = op + mlen; op < mend;) *op++ = *ref++; /* the match may overlap its output */
+  }
+  return op == oend ? PETSC_TRUE : PETSC_FALSE;
+}
+
+/* group the k-th bytes of all the values, the exponent and high mantissa bytes of smooth fields then form long runs */
+static void TJCShuffle(const unsigned char *in, size_t n, size_t s, unsigned char *out)
+{
+  for (size_t k = 0; k < s; k++)
+    for (size_t i = 0; i < n; i++) out[k * n + i] = in[i * s + k];
+}
+
+static void TJCUnshuffle(const unsigned char *in, size_t n, size_t s, unsigned char *out)
+{
+  for (size_t k = 0; k < s; k++)
+    for (size_t i = 0; i < n; i++) out[i * s + k] = in[k * n + i];
+}
+
+/* Returns the length of the varint stream, 0 if a value cannot be quantized with step h or the stream does not fit in cap */
+static size_t TJCQuantize(const PetscReal *x, size_t n, PetscReal h, unsigned char *out, size_t cap)
+{
+  unsigned char *op = out, *oend = out + cap;
+  int64_t        prev = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    const PetscReal q = x[i] / h;
+    int64_t         v, d;
+    uint64_t        z;
+
+    if (!(PetscAbsReal(q) < 4.0e18)) return 0; /* also catches Inf and NaN */
+    v    = (int64_t)PetscFloorReal(q + (PetscReal)0.5);
+    d    = v - prev;
+    prev = v;
+    z    = ((uint64_t)d << 1) ^ (uint64_t)(d >> 63);
+    for (; z >= 128; z >>= 7) {
+      if (op == oend) return 0;
+      *op++ = (unsigned char)(z | 128);
+    }
+    if (op == oend) return 0;
+    *op++ = (unsigned char)z;
+  }
+  return (size_t)(op - out);
+}
+
+static PetscBool TJCDequantize(const unsigned char *in, size_t len, PetscReal h, PetscReal *x, size_t n)
+{
+  const unsigned char *ip = in, *iend = in + len;
+  int64_t              v  = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    uint64_t z = 0;
+    int      shift;
+
+    for (shift = 0;; shift += 7) {
+      if (ip == iend || shift > 63) return PETSC_FALSE;
+      z |= (uint64_t)(*ip & 127) << shift;
+      if (!(*ip++ & 128)) break;
+    }
+    v += (int64_t)(z >> 1) ^ -(int64_t)(z & 1);
+    x[i] = (PetscReal)v * h;
+  }
+  return ip == iend ? PETSC_TRUE : PETSC_FALSE;
+}
+
+static void TJCompressJobRun(TJCompressor c, TJCompressJob job)
+{
+  const size_t nr = (size_t)job->n * (sizeof(PetscScalar) / sizeof(PetscReal)), nbytes = nr * sizeof(PetscReal);
+  size_t       len;
+
+  job->method = TJC_RAW;
+  job->len    = nbytes;
+  if (nbytes > UINT32_MAX) return; /* the LZ coder keeps 32-bit positions */
+  if (c->type == TS_TRAJECTORY_MEMORY_COMPRESS_LOSSY) {
+    job->midlen = TJCQuantize((const PetscReal *)job->raw, nr, 2 * c->tol, job->mid, nbytes);
+    if (job->midlen) {
+      job->method = TJC_QUANT;
+      job->len    = job->midlen;
+      len         = TJCLZCompress(job->mid, job->midlen, job->out, job->midlen, c->table);
+      if (len && len < job->midlen) {
+        job->method = TJC_QUANT_LZ;
+        job->len    = len;
+      }
+      return;
+    }
+  }
+  /* lossless, or values too large for the lossy tolerance */
+  TJCShuffle(job->raw, nr, sizeof(PetscReal), job->mid);
+  len = TJCLZCompress(job->mid, nbytes, job->out, nbytes, c->table);
+  if (len && len < nbytes) {
+    job->method = TJC_SHUFFLE_LZ;
+    job->len    = len;
+  }
+}
+
+#if defined(PETSC_HAVE_PTHREAD)
+static void *TJCompressorThread(void *ctx)
+{
+  TJCompressor  c = (TJCompressor)ctx;
+  TJCompressJob job;
+
+  pthread_mutex_lock(&c->lock);
+  for (;;) {
+    while (!c->head && !c->shutdown) pthread_cond_wait(&c->work, &c->lock);
+    if (!c->head) break;
+    job     = c->head;
+    c->head = job->next;
+    if (!c->head) c->tail = NULL;
+    pthread_mutex_unlock(&c->lock);
+    TJCompressJobRun(c, job);
+    pthread_mutex_lock(&c->lock);
+    job->done = PETSC_TRUE;
+    pthread_cond_broadcast(&c->finished);
+  }
+  pthread_mutex_unlock(&c->lock);
+  return NULL;
+}
+#endif
+
+/* move the result of a finished job into its vector, the job must have been removed from the inflight list */
+static PetscErrorCode TJCompressJobFinalize(TJCompressor c, TJCompressJob job)
+{
+  TJCompressedVec     *cv = job->cv;
+  const unsigned char *res;
+
+  PetscFunctionBegin;
+  switch (job->method) {
+  case TJC_RAW:
+    res = job->raw;
+    break;
+  case TJC_QUANT:
+    res = job->mid;
+    break;
+  default:
+    res = job->out;
+  }
+  cv->method = job->method;
+  cv->len    = job->len;
+  cv->midlen = job->midlen;
+  PetscCall(PetscMalloc1(cv->len, &cv->buf));
+  PetscCall(PetscMemcpy(cv->buf, res, cv->len));
+  PetscCall(PetscFree3(job->raw, job->mid, job->out));
+  PetscCall(PetscFree(job));
+  cv->job = NULL;
+  c->storedbytes += (PetscLogDouble)cv->len;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* finalize the jobs the helper thread is done with, so that their staging buffers are released as soon as possible */
+static PetscErrorCode TJCompressorReap(TJCompressor c)
+{
+  TJCompressJob done = NULL, *p, job;
+
+  PetscFunctionBegin;
+  if (!c->threaded) PetscFunctionReturn(PETSC_SUCCESS);
+#if defined(PETSC_HAVE_PTHREAD)
+  pthread_mutex_lock(&c->lock);
+  for (p = &c->inflight; *p;) {
+    job = *p;
+    if (job->done) {
+      *p         = job->inext;
+      job->inext = done;
+      done       = job;
+    } else p = &job->inext;
+  }
+  pthread_mutex_unlock(&c->lock);
+#endif
+  while (done) {
+    job  = done;
+    done = job->inext;
+    PetscCall(TJCompressJobFinalize(c, job));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode TJCompressorWait(TJCompressor c, TJCompressedVec *cv)
+{
+  TJCompressJob job = cv->job, *p;
+
+  PetscFunctionBegin;
+  if (!job) PetscFunctionReturn(PETSC_SUCCESS);
+#if defined(PETSC_HAVE_PTHREAD)
+  pthread_mutex_lock(&c->lock);
+  while (!job->done) pthread_cond_wait(&c->finished, &c->lock);
+  for (p = &c->inflight; *p != job; p = &(*p)->inext) { }
+  *p = job->inext;
+  pthread_mutex_unlock(&c->lock);
+#else
+  (void)p;
+#endif
+  PetscCall(TJCompressJobFinalize(c, job));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode TJCompressorCreate(TSTrajectoryMemoryCompressionType type, PetscReal tol, TJCompressor *compressor)
+{
+  TJCompressor c;
+
+  PetscFunctionBegin;
+  PetscCheck(type != TS_TRAJECTORY_MEMORY_COMPRESS_LOSSY || tol > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Lossy compression needs a positive tolerance, not %g", (double)tol);
+  PetscCall(PetscNew(&c));
+  c->type = type;
+  c->tol  = tol;
+  PetscCall(PetscMalloc1((size_t)1 << TJC_LZ_HASH_LOG, &c->table));
+#if defined(PETSC_HAVE_PTHREAD)
+  pthread_mutex_init(&c->lock, NULL);
+  pthread_cond_init(&c->work, NULL);
+  pthread_cond_init(&c->finished, NULL);
+  c->threaded = pthread_create(&c->thread, NULL, TJCompressorThread, c) ? PETSC_FALSE : PETSC_TRUE;
+  if (!c->threaded) PetscCall(PetscInfo(NULL, "Could not start the helper thread, compressing checkpoints synchronously\n"));
+#endif
+  *compressor = c;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode TJCompressorDestroy(TJCompressor *compressor)
+{
+  TJCompressor c = *compressor;
+
+  PetscFunctionBegin;
+  if (!c) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCheck(!c->inflight, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Destroying a compressor with pending compressions");
+#if defined(PETSC_HAVE_PTHREAD)
+  if (c->threaded) {
+    pthread_mutex_lock(&c->lock);
+    c->shutdown = PETSC_TRUE;
+    pthread_cond_signal(&c->work);
+    pthread_mutex_unlock(&c->lock);
+    pthread_join(c->thread, NULL);
+  }
+  pthread_cond_destroy(&c->finished);
+  pthread_cond_destroy(&c->work);
+  pthread_mutex_destroy(&c->lock);
+#endif
+  PetscCall(PetscFree(c->table));
+  PetscCall(PetscFree(*compressor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Starts compressing the local part of X into cv; X can be modified as soon as this returns */
+PetscErrorCode TJCompressorStore(TJCompressor c, Vec X, TJCompressedVec *cv)
+{
+  const PetscScalar *x;
+  TJCompressJob      job;
+  size_t             nbytes;
+
+  PetscFunctionBegin;
+  PetscCall(TJCompressorClear(c, cv));
+  PetscCall(TJCompressorReap(c));
+  PetscCall(PetscNew(&job));
+  PetscCall(VecGetLocalSize(X, &job->n));
+  nbytes = (size_t)job->n * sizeof(PetscScalar);
+  PetscCall(PetscMalloc3(nbytes, &job->raw, nbytes, &job->mid, nbytes, &job->out));
+  PetscCall(VecGetArrayRead(X, &x));
+  PetscCall(PetscMemcpy(job->raw, x, nbytes));
+  PetscCall(VecRestoreArrayRead(X, &x));
+  job->cv = cv;
+  cv->n   = job->n;
+  cv->h   = 2 * c->tol;
+  cv->job = job;
+  c->rawbytes += (PetscLogDouble)nbytes;
+  if (c->threaded) {
+#if defined(PETSC_HAVE_PTHREAD)
+    pthread_mutex_lock(&c->lock);
+    if (c->tail) c->tail->next = job;
+    else c->head = job;
+    c->tail     = job;
+    job->inext  = c->inflight;
+    c->inflight = job;
+    pthread_cond_signal(&c->work);
+    pthread_mutex_unlock(&c->lock);
+#endif
+  } else {
+    TJCompressJobRun(c, job);
+    PetscCall(TJCompressJobFinalize(c, job));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Decompresses cv into the local part of X, waiting for its compression to finish if needed */
+PetscErrorCode TJCompressorLoad(TJCompressor c, TJCompressedVec *cv, Vec X)
+{
+  PetscScalar   *x;
+  unsigned char *tmp;
+  PetscInt       n;
+  const size_t   nr = (size_t)cv->n * (sizeof(PetscScalar) / sizeof(PetscReal)), nbytes = nr * sizeof(PetscReal);
+  PetscBool      ok = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  PetscCall(TJCompressorWait(c, cv));
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCheck(n == cv->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Checkpoint has %" PetscInt_FMT " local entries, vector has %" PetscInt_FMT, cv->n, n);
+  PetscCall(VecGetArrayWrite(X, &x));
+  switch (cv->method) {
+  case TJC_RAW:
+    PetscCall(PetscMemcpy(x, cv->buf, nbytes));
+    break;
+  case TJC_SHUFFLE_LZ:
+    PetscCall(PetscMalloc1(nbytes, &tmp));
+    ok = TJCLZDecompress(cv->buf, cv->len, tmp, nbytes);
+    if (ok) TJCUnshuffle(tmp, nr, sizeof(PetscReal), (unsigned char *)x);
+    PetscCall(PetscFree(tmp));
+    break;
+  case TJC_QUANT:
+    ok = TJCDequantize(cv->buf, cv->len, cv->h, (PetscReal *)x, nr);
+    break;
+  case TJC_QUANT_LZ:
+    PetscCall(PetscMalloc1(cv->midlen, &tmp));
+    ok = TJCLZDecompress(cv->buf, cv->len, tmp, cv->midlen);
+    if (ok) ok = TJCDequantize(tmp, cv->midlen, cv->h, (PetscReal *)x, nr);
+    PetscCall(PetscFree(tmp));
+    break;
+  }
+  PetscCall(VecRestoreArrayWrite(X, &x));
+  PetscCheck(ok, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Corrupted compressed checkpoint");
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode TJCompressorClear(TJCompressor c, TJCompressedVec *cv)
+{
+  PetscFunctionBegin;
+  PetscCall(TJCompressorWait(c, cv));
+  c->rawbytes -= (PetscLogDouble)cv->n * sizeof(PetscScalar);
+  c->storedbytes -= (PetscLogDouble)cv->len;
+  PetscCall(PetscFree(cv->buf));
+  PetscCall(PetscMemzero(cv, sizeof(*cv)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Sizes in bytes of the vectors currently stored, before and after compression; waits for the pending compressions */
+PetscErrorCode TJCompressorGetSizes(TJCompressor c, PetscLogDouble *rawbytes, PetscLogDouble *storedbytes)
+{
+  PetscFunctionBegin;
+  while (c->inflight) PetscCall(TJCompressorWait(c, c->inflight->cv));
+  if (rawbytes) *rawbytes = c->rawbytes;
+  if (storedbytes) *storedbytes = c->storedbytes;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <petsc/private/tsimpl.h>
+
+/*
+   Compression of the checkpoints kept in RAM by TSTRAJECTORYMEMORY.
+
+   A vector is either stored as a byte-shuffled stream (lossless) or quantized to a prescribed absolute error (lossy), and
+   the result is packed with a small LZ77 coder. The compression runs on a helper thread when PETSc has pthreads, the caller
+   only pays for a copy of the local array; every access to the stored data waits for the pending compression to finish.
+*/
+typedef struct _n_TJCompressor *TJCompressor;
+typedef struct _n_TJCompressJob *TJCompressJob;
+
+typedef struct {
+  unsigned char *buf;    /* stored bytes */
+  size_t         len;    /* number of stored bytes */
+  size_t         midlen; /* length of the stream fed to the LZ coder */
+  PetscInt       n;      /* number of local scalars */
+  PetscReal      h;      /* quantization step of the lossy method */
+  int            method; /* how buf has to be decoded */
+  TJCompressJob  job;    /* compression pending on the helper thread, NULL if none */
+} TJCompressedVec;
+
+PETSC_INTERN PetscErrorCode TJCompressorCreate(TSTrajectoryMemoryCompressionType, PetscReal, TJCompressor *);
+PETSC_INTERN PetscErrorCode TJCompressorDestroy(TJCompressor *);
+PETSC_INTERN PetscErrorCode TJCompressorStore(TJCompressor, Vec, TJCompressedVec *);
+PETSC_INTERN PetscErrorCode TJCompressorLoad(TJCompressor, TJCompressedVec *, Vec);
+PETSC_INTERN PetscErrorCode TJCompressorClear(TJCompressor, TJCompressedVec *);
+PETSC_INTERN PetscErrorCode TJCompressorGetSizes(TJCompressor, PetscLogDouble *, PetscLogDouble *);
@@ -1,5 +1,12 @@
 #include <petsc/private/tsimpl.h> /*I "petscts.h"  I*/
 #include <petscsys.h>
+#include "trajcompress.h"
+#if defined(PETSC_HAVE_FCNTL_H)
+  #include <fcntl.h>
+#endif
+#if defined(PETSC_HAVE_UNISTD_H)
+  #include <unistd.h>
+#endif
 #if defined(PETSC_HAVE_REVOLVE)
   #include <revolve_c.h>
 
@@ -44,19 +51,21 @@ typedef enum {
   SOLUTION_STAGES = 2
 } CheckpointType;
 
-const char *const TSTrajectoryMemoryTypes[] = {"REVOLVE", "CAMS", "PETSC", "TSTrajectoryMemoryType", "TJ_", NULL};
+const char *const TSTrajectoryMemoryTypes[]            = {"REVOLVE", "CAMS", "PETSC", "TSTrajectoryMemoryType", "TJ_", NULL};
+const char *const TSTrajectoryMemoryCompressionTypes[] = {"NONE", "LOSSLESS", "LOSSY", "TSTrajectoryMemoryCompressionType", "TS_TRAJECTORY_MEMORY_COMPRESS_", NULL};
 
 #define HaveSolution(m) ((m) == SOLUTIONONLY || (m) == SOLUTION_STAGES)
 #define HaveStages(m)   ((m) == STAGESONLY || (m) == SOLUTION_STAGES)
 
 typedef struct _StackElement {
-  PetscInt       stepnum;
-  Vec            X;
-  Vec           *Y;
-  PetscReal      time;
-  PetscReal      timeprev; /* for no solution_only mode */
-  PetscReal      timenext; /* for solution_only mode */
-  CheckpointType cptype;
+  PetscInt         stepnum;
+  Vec              X;
+  Vec             *Y;
+  TJCompressedVec *cvec; /* solution and stages, in place of X and Y when the stack compresses */
+  PetscReal        time;
+  PetscReal        timeprev; /* for no solution_only mode */
+  PetscReal        timenext; /* for solution_only mode */
+  CheckpointType   cptype;
 } *StackElement;
 
 #if defined(PETSC_HAVE_REVOLVE)
@@ -94,6 +103,9 @@ typedef struct _Stack {
   PetscInt      numY;
   PetscBool     solution_only;
   PetscBool     use_dram;
+  TJCompressor  compressor; /* NULL if the checkpoints are not compressed */
+  Vec           workX;      /* work vectors to write and read compressed checkpoints to and from disk */
+  Vec          *workY;
 } Stack;
 
 typedef struct _DiskStack {
@@ -103,8 +115,9 @@ typedef struct _DiskStack {
 } DiskStack;
 
 typedef struct _TJScheduler {
-  SchedulerType          stype;
-  TSTrajectoryMemoryType tj_memory_type;
+  SchedulerType                     stype;
+  TSTrajectoryMemoryType            tj_memory_type;
+  TSTrajectoryMemoryCompressionType compress;
 #if defined(PETSC_HAVE_REVOLVE)
   RevolveCTX *rctx, *rctx2;
   PetscBool   use_online;
@@ -122,9 +135,18 @@ typedef struct _TJScheduler {
   PetscInt    max_cps_disk;   /* maximum checkpoints on disk */
   PetscInt    stride;
   PetscInt    total_steps; /* total number of steps */
+  PetscInt    max_cps_ram_set, max_units_ram_set; /* RAM budget given by the user, before scaling by compress_ratio */
+  PetscBool   ram_scaled;
+  PetscReal   compress_tol;
+  PetscReal   compress_ratio; /* expected compression ratio, scales the RAM budget */
   Stack       stack;
   DiskStack   diskstack;
   PetscViewer viewer;
+  char       *local_dirname;                 /* node-local directory, NULL if all the files go to tj->dirname */
+  char        local_dir[PETSC_MAX_PATH_LEN]; /* directory of this process in local_dirname, empty until it is created */
+  PetscInt    max_cps_local;                 /* maximum number of checkpoint files in local_dir, -1 if unlimited */
+  PetscViewer lviewer;                       /* writes the files in local_dir */
+  PetscBool   prefetch;                      /* ask the OS to read ahead the file that the backward sweep loads next */
 } TJScheduler;
 
 static PetscErrorCode TurnForwardWithStepsize(TS ts, PetscReal nextstepsize)
@@ -164,6 +186,22 @@ static PetscErrorCode ElementCreate(TS ts, CheckpointType cptype, Stack *stack,
   Vec *Y;
 
   PetscFunctionBegin;
+  if (stack->compressor) { /* the element only holds the compressed vectors, slot 0 for the solution and slot i+1 for stage i */
+    PetscCall(TSGetStages(ts, &stack->numY, &Y));
+    if (stack->top < stack->stacksize - 1 && stack->container[stack->top + 1]) {
+      *e = stack->container[stack->top + 1];
+      if (!HaveSolution(cptype)) PetscCall(TJCompressorClear(stack->compressor, &(*e)->cvec[0]));
+      if (!HaveStages(cptype)) {
+        for (PetscInt i = 0; i < stack->numY; i++) PetscCall(TJCompressorClear(stack->compressor, &(*e)->cvec[i + 1]));
+      }
+    } else {
+      PetscCall(PetscNew(e));
+      PetscCall(PetscCalloc1(stack->numY + 1, &(*e)->cvec));
+      stack->nallocated++;
+    }
+    (*e)->cptype = cptype;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (stack->top < stack->stacksize - 1 && stack->container[stack->top + 1]) {
     *e = stack->container[stack->top + 1];
     if (HaveSolution(cptype) && !(*e)->X) {
@@ -195,6 +233,38 @@ static PetscErrorCode ElementCreate(TS ts, CheckpointType cptype, Stack *stack,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Stores X as the solution (i = 0) or the stage i-1 of the element, compressing it if the stack compresses */
+static PetscErrorCode ElementSetVec(Stack *stack, StackElement e, PetscInt i, Vec X)
+{
+  PetscFunctionBegin;
+  if (stack->compressor) PetscCall(TJCompressorStore(stack->compressor, X, &e->cvec[i]));
+  else PetscCall(VecCopy(X, i ? e->Y[i - 1] : e->X));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Copies the solution (i = 0) or the stage i-1 of the element into X */
+static PetscErrorCode ElementGetVec(Stack *stack, StackElement e, PetscInt i, Vec X)
+{
+  PetscFunctionBegin;
+  if (stack->compressor) PetscCall(TJCompressorLoad(stack->compressor, &e->cvec[i], X));
+  else PetscCall(VecCopy(i ? e->Y[i - 1] : e->X, X));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Work vectors to pass compressed elements to WriteToDisk() and ReadFromDisk() */
+static PetscErrorCode StackGetWorkVecs(TS ts, Stack *stack, Vec *X, Vec **Y)
+{
+  Vec *Yts;
+
+  PetscFunctionBegin;
+  PetscCall(TSGetStages(ts, &stack->numY, &Yts));
+  if (!stack->workX) PetscCall(VecDuplicate(ts->vec_sol, &stack->workX));
+  if (!stack->workY && stack->numY) PetscCall(VecDuplicateVecs(Yts[0], stack->numY, &stack->workY));
+  *X = stack->workX;
+  *Y = stack->workY;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode ElementSet(TS ts, Stack *stack, StackElement *e, PetscInt stepnum, PetscReal time, Vec X)
 {
   Vec      *Y;
@@ -202,10 +272,10 @@ static PetscErrorCode ElementSet(TS ts, Stack *stack, StackElement *e, PetscInt
   PetscReal timeprev;
 
   PetscFunctionBegin;
-  if (HaveSolution((*e)->cptype)) PetscCall(VecCopy(X, (*e)->X));
+  if (HaveSolution((*e)->cptype)) PetscCall(ElementSetVec(stack, *e, 0, X));
   if (HaveStages((*e)->cptype)) {
     PetscCall(TSGetStages(ts, &stack->numY, &Y));
-    for (i = 0; i < stack->numY; i++) PetscCall(VecCopy(Y[i], (*e)->Y[i]));
+    for (i = 0; i < stack->numY; i++) PetscCall(ElementSetVec(stack, *e, i + 1, Y[i]));
   }
   (*e)->stepnum = stepnum;
   (*e)->time    = time;
@@ -222,6 +292,10 @@ static PetscErrorCode ElementSet(TS ts, Stack *stack, StackElement *e, PetscInt
 static PetscErrorCode ElementDestroy(Stack *stack, StackElement e)
 {
   PetscFunctionBegin;
+  if (e->cvec) {
+    for (PetscInt i = 0; i <= stack->numY; i++) PetscCall(TJCompressorClear(stack->compressor, &e->cvec[i]));
+    PetscCall(PetscFree(e->cvec));
+  }
   if (stack->use_dram) PetscCall(PetscMallocSetDRAM());
   PetscCall(VecDestroy(&e->X));
   if (e->Y) PetscCall(VecDestroyVecs(stack->numY, &e->Y));
@@ -288,6 +362,8 @@ static PetscErrorCode StackDestroy(Stack *stack)
   PetscCheck(stack->top + 1 <= n, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Stack size does not match element counter %" PetscInt_FMT, n);
   for (PetscInt i = 0; i < n; i++) PetscCall(ElementDestroy(stack, stack->container[i]));
   PetscCall(PetscFree(stack->container));
+  PetscCall(VecDestroy(&stack->workX));
+  if (stack->workY) PetscCall(VecDestroyVecs(stack->numY, &stack->workY));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -300,16 +376,110 @@ static PetscErrorCode StackFind(Stack *stack, StackElement *e, PetscInt index)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode WriteToDisk(PetscBool stifflyaccurate, PetscInt stepnum, PetscReal time, PetscReal timeprev, Vec X, Vec *Y, PetscInt numY, CheckpointType cptype, PetscViewer viewer)
+/* the id of the last file written by the two-level schemes, which is the first one read by the backward sweep */
+static PetscInt LastCheckpointId(TJScheduler *tjsch)
+{
+  PetscInt laststridesize = tjsch->total_steps % tjsch->stride;
+
+  if (!laststridesize) laststridesize = tjsch->stride;
+  return (tjsch->total_steps - laststridesize) / tjsch->stride;
+}
+
+/*
+  Every file is written once and read once, so the node-local directory is best used by filling it: when the ids of the
+  two-level schemes are known in advance the files with the largest ids, which the backward sweep reads first, are kept
+  there and the reads from the parallel file system overlap with the recomputation of the strides read before them.
+  The decision only depends on the id so that a file is read from where it was written.
+*/
+static PetscBool CheckpointIsLocal(TJScheduler *tjsch, PetscInt id)
+{
+  if (!tjsch->local_dirname) return PETSC_FALSE;
+  if (tjsch->max_cps_local < 0) return PETSC_TRUE;
+  if (tjsch->stride > 1 && tjsch->total_steps > 0 && tjsch->total_steps < PETSC_MAX_INT) return (PetscBool)(id > LastCheckpointId(tjsch) - tjsch->max_cps_local);
+  return (PetscBool)(id <= tjsch->max_cps_local);
+}
+
+static PetscErrorCode CheckpointGetFilename(TSTrajectory tj, const char kind[], PetscInt id, PetscBool *local, char filename[], size_t len)
+{
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
+
+  PetscFunctionBegin;
+  *local = CheckpointIsLocal(tjsch, id);
+  PetscCall(PetscSNPrintf(filename, len, "%s/TS-%s%06" PetscInt_FMT ".bin", *local ? tjsch->local_dir : tj->dirname, kind, id));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* a node-local file only holds the entries owned by this process */
+static PetscErrorCode CheckpointVecWrite(Vec X, PetscBool local, PetscViewer viewer)
+{
+  const PetscScalar *x;
+  PetscInt           n;
+
+  PetscFunctionBegin;
+  if (!local) {
+    PetscCall(VecView(X, viewer));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetArrayRead(X, &x));
+  PetscCall(PetscViewerBinaryWrite(viewer, x, n, PETSC_SCALAR));
+  PetscCall(VecRestoreArrayRead(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode CheckpointVecRead(Vec X, PetscBool local, PetscViewer viewer)
+{
+  PetscScalar *x;
+  PetscInt     n;
+
+  PetscFunctionBegin;
+  if (!local) {
+    PetscCall(VecLoad(X, viewer));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecGetLocalSize(X, &n));
+  PetscCall(VecGetArrayWrite(X, &x));
+  PetscCall(PetscViewerBinaryRead(viewer, x, n, NULL, PETSC_SCALAR));
+  PetscCall(VecRestoreArrayWrite(X, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* starts reading the file in the background, the process that will read it keeps it in its page cache */
+static PetscErrorCode PrefetchCheckpoint(TSTrajectory tj, PetscInt id)
+{
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
+  char         filename[PETSC_MAX_PATH_LEN];
+  PetscBool    local;
+  PetscMPIInt  rank;
+
+  PetscFunctionBegin;
+  if (!tjsch->prefetch || id < 1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(CheckpointGetFilename(tj, tjsch->save_stack ? "STACK" : "CPS", id, &local, filename, sizeof(filename)));
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)tj), &rank));
+  if (!local && rank) PetscFunctionReturn(PETSC_SUCCESS);
+#if defined(PETSC_HAVE_FCNTL_H) && defined(PETSC_HAVE_UNISTD_H) && defined(POSIX_FADV_WILLNEED)
+  {
+    int fd = open(filename, O_RDONLY);
+
+    if (fd >= 0) {
+      if (posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED)) PetscCall(PetscInfo(tj, "Could not prefetch %s\n", filename));
+      (void)close(fd);
+    }
+  }
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode WriteToDisk(PetscBool stifflyaccurate, PetscInt stepnum, PetscReal time, PetscReal timeprev, Vec X, Vec *Y, PetscInt numY, CheckpointType cptype, PetscBool local, PetscViewer viewer)
 {
   PetscFunctionBegin;
   PetscCall(PetscViewerBinaryWrite(viewer, &stepnum, 1, PETSC_INT));
-  if (HaveSolution(cptype)) PetscCall(VecView(X, viewer));
+  if (HaveSolution(cptype)) PetscCall(CheckpointVecWrite(X, local, viewer));
   if (HaveStages(cptype)) {
     for (PetscInt i = 0; i < numY; i++) {
       /* For stiffly accurate TS methods, the last stage Y[ns-1] is the same as the solution X, thus does not need to be saved again. */
       if (stifflyaccurate && i == numY - 1 && HaveSolution(cptype)) continue;
-      PetscCall(VecView(Y[i], viewer));
+      PetscCall(CheckpointVecWrite(Y[i], local, viewer));
     }
   }
   PetscCall(PetscViewerBinaryWrite(viewer, &time, 1, PETSC_REAL));
@@ -317,16 +487,16 @@ static PetscErrorCode WriteToDisk(PetscBool stifflyaccurate, PetscInt stepnum, P
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode ReadFromDisk(PetscBool stifflyaccurate, PetscInt *stepnum, PetscReal *time, PetscReal *timeprev, Vec X, Vec *Y, PetscInt numY, CheckpointType cptype, PetscViewer viewer)
+static PetscErrorCode ReadFromDisk(PetscBool stifflyaccurate, PetscInt *stepnum, PetscReal *time, PetscReal *timeprev, Vec X, Vec *Y, PetscInt numY, CheckpointType cptype, PetscBool local, PetscViewer viewer)
 {
   PetscFunctionBegin;
   PetscCall(PetscViewerBinaryRead(viewer, stepnum, 1, NULL, PETSC_INT));
-  if (HaveSolution(cptype)) PetscCall(VecLoad(X, viewer));
+  if (HaveSolution(cptype)) PetscCall(CheckpointVecRead(X, local, viewer));
   if (HaveStages(cptype)) {
     for (PetscInt i = 0; i < numY; i++) {
       /* For stiffly accurate TS methods, the last stage Y[ns-1] is the same as the solution X, thus does not need to be loaded again. */
       if (stifflyaccurate && i == numY - 1 && HaveSolution(cptype)) continue;
-      PetscCall(VecLoad(Y[i], viewer));
+      PetscCall(CheckpointVecRead(Y[i], local, viewer));
     }
   }
   PetscCall(PetscViewerBinaryRead(viewer, time, 1, NULL, PETSC_REAL));
@@ -341,26 +511,39 @@ static PetscErrorCode StackDumpAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
   StackElement e     = NULL;
   TJScheduler *tjsch = (TJScheduler *)tj->data;
   char         filename[PETSC_MAX_PATH_LEN];
-  MPI_Comm     comm;
+  PetscBool    local;
+  PetscViewer  viewer;
 
   PetscFunctionBegin;
-  PetscCall(PetscObjectGetComm((PetscObject)ts, &comm));
+  PetscCall(CheckpointGetFilename(tj, "STACK", id, &local, filename, sizeof(filename)));
   if (tj->monitor) {
     PetscCall(PetscViewerASCIIPushTab(tj->monitor));
-    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Dump stack id %" PetscInt_FMT " to file\n", id));
+    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Dump stack id %" PetscInt_FMT " to %sfile\n", id, local ? "node-local " : ""));
     PetscCall(PetscViewerASCIIPopTab(tj->monitor));
   }
-  PetscCall(PetscSNPrintf(filename, sizeof(filename), "%s/TS-STACK%06" PetscInt_FMT ".bin", tj->dirname, id));
-  PetscCall(PetscViewerFileSetName(tjsch->viewer, filename));
-  PetscCall(PetscViewerSetUp(tjsch->viewer));
+  viewer = local ? tjsch->lviewer : tjsch->viewer;
+  PetscCall(PetscViewerFileSetName(viewer, filename));
+  PetscCall(PetscViewerSetUp(viewer));
   ndumped = stack->top + 1;
-  PetscCall(PetscViewerBinaryWrite(tjsch->viewer, &ndumped, 1, PETSC_INT));
+  PetscCall(PetscViewerBinaryWrite(viewer, &ndumped, 1, PETSC_INT));
   for (PetscInt i = 0; i < ndumped; i++) {
+    Vec X = NULL, *Y = NULL;
+
     e          = stack->container[i];
     cptype_int = (PetscInt)e->cptype;
-    PetscCall(PetscViewerBinaryWrite(tjsch->viewer, &cptype_int, 1, PETSC_INT));
+    PetscCall(PetscViewerBinaryWrite(viewer, &cptype_int, 1, PETSC_INT));
+    if (stack->compressor) {
+      PetscCall(StackGetWorkVecs(ts, stack, &X, &Y));
+      if (HaveSolution(e->cptype)) PetscCall(ElementGetVec(stack, e, 0, X));
+      if (HaveStages(e->cptype)) {
+        for (PetscInt j = 0; j < stack->numY; j++) PetscCall(ElementGetVec(stack, e, j + 1, Y[j]));
+      }
+    } else {
+      X = e->X;
+      Y = e->Y;
+    }
     PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
-    PetscCall(WriteToDisk(ts->stifflyaccurate, e->stepnum, e->time, e->timeprev, e->X, e->Y, stack->numY, e->cptype, tjsch->viewer));
+    PetscCall(WriteToDisk(ts->stifflyaccurate, e->stepnum, e->time, e->timeprev, X, Y, stack->numY, e->cptype, local, viewer));
     PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
     ts->trajectory->diskwrites++;
     PetscCall(StackPop(stack, &e));
@@ -368,7 +551,7 @@ static PetscErrorCode StackDumpAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
   /* save the last step for restart, the last step is in memory when using single level schemes, but not necessarily the case for multi level schemes */
   PetscCall(TSGetStages(ts, &stack->numY, &Y));
   PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
-  PetscCall(WriteToDisk(ts->stifflyaccurate, ts->steps, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, tjsch->viewer));
+  PetscCall(WriteToDisk(ts->stifflyaccurate, ts->steps, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, local, viewer));
   PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
   ts->trajectory->diskwrites++;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -376,20 +559,22 @@ static PetscErrorCode StackDumpAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
 
 static PetscErrorCode StackLoadAll(TSTrajectory tj, TS ts, Stack *stack, PetscInt id)
 {
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
   Vec         *Y;
   PetscInt     i, nloaded, cptype_int;
   StackElement e;
   PetscViewer  viewer;
   char         filename[PETSC_MAX_PATH_LEN];
+  PetscBool    local;
 
   PetscFunctionBegin;
+  PetscCall(CheckpointGetFilename(tj, "STACK", id, &local, filename, sizeof(filename)));
   if (tj->monitor) {
     PetscCall(PetscViewerASCIIAddTab(tj->monitor, ((PetscObject)tj)->tablevel));
-    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load stack from file\n"));
+    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load stack from %sfile\n", local ? "node-local " : ""));
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
-  PetscCall(PetscSNPrintf(filename, sizeof filename, "%s/TS-STACK%06" PetscInt_FMT ".bin", tj->dirname, id));
-  PetscCall(PetscViewerBinaryOpen(PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
+  PetscCall(PetscViewerBinaryOpen(local ? PETSC_COMM_SELF : PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
   PetscCall(PetscViewerBinarySetSkipInfo(viewer, PETSC_TRUE));
   PetscCall(PetscViewerPushFormat(viewer, PETSC_VIEWER_NATIVE));
   PetscCall(PetscViewerBinaryRead(viewer, &nloaded, 1, NULL, PETSC_INT));
@@ -397,19 +582,35 @@ static PetscErrorCode StackLoadAll(TSTrajectory tj, TS ts, Stack *stack, PetscIn
     PetscCall(PetscViewerBinaryRead(viewer, &cptype_int, 1, NULL, PETSC_INT));
     PetscCall(ElementCreate(ts, (CheckpointType)cptype_int, stack, &e));
     PetscCall(StackPush(stack, e));
-    PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
-    PetscCall(ReadFromDisk(ts->stifflyaccurate, &e->stepnum, &e->time, &e->timeprev, e->X, e->Y, stack->numY, e->cptype, viewer));
-    PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
+    if (stack->compressor) {
+      Vec X, *Y;
+
+      PetscCall(StackGetWorkVecs(ts, stack, &X, &Y));
+      PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
+      PetscCall(ReadFromDisk(ts->stifflyaccurate, &e->stepnum, &e->time, &e->timeprev, X, Y, stack->numY, e->cptype, local, viewer));
+      PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
+      /* the last stage of stiffly accurate methods is not on disk since it is the solution */
+      if (ts->stifflyaccurate && HaveSolution(e->cptype) && HaveStages(e->cptype) && stack->numY) PetscCall(VecCopy(X, Y[stack->numY - 1]));
+      if (HaveSolution(e->cptype)) PetscCall(ElementSetVec(stack, e, 0, X));
+      if (HaveStages(e->cptype)) {
+        for (PetscInt j = 0; j < stack->numY; j++) PetscCall(ElementSetVec(stack, e, j + 1, Y[j]));
+      }
+    } else {
+      PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
+      PetscCall(ReadFromDisk(ts->stifflyaccurate, &e->stepnum, &e->time, &e->timeprev, e->X, e->Y, stack->numY, e->cptype, local, viewer));
+      PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
+    }
     ts->trajectory->diskreads++;
   }
   /* load the last step into TS */
   PetscCall(TSGetStages(ts, &stack->numY, &Y));
   PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
-  PetscCall(ReadFromDisk(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, viewer));
+  PetscCall(ReadFromDisk(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, local, viewer));
   PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
   ts->trajectory->diskreads++;
   PetscCall(TurnBackward(ts));
   PetscCall(PetscViewerDestroy(&viewer));
+  if (tjsch->stype == TWO_LEVEL_NOREVOLVE || tjsch->stype == TWO_LEVEL_REVOLVE) PetscCall(PrefetchCheckpoint(tj, id - 1)); /* the strides are traversed backward */
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -420,6 +621,7 @@ static PetscErrorCode StackLoadLast(TSTrajectory tj, TS ts, Stack *stack, PetscI
   PetscInt    size;
   PetscViewer viewer;
   char        filename[PETSC_MAX_PATH_LEN];
+  PetscBool   local;
   #if defined(PETSC_HAVE_MPIIO)
   PetscBool usempiio;
   #endif
@@ -427,25 +629,30 @@ static PetscErrorCode StackLoadLast(TSTrajectory tj, TS ts, Stack *stack, PetscI
   off_t off, offset;
 
   PetscFunctionBegin;
+  PetscCall(CheckpointGetFilename(tj, "STACK", id, &local, filename, sizeof(filename)));
   if (tj->monitor) {
     PetscCall(PetscViewerASCIIAddTab(tj->monitor, ((PetscObject)tj)->tablevel));
-    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load last stack element from file\n"));
+    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load last stack element from %sfile\n", local ? "node-local " : ""));
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
   PetscCall(TSGetStages(ts, &stack->numY, &Y));
-  PetscCall(VecGetSize(Y[0], &size));
-  /* VecView writes to file two extra int's for class id and number of rows */
-  off = -((stack->solution_only ? 0 : stack->numY) + 1) * (size * PETSC_BINARY_SCALAR_SIZE + 2 * PETSC_BINARY_INT_SIZE) - PETSC_BINARY_INT_SIZE - 2 * PETSC_BINARY_SCALAR_SIZE;
+  if (local) { /* only the local entries, without header */
+    PetscCall(VecGetLocalSize(Y[0], &size));
+    off = -((stack->solution_only ? 0 : stack->numY) + 1) * (size * PETSC_BINARY_SCALAR_SIZE) - PETSC_BINARY_INT_SIZE - 2 * PETSC_BINARY_SCALAR_SIZE;
+  } else {
+    PetscCall(VecGetSize(Y[0], &size));
+    /* VecView writes to file two extra int's for class id and number of rows */
+    off = -((stack->solution_only ? 0 : stack->numY) + 1) * (size * PETSC_BINARY_SCALAR_SIZE + 2 * PETSC_BINARY_INT_SIZE) - PETSC_BINARY_INT_SIZE - 2 * PETSC_BINARY_SCALAR_SIZE;
+  }
 
-  PetscCall(PetscSNPrintf(filename, sizeof filename, "%s/TS-STACK%06" PetscInt_FMT ".bin", tj->dirname, id));
-  PetscCall(PetscViewerBinaryOpen(PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
+  PetscCall(PetscViewerBinaryOpen(local ? PETSC_COMM_SELF : PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
   PetscCall(PetscViewerBinarySetSkipInfo(viewer, PETSC_TRUE));
   PetscCall(PetscViewerPushFormat(viewer, PETSC_VIEWER_NATIVE));
   #if defined(PETSC_HAVE_MPIIO)
   PetscCall(PetscViewerBinaryGetUseMPIIO(viewer, &usempiio));
   if (usempiio) {
     PetscCall(PetscViewerBinaryGetMPIIODescriptor(viewer, (MPI_File *)&fd));
-    PetscCall(PetscBinarySynchronizedSeek(PetscObjectComm((PetscObject)tj), fd, off, PETSC_BINARY_SEEK_END, &offset));
+    PetscCall(PetscBinarySynchronizedSeek(PetscObjectComm((PetscObject)viewer), fd, off, PETSC_BINARY_SEEK_END, &offset));
   } else {
   #endif
     PetscCall(PetscViewerBinaryGetDescriptor(viewer, &fd));
@@ -455,7 +662,7 @@ static PetscErrorCode StackLoadLast(TSTrajectory tj, TS ts, Stack *stack, PetscI
   #endif
   /* load the last step into TS */
   PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
-  PetscCall(ReadFromDisk(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, viewer));
+  PetscCall(ReadFromDisk(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, local, viewer));
   PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
   ts->trajectory->diskreads++;
   PetscCall(PetscViewerDestroy(&viewer));
@@ -470,23 +677,24 @@ static PetscErrorCode DumpSingle(TSTrajectory tj, TS ts, Stack *stack, PetscInt
   PetscInt     stepnum;
   TJScheduler *tjsch = (TJScheduler *)tj->data;
   char         filename[PETSC_MAX_PATH_LEN];
-  MPI_Comm     comm;
+  PetscBool    local;
+  PetscViewer  viewer;
 
   PetscFunctionBegin;
-  PetscCall(PetscObjectGetComm((PetscObject)ts, &comm));
+  PetscCall(CheckpointGetFilename(tj, "CPS", id, &local, filename, sizeof(filename)));
   if (tj->monitor) {
     PetscCall(PetscViewerASCIIAddTab(tj->monitor, ((PetscObject)tj)->tablevel));
-    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Dump a single point from file\n"));
+    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Dump a single point from %sfile\n", local ? "node-local " : ""));
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
   PetscCall(TSGetStepNumber(ts, &stepnum));
-  PetscCall(PetscSNPrintf(filename, sizeof(filename), "%s/TS-CPS%06" PetscInt_FMT ".bin", tj->dirname, id));
-  PetscCall(PetscViewerFileSetName(tjsch->viewer, filename));
-  PetscCall(PetscViewerSetUp(tjsch->viewer));
+  viewer = local ? tjsch->lviewer : tjsch->viewer;
+  PetscCall(PetscViewerFileSetName(viewer, filename));
+  PetscCall(PetscViewerSetUp(viewer));
 
   PetscCall(TSGetStages(ts, &stack->numY, &Y));
   PetscCall(PetscLogEventBegin(TSTrajectory_DiskWrite, tj, ts, 0, 0));
-  PetscCall(WriteToDisk(ts->stifflyaccurate, stepnum, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, tjsch->viewer));
+  PetscCall(WriteToDisk(ts->stifflyaccurate, stepnum, ts->ptime, ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, local, viewer));
   PetscCall(PetscLogEventEnd(TSTrajectory_DiskWrite, tj, ts, 0, 0));
   ts->trajectory->diskwrites++;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -494,26 +702,29 @@ static PetscErrorCode DumpSingle(TSTrajectory tj, TS ts, Stack *stack, PetscInt
 
 static PetscErrorCode LoadSingle(TSTrajectory tj, TS ts, Stack *stack, PetscInt id)
 {
-  Vec        *Y;
-  PetscViewer viewer;
-  char        filename[PETSC_MAX_PATH_LEN];
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
+  Vec         *Y;
+  PetscViewer  viewer;
+  char         filename[PETSC_MAX_PATH_LEN];
+  PetscBool    local;
 
   PetscFunctionBegin;
+  PetscCall(CheckpointGetFilename(tj, "CPS", id, &local, filename, sizeof(filename)));
   if (tj->monitor) {
     PetscCall(PetscViewerASCIIAddTab(tj->monitor, ((PetscObject)tj)->tablevel));
-    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load a single point from file\n"));
+    PetscCall(PetscViewerASCIIPrintf(tj->monitor, "Load a single point from %sfile\n", local ? "node-local " : ""));
     PetscCall(PetscViewerASCIISubtractTab(tj->monitor, ((PetscObject)tj)->tablevel));
   }
-  PetscCall(PetscSNPrintf(filename, sizeof filename, "%s/TS-CPS%06" PetscInt_FMT ".bin", tj->dirname, id));
-  PetscCall(PetscViewerBinaryOpen(PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
+  PetscCall(PetscViewerBinaryOpen(local ? PETSC_COMM_SELF : PetscObjectComm((PetscObject)tj), filename, FILE_MODE_READ, &viewer));
   PetscCall(PetscViewerBinarySetSkipInfo(viewer, PETSC_TRUE));
   PetscCall(PetscViewerPushFormat(viewer, PETSC_VIEWER_NATIVE));
   PetscCall(TSGetStages(ts, &stack->numY, &Y));
   PetscCall(PetscLogEventBegin(TSTrajectory_DiskRead, tj, ts, 0, 0));
-  PetscCall(ReadFromDisk(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, viewer));
+  PetscCall(ReadFromDisk(ts->stifflyaccurate, &ts->steps, &ts->ptime, &ts->ptime_prev, ts->vec_sol, Y, stack->numY, SOLUTION_STAGES, local, viewer));
   PetscCall(PetscLogEventEnd(TSTrajectory_DiskRead, tj, ts, 0, 0));
   ts->trajectory->diskreads++;
   PetscCall(PetscViewerDestroy(&viewer));
+  if (tjsch->stype == TWO_LEVEL_NOREVOLVE || tjsch->stype == TWO_LEVEL_REVOLVE) PetscCall(PrefetchCheckpoint(tj, id - 1)); /* the strides are traversed backward */
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -524,13 +735,13 @@ static PetscErrorCode UpdateTS(TS ts, Stack *stack, StackElement e, PetscInt ste
 
   PetscFunctionBegin;
   /* In adjoint mode we do not need to copy solution if the stepnum is the same */
-  if (!adjoint_mode || (HaveSolution(e->cptype) && e->stepnum != stepnum)) PetscCall(VecCopy(e->X, ts->vec_sol));
+  if (!adjoint_mode || (HaveSolution(e->cptype) && e->stepnum != stepnum)) PetscCall(ElementGetVec(stack, e, 0, ts->vec_sol));
   if (HaveStages(e->cptype)) {
     PetscCall(TSGetStages(ts, &stack->numY, &Y));
     if (e->stepnum && e->stepnum == stepnum) {
-      for (i = 0; i < stack->numY; i++) PetscCall(VecCopy(e->Y[i], Y[i]));
+      for (i = 0; i < stack->numY; i++) PetscCall(ElementGetVec(stack, e, i + 1, Y[i]));
     } else if (ts->stifflyaccurate) {
-      PetscCall(VecCopy(e->Y[stack->numY - 1], ts->vec_sol));
+      PetscCall(ElementGetVec(stack, e, stack->numY, ts->vec_sol));
     }
   }
   if (adjoint_mode) {
@@ -753,6 +964,7 @@ static PetscErrorCode TSTrajectoryMemoryGet_TLNR(TSTrajectory tj, TS ts, TJSched
   PetscFunctionBegin;
   if (stepnum == tjsch->total_steps) {
     PetscCall(TurnBackward(ts));
+    PetscCall(PrefetchCheckpoint(tj, LastCheckpointId(tjsch)));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
@@ -1057,10 +1269,10 @@ static PetscErrorCode TSTrajectoryMemorySet_RON(TSTrajectory tj, TS ts, TJSchedu
   if (store == 1) {
     if (rctx->check != stack->top + 1) { /* overwrite some non-top checkpoint in the stack */
       PetscCall(StackFind(stack, &e, rctx->check));
-      if (HaveSolution(e->cptype)) PetscCall(VecCopy(X, e->X));
+      if (HaveSolution(e->cptype)) PetscCall(ElementSetVec(stack, e, 0, X));
       if (HaveStages(e->cptype)) {
         PetscCall(TSGetStages(ts, &stack->numY, &Y));
-        for (i = 0; i < stack->numY; i++) PetscCall(VecCopy(Y[i], e->Y[i]));
+        for (i = 0; i < stack->numY; i++) PetscCall(ElementSetVec(stack, e, i + 1, Y[i]));
       }
       e->stepnum = stepnum;
       e->time    = time;
@@ -1183,6 +1395,7 @@ static PetscErrorCode TSTrajectoryMemoryGet_TLR(TSTrajectory tj, TS ts, TJSchedu
   stridenum    = stepnum / tjsch->stride;
   if (stepnum == tjsch->total_steps) {
     PetscCall(TurnBackward(ts));
+    PetscCall(PrefetchCheckpoint(tj, LastCheckpointId(tjsch)));
     tjsch->rctx->reverseonestep = PETSC_FALSE;
     PetscFunctionReturn(PETSC_SUCCESS);
   }
@@ -1812,6 +2025,7 @@ static PetscErrorCode TSTrajectorySetMaxCpsRAM_Memory(TSTrajectory tj, PetscInt
 
   PetscFunctionBegin;
   tjsch->max_cps_ram = max_cps_ram;
+  tjsch->ram_scaled  = PETSC_FALSE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1831,6 +2045,7 @@ static PetscErrorCode TSTrajectorySetMaxUnitsRAM_Memory(TSTrajectory tj, PetscIn
   PetscFunctionBegin;
   PetscCheck(tjsch->max_cps_ram, PetscObjectComm((PetscObject)tj), PETSC_ERR_ARG_INCOMP, "Conflict with -ts_trjaectory_max_cps_ram or TSTrajectorySetMaxCpsRAM. You can set max_cps_ram or max_units_ram, but not both at the same time.");
   tjsch->max_units_ram = max_units_ram;
+  tjsch->ram_scaled    = PETSC_FALSE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1854,6 +2069,25 @@ static PetscErrorCode TSTrajectoryMemorySetType_Memory(TSTrajectory tj, TSTrajec
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode TSTrajectoryMemorySetCompression_Memory(TSTrajectory tj, TSTrajectoryMemoryCompressionType type, PetscReal tol)
+{
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
+  PetscBool    same;
+
+  PetscFunctionBegin;
+  if (tol == (PetscReal)PETSC_CURRENT) tol = tjsch->compress_tol;
+  PetscCheck(type != TS_TRAJECTORY_MEMORY_COMPRESS_LOSSY || tol > 0, PetscObjectComm((PetscObject)tj), PETSC_ERR_ARG_OUTOFRANGE, "Lossy compression needs a positive tolerance, not %g", (double)tol);
+  same                = (PetscBool)(type == tjsch->compress && (type != TS_TRAJECTORY_MEMORY_COMPRESS_LOSSY || tol == tjsch->compress_tol));
+  tjsch->compress     = type;
+  tjsch->compress_tol = tol;
+  if (same) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCheck(!tj->setupcalled, PetscObjectComm((PetscObject)tj), PETSC_ERR_ARG_WRONGSTATE, "Cannot change the compression after TSTrajectory has been setup or used");
+  /* the checkpoints and the compressor are rebuilt by the next setup */
+  PetscCall(StackDestroy(&tjsch->stack));
+  PetscCall(TJCompressorDestroy(&tjsch->stack.compressor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 #if defined(PETSC_HAVE_REVOLVE)
 PETSC_UNUSED static PetscErrorCode TSTrajectorySetRevolveOnline(TSTrajectory tj, PetscBool use_online)
 {
@@ -1883,6 +2117,25 @@ PETSC_UNUSED static PetscErrorCode TSTrajectorySetUseDRAM(TSTrajectory tj, Petsc
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode TSTrajectoryMemorySetLocalStorage_Memory(TSTrajectory tj, const char dirname[], PetscInt max_cps_local)
+{
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
+  PetscBool    flg;
+
+  PetscFunctionBegin;
+  if (max_cps_local == PETSC_UNLIMITED || max_cps_local == PETSC_DECIDE) tjsch->max_cps_local = -1;
+  else if (max_cps_local != PETSC_CURRENT) {
+    PetscCheck(max_cps_local >= 0, PetscObjectComm((PetscObject)tj), PETSC_ERR_ARG_OUTOFRANGE, "Number of node-local checkpoint files %" PetscInt_FMT " must be nonnegative", max_cps_local);
+    tjsch->max_cps_local = max_cps_local;
+  }
+  PetscCall(PetscStrcmp(tjsch->local_dirname, dirname, &flg));
+  if (flg) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCheck(!tjsch->local_dir[0], PetscObjectComm((PetscObject)tj), PETSC_ERR_ORDER, "Cannot change the node-local directory after TSTrajectorySetUp()");
+  PetscCall(PetscFree(tjsch->local_dirname));
+  PetscCall(PetscStrallocpy(dirname, &tjsch->local_dirname));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   TSTrajectoryMemorySetType - sets the software that is used to generate the checkpointing schedule.
 
@@ -1906,6 +2159,88 @@ PetscErrorCode TSTrajectoryMemorySetType(TSTrajectory tj, TSTrajectoryMemoryType
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  TSTrajectoryMemorySetCompression - Sets how the checkpoints kept in RAM by `TSTRAJECTORYMEMORY` are compressed
+
+  Logically Collective
+
+  Input Parameters:
++ tj   - the `TSTrajectory` context
+. type - `TS_TRAJECTORY_MEMORY_COMPRESS_NONE`, `TS_TRAJECTORY_MEMORY_COMPRESS_LOSSLESS`, or `TS_TRAJECTORY_MEMORY_COMPRESS_LOSSY`
+- tol  - bound on the absolute error of each entry with the lossy compression, or `PETSC_CURRENT`
+
+  Options Database Keys:
++ -ts_trajectory_memory_compress <none,lossless,lossy> - type of compression
+. -ts_trajectory_memory_compress_tol <tol>             - error bound of the lossy compression
+- -ts_trajectory_memory_compress_ratio <r>             - expected compression ratio, multiplies the number of checkpoints in RAM
+
+  Level: advanced
+
+  Notes:
+  The lossless compression groups the bytes of equal significance of all the entries and packs them with an LZ77 coder.
+  The lossy compression rounds each entry to a multiple of 2 `tol`, codes the differences of consecutive rounded values as
+  variable-length integers and packs them with the same coder; a vector with entries too large for the tolerance is compressed
+  losslessly instead. A vector that does not compress is stored as is.
+
+  When PETSc has pthreads, the compression runs on a helper thread and the time integration only waits for a copy of each
+  stored vector. A checkpoint is decompressed when it is restored or written to disk.
+
+  The checkpointing schedule counts uncompressed checkpoints. With `-ts_trajectory_memory_compress_ratio` r, the budget set with
+  `TSTrajectorySetMaxCpsRAM()` or `TSTrajectorySetMaxUnitsRAM()` is multiplied by r, so that revolve stores more checkpoints
+  and recomputes fewer steps in the same memory. The compression ratio achieved is reported by `-info` when the trajectory is reset.
+
+  This cannot be changed after the trajectory has been set up.
+
+.seealso: [](ch_ts), `TSTrajectory`, `TSTRAJECTORYMEMORY`, `TSTrajectoryMemoryCompressionType`, `TSTrajectorySetMaxCpsRAM()`, `TSTrajectorySetMaxUnitsRAM()`
+@*/
+PetscErrorCode TSTrajectoryMemorySetCompression(TSTrajectory tj, TSTrajectoryMemoryCompressionType type, PetscReal tol)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tj, TSTRAJECTORY_CLASSID, 1);
+  PetscValidLogicalCollectiveEnum(tj, type, 2);
+  PetscValidLogicalCollectiveReal(tj, tol, 3);
+  PetscTryMethod(tj, "TSTrajectoryMemorySetCompression_C", (TSTrajectory, TSTrajectoryMemoryCompressionType, PetscReal), (tj, type, tol));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  TSTrajectoryMemorySetLocalStorage - Sets a node-local directory, for example on a local SSD, that holds some of the checkpoint files written by
+  the two-level checkpointing schemes of `TSTRAJECTORYMEMORY`
+
+  Logically Collective
+
+  Input Parameters:
++ tj            - the `TSTrajectory` context
+. dirname       - an existing directory on storage local to each compute node, or `NULL` to write all the files to the directory of `TSTrajectorySetDirname()`
+- max_cps_local - the maximum number of checkpoint files of each process in `dirname`, `PETSC_UNLIMITED` for no limit, or `PETSC_CURRENT` to keep the current value
+
+  Options Database Keys:
++ -ts_trajectory_local_dirname <dir> - the node-local directory
+. -ts_trajectory_max_cps_local <n>   - the maximum number of files in it
+- -ts_trajectory_prefetch <bool>     - start reading the file needed next by the adjoint while the current stride is recomputed (default true)
+
+  Level: intermediate
+
+  Notes:
+  The files of `TSTrajectorySetMaxCpsDisk()` and `-ts_trajectory_stride` then live in three tiers: RAM for the checkpoints within a stride, the
+  node-local directory, and the shared directory given by `TSTrajectorySetDirname()`. Each process writes the entries of the vectors it owns to its
+  own subdirectory of `dirname`, so the node-local files can only be read back with the same number of processes; they are removed by
+  `TSTrajectoryDestroy()` unless `TSTrajectorySetKeepFiles()` is used.
+
+  Since every file is written once and read once, the node-local tier is filled up to `max_cps_local`. With a fixed time step it keeps the files that
+  the backward sweep reads first, so the reads of the remaining files from the shared file system are started early, see `-ts_trajectory_prefetch`.
+
+.seealso: [](ch_ts), `TSTrajectory`, `TSTRAJECTORYMEMORY`, `TSTrajectorySetDirname()`, `TSTrajectorySetMaxCpsDisk()`, `TSTrajectorySetKeepFiles()`
+@*/
+PetscErrorCode TSTrajectoryMemorySetLocalStorage(TSTrajectory tj, const char dirname[], PetscInt max_cps_local)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tj, TSTRAJECTORY_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(tj, max_cps_local, 3);
+  PetscTryMethod(tj, "TSTrajectoryMemorySetLocalStorage_C", (TSTrajectory, const char[], PetscInt), (tj, dirname, max_cps_local));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   TSTrajectorySetMaxCpsRAM - Set maximum number of checkpoints in RAM
 
@@ -1999,7 +2334,10 @@ static PetscErrorCode TSTrajectorySetFromOptions_Memory(TSTrajectory tj, PetscOp
   TJScheduler *tjsch = (TJScheduler *)tj->data;
   PetscEnum    etmp;
   PetscInt     max_cps_ram, max_cps_disk, max_units_ram, max_units_disk;
-  PetscBool    flg;
+  PetscInt     max_cps_local;
+  PetscReal    tol;
+  PetscBool    flg, flg2;
+  char         dirname[PETSC_MAX_PATH_LEN];
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject, "Memory based TS trajectory options");
@@ -2020,11 +2358,40 @@ static PetscErrorCode TSTrajectorySetFromOptions_Memory(TSTrajectory tj, PetscOp
     PetscCall(PetscOptionsBool("-ts_trajectory_use_dram", "Use DRAM for checkpointing", "TSTrajectorySetUseDRAM", tjsch->stack.use_dram, &tjsch->stack.use_dram, NULL));
     PetscCall(PetscOptionsEnum("-ts_trajectory_memory_type", "Checkpointing schedule software to use", "TSTrajectoryMemorySetType", TSTrajectoryMemoryTypes, (PetscEnum)(int)tjsch->tj_memory_type, &etmp, &flg));
     if (flg) PetscCall(TSTrajectoryMemorySetType(tj, (TSTrajectoryMemoryType)etmp));
+    PetscCall(PetscOptionsEnum("-ts_trajectory_memory_compress", "Compression of the checkpoints in RAM", "TSTrajectoryMemorySetCompression", TSTrajectoryMemoryCompressionTypes, (PetscEnum)tjsch->compress, &etmp, &flg));
+    PetscCall(PetscOptionsReal("-ts_trajectory_memory_compress_tol", "Absolute error bound of the lossy compression", "TSTrajectoryMemorySetCompression", tjsch->compress_tol, &tol, &flg2));
+    if (flg || flg2) PetscCall(TSTrajectoryMemorySetCompression(tj, flg ? (TSTrajectoryMemoryCompressionType)etmp : tjsch->compress, flg2 ? tol : PETSC_CURRENT));
+    PetscCall(PetscOptionsString("-ts_trajectory_local_dirname", "Node-local directory for the checkpoint files read first by the adjoint", "TSTrajectoryMemorySetLocalStorage", tjsch->local_dirname, dirname, sizeof(dirname) - 16, &flg));
+    PetscCall(PetscOptionsInt("-ts_trajectory_max_cps_local", "Maximum number of checkpoint files in the node-local directory", "TSTrajectoryMemorySetLocalStorage", tjsch->max_cps_local, &max_cps_local, &flg2));
+    if (flg || flg2) PetscCall(TSTrajectoryMemorySetLocalStorage(tj, flg ? dirname : tjsch->local_dirname, flg2 ? max_cps_local : PETSC_CURRENT));
+    PetscCall(PetscOptionsBool("-ts_trajectory_prefetch", "Prefetch the checkpoint file that the adjoint reads next", "TSTrajectoryMemorySetLocalStorage", tjsch->prefetch, &tjsch->prefetch, NULL));
+    PetscCall(PetscOptionsBoundedReal("-ts_trajectory_memory_compress_ratio", "Expected compression ratio of the checkpoints, multiplies the number of checkpoints in RAM", "TSTrajectoryMemorySetCompression", tjsch->compress_ratio, &tjsch->compress_ratio, NULL, 1.0));
   }
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* every process creates its own directory, so processes sharing a node never race */
+static PetscErrorCode TSTrajectoryMemorySetUpLocalStorage(TSTrajectory tj)
+{
+  TJScheduler *tjsch = (TJScheduler *)tj->data;
+  PetscBool    flg;
+
+  PetscFunctionBegin;
+  if (!tjsch->local_dirname || tjsch->local_dir[0]) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscTestDirectory(tjsch->local_dirname, 'w', &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_FILE_OPEN, "Node-local directory %s does not exist or is not writable", tjsch->local_dirname);
+  PetscCall(PetscSNPrintf(tjsch->local_dir, sizeof(tjsch->local_dir), "%s/TS-local-XXXXXX", tjsch->local_dirname));
+  PetscCall(PetscMkdtemp(tjsch->local_dir));
+  PetscCall(PetscViewerCreate(PETSC_COMM_SELF, &tjsch->lviewer));
+  PetscCall(PetscViewerSetType(tjsch->lviewer, PETSCVIEWERBINARY));
+  PetscCall(PetscViewerBinarySetSkipInfo(tjsch->lviewer, PETSC_TRUE));
+  PetscCall(PetscViewerPushFormat(tjsch->lviewer, PETSC_VIEWER_NATIVE));
+  PetscCall(PetscViewerFileSetMode(tjsch->lviewer, FILE_MODE_WRITE));
+  PetscCall(PetscInfo(tj, "Node-local checkpoint files in %s, at most %" PetscInt_FMT " (-1 for unlimited)\n", tjsch->local_dir, tjsch->max_cps_local));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
 {
   TJScheduler *tjsch = (TJScheduler *)tj->data;
@@ -2049,6 +2416,11 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
 
   tjsch->stack.solution_only = tj->solution_only;
   PetscCall(TSGetStages(ts, &numY, PETSC_IGNORE));
+  if (tjsch->ram_scaled) { /* undo the scaling of the previous setup */
+    tjsch->max_cps_ram   = tjsch->max_cps_ram_set;
+    tjsch->max_units_ram = tjsch->max_units_ram_set;
+    tjsch->ram_scaled    = PETSC_FALSE;
+  }
   if (stack->solution_only) {
     if (tjsch->max_units_ram) tjsch->max_cps_ram = tjsch->max_units_ram;
     else tjsch->max_units_ram = tjsch->max_cps_ram;
@@ -2059,6 +2431,15 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
     if (tjsch->max_units_disk) tjsch->max_cps_disk = (ts->stifflyaccurate) ? tjsch->max_units_disk / numY : tjsch->max_units_disk / (numY + 1);
     else tjsch->max_units_disk = (ts->stifflyaccurate) ? numY * tjsch->max_cps_disk : (numY + 1) * tjsch->max_cps_disk;
   }
+  if (tjsch->compress && tjsch->compress_ratio > 1 && tjsch->max_cps_ram > 0) {
+    /* the budget counts uncompressed checkpoints, compressed ones let the schedule store more and recompute less */
+    tjsch->max_cps_ram_set   = tjsch->max_cps_ram;
+    tjsch->max_units_ram_set = tjsch->max_units_ram;
+    tjsch->max_cps_ram       = (PetscInt)(tjsch->max_cps_ram * tjsch->compress_ratio);
+    tjsch->max_units_ram     = (PetscInt)(tjsch->max_units_ram * tjsch->compress_ratio);
+    tjsch->ram_scaled        = PETSC_TRUE;
+    PetscCall(PetscInfo(tj, "Compression ratio %g raises the budget in RAM to %" PetscInt_FMT " checkpoints\n", (double)tjsch->compress_ratio, tjsch->max_cps_ram));
+  }
   if (tjsch->max_cps_ram > 0) stack->stacksize = tjsch->max_units_ram; /* maximum stack size. Could be overallocated. */
 
   /* Determine the scheduler type */
@@ -2192,21 +2573,27 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj, TS ts)
 
   if ((tjsch->stype >= TWO_LEVEL_NOREVOLVE && tjsch->stype < REVOLVE_OFFLINE) || tjsch->stype == REVOLVE_MULTISTAGE) { /* these types need to use disk */
     PetscCall(TSTrajectorySetUp_Basic(tj, ts));
+    PetscCall(TSTrajectoryMemorySetUpLocalStorage(tj));
   }
 
   stack->stacksize = PetscMax(stack->stacksize, 1);
   tjsch->recompute = PETSC_FALSE;
+  if (tjsch->compress && !stack->compressor) PetscCall(TJCompressorCreate(tjsch->compress, tjsch->compress_tol, &stack->compressor));
   PetscCall(StackInit(stack, stack->stacksize, numY));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 static PetscErrorCode TSTrajectoryReset_Memory(TSTrajectory tj)
 {
-#if defined(PETSC_HAVE_REVOLVE) || defined(PETSC_HAVE_CAMS)
   TJScheduler *tjsch = (TJScheduler *)tj->data;
-#endif
 
   PetscFunctionBegin;
+  if (tjsch->stack.compressor) {
+    PetscLogDouble rawbytes, storedbytes;
+
+    PetscCall(TJCompressorGetSizes(tjsch->stack.compressor, &rawbytes, &storedbytes));
+    PetscCall(PetscInfo(tj, "Checkpoints in RAM: %g bytes compressed to %g bytes, ratio %g\n", rawbytes, storedbytes, storedbytes > 0 ? rawbytes / storedbytes : 0.0));
+  }
 #if defined(PETSC_HAVE_REVOLVE)
   if (tjsch->stype > TWO_LEVEL_NOREVOLVE) {
     revolve_reset();
@@ -2236,12 +2623,18 @@ static PetscErrorCode TSTrajectoryDestroy_Memory(TSTrajectory tj)
 
   PetscFunctionBegin;
   PetscCall(StackDestroy(&tjsch->stack));
+  PetscCall(TJCompressorDestroy(&tjsch->stack.compressor));
   PetscCall(PetscViewerDestroy(&tjsch->viewer));
+  PetscCall(PetscViewerDestroy(&tjsch->lviewer));
+  if (tjsch->local_dir[0] && !tj->keepfiles) PetscCall(PetscRMTree(tjsch->local_dir));
+  PetscCall(PetscFree(tjsch->local_dirname));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxCpsRAM_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxCpsDisk_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxUnitsRAM_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxUnitsDisk_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectoryMemorySetType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectoryMemorySetCompression_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectoryMemorySetLocalStorage_C", NULL));
   PetscCall(PetscFree(tjsch));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -2249,9 +2642,15 @@ static PetscErrorCode TSTrajectoryDestroy_Memory(TSTrajectory tj)
 /*MC
       TSTRAJECTORYMEMORY - Stores each solution of the ODE/ADE in memory
 
+  Options Database Keys:
++ -ts_trajectory_memory_compress <none,lossless,lossy> - compress the checkpoints kept in RAM, see `TSTrajectoryMemorySetCompression()`
+. -ts_trajectory_local_dirname <dir>                   - keep some of the checkpoint files on node-local storage, see `TSTrajectoryMemorySetLocalStorage()`
+- -ts_trajectory_prefetch <bool>                       - read ahead the checkpoint file that the adjoint needs next
+
   Level: intermediate
 
-.seealso: [](ch_ts), `TSTrajectoryCreate()`, `TS`, `TSTrajectorySetType()`, `TSTrajectoryType`, `TSTrajectory`
+.seealso: [](ch_ts), `TSTrajectoryCreate()`, `TS`, `TSTrajectorySetType()`, `TSTrajectoryType`, `TSTrajectory`, `TSTrajectoryMemorySetCompression()`,
+          `TSTrajectoryMemorySetLocalStorage()`
 M*/
 PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj, TS ts)
 {
@@ -2273,7 +2672,12 @@ PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj, TS ts)
 #if defined(PETSC_HAVE_REVOLVE)
   tjsch->use_online = PETSC_FALSE;
 #endif
-  tjsch->save_stack = PETSC_TRUE;
+  tjsch->save_stack     = PETSC_TRUE;
+  tjsch->compress       = TS_TRAJECTORY_MEMORY_COMPRESS_NONE;
+  tjsch->compress_tol   = PETSC_SMALL;
+  tjsch->compress_ratio = 1.0;
+  tjsch->max_cps_local  = -1;
+  tjsch->prefetch       = PETSC_TRUE;
 
   tjsch->stack.solution_only = tj->solution_only;
   PetscCall(PetscViewerCreate(PetscObjectComm((PetscObject)tj), &tjsch->viewer));
@@ -2286,6 +2690,8 @@ PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj, TS ts)
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxUnitsRAM_C", TSTrajectorySetMaxUnitsRAM_Memory));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectorySetMaxUnitsDisk_C", TSTrajectorySetMaxUnitsDisk_Memory));
   PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectoryMemorySetType_C", TSTrajectoryMemorySetType_Memory));
+  PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectoryMemorySetCompression_C", TSTrajectoryMemorySetCompression_Memory));
+  PetscCall(PetscObjectComposeFunction((PetscObject)tj, "TSTrajectoryMemorySetLocalStorage_C", TSTrajectoryMemorySetLocalStorage_Memory));
   tj->data = tjsch;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
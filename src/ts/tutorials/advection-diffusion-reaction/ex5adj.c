@@ -10,6 +10,7 @@ static char help[] = "Demonstrates adjoint sensitivity analysis for Reaction-Dif
     -forwardonly  - run the forward simulation without adjoint
     -implicitform - provide IFunction and IJacobian to TS, if not set, RHSFunction and RHSJacobian will be used
     -aijpc        - set the preconditioner matrix to be aij (the Jacobian matrix can be of a different type such as ELL)
+    -compress_check - solve again with uncompressed checkpoints and compare the gradient against -ts_trajectory_memory_compress_tol
 */
 #include "reaction_diffusion.h"
 #include <petscdm.h>
@@ -45,8 +46,9 @@ int main(int argc, char **argv)
   Vec       x;  /* solution */
   DM        da;
   AppCtx    appctx;
-  Vec       lambda[1];
-  PetscBool forwardonly = PETSC_FALSE, implicitform = PETSC_TRUE;
+  Vec       lambda[1], lambdac = NULL;
+  PetscBool forwardonly = PETSC_FALSE, implicitform = PETSC_TRUE, compress_check = PETSC_FALSE;
+  PetscReal compress_tol = PETSC_SMALL;
 
   PetscFunctionBeginUser;
   PetscCall(PetscInitialize(&argc, &argv, (char *)0, help));
@@ -54,6 +56,8 @@ int main(int argc, char **argv)
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-implicitform", &implicitform, NULL));
   appctx.aijpc = PETSC_FALSE;
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-aijpc", &appctx.aijpc, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-compress_check", &compress_check, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-ts_trajectory_memory_compress_tol", &compress_tol, NULL));
 
   appctx.D1    = 8.0e-5;
   appctx.D2    = 4.0e-5;
@@ -75,75 +79,98 @@ int main(int argc, char **argv)
    - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
   PetscCall(DMCreateGlobalVector(da, &x));
 
-  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-     Create timestepping solver context
-     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-  PetscCall(TSCreate(PETSC_COMM_WORLD, &ts));
-  PetscCall(TSSetDM(ts, da));
-  PetscCall(TSSetProblemType(ts, TS_NONLINEAR));
-  PetscCall(TSSetEquationType(ts, TS_EQ_ODE_EXPLICIT)); /* less Jacobian evaluations when adjoint BEuler is used, otherwise no effect */
-  if (!implicitform) {
-    PetscCall(TSSetType(ts, TSRK));
-    PetscCall(TSSetRHSFunction(ts, NULL, RHSFunction, &appctx));
-    PetscCall(TSSetRHSJacobian(ts, NULL, NULL, RHSJacobian, &appctx));
-  } else {
-    PetscCall(TSSetType(ts, TSCN));
-    PetscCall(TSSetIFunction(ts, NULL, IFunction, &appctx));
-    if (appctx.aijpc) {
-      Mat A, B;
-
-      PetscCall(DMSetMatType(da, MATSELL));
-      PetscCall(DMCreateMatrix(da, &A));
-      PetscCall(MatConvert(A, MATAIJ, MAT_INITIAL_MATRIX, &B));
-      /* FIXME do we need to change viewer to display matrix in natural ordering as DMCreateMatrix_DA does? */
-      PetscCall(TSSetIJacobian(ts, A, B, IJacobian, &appctx));
-      PetscCall(MatDestroy(&A));
-      PetscCall(MatDestroy(&B));
+  /* with -compress_check, a second run gives the gradient with uncompressed checkpoints */
+  for (PetscInt run = 0; run < (compress_check && !forwardonly ? 2 : 1); run++) {
+    /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+       Create timestepping solver context
+       - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+    PetscCall(TSCreate(PETSC_COMM_WORLD, &ts));
+    PetscCall(TSSetDM(ts, da));
+    PetscCall(TSSetProblemType(ts, TS_NONLINEAR));
+    PetscCall(TSSetEquationType(ts, TS_EQ_ODE_EXPLICIT)); /* less Jacobian evaluations when adjoint BEuler is used, otherwise no effect */
+    if (!implicitform) {
+      PetscCall(TSSetType(ts, TSRK));
+      PetscCall(TSSetRHSFunction(ts, NULL, RHSFunction, &appctx));
+      PetscCall(TSSetRHSJacobian(ts, NULL, NULL, RHSJacobian, &appctx));
     } else {
-      PetscCall(TSSetIJacobian(ts, NULL, NULL, IJacobian, &appctx));
+      PetscCall(TSSetType(ts, TSCN));
+      PetscCall(TSSetIFunction(ts, NULL, IFunction, &appctx));
+      if (appctx.aijpc) {
+        Mat A, B;
+
+        PetscCall(DMSetMatType(da, MATSELL));
+        PetscCall(DMCreateMatrix(da, &A));
+        PetscCall(MatConvert(A, MATAIJ, MAT_INITIAL_MATRIX, &B));
+        /* FIXME do we need to change viewer to display matrix in natural ordering as DMCreateMatrix_DA does? */
+        PetscCall(TSSetIJacobian(ts, A, B, IJacobian, &appctx));
+        PetscCall(MatDestroy(&A));
+        PetscCall(MatDestroy(&B));
+      } else {
+        PetscCall(TSSetIJacobian(ts, NULL, NULL, IJacobian, &appctx));
+      }
     }
-  }
 
-  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-     Set initial conditions
-   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-  PetscCall(InitialConditions(da, x));
-  PetscCall(TSSetSolution(ts, x));
+    /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+       Set initial conditions
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+    PetscCall(InitialConditions(da, x));
+    PetscCall(TSSetSolution(ts, x));
 
-  /*
-    Have the TS save its trajectory so that TSAdjointSolve() may be used
-  */
-  if (!forwardonly) PetscCall(TSSetSaveTrajectory(ts));
+    /*
+      Have the TS save its trajectory so that TSAdjointSolve() may be used
+    */
+    if (!forwardonly) PetscCall(TSSetSaveTrajectory(ts));
 
-  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-     Set solver options
-   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-  PetscCall(TSSetMaxTime(ts, 200.0));
-  PetscCall(TSSetTimeStep(ts, 0.5));
-  PetscCall(TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP));
-  PetscCall(TSSetFromOptions(ts));
+    /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+       Set solver options
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+    PetscCall(TSSetMaxTime(ts, 200.0));
+    PetscCall(TSSetTimeStep(ts, 0.5));
+    PetscCall(TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP));
+    PetscCall(TSSetFromOptions(ts));
+    if (run) {
+      TSTrajectory tj;
+
+      /* the second run keeps uncompressed checkpoints and is not monitored */
+      PetscCall(TSGetTrajectory(ts, &tj));
+      PetscCall(TSTrajectoryMemorySetCompression(tj, TS_TRAJECTORY_MEMORY_COMPRESS_NONE, PETSC_CURRENT));
+      PetscCall(TSMonitorCancel(ts));
+      PetscCall(TSAdjointMonitorCancel(ts));
+    }
 
-  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-     Solve ODE system
-     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-  PetscCall(TSSolve(ts, x));
-  if (!forwardonly) {
     /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-       Start the Adjoint model
+       Solve ODE system
        - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-    PetscCall(VecDuplicate(x, &lambda[0]));
-    /*   Reset initial conditions for the adjoint integration */
-    PetscCall(InitializeLambda(da, lambda[0], 0.5, 0.5));
-    PetscCall(TSSetCostGradients(ts, 1, lambda, NULL));
-    PetscCall(TSAdjointSolve(ts));
-    PetscCall(VecDestroy(&lambda[0]));
+    PetscCall(TSSolve(ts, x));
+    if (!forwardonly) {
+      /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+         Start the Adjoint model
+         - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+      PetscCall(VecDuplicate(x, &lambda[0]));
+      /*   Reset initial conditions for the adjoint integration */
+      PetscCall(InitializeLambda(da, lambda[0], 0.5, 0.5));
+      PetscCall(TSSetCostGradients(ts, 1, lambda, NULL));
+      PetscCall(TSAdjointSolve(ts));
+      if (compress_check && !run) {
+        PetscCall(VecDuplicate(lambda[0], &lambdac));
+        PetscCall(VecCopy(lambda[0], lambdac));
+      } else if (run) {
+        PetscReal err;
+
+        PetscCall(VecAXPY(lambdac, -1.0, lambda[0]));
+        PetscCall(VecNorm(lambdac, NORM_INFINITY, &err));
+        PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Gradient difference from the uncompressed checkpoints %s %g\n", err <= compress_tol ? "<=" : ">", (double)compress_tol));
+        PetscCall(VecDestroy(&lambdac));
+      }
+      PetscCall(VecDestroy(&lambda[0]));
+    }
+    PetscCall(TSDestroy(&ts));
   }
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
      Free work space.  All PETSc objects should be destroyed when they
      are no longer needed.
    - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
   PetscCall(VecDestroy(&x));
-  PetscCall(TSDestroy(&ts));
   PetscCall(DMDestroy(&da));
   PetscCall(PetscFinalize());
   return 0;
@@ -226,6 +253,16 @@ PetscErrorCode InitialConditions(DM da, Vec U)
       args: -ts_max_steps 10 -implicitform 0 -ts_type rk -ts_rk_type 4 -ts_monitor -ts_adjoint_monitor -da_grid_x 20 -da_grid_y 20 -snes_fd_color
       output_file: output/ex5adj_1.out
 
+   test:
+      suffix: compress
+      nsize: 2
+      args: -ts_max_steps 10 -ts_monitor -ts_adjoint_monitor -da_grid_x 20 -da_grid_y 20 -ts_trajectory_type memory -ts_trajectory_solution_only 0 -ts_trajectory_memory_compress {{lossless lossy}shared output} -ts_trajectory_memory_compress_tol 1e-8 -compress_check
+
+   test:
+      suffix: local
+      nsize: 2
+      args: -ts_max_steps 10 -ts_monitor -ts_adjoint_monitor -da_grid_x 20 -da_grid_y 20 -ts_trajectory_type memory -ts_trajectory_solution_only 0 -ts_trajectory_stride 2 -ts_trajectory_save_stack 0 -ts_trajectory_local_dirname . -ts_trajectory_max_cps_local 2
+
    test:
       suffix: knl
       args: -ts_max_steps 10 -ts_monitor -ts_adjoint_monitor -ts_trajectory_type memory -ts_trajectory_solution_only 0 -malloc_hbw -ts_trajectory_use_dram 1
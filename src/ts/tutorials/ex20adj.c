@@ -539,4 +539,24 @@ int main(int argc, char **argv)
       suffix: 25
       args: -imexform -ts_max_steps 15 -ts_trajectory_type memory
       output_file: output/ex20adj_imex.out
+
+    test:
+      suffix: compress
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_solution_only {{0 1}} -ts_trajectory_memory_compress {{lossless lossy}} -ts_trajectory_memory_compress_tol 1e-12
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: compress_stride
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_stride 5 -ts_trajectory_solution_only {{0 1}} -ts_trajectory_save_stack -ts_trajectory_memory_compress lossless
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: compress_ratio
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_max_cps_ram 5 -ts_trajectory_solution_only {{0 1}} -ts_trajectory_memory_compress lossless -ts_trajectory_memory_compress_ratio 4
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: local
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_stride 5 -ts_trajectory_solution_only {{0 1}} -ts_trajectory_save_stack {{0 1}} -ts_trajectory_local_dirname . -ts_trajectory_max_cps_local 1
+      output_file: output/ex20adj_2.out
 TEST*/
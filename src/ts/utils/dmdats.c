@@ -9,6 +9,8 @@ typedef struct {
   PetscErrorCode (*rhsfunctionlocal)(DMDALocalInfo *, PetscReal, void *, void *, void *);
   PetscErrorCode (*ijacobianlocal)(DMDALocalInfo *, PetscReal, void *, void *, PetscReal, Mat, Mat, void *);
   PetscErrorCode (*rhsjacobianlocal)(DMDALocalInfo *, PetscReal, void *, Mat, Mat, void *);
+  PetscErrorCode (*rhsfunctionlocalinterior)(DMDALocalInfo *, PetscReal, void *, void *, void *);
+  PetscErrorCode (*rhsfunctionlocalboundary)(DMDALocalInfo *, PetscReal, void *, void *, void *);
   void      *ifunctionlocalctx;
   void      *ijacobianlocalctx;
   void      *rhsfunctionlocalctx;
@@ -138,6 +140,34 @@ static PetscErrorCode TSComputeIJacobian_DMDA(TS ts, PetscReal ptime, Vec X, Vec
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* the interior points only read owned values, so they are evaluated on the global vector while the ghost points are communicated */
+static PetscErrorCode TSComputeRHSFunctionSplit_DMDA(DM dm, DMTS_DA *dmdats, PetscReal ptime, Vec X, Vec F)
+{
+  DMDATSRHSFunctionLocalFn *boundaryfn = dmdats->rhsfunctionlocalboundary ? dmdats->rhsfunctionlocalboundary : dmdats->rhsfunctionlocalinterior;
+  DMDALocalInfo             interior, boundary[6];
+  PetscInt                  nb;
+  Vec                       Xloc;
+  void                     *x, *f;
+
+  PetscFunctionBegin;
+  PetscCall(DMDAGetLocalInfoSplit(dm, &interior, &nb, boundary));
+  PetscCall(DMGetLocalVector(dm, &Xloc));
+  PetscCall(DMGlobalToLocalBegin(dm, X, INSERT_VALUES, Xloc));
+  PetscCall(DMDAVecGetArray(dm, F, &f));
+  if (interior.xm && interior.ym && interior.zm) {
+    PetscCall(DMDAVecGetArrayRead(dm, X, &x));
+    PetscCall((*dmdats->rhsfunctionlocalinterior)(&interior, ptime, x, f, dmdats->rhsfunctionlocalctx));
+    PetscCall(DMDAVecRestoreArrayRead(dm, X, &x));
+  }
+  PetscCall(DMGlobalToLocalEnd(dm, X, INSERT_VALUES, Xloc));
+  PetscCall(DMDAVecGetArrayRead(dm, Xloc, &x));
+  for (PetscInt b = 0; b < nb; ++b) PetscCall((*boundaryfn)(&boundary[b], ptime, x, f, dmdats->rhsfunctionlocalctx));
+  PetscCall(DMDAVecRestoreArrayRead(dm, Xloc, &x));
+  PetscCall(DMDAVecRestoreArray(dm, F, &f));
+  PetscCall(DMRestoreLocalVector(dm, &Xloc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode TSComputeRHSFunction_DMDA(TS ts, PetscReal ptime, Vec X, Vec F, void *ctx)
 {
   DM            dm;
@@ -150,8 +180,12 @@ static PetscErrorCode TSComputeRHSFunction_DMDA(TS ts, PetscReal ptime, Vec X, V
   PetscValidHeaderSpecific(ts, TS_CLASSID, 1);
   PetscValidHeaderSpecific(X, VEC_CLASSID, 3);
   PetscValidHeaderSpecific(F, VEC_CLASSID, 4);
-  PetscCheck(dmdats->rhsfunctionlocal, PetscObjectComm((PetscObject)ts), PETSC_ERR_PLIB, "Corrupt context");
+  PetscCheck(dmdats->rhsfunctionlocal || dmdats->rhsfunctionlocalinterior, PetscObjectComm((PetscObject)ts), PETSC_ERR_PLIB, "Corrupt context");
   PetscCall(TSGetDM(ts, &dm));
+  if (dmdats->rhsfunctionlocalinterior) {
+    PetscCall(TSComputeRHSFunctionSplit_DMDA(dm, dmdats, ptime, X, F));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(DMGetLocalVector(dm, &Xloc));
   PetscCall(DMGlobalToLocalBegin(dm, X, INSERT_VALUES, Xloc));
   PetscCall(DMGlobalToLocalEnd(dm, X, INSERT_VALUES, Xloc));
@@ -196,7 +230,7 @@ static PetscErrorCode TSComputeRHSJacobian_DMDA(TS ts, PetscReal ptime, Vec X, M
   void         *x;
 
   PetscFunctionBegin;
-  PetscCheck(dmdats->rhsfunctionlocal, PetscObjectComm((PetscObject)ts), PETSC_ERR_PLIB, "Corrupt context");
+  PetscCheck(dmdats->rhsfunctionlocal || dmdats->rhsfunctionlocalinterior, PetscObjectComm((PetscObject)ts), PETSC_ERR_PLIB, "Corrupt context");
   PetscCall(TSGetDM(ts, &dm));
 
   if (dmdats->rhsjacobianlocal) {
@@ -243,9 +277,50 @@ PetscErrorCode DMDATSSetRHSFunctionLocal(DM dm, InsertMode imode, DMDATSRHSFunct
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscCall(DMGetDMTSWrite(dm, &sdm));
   PetscCall(DMDATSGetContext(dm, sdm, &dmdats));
-  dmdats->rhsfunctionlocalimode = imode;
-  dmdats->rhsfunctionlocal      = func;
-  dmdats->rhsfunctionlocalctx   = ctx;
+  dmdats->rhsfunctionlocalimode    = imode;
+  dmdats->rhsfunctionlocal         = func;
+  dmdats->rhsfunctionlocalctx      = ctx;
+  dmdats->rhsfunctionlocalinterior = NULL;
+  dmdats->rhsfunctionlocalboundary = NULL;
+  PetscCall(DMTSSetRHSFunction(dm, TSComputeRHSFunction_DMDA, dmdats));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  DMDATSSetRHSFunctionLocalSplit - set a local right-hand side evaluation function for use with `DMDA` that is split into interior and
+  boundary kernels, so the communication of the ghost points is overlapped with the evaluation at the interior points
+
+  Logically Collective
+
+  Input Parameters:
++ dm       - `DM` to associate callback with
+. interior - local right-hand side evaluation on the interior points, see `DMDATSRHSFunctionLocalFn` for the calling sequence
+. boundary - local right-hand side evaluation on the boundary points, or `NULL` to use `interior`
+- ctx      - optional context for local residual evaluation
+
+  Level: intermediate
+
+  Note:
+  The right-hand side is computed on the points owned by this MPI process, as with `INSERT_VALUES` in `DMDATSSetRHSFunctionLocal()`. The
+  interior points are evaluated on the array of the global vector between `DMGlobalToLocalBegin()` and `DMGlobalToLocalEnd()`, and the
+  boundary points on the ghosted local vector afterwards, see `DMDASNESSetFunctionLocalSplit()` for details.
+
+.seealso: [](ch_ts), `DMDA`, `DMDATSRHSFunctionLocalFn`, `DMDATSSetRHSFunctionLocal()`, `DMDAGetLocalInfoSplit()`, `DMDASNESSetFunctionLocalSplit()`
+@*/
+PetscErrorCode DMDATSSetRHSFunctionLocalSplit(DM dm, DMDATSRHSFunctionLocalFn *interior, DMDATSRHSFunctionLocalFn *boundary, void *ctx)
+{
+  DMTS     sdm;
+  DMTS_DA *dmdats;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscCall(DMGetDMTSWrite(dm, &sdm));
+  PetscCall(DMDATSGetContext(dm, sdm, &dmdats));
+  dmdats->rhsfunctionlocalimode    = INSERT_VALUES;
+  dmdats->rhsfunctionlocal         = NULL;
+  dmdats->rhsfunctionlocalctx      = ctx;
+  dmdats->rhsfunctionlocalinterior = interior;
+  dmdats->rhsfunctionlocalboundary = boundary;
   PetscCall(DMTSSetRHSFunction(dm, TSComputeRHSFunction_DMDA, dmdats));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -227,8 +227,9 @@ static PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
   PetscCall(ISGetLocalSize(is, &n));
   PetscCall(PetscHDF5IntCast(N / bs, dims + dim));
 
-  maxDims[dim]   = dims[dim];
-  chunkDims[dim] = PetscMax(1, dims[dim]);
+  maxDims[dim] = dims[dim];
+  /* chunk boundaries on the process boundaries, so that no chunk is shared by processes */
+  PetscCall(PetscViewerHDF5GetChunkLength_Internal(is->map->size, is->map->range, bs, chunkDims + dim));
   chunksize *= chunkDims[dim];
   ++dim;
   if (bs >= 1) {
@@ -259,8 +260,7 @@ static PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
   PetscCall(PetscObjectGetName((PetscObject)is, &isname));
   if (!H5Lexists(group, isname, H5P_DEFAULT)) {
     /* Create chunk */
-    PetscCallHDF5Return(chunkspace, H5Pcreate, (H5P_DATASET_CREATE));
-    PetscCallHDF5(H5Pset_chunk, (chunkspace, dim, chunkDims));
+    PetscCall(PetscViewerHDF5CreateDatasetPList_Internal(viewer, dim, chunkDims, &chunkspace));
 
     PetscCallHDF5Return(dset_id, H5Dcreate2, (group, isname, inttype, filespace, H5P_DEFAULT, chunkspace, H5P_DEFAULT));
     PetscCallHDF5(H5Pclose, (chunkspace));
@@ -312,7 +312,7 @@ static PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
 
   PetscCall(ISGetIndices(is, &ind));
   PetscCallHDF5(H5Dwrite, (dset_id, inttype, memspace, filespace, hdf5->dxpl_id, ind));
-  PetscCallHDF5(H5Fflush, (file_id, H5F_SCOPE_GLOBAL));
+  if (hdf5->datasetFlush) PetscCallHDF5(H5Fflush, (file_id, H5F_SCOPE_GLOBAL));
   PetscCall(ISRestoreIndices(is, &ind));
 
   /* Close/release resources */
@@ -598,8 +598,9 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
   }
   PetscCall(PetscHDF5IntCast(xin->map->N / bs, dims + dim));
 
-  maxDims[dim]   = dims[dim];
-  chunkDims[dim] = PetscMax(1, dims[dim]);
+  maxDims[dim] = dims[dim];
+  /* chunk boundaries on the process boundaries, so that no chunk is shared by processes */
+  PetscCall(PetscViewerHDF5GetChunkLength_Internal(xin->map->size, xin->map->range, bs, chunkDims + dim));
   chunksize *= chunkDims[dim];
   ++dim;
   if (bs > 1 || dim2) {
@@ -655,8 +656,7 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
   PetscCall(PetscObjectGetName((PetscObject)xin, &vecname));
   if (H5Lexists(group, vecname, H5P_DEFAULT) < 1) {
     /* Create chunk */
-    PetscCallHDF5Return(chunkspace, H5Pcreate, (H5P_DATASET_CREATE));
-    PetscCallHDF5(H5Pset_chunk, (chunkspace, dim, chunkDims));
+    PetscCall(PetscViewerHDF5CreateDatasetPList_Internal(viewer, dim, chunkDims, &chunkspace));
 
     PetscCallHDF5Return(dset_id, H5Dcreate2, (group, vecname, filescalartype, filespace, H5P_DEFAULT, chunkspace, H5P_DEFAULT));
     PetscCallHDF5(H5Pclose, (chunkspace));
@@ -716,7 +716,7 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
 
   PetscCall(VecGetArrayRead(xin, &x));
   PetscCallHDF5(H5Dwrite, (dset_id, memscalartype, memspace, filespace, hdf5->dxpl_id, x));
-  PetscCallHDF5(H5Fflush, (file_id, H5F_SCOPE_GLOBAL));
+  if (hdf5->datasetFlush) PetscCallHDF5(H5Fflush, (file_id, H5F_SCOPE_GLOBAL));
   PetscCall(VecRestoreArrayRead(xin, &x));
 
   /* Close/release resources */